@@ -270,6 +270,7 @@ void CPUInfo::Detect()
 	bIDIVt = isVFP4;
 	bFP = false;
 	bASIMD = false;
+	bSHA2 = false;
 #else // PPSSPP_PLATFORM(LINUX)
 	truncate_cpy(cpu_string, GetCPUString().c_str());
 	truncate_cpy(brand_string, GetCPUBrandString().c_str());
@@ -291,9 +292,10 @@ void CPUInfo::Detect()
 	unsigned short CPUPart = GetCPUPart();
 	if (GetCPUImplementer() == 0x51 && (CPUPart == 0x4D || CPUPart == 0x6F))
 		bIDIVa = bIDIVt = true;
-	// These two require ARMv8 or higher
+	// These require ARMv8 or higher
 	bFP = CheckCPUFeature("fp");
 	bASIMD = CheckCPUFeature("asimd");
+	bSHA2 = CheckCPUFeature("sha2");
 	num_cores = GetCoreCount();
 #endif
 #if PPSSPP_ARCH(ARM64)
@@ -322,6 +324,7 @@ std::string CPUInfo::Summarize()
 	if (bVFPv3) sum += ", VFPv3";
 	if (bVFPv4) sum += ", VFPv4";
 	if (bNEON) sum += ", NEON";
+	if (bSHA2) sum += ", SHA2";
 	if (bIDIVa) sum += ", IDIVa";
 	if (bIDIVt) sum += ", IDIVt";
 	if (CPU64bit) sum += ", 64-bit";
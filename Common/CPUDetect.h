@@ -88,6 +88,7 @@ struct CPUInfo {
 	// ARMv8 specific
 	bool bFP;
 	bool bASIMD;
+	bool bSHA2;  // Crypto extension SHA-256 instructions.
 
 	// MIPS specific
 	bool bXBurst1;
@@ -30,6 +30,7 @@
 // - Serialization code for anything complex has to be manually written.
 
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <unordered_map>
 #include <deque>
@@ -128,11 +129,23 @@ public:
 	u8 **ptr;
 	Mode mode;
 	Error error;
+	// Optional bound for MODE_WRITE. When the write would pass it, we stop
+	// writing and continue in MODE_MEASURE, so the same pass still yields the
+	// required size. See CChunkFileReader::MeasureAndSavePtr.
+	u8 *writeBound = nullptr;
+	bool overflowedBound = false;
 
 public:
 	PointerWrap(u8 **ptr_, Mode mode_) : ptr(ptr_), mode(mode_), error(ERROR_NONE) {}
 	PointerWrap(unsigned char **ptr_, int mode_) : ptr((u8**)ptr_), mode((Mode)mode_), error(ERROR_NONE) {}
 
+	inline void CheckWriteBound(int size) {
+		if (mode == MODE_WRITE && writeBound && *ptr + size > writeBound) {
+			mode = MODE_MEASURE;
+			overflowedBound = true;
+		}
+	}
+
 	PointerWrapSection Section(const char *title, int ver);
 
 	// The returned object can be compared against the version that was loaded.
@@ -193,11 +206,83 @@ public:
 		DoMap(x, dv);
 	}
 
+	// Dispatch on whether the container has reserve() (the unordered maps do.)
+	template<class M>
+	static auto MapReserve(M &x, size_t n, int) -> decltype(x.reserve(n)) {
+		x.reserve(n);
+	}
+	template<class M>
+	static void MapReserve(M &, size_t, long) {
+	}
+
+	// Bulk fast path for maps with POD keys and values, which is most of the
+	// kernel object bookkeeping. Produces the exact same byte layout as the
+	// element-wise loop in DoMap/DoMultimap (key, value, key, value, ...), so
+	// the savestate format is unchanged - this just skips the DoVoid round
+	// trip per element, and on load reserves/end-hints the inserts (keys were
+	// written in iteration order, so the hint makes ordered inserts O(1).)
+	// Returns false when the types don't qualify.
+	template<class M>
+	bool DoMapBulk(M &x, unsigned int number)
+	{
+		typedef typename M::key_type K;
+		typedef typename M::mapped_type T;
+#ifdef _MSC_VER
+		const bool podK = std::is_pod<K>::value, podT = std::is_pod<T>::value;
+#else
+		const bool podK = __is_pod(K), podT = __is_pod(T);
+#endif
+		// Pointer values get deep-serialized, so they don't qualify.
+		if (!podK || !podT || std::is_pointer<K>::value || std::is_pointer<T>::value)
+			return false;
+
+		const size_t entrySize = sizeof(K) + sizeof(T);
+		CheckWriteBound((int)(number * entrySize));
+		switch (mode) {
+		case MODE_MEASURE:
+			*ptr += number * entrySize;
+			return true;
+		case MODE_WRITE:
+			{
+				u8 *dst = *ptr;
+				for (auto itr = x.begin(); number > 0; --number, ++itr) {
+					memcpy(dst, &itr->first, sizeof(K));
+					memcpy(dst + sizeof(K), &itr->second, sizeof(T));
+					dst += entrySize;
+				}
+				*ptr = dst;
+			}
+			return true;
+		case MODE_READ:
+			{
+				x.clear();
+				MapReserve(x, number, 0);
+				const u8 *src = *ptr;
+				for (; number > 0; --number) {
+					K first = K();
+					T second = T();
+					memcpy(&first, src, sizeof(K));
+					memcpy(&second, src + sizeof(K), sizeof(T));
+					src += entrySize;
+					x.insert(x.end(), typename M::value_type(first, second));
+				}
+				*ptr = (u8 *)src;
+			}
+			return true;
+		case MODE_VERIFY:
+		default:
+			// Rare mode, keep it on the one slow path.
+			return false;
+		}
+	}
+
 	template<class M>
 	void DoMap(M &x, typename M::mapped_type &default_val)
 	{
 		unsigned int number = (unsigned int)x.size();
 		Do(number);
+		if (DoMapBulk(x, number))
+			return;
 		switch (mode) {
 		case MODE_READ:
 			{
@@ -280,6 +365,8 @@ public:
 	{
 		unsigned int number = (unsigned int)x.size();
 		Do(number);
+		if (DoMapBulk(x, number))
+			return;
 		switch (mode) {
 		case MODE_READ:
 			{
@@ -620,6 +707,39 @@ public:
 		}
 	}
 
+	// Saves into buffer, growing it only when needed. In steady state (buffer
+	// already big enough, e.g. reused rewind snapshots) this is a single write
+	// pass with no measure pass and no allocation.
+	template<class T>
+	static Error MeasureAndSavePtr(std::vector<u8> &buffer, T &_class)
+	{
+		if (buffer.empty())
+			buffer.resize(MeasurePtr(_class));
+
+		u8 *ptr = &buffer[0];
+		PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+		p.writeBound = &buffer[0] + buffer.size();
+		_class.DoState(p);
+		if (p.overflowedBound) {
+			// The bounded write doubled as a measure pass - grow and rewrite.
+			buffer.resize((size_t)(ptr - &buffer[0]));
+			ptr = &buffer[0];
+			PointerWrap p2(&ptr, PointerWrap::MODE_WRITE);
+			p2.writeBound = &buffer[0] + buffer.size();
+			_class.DoState(p2);
+			// If it still doesn't fit, the state changed under us somehow.
+			if (p2.overflowedBound || p2.error == p2.ERROR_FAILURE)
+				return ERROR_BROKEN_STATE;
+			return ERROR_NONE;
+		}
+
+		if (p.error != p.ERROR_FAILURE) {
+			return ERROR_NONE;
+		} else {
+			return ERROR_BROKEN_STATE;
+		}
+	}
+
 	// Load file template
 	template<class T>
 	static Error Load(const std::string &filename, std::string *gitVersion, T& _class, std::string *failureReason)
@@ -684,6 +804,11 @@ public:
 
 	static Error GetFileTitle(const std::string &filename, std::string *title);
 
+	// Compresses and writes an already-serialized state (e.g. from SavePtr.)
+	// Takes ownership of buffer, which must come from malloc.  Does no
+	// emulation work, so it's safe to call from a background thread.
+	static Error SaveFile(const std::string &filename, const std::string &title, const char *gitVersion, u8 *buffer, size_t sz);
+
 private:
 	struct SChunkHeader
 	{
@@ -701,6 +826,5 @@ private:
 	};
 
 	static Error LoadFile(const std::string &filename, std::string *gitVersion, u8 *&buffer, size_t &sz, std::string *failureReason);
-	static Error SaveFile(const std::string &filename, const std::string &title, const char *gitVersion, u8 *buffer, size_t sz);
 	static Error LoadFileHeader(File::IOFile &pFile, SChunkHeader &header, std::string *title);
 };
@@ -635,11 +635,82 @@ void ConvertRGB565ToBGR565Basic(u16 *dst, const u16 *src, u32 numPixels) {
 	}
 }
 
+// The coefficients here are shift-and-add approximations of what the PSP itself
+// computes, so any SIMD version needs to stay bit-exact with this.
+void ConvertYCbCrLineToABGRBasic(u32 *dst, const u8 *srcY, const u8 *srcCb, const u8 *srcCr, u32 numPixels) {
+	u32 x = 0;
+
+#ifdef _M_SSE
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i c128 = _mm_set1_epi16(128);
+	const __m128i alpha = _mm_set1_epi8((char)0xFF);
+	for (; x + 16 <= numPixels; x += 16) {
+		const __m128i ys = _mm_loadu_si128((const __m128i *)(srcY + x));
+		const __m128i y_lo = _mm_unpacklo_epi8(ys, zero);
+		const __m128i y_hi = _mm_unpackhi_epi8(ys, zero);
+
+		// Four chroma samples, each covering 4 pixels.
+		__m128i cb = _mm_cvtsi32_si128(*(const u32 *)(srcCb + (x >> 2)));
+		__m128i cr = _mm_cvtsi32_si128(*(const u32 *)(srcCr + (x >> 2)));
+		cb = _mm_sub_epi16(_mm_unpacklo_epi8(cb, zero), c128);
+		cr = _mm_sub_epi16(_mm_unpacklo_epi8(cr, zero), c128);
+		const __m128i cbq = _mm_unpacklo_epi16(cb, cb);
+		const __m128i crq = _mm_unpacklo_epi16(cr, cr);
+		const __m128i cb_lo = _mm_unpacklo_epi32(cbq, cbq);
+		const __m128i cb_hi = _mm_unpackhi_epi32(cbq, cbq);
+		const __m128i cr_lo = _mm_unpacklo_epi32(crq, crq);
+		const __m128i cr_hi = _mm_unpackhi_epi32(crq, crq);
+
+#define YCBCR_OFFSETS(cb, cr, rOff, gOff, bOff) \
+		const __m128i rOff = _mm_add_epi16(_mm_add_epi16(cr, _mm_srai_epi16(cr, 2)), _mm_add_epi16(_mm_srai_epi16(cr, 3), _mm_srai_epi16(cr, 5))); \
+		const __m128i gOff = _mm_add_epi16( \
+			_mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(cb, 2), _mm_srai_epi16(cb, 4)), _mm_srai_epi16(cb, 5)), \
+			_mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(cr, 1), _mm_srai_epi16(cr, 3)), _mm_add_epi16(_mm_srai_epi16(cr, 4), _mm_srai_epi16(cr, 5)))); \
+		const __m128i bOff = _mm_add_epi16(_mm_add_epi16(cb, _mm_srai_epi16(cb, 1)), _mm_add_epi16(_mm_srai_epi16(cb, 2), _mm_srai_epi16(cb, 6)))
+
+		YCBCR_OFFSETS(cb_lo, cr_lo, rOffLo, gOffLo, bOffLo);
+		YCBCR_OFFSETS(cb_hi, cr_hi, rOffHi, gOffHi, bOffHi);
+#undef YCBCR_OFFSETS
+
+		const __m128i r8 = _mm_packus_epi16(_mm_add_epi16(y_lo, rOffLo), _mm_add_epi16(y_hi, rOffHi));
+		const __m128i g8 = _mm_packus_epi16(_mm_sub_epi16(y_lo, gOffLo), _mm_sub_epi16(y_hi, gOffHi));
+		const __m128i b8 = _mm_packus_epi16(_mm_add_epi16(y_lo, bOffLo), _mm_add_epi16(y_hi, bOffHi));
+
+		// Interleave to the R, G, B, A byte order of ABGR8888.
+		const __m128i rg_lo = _mm_unpacklo_epi8(r8, g8);
+		const __m128i rg_hi = _mm_unpackhi_epi8(r8, g8);
+		const __m128i ba_lo = _mm_unpacklo_epi8(b8, alpha);
+		const __m128i ba_hi = _mm_unpackhi_epi8(b8, alpha);
+		_mm_storeu_si128((__m128i *)(dst + x + 0), _mm_unpacklo_epi16(rg_lo, ba_lo));
+		_mm_storeu_si128((__m128i *)(dst + x + 4), _mm_unpackhi_epi16(rg_lo, ba_lo));
+		_mm_storeu_si128((__m128i *)(dst + x + 8), _mm_unpacklo_epi16(rg_hi, ba_hi));
+		_mm_storeu_si128((__m128i *)(dst + x + 12), _mm_unpackhi_epi16(rg_hi, ba_hi));
+	}
+#endif
+
+	for (; x < numPixels; ++x) {
+		const int y = srcY[x];
+		const int cb = (int)srcCb[x >> 2] - 128;
+		const int cr = (int)srcCr[x >> 2] - 128;
+
+		int r = y + cr + (cr >> 2) + (cr >> 3) + (cr >> 5);
+		int g = y - ((cb >> 2) + (cb >> 4) + (cb >> 5)) - ((cr >> 1) + (cr >> 3) + (cr >> 4) + (cr >> 5));
+		int b = y + cb + (cb >> 1) + (cb >> 2) + (cb >> 6);
+
+		r = r > 0xFF ? 0xFF : (r < 0 ? 0 : r);
+		g = g > 0xFF ? 0xFF : (g < 0 ? 0 : g);
+		b = b > 0xFF ? 0xFF : (b < 0 ? 0 : b);
+
+		dst[x] = 0xFF000000 | (b << 16) | (g << 8) | (r << 0);
+	}
+}
+
 // Reuse the logic from the header - if these aren't defined, we need externs.
 #ifndef ConvertRGBA4444ToABGR4444
 Convert16bppTo16bppFunc ConvertRGBA4444ToABGR4444 = &ConvertRGBA4444ToABGR4444Basic;
 Convert16bppTo16bppFunc ConvertRGBA5551ToABGR1555 = &ConvertRGBA5551ToABGR1555Basic;
 Convert16bppTo16bppFunc ConvertRGB565ToBGR565 = &ConvertRGB565ToBGR565Basic;
+ConvertYCbCrLineFunc ConvertYCbCrLineToABGR = &ConvertYCbCrLineToABGRBasic;
 #endif
 
 void SetupColorConv() {
@@ -648,6 +719,7 @@ void SetupColorConv() {
 		ConvertRGBA4444ToABGR4444 = &ConvertRGBA4444ToABGR4444NEON;
 		ConvertRGBA5551ToABGR1555 = &ConvertRGBA5551ToABGR1555NEON;
 		ConvertRGB565ToBGR565 = &ConvertRGB565ToBGR565NEON;
+		ConvertYCbCrLineToABGR = &ConvertYCbCrLineToABGRNEON;
 	}
 #endif
 }
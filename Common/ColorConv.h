@@ -162,3 +162,17 @@ extern Convert16bppTo16bppFunc ConvertRGBA5551ToABGR1555;
 #else
 extern Convert16bppTo16bppFunc ConvertRGB565ToBGR565;
 #endif
+
+// The PSP's JPEG/MJPEG YCbCr output shares one Cb/Cr pair across each run of 4
+// horizontal pixels. Converts a single row to ABGR8888.
+void ConvertYCbCrLineToABGRBasic(u32 *dst, const u8 *srcY, const u8 *srcCb, const u8 *srcCr, u32 numPixels);
+
+typedef void (*ConvertYCbCrLineFunc)(u32 *dst, const u8 *srcY, const u8 *srcCb, const u8 *srcCr, u32 numPixels);
+
+#if PPSSPP_ARCH(ARM64)
+#define ConvertYCbCrLineToABGR ConvertYCbCrLineToABGRNEON
+#elif !PPSSPP_ARCH(ARM)
+#define ConvertYCbCrLineToABGR ConvertYCbCrLineToABGRBasic
+#else
+extern ConvertYCbCrLineFunc ConvertYCbCrLineToABGR;
+#endif
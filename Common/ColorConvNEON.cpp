@@ -115,4 +115,55 @@ void ConvertRGB565ToBGR565NEON(u16 *dst, const u16 *src, u32 numPixels) {
 	}
 }
 
+void ConvertYCbCrLineToABGRNEON(u32 *dst, const u8 *srcY, const u8 *srcCb, const u8 *srcCr, u32 numPixels) {
+	const int16x8_t c128 = vdupq_n_s16(128);
+
+	u32 x = 0;
+	for (; x + 16 <= numPixels; x += 16) {
+		const uint8x16_t ys = vld1q_u8(srcY + x);
+		const int16x8_t y_lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(ys)));
+		const int16x8_t y_hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(ys)));
+
+		// Four chroma samples, each covering 4 pixels. Careful to only read 4 bytes.
+		const uint8x8_t cb8 = vcreate_u8(*(const u32 *)(srcCb + (x >> 2)));
+		const uint8x8_t cr8 = vcreate_u8(*(const u32 *)(srcCr + (x >> 2)));
+		const int16x4_t cb4 = vget_low_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb8)), c128));
+		const int16x4_t cr4 = vget_low_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr8)), c128));
+		const int16x4x2_t cbp = vzip_s16(cb4, cb4);
+		const int16x4x2_t crp = vzip_s16(cr4, cr4);
+		const int16x4x2_t cb01 = vzip_s16(cbp.val[0], cbp.val[0]);
+		const int16x4x2_t cb23 = vzip_s16(cbp.val[1], cbp.val[1]);
+		const int16x4x2_t cr01 = vzip_s16(crp.val[0], crp.val[0]);
+		const int16x4x2_t cr23 = vzip_s16(crp.val[1], crp.val[1]);
+		const int16x8_t cb_lo = vcombine_s16(cb01.val[0], cb01.val[1]);
+		const int16x8_t cb_hi = vcombine_s16(cb23.val[0], cb23.val[1]);
+		const int16x8_t cr_lo = vcombine_s16(cr01.val[0], cr01.val[1]);
+		const int16x8_t cr_hi = vcombine_s16(cr23.val[0], cr23.val[1]);
+
+		// Same shift-and-add coefficients as ConvertYCbCrLineToABGRBasic.
+#define YCBCR_OFFSETS(cb, cr, rOff, gOff, bOff) \
+		const int16x8_t rOff = vaddq_s16(vaddq_s16(cr, vshrq_n_s16(cr, 2)), vaddq_s16(vshrq_n_s16(cr, 3), vshrq_n_s16(cr, 5))); \
+		const int16x8_t gOff = vaddq_s16( \
+			vaddq_s16(vaddq_s16(vshrq_n_s16(cb, 2), vshrq_n_s16(cb, 4)), vshrq_n_s16(cb, 5)), \
+			vaddq_s16(vaddq_s16(vshrq_n_s16(cr, 1), vshrq_n_s16(cr, 3)), vaddq_s16(vshrq_n_s16(cr, 4), vshrq_n_s16(cr, 5)))); \
+		const int16x8_t bOff = vaddq_s16(vaddq_s16(cb, vshrq_n_s16(cb, 1)), vaddq_s16(vshrq_n_s16(cb, 2), vshrq_n_s16(cb, 6)))
+
+		YCBCR_OFFSETS(cb_lo, cr_lo, rOffLo, gOffLo, bOffLo);
+		YCBCR_OFFSETS(cb_hi, cr_hi, rOffHi, gOffHi, bOffHi);
+#undef YCBCR_OFFSETS
+
+		uint8x16x4_t res;
+		res.val[0] = vcombine_u8(vqmovun_s16(vaddq_s16(y_lo, rOffLo)), vqmovun_s16(vaddq_s16(y_hi, rOffHi)));
+		res.val[1] = vcombine_u8(vqmovun_s16(vsubq_s16(y_lo, gOffLo)), vqmovun_s16(vsubq_s16(y_hi, gOffHi)));
+		res.val[2] = vcombine_u8(vqmovun_s16(vaddq_s16(y_lo, bOffLo)), vqmovun_s16(vaddq_s16(y_hi, bOffHi)));
+		res.val[3] = vdupq_n_u8(0xFF);
+		vst4q_u8((u8 *)(dst + x), res);
+	}
+
+	// Finish off the rest, if there were any outside the simdable range.
+	if (x < numPixels) {
+		ConvertYCbCrLineToABGRBasic(dst + x, srcY + x, srcCb + (x >> 2), srcCr + (x >> 2), numPixels - x);
+	}
+}
+
 #endif // PPSSPP_ARCH(ARM_NEON)
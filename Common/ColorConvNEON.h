@@ -22,3 +22,4 @@
 void ConvertRGBA4444ToABGR4444NEON(u16 *dst, const u16 *src, u32 numPixels);
 void ConvertRGBA5551ToABGR1555NEON(u16 *dst, const u16 *src, u32 numPixels);
 void ConvertRGB565ToBGR565NEON(u16 *dst, const u16 *src, u32 numPixels);
+void ConvertYCbCrLineToABGRNEON(u32 *dst, const u8 *srcY, const u8 *srcCb, const u8 *srcCr, u32 numPixels);
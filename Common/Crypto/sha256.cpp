@@ -20,8 +20,137 @@
 
 #include <string.h>
 
+#include "ppsspp_config.h"
+#include "../CPUDetect.h"
 #include "sha256.h"
 
+// Hardware SHA-256 kernels (x86 SHA extensions / ARMv8 crypto extensions),
+// runtime-dispatched in sha256_update. Compact versions of the well-known
+// public domain intrinsics implementations.
+
+#if (PPSSPP_ARCH(X86) || PPSSPP_ARCH(AMD64)) && (defined(_MSC_VER) || defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define SHA256_HAVE_X86_SHA 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define SHA256_SHANI_ATTR
+#else
+// Not compiled with these features enabled globally - enable them for just this function.
+#define SHA256_SHANI_ATTR __attribute__((target("sha,sse4.1")))
+#endif
+#elif PPSSPP_ARCH(ARM64) && defined(__ARM_FEATURE_CRYPTO)
+#define SHA256_HAVE_ARM_SHA 1
+#include <arm_neon.h>
+#endif
+
+#if defined(SHA256_HAVE_X86_SHA) || defined(SHA256_HAVE_ARM_SHA)
+alignas(16) static const uint32_t sha256_k[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+    0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+    0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+    0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+    0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+#endif
+
+#ifdef SHA256_HAVE_X86_SHA
+SHA256_SHANI_ATTR
+static void sha256_process_shani( uint32_t state[8], const uint8_t *data, uint32_t blocks )
+{
+    const __m128i byteswap = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+
+    // SHA256RNDS2 wants the state packed as ABEF / CDGH.
+    __m128i tmp = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *) &state[0] ), 0xB1 );  // CDAB
+    __m128i st1 = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *) &state[4] ), 0x1B );  // EFGH
+    __m128i st0 = _mm_alignr_epi8( tmp, st1, 8 );     // ABEF
+    st1 = _mm_blend_epi16( st1, tmp, 0xF0 );          // CDGH
+
+    while( blocks-- )
+    {
+        const __m128i abef_save = st0;
+        const __m128i cdgh_save = st1;
+
+        __m128i m[4];
+        for( int i = 0; i < 4; i++ )
+            m[i] = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (data + i * 16) ), byteswap );
+        data += 64;
+
+        for( int i = 0; i < 16; i++ )
+        {
+            const __m128i msg = _mm_add_epi32( m[i & 3], _mm_load_si128( (const __m128i *) &sha256_k[i * 4] ) );
+            st1 = _mm_sha256rnds2_epu32( st1, st0, msg );
+            st0 = _mm_sha256rnds2_epu32( st0, st1, _mm_shuffle_epi32( msg, 0x0E ) );
+            if( i < 12 )
+            {
+                // W[t] for the next group of four rounds.
+                const __m128i t = _mm_alignr_epi8( m[(i + 3) & 3], m[(i + 2) & 3], 4 );
+                m[i & 3] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32( _mm_sha256msg1_epu32( m[i & 3], m[(i + 1) & 3] ), t ),
+                    m[(i + 3) & 3] );
+            }
+        }
+
+        st0 = _mm_add_epi32( st0, abef_save );
+        st1 = _mm_add_epi32( st1, cdgh_save );
+    }
+
+    tmp = _mm_shuffle_epi32( st0, 0x1B );             // FEBA
+    st1 = _mm_shuffle_epi32( st1, 0xB1 );             // DCHG
+    st0 = _mm_blend_epi16( tmp, st1, 0xF0 );          // DCBA
+    st1 = _mm_alignr_epi8( st1, tmp, 8 );             // HGFE
+
+    _mm_storeu_si128( (__m128i *) &state[0], st0 );
+    _mm_storeu_si128( (__m128i *) &state[4], st1 );
+}
+#endif
+
+#ifdef SHA256_HAVE_ARM_SHA
+static void sha256_process_ce( uint32_t state[8], const uint8_t *data, uint32_t blocks )
+{
+    uint32x4_t st0 = vld1q_u32( &state[0] );
+    uint32x4_t st1 = vld1q_u32( &state[4] );
+
+    while( blocks-- )
+    {
+        const uint32x4_t abcd_save = st0;
+        const uint32x4_t efgh_save = st1;
+
+        uint32x4_t m[4];
+        for( int i = 0; i < 4; i++ )
+            m[i] = vreinterpretq_u32_u8( vrev32q_u8( vld1q_u8( data + i * 16 ) ) );
+        data += 64;
+
+        for( int i = 0; i < 16; i++ )
+        {
+            const uint32x4_t msg = vaddq_u32( m[i & 3], vld1q_u32( &sha256_k[i * 4] ) );
+            const uint32x4_t abcd = st0;
+            st0 = vsha256hq_u32( st0, st1, msg );
+            st1 = vsha256h2q_u32( st1, abcd, msg );
+            if( i < 12 )
+                m[i & 3] = vsha256su1q_u32( vsha256su0q_u32( m[i & 3], m[(i + 1) & 3] ),
+                                            m[(i + 2) & 3], m[(i + 3) & 3] );
+        }
+
+        st0 = vaddq_u32( st0, abcd_save );
+        st1 = vaddq_u32( st1, efgh_save );
+    }
+
+    vst1q_u32( &state[0], st0 );
+    vst1q_u32( &state[4], st1 );
+}
+#endif
+
 #define GET_uint32_t(n,b,i)                       \
 {                                               \
     (n) = ( (uint32_t) (b)[(i)    ] << 24 )       \
@@ -209,6 +338,25 @@ void sha256_update( sha256_context *ctx, const uint8_t *input, uint32_t length )
         left = 0;
     }
 
+    // Hand all the full blocks to the hardware kernel in one call when available.
+#if defined(SHA256_HAVE_X86_SHA)
+    if( length >= 64 && cpu_info.bSHA && cpu_info.bSSE4_1 )
+    {
+        uint32_t blocks = length / 64;
+        sha256_process_shani( ctx->state, input, blocks );
+        length -= blocks * 64;
+        input  += blocks * 64;
+    }
+#elif defined(SHA256_HAVE_ARM_SHA)
+    if( length >= 64 && cpu_info.bSHA2 )
+    {
+        uint32_t blocks = length / 64;
+        sha256_process_ce( ctx->state, input, blocks );
+        length -= blocks * 64;
+        input  += blocks * 64;
+    }
+#endif
+
     while( length >= 64 )
     {
         sha256_process( ctx, input );
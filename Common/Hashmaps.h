@@ -31,6 +31,11 @@ enum class BucketState : uint8_t {
 // we always use very small values, so it's probably better to have them in the same
 // cache-line as the corresponding key.
 // Enforces that value are pointers to make sure that combined storage makes sense.
+//
+// Growth is incremental: instead of reinserting every entry at once (a visible
+// frame hitch when the Vulkan pipeline map grows mid-game), the old table is
+// kept around and a few buckets are moved over on each Insert/Remove. Lookups
+// fall back to the old table until it's drained.
 template <class Key, class Value, Value NullValue>
 class DenseHashMap {
 public:
@@ -39,6 +44,18 @@ public:
 		state.resize(initialCapacity);
 	}
 
+	// Pre-sizes the table (e.g. when a cache file tells us the steady-state
+	// count up front) so it never has to grow mid-game. Power-of-2 rounded.
+	void Reserve(int expectedCount) {
+		int needed = capacity_;
+		while (needed < expectedCount * 2) {
+			needed *= 2;
+		}
+		if (needed > capacity_) {
+			Grow(needed / capacity_);
+		}
+	}
+
 	// Returns nullptr if no entry was found.
 	Value Get(const Key &key) {
 		uint32_t mask = capacity_ - 1;
@@ -49,12 +66,18 @@ public:
 			if (state[p] == BucketState::TAKEN && KeyEquals(key, map[p].key))
 				return map[p].value;
 			else if (state[p] == BucketState::FREE)
-				return NullValue;
-			p = (p + 1) & mask;  // If the state is REMOVED, we just keep on walking. 
+				break;
+			p = (p + 1) & mask;  // If the state is REMOVED, we just keep on walking.
 			if (p == pos) {
 				_assert_msg_(SYSTEM, false, "DenseHashMap: Hit full on Get()");
 			}
 		}
+		// Not there - might not have been migrated out of the old table yet.
+		if (Migrating()) {
+			int p = FindOld(key);
+			if (p >= 0)
+				return oldMap_[p].value;
+		}
 		return NullValue;
 	}
 
@@ -64,6 +87,16 @@ public:
 		if (count_ > capacity_ / 2) {
 			Grow(2);
 		}
+		if (Migrating()) {
+			MigrateStep();
+		}
+		if (Migrating()) {
+			if (FindOld(key) >= 0) {
+				// Bad! We already got this one. Let's avoid this case.
+				_assert_msg_(SYSTEM, false, "DenseHashMap: Duplicate key inserted");
+				return false;
+			}
+		}
 		uint32_t mask = capacity_ - 1;
 		uint32_t pos = HashKey(key) & mask;
 		uint32_t p = pos;
@@ -96,6 +129,18 @@ public:
 	}
 
 	bool Remove(const Key &key) {
+		if (Migrating()) {
+			MigrateStep();
+		}
+		if (Migrating()) {
+			int op = FindOld(key);
+			if (op >= 0) {
+				// Tombstone it in the old table so migration skips it.
+				oldState_[op] = BucketState::REMOVED;
+				count_--;
+				return true;
+			}
+		}
 		uint32_t mask = capacity_ - 1;
 		uint32_t pos = HashKey(key) & mask;
 		uint32_t p = pos;
@@ -127,10 +172,19 @@ public:
 				func(map[i].key, map[i].value);
 			}
 		}
+		for (size_t i = 0; i < oldMap_.size(); i++) {
+			if (oldState_[i] == BucketState::TAKEN) {
+				func(oldMap_[i].key, oldMap_[i].value);
+			}
+		}
 	}
 
 	void Clear() {
 		memset(state.data(), (int)BucketState::FREE, state.size());
+		oldMap_.clear();
+		oldState_.clear();
+		oldCapacity_ = 0;
+		migratePos_ = 0;
 		count_ = 0;
 		removedCount_ = 0;
 	}
@@ -147,27 +201,79 @@ public:
 	}
 
 private:
+	bool Migrating() const {
+		return oldCapacity_ != 0;
+	}
+
+	// Looks up the key in the old (not yet migrated) table. Returns -1 if absent.
+	int FindOld(const Key &key) const {
+		uint32_t mask = oldCapacity_ - 1;
+		uint32_t pos = HashKey(key) & mask;
+		uint32_t p = pos;
+		while (oldState_[p] != BucketState::FREE) {
+			if (oldState_[p] == BucketState::TAKEN && KeyEquals(key, oldMap_[p].key))
+				return (int)p;
+			p = (p + 1) & mask;
+			if (p == pos)
+				break;
+		}
+		return -1;
+	}
+
+	// Moves a handful of entries from the old table to the current one.
+	void MigrateStep() {
+		int moved = 0;
+		while (migratePos_ < oldCapacity_ && moved < 8) {
+			if (oldState_[migratePos_] == BucketState::TAKEN) {
+				InsertRaw(oldMap_[migratePos_].key, oldMap_[migratePos_].value);
+				// Tombstone, not FREE, to keep the old probe chains intact.
+				oldState_[migratePos_] = BucketState::REMOVED;
+				moved++;
+			}
+			migratePos_++;
+		}
+		if (migratePos_ >= oldCapacity_) {
+			oldMap_.clear();
+			oldState_.clear();
+			oldCapacity_ = 0;
+			migratePos_ = 0;
+		}
+	}
+
+	// Insert into the current table only - no growth, no duplicate check,
+	// and no count update, for use during migration.
+	void InsertRaw(const Key &key, Value value) {
+		uint32_t mask = capacity_ - 1;
+		uint32_t p = HashKey(key) & mask;
+		while (state[p] == BucketState::TAKEN) {
+			p = (p + 1) & mask;
+		}
+		if (state[p] == BucketState::REMOVED) {
+			removedCount_--;
+		}
+		state[p] = BucketState::TAKEN;
+		map[p].key = key;
+		map[p].value = value;
+	}
+
 	void Grow(int factor) {
-		// We simply move out the existing data, then we re-insert the old.
-		// This is extremely non-atomic and will need synchronization.
-		std::vector<Pair> old = std::move(map);
-		std::vector<BucketState> oldState = std::move(state);
+		// Finish any migration still in flight before starting another.
+		while (Migrating()) {
+			MigrateStep();
+		}
+		oldMap_ = std::move(map);
+		oldState_ = std::move(state);
+		oldCapacity_ = capacity_;
+		migratePos_ = 0;
 		// Can't assume move will clear, it just may clear.
 		map.clear();
 		state.clear();
 
-		int oldCount = count_;
 		capacity_ *= factor;
 		map.resize(capacity_);
 		state.resize(capacity_);
-		count_ = 0;  // Insert will update it.
+		// The tombstones stayed behind in the old table, they die with it.
 		removedCount_ = 0;
-		for (size_t i = 0; i < old.size(); i++) {
-			if (oldState[i] == BucketState::TAKEN) {
-				Insert(old[i].key, old[i].value);
-			}
-		}
-		_assert_msg_(SYSTEM, oldCount == count_, "DenseHashMap: count should not change in Grow()");
 	}
 	struct Pair {
 		Key key;
@@ -175,7 +281,11 @@ private:
 	};
 	std::vector<Pair> map;
 	std::vector<BucketState> state;
+	std::vector<Pair> oldMap_;
+	std::vector<BucketState> oldState_;
 	int capacity_;
+	int oldCapacity_ = 0;
+	int migratePos_ = 0;
 	int count_ = 0;
 	int removedCount_ = 0;
 };
@@ -190,6 +300,17 @@ public:
 		state.resize(initialCapacity);
 	}
 
+	// Pre-sizes the table, see DenseHashMap::Reserve.
+	void Reserve(int expectedCount) {
+		int needed = capacity_;
+		while (needed < expectedCount * 2) {
+			needed *= 2;
+		}
+		if (needed > capacity_) {
+			Grow(needed / capacity_);
+		}
+	}
+
 	// Returns nullptr if no entry was found.
 	Value Get(uint32_t hash) {
 		uint32_t mask = capacity_ - 1;
@@ -200,12 +321,18 @@ public:
 			if (state[p] == BucketState::TAKEN && hash == map[p].hash)
 				return map[p].value;
 			else if (state[p] == BucketState::FREE)
-				return NullValue;
-			p = (p + 1) & mask;  // If the state is REMOVED, we just keep on walking. 
+				break;
+			p = (p + 1) & mask;  // If the state is REMOVED, we just keep on walking.
 			if (p == pos) {
 				_assert_msg_(SYSTEM, false, "PrehashMap: Hit full on Get()");
 			}
 		}
+		// Not there - might not have been migrated out of the old table yet.
+		if (Migrating()) {
+			int p = FindOld(hash);
+			if (p >= 0)
+				return oldMap_[p].value;
+		}
 		return NullValue;
 	}
 
@@ -215,6 +342,12 @@ public:
 		if (count_ > capacity_ / 2) {
 			Grow(2);
 		}
+		if (Migrating()) {
+			MigrateStep();
+		}
+		if (Migrating() && FindOld(hash) >= 0) {
+			return false;  // Bad!
+		}
 		uint32_t mask = capacity_ - 1;
 		uint32_t pos = hash & mask;
 		uint32_t p = pos;
@@ -243,6 +376,18 @@ public:
 	}
 
 	bool Remove(uint32_t hash) {
+		if (Migrating()) {
+			MigrateStep();
+		}
+		if (Migrating()) {
+			int op = FindOld(hash);
+			if (op >= 0) {
+				// Tombstone it in the old table so migration skips it.
+				oldState_[op] = BucketState::REMOVED;
+				count_--;
+				return true;
+			}
+		}
 		uint32_t mask = capacity_ - 1;
 		uint32_t pos = hash & mask;
 		uint32_t p = pos;
@@ -273,10 +418,19 @@ public:
 				func(map[i].hash, map[i].value);
 			}
 		}
+		for (size_t i = 0; i < oldMap_.size(); i++) {
+			if (oldState_[i] == BucketState::TAKEN) {
+				func(oldMap_[i].hash, oldMap_[i].value);
+			}
+		}
 	}
 
 	void Clear() {
 		memset(state.data(), (int)BucketState::FREE, state.size());
+		oldMap_.clear();
+		oldState_.clear();
+		oldCapacity_ = 0;
+		migratePos_ = 0;
 		count_ = 0;
 		removedCount_ = 0;
 	}
@@ -294,29 +448,80 @@ public:
 	}
 
 private:
+	bool Migrating() const {
+		return oldCapacity_ != 0;
+	}
+
+	// Looks up the hash in the old (not yet migrated) table. Returns -1 if absent.
+	int FindOld(uint32_t hash) const {
+		uint32_t mask = oldCapacity_ - 1;
+		uint32_t pos = hash & mask;
+		uint32_t p = pos;
+		while (oldState_[p] != BucketState::FREE) {
+			if (oldState_[p] == BucketState::TAKEN && hash == oldMap_[p].hash)
+				return (int)p;
+			p = (p + 1) & mask;
+			if (p == pos)
+				break;
+		}
+		return -1;
+	}
+
+	// Moves a handful of entries from the old table to the current one.
+	void MigrateStep() {
+		int moved = 0;
+		while (migratePos_ < oldCapacity_ && moved < 8) {
+			if (oldState_[migratePos_] == BucketState::TAKEN) {
+				InsertRaw(oldMap_[migratePos_].hash, oldMap_[migratePos_].value);
+				// Tombstone, not FREE, to keep the old probe chains intact.
+				oldState_[migratePos_] = BucketState::REMOVED;
+				moved++;
+			}
+			migratePos_++;
+		}
+		if (migratePos_ >= oldCapacity_) {
+			oldMap_.clear();
+			oldState_.clear();
+			oldCapacity_ = 0;
+			migratePos_ = 0;
+		}
+	}
+
+	// Insert into the current table only - no growth, no duplicate check,
+	// and no count update, for use during migration.
+	void InsertRaw(uint32_t hash, Value value) {
+		uint32_t mask = capacity_ - 1;
+		uint32_t p = hash & mask;
+		while (state[p] == BucketState::TAKEN) {
+			p = (p + 1) & mask;
+		}
+		if (state[p] == BucketState::REMOVED) {
+			removedCount_--;
+		}
+		state[p] = BucketState::TAKEN;
+		map[p].hash = hash;
+		map[p].value = value;
+	}
+
 	void Grow(int factor) {
-		// We simply move out the existing data, then we re-insert the old.
-		// This is extremely non-atomic and will need synchronization.
-		std::vector<Pair> old = std::move(map);
-		std::vector<BucketState> oldState = std::move(state);
+		// Finish any migration still in flight before starting another.
+		while (Migrating()) {
+			MigrateStep();
+		}
+		oldMap_ = std::move(map);
+		oldState_ = std::move(state);
+		oldCapacity_ = capacity_;
+		migratePos_ = 0;
 		// Can't assume move will clear, it just may clear.
 		map.clear();
 		state.clear();
 
-		int oldCount = count_;
-		int oldCapacity = capacity_;
 		capacity_ *= factor;
 		map.resize(capacity_);
 		state.resize(capacity_);
-		count_ = 0;  // Insert will update it.
+		// The tombstones stayed behind in the old table, they die with it.
 		removedCount_ = 0;
-		for (size_t i = 0; i < old.size(); i++) {
-			if (oldState[i] == BucketState::TAKEN) {
-				Insert(old[i].hash, old[i].value);
-			}
-		}
-		INFO_LOG(G3D, "Grew hashmap capacity from %d to %d", oldCapacity, capacity_);
-		_assert_msg_(SYSTEM, oldCount == count_, "PrehashMap: count should not change in Grow()");
+		INFO_LOG(G3D, "Growing hashmap capacity from %d to %d", oldCapacity_, capacity_);
 	}
 	struct Pair {
 		uint32_t hash;
@@ -324,7 +529,11 @@ private:
 	};
 	std::vector<Pair> map;
 	std::vector<BucketState> state;
+	std::vector<Pair> oldMap_;
+	std::vector<BucketState> oldState_;
 	int capacity_;
+	int oldCapacity_ = 0;
+	int migratePos_ = 0;
 	int count_ = 0;
 	int removedCount_ = 0;
 };
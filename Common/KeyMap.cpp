@@ -32,6 +32,8 @@
 #include "../Core/Config.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 
 namespace KeyMap {
 
@@ -770,16 +772,38 @@ int CheckAxisSwap(int btn) {
 	return btn;
 }
 
-static bool FindKeyMapping(int deviceId, int key, std::vector<int> *psp_button) {
-	// Brute force, let's optimize later
+// Reverse index: (deviceId, keyCode) -> psp buttons. Analog sticks deliver
+// hundreds of axis events a second, so scanning the whole controller map per
+// event adds up. Rebuilt lazily whenever g_controllerMapGeneration changes.
+static std::unordered_map<uint64_t, std::vector<int>> g_reverseMap;
+static int g_reverseMapGeneration = -1;
+
+static inline uint64_t ReverseMapKey(int deviceId, int key) {
+	return ((uint64_t)(uint32_t)deviceId << 32) | (uint32_t)key;
+}
+
+static void RebuildReverseMap() {
+	g_reverseMap.clear();
 	for (auto iter = g_controllerMap.begin(); iter != g_controllerMap.end(); ++iter) {
 		for (auto iter2 = iter->second.begin(); iter2 != iter->second.end(); ++iter2) {
-			if (*iter2 == KeyDef(deviceId, key)) {
-				psp_button->push_back(CheckAxisSwap(iter->first));
-			}
+			g_reverseMap[ReverseMapKey(iter2->deviceId, iter2->keyCode)].push_back(iter->first);
 		}
 	}
-	return psp_button->size() > 0;
+	g_reverseMapGeneration = g_controllerMapGeneration;
+}
+
+static bool FindKeyMapping(int deviceId, int key, std::vector<int> *psp_button) {
+	if (g_reverseMapGeneration != g_controllerMapGeneration)
+		RebuildReverseMap();
+	auto iter = g_reverseMap.find(ReverseMapKey(deviceId, key));
+	if (iter == g_reverseMap.end())
+		return false;
+	// Axis swap is a display-time toggle, so it's applied here rather than
+	// baked into the index.
+	for (size_t i = 0; i < iter->second.size(); i++) {
+		psp_button->push_back(CheckAxisSwap(iter->second[i]));
+	}
+	return true;
 }
 
 bool KeyToPspButton(int deviceId, int key, std::vector<int> *pspKeys) {
@@ -904,6 +928,9 @@ void LoadFromIni(IniFile &file) {
 			SetKeyMapping(psp_button_names[i].key, KeyDef(deviceId, keyCode), false);
 		}
 	}
+	// The erases above don't go through SetKeyMapping, so make sure anything
+	// keyed on the generation (like the reverse index) notices.
+	g_controllerMapGeneration++;
 
 	UpdateNativeMenuKeys();
 }
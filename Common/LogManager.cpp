@@ -20,6 +20,7 @@
 #include <algorithm>
 
 #include "base/logging.h"
+#include "thread/threadutil.h"
 #include "util/text/utf8.h"
 #include "LogManager.h"
 #include "ConsoleListener.h"
@@ -112,6 +113,13 @@ static const LogNameTableEntry logTable[] = {
 };
 
 LogManager::LogManager() {
+	for (size_t i = 0; i < PENDING_RING_SIZE; i++) {
+		pending_[i].seq.store((uint64_t)i, std::memory_order_relaxed);
+	}
+	pendingHead_.store(0, std::memory_order_relaxed);
+	pendingTail_.store(0, std::memory_order_relaxed);
+	drainWaiting_.store(false, std::memory_order_relaxed);
+
 	for (size_t i = 0; i < ARRAY_SIZE(logTable); i++) {
 		if (i != logTable[i].logType) {
 			FLOG("Bad logtable at %i", (int)i);
@@ -150,9 +158,21 @@ LogManager::LogManager() {
 #endif
 	AddListener(ringLog_);
 #endif
+
+	drainThread_ = std::thread([this] { DrainThreadFunc(); });
 }
 
 LogManager::~LogManager() {
+	// Stop the drain thread, then flush whatever it didn't get to.
+	{
+		std::lock_guard<std::mutex> lk(drainLock_);
+		drainStop_ = true;
+		drainWake_.notify_one();
+	}
+	drainThread_.join();
+	while (DrainOnePending()) {
+	}
+
 	for (int i = 0; i < LogTypes::NUMBER_OF_LOGS; ++i) {
 #if !defined(MOBILE_DEVICE) || defined(_DEBUG)
 		RemoveListener(fileLog_);
@@ -208,10 +228,6 @@ void LogManager::Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const
 	if (level > log.level || !log.enabled)
 		return;
 
-	LogMessage message;
-	message.level = level;
-	message.log = log.m_shortName;
-
 #ifdef _WIN32
 	static const char sep = '\\';
 #else
@@ -226,39 +242,138 @@ void LogManager::Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const
 			file = fileshort + 1;
 	}
 
-	std::lock_guard<std::mutex> lk(log_lock_);
-	Common::Timer::GetTimeFormatted(message.timestamp);
+	// Claim a slot in the pending ring, lock-free.
+	uint64_t pos = pendingTail_.load(std::memory_order_relaxed);
+	PendingMessage *cell;
+	for (;;) {
+		cell = &pending_[pos & (PENDING_RING_SIZE - 1)];
+		uint64_t seq = cell->seq.load(std::memory_order_acquire);
+		int64_t dif = (int64_t)seq - (int64_t)pos;
+		if (dif == 0) {
+			if (pendingTail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		} else if (dif < 0) {
+			// Ring full - the drain thread is behind. Kick it and wait for
+			// room; we never drop messages, worst case this degrades to the
+			// old synchronous speed.
+			{
+				std::lock_guard<std::mutex> lk(drainLock_);
+				drainWake_.notify_one();
+			}
+			std::this_thread::yield();
+			pos = pendingTail_.load(std::memory_order_relaxed);
+		} else {
+			pos = pendingTail_.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->level = level;
+	cell->log = log.m_shortName;
+	cell->bigMsg = nullptr;
 
 	if (hleCurrentThreadName) {
-		snprintf(message.header, sizeof(message.header), "%-12.12s %c[%s]: %s:%d",
+		snprintf(cell->header, sizeof(cell->header), "%-12.12s %c[%s]: %s:%d",
 			hleCurrentThreadName, level_to_char[(int)level],
 			log.m_shortName,
 			file, line);
 	} else {
-		snprintf(message.header, sizeof(message.header), "%s:%d %c[%s]:",
+		snprintf(cell->header, sizeof(cell->header), "%s:%d %c[%s]:",
 			file, line, level_to_char[(int)level],
 			log.m_shortName);
 	}
 
-	char msgBuf[1024];
+	// The message itself has to be formatted here - deferring it would
+	// require the arguments to stay alive, and %s pointers don't.
 	va_list args_copy;
-
 	va_copy(args_copy, args);
-	size_t neededBytes = vsnprintf(msgBuf, sizeof(msgBuf), format, args);
-	message.msg.resize(neededBytes + 1);
-	if (neededBytes > sizeof(msgBuf)) {
-		// Needed more space? Re-run vsnprintf.
-		vsnprintf(&message.msg[0], neededBytes + 1, format, args_copy);
+	size_t neededBytes = vsnprintf(cell->msg, PENDING_MSG_SIZE - 1, format, args);
+	if (neededBytes >= PENDING_MSG_SIZE - 1) {
+		// Didn't fit in the slot - take a heap copy. Rare enough not to matter.
+		cell->bigMsg = new char[neededBytes + 2];
+		vsnprintf(cell->bigMsg, neededBytes + 1, format, args_copy);
+		cell->bigMsg[neededBytes] = '\n';
+		cell->bigMsg[neededBytes + 1] = '\0';
 	} else {
-		memcpy(&message.msg[0], msgBuf, neededBytes);
+		cell->msg[neededBytes] = '\n';
+		cell->msg[neededBytes + 1] = '\0';
 	}
-	message.msg[neededBytes] = '\n';
 	va_end(args_copy);
 
+	cell->seq.store(pos + 1, std::memory_order_release);
+
+	// Pairs with the fence in DrainThreadFunc: either we see the waiting
+	// flag, or the drain thread sees our message before parking.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (drainWaiting_.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lk(drainLock_);
+		drainWake_.notify_one();
+	}
+
+	// Errors are rare and often immediately precede a crash, so wait for the
+	// drain thread to get them out before returning. Unless this is the drain
+	// thread itself (a listener logging), which would wait forever.
+	if (level <= LogTypes::LERROR && std::this_thread::get_id() != drainThread_.get_id()) {
+		while ((int64_t)(pendingHead_.load(std::memory_order_acquire) - pos) <= 0) {
+			{
+				std::lock_guard<std::mutex> lk(drainLock_);
+				drainWake_.notify_one();
+			}
+			std::this_thread::yield();
+		}
+	}
+}
+
+// Drain thread only. Formats the timestamp and feeds the listeners.
+bool LogManager::DrainOnePending() {
+	uint64_t pos = pendingHead_.load(std::memory_order_relaxed);
+	PendingMessage *cell = &pending_[pos & (PENDING_RING_SIZE - 1)];
+	uint64_t seq = cell->seq.load(std::memory_order_acquire);
+	if ((int64_t)seq - (int64_t)(pos + 1) < 0)
+		return false;
+
+	LogMessage message;
+	Common::Timer::GetTimeFormatted(message.timestamp);
+	message.level = cell->level;
+	message.log = cell->log;
+	memcpy(message.header, cell->header, sizeof(message.header));
+	if (cell->bigMsg) {
+		message.msg = cell->bigMsg;
+		delete [] cell->bigMsg;
+		cell->bigMsg = nullptr;
+	} else {
+		message.msg = cell->msg;
+	}
+
+	cell->seq.store(pos + PENDING_RING_SIZE, std::memory_order_release);
+	pendingHead_.store(pos + 1, std::memory_order_release);
+
 	std::lock_guard<std::mutex> listeners_lock(listeners_lock_);
 	for (auto &iter : listeners_) {
 		iter->Log(message);
 	}
+	return true;
+}
+
+void LogManager::DrainThreadFunc() {
+	setCurrentThreadName("Log");
+	for (;;) {
+		if (DrainOnePending())
+			continue;
+		std::unique_lock<std::mutex> lk(drainLock_);
+		if (drainStop_)
+			break;
+		drainWaiting_.store(true, std::memory_order_relaxed);
+		// Pairs with the fence in Log, see above.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		uint64_t head = pendingHead_.load(std::memory_order_relaxed);
+		if (pending_[head & (PENDING_RING_SIZE - 1)].seq.load(std::memory_order_acquire) == head + 1) {
+			// A message arrived while we were getting ready to park.
+			drainWaiting_.store(false, std::memory_order_relaxed);
+			continue;
+		}
+		drainWake_.wait(lk);
+		drainWaiting_.store(false, std::memory_order_relaxed);
+	}
 }
 
 bool LogManager::IsEnabled(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type) {
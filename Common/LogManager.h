@@ -19,8 +19,11 @@
 
 #include "ppsspp_config.h"
 
-#include <vector>
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "file/ini_file.h"
 #include "Log.h"
@@ -120,7 +123,35 @@ private:
 	RingbufferLogListener *ringLog_ = nullptr;
 	static LogManager *logManager_;  // Singleton. Ugh.
 
-	std::mutex log_lock_;
+	// Pending messages go into a lock-free ring (multiple producers, drained
+	// by a single background thread). The producer formats the message text -
+	// lazy formatting isn't safe, %s arguments don't outlive the call - but
+	// timestamps, console/file IO and the listener lock all happen on the
+	// drain thread, so logging from the emu threads stays cheap.
+	enum {
+		PENDING_RING_SIZE = 512,  // Must be a power of 2.
+		PENDING_MSG_SIZE = 1024,
+	};
+	struct PendingMessage {
+		std::atomic<uint64_t> seq;
+		LogTypes::LOG_LEVELS level;
+		const char *log;
+		char header[64];
+		char msg[PENDING_MSG_SIZE];
+		char *bigMsg;  // Heap copy for the rare oversized message, freed on drain.
+	};
+	PendingMessage pending_[PENDING_RING_SIZE];
+	std::atomic<uint64_t> pendingHead_;
+	std::atomic<uint64_t> pendingTail_;
+	std::atomic<bool> drainWaiting_;
+	bool drainStop_ = false;
+	std::mutex drainLock_;
+	std::condition_variable drainWake_;
+	std::thread drainThread_;
+
+	void DrainThreadFunc();
+	bool DrainOnePending();
+
 	std::mutex listeners_lock_;
 	std::vector<LogListener*> listeners_;
 public:
@@ -93,6 +93,9 @@ void *MemArena::CreateView(s64 offset, size_t size, void *base)
 		NOTICE_LOG(MEMMAP, "mmap on %s (fd: %d) failed", ram_temp_file.c_str(), (int)fd);
 		return 0;
 	}
+	// Emulated RAM is walked constantly by the JIT, so huge-page backing helps a
+	// lot with dTLB pressure. Advisory only - needs shmem THP for these views.
+	AdviseHugePages(retval, size);
 	return retval;
 }
 
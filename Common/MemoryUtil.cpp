@@ -208,9 +208,29 @@ void *AllocateExecutableMemory(size_t size) {
 		}
 	}
 #endif
+	if (ptr) {
+		// The JIT space is large and hot, a prime candidate for huge pages.
+		AdviseHugePages(ptr, size);
+	}
 	return ptr;
 }
 
+void AdviseHugePages(void *ptr, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	// Align inward to whole pages - madvise wants page-aligned addresses, and the
+	// kernel only assembles huge pages from fully covered, aligned 2MB extents anyway.
+	uintptr_t start = round_page(ptr);
+	uintptr_t end = ((uintptr_t)ptr + size) & ~MEM_PAGE_MASK;
+	if (end <= start)
+		return;
+	if (madvise((void *)start, end - start, MADV_HUGEPAGE) != 0) {
+		// Expected on kernels without THP enabled (for file-backed views, this
+		// additionally needs shmem THP). Nothing lost, we keep 4KB pages.
+		DEBUG_LOG(MEMMAP, "madvise(MADV_HUGEPAGE) failed, errno=%d", (int)errno);
+	}
+#endif
+}
+
 void *AllocateMemoryPages(size_t size, uint32_t memProtFlags) {
 	size = round_page(size);
 #ifdef _WIN32
@@ -45,6 +45,11 @@ void FreeAlignedMemory(void* ptr);
 
 int GetMemoryProtectPageSize();
 
+// Hint the OS to back a large, hot allocation (emulated RAM, JIT code space) with
+// huge pages to cut down on dTLB misses. Purely advisory - on kernels or platforms
+// without support this does nothing and the mapping keeps regular 4KB pages.
+void AdviseHugePages(void *ptr, size_t size);
+
 template <typename T>
 class SimpleBuf {
 public:
@@ -11,6 +11,11 @@ void GlobalThreadPool::Loop(const std::function<void(int,int)>& loop, int lower,
 	pool->ParallelLoop(loop, lower, upper);
 }
 
+void GlobalThreadPool::Enqueue(std::function<void()> task) {
+	std::call_once(init_flag, Inititialize);
+	pool->Enqueue(std::move(task));
+}
+
 void GlobalThreadPool::Inititialize() {
 	pool = make_unique<ThreadPool>(g_Config.iNumWorkerThreads);
 }
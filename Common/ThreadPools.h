@@ -8,6 +8,9 @@ public:
 	// in parallel on the global thread pool
 	static void Loop(const std::function<void(int,int)>& loop, int lower, int upper);
 
+	// queues a standalone task on the global thread pool, returns immediately
+	static void Enqueue(std::function<void()> task);
+
 private:
 	static std::unique_ptr<ThreadPool> pool;
 	static std::once_flag init_flag;
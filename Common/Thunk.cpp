@@ -178,6 +178,81 @@ const void *ThunkManager::ProtectFunction(const void *function, int num_params)
 	return (const void *)call_point;
 }
 
+const void *ThunkManager::ProtectFunction(const void *function, int num_params, u32 gprMask, u32 xmmMask) {
+#ifndef _M_X64
+	// The 32-bit thunk only saves two registers to begin with, not worth specializing.
+	return ProtectFunction(function, num_params);
+#else
+	// Clamp to the set the full thunk protects. Everything else is either callee-saved
+	// (the called function preserves it) or scratch at every callsite.
+	static const u32 protectableGPRs =
+		(1 << RCX) | (1 << RDX) | (1 << R8) | (1 << R9) | (1 << R10) | (1 << R11) |
+#ifndef _WIN32
+		(1 << RSI) | (1 << RDI) |
+#endif
+		(1 << RBX);
+	gprMask &= protectableGPRs;
+	xmmMask &= ((1 << ABI_GetNumXMMRegs()) - 1) & ~3;  // XMM2 and up, like save_regs.
+
+	std::pair<const void *, u64> key(function, ((u64)gprMask << 32) | xmmMask);
+	auto iter = maskedThunks.find(key);
+	if (iter != maskedThunks.end())
+		return (const void *)iter->second;
+	if (!region)
+		PanicAlert("Trying to protect functions before the emu is started. Bad bad bad.");
+
+	BeginWrite();
+	const u8 *call_point = GetCodePtr();
+
+	// Same frame as the full thunk, we just skip the dead slots. The full thunk stores from
+	// within save_regs where its return address sits below the slots; we store directly, so
+	// our slots start one position down. The restore loop must mirror the save loop exactly.
+	const int frameSize = ThunkStackOffset() + ThunkBytesNeeded();
+	const int base = ThunkStackOffset() - 8;
+
+	SUB(64, R(RSP), Imm32(frameSize));
+	int pos = base;
+	for (int i = 2; i < ABI_GetNumXMMRegs(); i++) {
+		if (xmmMask & (1 << i)) {
+			MOVAPS(MDisp(RSP, pos), (X64Reg)(XMM0 + i));
+			pos += 16;
+		}
+	}
+	STMXCSR(MDisp(RSP, pos));
+	int gprPos = pos + 8;
+	for (int i = 0; i < 16; i++) {
+		if (gprMask & (1 << i)) {
+			MOV(64, MDisp(RSP, gprPos), R((X64Reg)i));
+			gprPos += 8;
+		}
+	}
+
+	ABI_CallFunction(function);
+
+	pos = base;
+	for (int i = 2; i < ABI_GetNumXMMRegs(); i++) {
+		if (xmmMask & (1 << i)) {
+			MOVAPS((X64Reg)(XMM0 + i), MDisp(RSP, pos));
+			pos += 16;
+		}
+	}
+	LDMXCSR(MDisp(RSP, pos));
+	gprPos = pos + 8;
+	for (int i = 0; i < 16; i++) {
+		if (gprMask & (1 << i)) {
+			MOV(64, R((X64Reg)i), MDisp(RSP, gprPos));
+			gprPos += 8;
+		}
+	}
+	ADD(64, R(RSP), Imm32(frameSize));
+	RET();
+	EndWrite();
+
+	maskedThunks[key] = call_point;
+	return (const void *)call_point;
+#endif
+}
+
 void ThunkManager::Enter(ThunkEmitter *emit, bool withinCall)
 {
 #ifdef _M_X64
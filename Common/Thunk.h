@@ -40,6 +40,7 @@ typedef Gen::XCodeBlock ThunkCodeBlock;
 class ThunkManager : public ThunkCodeBlock
 {
 	std::map<const void *, const u8 *> thunks;
+	std::map<std::pair<const void *, u64>, const u8 *> maskedThunks;
 
 	const u8 *save_regs;
 	const u8 *load_regs;
@@ -53,6 +54,12 @@ public:
 	}
 	const void *ProtectFunction(const void *function, int num_params);
 
+	// Like the above, but only spills the registers in the masks (bit index == Gen::X64Reg,
+	// xmmMask counts XMM0 as bit 0.) Masks are clamped to the set the full thunk protects,
+	// so callers can simply pass what their reg caches have in use. Falls back to the full
+	// thunk on 32-bit, where only two registers get saved anyway. x64 only otherwise.
+	const void *ProtectFunction(const void *function, int num_params, u32 gprMask, u32 xmmMask);
+
 	template <typename Tr>
 	const void *ProtectFunction(Tr (*func)()) {
 		return ProtectFunction((const void *)func, 0);
@@ -273,6 +273,17 @@ void VulkanContext::DestroyInstance() {
 	instance_ = VK_NULL_HANDLE;
 }
 
+void VulkanContext::UpdateInflightFrames(int n) {
+	if (n < 2)
+		n = 2;
+	if (n > MAX_INFLIGHT_FRAMES)
+		n = MAX_INFLIGHT_FRAMES;
+	inflightFrames_ = n;
+	if (curFrame_ >= inflightFrames_) {
+		curFrame_ = 0;
+	}
+}
+
 void VulkanContext::BeginFrame() {
 	FrameData *frame = &frame_[curFrame_];
 	// Process pending deletes.
@@ -243,6 +243,11 @@ public:
 		return inflightFrames_;
 	}
 
+	// Must be called before any frames have been rendered - the per-frame consumers
+	// (VulkanRenderManager, the draw engine's push buffers) size themselves for
+	// MAX_INFLIGHT_FRAMES but cycle through GetInflightFrames() slots.
+	void UpdateInflightFrames(int n);
+
 	int GetCurFrame() const {
 		return curFrame_;
 	}
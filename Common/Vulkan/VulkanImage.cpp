@@ -219,6 +219,16 @@ void VulkanTexture::EndCreate(VkCommandBuffer cmd, bool vertexTexture) {
 		VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
 }
 
+void VulkanTexture::PrepareForUpload(VkCommandBuffer cmd) {
+	// The barrier also orders the upload after any still-pending shader reads
+	// from earlier frames, so the image can be reused safely.
+	TransitionImageLayout2(cmd, image_, 0, numMips_,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+}
+
 void VulkanTexture::Touch() {
 	if (allocator_ && mem_ != VK_NULL_HANDLE) {
 		allocator_->Touch(mem_, offset_);
@@ -22,6 +22,10 @@ public:
 	void UploadMip(VkCommandBuffer cmd, int mip, int mipWidth, int mipHeight, VkBuffer buffer, uint32_t offset, size_t rowLength);  // rowLength is in pixels
 	void GenerateMip(VkCommandBuffer cmd, int mip);
 	void EndCreate(VkCommandBuffer cmd, bool vertexTexture = false);
+	// Transitions a texture previously finished with EndCreate back to
+	// TRANSFER_DST_OPTIMAL so its contents can be replaced with UploadMip,
+	// without recreating the image. Call EndCreate again after uploading.
+	void PrepareForUpload(VkCommandBuffer cmd);
 
 	void Destroy();
 
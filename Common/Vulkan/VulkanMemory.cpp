@@ -24,7 +24,7 @@
 #include "math/math_util.h"
 
 VulkanPushBuffer::VulkanPushBuffer(VulkanContext *vulkan, size_t size, VkBufferUsageFlags usage)
-		: vulkan_(vulkan), size_(size), usage_(usage) {
+		: vulkan_(vulkan), size_(size), initialSize_(size), usage_(usage) {
 	bool res = AddBuffer();
 	assert(res);
 }
@@ -125,6 +125,33 @@ void VulkanPushBuffer::Defragment(VulkanContext *vulkan) {
 	assert(res);
 }
 
+void VulkanPushBuffer::ConsiderShrink(VulkanContext *vulkan) {
+	// Buffers that grew during a heavy scene stick around forever otherwise.
+	// After a while of consistently low usage, scale back down, a step at a time.
+	if (buffers_.size() != 1 || size_ <= initialSize_) {
+		framesLowUsage_ = 0;
+		return;
+	}
+	if (usageLastFrame_ * 2 <= size_) {
+		framesLowUsage_++;
+	} else {
+		framesLowUsage_ = 0;
+	}
+	// A few seconds' worth of frames, to ride out brief lulls.
+	if (framesLowUsage_ < 300)
+		return;
+	framesLowUsage_ = 0;
+
+	size_t newSize = size_ >> 1;
+	if (newSize < initialSize_)
+		newSize = initialSize_;
+	// Queues the old buffer for deletion, so in-flight frames are safe.
+	Destroy(vulkan);
+	size_ = newSize;
+	bool res = AddBuffer();
+	assert(res);
+}
+
 size_t VulkanPushBuffer::GetTotalSize() const {
 	size_t sum = 0;
 	if (buffers_.size() > 1)
@@ -31,6 +31,7 @@ public:
 
 	// Needs context in case of defragment.
 	void Begin(VulkanContext *vulkan) {
+		ConsiderShrink(vulkan);
 		buf_ = 0;
 		offset_ = 0;
 		// Note: we must defrag because some buffers may be smaller than size_.
@@ -43,6 +44,8 @@ public:
 	}
 
 	void End() {
+		// Remember how much was actually used, for ConsiderShrink().
+		usageLastFrame_ = GetTotalSize();
 		Unmap();
 	}
 
@@ -107,12 +110,16 @@ private:
 	bool AddBuffer();
 	void NextBuffer(size_t minSize);
 	void Defragment(VulkanContext *vulkan);
+	void ConsiderShrink(VulkanContext *vulkan);
 
 	VulkanContext *vulkan_;
 	std::vector<BufInfo> buffers_;
 	size_t buf_ = 0;
 	size_t offset_ = 0;
 	size_t size_ = 0;
+	size_t initialSize_ = 0;
+	size_t usageLastFrame_ = 0;
+	int framesLowUsage_ = 0;
 	uint8_t *writePtr_ = nullptr;
 	VkBufferUsageFlags usage_;
 };
@@ -10,7 +10,10 @@
 
 #include <string>
 #include <cstdint>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #ifdef USE_FFMPEG
 
@@ -37,6 +40,7 @@ extern "C" {
 #include "Core/ELF/ParamSFO.h"
 #include "Core/HLE/sceKernelTime.h"
 #include "StringUtils.h"
+#include "thread/threadutil.h"
 
 #ifdef USE_FFMPEG
 
@@ -60,7 +64,23 @@ static bool s_start_dumping = false;
 static int s_current_width;
 static int s_current_height;
 static int s_file_index = 0;
-static GPUDebugBuffer buf;
+
+// Frames are grabbed into a small ring on the emu thread and encoded on a
+// dedicated thread, so the emu thread only pays for the framebuffer copy.
+struct PendingFrame {
+	GPUDebugBuffer buf;
+	u32 w;
+	u32 h;
+};
+static const int FRAME_RING_SIZE = 3;
+static PendingFrame s_frame_ring[FRAME_RING_SIZE];
+static std::thread s_encode_thread;
+static std::mutex s_ring_lock;
+static std::condition_variable s_ring_cond;
+static int s_ring_write = 0;
+static int s_ring_count = 0;
+static bool s_encoder_running = false;
+static bool s_encoder_quit = false;
 
 static void InitAVCodec() {
 	static bool first_run = true;
@@ -81,8 +101,18 @@ bool AVIDump::Start(int w, int h)
 
 	InitAVCodec();
 	bool success = CreateAVI();
-	if (!success)
+	if (!success) {
 		CloseFile();
+	} else {
+		std::lock_guard<std::mutex> guard(s_ring_lock);
+		if (!s_encoder_running) {
+			s_encoder_quit = false;
+			s_ring_write = 0;
+			s_ring_count = 0;
+			s_encoder_running = true;
+			s_encode_thread = std::thread(&AVIDump::EncoderThread);
+		}
+	}
 	return success;
 }
 
@@ -169,20 +199,59 @@ static void PreparePacket(AVPacket* pkt) {
 
 void AVIDump::AddFrame()
 {
-	u32 w = 0;
-	u32 h = 0;
+	std::unique_lock<std::mutex> guard(s_ring_lock);
+	if (!s_encoder_running)
+		return;
+	// If the encoder can't keep up, wait for a slot rather than dropping
+	// frames - dropped frames would change the video's timing.
+	while (s_ring_count == FRAME_RING_SIZE)
+		s_ring_cond.wait(guard);
+
+	PendingFrame &frame = s_frame_ring[s_ring_write];
 	if (g_Config.bDumpVideoOutput) {
-		gpuDebug->GetOutputFramebuffer(buf);
-		w = buf.GetStride();
-		h = buf.GetHeight();
+		gpuDebug->GetOutputFramebuffer(frame.buf);
+		frame.w = frame.buf.GetStride();
+		frame.h = frame.buf.GetHeight();
 	} else {
-		gpuDebug->GetCurrentFramebuffer(buf, GPU_DBG_FRAMEBUF_RENDER);
-		w = PSP_CoreParameter().renderWidth;
-		h = PSP_CoreParameter().renderHeight;
+		gpuDebug->GetCurrentFramebuffer(frame.buf, GPU_DBG_FRAMEBUF_RENDER);
+		frame.w = PSP_CoreParameter().renderWidth;
+		frame.h = PSP_CoreParameter().renderHeight;
+	}
+	s_ring_write = (s_ring_write + 1) % FRAME_RING_SIZE;
+	s_ring_count++;
+	s_ring_cond.notify_all();
+}
+
+void AVIDump::EncoderThread()
+{
+	setCurrentThreadName("AVIDump");
+
+	std::unique_lock<std::mutex> guard(s_ring_lock);
+	int pos = 0;
+	while (true) {
+		if (s_ring_count == 0) {
+			if (s_encoder_quit)
+				break;
+			s_ring_cond.wait(guard);
+			continue;
+		}
+		guard.unlock();
+		EncodeFrame(pos);
+		guard.lock();
+		pos = (pos + 1) % FRAME_RING_SIZE;
+		s_ring_count--;
+		s_ring_cond.notify_all();
 	}
+}
+
+void AVIDump::EncodeFrame(int pos)
+{
+	PendingFrame &frame = s_frame_ring[pos];
+	u32 w = frame.w;
+	u32 h = frame.h;
 	CheckResolution(w, h);
 	u8 *flipbuffer = nullptr;
-	const u8 *buffer = ConvertBufferToScreenshot(buf, false, flipbuffer, w, h);
+	const u8 *buffer = ConvertBufferToScreenshot(frame.buf, false, flipbuffer, w, h);
 
 #ifdef USE_FFMPEG
 
@@ -236,6 +305,19 @@ void AVIDump::AddFrame()
 }
 
 void AVIDump::Stop() {
+	// Let the encoder drain the ring, then shut it down before finishing the file.
+	{
+		std::lock_guard<std::mutex> guard(s_ring_lock);
+		s_encoder_quit = true;
+		s_ring_cond.notify_all();
+	}
+	if (s_encode_thread.joinable())
+		s_encode_thread.join();
+	{
+		std::lock_guard<std::mutex> guard(s_ring_lock);
+		s_encoder_running = false;
+	}
+
 #ifdef USE_FFMPEG
 
 	av_write_trailer(s_format_context);
@@ -286,10 +368,15 @@ void AVIDump::CheckResolution(int width, int height) {
 	// for the added frame.
 	if ((width != s_current_width || height != s_current_height) && (width > 0 && height > 0))
 	{
-		int temp_file_index = s_file_index;
-		Stop();
-		s_file_index = temp_file_index + 1;
-		Start(width, height);
+		// Finish the current file and open a new one at the new size. This runs
+		// on the encoder thread, so don't go through Start()/Stop() - those
+		// manage the thread itself.
+		av_write_trailer(s_format_context);
+		CloseFile();
+		s_file_index++;
+		s_width = width;
+		s_height = height;
+		CreateAVI();
 		s_current_width = width;
 		s_current_height = height;
 	}
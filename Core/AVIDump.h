@@ -13,6 +13,8 @@ private:
 	static bool CreateAVI();
 	static void CloseFile();
 	static void CheckResolution(int width, int height);
+	static void EncoderThread();
+	static void EncodeFrame(int pos);
 
 public:
 	static bool Start(int w, int h);
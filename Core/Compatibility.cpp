@@ -23,16 +23,24 @@ void Compatibility::Load(const std::string &gameID) {
 	Clear();
 
 	{
-		IniFile compat;
-		// This loads from assets.
-		if (compat.LoadFromVFS("compat.ini")) {
+		// The asset can't change while we're running, so parse it on the first
+		// boot only and keep it around - Load() is on the game boot path, and the
+		// per-flag lookups through the parsed file are just index probes.
+		static IniFile compat;
+		static bool compatLoaded = false;
+		if (!compatLoaded) {
+			// This loads from assets.
+			compatLoaded = compat.LoadFromVFS("compat.ini");
+		}
+		if (compatLoaded) {
 			CheckSettings(compat, gameID);
 		}
 	}
 
 	{
 		IniFile compat2;
-		// This one is user-editable. Need to load it after the system one.
+		// This one is user-editable, so reload it every boot to pick up live edits.
+		// Need to load it after the system one.
 		std::string path = GetSysDirectory(DIRECTORY_SYSTEM) + "compat.ini";
 		if (compat2.Load(path)) {
 			CheckSettings(compat2, gameID);
@@ -457,6 +457,9 @@ static ConfigSetting generalSettings[] = {
 	ConfigSetting("ReportingHost", &g_Config.sReportHost, "default"),
 	ConfigSetting("AutoSaveSymbolMap", &g_Config.bAutoSaveSymbolMap, false, true, true),
 	ConfigSetting("CacheFullIsoInRam", &g_Config.bCacheFullIsoInRam, false, true, true),
+	ConfigSetting("CachePrxDecryption", &g_Config.bCachePrxDecryption, false, true, true),
+	ConfigSetting("RamCacheSizeMB", &g_Config.iRamCacheSizeMB, 0, true, true),
+	ConfigSetting("CompressISOOnInstall", &g_Config.bCompressISOOnInstall, false),
 	ConfigSetting("RemoteISOPort", &g_Config.iRemoteISOPort, 0, true, false),
 	ConfigSetting("LastRemoteISOServer", &g_Config.sLastRemoteISOServer, ""),
 	ConfigSetting("LastRemoteISOPort", &g_Config.iLastRemoteISOPort, 0),
@@ -729,6 +732,7 @@ static ConfigSetting graphicsSettings[] = {
 	ReportedConfigSetting("TextureBackoffCache", &g_Config.bTextureBackoffCache, false, true, true),
 	ReportedConfigSetting("TextureSecondaryCache", &g_Config.bTextureSecondaryCache, false, true, true),
 	ReportedConfigSetting("VertexDecJit", &g_Config.bVertexDecoderJit, &DefaultCodeGen, false),
+	ReportedConfigSetting("ThreadedVertexDecode", &g_Config.bThreadedVertexDecode, true, true, true),
 
 #ifndef MOBILE_DEVICE
 	ConfigSetting("FullScreen", &g_Config.bFullScreen, false),
@@ -749,8 +753,12 @@ static ConfigSetting graphicsSettings[] = {
 	ReportedConfigSetting("TexScalingLevel", &g_Config.iTexScalingLevel, 1, true, true),
 	ReportedConfigSetting("TexScalingType", &g_Config.iTexScalingType, 0, true, true),
 	ReportedConfigSetting("TexDeposterize", &g_Config.bTexDeposterize, false, true, true),
+	ReportedConfigSetting("ScaledTextureCache", &g_Config.bScaledTextureCache, false, true, true),
 	ConfigSetting("VSyncInterval", &g_Config.bVSync, false, true, true),
 	ReportedConfigSetting("BloomHack", &g_Config.iBloomHack, 0, true, true),
+	// Number of frames the CPU may run ahead of the GPU (Vulkan only). 3 overlaps best,
+	// 2 trades a little throughput for lower latency. Applied at backend startup.
+	ConfigSetting("InflightFrames", &g_Config.iInflightFrames, 3, true, true),
 
 	// Not really a graphics setting...
 	ReportedConfigSetting("SplineBezierQuality", &g_Config.iSplineBezierQuality, 2, true, true),
@@ -1090,6 +1098,7 @@ void Config::Load(const char *iniFileName, const char *controllerIniFilename) {
 	bSaveSettings = true;
 
 	bShowFrameProfiler = true;
+	bShowPerfStats = false;
 
 	IniFile iniFile;
 	if (!iniFile.Load(iniFilename_)) {
@@ -1247,12 +1256,19 @@ void Config::Save(const char *saveReason) {
 		}
 
 		IniFile::Section *pinnedPaths = iniFile.GetOrCreateSection("PinnedPaths");
-		pinnedPaths->Clear();
 		for (size_t i = 0; i < vPinnedPaths.size(); ++i) {
 			char keyName[64];
 			snprintf(keyName, sizeof(keyName), "Path%d", (int)i);
 			pinnedPaths->Set(keyName, vPinnedPaths[i]);
 		}
+		// Delete any leftover entries if the list shrank, instead of clearing
+		// the whole section - that way an unchanged list stays clean below.
+		for (size_t i = vPinnedPaths.size(); ; ++i) {
+			char keyName[64];
+			snprintf(keyName, sizeof(keyName), "Path%d", (int)i);
+			if (!pinnedPaths->Delete(keyName))
+				break;
+		}
 
 		IniFile::Section *control = iniFile.GetOrCreateSection("Control");
 		control->Delete("DPadRadius");
@@ -1261,12 +1277,17 @@ void Config::Save(const char *saveReason) {
 		if (LogManager::GetInstance())
 			LogManager::GetInstance()->SaveConfig(log);
 
-		if (!iniFile.Save(iniFilename_.c_str())) {
+		if (iniFile.Clean()) {
+			// Nothing changed since the last save, so skip the write entirely.
+			// Writing the ini can stall noticeably on slow storage.
+			INFO_LOG(LOADER, "Config unchanged (%s), skipped saving '%s'", saveReason, iniFilename_.c_str());
+		} else if (!iniFile.Save(iniFilename_.c_str())) {
 			ERROR_LOG(LOADER, "Error saving config (%s)- can't write ini '%s'", saveReason, iniFilename_.c_str());
 			System_SendMessage("toast", "Failed to save settings!\nCheck permissions, or try to restart the device.");
 			return;
+		} else {
+			INFO_LOG(LOADER, "Config saved (%s): '%s'", saveReason, iniFilename_.c_str());
 		}
-		INFO_LOG(LOADER, "Config saved (%s): '%s'", saveReason, iniFilename_.c_str());
 
 		if (!bGameSpecific) //otherwise we already did this in saveGameConfig()
 		{
@@ -1275,11 +1296,14 @@ void Config::Save(const char *saveReason) {
 				ERROR_LOG(LOADER, "Error saving config - can't read ini '%s'", controllerIniFilename_.c_str());
 			}
 			KeyMap::SaveToIni(controllerIniFile);
-			if (!controllerIniFile.Save(controllerIniFilename_.c_str())) {
+			if (controllerIniFile.Clean()) {
+				INFO_LOG(LOADER, "Controller config unchanged, skipped saving '%s'", controllerIniFilename_.c_str());
+			} else if (!controllerIniFile.Save(controllerIniFilename_.c_str())) {
 				ERROR_LOG(LOADER, "Error saving config - can't write ini '%s'", controllerIniFilename_.c_str());
 				return;
+			} else {
+				INFO_LOG(LOADER, "Controller config saved: %s", controllerIniFilename_.c_str());
 			}
-			INFO_LOG(LOADER, "Controller config saved: %s", controllerIniFilename_.c_str());
 		}
 	} else {
 		INFO_LOG(LOADER, "Not saving config");
@@ -1493,9 +1517,12 @@ bool Config::saveGameConfig(const std::string &pGameId, const std::string &title
 	std::string fullIniFilePath = getGameConfigFile(pGameId);
 
 	IniFile iniFile;
-
-	IniFile::Section *top = iniFile.GetOrCreateSection("");
-	top->AddComment(StringFromFormat("Game config for %s - %s", pGameId.c_str(), title.c_str()));
+	if (!iniFile.Load(fullIniFilePath)) {
+		// New file - add the header comment. On an existing file it's
+		// already there, and loading it first lets us skip an unchanged save.
+		IniFile::Section *top = iniFile.GetOrCreateSection("");
+		top->AddComment(StringFromFormat("Game config for %s - %s", pGameId.c_str(), title.c_str()));
+	}
 
 	IterateSettings(iniFile, [](IniFile::Section *section, ConfigSetting *setting) {
 		if (setting->perGame_) {
@@ -1504,7 +1531,8 @@ bool Config::saveGameConfig(const std::string &pGameId, const std::string &title
 	});
 
 	KeyMap::SaveToIni(iniFile);
-	iniFile.Save(fullIniFilePath);
+	if (!iniFile.Clean())
+		iniFile.Save(fullIniFilePath);
 
 	return true;
 }
@@ -103,6 +103,12 @@ public:
 	int iLockedCPUSpeed;
 	bool bAutoSaveSymbolMap;
 	bool bCacheFullIsoInRam;
+	// Cache decrypted EBOOT/PRX images in the cache directory so later boots
+	// skip kirk decryption.  Off by default since it writes game code to disk.
+	bool bCachePrxDecryption;
+	// Budget for the RAM cache in MB. 0 means unlimited (cache the whole ISO.)
+	int iRamCacheSizeMB;
+	bool bCompressISOOnInstall;
 	int iRemoteISOPort;
 	std::string sLastRemoteISOServer;
 	int iLastRemoteISOPort;
@@ -151,6 +157,7 @@ public:
 	int iFrameSkipType;
 	bool bAutoFrameSkip;
 	bool bFrameSkipUnthrottle;
+	int iInflightFrames;  // Vulkan: how many frames the CPU may run ahead of the GPU.
 
 	int iWindowX;
 	int iWindowY;
@@ -161,6 +168,7 @@ public:
 	bool bTextureBackoffCache;
 	bool bTextureSecondaryCache;
 	bool bVertexDecoderJit;
+	bool bThreadedVertexDecode;
 	bool bFullScreen;
 	bool bFullScreenMulti;
 	int iInternalResolution;  // 0 = Auto (native), 1 = 1x (480x272), 2 = 2x, 3 = 3x, 4 = 4x and so on.
@@ -172,6 +180,7 @@ public:
 	int iTexScalingLevel; // 0 = auto, 1 = off, 2 = 2x, ..., 5 = 5x
 	int iTexScalingType; // 0 = xBRZ, 1 = Hybrid
 	bool bTexDeposterize;
+	bool bScaledTextureCache;  // Keep scaled textures on disk between sessions.
 	int iFpsLimit1;
 	int iFpsLimit2;
 	int iMaxRecent;
@@ -393,6 +402,8 @@ public:
 
 	// Volatile development settings
 	bool bShowFrameProfiler;
+	// Frame time percentiles and hitch log overlay.
+	bool bShowPerfStats;
 
 	std::string currentDirectory;
 	std::string externalDirectory;
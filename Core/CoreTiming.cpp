@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <cstdio>
+#include <atomic>
 #include <mutex>
 
 #include "base/logging.h"
@@ -71,9 +72,18 @@ Event *first;
 Event *tsFirst;
 Event *tsLast;
 
+// Lock-free MPSC stack for ScheduleEvent_Threadsafe(). Producers push here
+// without taking externalEventLock; the CPU thread drains it (in FIFO order)
+// into the ts queue whenever it takes the lock anyway.
+static std::atomic<Event *> tsPendingHead;
+
+// Lock-free free stack the producers allocate from. Consumed ts events get
+// CAS-pushed back here instead of heap-freed, so steady state does no
+// allocation at all.
+static std::atomic<Event *> tsFreeHead;
+
 // event pools
 Event *eventPool = 0;
-Event *eventTsPool = 0;
 int allocatedTsEvents = 0;
 // Optimization to skip MoveEvents when possible.
 volatile u32 hasTsEvents = 0;
@@ -140,16 +150,42 @@ Event* GetNewEvent()
 	return ev;
 }
 
-Event* GetNewTsEvent()
+// Pops one node off the lock-free free stack, allocating if it's empty.
+// Several threads can be in here at once (producers, plus the CPU thread
+// during savestates), so a plain compare-exchange pop would be exposed to
+// ABA - instead we detach the whole stack with an exchange, keep the head
+// node, and push the remainder back as a chain. The stack stays small (it
+// only ever holds events in flight), so the tail walk is cheap.
+static Event* AllocTsEvent()
 {
-	allocatedTsEvents++;
-
-	if(!eventTsPool)
+	Event *list = tsFreeHead.exchange(nullptr, std::memory_order_acquire);
+	if (!list)
 		return new Event;
+	Event *rest = list->next;
+	if (rest) {
+		Event *tail = rest;
+		while (tail->next)
+			tail = tail->next;
+		Event *head = tsFreeHead.load(std::memory_order_relaxed);
+		do {
+			tail->next = head;
+		} while (!tsFreeHead.compare_exchange_weak(head, rest, std::memory_order_release));
+	}
+	return list;
+}
 
-	Event* ev = eventTsPool;
-	eventTsPool = ev->next;
-	return ev;
+static void RecycleTsEvent(Event* ev)
+{
+	Event *head = tsFreeHead.load(std::memory_order_relaxed);
+	do {
+		ev->next = head;
+	} while (!tsFreeHead.compare_exchange_weak(head, ev, std::memory_order_release));
+}
+
+Event* GetNewTsEvent()
+{
+	allocatedTsEvents++;
+	return AllocTsEvent();
 }
 
 void FreeEvent(Event* ev)
@@ -160,8 +196,7 @@ void FreeEvent(Event* ev)
 
 void FreeTsEvent(Event* ev)
 {
-	ev->next = eventTsPool;
-	eventTsPool = ev;
+	RecycleTsEvent(ev);
 	allocatedTsEvents--;
 }
 
@@ -219,12 +254,12 @@ void Shutdown()
 		delete ev;
 	}
 
-	std::lock_guard<std::mutex> lk(externalEventLock);
-	while(eventTsPool)
+	Event *ev = tsFreeHead.exchange(nullptr);
+	while (ev)
 	{
-		Event *ev = eventTsPool;
-		eventTsPool = ev->next;
+		Event *next = ev->next;
 		delete ev;
+		ev = next;
 	}
 }
 
@@ -239,21 +274,47 @@ u64 GetIdleTicks()
 }
 
 
+// Appends everything from the lock-free producer stack to the ts queue, oldest
+// event first. Must be called with externalEventLock held, which serializes
+// the consumers - producers never take the lock.
+static void DrainPendingTsEvents()
+{
+	Event *pending = tsPendingHead.exchange(nullptr, std::memory_order_acquire);
+	// The stack is LIFO - reverse it to get scheduling order back.
+	Event *fifo = nullptr;
+	while (pending) {
+		Event *next = pending->next;
+		pending->next = fifo;
+		fifo = pending;
+		pending = next;
+	}
+	while (fifo) {
+		Event *next = fifo->next;
+		fifo->next = 0;
+		if (!tsFirst)
+			tsFirst = fifo;
+		if (tsLast)
+			tsLast->next = fifo;
+		tsLast = fifo;
+		allocatedTsEvents++;
+		fifo = next;
+	}
+}
+
 // This is to be called when outside threads, such as the graphics thread, wants to
 // schedule things to be executed on the main thread.
 void ScheduleEvent_Threadsafe(s64 cyclesIntoFuture, int event_type, u64 userdata)
 {
-	std::lock_guard<std::mutex> lk(externalEventLock);
-	Event *ne = GetNewTsEvent();
+	// No lock - audio and GE interrupts land here every few milliseconds and
+	// were contending with the much longer consumer-side critical sections.
+	Event *ne = AllocTsEvent();
 	ne->time = GetTicks() + cyclesIntoFuture;
 	ne->type = event_type;
-	ne->next = 0;
 	ne->userdata = userdata;
-	if(!tsFirst)
-		tsFirst = ne;
-	if(tsLast)
-		tsLast->next = ne;
-	tsLast = ne;
+	Event *head = tsPendingHead.load(std::memory_order_relaxed);
+	do {
+		ne->next = head;
+	} while (!tsPendingHead.compare_exchange_weak(head, ne, std::memory_order_release));
 
 	Common::AtomicStoreRelease(hasTsEvents, 1);
 }
@@ -360,6 +421,7 @@ s64 UnscheduleThreadsafeEvent(int event_type, u64 userdata)
 {
 	s64 result = 0;
 	std::lock_guard<std::mutex> lk(externalEventLock);
+	DrainPendingTsEvents();
 	if (!tsFirst)
 		return result;
 	while(tsFirst)
@@ -464,6 +526,7 @@ void RemoveEvent(int event_type)
 void RemoveThreadsafeEvent(int event_type)
 {
 	std::lock_guard<std::mutex> lk(externalEventLock);
+	DrainPendingTsEvents();
 	if (!tsFirst)
 	{
 		return;
@@ -537,24 +600,33 @@ void MoveEvents()
 {
 	Common::AtomicStoreRelease(hasTsEvents, 0);
 
-	std::lock_guard<std::mutex> lk(externalEventLock);
-	// Move events from async queue into main queue
-	while (tsFirst)
+	Event *moveFirst;
 	{
-		Event *next = tsFirst->next;
-		AddEventToQueue(tsFirst);
-		tsFirst = next;
+		std::lock_guard<std::mutex> lk(externalEventLock);
+		DrainPendingTsEvents();
+		// Detach the async queue - the sorted insertion walk below is the
+		// expensive part, no reason to do it while holding up other threads.
+		moveFirst = tsFirst;
+		tsFirst = NULL;
+		tsLast = NULL;
+
+		// Move free events back to the threadsafe free stack, so producers
+		// keep finding nodes there instead of hitting the allocator.
+		while(allocatedTsEvents > 0 && eventPool)
+		{
+			Event *ev = eventPool;
+			eventPool = ev->next;
+			RecycleTsEvent(ev);
+			allocatedTsEvents--;
+		}
 	}
-	tsLast = NULL;
 
-	// Move free events to threadsafe pool
-	while(allocatedTsEvents > 0 && eventPool)
+	// Move events from async queue into main queue
+	while (moveFirst)
 	{
-		Event *ev = eventPool;
-		eventPool = ev->next;
-		ev->next = eventTsPool;
-		eventTsPool = ev;
-		allocatedTsEvents--;
+		Event *next = moveFirst->next;
+		AddEventToQueue(moveFirst);
+		moveFirst = next;
 	}
 }
 
@@ -680,6 +752,8 @@ void Event_DoStateOld(PointerWrap &p, BaseEvent *ev)
 void DoState(PointerWrap &p)
 {
 	std::lock_guard<std::mutex> lk(externalEventLock);
+	// Get any pending lock-free events into the serialized ts queue.
+	DrainPendingTsEvents();
 
 	auto s = p.Section("CoreTiming", 1, 3);
 	if (!s)
@@ -353,6 +353,7 @@ void CWCheatEngine::ParseCheats() {
 	// TODO: Report errors.
 
 	cheats_ = parser.GetCheats();
+	CompileCheats();
 }
 
 u32 CWCheatEngine::GetAddress(u32 value) {
@@ -463,6 +464,25 @@ struct CheatOperation {
 	};
 };
 
+// One pre-decoded operation.  The line positions are kept so that the skip
+// counts in conditional ops (which are in raw line units, not op units) can be
+// mapped back onto op indices at run time.
+struct CompiledCheatOp {
+	CheatOperation op;
+	// Line index this op was decoded from.
+	uint32_t startLine;
+	// Line index just past the decoded lines - where ExecuteOp starts reading
+	// any runtime-consumed lines (pointer commands.)
+	uint32_t execLine;
+	// Line index of the next op, including runtime-consumed lines.
+	uint32_t nextLine;
+};
+
+struct CompiledCheatSet {
+	// Parallel to CWCheatEngine::cheats_.
+	std::vector<std::vector<CompiledCheatOp>> cheats;
+};
+
 CheatOperation CWCheatEngine::InterpretNextCwCheat(const CheatCode &cheat, size_t &i) {
 	const CheatLine &line1 = cheat.lines[i++];
 	const uint32_t &arg = line1.part2;
@@ -1051,12 +1071,63 @@ void CWCheatEngine::ExecuteOp(const CheatOperation &op, const CheatCode &cheat,
 	}
 }
 
-void CWCheatEngine::Run() {
-	for (CheatCode cheat : cheats_) {
-		// InterpretNextOp and ExecuteOp move i.
+// Defined here, after CompiledCheatSet, so delete sees the complete type.
+CWCheatEngine::~CWCheatEngine() {
+	delete compiled_;
+}
+
+void CWCheatEngine::CompileCheats() {
+	delete compiled_;
+	compiled_ = new CompiledCheatSet();
+	compiled_->cheats.resize(cheats_.size());
+
+	for (size_t c = 0; c < cheats_.size(); ++c) {
+		const CheatCode &cheat = cheats_[c];
+		std::vector<CompiledCheatOp> &ops = compiled_->cheats[c];
+
 		for (size_t i = 0; i < cheat.lines.size(); ) {
-			CheatOperation op = InterpretNextOp(cheat, i);
-			ExecuteOp(op, cheat, i);
+			CompiledCheatOp cop;
+			cop.startLine = (uint32_t)i;
+			cop.op = InterpretNextOp(cheat, i);
+			cop.execLine = (uint32_t)i;
+			// Pointer commands read their extra lines in ExecuteOp, not during
+			// decode - account for them so nextLine is the real next op.
+			if (cop.op.op == CheatOp::CwCheatPointerCommands) {
+				i += cop.op.pointerCommands.count;
+				if (i > cheat.lines.size())
+					i = cheat.lines.size();
+			}
+			cop.nextLine = (uint32_t)i;
+			ops.push_back(cop);
+		}
+	}
+}
+
+void CWCheatEngine::Run() {
+	// Decoding the cheat lines is the expensive part and their meaning can't
+	// change between ticks, so it's done once in CompileCheats().  Here we
+	// just execute the pre-decoded ops, re-testing only the conditionals.
+	if (!compiled_) {
+		CompileCheats();
+	}
+
+	for (size_t c = 0; c < cheats_.size(); ++c) {
+		const CheatCode &cheat = cheats_[c];
+		const std::vector<CompiledCheatOp> &ops = compiled_->cheats[c];
+
+		for (size_t opIndex = 0; opIndex < ops.size(); ) {
+			const CompiledCheatOp &cop = ops[opIndex];
+			size_t i = cop.execLine;
+			ExecuteOp(cop.op, cheat, i);
+
+			if (i == cop.nextLine) {
+				++opIndex;
+			} else {
+				// A conditional skipped forward (skips are in line units), or
+				// an assert aborted the cheat.  Map the line back to an op.
+				while (opIndex < ops.size() && ops[opIndex].startLine < i)
+					++opIndex;
+			}
 		}
 	}
 }
@@ -35,10 +35,12 @@ struct CheatCode {
 };
 
 struct CheatOperation;
+struct CompiledCheatSet;
 
 class CWCheatEngine {
 public:
 	CWCheatEngine();
+	~CWCheatEngine();
 	std::vector<std::string> GetCodesList();
 	void ParseCheats();
 	void CreateCheatFile();
@@ -49,6 +51,8 @@ public:
 private:
 	u32 GetAddress(u32 value);
 
+	void CompileCheats();
+
 	CheatOperation InterpretNextOp(const CheatCode &cheat, size_t &i);
 	CheatOperation InterpretNextCwCheat(const CheatCode &cheat, size_t &i);
 	CheatOperation InterpretNextTempAR(const CheatCode &cheat, size_t &i);
@@ -59,4 +63,6 @@ private:
 	bool TestIfAddr(const CheatOperation &op, bool(*oper)(int a, int b));
 
 	std::vector<CheatCode> cheats_;
+	// Decoded form of cheats_, rebuilt whenever cheats_ changes.  See Run().
+	CompiledCheatSet *compiled_ = nullptr;
 };
@@ -30,6 +30,12 @@
 #include "Core/CoreTiming.h"
 
 std::atomic<bool> anyMemChecks_(false);
+// Tracks whether breakPoints_ is non-empty, so the jits can skip the mutex
+// and scan per compiled instruction when no breakpoints exist at all (the
+// common case, and also the armed-watchpoint-only case.)  Breakpoint checks
+// are only compiled into the blocks that contain them, so with this gate,
+// unaffected blocks compile and run at full speed.
+std::atomic<bool> anyBreakPoints_(false);
 
 static std::mutex breakPointsMutex_;
 std::vector<BreakPoint> CBreakPoints::breakPoints_;
@@ -160,6 +166,8 @@ size_t CBreakPoints::FindMemCheck(u32 start, u32 end)
 
 bool CBreakPoints::IsAddressBreakPoint(u32 addr)
 {
+	if (!anyBreakPoints_)
+		return false;
 	std::lock_guard<std::mutex> guard(breakPointsMutex_);
 	size_t bp = FindBreakpoint(addr);
 	return bp != INVALID_BREAKPOINT && breakPoints_[bp].result != BREAK_ACTION_IGNORE;
@@ -167,6 +175,8 @@ bool CBreakPoints::IsAddressBreakPoint(u32 addr)
 
 bool CBreakPoints::IsAddressBreakPoint(u32 addr, bool* enabled)
 {
+	if (!anyBreakPoints_)
+		return false;
 	std::lock_guard<std::mutex> guard(breakPointsMutex_);
 	size_t bp = FindBreakpoint(addr);
 	if (bp == INVALID_BREAKPOINT) return false;
@@ -177,6 +187,8 @@ bool CBreakPoints::IsAddressBreakPoint(u32 addr, bool* enabled)
 
 bool CBreakPoints::IsTempBreakPoint(u32 addr)
 {
+	if (!anyBreakPoints_)
+		return false;
 	std::lock_guard<std::mutex> guard(breakPointsMutex_);
 	size_t bp = FindBreakpoint(addr, true, true);
 	return bp != INVALID_BREAKPOINT;
@@ -184,6 +196,8 @@ bool CBreakPoints::IsTempBreakPoint(u32 addr)
 
 bool CBreakPoints::RangeContainsBreakPoint(u32 addr, u32 size)
 {
+	if (!anyBreakPoints_)
+		return false;
 	std::lock_guard<std::mutex> guard(breakPointsMutex_);
 	const u32 end = addr + size;
 	for (const auto &bp : breakPoints_)
@@ -207,6 +221,7 @@ void CBreakPoints::AddBreakPoint(u32 addr, bool temp)
 		pt.addr = addr;
 
 		breakPoints_.push_back(pt);
+		anyBreakPoints_ = true;
 		guard.unlock();
 		Update(addr);
 	}
@@ -232,6 +247,7 @@ void CBreakPoints::RemoveBreakPoint(u32 addr)
 		if (bp != INVALID_BREAKPOINT)
 			breakPoints_.erase(breakPoints_.begin() + bp);
 
+		anyBreakPoints_ = !breakPoints_.empty();
 		guard.unlock();
 		Update(addr);
 	}
@@ -271,6 +287,7 @@ void CBreakPoints::ClearAllBreakPoints()
 	if (!breakPoints_.empty())
 	{
 		breakPoints_.clear();
+		anyBreakPoints_ = false;
 		guard.unlock();
 		Update();
 	}
@@ -292,6 +309,7 @@ void CBreakPoints::ClearTemporaryBreakPoints()
 		}
 	}
 
+	anyBreakPoints_ = !breakPoints_.empty();
 	guard.unlock();
 	if (update)
 		Update();
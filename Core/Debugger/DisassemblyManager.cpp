@@ -22,6 +22,7 @@
 #include "ext/xxhash.h"
 
 #include "Common/CommonTypes.h"
+#include "Core/CoreTiming.h"
 #include "Core/MemMap.h"
 #include "Core/System.h"
 #include "Core/MIPS/MIPSCodeUtils.h"
@@ -156,7 +157,12 @@ void DisassemblyManager::analyze(u32 address, u32 size = 1024)
 		if (it != entries.end())
 		{
 			DisassemblyEntry* entry = it->second;
-			entry->recheck();
+			u64 ticks = CoreTiming::GetTicks();
+			if (entry->lastCheckTicks != ticks)
+			{
+				entry->recheck();
+				entry->lastCheckTicks = ticks;
+			}
 			address = entry->getLineAddress(0)+entry->getTotalSize();
 			continue;
 		}
@@ -354,6 +360,24 @@ u32 DisassemblyManager::getNthNextAddress(u32 address, int n)
 DisassemblyManager::~DisassemblyManager() {
 }
 
+void DisassemblyManager::invalidate(u32 address, u32 size)
+{
+	auto memLock = Memory::Lock();
+	std::lock_guard<std::recursive_mutex> guard(entriesLock_);
+	if (size == 0 || entries.empty())
+		return;
+
+	// An entry starting before the range can still overlap it.
+	auto it = findDisassemblyEntry(entries, address, false);
+	if (it == entries.end())
+		it = entries.lower_bound(address);
+	while (it != entries.end() && it->first < address + size)
+	{
+		delete it->second;
+		it = entries.erase(it);
+	}
+}
+
 void DisassemblyManager::clear()
 {
 	auto memLock = Memory::Lock();
@@ -65,6 +65,12 @@ public:
 	virtual u32 getTotalSize() = 0;
 	virtual bool disassemble(u32 address, DisassemblyLineInfo& dest, bool insertSymbols, DebugInterface *cpuDebug) = 0;
 	virtual void getBranchLines(u32 start, u32 size, std::vector<BranchLine>& dest) { };
+
+	// CoreTiming tick count at the last recheck(). analyze() skips the (often
+	// expensive) recheck when the CPU hasn't run since - memory can't have
+	// changed while execution is paused, and scrolling otherwise rehashes
+	// every function in view on each redraw.
+	u64 lastCheckTicks = 0;
 };
 
 class DisassemblyFunction: public DisassemblyEntry
@@ -202,6 +208,9 @@ public:
 	~DisassemblyManager();
 
 	void clear();
+	// Drops only the entries overlapping the range, for symbol changes that
+	// touch a known address range. Cheaper than a full clear() and reanalysis.
+	void invalidate(u32 address, u32 size);
 
 	void setCpu(DebugInterface* _cpu) { cpu = _cpu; };
 	void setMaxParamChars(int num) { maxParamChars = num; clear(); };
@@ -60,6 +60,7 @@ void SymbolMap::Clear() {
 	activeModuleEnds.clear();
 	modules.clear();
 	activeNeedUpdate_ = false;
+	snapshotDirty_ = true;
 }
 
 bool SymbolMap::LoadSymbolMap(const char *filename) {
@@ -299,13 +300,10 @@ void SymbolMap::SaveNocashSym(const char *filename) const {
 }
 
 SymbolType SymbolMap::GetSymbolType(u32 address) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	if (activeFunctions.find(address) != activeFunctions.end())
+	auto snap = GetSnapshot();
+	if (FindExact(snap->funcAddrs, address) >= 0)
 		return ST_FUNCTION;
-	if (activeData.find(address) != activeData.end())
+	if (FindExact(snap->dataAddrs, address) >= 0)
 		return ST_DATA;
 	return ST_NONE;
 }
@@ -349,18 +347,15 @@ bool SymbolMap::GetSymbolInfo(SymbolInfo *info, u32 address, SymbolType symmask)
 }
 
 u32 SymbolMap::GetNextSymbolAddress(u32 address, SymbolType symmask) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
+	auto snap = GetSnapshot();
+	const auto functionEntry = symmask & ST_FUNCTION ? std::upper_bound(snap->funcAddrs.begin(), snap->funcAddrs.end(), address) : snap->funcAddrs.end();
+	const auto dataEntry = symmask & ST_DATA ? std::upper_bound(snap->dataAddrs.begin(), snap->dataAddrs.end(), address) : snap->dataAddrs.end();
 
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	const auto functionEntry = symmask & ST_FUNCTION ? activeFunctions.upper_bound(address) : activeFunctions.end();
-	const auto dataEntry = symmask & ST_DATA ? activeData.upper_bound(address) : activeData.end();
-
-	if (functionEntry == activeFunctions.end() && dataEntry == activeData.end())
+	if (functionEntry == snap->funcAddrs.end() && dataEntry == snap->dataAddrs.end())
 		return INVALID_ADDRESS;
 
-	u32 funcAddress = (functionEntry != activeFunctions.end()) ? functionEntry->first : 0xFFFFFFFF;
-	u32 dataAddress = (dataEntry != activeData.end()) ? dataEntry->first : 0xFFFFFFFF;
+	u32 funcAddress = (functionEntry != snap->funcAddrs.end()) ? *functionEntry : 0xFFFFFFFF;
+	u32 dataAddress = (dataEntry != snap->dataAddrs.end()) ? *dataEntry : 0xFFFFFFFF;
 
 	if (funcAddress <= dataAddress)
 		return funcAddress;
@@ -369,7 +364,8 @@ u32 SymbolMap::GetNextSymbolAddress(u32 address, SymbolType symmask) {
 }
 
 std::string SymbolMap::GetDescription(unsigned int address) {
-	std::lock_guard<std::recursive_mutex> guard(lock_);
+	// Keep the snapshot referenced so the label pointer stays valid.
+	auto snap = GetSnapshot();
 	const char* labelName = NULL;
 
 	u32 funcStart = GetFunctionStart(address);
@@ -567,32 +563,18 @@ void SymbolMap::AddFunction(const char* name, u32 address, u32 size, int moduleI
 		}
 	}
 
+	snapshotDirty_ = true;
 	AddLabel(name, address, moduleIndex);
 }
 
 u32 SymbolMap::GetFunctionStart(u32 address) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeFunctions.upper_bound(address);
-	if (it == activeFunctions.end()) {
-		// check last element
-		auto rit = activeFunctions.rbegin();
-		if (rit != activeFunctions.rend()) {
-			u32 start = rit->first;
-			u32 size = rit->second.size;
-			if (start <= address && start+size > address)
-				return start;
-		}
-		// otherwise there's no function that contains this address
-		return INVALID_ADDRESS;
-	}
-
-	if (it != activeFunctions.begin()) {
-		it--;
-		u32 start = it->first;
-		u32 size = it->second.size;
+	auto snap = GetSnapshot();
+	// The first function above the address, then step back to the candidate.
+	auto it = std::upper_bound(snap->funcAddrs.begin(), snap->funcAddrs.end(), address);
+	if (it != snap->funcAddrs.begin()) {
+		size_t i = (it - snap->funcAddrs.begin()) - 1;
+		u32 start = snap->funcAddrs[i];
+		u32 size = snap->funcs[i].size;
 		if (start <= address && start+size > address)
 			return start;
 	}
@@ -601,55 +583,43 @@ u32 SymbolMap::GetFunctionStart(u32 address) {
 }
 
 u32 SymbolMap::FindPossibleFunctionAtAfter(u32 address) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeFunctions.lower_bound(address);
-	if (it == activeFunctions.end()) {
+	auto snap = GetSnapshot();
+	auto it = std::lower_bound(snap->funcAddrs.begin(), snap->funcAddrs.end(), address);
+	if (it == snap->funcAddrs.end()) {
 		return (u32)-1;
 	}
-	return it->first;
+	return *it;
 }
 
 u32 SymbolMap::GetFunctionSize(u32 startAddress) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeFunctions.find(startAddress);
-	if (it == activeFunctions.end())
+	auto snap = GetSnapshot();
+	int i = FindExact(snap->funcAddrs, startAddress);
+	if (i < 0)
 		return INVALID_ADDRESS;
 
-	return it->second.size;
+	return snap->funcs[i].size;
 }
 
 u32 SymbolMap::GetFunctionModuleAddress(u32 startAddress) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeFunctions.find(startAddress);
-	if (it == activeFunctions.end())
+	auto snap = GetSnapshot();
+	int i = FindExact(snap->funcAddrs, startAddress);
+	if (i < 0)
 		return INVALID_ADDRESS;
 
-	return GetModuleAbsoluteAddr(0, it->second.module);
+	return GetModuleAbsoluteAddr(0, snap->funcs[i].module);
 }
 
 int SymbolMap::GetFunctionNum(u32 address) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
+	auto snap = GetSnapshot();
 	u32 start = GetFunctionStart(address);
 	if (start == INVALID_ADDRESS)
 		return INVALID_ADDRESS;
 
-	auto it = activeFunctions.find(start);
-	if (it == activeFunctions.end())
+	int i = FindExact(snap->funcAddrs, start);
+	if (i < 0)
 		return INVALID_ADDRESS;
 
-	return it->second.index;
+	return snap->funcs[i].index;
 }
 
 void SymbolMap::AssignFunctionIndices() {
@@ -712,6 +682,53 @@ void SymbolMap::UpdateActiveSymbols() {
 
 	AssignFunctionIndices();
 	activeNeedUpdate_ = false;
+	snapshotDirty_ = true;
+}
+
+std::shared_ptr<const SymbolMap::ActiveSnapshot> SymbolMap::GetSnapshot() {
+	if (activeNeedUpdate_)
+		UpdateActiveSymbols();
+
+	if (snapshotDirty_) {
+		std::lock_guard<std::recursive_mutex> guard(lock_);
+		auto snap = std::make_shared<ActiveSnapshot>();
+		snap->funcAddrs.reserve(activeFunctions.size());
+		snap->funcs.reserve(activeFunctions.size());
+		for (auto it = activeFunctions.begin(), end = activeFunctions.end(); it != end; ++it) {
+			snap->funcAddrs.push_back(it->first);
+			snap->funcs.push_back(it->second);
+		}
+		snap->labelAddrs.reserve(activeLabels.size());
+		snap->labels.reserve(activeLabels.size());
+		for (auto it = activeLabels.begin(), end = activeLabels.end(); it != end; ++it) {
+			snap->labelAddrs.push_back(it->first);
+			snap->labels.push_back(it->second);
+		}
+		snap->dataAddrs.reserve(activeData.size());
+		snap->data.reserve(activeData.size());
+		for (auto it = activeData.begin(), end = activeData.end(); it != end; ++it) {
+			snap->dataAddrs.push_back(it->first);
+			snap->data.push_back(it->second);
+		}
+		// Publish before clearing the dirty flag - in the other order, a
+		// concurrent caller could see the flag clear and load the previous
+		// snapshot (null before the very first build finishes). The mutators
+		// that set the flag all hold lock_, so no invalidation can slip in
+		// between the two.
+		std::shared_ptr<const ActiveSnapshot> result = std::move(snap);
+		std::atomic_store(&snapshot_, result);
+		snapshotDirty_ = false;
+		return result;
+	}
+
+	return std::atomic_load(&snapshot_);
+}
+
+int SymbolMap::FindExact(const std::vector<u32> &addrs, u32 addr) {
+	auto it = std::lower_bound(addrs.begin(), addrs.end(), addr);
+	if (it == addrs.end() || *it != addr)
+		return -1;
+	return (int)(it - addrs.begin());
 }
 
 bool SymbolMap::SetFunctionSize(u32 startAddress, u32 newSize) {
@@ -731,6 +748,8 @@ bool SymbolMap::SetFunctionSize(u32 startAddress, u32 newSize) {
 		}
 	}
 
+	snapshotDirty_ = true;
+
 	// TODO: check for overlaps
 	return true;
 }
@@ -764,6 +783,7 @@ bool SymbolMap::RemoveFunction(u32 startAddress, bool removeName) {
 		}
 	}
 
+	snapshotDirty_ = true;
 	return true;
 }
 
@@ -813,6 +833,7 @@ void SymbolMap::AddLabel(const char* name, u32 address, int moduleIndex) {
 			activeLabels.insert(std::make_pair(address, label));
 		}
 	}
+	snapshotDirty_ = true;
 }
 
 void SymbolMap::SetLabelName(const char* name, u32 address) {
@@ -836,20 +857,19 @@ void SymbolMap::SetLabelName(const char* name, u32 address) {
 				activeLabels.erase(active);
 				activeLabels.insert(std::make_pair(address, label->second));
 			}
+			snapshotDirty_ = true;
 		}
 	}
 }
 
 const char *SymbolMap::GetLabelName(u32 address) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeLabels.find(address);
-	if (it == activeLabels.end())
+	// Only valid until the snapshot is replaced - callers copy right away.
+	auto snap = GetSnapshot();
+	int i = FindExact(snap->labelAddrs, address);
+	if (i < 0)
 		return NULL;
 
-	return it->second.name;
+	return snap->labels[i].name;
 }
 
 const char *SymbolMap::GetLabelNameRel(u32 relAddress, int moduleIndex) const {
@@ -862,7 +882,8 @@ const char *SymbolMap::GetLabelNameRel(u32 relAddress, int moduleIndex) const {
 }
 
 std::string SymbolMap::GetLabelString(u32 address) {
-	std::lock_guard<std::recursive_mutex> guard(lock_);
+	// Keep the snapshot referenced while we copy the label.
+	auto snap = GetSnapshot();
 	const char *label = GetLabelName(address);
 	if (label == NULL)
 		return "";
@@ -870,13 +891,10 @@ std::string SymbolMap::GetLabelString(u32 address) {
 }
 
 bool SymbolMap::GetLabelValue(const char* name, u32& dest) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	for (auto it = activeLabels.begin(); it != activeLabels.end(); it++) {
-		if (strcasecmp(name, it->second.name) == 0) {
-			dest = it->first;
+	auto snap = GetSnapshot();
+	for (size_t i = 0; i < snap->labels.size(); ++i) {
+		if (strcasecmp(name, snap->labels[i].name) == 0) {
+			dest = snap->labelAddrs[i];
 			return true;
 		}
 	}
@@ -931,34 +949,16 @@ void SymbolMap::AddData(u32 address, u32 size, DataType type, int moduleIndex) {
 			activeData.insert(std::make_pair(address, entry));
 		}
 	}
+	snapshotDirty_ = true;
 }
 
 u32 SymbolMap::GetDataStart(u32 address) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeData.upper_bound(address);
-	if (it == activeData.end())
-	{
-		// check last element
-		auto rit = activeData.rbegin();
-
-		if (rit != activeData.rend())
-		{
-			u32 start = rit->first;
-			u32 size = rit->second.size;
-			if (start <= address && start+size > address)
-				return start;
-		}
-		// otherwise there's no data that contains this address
-		return INVALID_ADDRESS;
-	}
-
-	if (it != activeData.begin()) {
-		it--;
-		u32 start = it->first;
-		u32 size = it->second.size;
+	auto snap = GetSnapshot();
+	auto it = std::upper_bound(snap->dataAddrs.begin(), snap->dataAddrs.end(), address);
+	if (it != snap->dataAddrs.begin()) {
+		size_t i = (it - snap->dataAddrs.begin()) - 1;
+		u32 start = snap->dataAddrs[i];
+		u32 size = snap->data[i].size;
 		if (start <= address && start+size > address)
 			return start;
 	}
@@ -967,36 +967,27 @@ u32 SymbolMap::GetDataStart(u32 address) {
 }
 
 u32 SymbolMap::GetDataSize(u32 startAddress) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	auto snap = GetSnapshot();
+	int i = FindExact(snap->dataAddrs, startAddress);
+	if (i < 0)
 		return INVALID_ADDRESS;
-	return it->second.size;
+	return snap->data[i].size;
 }
 
 u32 SymbolMap::GetDataModuleAddress(u32 startAddress) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	auto snap = GetSnapshot();
+	int i = FindExact(snap->dataAddrs, startAddress);
+	if (i < 0)
 		return INVALID_ADDRESS;
-	return GetModuleAbsoluteAddr(0, it->second.module);
+	return GetModuleAbsoluteAddr(0, snap->data[i].module);
 }
 
 DataType SymbolMap::GetDataType(u32 startAddress) {
-	if (activeNeedUpdate_)
-		UpdateActiveSymbols();
-
-	std::lock_guard<std::recursive_mutex> guard(lock_);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	auto snap = GetSnapshot();
+	int i = FindExact(snap->dataAddrs, startAddress);
+	if (i < 0)
 		return DATATYPE_NONE;
-	return it->second.type;
+	return snap->data[i].type;
 }
 
 void SymbolMap::GetLabels(std::vector<LabelDefinition> &dest) {
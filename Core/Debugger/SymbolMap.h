@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <set>
 #include <map>
@@ -152,6 +154,24 @@ private:
 		char name[128];
 	};
 
+	// An immutable, flattened copy of the active symbols, sorted by absolute
+	// address and swapped in whole.  The hot queries (the disassembly view
+	// calls GetDescription for every visible line, every frame) binary search
+	// this without ever holding lock_ - writers just build a new one.
+	struct ActiveSnapshot {
+		std::vector<u32> funcAddrs;
+		std::vector<FunctionEntry> funcs;
+		std::vector<u32> labelAddrs;
+		std::vector<LabelEntry> labels;
+		std::vector<u32> dataAddrs;
+		std::vector<DataEntry> data;
+	};
+	std::shared_ptr<const ActiveSnapshot> GetSnapshot();
+	static int FindExact(const std::vector<u32> &addrs, u32 addr);
+
+	std::shared_ptr<const ActiveSnapshot> snapshot_;
+	std::atomic<bool> snapshotDirty_{ true };
+
 	// These are flattened, read-only copies of the actual data in active modules only.
 	std::map<u32, const FunctionEntry> activeFunctions;
 	std::map<u32, const LabelEntry> activeLabels;
@@ -25,8 +25,23 @@
 #include "Core/MIPS/MIPS.h"
 #include "Core/MIPS/MIPSDebugInterface.h"
 
+// Watches CPU state between stops, so only changed registers are resent.
+class WebSocketCPUState : public DebuggerSubscriber {
+public:
+	void Subscribe(DebuggerRequest &req);
+	void Unsubscribe(DebuggerRequest &req);
+	void Broadcast(net::WebSocketServer *ws) override;
+
+protected:
+	void GatherValues(std::vector<uint32_t> &values);
+
+	bool subscribed_ = false;
+	int lastCounter_ = 0;
+	std::vector<uint32_t> lastValues_;
+};
+
 DebuggerSubscriber *WebSocketCPUCoreInit(DebuggerEventHandlerMap &map) {
-	// No need to bind or alloc state, these are all global.
+	// These are all global.
 	map["cpu.stepping"] = &WebSocketCPUStepping;
 	map["cpu.resume"] = &WebSocketCPUResume;
 	map["cpu.status"] = &WebSocketCPUStatus;
@@ -35,7 +50,12 @@ DebuggerSubscriber *WebSocketCPUCoreInit(DebuggerEventHandlerMap &map) {
 	map["cpu.setReg"] = &WebSocketCPUSetReg;
 	map["cpu.evaluate"] = &WebSocketCPUEvaluate;
 
-	return nullptr;
+	// The subscription tracks per-connection state.
+	auto p = new WebSocketCPUState();
+	map["cpu.subscribe"] = std::bind(&WebSocketCPUState::Subscribe, p, std::placeholders::_1);
+	map["cpu.unsubscribe"] = std::bind(&WebSocketCPUState::Unsubscribe, p, std::placeholders::_1);
+
+	return p;
 }
 
 static std::string RegValueAsFloat(uint32_t u) {
@@ -410,3 +430,90 @@ void WebSocketCPUEvaluate(DebuggerRequest &req) {
 	json.writeUint("uintValue", val);
 	json.writeString("floatValue", RegValueAsFloat(val));
 }
+
+// Subscribe to CPU state updates (cpu.subscribe)
+//
+// No parameters.
+//
+// Response (same event name) with no other properties.  After this, a
+// "cpu.delta" event is sent each time the CPU stops (stepping, breakpoint),
+// containing only the registers that changed since the last stop:
+//  - registers: array of objects:
+//     - category: number (id from cpu.getAllRegs.)
+//     - register: number index within the category (32 = pc, 33 = hi,
+//       34 = lo, category 0 only.)
+//     - uintValue: new value in the register.
+//     - floatValue: string showing float representation.
+void WebSocketCPUState::Subscribe(DebuggerRequest &req) {
+	subscribed_ = true;
+	// Resend everything on the next stop.
+	lastValues_.clear();
+	req.Respond();
+}
+
+// Stop receiving CPU state updates (cpu.unsubscribe)
+//
+// No parameters.  Response (same event name) with no other properties.
+void WebSocketCPUState::Unsubscribe(DebuggerRequest &req) {
+	subscribed_ = false;
+	lastValues_.clear();
+	req.Respond();
+}
+
+void WebSocketCPUState::GatherValues(std::vector<uint32_t> &values) {
+	values.clear();
+	for (int c = 0; c < currentDebugMIPS->GetNumCategories(); ++c) {
+		int total = currentDebugMIPS->GetNumRegsInCategory(c);
+		for (int r = 0; r < total; ++r)
+			values.push_back(currentDebugMIPS->GetRegValue(c, r));
+		if (c == 0) {
+			values.push_back(currentDebugMIPS->GetPC());
+			values.push_back(currentDebugMIPS->GetHi());
+			values.push_back(currentDebugMIPS->GetLo());
+		}
+	}
+}
+
+void WebSocketCPUState::Broadcast(net::WebSocketServer *ws) {
+	if (!subscribed_ || !PSP_IsInited() || !currentDebugMIPS->isAlive()) {
+		return;
+	}
+
+	int steppingCounter = Core_GetSteppingCounter();
+	if (coreState == CORE_STEPPING && steppingCounter != lastCounter_) {
+		std::vector<uint32_t> values;
+		GatherValues(values);
+
+		// If sizes mismatch (first time), everything counts as changed.
+		const bool sendAll = values.size() != lastValues_.size();
+
+		JsonWriter json;
+		json.begin();
+		json.writeString("event", "cpu.delta");
+		json.pushArray("registers");
+		size_t i = 0;
+		bool anyChanged = false;
+		for (int c = 0; c < currentDebugMIPS->GetNumCategories(); ++c) {
+			int total = currentDebugMIPS->GetNumRegsInCategory(c) + (c == 0 ? 3 : 0);
+			for (int r = 0; r < total; ++r, ++i) {
+				if (!sendAll && values[i] == lastValues_[i])
+					continue;
+				anyChanged = true;
+				json.pushDict();
+				json.writeInt("category", c);
+				json.writeInt("register", r);
+				json.writeUint("uintValue", values[i]);
+				json.writeString("floatValue", RegValueAsFloat(values[i]));
+				json.pop();
+			}
+		}
+		json.pop();
+		json.end();
+
+		if (anyChanged) {
+			ws->Send(json.str());
+		}
+		lastValues_ = std::move(values);
+	}
+	lastCounter_ = steppingCounter;
+}
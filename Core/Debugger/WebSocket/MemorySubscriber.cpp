@@ -0,0 +1,345 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+#include <cstring>
+#include <vector>
+#include "data/base64.h"
+#include "Core/Core.h"
+#include "Core/Debugger/WebSocket/MemorySubscriber.h"
+#include "Core/Debugger/WebSocket/WebSocketUtils.h"
+#include "Core/MemMap.h"
+#include "Core/System.h"
+
+// Memory reads are batched (many ranges per request) and can return binary
+// WebSocket frames instead of base64 JSON, since stepping through a memory
+// view over a slow link otherwise drowns in per-read text messages.
+// Subscriptions resend only the changed bytes whenever the CPU stops.
+//
+// Binary frames all start with a 4 byte magic, then little-endian fields:
+//   "MEMR"  full read: uint32 token, uint32 numRanges, then for each range
+//           uint32 address, uint32 size, uint8 valid, and size bytes if valid.
+//   "MEMD"  delta: uint32 token, uint32 numChunks, then for each chunk
+//           uint32 address, uint32 size, and size bytes.
+
+struct MemRange {
+	u32 address;
+	u32 size;
+};
+
+struct MemSubscription {
+	u32 token;
+	std::vector<MemRange> ranges;
+	// Parallel to ranges, the last data sent (for delta comparison.)
+	std::vector<std::vector<u8>> snapshots;
+};
+
+class WebSocketMemoryState : public DebuggerSubscriber {
+public:
+	void Read(DebuggerRequest &req);
+	void Subscribe(DebuggerRequest &req);
+	void Unsubscribe(DebuggerRequest &req);
+
+	void Broadcast(net::WebSocketServer *ws) override;
+
+protected:
+	bool ParseRanges(DebuggerRequest &req, std::vector<MemRange> *ranges);
+	void SendReadFrame(net::WebSocketServer *ws, u32 token, const std::vector<MemRange> &ranges, std::vector<std::vector<u8>> *snapshots);
+	void SendDeltaFrame(net::WebSocketServer *ws, MemSubscription &sub);
+
+	std::vector<MemSubscription> subscriptions_;
+	int lastCounter_ = 0;
+
+	// Compare/resend granularity for deltas, and a sanity cap per request.
+	enum : u32 {
+		DELTA_CHUNK_SIZE = 64,
+		MAX_TOTAL_SIZE = 16 * 1024 * 1024,
+	};
+};
+
+DebuggerSubscriber *WebSocketMemoryInit(DebuggerEventHandlerMap &map) {
+	auto p = new WebSocketMemoryState();
+	map["memory.read"] = std::bind(&WebSocketMemoryState::Read, p, std::placeholders::_1);
+	map["memory.subscribe"] = std::bind(&WebSocketMemoryState::Subscribe, p, std::placeholders::_1);
+	map["memory.unsubscribe"] = std::bind(&WebSocketMemoryState::Unsubscribe, p, std::placeholders::_1);
+
+	return p;
+}
+
+static void WriteU32(std::vector<u8> &buf, u32 v) {
+	buf.push_back((u8)(v & 0xFF));
+	buf.push_back((u8)((v >> 8) & 0xFF));
+	buf.push_back((u8)((v >> 16) & 0xFF));
+	buf.push_back((u8)((v >> 24) & 0xFF));
+}
+
+bool WebSocketMemoryState::ParseRanges(DebuggerRequest &req, std::vector<MemRange> *ranges) {
+	if (req.HasParam("ranges")) {
+		const JsonNode *node = req.data.getArray("ranges");
+		if (!node) {
+			req.Fail("Invalid 'ranges' parameter");
+			return false;
+		}
+		for (const JsonNode *r : node->value) {
+			if (r->value.getTag() != JSON_OBJECT) {
+				req.Fail("Invalid 'ranges' entry");
+				return false;
+			}
+			const JsonGet dict(r->value);
+			double address = dict.getFloat("address", -1.0);
+			double size = dict.getFloat("size", -1.0);
+			if (address < 0.0 || size <= 0.0) {
+				req.Fail("Invalid address or size in 'ranges' entry");
+				return false;
+			}
+			ranges->push_back(MemRange{ (u32)address, (u32)size });
+		}
+	} else {
+		u32 address, size;
+		if (!req.ParamU32("address", &address))
+			return false;
+		if (!req.ParamU32("size", &size))
+			return false;
+		ranges->push_back(MemRange{ address, size });
+	}
+
+	if (ranges->empty()) {
+		req.Fail("No ranges requested");
+		return false;
+	}
+
+	u64 total = 0;
+	for (const auto &range : *ranges)
+		total += range.size;
+	if (total > MAX_TOTAL_SIZE) {
+		req.Fail("Too much data requested");
+		return false;
+	}
+
+	return true;
+}
+
+void WebSocketMemoryState::SendReadFrame(net::WebSocketServer *ws, u32 token, const std::vector<MemRange> &ranges, std::vector<std::vector<u8>> *snapshots) {
+	std::vector<u8> frame;
+	frame.push_back('M');
+	frame.push_back('E');
+	frame.push_back('M');
+	frame.push_back('R');
+	WriteU32(frame, token);
+	WriteU32(frame, (u32)ranges.size());
+
+	for (const auto &range : ranges) {
+		WriteU32(frame, range.address);
+		WriteU32(frame, range.size);
+		const bool valid = Memory::IsValidRange(range.address, range.size);
+		frame.push_back(valid ? 1 : 0);
+		if (valid) {
+			size_t pos = frame.size();
+			frame.resize(pos + range.size);
+			memcpy(&frame[pos], Memory::GetPointer(range.address), range.size);
+			if (snapshots)
+				snapshots->push_back(std::vector<u8>(&frame[pos], &frame[pos] + range.size));
+		} else if (snapshots) {
+			snapshots->push_back(std::vector<u8>());
+		}
+	}
+
+	ws->Send(frame);
+}
+
+// Read one or more ranges of memory (memory.read)
+//
+// Parameters (either, not both):
+//  - address and size: numbers, a single range.
+//  - ranges: array of objects with address and size properties.
+// Optionally:
+//  - format: "base64" (default) or "binary" for a binary frame reply.
+//  - token: number echoed back, to correlate binary frames (default 0.)
+//
+// Response (same event name) for base64:
+//  - ranges: array of objects with:
+//     - address: number, start of the range.
+//     - size: number, length of the range.
+//     - base64: base64 encode of the bytes, or null if the range was invalid.
+//
+// For binary, the response carries only the token, and the data follows
+// as a "MEMR" binary frame (see the top of this file.)
+void WebSocketMemoryState::Read(DebuggerRequest &req) {
+	if (!PSP_IsInited())
+		return req.Fail("CPU not started");
+
+	std::vector<MemRange> ranges;
+	if (!ParseRanges(req, &ranges))
+		return;
+
+	std::string format = "base64";
+	if (!req.ParamString("format", &format, DebuggerParamType::OPTIONAL))
+		return;
+	u32 token = 0;
+	if (!req.ParamU32("token", &token, false, DebuggerParamType::OPTIONAL))
+		return;
+
+	if (format == "binary") {
+		JsonWriter &json = req.Respond();
+		json.writeUint("token", token);
+		req.Flush();
+		SendReadFrame(req.ws, token, ranges, nullptr);
+		return;
+	}
+	if (format != "base64")
+		return req.Fail("Invalid 'format' parameter");
+
+	JsonWriter &json = req.Respond();
+	json.pushArray("ranges");
+	for (const auto &range : ranges) {
+		json.pushDict();
+		json.writeUint("address", range.address);
+		json.writeUint("size", range.size);
+		if (Memory::IsValidRange(range.address, range.size))
+			json.writeString("base64", Base64Encode(Memory::GetPointer(range.address), range.size));
+		else
+			json.writeRaw("base64", "null");
+		json.pop();
+	}
+	json.pop();
+}
+
+// Watch ranges of memory for changes (memory.subscribe)
+//
+// Parameters:
+//  - token: number identifying this subscription, echoed in delta frames.
+//  - address and size, or ranges: as in memory.read.
+//
+// Response (same event name) carries the token.  The current contents are
+// sent right away as a "MEMR" binary frame.  After that, whenever the CPU
+// stops (stepping, breakpoint), only the changed bytes are sent as "MEMD"
+// binary frames - nothing at all if the watched memory didn't change.
+void WebSocketMemoryState::Subscribe(DebuggerRequest &req) {
+	if (!PSP_IsInited())
+		return req.Fail("CPU not started");
+
+	u32 token;
+	if (!req.ParamU32("token", &token))
+		return;
+
+	MemSubscription sub;
+	sub.token = token;
+	if (!ParseRanges(req, &sub.ranges))
+		return;
+
+	// Replace any existing subscription with the same token.
+	for (size_t i = 0; i < subscriptions_.size(); ++i) {
+		if (subscriptions_[i].token == token) {
+			subscriptions_.erase(subscriptions_.begin() + i);
+			break;
+		}
+	}
+
+	JsonWriter &json = req.Respond();
+	json.writeUint("token", token);
+	req.Flush();
+	SendReadFrame(req.ws, token, sub.ranges, &sub.snapshots);
+	subscriptions_.push_back(std::move(sub));
+}
+
+// Stop watching memory (memory.unsubscribe)
+//
+// Parameters:
+//  - token: number previously passed to memory.subscribe.
+//
+// Response (same event name) carries the token.
+void WebSocketMemoryState::Unsubscribe(DebuggerRequest &req) {
+	u32 token;
+	if (!req.ParamU32("token", &token))
+		return;
+
+	for (size_t i = 0; i < subscriptions_.size(); ++i) {
+		if (subscriptions_[i].token == token) {
+			subscriptions_.erase(subscriptions_.begin() + i);
+			JsonWriter &json = req.Respond();
+			json.writeUint("token", token);
+			return;
+		}
+	}
+	req.Fail("Subscription not found");
+}
+
+void WebSocketMemoryState::SendDeltaFrame(net::WebSocketServer *ws, MemSubscription &sub) {
+	std::vector<u8> frame;
+	u32 numChunks = 0;
+
+	for (size_t i = 0; i < sub.ranges.size(); ++i) {
+		const MemRange &range = sub.ranges[i];
+		std::vector<u8> &snapshot = sub.snapshots[i];
+		if (snapshot.empty() || !Memory::IsValidRange(range.address, range.size))
+			continue;
+
+		const u8 *now = Memory::GetPointer(range.address);
+		// Compare in chunks, coalescing adjacent changed ones.
+		u32 runStart = 0;
+		bool inRun = false;
+		for (u32 pos = 0; pos < range.size; pos += DELTA_CHUNK_SIZE) {
+			u32 chunk = std::min((u32)DELTA_CHUNK_SIZE, range.size - pos);
+			bool changed = memcmp(&snapshot[pos], now + pos, chunk) != 0;
+			if (changed && !inRun) {
+				runStart = pos;
+				inRun = true;
+			} else if (!changed && inRun) {
+				WriteU32(frame, range.address + runStart);
+				WriteU32(frame, pos - runStart);
+				frame.insert(frame.end(), now + runStart, now + pos);
+				++numChunks;
+				inRun = false;
+			}
+		}
+		if (inRun) {
+			WriteU32(frame, range.address + runStart);
+			WriteU32(frame, range.size - runStart);
+			frame.insert(frame.end(), now + runStart, now + range.size);
+			++numChunks;
+		}
+
+		memcpy(snapshot.data(), now, range.size);
+	}
+
+	if (numChunks == 0)
+		return;
+
+	std::vector<u8> header;
+	header.push_back('M');
+	header.push_back('E');
+	header.push_back('M');
+	header.push_back('D');
+	WriteU32(header, sub.token);
+	WriteU32(header, numChunks);
+	frame.insert(frame.begin(), header.begin(), header.end());
+	ws->Send(frame);
+}
+
+void WebSocketMemoryState::Broadcast(net::WebSocketServer *ws) {
+	if (!PSP_IsInited()) {
+		return;
+	}
+
+	// Only rescan when the CPU has stopped again - each step or break.
+	int steppingCounter = Core_GetSteppingCounter();
+	if (coreState == CORE_STEPPING && steppingCounter != lastCounter_) {
+		for (auto &sub : subscriptions_) {
+			SendDeltaFrame(ws, sub);
+		}
+	}
+	lastCounter_ = steppingCounter;
+}
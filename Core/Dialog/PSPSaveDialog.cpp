@@ -54,11 +54,13 @@ PSPSaveDialog::PSPSaveDialog()
 	, display(DS_NONE)
 	, currentSelectedSave(0)
 	, ioThread(0)
+	, iconThread(0)
 {
 	param.SetPspParam(0);
 }
 
 PSPSaveDialog::~PSPSaveDialog() {
+	JoinIconThread();
 }
 
 int PSPSaveDialog::Init(int paramAddr)
@@ -70,6 +72,7 @@ int PSPSaveDialog::Init(int paramAddr)
 	}
 
 	JoinIOThread();
+	JoinIconThread();
 	ioThreadStatus = SAVEIO_NONE;
 
 	requestAddr = paramAddr;
@@ -208,6 +211,8 @@ int PSPSaveDialog::Init(int paramAddr)
 		ChangeStatusShutdown(SAVEDATA_SHUTDOWN_DELAY_US);
 	} else {
 		ChangeStatusInit(SAVEDATA_INIT_DELAY_US);
+		// Get the PNG icons decoded before the first frame wants to draw them.
+		StartIconPreloadThread();
 	}
 
 	UpdateButtons();
@@ -1150,11 +1155,42 @@ void PSPSaveDialog::StartIOThread() {
 	ioThread = new std::thread(&DoExecuteIOAction, this);
 }
 
+void PSPSaveDialog::ExecuteIconPreload() {
+	int count = param.GetFilenameCount();
+	// Even without a name list there's one entry (the current save.)
+	if (count == 0)
+		count = 1;
+	for (int i = 0; i < count; ++i) {
+		const SaveFileInfo &info = param.GetFileInfo(i);
+		if (info.texture != NULL)
+			info.texture->Preload();
+	}
+}
+
+static void DoExecuteIconPreload(PSPSaveDialog *dialog) {
+	setCurrentThreadName("SaveIcons");
+	dialog->ExecuteIconPreload();
+}
+
+void PSPSaveDialog::JoinIconThread() {
+	if (iconThread) {
+		iconThread->join();
+		delete iconThread;
+		iconThread = 0;
+	}
+}
+
+void PSPSaveDialog::StartIconPreloadThread() {
+	JoinIconThread();
+	iconThread = new std::thread(&DoExecuteIconPreload, this);
+}
+
 int PSPSaveDialog::Shutdown(bool force) {
 	if (GetStatus() != SCE_UTILITY_STATUS_FINISHED && !force)
 		return SCE_ERROR_UTILITY_INVALID_STATUS;
 
 	JoinIOThread();
+	JoinIconThread();
 	ioThreadStatus = SAVEIO_NONE;
 
 	PSPDialog::Shutdown(force);
@@ -1168,6 +1204,7 @@ int PSPSaveDialog::Shutdown(bool force) {
 
 void PSPSaveDialog::DoState(PointerWrap &p) {
 	JoinIOThread();
+	JoinIconThread();
 	PSPDialog::DoState(p);
 
 	auto s = p.Section("PSPSaveDialog", 1, 2);
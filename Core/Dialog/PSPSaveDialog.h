@@ -80,6 +80,7 @@ public:
 	virtual pspUtilityDialogCommon *GetCommonParam() override;
 
 	void ExecuteIOAction();
+	void ExecuteIconPreload();
 
 protected:
 	virtual bool UseAutoStatus() override {
@@ -100,6 +101,9 @@ private:
 	void StartIOThread();
 	void ExecuteNotVisibleIOAction();
 
+	void JoinIconThread();
+	void StartIconPreloadThread();
+
 	enum DisplayState
 	{
 		DS_NONE,
@@ -154,6 +158,8 @@ private:
 	};
 
 	std::thread *ioThread;
+	// Decodes the save list's PNG icons ahead of the PPGe rendering.
+	std::thread *iconThread;
 	std::mutex paramLock;
 	volatile SaveIOStatus ioThreadStatus;
 };
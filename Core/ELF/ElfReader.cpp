@@ -15,6 +15,10 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <atomic>
+#include <vector>
+
+#include "Common/ThreadPools.h"
 #include "Core/MemMap.h"
 #include "Core/Reporting.h"
 #include "Core/MIPS/MIPSTables.h"
@@ -55,27 +59,39 @@ void addrToHiLo(u32 addr, u16 &hi, s16 &lo)
 
 bool ElfReader::LoadRelocations(const Elf32_Rel *rels, int numRelocs)
 {
-	int numErrors = 0;
+	std::atomic<int> numErrors(0);
 	DEBUG_LOG(LOADER, "Loading %i relocations...", numRelocs);
-	for (int r = 0; r < numRelocs; r++)
+
+	// Relocations are applied in two passes so the expensive decode can run
+	// on the thread pool - some games carry hundreds of thousands.  First
+	// every new opcode is computed against the unmodified memory (R_MIPS_HI16
+	// peeks at its matching LO16's pre-relocation value, so writing as we go
+	// would race between chunks), then they're all stored.
+	std::vector<u32> relocAddrs(numRelocs);
+	std::vector<u32> relocOps(numRelocs);
+
+	auto computeRange = [&](int l, int h) {
+	for (int r = l; r < h; r++)
 	{
 		// INFO_LOG(LOADER, "Loading reloc %i  (%p)...", r, rels + r);
 		u32 info = rels[r].r_info;
 		u32 addr = rels[r].r_offset;
 
+		// Zero means skip - never a valid relocation target.
+		relocAddrs[r] = 0;
+
 		int type = info & 0xf;
 
-		int readwrite = (info>>8) & 0xff; 
+		int readwrite = (info>>8) & 0xff;
 		int relative  = (info>>16) & 0xff;
 
 		//0 = code
 		//1 = data
 
 		if (readwrite >= (int)ARRAY_SIZE(segmentVAddr)) {
-			if (numErrors < 10) {
+			if (numErrors.fetch_add(1) < 10) {
 				ERROR_LOG_REPORT(LOADER, "Bad segment number %i", readwrite);
 			}
-			numErrors++;
 			continue;
 		}
 
@@ -85,12 +101,12 @@ bool ElfReader::LoadRelocations(const Elf32_Rel *rels, int numRelocs)
 		// Will they work correctly on big-endian?
 
 		if (((addr & 3) && type != R_MIPS_32) || !Memory::IsValidAddress(addr)) {
-			if (numErrors < 10) {
+			int errors = numErrors.fetch_add(1);
+			if (errors < 10) {
 				WARN_LOG_REPORT(LOADER, "Suspicious address %08x, skipping reloc, type = %d", addr, type);
-			} else if (numErrors == 10) {
+			} else if (errors == 10) {
 				WARN_LOG(LOADER, "Too many bad relocations, skipping logging");
 			}
-			numErrors++;
 			continue;
 		}
 
@@ -189,10 +205,25 @@ bool ElfReader::LoadRelocations(const Elf32_Rel *rels, int numRelocs)
 			}
 			break;
 		}
-		Memory::Write_U32(op, addr);
+		relocAddrs[r] = addr;
+		relocOps[r] = op;
 	}
+	};
+
+	if (numRelocs >= 1024) {
+		GlobalThreadPool::Loop(computeRange, 0, numRelocs);
+	} else {
+		computeRange(0, numRelocs);
+	}
+
+	for (int r = 0; r < numRelocs; r++) {
+		if (relocAddrs[r] != 0) {
+			Memory::Write_U32(relocOps[r], relocAddrs[r]);
+		}
+	}
+
 	if (numErrors) {
-		WARN_LOG(LOADER, "%i bad relocations found!!!", numErrors);
+		WARN_LOG(LOADER, "%i bad relocations found!!!", numErrors.load());
 	}
 	return numErrors == 0;
 }
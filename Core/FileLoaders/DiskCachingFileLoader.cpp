@@ -281,7 +281,7 @@ size_t DiskCachingFileLoaderCache::SaveIntoCache(FileLoader *backend, s64 pos, s
 		if (info.block == INVALID_BLOCK && readBytes != 0) {
 			info.block = AllocateBlock((u32)cacheStartPos);
 			WriteBlockData(info, buf);
-			WriteIndexData((u32)cacheStartPos, info);
+			WriteIndexRange((u32)cacheStartPos, 1);
 		}
 
 		size_t toRead = std::min(bytes - readSize, (size_t)blockSize_ - offset);
@@ -293,16 +293,30 @@ size_t DiskCachingFileLoaderCache::SaveIntoCache(FileLoader *backend, s64 pos, s
 		u8 *wholeRead = new u8[blocksToRead * blockSize_];
 		size_t readBytes = backend->ReadAt(cacheStartPos * (u64)blockSize_, blocksToRead * blockSize_, wholeRead, flags);
 
-		for (size_t i = 0; i < blocksToRead; ++i) {
-			auto &info = index_[cacheStartPos + i];
-			// Check if it was written while we were busy.  Might happen if we thread.
-			if (info.block == INVALID_BLOCK && readBytes != 0) {
-				info.block = AllocateBlock((u32)cacheStartPos + (u32)i);
-				WriteBlockData(info, wholeRead + (i * blockSize_));
-				// TODO: Doing each index together would probably be better.
-				WriteIndexData((u32)cacheStartPos + (u32)i, info);
+		if (readBytes != 0) {
+			// Prefer one contiguous extent so the data lands as a single
+			// sequential write instead of a scatter of small ones.
+			u32 runStart = AllocateBlockRun((u32)cacheStartPos, (u32)blocksToRead);
+			if (runStart != INVALID_BLOCK) {
+				for (size_t i = 0; i < blocksToRead; ++i) {
+					index_[cacheStartPos + i].block = runStart + (u32)i;
+				}
+				WriteBlockData(index_[cacheStartPos], wholeRead, (u32)blocksToRead);
+			} else {
+				for (size_t i = 0; i < blocksToRead; ++i) {
+					auto &info = index_[cacheStartPos + i];
+					// Check if it was written while we were busy.  Might happen if we thread.
+					if (info.block == INVALID_BLOCK) {
+						info.block = AllocateBlock((u32)cacheStartPos + (u32)i);
+						WriteBlockData(info, wholeRead + (i * blockSize_));
+					}
+				}
 			}
+			// And one write for all the index entries.
+			WriteIndexRange((u32)cacheStartPos, (u32)blocksToRead);
+		}
 
+		for (size_t i = 0; i < blocksToRead; ++i) {
 			size_t toRead = std::min(bytes - readSize, (size_t)blockSize_ - offset);
 			memcpy(p + readSize, wholeRead + (i * blockSize_) + offset, toRead);
 			readSize += toRead;
@@ -325,6 +339,8 @@ bool DiskCachingFileLoaderCache::MakeCacheSpaceFor(size_t blocks) {
 
 	while (cacheSize_ > goal) {
 		u16 minGeneration = generation_;
+		u32 dirtyMin = INVALID_INDEX;
+		u32 dirtyMax = 0;
 
 		// We increment the iterator inside because we delete things inside.
 		for (size_t i = 0; i < blockIndexLookup_.size(); ++i) {
@@ -346,8 +362,13 @@ bool DiskCachingFileLoaderCache::MakeCacheSpaceFor(size_t blocks) {
 				info.hits = 0;
 				--cacheSize_;
 
-				// TODO: Doing this in chunks might be a lot better.
-				WriteIndexData(blockIndexLookup_[i], info);
+				const u32 indexPos = blockIndexLookup_[i];
+				if (dirtyMin == INVALID_INDEX || indexPos < dirtyMin) {
+					dirtyMin = indexPos;
+				}
+				if (indexPos > dirtyMax) {
+					dirtyMax = indexPos;
+				}
 				blockIndexLookup_[i] = INVALID_INDEX;
 
 				// Keep going?
@@ -357,6 +378,12 @@ bool DiskCachingFileLoaderCache::MakeCacheSpaceFor(size_t blocks) {
 			}
 		}
 
+		// Flush all the evicted entries with one sequential write, instead of
+		// one small write per entry.
+		if (dirtyMin != INVALID_INDEX) {
+			WriteIndexRange(dirtyMin, dirtyMax - dirtyMin + 1);
+		}
+
 		// If we didn't find any, update to the lowest we did find.
 		oldestGeneration_ = minGeneration;
 	}
@@ -376,11 +403,12 @@ void DiskCachingFileLoaderCache::RebalanceGenerations() {
 
 		if (info.generation > oldestGeneration_) {
 			info.generation = (info.generation - oldestGeneration_) / 2;
-			// TODO: Doing this all at once would be much better.
-			WriteIndexData((u32)i, info);
 		}
 	}
 
+	// This touches most entries, so write the whole index in one go.
+	WriteIndexRange(0, (u32)index_.size());
+
 	oldestGeneration_ = 0;
 }
 
@@ -396,6 +424,30 @@ u32 DiskCachingFileLoaderCache::AllocateBlock(u32 indexPos) {
 	return INVALID_BLOCK;
 }
 
+u32 DiskCachingFileLoaderCache::AllocateBlockRun(u32 indexPos, u32 count) {
+	if (count <= 1) {
+		return INVALID_BLOCK;
+	}
+
+	u32 runLength = 0;
+	for (u32 i = 0; i < (u32)blockIndexLookup_.size(); ++i) {
+		if (blockIndexLookup_[i] != INVALID_INDEX) {
+			runLength = 0;
+			continue;
+		}
+
+		if (++runLength == count) {
+			const u32 start = i - count + 1;
+			for (u32 b = 0; b < count; ++b) {
+				blockIndexLookup_[start + b] = indexPos + b;
+			}
+			return start;
+		}
+	}
+
+	return INVALID_BLOCK;
+}
+
 std::string DiskCachingFileLoaderCache::MakeCacheFilename(const std::string &path) {
 	static const char *const invalidChars = "?*:/\\^|<>\"'";
 	std::string filename = path;
@@ -435,9 +487,12 @@ bool DiskCachingFileLoaderCache::ReadBlockData(u8 *dest, BlockInfo &info, size_t
 	}
 	s64 blockOffset = GetBlockOffset(info.block);
 
-	// Before we read, make sure the buffers are flushed.
+	// Before we read, make sure any pending writes are flushed.
 	// We might be trying to read an area we've recently written.
-	fflush(f_);
+	if (pendingWrites_) {
+		fflush(f_);
+		pendingWrites_ = false;
+	}
 
 	bool failed = false;
 #ifdef __ANDROID__
@@ -461,23 +516,24 @@ bool DiskCachingFileLoaderCache::ReadBlockData(u8 *dest, BlockInfo &info, size_t
 	return !failed;
 }
 
-void DiskCachingFileLoaderCache::WriteBlockData(BlockInfo &info, u8 *src) {
+void DiskCachingFileLoaderCache::WriteBlockData(BlockInfo &info, u8 *src, u32 count) {
 	if (!f_) {
 		return;
 	}
 	s64 blockOffset = GetBlockOffset(info.block);
+	const size_t writeSize = (size_t)blockSize_ * count;
 
 	bool failed = false;
 #ifdef __ANDROID__
 	if (lseek64(fd_, blockOffset, SEEK_SET) != blockOffset) {
 		failed = true;
-	} else if (write(fd_, src, blockSize_) != (ssize_t)blockSize_) {
+	} else if (write(fd_, src, writeSize) != (ssize_t)writeSize) {
 		failed = true;
 	}
 #else
 	if (fseeko(f_, blockOffset, SEEK_SET) != 0) {
 		failed = true;
-	} else if (fwrite(src, blockSize_, 1, f_) != 1) {
+	} else if (fwrite(src, blockSize_, count, f_) != count) {
 		failed = true;
 	}
 #endif
@@ -485,10 +541,12 @@ void DiskCachingFileLoaderCache::WriteBlockData(BlockInfo &info, u8 *src) {
 	if (failed) {
 		ERROR_LOG(LOADER, "Unable to write disk cache data entry.");
 		CloseFileHandle();
+	} else {
+		pendingWrites_ = true;
 	}
 }
 
-void DiskCachingFileLoaderCache::WriteIndexData(u32 indexPos, BlockInfo &info) {
+void DiskCachingFileLoaderCache::WriteIndexRange(u32 indexPos, u32 count) {
 	if (!f_) {
 		return;
 	}
@@ -498,13 +556,15 @@ void DiskCachingFileLoaderCache::WriteIndexData(u32 indexPos, BlockInfo &info) {
 	bool failed = false;
 	if (fseek(f_, offset, SEEK_SET) != 0) {
 		failed = true;
-	} else if (fwrite(&info, sizeof(BlockInfo), 1, f_) != 1) {
+	} else if (fwrite(&index_[indexPos], sizeof(BlockInfo), count, f_) != count) {
 		failed = true;
 	}
 
 	if (failed) {
-		ERROR_LOG(LOADER, "Unable to write disk cache index entry.");
+		ERROR_LOG(LOADER, "Unable to write disk cache index entries.");
 		CloseFileHandle();
+	} else {
+		pendingWrites_ = true;
 	}
 }
 
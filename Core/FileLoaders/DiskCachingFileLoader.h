@@ -91,11 +91,16 @@ private:
 	bool MakeCacheSpaceFor(size_t blocks);
 	void RebalanceGenerations();
 	u32 AllocateBlock(u32 indexPos);
+	// Tries to grab a run of contiguous free blocks for index positions
+	// [indexPos, indexPos + count), so a multi-block read lands as one
+	// sequential write.  Returns the first block, or INVALID_BLOCK if no
+	// contiguous run is free (the caller falls back to scattered blocks.)
+	u32 AllocateBlockRun(u32 indexPos, u32 count);
 
 	struct BlockInfo;
 	bool ReadBlockData(u8 *dest, BlockInfo &info, size_t offset, size_t size);
-	void WriteBlockData(BlockInfo &info, u8 *src);
-	void WriteIndexData(u32 indexPos, BlockInfo &info);
+	void WriteBlockData(BlockInfo &info, u8 *src, u32 count = 1);
+	void WriteIndexRange(u32 indexPos, u32 count);
 	s64 GetBlockOffset(u32 block);
 
 	std::string MakeCacheFilePath(const std::string &path);
@@ -175,6 +180,8 @@ private:
 
 	FILE *f_ = nullptr;
 	int fd_ = 0;
+	// Whether we've written since the last flush, so reads can skip the flush.
+	bool pendingWrites_ = false;
 
 	static std::string cacheDir_;
 };
@@ -23,6 +23,8 @@
 
 HTTPFileLoader::HTTPFileLoader(const std::string &filename)
 	: url_(filename), filename_(filename) {
+	// Each connect costs us a round trip or three - reuse the connection between reads.
+	client_.SetKeepAlive(true);
 }
 
 void HTTPFileLoader::Prepare() {
@@ -98,8 +100,7 @@ void HTTPFileLoader::Prepare() {
 			}
 		}
 
-		// TODO: Keepalive instead.
-		Disconnect();
+		// Leave the connection open - the first data read follows right away.
 
 		if (!acceptsRange) {
 			WARN_LOG(LOADER, "HTTP server did not advertise support for range requests.");
@@ -182,26 +183,38 @@ size_t HTTPFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, Flags f
 		return 0;
 	}
 
-	Connect();
-	if (!connected_) {
-		return 0;
-	}
-
 	char requestHeaders[4096];
 	// Note that the Range header is *inclusive*.
 	snprintf(requestHeaders, sizeof(requestHeaders),
 		"Range: bytes=%lld-%lld\r\n", absolutePos, absoluteEnd - 1);
 
-	int err = client_.SendRequest("GET", url_.Resource().c_str(), requestHeaders, nullptr);
-	if (err < 0) {
+	Buffer readbuf;
+	std::vector<std::string> responseHeaders;
+	int code = -1;
+	// A reused keep-alive connection may have been closed by the server between
+	// reads - if so, reconnect and resend once.
+	for (int attempt = 0; attempt < 2 && code < 0; ++attempt) {
+		Connect();
+		if (!connected_) {
+			return 0;
+		}
+
+		if (client_.SendRequest("GET", url_.Resource().c_str(), requestHeaders, nullptr) < 0) {
+			Disconnect();
+			continue;
+		}
+
+		readbuf.clear();
+		responseHeaders.clear();
+		code = client_.ReadResponseHeaders(&readbuf, responseHeaders);
+		if (code < 0) {
+			Disconnect();
+		}
+	}
+	if (code < 0) {
 		latestError_ = "Invalid response reading data";
-		Disconnect();
 		return 0;
 	}
-
-	Buffer readbuf;
-	std::vector<std::string> responseHeaders;
-	int code = client_.ReadResponseHeaders(&readbuf, responseHeaders);
 	if (code != 206) {
 		ERROR_LOG(LOADER, "HTTP server did not respond with range, received code=%03d", code);
 		latestError_ = "Invalid response reading data";
@@ -212,7 +225,20 @@ size_t HTTPFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, Flags f
 	// TODO: Expire cache via ETag, etc.
 	// We don't support multipart/byteranges responses.
 	bool supportedResponse = false;
+	// Only keep the connection if the response is cleanly delimited by a
+	// Content-Length and the server didn't ask us to close it.
+	bool keepConnection = true;
+	bool hasContentLength = false;
 	for (std::string header : responseHeaders) {
+		if (startsWithNoCase(header, "Content-Length:")) {
+			hasContentLength = true;
+		}
+		if (startsWithNoCase(header, "Connection:") && header.find("close") != header.npos) {
+			keepConnection = false;
+		}
+		if (startsWithNoCase(header, "Transfer-Encoding:") && header.find("chunked") != header.npos) {
+			keepConnection = false;
+		}
 		if (startsWithNoCase(header, "Content-Range:")) {
 			// TODO: More correctness.  Whitespace can be missing or different.
 			s64 first = -1, last = -1, total = -1;
@@ -238,8 +264,9 @@ size_t HTTPFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, Flags f
 		// Let's take anything we got anyway.  Not worse than returning nothing?
 	}
 
-	// TODO: Keepalive instead.
-	Disconnect();
+	if (!keepConnection || !hasContentLength || res != 0) {
+		Disconnect();
+	}
 
 	if (!supportedResponse) {
 		ERROR_LOG(LOADER, "HTTP server did not respond with the range we wanted.");
@@ -27,10 +27,19 @@
 #include "Common/CommonWindows.h"
 #else
 #include <fcntl.h>
+#if PPSSPP_ARCH(64BIT)
+#include <sys/mman.h>
 #endif
+#endif
+
+#include <cstring>
 
 LocalFileLoader::LocalFileLoader(const std::string &filename)
+#ifndef _WIN32
+	: mapped_(nullptr), filesize_(0), filename_(filename) {
+#else
 	: filesize_(0), filename_(filename) {
+#endif
 	if (filename.empty()) {
 		ERROR_LOG(FILESYS, "LocalFileLoader can't load empty filenames");
 		return;
@@ -51,6 +60,17 @@ LocalFileLoader::LocalFileLoader(const std::string &filename)
 	lseek(fd_, 0, SEEK_SET);
 #endif
 
+#if PPSSPP_ARCH(64BIT)
+	// Plenty of address space - map the file and let the page cache do the work.
+	// On 32-bit we'd risk running the address space dry, so we stick to pread.
+	if (filesize_ > 0) {
+		void *mapped = mmap(nullptr, filesize_, PROT_READ, MAP_SHARED, fd_, 0);
+		if (mapped != MAP_FAILED) {
+			mapped_ = mapped;
+		}
+	}
+#endif
+
 #else // _WIN32
 
 	const DWORD access = GENERIC_READ, share = FILE_SHARE_READ, mode = OPEN_EXISTING, flags = FILE_ATTRIBUTE_NORMAL;
@@ -77,6 +97,11 @@ LocalFileLoader::LocalFileLoader(const std::string &filename)
 
 LocalFileLoader::~LocalFileLoader() {
 #ifndef _WIN32
+#if PPSSPP_ARCH(64BIT)
+	if (mapped_ != nullptr) {
+		munmap(mapped_, filesize_);
+	}
+#endif
 	if (fd_ != -1) {
 		close(fd_);
 	}
@@ -117,6 +142,19 @@ std::string LocalFileLoader::Path() const {
 }
 
 size_t LocalFileLoader::ReadAt(s64 absolutePos, size_t bytes, size_t count, void *data, Flags flags) {
+#if !defined(_WIN32) && PPSSPP_ARCH(64BIT)
+	if (mapped_ != nullptr) {
+		if (absolutePos < 0 || (u64)absolutePos >= filesize_) {
+			return 0;
+		}
+		size_t copyBytes = bytes * count;
+		if ((u64)absolutePos + copyBytes > filesize_) {
+			copyBytes = (size_t)(filesize_ - absolutePos);
+		}
+		memcpy(data, (const u8 *)mapped_ + absolutePos, copyBytes);
+		return copyBytes / bytes;
+	}
+#endif
 #if PPSSPP_PLATFORM(ANDROID)
 	// pread64 doesn't appear to actually be 64-bit safe, though such ISOs are uncommon.  See #10862.
 	if (absolutePos <= 0x7FFFFFFF) {
@@ -38,6 +38,9 @@ public:
 private:
 #ifndef _WIN32
 	int fd_;
+	// On 64-bit platforms we map the whole file and serve reads straight from
+	// the page cache, no syscall per read. nullptr when mapping isn't possible.
+	void *mapped_;
 #else
 	HANDLE handle_;
 #endif
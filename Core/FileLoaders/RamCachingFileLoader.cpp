@@ -22,10 +22,26 @@
 
 #include "base/timeutil.h"
 #include "thread/threadutil.h"
+#include "Common/FileUtil.h"
+#include "Core/Config.h"
 #include "Core/FileLoaders/RamCachingFileLoader.h"
+#include "Core/System.h"
 
 #include "Common/Log.h"
 
+static const char * const PATTERNFILE_MAGIC = "ppssppRA";
+
+// Totalled across instances so the overlay doesn't have to chase the loader.
+static std::atomic<u64> g_ramCacheHits(0);
+static std::atomic<u64> g_ramCacheMisses(0);
+static std::atomic<u64> g_ramCacheEvictions(0);
+
+void RamCachingFileLoader::GetRAMCacheStats(u64 *hits, u64 *misses, u64 *evictions) {
+	*hits = g_ramCacheHits.load();
+	*misses = g_ramCacheMisses.load();
+	*evictions = g_ramCacheEvictions.load();
+}
+
 // Takes ownership of backend.
 RamCachingFileLoader::RamCachingFileLoader(FileLoader *backend)
 	: ProxiedFileLoader(backend) {
@@ -71,6 +87,7 @@ size_t RamCachingFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, F
 	if (cache_ == nullptr || (flags & Flags::HINT_UNCACHED) != 0) {
 		readSize = backend_->ReadAt(absolutePos, bytes, data, flags);
 	} else {
+		RecordAccess(absolutePos);
 		readSize = ReadFromCache(absolutePos, bytes, data);
 		// While in case the cache size is too small for the entire read.
 		while (readSize < bytes) {
@@ -83,6 +100,19 @@ size_t RamCachingFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, F
 			}
 		}
 
+		{
+			// Back-to-back reads mean a sequential stream (e.g. a movie), which
+			// is worth fetching ahead of in bigger chunks.
+			std::lock_guard<std::mutex> guard(blocksMutex_);
+			if (absolutePos == lastReadEnd_) {
+				++seqReads_;
+			} else {
+				seqReads_ = 0;
+			}
+			lastReadEnd_ = absolutePos + (s64)readSize;
+			aheadCount_ = seqReads_ >= 8 ? (u32)BLOCK_READAHEAD_SEQ : (u32)BLOCK_READAHEAD;
+		}
+
 		StartReadAhead(absolutePos + readSize);
 	}
 	return readSize;
@@ -91,13 +121,31 @@ size_t RamCachingFileLoader::ReadAt(s64 absolutePos, size_t bytes, void *data, F
 void RamCachingFileLoader::InitCache() {
 	std::lock_guard<std::mutex> guard(blocksMutex_);
 	u32 blockCount = (u32)((filesize_ + BLOCK_SIZE - 1) >> BLOCK_SHIFT);
-	// Overallocate for the last block.
-	cache_ = (u8 *)malloc((size_t)blockCount << BLOCK_SHIFT);
+	slotCount_ = blockCount;
+	if (g_Config.iRamCacheSizeMB > 0) {
+		u32 budgetBlocks = (u32)(((u64)g_Config.iRamCacheSizeMB << 20) >> BLOCK_SHIFT);
+		// Keep enough room that concurrent fills can never starve each other.
+		budgetBlocks = std::max(budgetBlocks, (u32)MAX_BLOCKS_PER_READ * 4);
+		if (budgetBlocks < slotCount_) {
+			slotCount_ = budgetBlocks;
+		}
+	}
+	cache_ = (u8 *)malloc((size_t)slotCount_ << BLOCK_SHIFT);
 	if (cache_ == nullptr) {
 		return;
 	}
 	aheadRemaining_ = blockCount;
-	blocks_.resize(blockCount);
+	blocks_.resize(blockCount, BLOCK_EMPTY);
+	blockSlot_.resize(blockCount, INVALID_SLOT);
+	slotBlock_.resize(slotCount_, 0);
+	slotUsed_.resize(slotCount_, 0);
+	freeSlots_.reserve(slotCount_);
+	// Hand out slots in increasing order, mostly for tidiness.
+	for (u32 i = slotCount_; i != 0; --i) {
+		freeSlots_.push_back(i - 1);
+	}
+
+	LoadAccessPattern();
 }
 
 void RamCachingFileLoader::ShutdownCache() {
@@ -109,8 +157,14 @@ void RamCachingFileLoader::ShutdownCache() {
 		sleep_ms(1);
 	}
 
+	SaveAccessPattern();
+
 	std::lock_guard<std::mutex> guard(blocksMutex_);
 	blocks_.clear();
+	blockSlot_.clear();
+	slotBlock_.clear();
+	slotUsed_.clear();
+	freeSlots_.clear();
 	if (cache_ != nullptr) {
 		free(cache_);
 		cache_ = nullptr;
@@ -148,12 +202,17 @@ size_t RamCachingFileLoader::ReadFromCache(s64 pos, size_t bytes, void *data) {
 
 	std::lock_guard<std::mutex> guard(blocksMutex_);
 	for (s64 i = cacheStartPos; i <= cacheEndPos; ++i) {
-		if (blocks_[(size_t)i] == 0) {
+		if (blocks_[(size_t)i] != BLOCK_READY) {
+			++g_ramCacheMisses;
 			return readSize;
 		}
 
+		const u32 slot = blockSlot_[(size_t)i];
+		slotUsed_[slot] = 1;
+		++g_ramCacheHits;
+
 		size_t toRead = std::min(bytes - readSize, (size_t)BLOCK_SIZE - offset);
-		s64 cachePos = (i << BLOCK_SHIFT) + offset;
+		s64 cachePos = ((s64)slot << BLOCK_SHIFT) + offset;
 		memcpy(p + readSize, &cache_[cachePos], toRead);
 		readSize += toRead;
 
@@ -166,16 +225,38 @@ size_t RamCachingFileLoader::ReadFromCache(s64 pos, size_t bytes, void *data) {
 void RamCachingFileLoader::SaveIntoCache(s64 pos, size_t bytes, Flags flags) {
 	s64 cacheStartPos = pos >> BLOCK_SHIFT;
 	s64 cacheEndPos = (pos + bytes - 1) >> BLOCK_SHIFT;
+	if ((size_t)cacheStartPos >= blocks_.size()) {
+		return;
+	}
 	if ((size_t)cacheEndPos >= blocks_.size()) {
 		cacheEndPos = blocks_.size() - 1;
 	}
 
-	size_t blocksToRead = 0;
+	s64 firstBlock = -1;
+	u32 blocksToRead = 0;
+	std::vector<u32> claimed;
 	{
-		std::lock_guard<std::mutex> guard(blocksMutex_);
+		std::unique_lock<std::mutex> guard(blocksMutex_);
+		// If another thread is already reading the first block, wait for it to
+		// land rather than reading it twice.
+		while (blocks_[(size_t)cacheStartPos] == BLOCK_FILLING) {
+			fillDone_.wait(guard);
+		}
+
 		for (s64 i = cacheStartPos; i <= cacheEndPos; ++i) {
-			if (blocks_[(size_t)i] == 0) {
-				++blocksToRead;
+			if (blocks_[(size_t)i] == BLOCK_EMPTY) {
+				u32 slot = AllocateSlot();
+				if (slot == INVALID_SLOT) {
+					break;
+				}
+				if (firstBlock == -1) {
+					firstBlock = i;
+				}
+				blocks_[(size_t)i] = BLOCK_FILLING;
+				blockSlot_[(size_t)i] = slot;
+				slotBlock_[slot] = (u32)i;
+				claimed.push_back((u32)i);
+				blocksToRead = (u32)(i - firstBlock) + 1;
 				if (blocksToRead >= MAX_BLOCKS_PER_READ) {
 					break;
 				}
@@ -183,27 +264,72 @@ void RamCachingFileLoader::SaveIntoCache(s64 pos, size_t bytes, Flags flags) {
 		}
 	}
 
-	s64 cacheFilePos = cacheStartPos << BLOCK_SHIFT;
-	size_t bytesRead = backend_->ReadAt(cacheFilePos, blocksToRead << BLOCK_SHIFT, &cache_[cacheFilePos], flags);
+	if (claimed.empty()) {
+		// Everything was already cached or in flight.
+		return;
+	}
+
+	// Slots aren't contiguous, so stage the read and distribute it afterwards.
+	std::vector<u8> staging((size_t)blocksToRead << BLOCK_SHIFT);
+	size_t bytesRead = backend_->ReadAt(firstBlock << BLOCK_SHIFT, staging.size(), &staging[0], flags);
 
 	// In case there was an error, let's not mark blocks that failed to read as read.
 	u32 blocksActuallyRead = (u32)((bytesRead + BLOCK_SIZE - 1) >> BLOCK_SHIFT);
 	{
 		std::lock_guard<std::mutex> guard(blocksMutex_);
 
-		// In case they were simultaneously read.
 		u32 blocksRead = 0;
-		for (size_t i = 0; i < blocksActuallyRead; ++i) {
-			if (blocks_[(size_t)cacheStartPos + i] == 0) {
-				blocks_[(size_t)cacheStartPos + i] = 1;
+		for (u32 block : claimed) {
+			const u32 slot = blockSlot_[block];
+			const u32 idx = block - (u32)firstBlock;
+			if (idx < blocksActuallyRead) {
+				memcpy(&cache_[(size_t)slot << BLOCK_SHIFT], &staging[(size_t)idx << BLOCK_SHIFT], BLOCK_SIZE);
+				blocks_[block] = BLOCK_READY;
+				slotUsed_[slot] = 1;
 				++blocksRead;
+			} else {
+				// Didn't get this one - put the slot back.
+				blocks_[block] = BLOCK_EMPTY;
+				blockSlot_[block] = INVALID_SLOT;
+				freeSlots_.push_back(slot);
 			}
 		}
 
-		if (aheadRemaining_ != 0) {
+		if (blocksRead <= aheadRemaining_) {
 			aheadRemaining_ -= blocksRead;
+		} else {
+			aheadRemaining_ = 0;
+		}
+	}
+	fillDone_.notify_all();
+}
+
+u32 RamCachingFileLoader::AllocateSlot() {
+	if (!freeSlots_.empty()) {
+		u32 slot = freeSlots_.back();
+		freeSlots_.pop_back();
+		return slot;
+	}
+
+	// Budget exhausted - evict the first block the clock hand finds that hasn't
+	// been touched since the last sweep.
+	for (u32 sweep = 0; sweep < slotCount_ * 2; ++sweep) {
+		const u32 slot = clockHand_;
+		clockHand_ = (clockHand_ + 1) % slotCount_;
+		if (blocks_[slotBlock_[slot]] == BLOCK_FILLING) {
+			// Mid-read, can't take this one.
+			continue;
 		}
+		if (slotUsed_[slot] != 0) {
+			slotUsed_[slot] = 0;
+			continue;
+		}
+		blocks_[slotBlock_[slot]] = BLOCK_EMPTY;
+		blockSlot_[slotBlock_[slot]] = INVALID_SLOT;
+		++g_ramCacheEvictions;
+		return slot;
 	}
+	return INVALID_SLOT;
 }
 
 void RamCachingFileLoader::StartReadAhead(s64 pos) {
@@ -230,14 +356,15 @@ void RamCachingFileLoader::StartReadAhead(s64 pos) {
 				// Must be full.
 				break;
 			}
-			u32 cacheEndPos = cacheStartPos + BLOCK_READAHEAD - 1;
+			const u32 aheadCount = aheadCount_;
+			u32 cacheEndPos = cacheStartPos + aheadCount - 1;
 			if (cacheEndPos >= blocks_.size()) {
 				cacheEndPos = (u32)blocks_.size() - 1;
 			}
 
 			for (u32 i = cacheStartPos; i <= cacheEndPos; ++i) {
-				if (blocks_[i] == 0) {
-					SaveIntoCache((u64)i << BLOCK_SHIFT, BLOCK_SIZE * BLOCK_READAHEAD, Flags::NONE);
+				if (blocks_[i] == BLOCK_EMPTY) {
+					SaveIntoCache((u64)i << BLOCK_SHIFT, (size_t)BLOCK_SIZE * aheadCount, Flags::NONE);
 					break;
 				}
 			}
@@ -251,16 +378,131 @@ void RamCachingFileLoader::StartReadAhead(s64 pos) {
 u32 RamCachingFileLoader::NextAheadBlock() {
 	std::lock_guard<std::mutex> guard(blocksMutex_);
 
+	// First, replay the recorded access pattern from the previous session.
+	// RecordAccess() keeps patternPlayPos_ roughly in sync with where the game is.
+	while (patternPlayPos_ < patternPrev_.size()) {
+		u32 block = patternPrev_[patternPlayPos_++];
+		if (block < blocks_.size() && blocks_[block] == BLOCK_EMPTY) {
+			return block;
+		}
+	}
+
 	// If we had an aheadPos_ set, start reading from there and go forward.
 	u32 startFrom = (u32)(aheadPos_ >> BLOCK_SHIFT);
-	// But next time, start from the beginning again.
-	aheadPos_ = 0;
+	u32 windowEnd = (u32)blocks_.size();
+	if (slotCount_ < blocks_.size()) {
+		// Bounded cache: stay within half the budget of the last read.  Reading
+		// further ahead would only evict blocks we still want.
+		if (startFrom + slotCount_ / 2 < windowEnd) {
+			windowEnd = startFrom + slotCount_ / 2;
+		}
+	} else {
+		// But next time, start from the beginning again.
+		aheadPos_ = 0;
+	}
 
-	for (u32 i = startFrom; i < blocks_.size(); ++i) {
-		if (blocks_[i] == 0) {
+	for (u32 i = startFrom; i < windowEnd; ++i) {
+		if (blocks_[i] == BLOCK_EMPTY) {
 			return i;
 		}
 	}
 
 	return 0xFFFFFFFF;
 }
+
+void RamCachingFileLoader::RecordAccess(s64 pos) {
+	u32 block = (u32)(pos >> BLOCK_SHIFT);
+
+	std::lock_guard<std::mutex> guard(blocksMutex_);
+	if (patternCurrent_.size() < PATTERN_MAX_ENTRIES) {
+		if (patternCurrent_.empty() || patternCurrent_.back() != block) {
+			patternCurrent_.push_back(block);
+		}
+	}
+
+	// Resync the replay position if this access matches a bit further along the
+	// recorded sequence - that way readahead keeps predicting from where the
+	// game actually is, even if it skipped some reads this run.
+	size_t end = std::min(patternPrev_.size(), patternPlayPos_ + PATTERN_MATCH_WINDOW);
+	for (size_t i = patternPlayPos_; i < end; ++i) {
+		if (patternPrev_[i] == block) {
+			patternPlayPos_ = i + 1;
+			break;
+		}
+	}
+}
+
+std::string RamCachingFileLoader::AccessPatternFilePath() {
+	// Same mangling as the disk cache uses for its .ppdc files.
+	static const char *const invalidChars = "?*:/\\^|<>\"'";
+	std::string filename = ProxiedFileLoader::Path();
+	for (size_t i = 0; i < filename.size(); ++i) {
+		int c = filename[i];
+		if (strchr(invalidChars, c) != nullptr) {
+			filename[i] = '_';
+		}
+	}
+
+	std::string dir = GetSysDirectory(DIRECTORY_CACHE);
+	if (!File::Exists(dir)) {
+		File::CreateFullPath(dir);
+	}
+
+	return dir + "/" + filename + ".ppra";
+}
+
+void RamCachingFileLoader::LoadAccessPattern() {
+	FILE *fp = File::OpenCFile(AccessPatternFilePath(), "rb");
+	if (fp == nullptr) {
+		return;
+	}
+
+	char magic[8];
+	u32 version = 0;
+	s64 patternFilesize = 0;
+	u32 count = 0;
+	bool valid = fread(magic, sizeof(magic), 1, fp) == 1;
+	valid = valid && memcmp(magic, PATTERNFILE_MAGIC, sizeof(magic)) == 0;
+	valid = valid && fread(&version, sizeof(version), 1, fp) == 1 && version == 1;
+	valid = valid && fread(&patternFilesize, sizeof(patternFilesize), 1, fp) == 1;
+	// If the underlying file changed, the old pattern is useless.
+	valid = valid && patternFilesize == filesize_;
+	valid = valid && fread(&count, sizeof(count), 1, fp) == 1 && count <= PATTERN_MAX_ENTRIES;
+
+	if (valid) {
+		std::lock_guard<std::mutex> guard(blocksMutex_);
+		patternPrev_.resize(count);
+		if (count != 0 && fread(&patternPrev_[0], sizeof(u32), count, fp) != count) {
+			patternPrev_.clear();
+		}
+		patternPlayPos_ = 0;
+	}
+	fclose(fp);
+}
+
+void RamCachingFileLoader::SaveAccessPattern() {
+	std::lock_guard<std::mutex> guard(blocksMutex_);
+	// Not worth saving trivial sessions - we'd risk overwriting a useful pattern.
+	if (patternCurrent_.size() < 16) {
+		return;
+	}
+
+	FILE *fp = File::OpenCFile(AccessPatternFilePath(), "wb");
+	if (fp == nullptr) {
+		return;
+	}
+
+	u32 version = 1;
+	u32 count = (u32)patternCurrent_.size();
+	bool valid = fwrite(PATTERNFILE_MAGIC, 8, 1, fp) == 1;
+	valid = valid && fwrite(&version, sizeof(version), 1, fp) == 1;
+	valid = valid && fwrite(&filesize_, sizeof(filesize_), 1, fp) == 1;
+	valid = valid && fwrite(&count, sizeof(count), 1, fp) == 1;
+	valid = valid && fwrite(&patternCurrent_[0], sizeof(u32), count, fp) == count;
+	fclose(fp);
+
+	if (!valid) {
+		// Don't leave a truncated pattern behind.
+		File::Delete(AccessPatternFilePath());
+	}
+}
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <string>
 #include <vector>
 #include <mutex>
 
@@ -40,6 +43,10 @@ public:
 
 	void Cancel() override;
 
+	// Cache effectiveness counters for the debug stats overlay, totalled
+	// across all instances.
+	static void GetRAMCacheStats(u64 *hits, u64 *misses, u64 *evictions);
+
 private:
 	void InitCache();
 	void ShutdownCache();
@@ -48,12 +55,40 @@ private:
 	void SaveIntoCache(s64 pos, size_t bytes, Flags flags);
 	void StartReadAhead(s64 pos);
 	u32 NextAheadBlock();
+	// Returns a free cache slot, evicting the least recently used block if the
+	// budget is exhausted.  Must be called with blocksMutex_ held.
+	u32 AllocateSlot();
+
+	// Games tend to read the same file areas in the same order each boot, but
+	// not sequentially - so we record the block access order and replay it as
+	// the readahead order on the next run.
+	void RecordAccess(s64 pos);
+	void LoadAccessPattern();
+	void SaveAccessPattern();
+	std::string AccessPatternFilePath();
 
 	enum {
 		BLOCK_SIZE = 65536,
 		BLOCK_SHIFT = 16,
 		MAX_BLOCKS_PER_READ = 16,
 		BLOCK_READAHEAD = 4,
+		// Deeper readahead once we've detected a sequential stream (e.g. video.)
+		BLOCK_READAHEAD_SEQ = 16,
+		// At 4 bytes per entry, caps the pattern file at 64KB.
+		PATTERN_MAX_ENTRIES = 16384,
+		// How far ahead we look to resync the replay position on each access.
+		PATTERN_MATCH_WINDOW = 64,
+	};
+
+	enum : u8 {
+		BLOCK_EMPTY = 0,
+		BLOCK_READY = 1,
+		// Another thread is reading this block from the backend right now.
+		BLOCK_FILLING = 2,
+	};
+
+	enum : u32 {
+		INVALID_SLOT = 0xFFFFFFFF,
 	};
 
 	s64 filesize_ = 0;
@@ -63,8 +98,29 @@ private:
 
 	std::vector<u8> blocks_;
 	std::mutex blocksMutex_;
+	std::condition_variable fillDone_;
 	u32 aheadRemaining_;
 	s64 aheadPos_;
 	bool aheadThread_ = false;
 	bool aheadCancel_ = false;
+
+	// Blocks live in a fixed pool of slots.  When RamCacheSizeMB caps the pool
+	// below the file size, the least recently used block gets evicted (clock
+	// sweep over the reference bits.)  All protected by blocksMutex_.
+	std::vector<u32> blockSlot_;
+	std::vector<u32> slotBlock_;
+	std::vector<u8> slotUsed_;
+	std::vector<u32> freeSlots_;
+	u32 slotCount_ = 0;
+	u32 clockHand_ = 0;
+
+	// Sequential stream detection for deeper readahead.
+	s64 lastReadEnd_ = 0;
+	u32 seqReads_ = 0;
+	u32 aheadCount_ = BLOCK_READAHEAD;
+
+	// Protected by blocksMutex_.
+	std::vector<u32> patternPrev_;
+	size_t patternPlayPos_ = 0;
+	std::vector<u32> patternCurrent_;
 };
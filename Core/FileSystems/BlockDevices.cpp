@@ -18,9 +18,12 @@
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <vector>
 #include "i18n/i18n.h"
+#include "ppsspp_config.h"
 #include "Common/FileUtil.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPools.h"
 #include "Core/Loaders.h"
 #include "Core/Host.h"
 #include "Core/FileSystems/BlockDevices.h"
@@ -170,8 +173,11 @@ CISOFileBlockDevice::CISOFileBlockDevice(FileLoader *fileLoader)
 		readBuffer = new u8[CSO_READ_BUFFER_SIZE];
 	else
 		readBuffer = new u8[frameSize + (1 << indexShift)];
-	zlibBuffer = new u8[frameSize + (1 << indexShift)];
-	zlibBufferFrame = numFrames;
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i) {
+		frameCache[i] = new u8[frameSize + (1 << indexShift)];
+		frameCacheFrame[i] = numFrames;
+	}
+	frameCacheNext = 0;
 
 	const u32 indexSize = numFrames + 1;
 
@@ -210,7 +216,80 @@ CISOFileBlockDevice::~CISOFileBlockDevice()
 {
 	delete [] index;
 	delete [] readBuffer;
-	delete [] zlibBuffer;
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i)
+		delete [] frameCache[i];
+}
+
+// Reusable inflate context, so we don't pay for allocating the 32KB window on
+// every frame.  Mirrors the persistent deflate stream the CSO writer keeps.
+struct InflateContext {
+	InflateContext() {
+		z.zalloc = Z_NULL;
+		z.zfree = Z_NULL;
+		z.opaque = Z_NULL;
+		valid = inflateInit2(&z, -15) == Z_OK;
+	}
+	~InflateContext() {
+		if (valid)
+			inflateEnd(&z);
+	}
+	z_stream z;
+	bool valid;
+};
+
+bool CISOFileBlockDevice::InflateFrame(u32 frame, const u8 *src, u32 srcSize, u8 *dst)
+{
+	// Each frame is a separate deflate stream, so this can run on any thread.
+#if PPSSPP_PLATFORM(IOS) && defined(__IPHONE_OS_VERSION_MIN_REQUIRED) && __IPHONE_OS_VERSION_MIN_REQUIRED < __IPHONE_9_0
+	// iOS did not support C++ thread_local before iOS 9.
+	InflateContext ctx;
+#else
+	static thread_local InflateContext ctx;
+#endif
+	if (!ctx.valid || inflateReset(&ctx.z) != Z_OK) {
+		ERROR_LOG(LOADER, "Unable to initialize inflate: %s\n", (ctx.z.msg) ? ctx.z.msg : "?");
+		NotifyReadError();
+		return false;
+	}
+	z_stream &z = ctx.z;
+	z.avail_in = srcSize;
+	z.next_in = (Bytef *)src;
+	z.next_out = dst;
+	z.avail_out = frameSize;
+
+	bool success = true;
+	int status = inflate(&z, Z_FINISH);
+	if (status != Z_STREAM_END) {
+		ERROR_LOG(LOADER, "Inflate frame %d: failed - %s[%d]\n", frame, (z.msg) ? z.msg : "error", status);
+		success = false;
+	} else if (z.total_out != frameSize) {
+		ERROR_LOG(LOADER, "Inflate frame %d: block size error %d != %d\n", frame, (u32)z.total_out, frameSize);
+		success = false;
+	}
+	if (!success)
+		NotifyReadError();
+	return success;
+}
+
+u8 *CISOFileBlockDevice::FindCachedFrame(u32 frame)
+{
+	for (int i = 0; i < FRAME_CACHE_SIZE; ++i) {
+		if (frameCacheFrame[i] == frame)
+			return frameCache[i];
+	}
+	return nullptr;
+}
+
+u8 *CISOFileBlockDevice::InflateToCache(u32 frame, const u8 *src, u32 srcSize)
+{
+	const u32 slot = frameCacheNext;
+	frameCacheNext = (frameCacheNext + 1) % FRAME_CACHE_SIZE;
+	if (!InflateFrame(frame, src, srcSize, frameCache[slot])) {
+		frameCacheFrame[slot] = numFrames;
+		return nullptr;
+	}
+	frameCacheFrame[slot] = frame;
+	return frameCache[slot];
 }
 
 bool CISOFileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
@@ -226,7 +305,6 @@ bool CISOFileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 	const u32 idx = index[frameNumber];
 	const u32 indexPos = idx & 0x7FFFFFFF;
 	const u32 nextIndexPos = index[frameNumber + 1] & 0x7FFFFFFF;
-	z_stream z;
 
 	const u64 compressedReadPos = (u64)indexPos << indexShift;
 	const u64 compressedReadEnd = (u64)nextIndexPos << indexShift;
@@ -240,49 +318,28 @@ bool CISOFileBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 		if (readSize < GetBlockSize())
 			memset(outPtr + readSize, 0, GetBlockSize() - readSize);
 	}
-	else if (zlibBufferFrame == frameNumber)
-	{
-		// We already have it.  Just apply the offset and copy.
-		memcpy(outPtr, zlibBuffer + compressedOffset, GetBlockSize());
-	}
 	else
 	{
-		const u32 readSize = (u32)fileLoader_->ReadAt(compressedReadPos, 1, compressedReadSize, readBuffer, flags);
-
-		z.zalloc = Z_NULL;
-		z.zfree = Z_NULL;
-		z.opaque = Z_NULL;
-		if (inflateInit2(&z, -15) != Z_OK) {
-			ERROR_LOG(LOADER, "GetBlockSize() ERROR: %s\n", (z.msg) ? z.msg : "?");
-			NotifyReadError();
-			return false;
-		}
-		z.avail_in = readSize;
-		z.next_out = frameSize == (u32)GetBlockSize() ? outPtr : zlibBuffer;
-		z.avail_out = frameSize;
-		z.next_in = readBuffer;
-
-		int status = inflate(&z, Z_FINISH);
-		if (status != Z_STREAM_END) {
-			ERROR_LOG(LOADER, "block %d: inflate : %s[%d]\n", blockNumber, (z.msg) ? z.msg : "error", status);
-			NotifyReadError();
-			inflateEnd(&z);
-			memset(outPtr, 0, GetBlockSize());
-			return false;
-		}
-		if (z.total_out != frameSize) {
-			ERROR_LOG(LOADER, "block %d: block size error %d != %d\n", blockNumber, (u32)z.total_out, frameSize);
-			NotifyReadError();
-			inflateEnd(&z);
-			memset(outPtr, 0, GetBlockSize());
-			return false;
-		}
-		inflateEnd(&z);
-
-		if (frameSize != (u32)GetBlockSize()) {
-			zlibBufferFrame = frameNumber;
-			memcpy(outPtr, zlibBuffer + compressedOffset, GetBlockSize());
+		u8 *cached = FindCachedFrame(frameNumber);
+		if (cached == nullptr)
+		{
+			const u32 readSize = (u32)fileLoader_->ReadAt(compressedReadPos, 1, compressedReadSize, readBuffer, flags);
+			if (frameSize == (u32)GetBlockSize()) {
+				// Single-block frame, no point in caching - inflate straight to the destination.
+				if (!InflateFrame(frameNumber, readBuffer, readSize, outPtr)) {
+					memset(outPtr, 0, GetBlockSize());
+					return false;
+				}
+				return true;
+			}
+			cached = InflateToCache(frameNumber, readBuffer, readSize);
+			if (cached == nullptr) {
+				memset(outPtr, 0, GetBlockSize());
+				return false;
+			}
 		}
+		// Just apply the offset and copy.
+		memcpy(outPtr, cached + compressedOffset, GetBlockSize());
 	}
 	return true;
 }
@@ -307,14 +364,36 @@ bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
 	const u32 afterLastIndexPos = index[lastFrameNumber + 1] & 0x7FFFFFFF;
 	const u64 totalReadEnd = (u64)afterLastIndexPos << indexShift;
 
-	z_stream z;
-	z.zalloc = Z_NULL;
-	z.zfree = Z_NULL;
-	z.opaque = Z_NULL;
-	if (inflateInit2(&z, -15) != Z_OK) {
-		ERROR_LOG(LOADER, "Unable to initialize inflate: %s\n", (z.msg) ? z.msg : "?");
-		return false;
-	}
+	// Frames that decompress whole into the output are collected here and then
+	// inflated in parallel - each frame is an independent deflate stream.
+	struct FrameJob {
+		u32 frame;
+		const u8 *src;
+		u32 srcSize;
+		u8 *dst;
+		bool ok;
+	};
+	std::vector<FrameJob> jobs;
+
+	auto runJobs = [&] {
+		if (jobs.empty())
+			return;
+		auto inflateRange = [&](int low, int high) {
+			for (int i = low; i < high; ++i) {
+				FrameJob &job = jobs[i];
+				job.ok = InflateFrame(job.frame, job.src, job.srcSize, job.dst);
+			}
+		};
+		if (jobs.size() == 1)
+			inflateRange(0, 1);
+		else
+			GlobalThreadPool::Loop(inflateRange, 0, (int)jobs.size());
+		for (size_t i = 0; i < jobs.size(); ++i) {
+			if (!jobs[i].ok)
+				memset(jobs[i].dst, 0, frameSize);
+		}
+		jobs.clear();
+	};
 
 	u64 readBufferStart = 0;
 	u64 readBufferEnd = 0;
@@ -332,6 +411,9 @@ bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
 		const u32 frameBlocks = std::min(lastBlock - block + 1, blocksPerFrame - frameBlockOffset);
 
 		if (frameReadEnd > readBufferEnd) {
+			// About to overwrite readBuffer - finish any queued frames that point into it first.
+			runJobs();
+
 			const s64 maxNeeded = totalReadEnd - frameReadPos;
 			const size_t chunkSize = (size_t)std::min(maxNeeded, (s64)std::max(frameReadSize, CSO_READ_BUFFER_SIZE));
 
@@ -348,35 +430,145 @@ bool CISOFileBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr) {
 		const int plain = idx & 0x80000000;
 		if (plain) {
 			memcpy(outPtr, rawBuffer + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
+		} else if (frameBlocks == blocksPerFrame) {
+			FrameJob job = { frame, rawBuffer, frameReadSize, outPtr, false };
+			jobs.push_back(job);
 		} else {
-			z.avail_in = frameReadSize;
-			z.next_out = frameBlocks == blocksPerFrame ? outPtr : zlibBuffer;
-			z.avail_out = frameSize;
-			z.next_in = rawBuffer;
-
-			int status = inflate(&z, Z_FINISH);
-			if (status != Z_STREAM_END) {
-				ERROR_LOG(LOADER, "Inflate frame %d: failed - %s[%d]\n", frame, (z.msg) ? z.msg : "error", status);
-				NotifyReadError();
+			// A partial frame at the edge of the range - inflate via the cache, it may
+			// well be reused by a neighboring read shortly.
+			u8 *cached = FindCachedFrame(frame);
+			if (cached == nullptr)
+				cached = InflateToCache(frame, rawBuffer, frameReadSize);
+			if (cached != nullptr) {
+				memcpy(outPtr, cached + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
+			} else {
 				memset(outPtr, 0, frameBlocks * GetBlockSize());
-			} else if (z.total_out != frameSize) {
-				ERROR_LOG(LOADER, "Inflate frame %d: block size error %d != %d\n", frame, (u32)z.total_out, frameSize);
-				NotifyReadError();
-				memset(outPtr, 0, frameBlocks * GetBlockSize());
-			} else if (frameBlocks != blocksPerFrame) {
-				memcpy(outPtr, zlibBuffer + frameBlockOffset * GetBlockSize(), frameBlocks * GetBlockSize());
-				// In case we end up reusing it in a single read later.
-				zlibBufferFrame = frame;
 			}
-
-			inflateReset(&z);
 		}
 
 		block += frameBlocks;
 		outPtr += frameBlocks * GetBlockSize();
 	}
 
-	inflateEnd(&z);
+	runJobs();
+	return true;
+}
+
+bool ConvertISOToCISO(const std::string &isoPath, const std::string &csoPath, u32 frameSize, float *progress) {
+	FILE *in = File::OpenCFile(isoPath, "rb");
+	if (!in) {
+		ERROR_LOG(LOADER, "Unable to open '%s' for CSO conversion", isoPath.c_str());
+		return false;
+	}
+	const u64 isoSize = File::GetFileSize(in);
+	if (isoSize == 0) {
+		ERROR_LOG(LOADER, "Empty ISO '%s', not converting", isoPath.c_str());
+		fclose(in);
+		return false;
+	}
+
+	const u32 numFrames = (u32)((isoSize + frameSize - 1) / frameSize);
+	const u64 headerAndIndexSize = sizeof(CISO_H) + (u64)(numFrames + 1) * sizeof(u32);
+
+	// Pick an index alignment that keeps every offset within the 31 bits we have.
+	// The worst case is incompressible data plus alignment padding on every frame.
+	u8 align = 0;
+	while (((headerAndIndexSize + (u64)numFrames * (frameSize + ((u64)1 << align))) >> align) > 0x7FFFFFFF)
+		++align;
+
+	FILE *out = File::OpenCFile(csoPath, "wb");
+	if (!out) {
+		ERROR_LOG(LOADER, "Unable to open '%s' for CSO conversion", csoPath.c_str());
+		fclose(in);
+		return false;
+	}
+
+	CISO_H hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, "CISO", 4);
+	hdr.header_size = sizeof(hdr);
+	hdr.total_bytes = isoSize;
+	hdr.block_size = frameSize;
+	hdr.ver = 1;
+	hdr.align = align;
+
+	std::vector<u32_le> index(numFrames + 1);
+	std::vector<u8> rawBuffer(frameSize);
+	std::vector<u8> compBuffer(frameSize);
+
+	z_stream z;
+	z.zalloc = Z_NULL;
+	z.zfree = Z_NULL;
+	z.opaque = Z_NULL;
+	if (deflateInit2(&z, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		ERROR_LOG(LOADER, "Unable to initialize deflate: %s", (z.msg) ? z.msg : "?");
+		fclose(in);
+		fclose(out);
+		File::Delete(csoPath);
+		return false;
+	}
+
+	// Reserve space for the header and index, we'll rewrite the index at the end.
+	bool failed = fwrite(&hdr, sizeof(hdr), 1, out) != 1;
+	failed = failed || fwrite(&index[0], sizeof(u32), numFrames + 1, out) != numFrames + 1;
+	u64 outPos = headerAndIndexSize;
+
+	for (u32 frame = 0; frame < numFrames && !failed; ++frame) {
+		const size_t readSize = fread(&rawBuffer[0], 1, frameSize, in);
+		if (readSize == 0) {
+			failed = true;
+			break;
+		}
+		// The reader always inflates exactly one frame, so pad out the last one.
+		if (readSize < frameSize)
+			memset(&rawBuffer[readSize], 0, frameSize - readSize);
+
+		while ((outPos & (((u64)1 << align) - 1)) != 0 && !failed) {
+			failed = fputc(0, out) == EOF;
+			++outPos;
+		}
+
+		deflateReset(&z);
+		z.next_in = &rawBuffer[0];
+		z.avail_in = frameSize;
+		z.next_out = &compBuffer[0];
+		z.avail_out = frameSize;
+		const int status = deflate(&z, Z_FINISH);
+
+		if (status == Z_STREAM_END && z.total_out < frameSize) {
+			index[frame] = (u32)(outPos >> align);
+			failed = failed || fwrite(&compBuffer[0], 1, z.total_out, out) != z.total_out;
+			outPos += z.total_out;
+		} else {
+			// Didn't shrink (or didn't fit) - store the frame as-is.
+			index[frame] = (u32)(outPos >> align) | 0x80000000;
+			failed = failed || fwrite(&rawBuffer[0], 1, frameSize, out) != frameSize;
+			outPos += frameSize;
+		}
+
+		if (progress)
+			*progress = (float)(frame + 1) / (float)numFrames;
+	}
+
+	while ((outPos & (((u64)1 << align) - 1)) != 0 && !failed) {
+		failed = fputc(0, out) == EOF;
+		++outPos;
+	}
+	index[numFrames] = (u32)(outPos >> align);
+
+	deflateEnd(&z);
+	failed = failed || fseek(out, sizeof(hdr), SEEK_SET) != 0;
+	failed = failed || fwrite(&index[0], sizeof(u32), numFrames + 1, out) != numFrames + 1;
+
+	fclose(in);
+	fclose(out);
+	if (failed) {
+		ERROR_LOG(LOADER, "CSO conversion of '%s' failed", isoPath.c_str());
+		File::Delete(csoPath);
+		return false;
+	}
+
+	INFO_LOG(LOADER, "Converted '%s' (%lld bytes) to '%s' (%lld bytes)", isoPath.c_str(), (long long)isoSize, csoPath.c_str(), (long long)outPos);
 	return true;
 }
 
@@ -416,7 +608,12 @@ NPDRMDemoBlockDevice::NPDRMDemoBlockDevice(FileLoader *fileLoader)
 	blockSize = blockLBAs*2048;
 	numBlocks = (lbaSize+blockLBAs-1)/blockLBAs; // total blocks;
 
-	blockBuf = new u8[blockSize];
+	for (auto &entry : cache_) {
+		entry.block = -1;
+		entry.lastUsed = 0;
+		entry.buf = new u8[blockSize];
+	}
+	cacheCounter_ = 0;
 	tempBuf  = new u8[blockSize];
 
 	tableOffset = *(u32*)(np_header+0x6c); // table offset
@@ -443,8 +640,6 @@ NPDRMDemoBlockDevice::NPDRMDemoBlockDevice(FileLoader *fileLoader)
 		p += 8;
 	}
 
-	currentBlock = -1;
-
 }
 
 NPDRMDemoBlockDevice::~NPDRMDemoBlockDevice()
@@ -452,48 +647,53 @@ NPDRMDemoBlockDevice::~NPDRMDemoBlockDevice()
 	std::lock_guard<std::mutex> guard(mutex_);
 	delete [] table;
 	delete [] tempBuf;
-	delete [] blockBuf;
+	for (auto &entry : cache_)
+		delete [] entry.buf;
 }
 
 int lzrc_decompress(void *out, int out_len, void *in, int in_len);
 
-bool NPDRMDemoBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
+NPDRMDemoBlockDevice::DecodedBlock *NPDRMDemoBlockDevice::ClaimCacheEntry()
 {
-	FileLoader::Flags flags = uncached ? FileLoader::Flags::HINT_UNCACHED : FileLoader::Flags::NONE;
-	std::lock_guard<std::mutex> guard(mutex_);
-	CIPHER_KEY ckey;
-	int block, lba, lzsize;
-	size_t readSize;
-	u8 *readBuf;
-
-	lba = blockNumber-currentBlock;
-	if(lba>=0 && lba<blockLBAs){
-		memcpy(outPtr, blockBuf+lba*2048, 2048);
-		return true;
+	DecodedBlock *entry = &cache_[0];
+	for (auto &c : cache_) {
+		if (c.lastUsed < entry->lastUsed)
+			entry = &c;
 	}
+	entry->block = -1;
+	entry->lastUsed = ++cacheCounter_;
+	return entry;
+}
 
-	block = blockNumber/blockLBAs;
-	lba = blockNumber%blockLBAs;
-	currentBlock = block*blockLBAs;
+const u8 *NPDRMDemoBlockDevice::DecodeBlock(int block, bool uncached, int &result)
+{
+	for (auto &c : cache_) {
+		if (c.block == block) {
+			c.lastUsed = ++cacheCounter_;
+			result = 1;
+			return c.buf;
+		}
+	}
 
 	if(table[block].unk_1c!=0){
-		if((u32)block==(numBlocks-1))
-			return true; // demos make by fake_np
-		else
-			return false;
+		// demos make by fake_np
+		result = ((u32)block == numBlocks - 1) ? 2 : 0;
+		return nullptr;
 	}
 
+	DecodedBlock *entry = ClaimCacheEntry();
+
+	u8 *readBuf;
 	if(table[block].size<blockSize)
 		readBuf = tempBuf;
 	else
-		readBuf = blockBuf;
+		readBuf = entry->buf;
 
-	readSize = fileLoader_->ReadAt(psarOffset+table[block].offset, 1, table[block].size, readBuf, flags);
+	FileLoader::Flags flags = uncached ? FileLoader::Flags::HINT_UNCACHED : FileLoader::Flags::NONE;
+	size_t readSize = fileLoader_->ReadAt(psarOffset+table[block].offset, 1, table[block].size, readBuf, flags);
 	if(readSize != (size_t)table[block].size){
-		if((u32)block==(numBlocks-1))
-			return true;
-		else
-			return false;
+		result = ((u32)block == numBlocks - 1) ? 2 : 0;
+		return nullptr;
 	}
 
 	if((table[block].flag&1)==0){
@@ -501,21 +701,167 @@ bool NPDRMDemoBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
 	}
 
 	if((table[block].flag&4)==0){
+		CIPHER_KEY ckey;
 		sceDrmBBCipherInit(&ckey, 1, 2, hkey, vkey, table[block].offset>>4);
 		sceDrmBBCipherUpdate(&ckey, readBuf, table[block].size);
 		sceDrmBBCipherFinal(&ckey);
 	}
 
 	if(table[block].size<blockSize){
-		lzsize = lzrc_decompress(blockBuf, 0x00100000, readBuf, table[block].size);
+		int lzsize = lzrc_decompress(entry->buf, 0x00100000, readBuf, table[block].size);
 		if(lzsize!=blockSize){
 			ERROR_LOG(LOADER, "LZRC decompress error! lzsize=%d\n", lzsize);
 			NotifyReadError();
-			return false;
+			result = 0;
+			return nullptr;
 		}
 	}
 
-	memcpy(outPtr, blockBuf+lba*2048, 2048);
+	entry->block = block;
+	result = 1;
+	return entry->buf;
+}
 
+bool NPDRMDemoBlockDevice::ReadBlock(int blockNumber, u8 *outPtr, bool uncached)
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+
+	int block = blockNumber/blockLBAs;
+	int lba = blockNumber%blockLBAs;
+
+	int result;
+	const u8 *buf = DecodeBlock(block, uncached, result);
+	if (!buf)
+		return result == 2;
+
+	memcpy(outPtr, buf+lba*2048, 2048);
 	return true;
 }
+
+bool NPDRMDemoBlockDevice::ReadBlocks(u32 minBlock, int count, u8 *outPtr)
+{
+	if (count == 1)
+		return ReadBlock(minBlock, outPtr);
+
+	std::lock_guard<std::mutex> guard(mutex_);
+
+	const u32 lastLBA = minBlock + count - 1;
+	int block = (int)(minBlock / blockLBAs);
+	const int lastBlock = (int)(lastLBA / blockLBAs);
+	bool ok = true;
+
+	// Copies all the LBAs the request covers out of one decoded block.
+	auto copyOut = [&](int b, const u8 *buf) {
+		u32 firstCopyLBA = std::max(minBlock, (u32)(b * blockLBAs));
+		u32 lastCopyLBA = std::min(lastLBA, (u32)((b + 1) * blockLBAs - 1));
+		memcpy(outPtr + (firstCopyLBA - minBlock) * 2048, buf + (firstCopyLBA % blockLBAs) * 2048, (lastCopyLBA - firstCopyLBA + 1) * 2048);
+	};
+
+	// Work in batches of at most DECODED_CACHE_BLOCKS compressed blocks: read
+	// and decrypt each missing block on this thread (the kirk-based cipher
+	// isn't known to be thread-safe), then run the LZRC decodes in parallel -
+	// each block is an independent stream - and copy the results out.
+	while (block <= lastBlock && ok) {
+		struct BlockJob {
+			int block;
+			std::vector<u8> src;
+			u8 *dst;
+			bool ok;
+		};
+		std::vector<BlockJob> jobs;
+		struct BatchEntry {
+			int block;
+			const u8 *buf;  // Null for quirky "succeed without writing" blocks.
+		};
+		std::vector<BatchEntry> batch;
+
+		for (; block <= lastBlock && (int)batch.size() < DECODED_CACHE_BLOCKS; ++block) {
+			// Cache hits and uncompressed/quirky blocks take the serial path.
+			if (table[block].size >= blockSize || table[block].unk_1c != 0) {
+				int result;
+				const u8 *buf = DecodeBlock(block, false, result);
+				if (!buf && result != 2) {
+					ok = false;
+					break;
+				}
+				batch.push_back(BatchEntry{ block, buf });
+				continue;
+			}
+			bool cached = false;
+			for (auto &c : cache_) {
+				if (c.block == block) {
+					c.lastUsed = ++cacheCounter_;
+					batch.push_back(BatchEntry{ block, c.buf });
+					cached = true;
+					break;
+				}
+			}
+			if (cached)
+				continue;
+
+			BlockJob job;
+			job.block = block;
+			job.src.resize(table[block].size);
+			size_t readSize = fileLoader_->ReadAt(psarOffset+table[block].offset, 1, table[block].size, &job.src[0]);
+			if (readSize != (size_t)table[block].size) {
+				if ((u32)block == numBlocks - 1) {
+					batch.push_back(BatchEntry{ block, nullptr });
+					continue;
+				}
+				ok = false;
+				break;
+			}
+			if((table[block].flag&4)==0){
+				CIPHER_KEY ckey;
+				sceDrmBBCipherInit(&ckey, 1, 2, hkey, vkey, table[block].offset>>4);
+				sceDrmBBCipherUpdate(&ckey, &job.src[0], table[block].size);
+				sceDrmBBCipherFinal(&ckey);
+			}
+			DecodedBlock *entry = ClaimCacheEntry();
+			job.dst = entry->buf;
+			job.ok = false;
+			jobs.push_back(std::move(job));
+			batch.push_back(BatchEntry{ block, entry->buf });
+		}
+
+		if (!jobs.empty()) {
+			auto decodeRange = [&](int low, int high) {
+				for (int i = low; i < high; ++i) {
+					BlockJob &job = jobs[i];
+					job.ok = lzrc_decompress(job.dst, 0x00100000, &job.src[0], table[job.block].size) == blockSize;
+				}
+			};
+			if (jobs.size() == 1)
+				decodeRange(0, 1);
+			else
+				GlobalThreadPool::Loop(decodeRange, 0, (int)jobs.size());
+			for (auto &job : jobs) {
+				if (!job.ok) {
+					ERROR_LOG(LOADER, "LZRC decompress error on block %d\n", job.block);
+					NotifyReadError();
+					ok = false;
+				}
+			}
+			if (ok) {
+				// Only mark the entries valid once the decode succeeded.
+				for (auto &job : jobs) {
+					for (auto &c : cache_) {
+						if (c.buf == job.dst) {
+							c.block = job.block;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		if (ok) {
+			for (auto &entry : batch) {
+				if (entry.buf)
+					copyOut(entry.block, entry.buf);
+			}
+		}
+	}
+
+	return ok;
+}
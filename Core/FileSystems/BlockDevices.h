@@ -24,6 +24,7 @@
 // with CISO images.
 
 #include <mutex>
+#include <string>
 
 #include "Common/CommonTypes.h"
 #include "Core/ELF/PBPReader.h"
@@ -62,11 +63,22 @@ public:
 	u32 GetNumBlocks() override { return numBlocks; }
 
 private:
+	bool InflateFrame(u32 frame, const u8 *src, u32 srcSize, u8 *dst);
+	u8 *FindCachedFrame(u32 frame);
+	u8 *InflateToCache(u32 frame, const u8 *src, u32 srcSize);
+
+	enum {
+		// Recently inflated frames, so single-block reads within the same frame
+		// don't inflate it over and over.
+		FRAME_CACHE_SIZE = 4,
+	};
+
 	FileLoader *fileLoader_;
 	u32 *index;
 	u8 *readBuffer;
-	u8 *zlibBuffer;
-	u32 zlibBufferFrame;
+	u8 *frameCache[FRAME_CACHE_SIZE];
+	u32 frameCacheFrame[FRAME_CACHE_SIZE];
+	u32 frameCacheNext;
 	u8 indexShift;
 	u8 blockShift;
 	u32 frameSize;
@@ -105,9 +117,28 @@ public:
 	~NPDRMDemoBlockDevice();
 
 	bool ReadBlock(int blockNumber, u8 *outPtr, bool uncached = false) override;
+	bool ReadBlocks(u32 minBlock, int count, u8 *outPtr) override;
 	u32 GetNumBlocks() override {return (u32)lbaSize;}
 
 private:
+	// Small decoded-block cache so streaming reads don't re-decode the same
+	// compressed block for every 2048-byte LBA. Entries are keyed by
+	// compressed block index and evicted LRU. The size also bounds how many
+	// blocks ReadBlocks() will decompress in parallel per batch.
+	enum { DECODED_CACHE_BLOCKS = 8 };
+	struct DecodedBlock {
+		int block;
+		u32 lastUsed;
+		u8 *buf;
+	};
+
+	// Returns the decoded data for a compressed block, decoding into the LRU
+	// cache entry on a miss. result is 1 on success, 0 on failure, or 2 for
+	// the fake_np tail quirk (report success but leave the output untouched.)
+	// Call with mutex_ held.
+	const u8 *DecodeBlock(int block, bool uncached, int &result);
+	DecodedBlock *ClaimCacheEntry();
+
 	FileLoader *fileLoader_;
 	static std::mutex mutex_;
 	u32 lbaSize;
@@ -121,10 +152,21 @@ private:
 	u8 hkey[16];
 	struct table_info *table;
 
-	int currentBlock;
-	u8 *blockBuf;
+	DecodedBlock cache_[DECODED_CACHE_BLOCKS];
+	u32 cacheCounter_;
 	u8 *tempBuf;
 };
 
 
 BlockDevice *constructBlockDevice(FileLoader *fileLoader);
+
+// The default frame size for CSOs we write ourselves. Much larger than the usual
+// 2KB - better ratio, and far fewer deflate streams to set up when reading.
+enum : u32 {
+	CSO_DEFAULT_WRITE_FRAME_SIZE = 0x20000,
+};
+
+// Compresses a plain ISO into a CSO. Frames that don't shrink are stored as-is.
+// Reports progress in [0, 1] if progress is non-null. On failure, removes the
+// partial output and returns false.
+bool ConvertISOToCISO(const std::string &isoPath, const std::string &csoPath, u32 frameSize = CSO_DEFAULT_WRITE_FRAME_SIZE, float *progress = nullptr);
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <limits>
+#include "file/file_util.h"
 #include "file/free.h"
 #include "file/zip_read.h"
 #include "i18n/i18n.h"
@@ -482,6 +483,7 @@ std::string DirectoryFileSystem::GetLocalPath(std::string localpath) {
 }
 
 bool DirectoryFileSystem::MkDir(const std::string &dirname) {
+	InvalidateDirInfoCache();
 	bool result;
 #if HOST_IS_CASE_SENSITIVE
 	// Must fix case BEFORE attempting, because MkDir would create
@@ -499,6 +501,7 @@ bool DirectoryFileSystem::MkDir(const std::string &dirname) {
 }
 
 bool DirectoryFileSystem::RmDir(const std::string &dirname) {
+	InvalidateDirInfoCache();
 	std::string fullName = GetLocalPath(dirname);
 
 #if HOST_IS_CASE_SENSITIVE
@@ -524,6 +527,7 @@ bool DirectoryFileSystem::RmDir(const std::string &dirname) {
 }
 
 int DirectoryFileSystem::RenameFile(const std::string &from, const std::string &to) {
+	InvalidateDirInfoCache();
 	std::string fullTo = to;
 
 	// Rename ignores the path (even if specified) on to.
@@ -580,6 +584,7 @@ int DirectoryFileSystem::RenameFile(const std::string &from, const std::string &
 }
 
 bool DirectoryFileSystem::RemoveFile(const std::string &filename) {
+	InvalidateDirInfoCache();
 	std::string fullName = GetLocalPath(filename);
 #ifdef _WIN32
 	bool retValue = (::DeleteFileA(fullName.c_str()) == TRUE);
@@ -608,6 +613,10 @@ bool DirectoryFileSystem::RemoveFile(const std::string &filename) {
 }
 
 u32 DirectoryFileSystem::OpenFile(std::string filename, FileAccess access, const char *devicename) {
+	if (access & (FILEACCESS_WRITE | FILEACCESS_APPEND | FILEACCESS_CREATE | FILEACCESS_TRUNCATE)) {
+		// The open itself may create or truncate, and writes will likely follow.
+		InvalidateDirInfoCache();
+	}
 	OpenFileEntry entry;
 	u32 err = 0;
 	bool success = entry.hFile.Open(basePath, filename, access, err);
@@ -697,6 +706,8 @@ size_t DirectoryFileSystem::WriteFile(u32 handle, const u8 *pointer, s64 size, i
 	EntryMap::iterator iter = entries.find(handle);
 	if (iter != entries.end())
 	{
+		// The directory mtime won't change for a rewritten file, so invalidate.
+		InvalidateDirInfoCache();
 		size_t bytesWritten = iter->second.hFile.Write(pointer,size);
 		return bytesWritten;
 	} else {
@@ -717,11 +728,113 @@ size_t DirectoryFileSystem::SeekFile(u32 handle, s32 position, FileMove type) {
 	}
 }
 
+bool DirectoryFileSystem::BuildDirInfoCache(const std::string &localDir) {
+	File::FileDetails dirDetails;
+	if (!File::GetFileDetails(localDir, &dirDetails) || !dirDetails.isDirectory) {
+		return false;
+	}
+
+	DirInfoCache cache;
+	cache.dirMtime = dirDetails.mtime;
+
+	std::vector<FileInfo> files;
+	getFilesInDir(localDir.c_str(), &files);
+	for (const auto &file : files) {
+		PSPFileInfo info;
+		info.name = file.name;
+		info.exists = true;
+		info.type = file.isDirectory ? FILETYPE_DIRECTORY : FILETYPE_NORMAL;
+		if (!file.isDirectory) {
+			File::FileDetails details;
+			if (File::GetFileDetails(file.fullName, &details)) {
+				info.size = details.size;
+				info.access = details.access;
+				time_t atime = details.atime;
+				time_t ctime = details.ctime;
+				time_t mtime = details.mtime;
+				localtime_r(&atime, &info.atime);
+				localtime_r(&ctime, &info.ctime);
+				localtime_r(&mtime, &info.mtime);
+			}
+		}
+		cache.files[file.name] = info;
+	}
+
+	// Keep this from growing without bound if a game wanders around.
+	if (dirInfoCache_.size() >= 16) {
+		dirInfoCache_.clear();
+	}
+	dirInfoCache_[localDir] = std::move(cache);
+	return true;
+}
+
+bool DirectoryFileSystem::GetCachedFileInfo(const std::string &fullName, PSPFileInfo *info) {
+	size_t slash = fullName.find_last_of("/\\");
+	if (slash == std::string::npos || slash == 0) {
+		return false;
+	}
+	const std::string localDir = fullName.substr(0, slash);
+	const std::string name = fullName.substr(slash + 1);
+	if (name.empty() || name == "." || name == "..") {
+		return false;
+	}
+
+	auto it = dirInfoCache_.find(localDir);
+	if (it != dirInfoCache_.end()) {
+		// If the directory changed behind our back, rebuild.
+		File::FileDetails dirDetails;
+		if (!File::GetFileDetails(localDir, &dirDetails) || dirDetails.mtime != it->second.dirMtime) {
+			dirInfoCache_.erase(it);
+			it = dirInfoCache_.end();
+		}
+	}
+	if (it == dirInfoCache_.end()) {
+		// Only bother snapshotting once a storm of stats in one directory is
+		// evident - a lone stat is cheaper served directly.
+		if (localDir == statStreakDir_) {
+			++statStreakCount_;
+		} else {
+			statStreakDir_ = localDir;
+			statStreakCount_ = 1;
+		}
+		if (statStreakCount_ < 4 || !BuildDirInfoCache(localDir)) {
+			return false;
+		}
+		it = dirInfoCache_.find(localDir);
+	}
+
+	auto f = it->second.files.find(name);
+#if HOST_IS_CASE_SENSITIVE
+	if (f == it->second.files.end()) {
+		// The snapshot makes case fixing cheap - no directory walk needed.
+		for (auto i = it->second.files.begin(); i != it->second.files.end(); ++i) {
+			if (strcasecmp(i->first.c_str(), name.c_str()) == 0) {
+				f = i;
+				break;
+			}
+		}
+	}
+#endif
+	if (f != it->second.files.end()) {
+		const std::string requestedName = info->name;
+		*info = f->second;
+		// Like the uncached path, report back the name the game asked about.
+		info->name = requestedName;
+	}
+	// The snapshot is authoritative either way - not found means not exists.
+	return true;
+}
+
 PSPFileInfo DirectoryFileSystem::GetFileInfo(std::string filename) {
 	PSPFileInfo x;
 	x.name = filename;
 
 	std::string fullName = GetLocalPath(filename);
+
+	if (GetCachedFileInfo(fullName, &x)) {
+		return ReplayApplyDiskFileInfo(x, CoreTiming::GetGlobalTimeUs());
+	}
+
 	if (!File::Exists(fullName)) {
 #if HOST_IS_CASE_SENSITIVE
 		if (! FixPathCase(basePath,filename, FPC_FILE_MUST_EXIST))
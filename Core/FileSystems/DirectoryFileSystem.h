@@ -124,6 +124,25 @@ private:
 	std::string basePath;
 	IHandleAllocator *hAlloc;
 	int flags;
+
+	// Snapshot of a host directory's stat data, so that stat storms (e.g. the
+	// savedata dialog statting hundreds of files) read each directory once
+	// instead of hitting the host filesystem per file.  Invalidated when the
+	// directory mtime changes or when we write through this filesystem.
+	struct DirInfoCache {
+		u64 dirMtime;
+		std::map<std::string, PSPFileInfo> files;
+	};
+	std::map<std::string, DirInfoCache> dirInfoCache_;
+	std::string statStreakDir_;
+	int statStreakCount_ = 0;
+
+	bool GetCachedFileInfo(const std::string &fullName, PSPFileInfo *info);
+	bool BuildDirInfoCache(const std::string &localDir);
+	void InvalidateDirInfoCache() {
+		dirInfoCache_.clear();
+	}
+
 	// In case of Windows: Translate slashes, etc.
 	std::string GetLocalPath(std::string localpath);
 };
@@ -164,7 +164,8 @@ struct VolDescriptor {
 
 #pragma pack(pop)
 
-ISOFileSystem::ISOFileSystem(IHandleAllocator *_hAlloc, BlockDevice *_blockDevice) {
+ISOFileSystem::ISOFileSystem(IHandleAllocator *_hAlloc, BlockDevice *_blockDevice)
+	: pathCache_(1024) {
 	blockDevice = _blockDevice;
 	hAlloc = _hAlloc;
 
@@ -287,6 +288,21 @@ ISOFileSystem::TreeEntry *ISOFileSystem::GetFromPath(const std::string &path, bo
 	if (pathLength <= pathIndex)
 		return treeroot;
 
+	// 64-bit hash over the normalized path.  A collision is about theoretical,
+	// but we double check the final component below just in case.
+	const u64 pathHash = XXH64(path.c_str() + pathIndex, pathLength - pathIndex, hashmapSeed);
+	TreeEntry *cached = pathCache_.Get(pathHash);
+	if (cached) {
+		const size_t lastSlash = path.find_last_of('/');
+		const size_t lastComponent = lastSlash == std::string::npos ? pathIndex : std::max(pathIndex, lastSlash + 1);
+		if (path.compare(lastComponent, std::string::npos, cached->name) == 0) {
+			return cached;
+		}
+		// A path the check doesn't like (e.g. a trailing slash) - resolve it the
+		// slow way, and don't try to re-insert it below.
+	}
+	const bool canCache = cached == nullptr;
+
 	TreeEntry *entry = treeroot;
 	while (true) {
 		if (!entry->valid) {
@@ -319,8 +335,12 @@ ISOFileSystem::TreeEntry *ISOFileSystem::GetFromPath(const std::string &path, bo
 			if (pathIndex < pathLength && path[pathIndex] == '/')
 				++pathIndex;
 
-			if (pathLength <= pathIndex)
+			if (pathLength <= pathIndex) {
+				if (canCache) {
+					pathCache_.Insert(pathHash, entry);
+				}
 				return entry;
+			}
 		} else {
 			if (catchError)
 				ERROR_LOG(FILESYS,"File %s not found", path.c_str());
@@ -20,6 +20,8 @@
 #include <map>
 #include <list>
 
+#include "Common/Hashmaps.h"
+
 #include "FileSystem.h"
 
 #include "BlockDevices.h"
@@ -92,6 +94,11 @@ private:
 
 	TreeEntry entireISO;
 
+	// Resolved paths by hash, since GetFromPath walks the tree on every open
+	// and games open in storms during level loads.  The tree only ever grows,
+	// so cached entries stay valid for our lifetime.
+	DenseHashMap<u64, TreeEntry *, nullptr> pathCache_;
+
 	void ReadDirectory(TreeEntry *root);
 	TreeEntry *GetFromPath(const std::string &path, bool catchError = true);
 	std::string EntryFullPath(TreeEntry *e);
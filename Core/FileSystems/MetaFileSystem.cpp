@@ -225,6 +225,14 @@ bool MetaFileSystem::MapFilePath(const std::string &_inpath, std::string &outpat
 		currentDirectory = &(it->second);
 	}
 
+	const auto cacheKey = std::make_pair(*currentDirectory, inpath);
+	const auto cached = pathCache_.find(cacheKey);
+	if (cached != pathCache_.end()) {
+		outpath = cached->second.outpath;
+		*system = &fileSystems[cached->second.mountIndex];
+		return true;
+	}
+
 	if ( RealPath(*currentDirectory, inpath, realpath) )
 	{
 		std::string prefix = realpath;
@@ -240,6 +248,13 @@ bool MetaFileSystem::MapFilePath(const std::string &_inpath, std::string &outpat
 				outpath = realpath.substr(prefixPos + 1);
 				*system = &(fileSystems[i]);
 
+				if (pathCache_.size() >= 512) {
+					// Games shouldn't generate this many distinct paths, but
+					// let's not grow forever if one does.
+					pathCache_.clear();
+				}
+				pathCache_[cacheKey] = ResolvedPath{ i, outpath };
+
 				VERBOSE_LOG(FILESYS, "MapFilePath: mapped \"%s\" to prefix: \"%s\", path: \"%s\"", inpath.c_str(), fileSystems[i].prefix.c_str(), outpath.c_str());
 
 				return true;
@@ -276,6 +291,7 @@ void MetaFileSystem::Mount(std::string prefix, IFileSystem *system)
 	x.prefix = prefix;
 	x.system = system;
 	fileSystems.push_back(x);
+	pathCache_.clear();
 }
 
 void MetaFileSystem::Unmount(std::string prefix, IFileSystem *system)
@@ -285,6 +301,7 @@ void MetaFileSystem::Unmount(std::string prefix, IFileSystem *system)
 	x.prefix = prefix;
 	x.system = system;
 	fileSystems.erase(std::remove(fileSystems.begin(), fileSystems.end(), x), fileSystems.end());
+	pathCache_.clear();
 }
 
 void MetaFileSystem::Remount(IFileSystem *oldSystem, IFileSystem *newSystem) {
@@ -293,6 +310,7 @@ void MetaFileSystem::Remount(IFileSystem *oldSystem, IFileSystem *newSystem) {
 			it->system = newSystem;
 		}
 	}
+	pathCache_.clear();
 }
 
 IFileSystem *MetaFileSystem::GetSystemFromFilename(const std::string &filename) {
@@ -310,6 +328,13 @@ IFileSystem *MetaFileSystem::GetSystem(const std::string &prefix) {
 	return NULL;
 }
 
+std::shared_ptr<std::recursive_mutex> MetaFileSystem::GetSystemLock(IFileSystem *system) {
+	auto &entry = systemLocks_[system];
+	if (!entry)
+		entry = std::make_shared<std::recursive_mutex>();
+	return entry;
+}
+
 void MetaFileSystem::Shutdown()
 {
 	std::lock_guard<std::recursive_mutex> guard(lock);
@@ -328,6 +353,8 @@ void MetaFileSystem::Shutdown()
 	}
 
 	fileSystems.clear();
+	systemLocks_.clear();
+	pathCache_.clear();
 	currentDir.clear();
 	startingDirectory = "";
 }
@@ -348,6 +375,8 @@ u32 MetaFileSystem::OpenFile(std::string filename, FileAccess access, const char
 	MountPoint *mount;
 	if (MapFilePath(filename, of, &mount))
 	{
+		// Take the per-system lock too, in case an async read is in flight on this system.
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(mount->system));
 		s32 res = mount->system->OpenFile(of, access, mount->prefix.c_str());
 		if (res < 0)
 		{
@@ -369,6 +398,7 @@ PSPFileInfo MetaFileSystem::GetFileInfo(std::string filename)
 	IFileSystem *system;
 	if (MapFilePath(filename, of, &system))
 	{
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->GetFileInfo(of);
 	}
 	else
@@ -384,6 +414,7 @@ bool MetaFileSystem::GetHostPath(const std::string &inpath, std::string &outpath
 	std::string of;
 	IFileSystem *system;
 	if (MapFilePath(inpath, of, &system)) {
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->GetHostPath(of, outpath);
 	} else {
 		return false;
@@ -397,6 +428,7 @@ std::vector<PSPFileInfo> MetaFileSystem::GetDirListing(std::string path)
 	IFileSystem *system;
 	if (MapFilePath(path, of, &system))
 	{
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->GetDirListing(of);
 	}
 	else
@@ -454,6 +486,7 @@ bool MetaFileSystem::MkDir(const std::string &dirname)
 	IFileSystem *system;
 	if (MapFilePath(dirname, of, &system))
 	{
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->MkDir(of);
 	}
 	else
@@ -469,6 +502,7 @@ bool MetaFileSystem::RmDir(const std::string &dirname)
 	IFileSystem *system;
 	if (MapFilePath(dirname, of, &system))
 	{
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->RmDir(of);
 	}
 	else
@@ -501,6 +535,7 @@ int MetaFileSystem::RenameFile(const std::string &from, const std::string &to)
 		if (osystem != rsystem)
 			return SCE_KERNEL_ERROR_XDEV;
 
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(osystem));
 		return osystem->RenameFile(of, rf);
 	}
 	else
@@ -516,6 +551,7 @@ bool MetaFileSystem::RemoveFile(const std::string &filename)
 	IFileSystem *system;
 	if (MapFilePath(filename, of, &system))
 	{
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->RemoveFile(of);
 	}
 	else
@@ -528,8 +564,10 @@ int MetaFileSystem::Ioctl(u32 handle, u32 cmd, u32 indataPtr, u32 inlen, u32 out
 {
 	std::lock_guard<std::recursive_mutex> guard(lock);
 	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
+	if (sys) {
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(sys));
 		return sys->Ioctl(handle, cmd, indataPtr, inlen, outdataPtr, outlen, usec);
+	}
 	return SCE_KERNEL_ERROR_ERROR;
 }
 
@@ -546,56 +584,82 @@ void MetaFileSystem::CloseFile(u32 handle)
 {
 	std::lock_guard<std::recursive_mutex> guard(lock);
 	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
+	if (sys) {
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(sys));
 		sys->CloseFile(handle);
+	}
 }
 
 size_t MetaFileSystem::ReadFile(u32 handle, u8 *pointer, s64 size)
 {
-	std::lock_guard<std::recursive_mutex> guard(lock);
-	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
-		return sys->ReadFile(handle, pointer, size);
-	else
-		return 0;
+	IFileSystem *sys;
+	std::shared_ptr<std::recursive_mutex> systemLock;
+	{
+		std::lock_guard<std::recursive_mutex> guard(lock);
+		sys = GetHandleOwner(handle);
+		if (!sys)
+			return 0;
+		systemLock = GetSystemLock(sys);
+	}
+	// Only hold the per-system lock over the blocking read, so that I/O against
+	// other filesystems can proceed in the meantime.
+	std::lock_guard<std::recursive_mutex> sysGuard(*systemLock);
+	return sys->ReadFile(handle, pointer, size);
 }
 
 size_t MetaFileSystem::WriteFile(u32 handle, const u8 *pointer, s64 size)
 {
-	std::lock_guard<std::recursive_mutex> guard(lock);
-	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
-		return sys->WriteFile(handle, pointer, size);
-	else
-		return 0;
+	IFileSystem *sys;
+	std::shared_ptr<std::recursive_mutex> systemLock;
+	{
+		std::lock_guard<std::recursive_mutex> guard(lock);
+		sys = GetHandleOwner(handle);
+		if (!sys)
+			return 0;
+		systemLock = GetSystemLock(sys);
+	}
+	std::lock_guard<std::recursive_mutex> sysGuard(*systemLock);
+	return sys->WriteFile(handle, pointer, size);
 }
 
 size_t MetaFileSystem::ReadFile(u32 handle, u8 *pointer, s64 size, int &usec)
 {
-	std::lock_guard<std::recursive_mutex> guard(lock);
-	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
-		return sys->ReadFile(handle, pointer, size, usec);
-	else
-		return 0;
+	IFileSystem *sys;
+	std::shared_ptr<std::recursive_mutex> systemLock;
+	{
+		std::lock_guard<std::recursive_mutex> guard(lock);
+		sys = GetHandleOwner(handle);
+		if (!sys)
+			return 0;
+		systemLock = GetSystemLock(sys);
+	}
+	std::lock_guard<std::recursive_mutex> sysGuard(*systemLock);
+	return sys->ReadFile(handle, pointer, size, usec);
 }
 
 size_t MetaFileSystem::WriteFile(u32 handle, const u8 *pointer, s64 size, int &usec)
 {
-	std::lock_guard<std::recursive_mutex> guard(lock);
-	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
-		return sys->WriteFile(handle, pointer, size, usec);
-	else
-		return 0;
+	IFileSystem *sys;
+	std::shared_ptr<std::recursive_mutex> systemLock;
+	{
+		std::lock_guard<std::recursive_mutex> guard(lock);
+		sys = GetHandleOwner(handle);
+		if (!sys)
+			return 0;
+		systemLock = GetSystemLock(sys);
+	}
+	std::lock_guard<std::recursive_mutex> sysGuard(*systemLock);
+	return sys->WriteFile(handle, pointer, size, usec);
 }
 
 size_t MetaFileSystem::SeekFile(u32 handle, s32 position, FileMove type)
 {
 	std::lock_guard<std::recursive_mutex> guard(lock);
 	IFileSystem *sys = GetHandleOwner(handle);
-	if (sys)
+	if (sys) {
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(sys));
 		return sys->SeekFile(handle,position,type);
+	}
 	else
 		return 0;
 }
@@ -622,8 +686,10 @@ u64 MetaFileSystem::FreeSpace(const std::string &path)
 	std::lock_guard<std::recursive_mutex> guard(lock);
 	std::string of;
 	IFileSystem *system;
-	if (MapFilePath(path, of, &system))
+	if (MapFilePath(path, of, &system)) {
+		std::lock_guard<std::recursive_mutex> sysGuard(*GetSystemLock(system));
 		return system->FreeSpace(of);
+	}
 	else
 		return 0;
 }
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <mutex>
@@ -44,6 +46,26 @@ private:
 	int lastOpenError;
 	std::recursive_mutex lock;  // must be recursive
 
+	// Serializes calls into each backing filesystem. Reads and writes only take
+	// the per-system lock, so I/O against different devices (e.g. UMD and the
+	// memstick) can overlap. Always taken while holding the main lock, or after
+	// releasing it - never the other way around.
+	std::map<IFileSystem *, std::shared_ptr<std::recursive_mutex>> systemLocks_;
+
+	// Must be called with the main lock held.
+	std::shared_ptr<std::recursive_mutex> GetSystemLock(IFileSystem *system);
+
+	// MapFilePath re-parses the path on every single sceIo call, and games
+	// stat the same files in loops - so cache resolutions. The key includes
+	// the thread's current directory, so ChDir needs no invalidation; mount
+	// changes clear the cache since they remap prefixes and shift indexes.
+	// Protected by lock.
+	struct ResolvedPath {
+		size_t mountIndex;
+		std::string outpath;
+	};
+	std::map<std::pair<std::string, std::string>, ResolvedPath> pathCache_;
+
 public:
 	MetaFileSystem() {
 		current = 6;  // what?
@@ -174,6 +174,10 @@ void PGF::DoState(PointerWrap &p) {
 		p.Do(shadowGlyphs);
 	}
 	p.Do(firstGlyph);
+
+	if (p.mode == p.MODE_READ) {
+		decodedGlyphCache_.clear();
+	}
 }
 
 bool PGF::ReadPtr(const u8 *ptr, size_t dataSize) {
@@ -272,6 +276,7 @@ bool PGF::ReadPtr(const u8 *ptr, size_t dataSize) {
 	fontDataSize = dataSize - fontDataOffset;
 	fontData = new u8[fontDataSize];
 	memcpy(fontData, uptr, fontDataSize);
+	decodedGlyphCache_.clear();
 
 	// charmap.resize();
 	charmap.resize(header.charMapLength);
@@ -596,32 +601,43 @@ void PGF::DrawCharacter(const GlyphImage *image, int clipX, int clipY, int clipW
 	if (clipHeight < 0)
 		clipHeight = 8192;
 
-	// Use a buffer so we can apply subpixel rendering.
-	// TODO: Cache this buffer per glyph?  Maybe even transpose it first?
-	std::vector<u8> decodedPixels;
-	decodedPixels.resize(numberPixels);
+	// Use a buffer so we can apply subpixel rendering, and cache the decode
+	// since games redraw the same glyphs over and over.
+	auto cached = decodedGlyphCache_.find(glyph.ptr);
+	if (cached == decodedGlyphCache_.end()) {
+		// Keep a lid on memory in case a game cycles through a huge charmap.
+		if (decodedGlyphCache_.size() >= 768) {
+			decodedGlyphCache_.clear();
+		}
 
-	while (pixelIndex < numberPixels && bitPtr + 8 < fontDataSize * 8) {
-		// This is some kind of nibble based RLE compression.
-		int nibble = consumeBits(4, fontData, bitPtr);
+		std::vector<u8> pixels;
+		pixels.resize(numberPixels);
 
-		int count;
-		int value = 0;
-		if (nibble < 8) {
-			value = consumeBits(4, fontData, bitPtr);
-			count = nibble + 1;
-		} else {
-			count = 16 - nibble;
-		}
+		while (pixelIndex < numberPixels && bitPtr + 8 < fontDataSize * 8) {
+			// This is some kind of nibble based RLE compression.
+			int nibble = consumeBits(4, fontData, bitPtr);
 
-		for (int i = 0; i < count && pixelIndex < numberPixels; i++) {
-			if (nibble >= 8) {
+			int count;
+			int value = 0;
+			if (nibble < 8) {
 				value = consumeBits(4, fontData, bitPtr);
+				count = nibble + 1;
+			} else {
+				count = 16 - nibble;
 			}
 
-			decodedPixels[pixelIndex++] = value | (value << 4);
+			for (int i = 0; i < count && pixelIndex < numberPixels; i++) {
+				if (nibble >= 8) {
+					value = consumeBits(4, fontData, bitPtr);
+				}
+
+				pixels[pixelIndex++] = value | (value << 4);
+			}
 		}
+
+		cached = decodedGlyphCache_.emplace(glyph.ptr, std::move(pixels)).first;
 	}
+	const std::vector<u8> &decodedPixels = cached->second;
 
 	auto samplePixel = [&](int xx, int yy) -> u8 {
 		if (xx < 0 || yy < 0 || xx >= glyph.w || yy >= glyph.h) {
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -306,4 +307,11 @@ private:
 	std::vector<Glyph> glyphs;
 	std::vector<Glyph> shadowGlyphs;
 	int firstGlyph;
+
+	// Glyph bitmaps are nibble-RLE compressed in the font data, and games
+	// redraw the same characters constantly - so keep the decoded pixels
+	// around.  Keyed by the bitmap's position in the font data, which is
+	// unique per glyph (and shared between char and shadow where they alias.)
+	// Not savestated, it's just a decode cache.
+	mutable std::map<u32, std::vector<u8>> decodedGlyphCache_;
 };
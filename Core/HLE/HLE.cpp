@@ -15,8 +15,10 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <algorithm>
 #include <cstdarg>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -62,6 +64,15 @@ enum
 };
 
 static std::vector<HLEModule> moduleDB;
+// Flat callno -> function table, populated as modules register. Saves the
+// interpreter cores from re-deriving module/func indices on every syscall.
+static std::vector<const HLEFunction *> syscallDispatch;
+// Lookup indexes built as modules register, so import resolution at module
+// load doesn't linear-scan the whole database for each of the (sometimes
+// tens of thousands of) NIDs a multi-PRX game brings in.
+static std::unordered_map<std::string, int> moduleIndexByName;
+// Per module, (nid, func index) sorted by nid for binary search.
+static std::vector<std::vector<std::pair<u32, int>>> funcIndexByNid;
 static int delayedResultEvent = -1;
 static int hleAfterSyscall = HLE_AFTER_NOTHING;
 static const char *hleAfterSyscallReschedReason;
@@ -110,30 +121,45 @@ void HLEShutdown()
 	hleAfterSyscall = HLE_AFTER_NOTHING;
 	latestSyscall = nullptr;
 	moduleDB.clear();
+	syscallDispatch.clear();
+	moduleIndexByName.clear();
+	funcIndexByNid.clear();
 }
 
 void RegisterModule(const char *name, int numFunctions, const HLEFunction *funcTable)
 {
 	HLEModule module = {name, numFunctions, funcTable};
 	moduleDB.push_back(module);
+
+	// Syscall numbers are 8 bits of module index and 12 bits of function index.
+	int modulenum = (int)moduleDB.size() - 1;
+	syscallDispatch.resize(moduleDB.size() << 12, nullptr);
+	for (int i = 0; i < numFunctions; i++)
+		syscallDispatch[(modulenum << 12) | i] = &funcTable[i];
+
+	moduleIndexByName[name] = modulenum;
+	std::vector<std::pair<u32, int>> nids;
+	nids.reserve(numFunctions);
+	for (int i = 0; i < numFunctions; i++)
+		nids.push_back(std::make_pair(funcTable[i].ID, i));
+	std::sort(nids.begin(), nids.end());
+	funcIndexByNid.push_back(std::move(nids));
 }
 
 int GetModuleIndex(const char *moduleName)
 {
-	for (size_t i = 0; i < moduleDB.size(); i++)
-		if (strcmp(moduleName, moduleDB[i].name) == 0)
-			return (int)i;
+	auto it = moduleIndexByName.find(moduleName);
+	if (it != moduleIndexByName.end())
+		return it->second;
 	return -1;
 }
 
 int GetFuncIndex(int moduleIndex, u32 nib)
 {
-	const HLEModule &module = moduleDB[moduleIndex];
-	for (int i = 0; i < module.numFunctions; i++)
-	{
-		if (module.funcTable[i].ID == nib)
-			return i;
-	}
+	const std::vector<std::pair<u32, int>> &nids = funcIndexByNid[moduleIndex];
+	auto it = std::lower_bound(nids.begin(), nids.end(), std::make_pair(nib, 0));
+	if (it != nids.end() && it->first == nib)
+		return it->second;
 	return -1;
 }
 
@@ -477,6 +503,10 @@ inline void CallSyscallWithoutFlags(const HLEFunction *info)
 const HLEFunction *GetSyscallFuncPointer(MIPSOpcode op)
 {
 	u32 callno = (op >> 6) & 0xFFFFF; //20 bits
+	// Fast path - a single bounds check and load for anything registered.
+	if (callno < syscallDispatch.size() && syscallDispatch[callno] != nullptr)
+		return syscallDispatch[callno];
+
 	int funcnum = callno & 0xFFF;
 	int modulenum = (callno & 0xFF000) >> 12;
 	if (funcnum == 0xfff) {
@@ -347,20 +347,38 @@ static int Replace_memset_jak() {
 	return 5 + bytes * 6 + 2;  // approximation (hm, inspecting the disasm this should be 5 + 6 * bytes + 2, but this is what works..)
 }
 
+// How far we can safely scan from a guest pointer without leaving its memory
+// region. An unterminated string must not send libc off the end of the arena.
+static u32 StringScanBound(u32 ptr) {
+	return Memory::ValidSize(ptr, Memory::g_MemorySize);
+}
+
 static int Replace_strlen() {
 	u32 srcPtr = PARAM(0);
 	const char *src = (const char *)Memory::GetPointer(srcPtr);
-	u32 len = src ? (u32)strlen(src) : 0UL;
+	u32 len = 0;
+	if (src) {
+		const u32 maxBytes = StringScanBound(srcPtr);
+		const void *terminator = memchr(src, 0, maxBytes);
+		len = terminator ? (u32)((const char *)terminator - src) : maxBytes;
+	}
 	RETURN(len);
 	return 7 + len * 4;  // approximation
 }
 
 static int Replace_strcpy() {
 	u32 destPtr = PARAM(0);
+	u32 srcPtr = PARAM(1);
 	char *dst = (char *)Memory::GetPointer(destPtr);
-	const char *src = (const char *)Memory::GetPointer(PARAM(1));
+	const char *src = (const char *)Memory::GetPointer(srcPtr);
 	if (dst && src) {
-		strcpy(dst, src);
+		u32 maxBytes = std::min(StringScanBound(srcPtr), StringScanBound(destPtr));
+		const void *terminator = memchr(src, 0, maxBytes);
+		if (terminator) {
+			memcpy(dst, src, (const char *)terminator - src + 1);
+		} else {
+			memcpy(dst, src, maxBytes);
+		}
 	}
 	RETURN(destPtr);
 	return 10;  // approximation
@@ -368,21 +386,26 @@ static int Replace_strcpy() {
 
 static int Replace_strncpy() {
 	u32 destPtr = PARAM(0);
+	u32 srcPtr = PARAM(1);
 	char *dst = (char *)Memory::GetPointer(destPtr);
-	const char *src = (const char *)Memory::GetPointer(PARAM(1));
+	const char *src = (const char *)Memory::GetPointer(srcPtr);
 	u32 bytes = PARAM(2);
 	if (dst && src && bytes != 0) {
-		strncpy(dst, src, bytes);
+		u32 maxBytes = std::min(bytes, std::min(StringScanBound(srcPtr), StringScanBound(destPtr)));
+		strncpy(dst, src, maxBytes);
 	}
 	RETURN(destPtr);
 	return 10;  // approximation
 }
 
 static int Replace_strcmp() {
-	const char *a = (const char *)Memory::GetPointer(PARAM(0));
-	const char *b = (const char *)Memory::GetPointer(PARAM(1));
+	u32 aPtr = PARAM(0);
+	u32 bPtr = PARAM(1);
+	const char *a = (const char *)Memory::GetPointer(aPtr);
+	const char *b = (const char *)Memory::GetPointer(bPtr);
 	if (a && b) {
-		RETURN(strcmp(a, b));
+		u32 maxBytes = std::min(StringScanBound(aPtr), StringScanBound(bPtr));
+		RETURN(strncmp(a, b, maxBytes));
 	} else {
 		RETURN(0);
 	}
@@ -390,11 +413,14 @@ static int Replace_strcmp() {
 }
 
 static int Replace_strncmp() {
-	const char *a = (const char *)Memory::GetPointer(PARAM(0));
-	const char *b = (const char *)Memory::GetPointer(PARAM(1));
+	u32 aPtr = PARAM(0);
+	u32 bPtr = PARAM(1);
+	const char *a = (const char *)Memory::GetPointer(aPtr);
+	const char *b = (const char *)Memory::GetPointer(bPtr);
 	u32 bytes = PARAM(2);
 	if (a && b && bytes != 0) {
-		RETURN(strncmp(a, b, bytes));
+		u32 maxBytes = std::min(bytes, std::min(StringScanBound(aPtr), StringScanBound(bPtr)));
+		RETURN(strncmp(a, b, maxBytes));
 	} else {
 		RETURN(0);
 	}
@@ -1259,11 +1285,15 @@ static const ReplacementTableEntry entries[] = {
 	{ "memmove", &Replace_memmove, 0, 0 },
 	{ "memset", &Replace_memset, 0, 0 },
 	{ "memset_jak", &Replace_memset_jak, 0, 0 },
-	{ "strlen", &Replace_strlen, 0, REPFLAG_DISABLED },
+	// The read-only string functions are bounded against the memory arena now,
+	// so they're safe to enable. The writing ones stay off - a misidentified
+	// function there would corrupt guest memory instead of just returning
+	// a wrong value.
+	{ "strlen", &Replace_strlen, 0, 0 },
 	{ "strcpy", &Replace_strcpy, 0, REPFLAG_DISABLED },
 	{ "strncpy", &Replace_strncpy, 0, REPFLAG_DISABLED },
-	{ "strcmp", &Replace_strcmp, 0, REPFLAG_DISABLED },
-	{ "strncmp", &Replace_strncmp, 0, REPFLAG_DISABLED },
+	{ "strcmp", &Replace_strcmp, 0, 0 },
+	{ "strncmp", &Replace_strncmp, 0, 0 },
 	{ "fabsf", &Replace_fabsf, JITFUNC(Replace_fabsf), REPFLAG_ALLOWINLINE | REPFLAG_DISABLED },
 	{ "dl_write_matrix", &Replace_dl_write_matrix, 0, REPFLAG_DISABLED }, // &MIPSComp::Jit::Replace_dl_write_matrix, REPFLAG_DISABLED },
 	{ "dl_write_matrix_2", &Replace_dl_write_matrix, 0, REPFLAG_DISABLED },
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "Core/HLE/sceKernel.h"
+#include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 
 struct ThreadQueueList {
@@ -51,6 +52,7 @@ struct ThreadQueueList {
 
 	ThreadQueueList() {
 		memset(queues, 0, sizeof(queues));
+		memset(occupied, 0, sizeof(occupied));
 		first = invalid();
 	}
 
@@ -75,11 +77,15 @@ struct ThreadQueueList {
 	}
 
 	inline SceUID pop_first() {
-		Queue *cur = first;
-		while (cur != invalid()) {
-			if (cur->size() > 0)
-				return cur->data[cur->first++];
-			cur = cur->next;
+		for (int w = 0; w < OCCUPIED_WORDS; ++w) {
+			if (occupied[w] == 0)
+				continue;
+			u32 priority = w * 32 + LeastSignificantSetBit(occupied[w]);
+			Queue *cur = &queues[priority];
+			SceUID threadID = cur->data[cur->first++];
+			if (cur->empty())
+				markEmpty(priority);
+			return threadID;
 		}
 
 		_dbg_assert_msg_(SCEKERNEL, false, "ThreadQueueList should not be empty.");
@@ -87,24 +93,31 @@ struct ThreadQueueList {
 	}
 
 	inline SceUID pop_first_better(u32 priority) {
-		Queue *cur = first;
 		// Don't bother looking past (worse than) this priority.
-		Queue *stop = &queues[priority];
-		while (cur < stop) {
-			if (cur->size() > 0)
-				return cur->data[cur->first++];
-			cur = cur->next;
+		const int stopWord = priority >> 5;
+		for (int w = 0; w <= stopWord; ++w) {
+			u32 bits = occupied[w];
+			if (w == stopWord)
+				bits &= (1u << (priority & 31)) - 1;
+			if (bits == 0)
+				continue;
+			u32 pri = w * 32 + LeastSignificantSetBit(bits);
+			Queue *cur = &queues[pri];
+			SceUID threadID = cur->data[cur->first++];
+			if (cur->empty())
+				markEmpty(pri);
+			return threadID;
 		}
 
 		return 0;
 	}
 
 	inline SceUID peek_first() {
-		Queue *cur = first;
-		while (cur != invalid()) {
-			if (cur->size() > 0)
-				return cur->data[cur->first];
-			cur = cur->next;
+		for (int w = 0; w < OCCUPIED_WORDS; ++w) {
+			if (occupied[w] == 0)
+				continue;
+			u32 priority = w * 32 + LeastSignificantSetBit(occupied[w]);
+			return queues[priority].data[queues[priority].first];
 		}
 
 		return 0;
@@ -113,6 +126,7 @@ struct ThreadQueueList {
 	inline void push_front(u32 priority, const SceUID threadID) {
 		Queue *cur = &queues[priority];
 		cur->data[--cur->first] = threadID;
+		markOccupied(priority);
 		// If we ran out of room toward the front, add more room for next time.
 		if (cur->first == 0)
 			rebalance(priority);
@@ -121,6 +135,7 @@ struct ThreadQueueList {
 	inline void push_back(u32 priority, const SceUID threadID) {
 		Queue *cur = &queues[priority];
 		cur->data[cur->end++] = threadID;
+		markOccupied(priority);
 		if (cur->full())
 			rebalance(priority);
 	}
@@ -139,6 +154,8 @@ struct ThreadQueueList {
 
 				// Now we're one shorter.
 				--cur->end;
+				if (cur->empty())
+					markEmpty(priority);
 				return;
 			}
 		}
@@ -164,6 +181,7 @@ struct ThreadQueueList {
 				free(queues[i].data);
 		}
 		memset(queues, 0, sizeof(queues));
+		memset(occupied, 0, sizeof(occupied));
 		first = invalid();
 	}
 
@@ -208,6 +226,8 @@ struct ThreadQueueList {
 				link(i, capacity);
 				cur->first = (cur->capacity - size) / 2;
 				cur->end = cur->first + size;
+				if (size != 0)
+					markOccupied(i);
 			}
 
 			if (size != 0)
@@ -216,10 +236,21 @@ struct ThreadQueueList {
 	}
 
 private:
+	// One bit per priority level, u32 words so it's fast on 32-bit too.
+	static const int OCCUPIED_WORDS = NUM_QUEUES / 32;
+
 	Queue *invalid() const {
 		return (Queue *)-1;
 	}
 
+	inline void markOccupied(u32 priority) {
+		occupied[priority >> 5] |= 1u << (priority & 31);
+	}
+
+	inline void markEmpty(u32 priority) {
+		occupied[priority >> 5] &= ~(1u << (priority & 31));
+	}
+
 	// Initialize a priority level and link to other queues.
 	void link(u32 priority, int size) {
 		_dbg_assert_msg_(SCEKERNEL, queues[priority].data == nullptr, "ThreadQueueList::Queue should only be initialized once.");
@@ -282,6 +313,10 @@ private:
 		}
 	}
 
+	// Bit set = that priority level has at least one ready thread.
+	// Lets the pop/peek paths find the best priority with a single bit scan
+	// instead of walking the queue chain.
+	u32 occupied[OCCUPIED_WORDS];
 	// The first queue that's ever been used.
 	Queue *first;
 	// The priority level queues of thread ids.
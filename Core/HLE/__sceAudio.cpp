@@ -39,6 +39,7 @@
 #include "Core/HLE/sceKernelTime.h"
 #include "StringUtils.h"
 #endif
+#include "Core/Replay.h"
 #include "Core/HLE/__sceAudio.h"
 #include "Core/HLE/sceAudio.h"
 #include "Core/HLE/sceKernel.h"
@@ -49,10 +50,6 @@
 StereoResampler resampler;
 AudioDebugStats g_AudioDebugStats;
 
-// Should be used to lock anything related to the outAudioQueue.
-// atomic locks are used on the lock. TODO: make this lock-free
-std::atomic_flag atomicLock_;
-
 enum latency {
 	LOW_LATENCY = 0,
 	MEDIUM_LATENCY = 1,
@@ -437,6 +434,12 @@ void __AudioUpdate(bool resetRecording) {
 		memset(mixBuffer, 0, hwBlockSize * 2 * sizeof(s32));
 	}
 
+	if (ReplayIsSeeking()) {
+		// Muted during a replay turbo-seek - push silence so the host side
+		// doesn't underrun-pad with whatever was last in the ring.
+		memset(mixBuffer, 0, hwBlockSize * 2 * sizeof(s32));
+	}
+
 	if (g_Config.bEnableSound) {
 		resampler.PushSamples(mixBuffer, hwBlockSize);
 #ifndef MOBILE_DEVICE
@@ -1047,8 +1047,13 @@ int friendFinder(){
 			INFO_LOG(SCENET, "Received %d Bytes of Data from Adhoc Server", received);
 		}
 
-		// Handle Packets
-		if (rxpos > 0) {
+		// Handle Packets. The server may have batched several packets into one
+		// TCP segment, so keep going until no complete packet is left instead
+		// of sleeping between each one.
+		bool handled = rxpos > 0;
+		while (handled && rxpos > 0) {
+			handled = false;
+
 			// BSSID Packet
 			if (rx[0] == OPCODE_CONNECT_BSSID) {
 				INFO_LOG(SCENET, "FriendFinder: Incoming OPCODE_CONNECT_BSSID");
@@ -1068,6 +1073,7 @@ int friendFinder(){
 
 					// Fix RX Buffer Length
 					rxpos -= sizeof(SceNetAdhocctlConnectBSSIDPacketS2C);
+					handled = true;
 				}
 			}
 
@@ -1091,6 +1097,7 @@ int friendFinder(){
 
 					// Fix RX Buffer Length
 					rxpos -= sizeof(SceNetAdhocctlChatPacketS2C);
+					handled = true;
 				}
 			}
 
@@ -1120,6 +1127,7 @@ int friendFinder(){
 
 					// Fix RX Buffer Length
 					rxpos -= sizeof(SceNetAdhocctlConnectPacketS2C);
+					handled = true;
 				}
 			}
 
@@ -1149,6 +1157,7 @@ int friendFinder(){
 
 					// Fix RX Buffer Length
 					rxpos -= sizeof(SceNetAdhocctlDisconnectPacketS2C);
+					handled = true;
 				}
 			}
 
@@ -1208,6 +1217,7 @@ int friendFinder(){
 
 					// Fix RX Buffer Length
 					rxpos -= sizeof(SceNetAdhocctlScanPacketS2C);
+					handled = true;
 				}
 			}
 
@@ -1240,10 +1250,25 @@ int friendFinder(){
 
 				// Fix RX Buffer Length
 				rxpos -= 1;
+				handled = true;
 			}
 		}
-		// Original value was 10 ms, I think 100 is just fine
-		sleep_ms(1); // Using 1ms for faster response just like AdhocServer
+
+		// Wait for the socket to become readable instead of spinning on a
+		// fixed sleep. Capped so the ping above, shutdown and stepping all
+		// stay responsive.
+		uint64_t waitus = 10000;
+		now = real_time_now()*1000000.0;
+		if (now - lastping < PSP_ADHOCCTL_PING_TIMEOUT && PSP_ADHOCCTL_PING_TIMEOUT - (now - lastping) < waitus)
+			waitus = PSP_ADHOCCTL_PING_TIMEOUT - (now - lastping);
+		fd_set readfds;
+		FD_ZERO(&readfds);
+		FD_SET(metasocket, &readfds);
+		timeval timeout;
+		timeout.tv_sec = 0;
+		timeout.tv_usec = (long)waitus;
+		if (select(metasocket + 1, &readfds, NULL, NULL, &timeout) < 0)
+			sleep_ms(1); // Don't busy-loop if the socket has gone bad.
 
 		// Don't do anything if it's paused, otherwise the log will be flooded
 		while (Core_IsStepping() && friendFinderRunning) sleep_ms(1);
@@ -33,9 +33,13 @@
 #include <sys/types.h>
 // Net stuff
 #if defined(_WIN32)
+// Raise the fd_set capacity so one server instance can watch a few hundred
+// client sockets at once (the WinSock default is only 64).
+#define FD_SETSIZE 1024
 #include <WS2tcpip.h>
 #else
 #include <sys/socket.h>
+#include <sys/select.h>
 #include <netinet/in.h>
 #endif
 
@@ -1830,7 +1834,58 @@ int server_loop(int server)
 	// Handling Loop
 	while (adhocServerRunning) //(_status == 1)
 	{
+		// Watch the Listening Socket and every User Stream for Activity, so idle
+		// Users cost no recv Syscalls and the Loop only wakes when there is Work.
+		fd_set readfds;
+		FD_ZERO(&readfds);
+		FD_SET(server, &readfds);
+		int maxfd = server;
+		int watched = 1;
+
+		// Leftover Data in an RX Buffer
+		bool pending = false;
+
+		// fd_set Capacity exceeded
+		bool setfull = false;
+
+		// Collect User Streams
+		SceNetAdhocctlUserNode * watchuser = _db_user;
+		while(watchuser != NULL)
+		{
+#ifdef _WIN32
+			bool fits = watched < FD_SETSIZE;
+#else
+			bool fits = watchuser->stream < FD_SETSIZE;
+#endif
+			if(fits)
+			{
+				FD_SET(watchuser->stream, &readfds);
+				if(watchuser->stream > maxfd) maxfd = watchuser->stream;
+				watched++;
+			}
+			else setfull = true;
+
+			if(watchuser->rxpos > 0) pending = true;
+			watchuser = watchuser->next;
+		}
+
+		// Sweep every Socket when select can't be used (too many Users, or Error)
+		bool swept = true;
+		if(!setfull)
+		{
+			// Zero Timeout while buffered Packets wait, so Bursts drain on
+			// consecutive Sweeps. Capped otherwise to keep the Death Clocks,
+			// Shutdown Flag and Stepping checked.
+			timeval timeout;
+			timeout.tv_sec = 0;
+			timeout.tv_usec = pending ? 0 : 10000;
+			if(select(maxfd + 1, &readfds, NULL, NULL, &timeout) >= 0) swept = false;
+			else sleep_ms(1);
+		}
+		else sleep_ms(1);
+
 		// Login Block
+		if(swept || FD_ISSET(server, &readfds))
 		{
 			// Login Result
 			int loginresult = 0;
@@ -1877,11 +1932,15 @@ int server_loop(int server)
 			// Next User (for safe delete)
 			SceNetAdhocctlUserNode * next = user->next;
 
+			// Only hit Sockets select marked readable
+			bool readable = swept || FD_ISSET(user->stream, &readfds) != 0;
+
 			// Receive Data from User
-			int recvresult = recv(user->stream, (char*)user->rx + user->rxpos, sizeof(user->rx) - user->rxpos, 0);
+			int recvresult = -1;
+			if(readable) recvresult = recv(user->stream, (char*)user->rx + user->rxpos, sizeof(user->rx) - user->rxpos, 0);
 
 			// Connection Closed or Timed Out
-			if(recvresult == 0 || (recvresult == -1 && errno != EAGAIN && errno != EWOULDBLOCK) || get_user_state(user) == USER_STATE_TIMED_OUT)
+			if(recvresult == 0 || (readable && recvresult == -1 && errno != EAGAIN && errno != EWOULDBLOCK) || get_user_state(user) == USER_STATE_TIMED_OUT)
 			{
 				// Logout User
 				logout_user(user);
@@ -2021,9 +2080,6 @@ int server_loop(int server)
 			user = next;
 		}
 
-		// Prevent needless CPU Overload (1ms Sleep)
-		sleep_ms(1);
-
 		// Don't do anything if it's paused, otherwise the log will be flooded
 		while (adhocServerRunning && Core_IsStepping()) sleep_ms(1);
 	}
@@ -16,6 +16,12 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "thread/threadutil.h"
 
 #include "Core/HLE/HLE.h"
 #include "Core/HLE/FunctionWrappers.h"
@@ -153,6 +159,7 @@ struct InputBuffer {
 struct Atrac;
 int __AtracSetContext(Atrac *atrac);
 void _AtracGenerateContext(Atrac *atrac, SceAtracId *context);
+static void AtracPrefetchSync(Atrac *atrac);
 
 struct AtracLoopInfo {
 	int cuePointID;
@@ -187,13 +194,26 @@ struct Atrac {
 		packet_ = nullptr;
 #endif // USE_FFMPEG
 		context_ = 0;
+
+		prefetchPcm_ = nullptr;
+		prefetchSamples_ = 0;
+		prefetchSample_ = -1;
+		prefetchValid_ = false;
+		prefetchAdvanced_ = false;
+		prefetchQueued_ = false;
+		prefetchBusy_ = false;
 	}
 
 	~Atrac() {
 		ResetData();
+		delete [] prefetchPcm_;
 	}
 
 	void ResetData() {
+		AtracPrefetchSync(this);
+		prefetchValid_ = false;
+		prefetchAdvanced_ = false;
+
 #ifdef USE_FFMPEG
 		ReleaseFFMPEGContext();
 #endif // USE_FFMPEG
@@ -232,6 +252,9 @@ struct Atrac {
 	}
 
 	void DoState(PointerWrap &p) {
+		// Make sure the decode-ahead worker isn't in the middle of us.
+		AtracPrefetchSync(this);
+
 		auto s = p.Section("Atrac", 1, 9);
 		if (!s)
 			return;
@@ -326,6 +349,12 @@ struct Atrac {
 			bufferState_ = ATRAC_STATUS_STREAMED_LOOP_FROM_END;
 		}
 
+		if (p.mode == p.MODE_READ) {
+			// The prefetched frame (if any) doesn't survive a savestate.
+			prefetchValid_ = false;
+			prefetchAdvanced_ = false;
+		}
+
 		// Make sure to do this late; it depends on things like bytesPerFrame_.
 		if (p.mode == p.MODE_READ && bufferState_ != ATRAC_STATUS_NO_DATA) {
 			__AtracSetContext(this);
@@ -433,6 +462,20 @@ struct Atrac {
 
 	PSPPointer<SceAtracId> context_;
 
+	// Decode-ahead state. The worker thread owns the codec while prefetchBusy_ is set;
+	// getAtrac() waits the worker out, so HLE code never sees it in flux.
+	s16 *prefetchPcm_;
+	int prefetchSamples_;
+	int prefetchSample_;
+	bool prefetchValid_;
+	// Set once the worker has fed the prefetched frame's packet to the codec. If that
+	// frame is never delivered to the game, SeekToSample() re-primes the codec.
+	bool prefetchAdvanced_;
+	bool prefetchQueued_;
+	bool prefetchBusy_;
+
+	void PrefetchDecode();
+
 #ifdef USE_FFMPEG
 	AVCodecContext  *codecCtx_ = nullptr;
 	SwrContext      *swrCtx_ = nullptr;
@@ -475,6 +518,8 @@ struct Atrac {
 		packet_->size = 0;
 #endif
 
+		prefetchValid_ = false;
+		prefetchAdvanced_ = false;
 		currentSample_ = sample;
 	}
 
@@ -492,7 +537,9 @@ struct Atrac {
 		const u32 unalignedSamples = (offsetSamples + sample) % SamplesPerFrame();
 		int seekFrame = sample + offsetSamples - unalignedSamples;
 
-		if ((sample != currentSample_ || sample == 0) && codecCtx_ != nullptr) {
+		// If the decode-ahead worker moved the codec past a frame that was never
+		// delivered, re-prime the codec even for a same-position "seek".
+		if ((sample != currentSample_ || sample == 0 || prefetchAdvanced_) && codecCtx_ != nullptr) {
 			// Prefill the decode buffer with packets before the first sample offset.
 			avcodec_flush_buffers(codecCtx_);
 
@@ -516,6 +563,8 @@ struct Atrac {
 		}
 #endif // USE_FFMPEG
 
+		prefetchValid_ = false;
+		prefetchAdvanced_ = false;
 		currentSample_ = sample;
 	}
 
@@ -622,6 +671,119 @@ static bool atracInited = true;
 static Atrac *atracIDs[PSP_NUM_ATRAC_IDS];
 static u32 atracIDTypes[PSP_NUM_ATRAC_IDS];
 
+// Decode-ahead worker. After a successful sceAtracDecodeData we queue the context here
+// and decode the next frame while the game goes off and mixes - the next decode call then
+// only needs a memcpy. One worker is plenty, ATRAC frames are small.
+static std::thread atracPrefetchThread;
+static bool atracPrefetchThreadRunning = false;
+static bool atracPrefetchExit = false;
+static std::mutex atracPrefetchLock;
+static std::condition_variable atracPrefetchWake;
+static std::condition_variable atracPrefetchDone;
+static std::deque<Atrac *> atracPrefetchQueue;
+
+// Runs on the worker. Decodes the frame at currentSample_ into prefetchPcm_ without
+// moving currentSample_, leaving the codec one frame ahead (prefetchAdvanced_.)
+void Atrac::PrefetchDecode() {
+#ifdef USE_FFMPEG
+	if (!prefetchPcm_)
+		prefetchPcm_ = new s16[ATRAC3PLUS_MAX_SAMPLES * 2];
+	prefetchSample_ = currentSample_;
+	prefetchSamples_ = 0;
+
+	AtracDecodeResult res = ATDECODE_FEEDME;
+	while (FillPacket()) {
+		res = DecodePacket();
+		prefetchAdvanced_ = true;
+		if (res != ATDECODE_FEEDME)
+			break;
+	}
+	if (res != ATDECODE_GOTFRAME || frame_->nb_samples <= 0)
+		return;
+
+	u8 *out = (u8 *)prefetchPcm_;
+	int avret = swr_convert(swrCtx_, &out, frame_->nb_samples, (const u8 **)frame_->extended_data, frame_->nb_samples);
+	if (avret < 0) {
+		ERROR_LOG(ME, "swr_convert: Error while converting %d", avret);
+		return;
+	}
+	prefetchSamples_ = frame_->nb_samples;
+	prefetchValid_ = true;
+#endif // USE_FFMPEG
+}
+
+static void AtracPrefetchThreadFunc() {
+	setCurrentThreadName("AtracPrefetch");
+	std::unique_lock<std::mutex> guard(atracPrefetchLock);
+	while (!atracPrefetchExit) {
+		if (atracPrefetchQueue.empty()) {
+			atracPrefetchWake.wait(guard);
+			continue;
+		}
+		Atrac *atrac = atracPrefetchQueue.front();
+		atracPrefetchQueue.pop_front();
+		atrac->prefetchQueued_ = false;
+		atrac->prefetchBusy_ = true;
+		guard.unlock();
+		atrac->PrefetchDecode();
+		guard.lock();
+		atrac->prefetchBusy_ = false;
+		atracPrefetchDone.notify_all();
+	}
+}
+
+// Called on the emu thread before anything touches the context.
+static void AtracPrefetchSync(Atrac *atrac) {
+	if (!atracPrefetchThreadRunning)
+		return;
+	std::unique_lock<std::mutex> guard(atracPrefetchLock);
+	while (atrac->prefetchQueued_ || atrac->prefetchBusy_)
+		atracPrefetchDone.wait(guard);
+}
+
+static void AtracPrefetchStop() {
+	if (!atracPrefetchThreadRunning)
+		return;
+	{
+		std::unique_lock<std::mutex> guard(atracPrefetchLock);
+		for (Atrac *queued : atracPrefetchQueue)
+			queued->prefetchQueued_ = false;
+		atracPrefetchQueue.clear();
+		atracPrefetchExit = true;
+		atracPrefetchWake.notify_one();
+	}
+	atracPrefetchThread.join();
+	atracPrefetchThreadRunning = false;
+	atracPrefetchExit = false;
+}
+
+static void AtracPrefetchSchedule(Atrac *atrac) {
+#ifdef USE_FFMPEG
+	// Keep to the simple case: the whole file in memory, no looping, and a frame-aligned
+	// position, so that the next decode is exactly "the frame at currentSample_".
+	if (atrac->bufferState_ != ATRAC_STATUS_ALL_DATA_LOADED || atrac->loopNum_ != 0)
+		return;
+	if (atrac->failedDecode_ || (atrac->codecType_ != PSP_MODE_AT_3 && atrac->codecType_ != PSP_MODE_AT_3_PLUS))
+		return;
+	if (atrac->currentSample_ >= atrac->endSample_)
+		return;
+	const u32 offsetSamples = atrac->firstSampleOffset_ + atrac->FirstOffsetExtra();
+	if ((offsetSamples + atrac->currentSample_) % atrac->SamplesPerFrame() != 0)
+		return;
+
+	std::unique_lock<std::mutex> guard(atracPrefetchLock);
+	if (atrac->prefetchQueued_ || atrac->prefetchBusy_)
+		return;
+	if (!atracPrefetchThreadRunning) {
+		atracPrefetchThread = std::thread(&AtracPrefetchThreadFunc);
+		atracPrefetchThreadRunning = true;
+	}
+	atrac->prefetchQueued_ = true;
+	atracPrefetchQueue.push_back(atrac);
+	atracPrefetchWake.notify_one();
+#endif // USE_FFMPEG
+}
+
 void __AtracInit() {
 	atracInited = true;
 	memset(atracIDs, 0, sizeof(atracIDs));
@@ -660,6 +822,7 @@ void __AtracDoState(PointerWrap &p) {
 }
 
 void __AtracShutdown() {
+	AtracPrefetchStop();
 	for (size_t i = 0; i < ARRAY_SIZE(atracIDs); ++i) {
 		delete atracIDs[i];
 		atracIDs[i] = NULL;
@@ -671,6 +834,10 @@ static Atrac *getAtrac(int atracID) {
 		return NULL;
 	}
 	Atrac *atrac = atracIDs[atracID];
+	if (atrac) {
+		// If the decode-ahead worker is on this context, let it finish first.
+		AtracPrefetchSync(atrac);
+	}
 
 	if (atrac && atrac->context_.IsValid()) {
 		// Read in any changes from the game to the context.
@@ -1178,7 +1345,21 @@ u32 _AtracDecodeData(int atracID, u8 *outbuf, u32 outbufPtr, u32 *SamplesNum, u3
 				atrac->ConsumeFrame();
 			}
 
-			if (!atrac->failedDecode_ && (atrac->codecType_ == PSP_MODE_AT_3 || atrac->codecType_ == PSP_MODE_AT_3_PLUS)) {
+			if (skipSamples == 0 && atrac->prefetchValid_ && atrac->prefetchSample_ == atrac->currentSample_ && atrac->bufferState_ == ATRAC_STATUS_ALL_DATA_LOADED) {
+				// The decode-ahead worker already produced this frame - just deliver it.
+				numSamples = std::min(maxSamples, (u32)atrac->prefetchSamples_);
+				if (outbuf != NULL && numSamples != 0) {
+					u32 outBytes = numSamples * atrac->outputChannels_ * sizeof(s16);
+					memcpy(outbuf, atrac->prefetchPcm_, outBytes);
+					if (outbufPtr != 0) {
+						CBreakPoints::ExecMemCheck(outbufPtr, true, outBytes, currentMIPS->pc);
+					}
+				}
+				// The codec is already past this frame, which is exactly where the
+				// bookkeeping below leaves currentSample_.
+				atrac->prefetchValid_ = false;
+				atrac->prefetchAdvanced_ = false;
+			} else if (!atrac->failedDecode_ && (atrac->codecType_ == PSP_MODE_AT_3 || atrac->codecType_ == PSP_MODE_AT_3_PLUS)) {
 				atrac->SeekToSample(atrac->currentSample_);
 
 				AtracDecodeResult res = ATDECODE_FEEDME;
@@ -1285,6 +1466,11 @@ u32 _AtracDecodeData(int atracID, u8 *outbuf, u32 outbufPtr, u32 *SamplesNum, u3
 
 			*finish = finishFlag;
 			*remains = atrac->RemainingFrames();
+
+			if (finishFlag == 0) {
+				// Get a head start on the next frame while the game does other work.
+				AtracPrefetchSchedule(atrac);
+			}
 		}
 		if (atrac->context_.IsValid()) {
 			// refresh context_
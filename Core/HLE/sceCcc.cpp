@@ -15,11 +15,21 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include "ppsspp_config.h"
+
 #include "util/text/utf8.h"
 #include "util/text/utf16.h"
 #include "util/text/shiftjis.h"
 
 #include "Common/ChunkFile.h"
+
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+#if PPSSPP_ARCH(ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "Core/Debugger/Breakpoints.h"
 #include "Core/MemMap.h"
 #include "Core/HLE/HLE.h"
@@ -106,6 +116,40 @@ static int sceCccUTF8toUTF16(u32 dstAddr, u32 dstSize, u32 srcAddr)
 	DEBUG_LOG(SCEMISC, "sceCccUTF8toUTF16(%08x, %d, %08x)", dstAddr, dstSize, srcAddr);
 	UTF8 utf(src);
 	int n = 0;
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+	// ASCII fast path - script text is mostly ASCII even in Japanese games.
+	// Widen 16 source bytes per iteration until a high byte, the terminator,
+	// or the end of either buffer shows up, then drop to the code point loop.
+	{
+		const u8 *s = (const u8 *)(const char *)src;
+		const u32 srcValid = Memory::ValidSize(srcAddr, 0x40000000);
+		int i = 0;
+		while (i + 16 <= (int)srcValid && dst + 16 < dstEnd) {
+			u16 *d = dst;
+#ifdef _M_SSE
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i chunk = _mm_loadu_si128((const __m128i *)&s[i]);
+			const int stop = _mm_movemask_epi8(chunk) | _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+			if (stop != 0)
+				break;
+			_mm_storeu_si128((__m128i *)d, _mm_unpacklo_epi8(chunk, zero));
+			_mm_storeu_si128((__m128i *)(d + 8), _mm_unpackhi_epi8(chunk, zero));
+#else
+			const uint8x16_t chunk = vld1q_u8(&s[i]);
+			const uint8x16_t stop = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(0)), vcgeq_u8(chunk, vdupq_n_u8(0x80)));
+			const uint8x8_t stop2 = vorr_u8(vget_low_u8(stop), vget_high_u8(stop));
+			if (vget_lane_u64(vreinterpret_u64_u8(stop2), 0) != 0)
+				break;
+			vst1q_u16(d, vmovl_u8(vget_low_u8(chunk)));
+			vst1q_u16(d + 8, vmovl_u8(vget_high_u8(chunk)));
+#endif
+			i += 16;
+			dst += 16;
+			n += 16;
+		}
+		utf = UTF8(src, i);
+	}
+#endif
 	while (u32 c = utf.next())
 	{
 		if (dst + UTF16LE::encodeUnits(c) >= dstEnd)
@@ -173,6 +217,46 @@ static int sceCccUTF16toUTF8(u32 dstAddr, u32 dstSize, u32 srcAddr)
 	DEBUG_LOG(SCEMISC, "sceCccUTF16toUTF8(%08x, %d, %08x)", dstAddr, dstSize, srcAddr);
 	UTF16LE utf(src);
 	int n = 0;
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+	// ASCII fast path, the mirror of the one in sceCccUTF8toUTF16: narrow 16
+	// UTF-16 units per iteration as long as they're all plain ASCII.
+	{
+		const u16 *s = src;
+		const u32 srcValid = Memory::ValidSize(srcAddr, 0x40000000) / sizeof(u16);
+		int i = 0;
+		while (i + 16 <= (int)srcValid && dst + 16 < dstEnd) {
+			char *d = dst;
+#ifdef _M_SSE
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i limit = _mm_set1_epi16(0x7F);
+			const __m128i v1 = _mm_loadu_si128((const __m128i *)&s[i]);
+			const __m128i v2 = _mm_loadu_si128((const __m128i *)&s[i + 8]);
+			// A unit stops the bulk loop if it's the terminator, above 0x7F,
+			// or 0x8000+ (negative as signed, so cmpgt alone would miss it.)
+			__m128i stop = _mm_or_si128(_mm_cmpeq_epi16(v1, zero), _mm_cmpeq_epi16(v2, zero));
+			stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpgt_epi16(v1, limit), _mm_cmpgt_epi16(v2, limit)));
+			stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmplt_epi16(v1, zero), _mm_cmplt_epi16(v2, zero)));
+			if (_mm_movemask_epi8(stop) != 0)
+				break;
+			_mm_storeu_si128((__m128i *)d, _mm_packus_epi16(v1, v2));
+#else
+			const uint16x8_t v1 = vld1q_u16(&s[i]);
+			const uint16x8_t v2 = vld1q_u16(&s[i + 8]);
+			const uint16x8_t stop = vorrq_u16(
+				vorrq_u16(vceqq_u16(v1, vdupq_n_u16(0)), vcgeq_u16(v1, vdupq_n_u16(0x80))),
+				vorrq_u16(vceqq_u16(v2, vdupq_n_u16(0)), vcgeq_u16(v2, vdupq_n_u16(0x80))));
+			const uint8x8_t stop2 = vorr_u8(vget_low_u8(vreinterpretq_u8_u16(stop)), vget_high_u8(vreinterpretq_u8_u16(stop)));
+			if (vget_lane_u64(vreinterpret_u64_u8(stop2), 0) != 0)
+				break;
+			vst1q_u8((u8 *)d, vcombine_u8(vmovn_u16(v1), vmovn_u16(v2)));
+#endif
+			i += 16;
+			dst += 16;
+			n += 16;
+		}
+		utf = UTF16LE(src, i);
+	}
+#endif
 	while (u32 c = utf.next())
 	{
 		if (dst + UTF8::encodeUnits(c) >= dstEnd)
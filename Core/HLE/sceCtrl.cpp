@@ -17,7 +17,9 @@
 
 #include <cmath>
 #include <mutex>
+#include <vector>
 
+#include "base/timeutil.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HLE/FunctionWrappers.h"
 #include "Core/MIPS/MIPS.h"
@@ -95,6 +97,19 @@ static int ctrlTimer = -1;
 static bool emuRapidFire = false;
 static u32 emuRapidFireFrames = 0;
 
+// Host button events are queued with their arrival time and applied in order at
+// the emulated latch instant. This way a press and release that both land within
+// one sample interval still show up in the latch instead of cancelling out.
+// Not savestated - it's host input state, like ctrlCurrent. Guarded by ctrlMutex.
+struct CtrlButtonEvent {
+	double time;  // host time, from real_time_now()
+	u32 down;
+	u32 up;
+};
+static std::vector<CtrlButtonEvent> buttonEvents;
+static u32 ctrlSampledButtons = 0;
+static const size_t MAX_BUTTON_EVENTS = 256;
+
 // These buttons are not affected by rapid fire (neither is analog.)
 const u32 CTRL_EMU_RAPIDFIRE_MASK = CTRL_UP | CTRL_DOWN | CTRL_LEFT | CTRL_RIGHT;
 
@@ -102,23 +117,49 @@ static void __CtrlUpdateLatch()
 {
 	std::lock_guard<std::mutex> guard(ctrlMutex);
 	u64 t = CoreTiming::GetGlobalTimeUs();
+	double now = real_time_now();
+
+	// Apply queued button events in arrival order up to the latch instant,
+	// collecting the makes and breaks of even sub-sample taps.
+	u32 evtMake = 0;
+	u32 evtBreak = 0;
+	size_t applied = 0;
+	while (applied < buttonEvents.size() && buttonEvents[applied].time <= now) {
+		const CtrlButtonEvent &e = buttonEvents[applied];
+		u32 newButtons = (ctrlSampledButtons | e.down) & ~e.up;
+		u32 evtChanged = newButtons ^ ctrlSampledButtons;
+		evtMake |= newButtons & evtChanged;
+		evtBreak |= ctrlSampledButtons & evtChanged;
+		ctrlSampledButtons = newButtons;
+		applied++;
+	}
+	if (applied > 0)
+		buttonEvents.erase(buttonEvents.begin(), buttonEvents.begin() + applied);
 
-	u32 buttons = ctrlCurrent.buttons;
-	if (emuRapidFire && (emuRapidFireFrames % 10) < 5)
+	u32 buttons = ctrlSampledButtons;
+	if (emuRapidFire && (emuRapidFireFrames % 10) < 5) {
 		buttons &= CTRL_EMU_RAPIDFIRE_MASK;
+		evtMake &= CTRL_EMU_RAPIDFIRE_MASK;
+	}
 
+	u32 preReplay = buttons;
 	ReplayApplyCtrl(buttons, ctrlCurrent.analog, t);
+	if (buttons != preReplay) {
+		// A replay is overriding the live input - our host event bits don't apply.
+		evtMake = 0;
+		evtBreak = 0;
+	}
 
 	// Copy in the current data to the current buffer.
 	ctrlBufs[ctrlBuf] = ctrlCurrent;
 	ctrlBufs[ctrlBuf].buttons = buttons;
 
 	u32 changed = buttons ^ ctrlOldButtons;
-	latch.btnMake |= buttons & changed;
-	latch.btnBreak |= ctrlOldButtons & changed;
-	latch.btnPress |= buttons;
-	latch.btnRelease |= ~buttons;
-	dialogBtnMake |= buttons & changed;
+	latch.btnMake |= (buttons & changed) | evtMake;
+	latch.btnBreak |= (ctrlOldButtons & changed) | evtBreak;
+	latch.btnPress |= buttons | evtMake;
+	latch.btnRelease |= ~buttons | evtBreak;
+	dialogBtnMake |= (buttons & changed) | evtMake;
 	ctrlLatchBufs++;
 
 	ctrlOldButtons = buttons;
@@ -171,14 +212,22 @@ u32 __CtrlReadLatch()
 
 void __CtrlButtonDown(u32 buttonBit)
 {
+	double now = real_time_now();
 	std::lock_guard<std::mutex> guard(ctrlMutex);
 	ctrlCurrent.buttons |= buttonBit;
+	// If the queue somehow fills up (sampling stalled), just skip the event -
+	// the state above is still correct, only sub-sample taps degrade.
+	if (buttonEvents.size() < MAX_BUTTON_EVENTS)
+		buttonEvents.push_back(CtrlButtonEvent{ now, buttonBit, 0 });
 }
 
 void __CtrlButtonUp(u32 buttonBit)
 {
+	double now = real_time_now();
 	std::lock_guard<std::mutex> guard(ctrlMutex);
 	ctrlCurrent.buttons &= ~buttonBit;
+	if (buttonEvents.size() < MAX_BUTTON_EVENTS)
+		buttonEvents.push_back(CtrlButtonEvent{ now, 0, buttonBit });
 }
 
 void __CtrlSetAnalogX(float x, int stick)
@@ -323,6 +372,9 @@ void __CtrlInit()
 	memset(ctrlCurrent.analog, CTRL_ANALOG_CENTER, sizeof(ctrlCurrent.analog));
 	analogEnabled = false;
 
+	buttonEvents.clear();
+	ctrlSampledButtons = 0;
+
 	for (u32 i = 0; i < NUM_CTRL_BUFFERS; i++)
 		memcpy(&ctrlBufs[i], &ctrlCurrent, sizeof(CtrlData));
 }
@@ -23,92 +23,61 @@
 #include "Core/HLE/sceDeflt.h"
 #include "Core/MemMap.h"
 
-// All the decompress functions are identical with only differing window bits. Possibly should be one function
-
-static int sceDeflateDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
-	DEBUG_LOG(HLE, "sceGzipDecompress(%08x, %x, %08x, %08x)", OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
+// All the decompress functions are identical with only differing window bits.
+static int DecompressCommon(const char *name, int windowBits, u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
+	DEBUG_LOG(HLE, "%s(%08x, %x, %08x, %08x)", name, OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
 	int err;
 	uLong crc;
-	z_stream stream;
 	u8 *outBufferPtr;
 	u32 *crc32AddrPtr = 0;
 
 	if (!Memory::IsValidAddress(OutBuffer) || !Memory::IsValidAddress(InBuffer)) {
-		ERROR_LOG(HLE, "sceZlibDecompress: Bad address %08x %08x", OutBuffer, InBuffer);
+		ERROR_LOG(HLE, "%s: Bad address %08x %08x", name, OutBuffer, InBuffer);
 		return 0;
 	}
 	if (Crc32Addr) {
 		if (!Memory::IsValidAddress(Crc32Addr)) {
-			ERROR_LOG(HLE, "sceZlibDecompress: Bad address %08x", Crc32Addr);
+			ERROR_LOG(HLE, "%s: Bad address %08x", name, Crc32Addr);
 			return 0;
 		}
 		crc32AddrPtr = (u32 *)Memory::GetPointer(Crc32Addr);
 	}
-	outBufferPtr = Memory::GetPointer(OutBuffer);
-	stream.next_in = (Bytef*)Memory::GetPointer(InBuffer);
-	stream.avail_in = (uInt)OutBufferLength;
-	stream.next_out = outBufferPtr;
-	stream.avail_out = (uInt)OutBufferLength;
-	stream.zalloc = (alloc_func)0;
-	stream.zfree = (free_func)0;
-	err = inflateInit2(&stream, -MAX_WBITS);
-	if (err != Z_OK) {
-		ERROR_LOG(HLE, "sceZlibDecompress: inflateInit2 failed %08x", err);
-		return 0;
-	}
-	err = inflate(&stream, Z_FINISH);
-	if (err != Z_STREAM_END) {
-		inflateEnd(&stream);
-		ERROR_LOG(HLE, "sceZlibDecompress: inflate failed %08x", err);
-		return 0;
-	}
-	inflateEnd(&stream);
-	if (crc32AddrPtr) {
-		crc = crc32(0L, Z_NULL, 0);
-		*crc32AddrPtr = crc32(crc, outBufferPtr, stream.total_out);
-	}
-	return stream.total_out;
-}
 
-
-static int sceGzipDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
-	DEBUG_LOG(HLE, "sceGzipDecompress(%08x, %x, %08x, %08x)", OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
-	int err;
-	uLong crc;
-	z_stream stream;
-	u8 *outBufferPtr;
-	u32 *crc32AddrPtr = 0;
-
-	if (!Memory::IsValidAddress(OutBuffer) || !Memory::IsValidAddress(InBuffer)) {
-		ERROR_LOG(HLE, "sceZlibDecompress: Bad address %08x %08x", OutBuffer, InBuffer);
-		return 0;
-	}
-	if (Crc32Addr) {
-		if (!Memory::IsValidAddress(Crc32Addr)) {
-			ERROR_LOG(HLE, "sceZlibDecompress: Bad address %08x", Crc32Addr);
+	// HLE calls only run on the CPU thread, so one reusable context is enough.
+	// inflateInit2 allocates the whole inflate window per call, which adds up when
+	// games decompress assets in tight sequences during loads - resetting the kept
+	// stream skips that. inflateReset2 also switches the window bits as needed.
+	static z_stream stream;
+	static bool streamInit = false;
+	if (!streamInit) {
+		stream.zalloc = (alloc_func)0;
+		stream.zfree = (free_func)0;
+		stream.opaque = (voidpf)0;
+		err = inflateInit2(&stream, windowBits);
+		if (err != Z_OK) {
+			ERROR_LOG(HLE, "%s: inflateInit2 failed %08x", name, err);
+			return 0;
+		}
+		streamInit = true;
+	} else {
+		err = inflateReset2(&stream, windowBits);
+		if (err != Z_OK) {
+			ERROR_LOG(HLE, "%s: inflateReset2 failed %08x", name, err);
 			return 0;
 		}
-		crc32AddrPtr = (u32 *)Memory::GetPointer(Crc32Addr);
 	}
+
 	outBufferPtr = Memory::GetPointer(OutBuffer);
 	stream.next_in = (Bytef*)Memory::GetPointer(InBuffer);
 	stream.avail_in = (uInt)OutBufferLength;
 	stream.next_out = outBufferPtr;
 	stream.avail_out = (uInt)OutBufferLength;
-	stream.zalloc = (alloc_func)0;
-	stream.zfree = (free_func)0;
-	err = inflateInit2(&stream, 16+MAX_WBITS);
-	if (err != Z_OK) {
-		ERROR_LOG(HLE, "sceZlibDecompress: inflateInit2 failed %08x", err);
-		return 0;
-	}
 	err = inflate(&stream, Z_FINISH);
 	if (err != Z_STREAM_END) {
-		inflateEnd(&stream);
-		ERROR_LOG(HLE, "sceZlibDecompress: inflate failed %08x", err);
+		// The context is reset on the next call, no need to tear it down.
+		ERROR_LOG(HLE, "%s: inflate failed %08x", name, err);
 		return 0;
 	}
-	inflateEnd(&stream);
 	if (crc32AddrPtr) {
 		crc = crc32(0L, Z_NULL, 0);
 		*crc32AddrPtr = crc32(crc, outBufferPtr, stream.total_out);
@@ -116,49 +85,16 @@ static int sceGzipDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u
 	return stream.total_out;
 }
 
-static int sceZlibDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
-	DEBUG_LOG(HLE, "sceZlibDecompress(%08x, %x, %08x, %08x)", OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
-	int err;
-	uLong crc;
-	z_stream stream;
-	u8 *outBufferPtr;
-	u32 *crc32AddrPtr = 0;
+static int sceDeflateDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
+	return DecompressCommon("sceDeflateDecompress", -MAX_WBITS, OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
+}
 
-	if (!Memory::IsValidAddress(OutBuffer) || !Memory::IsValidAddress(InBuffer)) {
-		ERROR_LOG(HLE, "sceZlibDecompress: Bad address %08x %08x", OutBuffer, InBuffer);
-		return 0;
-	}
-	if (Crc32Addr) {
-		if (!Memory::IsValidAddress(Crc32Addr)) {
-			ERROR_LOG(HLE, "sceZlibDecompress: Bad address %08x", Crc32Addr);
-			return 0;
-		}
-		crc32AddrPtr = (u32 *)Memory::GetPointer(Crc32Addr);
-	}
-	outBufferPtr = Memory::GetPointer(OutBuffer);
-	stream.next_in = (Bytef*)Memory::GetPointer(InBuffer);
-	stream.avail_in = (uInt)OutBufferLength;
-	stream.next_out = outBufferPtr;
-	stream.avail_out = (uInt)OutBufferLength;
-	stream.zalloc = (alloc_func)0;
-	stream.zfree = (free_func)0;
-	err = inflateInit2(&stream, MAX_WBITS);
-	if (err != Z_OK) {
-		ERROR_LOG(HLE, "sceZlibDecompress: inflateInit failed %08x", err);
-		return 0;
-	}
-	err = inflate(&stream, Z_FINISH);
-	if (err != Z_STREAM_END) {
-		inflateEnd(&stream);
-		ERROR_LOG(HLE, "sceZlibDecompress: inflate failed %08x", err);
-		return 0;
-	}
-	inflateEnd(&stream);
-	if (crc32AddrPtr) {
-		crc = crc32(0L, Z_NULL, 0);
-		*crc32AddrPtr = crc32(crc, outBufferPtr, stream.total_out);
-	}
-	return stream.total_out;
+static int sceGzipDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
+	return DecompressCommon("sceGzipDecompress", 16 + MAX_WBITS, OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
+}
+
+static int sceZlibDecompress(u32 OutBuffer, int OutBufferLength, u32 InBuffer, u32 Crc32Addr) {
+	return DecompressCommon("sceZlibDecompress", MAX_WBITS, OutBuffer, OutBufferLength, InBuffer, Crc32Addr);
 }
 
 const HLEFunction sceDeflt[] = {
@@ -40,7 +40,9 @@
 #include "Core/Config.h"
 #include "Core/CoreTiming.h"
 #include "Core/CoreParameter.h"
+#include "Core/FileLoaders/RamCachingFileLoader.h"
 #include "Core/Host.h"
+#include "Core/Replay.h"
 #include "Core/Reporting.h"
 #include "Core/System.h"
 #include "Core/HLE/HLE.h"
@@ -49,6 +51,8 @@
 #include "Core/HLE/sceKernel.h"
 #include "Core/HLE/sceKernelThread.h"
 #include "Core/HLE/sceKernelInterrupt.h"
+#include "Core/MIPS/MIPSAnalyst.h"
+#include "Core/MIPS/JitCommon/JitCommon.h"
 
 #include "GPU/GPU.h"
 #include "GPU/GPUState.h"
@@ -119,6 +123,14 @@ static double nextFrameTime;
 static int numVBlanks;
 static int numVBlanksSinceFlip;
 
+// Frame pacing bookkeeping, not part of the state either. We track how much host
+// sleeps tend to overshoot so the tail of each frame wait can be spun precisely,
+// and how far off target frames are actually released (shown in debug stats).
+static double sleepOvershoot;
+static double pacingErrorAvg;
+static double pacingErrorMax;
+static int pacingErrorFrames;
+
 static u64 frameStartTicks;
 const int hCountPerVblank = 286;
 
@@ -227,6 +239,10 @@ void __DisplayInit() {
 	curFrameTime = 0.0;
 	nextFrameTime = 0.0;
 	lastFrameTime = 0.0;
+	sleepOvershoot = 0.0;
+	pacingErrorAvg = 0.0;
+	pacingErrorMax = 0.0;
+	pacingErrorFrames = 0;
 
 	flips = 0;
 	fps = 0.0;
@@ -470,15 +486,31 @@ void __DisplayGetDebugStats(char *stats, size_t bufsize) {
 	char statbuf[4096];
 	gpu->GetStats(statbuf, sizeof(statbuf));
 
+	char cachebuf[192];
+	cachebuf[0] = '\0';
+	u64 ramCacheHits = 0, ramCacheMisses = 0, ramCacheEvictions = 0;
+	RamCachingFileLoader::GetRAMCacheStats(&ramCacheHits, &ramCacheMisses, &ramCacheEvictions);
+	if (ramCacheHits != 0 || ramCacheMisses != 0) {
+		snprintf(cachebuf, sizeof(cachebuf),
+			"ISO RAM cache: %llu hits, %llu misses, %llu evicted\n",
+			(unsigned long long)ramCacheHits,
+			(unsigned long long)ramCacheMisses,
+			(unsigned long long)ramCacheEvictions);
+	}
+
 	snprintf(stats, bufsize,
 		"Kernel processing time: %0.2f ms\n"
 		"Slowest syscall: %s : %0.2f ms\n"
-		"Most active syscall: %s : %0.2f ms\n%s",
+		"Most active syscall: %s : %0.2f ms\n"
+		"Frame pacing error: %0.2f ms avg, %0.2f ms max\n%s%s",
 		kernelStats.msInSyscalls * 1000.0f,
 		kernelStats.slowestSyscallName ? kernelStats.slowestSyscallName : "(none)",
 		kernelStats.slowestSyscallTime * 1000.0f,
 		kernelStats.summedSlowestSyscallName ? kernelStats.summedSlowestSyscallName : "(none)",
 		kernelStats.summedSlowestSyscallTime * 1000.0f,
+		pacingErrorAvg * 1000.0,
+		pacingErrorMax * 1000.0,
+		cachebuf,
 		statbuf);
 }
 
@@ -590,20 +622,50 @@ static void DoFrameTiming(bool &throttle, bool &skipFrame, float timestep) {
 		if (nextFrameTime - curFrameTime > 2*scaledTimestep) {
 			nextFrameTime = curFrameTime;
 		} else {
-			// Wait until we've caught up.
-			while (time_now_d() < nextFrameTime) {
+			// Wait until we've caught up. Only sleep while there's more time left than
+			// the host's sleeps have recently overshot by, then spin off the remainder
+			// so the frame is released on target instead of a timer tick late.
+			while (nextFrameTime - time_now_d() > sleepOvershoot) {
+				const double before = time_now_d();
 #ifdef _WIN32
+				const double requested = 0.001;
 				sleep_ms(1); // Sleep for 1ms on this thread
 #else
-				const double left = nextFrameTime - curFrameTime;
-				usleep((long)(left * 1000000));
+				const double requested = nextFrameTime - before - sleepOvershoot;
+				if (requested > 0.0)
+					usleep((long)(requested * 1000000));
 #endif
 				time_update();
+				// Feed this sleep's overshoot into a rolling estimate of the host
+				// timer's latency. Ignore wild outliers (scheduling hiccups).
+				const double overshoot = (time_now_d() - before) - requested;
+				if (overshoot > 0.0 && overshoot < 0.005) {
+					sleepOvershoot += (overshoot - sleepOvershoot) * (1.0 / 16.0);
+				}
+			}
+			while (time_now_d() < nextFrameTime) {
+				time_update();
 			}
 		}
 		curFrameTime = time_now_d();
 	}
 
+	if (throttle && !wasPaused) {
+		// Track how late past the ideal release time this frame actually was,
+		// for the debug stats HUD.
+		double pacingError = curFrameTime - nextFrameTime;
+		if (pacingError < 0.0)
+			pacingError = 0.0;
+		pacingErrorAvg += (pacingError - pacingErrorAvg) * (1.0 / 32.0);
+		if (pacingError > pacingErrorMax)
+			pacingErrorMax = pacingError;
+		// Restart the max every couple of seconds so it reflects recent behavior.
+		if (++pacingErrorFrames >= 120) {
+			pacingErrorMax = pacingError;
+			pacingErrorFrames = 0;
+		}
+	}
+
 	lastFrameTime = nextFrameTime;
 	wasPaused = false;
 }
@@ -655,6 +717,7 @@ void hleEnterVblank(u64 userdata, int cyclesLate) {
 
 	isVblank = 1;
 	vCount++; // vCount increases at each VBLANK.
+	ReplayNotifyVblank(vCount);
 	hCountBase += hCountPerVblank; // This is the "accumulated" hcount base.
 	if (hCountBase > 0x7FFFFFFF) {
 		hCountBase -= 0x80000000;
@@ -698,6 +761,13 @@ void hleEnterVblank(u64 userdata, int cyclesLate) {
 		// Gotta flip even if sceDisplaySetFramebuf was not called.
 		__DisplayFlip(cyclesLate);
 	}
+
+	// A good safe point to chip away at any queued function precompiles - we're
+	// on the CPU thread and no jit code is running.
+	MIPSAnalyst::ProcessPrecompileQueue(0.001);
+	// Same goes for batching up pending hot-block recompiles contiguously.
+	if (MIPSComp::jit)
+		MIPSComp::jit->CompactHotBlocks();
 }
 
 void __DisplayFlip(int cyclesLate) {
@@ -760,6 +830,11 @@ void __DisplayFlip(int cyclesLate) {
 		if (numSkippedFrames >= maxFrameskip || GPURecord::IsActivePending()) {
 			skipFrame = false;
 		}
+		// A replay turbo-seek only needs the GE run for state - skip every
+		// draw until the target vblank (unless a GE dump was just requested.)
+		if (ReplayIsSeeking() && !GPURecord::IsActivePending()) {
+			skipFrame = true;
+		}
 
 		if (skipFrame) {
 			gstate_c.skipDrawReason |= SKIPDRAW_SKIPFRAME;
@@ -31,6 +31,7 @@
 #include "Core/System.h"
 #include "Core/HDRemaster.h"
 #include "Core/Host.h"
+#include "Core/Replay.h"
 #include "Core/SaveState.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HLE/FunctionWrappers.h"
@@ -295,6 +296,9 @@ static void __IoFreeFd(int fd, u32 &error) {
 	} else {
 		FileNode *f = __IoGetFd(fd, error);
 		if (f) {
+			// A write-behind isn't an operation the game knows about - finish
+			// it instead of refusing the close.
+			ioManager.WaitWriteBehind(f->handle);
 			// If there are pending results, don't allow closing.
 			if (ioManager.HasOperation(f->handle)) {
 				error = SCE_KERNEL_ERROR_ASYNC_BUSY;
@@ -502,6 +506,7 @@ static VFSFileSystem *flash0System = nullptr;
 
 static void __IoManagerThread() {
 	setCurrentThreadName("IO");
+	setCurrentThreadRole(ThreadRole::IO);
 	while (ioManagerThreadEnabled && coreState != CORE_ERROR && coreState != CORE_POWERDOWN) {
 		ioManager.RunEventsUntil(CoreTiming::GetTicks() + msToCycles(1000));
 	}
@@ -654,8 +659,9 @@ void __IoShutdown() {
 	if (ioManagerThread != NULL) {
 		delete ioManagerThread;
 		ioManagerThread = NULL;
-		ioManager.Shutdown();
 	}
+	// Stop the worker pool before the filesystems below go away.
+	ioManager.Shutdown();
 
 	pspFileSystem.Unmount("ms0:", memstickSystem);
 	pspFileSystem.Unmount("fatms0:", memstickSystem);
@@ -915,6 +921,8 @@ static bool __IoRead(int &result, int id, u32 data_addr, int size, int &us) {
 				return true;
 			}
 
+			// A previous write-behind must land before we read.
+			ioManager.WaitWriteBehind(f->handle);
 			bool useThread = __KernelIsDispatchEnabled() && ioManagerThreadEnabled && size > IO_THREAD_MIN_DATA_SIZE;
 			if (useThread) {
 				// If there's a pending operation on this file, wait for it to finish and don't overwrite it.
@@ -1050,6 +1058,8 @@ static bool __IoWrite(int &result, int id, u32 data_addr, int size, int &us) {
 
 		CBreakPoints::ExecMemCheck(data_addr, false, size, currentMIPS->pc);
 
+		// A previous write-behind must land before we touch the file again.
+		ioManager.WaitWriteBehind(f->handle);
 		bool useThread = __KernelIsDispatchEnabled() && ioManagerThreadEnabled && size > IO_THREAD_MIN_DATA_SIZE;
 		if (useThread) {
 			// If there's a pending operation on this file, wait for it to finish and don't overwrite it.
@@ -1059,6 +1069,26 @@ static bool __IoWrite(int &result, int id, u32 data_addr, int size, int &us) {
 			}
 		}
 		if (useThread) {
+			// When the free space says the write can't fail, report success at
+			// emulated speed right away and let the host write finish behind
+			// our back. Realistic timing needs the actual write duration, and
+			// replay execution must return the recorded result, so both still
+			// wait for the host.
+			bool writeBehind = GetIOTimingMethod() != IOTIMING_REALISTIC && !ReplayIsExecuting() &&
+				MemoryStick_FreeSpace() >= (u64)size + MemoryStick_SectorSize();
+			if (writeBehind) {
+				AsyncIOEvent ev = IO_EVENT_WRITE_BEHIND;
+				ev.handle = f->handle;
+				// The game is free to reuse its buffer once we return, so copy.
+				u8 *copy = new u8[size];
+				memcpy(copy, data_ptr, size);
+				ev.buf = copy;
+				ev.bytes = size;
+				ev.invalidateAddr = 0;
+				ioManager.ScheduleOperation(ev);
+				result = size;
+				return true;
+			}
 			AsyncIOEvent ev = IO_EVENT_WRITE;
 			ev.handle = f->handle;
 			ev.buf = (u8 *) data_ptr;
@@ -1212,6 +1242,7 @@ static s64 __IoLseekDest(FileNode *f, s64 offset, int whence, FileMove &seek) {
 	seek = FILEMOVE_BEGIN;
 
 	// Let's make sure this isn't incorrect mid-operation.
+	ioManager.WaitWriteBehind(f->handle);
 	if (ioManager.HasOperation(f->handle)) {
 		ioManager.SyncThread();
 	}
@@ -16,7 +16,7 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <string>
-#include <list>
+#include <deque>
 #include <map>
 
 #include "Core/MemMapHelpers.h"
@@ -71,7 +71,9 @@ public:
 
 InterruptState intState;
 IntrHandler* intrHandlers[PSP_NUMBER_INTERRUPTS];
-std::list<PendingInterrupt> pendingInterrupts;
+// Used as a FIFO ring - avoids a node allocation per queued interrupt, which adds up
+// since vblank alone queues at 60 Hz.
+std::deque<PendingInterrupt> pendingInterrupts;
 
 // Yeah, this bit is a bit silly.
 static int interruptsEnabled = 1;
@@ -140,19 +142,13 @@ bool IntrHandler::run(PendingInterrupt& pend)
 		return false;
 	}
 
-	copyArgsToCPU(pend);
-
-	return true;
-}
-
-void IntrHandler::copyArgsToCPU(PendingInterrupt& pend)
-{
-	SubIntrHandler* handler = get(pend.subintr);
 	DEBUG_LOG(CPU, "Entering interrupt handler %08x", handler->handlerAddress);
 	currentMIPS->pc = handler->handlerAddress;
 	currentMIPS->r[MIPS_REG_A0] = handler->subIntrNumber;
 	currentMIPS->r[MIPS_REG_A1] = handler->handlerArg;
 	// RA is already taken care of
+
+	return true;
 }
 
 void IntrHandler::handleResult(PendingInterrupt& pend)
@@ -166,10 +162,7 @@ SubIntrHandler* IntrHandler::add(int subIntrNum)
 }
 void IntrHandler::remove(int subIntrNum)
 {
-	if (has(subIntrNum))
-	{
-		subIntrHandlers.erase(subIntrNum);
-	}
+	subIntrHandlers.erase(subIntrNum);
 }
 bool IntrHandler::has(int subIntrNum) const
 {
@@ -185,10 +178,10 @@ void IntrHandler::disable(int subIntrNum)
 }
 SubIntrHandler* IntrHandler::get(int subIntrNum)
 {
-	if (has(subIntrNum))
-		return &subIntrHandlers[subIntrNum];
-	else
-		return NULL;
+	auto iter = subIntrHandlers.find(subIntrNum);
+	if (iter != subIntrHandlers.end())
+		return &iter->second;
+	return NULL;
 }
 void IntrHandler::clear()
 {
@@ -255,8 +248,10 @@ void __InterruptsDoState(PointerWrap &p)
 	}
 
 	intState.DoState(p);
+	// Serializes identically to the old std::list (count + entries), so the
+	// section version stays at 1.
 	PendingInterrupt pi(0, 0);
-	p.Do(pendingInterrupts, pi);
+	p.DoDeque(pendingInterrupts, pi);
 	p.Do(interruptsEnabled);
 	p.Do(inInterrupt);
 	p.Do(threadBeforeInterrupt);
@@ -482,7 +477,7 @@ int __ReleaseSubIntrHandler(int intrNumber, int subIntrNumber) {
 
 	for (auto it = pendingInterrupts.begin(); it != pendingInterrupts.end(); ) {
 		if (it->intr == intrNumber && it->subintr == subIntrNumber) {
-			pendingInterrupts.erase(it++);
+			it = pendingInterrupts.erase(it);
 		} else {
 			++it;
 		}
@@ -108,7 +108,6 @@ public:
 	virtual ~IntrHandler() {}
 
 	virtual bool run(PendingInterrupt& pend);
-	virtual void copyArgsToCPU(PendingInterrupt& pend);
 	virtual void handleResult(PendingInterrupt& pend);
 	void queueUp(int subintr);
 
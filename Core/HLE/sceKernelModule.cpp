@@ -20,6 +20,7 @@
 #include <set>
 
 #include "base/stringutil.h"
+#include "ext/xxhash.h"
 #include "Common/ChunkFile.h"
 #include "Common/FileUtil.h"
 #include "Common/StringUtils.h"
@@ -1060,6 +1061,74 @@ static bool KernelImportModuleFuncs(Module *module, u32 *firstImportStubAddr, bo
 	return true;
 }
 
+// Optional disk cache of decrypted module images, keyed by a hash of the
+// encrypted data, so second boots of encrypted retail titles skip kirk
+// decryption entirely.  Opt-in (CachePrxDecryption in the ini) since it
+// writes decrypted game code to the cache directory.
+struct PrxDecryptedHeader {
+	char magic[4];   // "PRXD"
+	u32_le version;
+	u64_le hash;
+	u32_le inSize;
+	u32_le outSize;
+};
+
+static std::string PrxDecryptedCachePath(u64 hash) {
+	return GetSysDirectory(DIRECTORY_CACHE) + StringFromFormat("%016llx.prxdec", hash);
+}
+
+// Returns the decrypted size on a cache hit, 0 on a miss (or when disabled.)
+// On any return, *hash holds the key to save a fresh decryption under.
+static int LoadCachedPrxDecryption(const u8 *in, u32 inSize, u8 *out, u32 outCapacity, u64 *hash) {
+	*hash = 0;
+	if (!g_Config.bCachePrxDecryption)
+		return 0;
+
+	*hash = XXH64(in, inSize, 0xC0DE2501);
+	FILE *f = File::OpenCFile(PrxDecryptedCachePath(*hash), "rb");
+	if (!f)
+		return 0;
+
+	PrxDecryptedHeader header;
+	bool good = fread(&header, sizeof(header), 1, f) == 1;
+	good = good && memcmp(header.magic, "PRXD", 4) == 0 && header.version == 1;
+	good = good && header.hash == *hash && header.inSize == inSize;
+	good = good && header.outSize > 0 && header.outSize <= outCapacity;
+	if (good)
+		good = fread(out, 1, header.outSize, f) == header.outSize;
+	fclose(f);
+	return good ? (int)header.outSize : 0;
+}
+
+static void SaveCachedPrxDecryption(u64 hash, u32 inSize, const u8 *out, int outSize) {
+	if (!g_Config.bCachePrxDecryption || hash == 0 || outSize <= 0)
+		return;
+
+	const std::string filename = PrxDecryptedCachePath(hash);
+	if (File::Exists(filename))
+		return;
+	File::CreateFullPath(GetSysDirectory(DIRECTORY_CACHE));
+
+	PrxDecryptedHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "PRXD", 4);
+	header.version = 1;
+	header.hash = hash;
+	header.inSize = inSize;
+	header.outSize = (u32)outSize;
+
+	FILE *f = File::OpenCFile(filename, "wb");
+	if (!f)
+		return;
+	bool good = fwrite(&header, sizeof(header), 1, f) == 1;
+	good = good && fwrite(out, 1, outSize, f) == (size_t)outSize;
+	fclose(f);
+	if (!good) {
+		// Don't leave a truncated image behind.
+		File::Delete(filename);
+	}
+}
+
 static Module *__KernelLoadELFFromPtr(const u8 *ptr, size_t elfSize, u32 loadAddress, bool fromTop, std::string *error_string, u32 *magic, u32 &error) {
 	Module *module = new Module;
 	kernelObjects.Create(module);
@@ -1108,7 +1177,16 @@ static Module *__KernelLoadELFFromPtr(const u8 *ptr, size_t elfSize, u32 loadAdd
 		newptr = new u8[std::max(head->elf_size, head->psp_size)];
 		ptr = newptr;
 		magicPtr = (u32_le *)ptr;
-		int ret = pspDecryptPRX(in, (u8*)ptr, head->psp_size);
+		u64 prxHash = 0;
+		int ret = LoadCachedPrxDecryption(in, head->psp_size, (u8*)ptr, std::max(head->elf_size, head->psp_size), &prxHash);
+		if (ret != 0) {
+			DEBUG_LOG(SCEMODULE, "Loaded decrypted module image from cache");
+		} else {
+			ret = pspDecryptPRX(in, (u8*)ptr, head->psp_size);
+			if (ret > 0) {
+				SaveCachedPrxDecryption(prxHash, head->psp_size, (u8*)ptr, ret);
+			}
+		}
 		if (ret == MISSING_KEY) {
 			// This should happen for all "kernel" modules.
 			*error_string = "Missing key";
@@ -208,19 +208,15 @@ struct MsgPipe : public KernelObject
 		SortReceiveThreads();
 
 		bool wokeThreads = false;
-		bool freedSpace = false;
-		while (!receiveWaitingThreads.empty() && GetUsedSize() > 0)
+		u32 bytesRead = 0;
+		while (!receiveWaitingThreads.empty() && GetUsedSize() - bytesRead > 0)
 		{
 			MsgPipeWaitingThread *thread = &receiveWaitingThreads.front();
 			// Receive as much as possible, even if it's not enough to wake up.
-			u32 bytesToSend = std::min(thread->freeSize, GetUsedSize());
+			u32 bytesToSend = std::min(thread->freeSize, GetUsedSize() - bytesRead);
 
-			u8* ptr = Memory::GetPointer(buffer);
-			thread->WriteBuffer(buffer, bytesToSend);
-			// Put the unused data at the start of the buffer.
-			nmp.freeSize += bytesToSend;
-			memmove(ptr, ptr + bytesToSend, GetUsedSize());
-			freedSpace = true;
+			thread->WriteBuffer(buffer + bytesRead, bytesToSend);
+			bytesRead += bytesToSend;
 
 			if (thread->waitMode == SCE_KERNEL_MPW_ASAP || thread->freeSize == 0)
 			{
@@ -234,8 +230,17 @@ struct MsgPipe : public KernelObject
 				break;
 		}
 
-		if (freedSpace)
+		if (bytesRead > 0)
+		{
+			// Put the unused data at the start of the buffer, in one move for all receivers.
+			nmp.freeSize += bytesRead;
+			if (GetUsedSize() > 0)
+			{
+				u8 *ptr = Memory::GetPointer(buffer);
+				memmove(ptr, ptr + bytesRead, GetUsedSize());
+			}
 			wokeThreads |= CheckSendThreads();
+		}
 
 		return wokeThreads;
 	}
@@ -383,9 +388,43 @@ static int __KernelSendMsgPipe(MsgPipe *m, u32 sendBufAddr, u32 sendSize, int wa
 			return SCE_KERNEL_ERROR_ILLEGAL_SIZE;
 		}
 
-		u32 bytesToSend = 0;
 		// If others are already waiting, space or not, we have to get in line.
 		m->SortSendThreads();
+
+		// Fast path: nothing buffered and no other senders in line, so hand the data
+		// directly to any waiting receivers instead of staging it in the pipe buffer
+		// first. Amounts and wake order match going through the buffer (the full send
+		// fits, since we validated against bufSize above), we just copy once, not twice.
+		if (m->sendWaitingThreads.empty() && m->GetUsedSize() == 0 && !m->receiveWaitingThreads.empty())
+		{
+			m->SortReceiveThreads();
+
+			while (!m->receiveWaitingThreads.empty() && sendSize != 0)
+			{
+				MsgPipeWaitingThread *thread = &m->receiveWaitingThreads.front();
+
+				u32 bytesToCopy = std::min(thread->freeSize, sendSize);
+				if (bytesToCopy > 0)
+				{
+					thread->WriteBuffer(curSendAddr, bytesToCopy);
+					sendSize -= bytesToCopy;
+					curSendAddr += bytesToCopy;
+				}
+
+				if (thread->freeSize == 0 || thread->waitMode == SCE_KERNEL_MPW_ASAP)
+				{
+					thread->Complete(uid, 0);
+					m->receiveWaitingThreads.erase(m->receiveWaitingThreads.begin());
+					needsResched = true;
+					thread = NULL;
+				}
+				// Stop at the first that can't wake up.
+				else
+					break;
+			}
+		}
+
+		u32 bytesToSend = 0;
 		if (m->sendWaitingThreads.empty())
 		{
 			if (sendSize <= (u32) m->nmp.freeSize)
@@ -396,7 +435,9 @@ static int __KernelSendMsgPipe(MsgPipe *m, u32 sendBufAddr, u32 sendSize, int wa
 
 		if (bytesToSend != 0)
 		{
-			Memory::Memcpy(m->buffer + (m->nmp.bufSize - m->nmp.freeSize), sendBufAddr, bytesToSend);
+			// From curSendAddr, not sendBufAddr - the direct-to-receiver path above
+			// may already have delivered the head of the send.
+			Memory::Memcpy(m->buffer + (m->nmp.bufSize - m->nmp.freeSize), curSendAddr, bytesToSend);
 			m->nmp.freeSize -= bytesToSend;
 			curSendAddr += bytesToSend;
 			sendSize -= bytesToSend;
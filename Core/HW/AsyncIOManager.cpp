@@ -17,7 +17,9 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <thread>
 
+#include "thread/threadutil.h"
 #include "Common/ChunkFile.h"
 #include "Core/MIPS/MIPS.h"
 #include "Core/Reporting.h"
@@ -41,14 +43,19 @@ void AsyncIOManager::ScheduleOperation(AsyncIOEvent ev) {
 		if (!resultsPending_.insert(ev.handle).second) {
 			ERROR_LOG_REPORT(SCEIO, "Scheduling operation for file %d while one is pending (type %d)", ev.handle, ev.type);
 		}
+		if (ev.type == IO_EVENT_WRITE_BEHIND) {
+			writeBehind_.insert(ev.handle);
+		}
 	}
 	ScheduleEvent(ev);
 }
 
 void AsyncIOManager::Shutdown() {
+	StopWorkers();
 	std::lock_guard<std::mutex> guard(resultsLock_);
 	resultsPending_.clear();
 	results_.clear();
+	writeBehind_.clear();
 }
 
 bool AsyncIOManager::HasResult(u32 handle) {
@@ -83,7 +90,8 @@ bool AsyncIOManager::ReadResult(u32 handle, AsyncIOResult &result) {
 bool AsyncIOManager::WaitResult(u32 handle, AsyncIOResult &result) {
 	std::unique_lock<std::mutex> guard(resultsLock_);
 	ScheduleEvent(IO_EVENT_SYNC);
-	while (HasEvents() && ThreadEnabled() && resultsPending_.find(handle) != resultsPending_.end()) {
+	// Workers may still be busy even after the event queue has drained.
+	while (((HasEvents() && ThreadEnabled()) || WorkersBusy()) && resultsPending_.find(handle) != resultsPending_.end()) {
 		if (PopResult(handle, result)) {
 			return true;
 		}
@@ -92,12 +100,23 @@ bool AsyncIOManager::WaitResult(u32 handle, AsyncIOResult &result) {
 	return PopResult(handle, result);
 }
 
+void AsyncIOManager::WaitWriteBehind(u32 handle) {
+	std::unique_lock<std::mutex> guard(resultsLock_);
+	if (writeBehind_.find(handle) == writeBehind_.end()) {
+		return;
+	}
+	ScheduleEvent(IO_EVENT_SYNC);
+	while (((HasEvents() && ThreadEnabled()) || WorkersBusy()) && writeBehind_.find(handle) != writeBehind_.end()) {
+		resultsWait_.wait_for(guard, std::chrono::milliseconds(16));
+	}
+}
+
 u64 AsyncIOManager::ResultFinishTicks(u32 handle) {
 	AsyncIOResult result;
 
 	std::unique_lock<std::mutex> guard(resultsLock_);
 	ScheduleEvent(IO_EVENT_SYNC);
-	while (HasEvents() && ThreadEnabled() && resultsPending_.find(handle) != resultsPending_.end()) {
+	while (((HasEvents() && ThreadEnabled()) || WorkersBusy()) && resultsPending_.find(handle) != resultsPending_.end()) {
 		if (ReadResult(handle, result)) {
 			return result.finishTicks;
 		}
@@ -113,11 +132,11 @@ u64 AsyncIOManager::ResultFinishTicks(u32 handle) {
 void AsyncIOManager::ProcessEvent(AsyncIOEvent ev) {
 	switch (ev.type) {
 	case IO_EVENT_READ:
-		Read(ev.handle, ev.buf, ev.bytes, ev.invalidateAddr);
-		break;
-
 	case IO_EVENT_WRITE:
-		Write(ev.handle, ev.buf, ev.bytes);
+	case IO_EVENT_WRITE_BEHIND:
+		// Hand the blocking call off to the pool so that operations on separate
+		// handles can actually overlap.
+		DispatchOperation(ev);
 		break;
 
 	default:
@@ -125,6 +144,74 @@ void AsyncIOManager::ProcessEvent(AsyncIOEvent ev) {
 	}
 }
 
+void AsyncIOManager::DispatchOperation(const AsyncIOEvent &ev) {
+	std::lock_guard<std::mutex> guard(workLock_);
+	if (workers_.empty()) {
+		workersExit_ = false;
+		for (int i = 0; i < 2; ++i) {
+			workers_.push_back(std::thread(&AsyncIOManager::WorkerFunc, this));
+		}
+	}
+	work_.push_back(ev);
+	workWake_.notify_one();
+}
+
+void AsyncIOManager::WorkerFunc() {
+	setCurrentThreadName("AsyncIO");
+
+	std::unique_lock<std::mutex> guard(workLock_);
+	while (!workersExit_) {
+		if (work_.empty()) {
+			workWake_.wait(guard);
+			continue;
+		}
+		AsyncIOEvent ev = work_.front();
+		work_.pop_front();
+		++workBusy_;
+		guard.unlock();
+
+		if (ev.type == IO_EVENT_READ) {
+			Read(ev.handle, ev.buf, ev.bytes, ev.invalidateAddr);
+		} else if (ev.type == IO_EVENT_WRITE_BEHIND) {
+			WriteBehind(ev.handle, ev.buf, ev.bytes);
+		} else {
+			Write(ev.handle, ev.buf, ev.bytes);
+		}
+
+		guard.lock();
+		--workBusy_;
+		workDone_.notify_all();
+	}
+}
+
+bool AsyncIOManager::WorkersBusy() {
+	std::lock_guard<std::mutex> guard(workLock_);
+	return !work_.empty() || workBusy_ != 0;
+}
+
+void AsyncIOManager::SyncWorkers() {
+	std::unique_lock<std::mutex> guard(workLock_);
+	while (!work_.empty() || workBusy_ != 0) {
+		workDone_.wait(guard);
+	}
+}
+
+void AsyncIOManager::StopWorkers() {
+	std::vector<std::thread> waiting;
+	{
+		std::unique_lock<std::mutex> guard(workLock_);
+		while (!work_.empty() || workBusy_ != 0) {
+			workDone_.wait(guard);
+		}
+		workersExit_ = true;
+		workWake_.notify_all();
+		waiting.swap(workers_);
+	}
+	for (size_t i = 0; i < waiting.size(); ++i) {
+		waiting[i].join();
+	}
+}
+
 void AsyncIOManager::Read(u32 handle, u8 *buf, size_t bytes, u32 invalidateAddr) {
 	int usec = 0;
 	s64 result = pspFileSystem.ReadFile(handle, buf, bytes, usec);
@@ -137,6 +224,19 @@ void AsyncIOManager::Write(u32 handle, u8 *buf, size_t bytes) {
 	EventResult(handle, AsyncIOResult(result, usec));
 }
 
+void AsyncIOManager::WriteBehind(u32 handle, u8 *buf, size_t bytes) {
+	int usec = 0;
+	s64 result = pspFileSystem.WriteFile(handle, buf, bytes, usec);
+	if (result != (s64)bytes) {
+		// The game was already told the write succeeded in full - the free
+		// space check before scheduling said this would fit. All we can do now
+		// is complain.
+		ERROR_LOG_REPORT(SCEIO, "Write-behind on %d wrote only %lld of %lld bytes", handle, (long long)result, (long long)bytes);
+	}
+	delete [] buf;
+	EventComplete(handle);
+}
+
 void AsyncIOManager::EventResult(u32 handle, AsyncIOResult result) {
 	std::lock_guard<std::mutex> guard(resultsLock_);
 	if (results_.find(handle) != results_.end()) {
@@ -146,12 +246,21 @@ void AsyncIOManager::EventResult(u32 handle, AsyncIOResult result) {
 	resultsWait_.notify_one();
 }
 
+// Like EventResult, for operations that don't deliver one (write-behind.)
+void AsyncIOManager::EventComplete(u32 handle) {
+	std::lock_guard<std::mutex> guard(resultsLock_);
+	resultsPending_.erase(handle);
+	writeBehind_.erase(handle);
+	resultsWait_.notify_one();
+}
+
 void AsyncIOManager::DoState(PointerWrap &p) {
 	auto s = p.Section("AsyncIoManager", 1, 2);
 	if (!s)
 		return;
 
 	SyncThread();
+	SyncWorkers();
 	std::lock_guard<std::mutex> guard(resultsLock_);
 	p.Do(resultsPending_);
 	if (s >= 2) {
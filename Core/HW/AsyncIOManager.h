@@ -15,9 +15,13 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <set>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Core/ThreadEventQueue.h"
 
@@ -30,6 +34,9 @@ enum AsyncIOEventType {
 	IO_EVENT_FINISH,
 	IO_EVENT_READ,
 	IO_EVENT_WRITE,
+	// Like IO_EVENT_WRITE, but the caller already reported success to the
+	// game and no result is delivered. Owns buf (heap copy of the data.)
+	IO_EVENT_WRITE_BEHIND,
 };
 
 struct AsyncIOEvent {
@@ -78,6 +85,9 @@ struct AsyncIOResult {
 typedef ThreadEventQueue<NoBase, AsyncIOEvent, AsyncIOEventType, IO_EVENT_INVALID, IO_EVENT_SYNC, IO_EVENT_FINISH> IOThreadEventQueue;
 class AsyncIOManager : public IOThreadEventQueue {
 public:
+	AsyncIOManager() : workBusy_(0), workersExit_(false) {
+	}
+
 	void DoState(PointerWrap &p);
 
 	bool HasOperation(u32 handle);
@@ -88,6 +98,12 @@ public:
 	bool WaitResult(u32 handle, AsyncIOResult &result);
 	u64 ResultFinishTicks(u32 handle);
 
+	// Waits for any write-behind on the handle to reach host storage. Must be
+	// called before any other operation (read, seek, close...) touches the
+	// handle, since the game already thinks the write completed. Cheap when
+	// nothing is pending.
+	void WaitWriteBehind(u32 handle);
+
 protected:
 	void ProcessEvent(AsyncIOEvent ref) override;
 	bool ShouldExitEventLoop() override {
@@ -99,11 +115,32 @@ private:
 	bool ReadResult(u32 handle, AsyncIOResult &result);
 	void Read(u32 handle, u8 *buf, size_t bytes, u32 invalidateAddr);
 	void Write(u32 handle, u8 *buf, size_t bytes);
+	void WriteBehind(u32 handle, u8 *buf, size_t bytes);
 
 	void EventResult(u32 handle, AsyncIOResult result);
+	void EventComplete(u32 handle);
+
+	// Operations on different handles run concurrently on a small worker pool.
+	// Only one operation can be pending per handle (see ScheduleOperation), so
+	// per-handle ordering comes for free.
+	void DispatchOperation(const AsyncIOEvent &ev);
+	void WorkerFunc();
+	bool WorkersBusy();
+	void SyncWorkers();
+	void StopWorkers();
 
 	std::mutex resultsLock_;
 	std::condition_variable resultsWait_;
 	std::set<u32> resultsPending_;
 	std::map<u32, AsyncIOResult> results_;
+	// Handles with a write-behind in flight (subset of resultsPending_.)
+	std::set<u32> writeBehind_;
+
+	std::vector<std::thread> workers_;
+	std::mutex workLock_;
+	std::condition_variable workWake_;
+	std::condition_variable workDone_;
+	std::deque<AsyncIOEvent> work_;
+	int workBusy_;
+	bool workersExit_;
 };
\ No newline at end of file
@@ -108,6 +108,32 @@ struct BufferQueue {
 		return bytesgot;
 	}
 
+	// Peek without copying. Returns the number of bytes visible (up to wantedsize),
+	// split over at most two spans when the data wraps around the end of the buffer.
+	// The spans stay valid until the next push or alloc.
+	int get_front_spans(const unsigned char **buf1, int *size1, const unsigned char **buf2, int *size2, int wantedsize) {
+		*buf1 = NULL;
+		*buf2 = NULL;
+		*size1 = 0;
+		*size2 = 0;
+		if (wantedsize <= 0)
+			return 0;
+		int bytesgot = getQueueSize();
+		if (wantedsize < bytesgot)
+			bytesgot = wantedsize;
+		if (bytesgot == 0)
+			return 0;
+		*buf1 = bufQueue + start;
+		if (start + bytesgot <= bufQueueSize) {
+			*size1 = bytesgot;
+		} else {
+			*size1 = bufQueueSize - start;
+			*buf2 = bufQueue;
+			*size2 = bytesgot - *size1;
+		}
+		return bytesgot;
+	}
+
 	int get_front(unsigned char *buf, int wantedsize) {
 		if (wantedsize <= 0)
 			return 0;
@@ -15,6 +15,9 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include "ppsspp_config.h"
+
+#include "Common/Common.h"
 #include "Core/Config.h"
 #include "Core/Debugger/Breakpoints.h"
 #include "Core/HW/MediaEngine.h"
@@ -26,8 +29,21 @@
 #include "GPU/GPUInterface.h"
 #include "Core/HW/SimpleAudioDec.h"
 
+#include "thread/threadutil.h"
+
 #include <algorithm>
 
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+#if PPSSPP_ARCH(ARM_NEON)
+#if defined(_MSC_VER) && PPSSPP_ARCH(ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
 #ifdef USE_FFMPEG
 
 extern "C" {
@@ -149,6 +165,18 @@ MediaEngine::MediaEngine(): m_pdata(0) {
 	m_mpegheaderReadPos = 0;
 	m_mpegheaderSize = sizeof(m_mpegheader);
 	m_audioType = PSP_CODEC_AT3PLUS; // in movie, we use only AT3+ audio
+
+	m_threadRunning = false;
+	m_threadExit = false;
+	m_threadWork = false;
+#ifdef USE_FFMPEG
+	m_pFrameAhead = 0;
+	m_pFrameRGBAhead = 0;
+#endif
+	m_bufferAhead = 0;
+	m_aheadPixelMode = 0;
+	m_aheadValid = false;
+	m_aheadPts = 0;
 }
 
 MediaEngine::~MediaEngine() {
@@ -168,6 +196,10 @@ void MediaEngine::closeMedia() {
 }
 
 void MediaEngine::DoState(PointerWrap &p) {
+	// The worker reads from m_pdata, so make sure it's idle.
+	SyncThread();
+	m_aheadValid = false;
+
 	auto s = p.Section("MediaEngine", 1, 5);
 	if (!s)
 		return;
@@ -340,13 +372,20 @@ bool MediaEngine::openContext(bool keepReadPos) {
 
 void MediaEngine::closeContext()
 {
+	StopThread();
 #ifdef USE_FFMPEG
 	if (m_buffer)
 		av_free(m_buffer);
+	if (m_bufferAhead)
+		av_free(m_bufferAhead);
 	if (m_pFrameRGB)
 		av_frame_free(&m_pFrameRGB);
+	if (m_pFrameRGBAhead)
+		av_frame_free(&m_pFrameRGBAhead);
 	if (m_pFrame)
 		av_frame_free(&m_pFrame);
+	if (m_pFrameAhead)
+		av_frame_free(&m_pFrameAhead);
 	if (m_pIOContext && m_pIOContext->buffer)
 		av_free(m_pIOContext->buffer);
 	if (m_pIOContext)
@@ -361,6 +400,8 @@ void MediaEngine::closeContext()
 	m_pIOContext = 0;
 #endif
 	m_buffer = 0;
+	m_bufferAhead = 0;
+	m_aheadValid = false;
 }
 
 bool MediaEngine::loadStream(const u8 *buffer, int readSize, int RingbufferSize)
@@ -386,6 +427,7 @@ bool MediaEngine::reloadStream()
 }
 
 int MediaEngine::addStreamData(const u8 *buffer, int addSize) {
+	SyncThread();
 	int size = addSize;
 	if (size > 0 && m_pdata) {
 		if (!m_pdata->push(buffer, size)) 
@@ -447,6 +489,7 @@ bool MediaEngine::setVideoStream(int streamNum, bool force) {
 		// Yay, nothing to do.
 		return true;
 	}
+	SyncThread();
 
 #ifdef USE_FFMPEG
 	if (m_pFormatCtx && m_pCodecCtxs.find(streamNum) == m_pCodecCtxs.end()) {
@@ -489,7 +532,17 @@ bool MediaEngine::setVideoStream(int streamNum, bool force) {
 
 bool MediaEngine::setVideoDim(int width, int height)
 {
+	SyncThread();
+	m_aheadValid = false;
 #ifdef USE_FFMPEG
+	// The ahead buffers are sized for the old dimensions.
+	if (m_pFrameRGBAhead)
+		av_frame_free(&m_pFrameRGBAhead);
+	if (m_bufferAhead) {
+		av_free(m_bufferAhead);
+		m_bufferAhead = 0;
+	}
+
 	auto codecIter = m_pCodecCtxs.find(m_videoStream);
 	if (codecIter == m_pCodecCtxs.end())
 		return false;
@@ -579,17 +632,12 @@ void MediaEngine::updateSwsFormat(int videoPixelMode) {
 #endif
 }
 
-bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 #ifdef USE_FFMPEG
+bool MediaEngine::decodeVideoFrame(AVFrame *frame, AVFrame *frameRGB, int videoPixelMode, bool convert, s64 &pts, bool &videoEnd) {
 	auto codecIter = m_pCodecCtxs.find(m_videoStream);
 	AVCodecContext *m_pCodecCtx = codecIter == m_pCodecCtxs.end() ? 0 : codecIter->second;
-
-	if (!m_pFormatCtx)
-		return false;
 	if (!m_pCodecCtx)
 		return false;
-	if (!m_pFrame)
-		return false;
 
 	AVPacket packet;
 	av_init_packet(&packet);
@@ -609,32 +657,34 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 				av_free_packet(&packet);
 #endif
 
-			int result = avcodec_decode_video2(m_pCodecCtx, m_pFrame, &frameFinished, &packet);
+			int result = avcodec_decode_video2(m_pCodecCtx, frame, &frameFinished, &packet);
 			if (frameFinished) {
 				if (!m_pFrameRGB) {
 					setVideoDim();
+					if (frameRGB == nullptr)
+						frameRGB = m_pFrameRGB;
 				}
-				if (m_pFrameRGB && !skipFrame) {
+				if (frameRGB && convert) {
 					updateSwsFormat(videoPixelMode);
 					// TODO: Technically we could set this to frameWidth instead of m_desWidth for better perf.
 					// Update the linesize for the new format too.  We started with the largest size, so it should fit.
-					m_pFrameRGB->linesize[0] = getPixelFormatBytes(videoPixelMode) * m_desWidth;
+					frameRGB->linesize[0] = getPixelFormatBytes(videoPixelMode) * m_desWidth;
 
-					sws_scale(m_sws_ctx, m_pFrame->data, m_pFrame->linesize, 0,
-						m_pCodecCtx->height, m_pFrameRGB->data, m_pFrameRGB->linesize);
+					sws_scale(m_sws_ctx, frame->data, frame->linesize, 0,
+						m_pCodecCtx->height, frameRGB->data, frameRGB->linesize);
 				}
 
-				if (av_frame_get_best_effort_timestamp(m_pFrame) != AV_NOPTS_VALUE)
-					m_videopts = av_frame_get_best_effort_timestamp(m_pFrame) + av_frame_get_pkt_duration(m_pFrame) - m_firstTimeStamp;
+				if (av_frame_get_best_effort_timestamp(frame) != AV_NOPTS_VALUE)
+					pts = av_frame_get_best_effort_timestamp(frame) + av_frame_get_pkt_duration(frame) - m_firstTimeStamp;
 				else
-					m_videopts += av_frame_get_pkt_duration(m_pFrame);
+					pts += av_frame_get_pkt_duration(frame);
 				bGetFrame = true;
 			}
 			if (result <= 0 && dataEnd) {
 				// Sometimes, m_readSize is less than m_streamSize at the end, but not by much.
 				// This is kinda a hack, but the ringbuffer would have to be prematurely empty too.
-				m_isVideoEnd = !bGetFrame && (m_pdata->getQueueSize() == 0);
-				if (m_isVideoEnd)
+				videoEnd = !bGetFrame && (m_pdata->getQueueSize() == 0);
+				if (videoEnd)
 					m_decodingsize = 0;
 				break;
 			}
@@ -646,6 +696,139 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 #endif
 	}
 	return bGetFrame;
+}
+#endif // USE_FFMPEG
+
+void MediaEngine::DecodeAheadFunc() {
+	setCurrentThreadName("MediaDecode");
+	std::unique_lock<std::mutex> guard(m_threadLock);
+	while (!m_threadExit) {
+		if (!m_threadWork) {
+			m_threadWake.wait(guard);
+			continue;
+		}
+		guard.unlock();
+#ifdef USE_FFMPEG
+		s64 pts = m_videopts;
+		bool videoEnd = false;
+		bool bGetFrame = decodeVideoFrame(m_pFrameAhead, m_pFrameRGBAhead, m_aheadPixelMode, true, pts, videoEnd);
+		guard.lock();
+		// A no-frame result is simply dropped - stepVideo() retries synchronously, by
+		// which time the game may have added the data we were missing.
+		m_aheadValid = bGetFrame;
+		m_aheadPts = pts;
+#else
+		guard.lock();
+#endif
+		m_threadWork = false;
+		m_threadDone.notify_all();
+	}
+}
+
+void MediaEngine::SyncThread() {
+	if (!m_threadRunning)
+		return;
+	std::unique_lock<std::mutex> guard(m_threadLock);
+	while (m_threadWork)
+		m_threadDone.wait(guard);
+}
+
+void MediaEngine::StopThread() {
+	if (!m_threadRunning)
+		return;
+	{
+		std::unique_lock<std::mutex> guard(m_threadLock);
+		m_threadExit = true;
+		m_threadWake.notify_one();
+	}
+	m_thread.join();
+	m_threadRunning = false;
+	m_threadExit = false;
+	m_threadWork = false;
+	m_aheadValid = false;
+}
+
+void MediaEngine::KickDecodeAhead(int videoPixelMode) {
+#ifdef USE_FFMPEG
+	if (!m_pFormatCtx || !m_pFrame || !m_pFrameRGB || !m_sws_ctx || !m_pdata)
+		return;
+	if (m_pCodecCtxs.find(m_videoStream) == m_pCodecCtxs.end())
+		return;
+	// Don't race ahead of the game's ringbuffer writes - only prefetch when there's
+	// already a good amount of data buffered past the current position.
+	if (m_pdata->getQueueSize() < 0x8000)
+		return;
+
+	if (!m_pFrameAhead)
+		m_pFrameAhead = av_frame_alloc();
+	if (!m_pFrameRGBAhead) {
+		m_pFrameRGBAhead = av_frame_alloc();
+		// Allocate at the largest (32-bit) size, same as setVideoDim() does.
+		AVPixelFormat fmt = getSwsFormat(GE_CMODE_32BIT_ABGR8888);
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 12, 100)
+		int numBytes = av_image_get_buffer_size(fmt, m_desWidth, m_desHeight, 1);
+#else
+		int numBytes = avpicture_get_size(fmt, m_desWidth, m_desHeight);
+#endif
+		m_bufferAhead = (u8 *)av_malloc(numBytes * sizeof(uint8_t));
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 12, 100)
+		av_image_fill_arrays(m_pFrameRGBAhead->data, m_pFrameRGBAhead->linesize, m_bufferAhead, fmt, m_desWidth, m_desHeight, 1);
+#else
+		avpicture_fill((AVPicture *)m_pFrameRGBAhead, m_bufferAhead, fmt, m_desWidth, m_desHeight);
+#endif
+	}
+
+	std::unique_lock<std::mutex> guard(m_threadLock);
+	if (!m_threadRunning) {
+		m_thread = std::thread(&MediaEngine::DecodeAheadFunc, this);
+		m_threadRunning = true;
+	}
+	m_aheadPixelMode = videoPixelMode;
+	m_aheadValid = false;
+	m_threadWork = true;
+	m_threadWake.notify_one();
+#endif // USE_FFMPEG
+}
+
+bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
+#ifdef USE_FFMPEG
+	SyncThread();
+
+	if (!m_pFormatCtx)
+		return false;
+	if (!m_pFrame)
+		return false;
+
+	bool bGetFrame = false;
+	if (m_aheadValid) {
+		// The worker already decoded (and converted) the next frame - deliver it.
+		m_aheadValid = false;
+		if (!skipFrame) {
+			if (m_aheadPixelMode == videoPixelMode) {
+				std::swap(m_pFrameRGB, m_pFrameRGBAhead);
+				std::swap(m_buffer, m_bufferAhead);
+			} else if (m_pFrameRGB) {
+				// The pixel mode changed between frames - redo just the conversion.
+				auto codecIter = m_pCodecCtxs.find(m_videoStream);
+				if (codecIter != m_pCodecCtxs.end()) {
+					updateSwsFormat(videoPixelMode);
+					m_pFrameRGB->linesize[0] = getPixelFormatBytes(videoPixelMode) * m_desWidth;
+					sws_scale(m_sws_ctx, m_pFrameAhead->data, m_pFrameAhead->linesize, 0,
+						codecIter->second->height, m_pFrameRGB->data, m_pFrameRGB->linesize);
+				}
+			}
+		}
+		m_videopts = m_aheadPts;
+		bGetFrame = true;
+	} else {
+		bGetFrame = decodeVideoFrame(m_pFrame, m_pFrameRGB, videoPixelMode, !skipFrame, m_videopts, m_isVideoEnd);
+	}
+
+	if (bGetFrame && !skipFrame && !m_isVideoEnd) {
+		// Get a head start on the next frame while the game does other work.
+		KickDecodeAhead(videoPixelMode);
+	}
+	return bGetFrame;
 #else
 	// If video engine is not available, just add to the timestamp at least.
 	m_videopts += 3003;
@@ -656,12 +839,26 @@ bool MediaEngine::stepVideo(int videoPixelMode, bool skipFrame) {
 // Helpers that null out alpha (which seems to be the case on the PSP.)
 // Some games depend on this, for example Sword Art Online (doesn't clear A's from buffer.)
 inline void writeVideoLineRGBA(void *destp, const void *srcp, int width) {
-	// TODO: Use SSE/NEON, investigate why AV_PIX_FMT_RGB0 does not work.
+	// TODO: Investigate why AV_PIX_FMT_RGB0 does not work.
 	u32_le *dest = (u32_le *)destp;
 	const u32_le *src = (u32_le *)srcp;
 
 	const u32 mask = 0x00FFFFFF;
-	for (int i = 0; i < width; ++i) {
+	int i = 0;
+#ifdef _M_SSE
+	const __m128i mask4 = _mm_set1_epi32(mask);
+	for (; i + 4 <= width; i += 4) {
+		__m128i c = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_and_si128(c, mask4));
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	const uint32x4_t mask4 = vdupq_n_u32(mask);
+	for (; i + 4 <= width; i += 4) {
+		uint32x4_t c = vld1q_u32((const u32 *)&src[i]);
+		vst1q_u32((u32 *)&dest[i], vandq_u32(c, mask4));
+	}
+#endif
+	for (; i < width; ++i) {
 		dest[i] = src[i] & mask;
 	}
 }
@@ -670,26 +867,35 @@ inline void writeVideoLineABGR5650(void *destp, const void *srcp, int width) {
 	memcpy(destp, srcp, width * sizeof(u16));
 }
 
-inline void writeVideoLineABGR5551(void *destp, const void *srcp, int width) {
-	// TODO: Use SSE/NEON.
+inline void writeVideoLineMasked16(void *destp, const void *srcp, int width, u16 mask) {
 	u16_le *dest = (u16_le *)destp;
 	const u16_le *src = (u16_le *)srcp;
 
-	const u16 mask = 0x7FFF;
-	for (int i = 0; i < width; ++i) {
+	int i = 0;
+#ifdef _M_SSE
+	const __m128i mask8 = _mm_set1_epi16(mask);
+	for (; i + 8 <= width; i += 8) {
+		__m128i c = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_and_si128(c, mask8));
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	const uint16x8_t mask8 = vdupq_n_u16(mask);
+	for (; i + 8 <= width; i += 8) {
+		uint16x8_t c = vld1q_u16((const u16 *)&src[i]);
+		vst1q_u16((u16 *)&dest[i], vandq_u16(c, mask8));
+	}
+#endif
+	for (; i < width; ++i) {
 		dest[i] = src[i] & mask;
 	}
 }
 
-inline void writeVideoLineABGR4444(void *destp, const void *srcp, int width) {
-	// TODO: Use SSE/NEON.
-	u16_le *dest = (u16_le *)destp;
-	const u16_le *src = (u16_le *)srcp;
+inline void writeVideoLineABGR5551(void *destp, const void *srcp, int width) {
+	writeVideoLineMasked16(destp, srcp, width, 0x7FFF);
+}
 
-	const u16 mask = 0x0FFF;
-	for (int i = 0; i < width; ++i) {
-		dest[i] = src[i] & mask;
-	}
+inline void writeVideoLineABGR4444(void *destp, const void *srcp, int width) {
+	writeVideoLineMasked16(destp, srcp, width, 0x0FFF);
 }
 
 int MediaEngine::writeVideoImage(u32 bufferPtr, int frameWidth, int videoPixelMode) {
@@ -895,6 +1101,8 @@ u8 *MediaEngine::getFrameImage() {
 }
 
 int MediaEngine::getRemainSize() {
+	// The worker consumes from m_pdata as it reads packets.
+	SyncThread();
 	if (!m_pdata)
 		return 0;
 	return std::max(m_pdata->getRemainSize() - m_decodingsize - 2048, 0);
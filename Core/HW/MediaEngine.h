@@ -24,7 +24,11 @@
 
 // An approximation of what the interface will look like. Similar to JPCSP's.
 
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <thread>
+
 #include "Common/CommonTypes.h"
 #include "Core/HLE/sceMpeg.h"
 #include "Core/HW/MpegDemux.h"
@@ -98,6 +102,15 @@ private:
 	void updateSwsFormat(int videoPixelMode);
 	int getNextAudioFrame(u8 **buf, int *headerCode1, int *headerCode2);
 
+	// Decode-ahead worker (see MediaEngine.cpp.)
+	void SyncThread();
+	void StopThread();
+	void KickDecodeAhead(int videoPixelMode);
+	void DecodeAheadFunc();
+#ifdef USE_FFMPEG
+	bool decodeVideoFrame(AVFrame *frame, AVFrame *frameRGB, int videoPixelMode, bool convert, s64 &pts, bool &videoEnd);
+#endif
+
 public:  // TODO: Very little of this below should be public.
 
 	// Video ffmpeg context - not used for audio
@@ -138,6 +151,26 @@ public:  // TODO: Very little of this below should be public.
 	int m_mpegheaderReadPos;
 	int m_mpegheaderSize;
 
-	// used for audio type 
+	// used for audio type
 	int m_audioType;
+
+private:
+	// Decode-ahead state. The worker decodes and converts the next frame into the
+	// "ahead" buffers while the game does other work; stepVideo() then just swaps
+	// them in. Transient - none of this is saved.
+	std::thread m_thread;
+	std::mutex m_threadLock;
+	std::condition_variable m_threadWake;
+	std::condition_variable m_threadDone;
+	bool m_threadRunning;
+	bool m_threadExit;
+	bool m_threadWork;
+#ifdef USE_FFMPEG
+	AVFrame *m_pFrameAhead;
+	AVFrame *m_pFrameRGBAhead;
+#endif
+	u8 *m_bufferAhead;
+	int m_aheadPixelMode;
+	bool m_aheadValid;
+	s64 m_aheadPts;
 };
@@ -286,23 +286,39 @@ bool MpegDemux::demux(int audioChannel)
 	return looksValid;
 }
 
-static bool isHeader(u8* audioStream, int offset)
+static bool isHeader(const u8* audioStream, int offset)
 {
 	const u8 header1 = (u8)0x0F;
 	const u8 header2 = (u8)0xD0;
 	return (audioStream[offset] == header1) && (audioStream[offset+1] == header2);
 }
 
-static int getNextHeaderPosition(u8* audioStream, int curpos, int limit, int frameSize)
+// Reads bytes from the (up to) two spans of a wrapped BufferQueue peek,
+// so headers can be scanned for without copying the queue contents out.
+struct SpanReader {
+	const u8 *buf1;
+	int size1;
+	const u8 *buf2;
+	int size2;
+
+	inline u8 at(int offset) const {
+		return offset < size1 ? buf1[offset] : buf2[offset - size1];
+	}
+	inline bool isHeaderAt(int offset) const {
+		return at(offset) == (u8)0x0F && at(offset + 1) == (u8)0xD0;
+	}
+};
+
+static int getNextHeaderPosition(const SpanReader &audioStream, int curpos, int limit, int frameSize)
 {
 	int endScan = limit - 1;
 
 	// Most common case: the header can be found at each frameSize
 	int offset = curpos + frameSize - 8;
-	if (offset < endScan && isHeader(audioStream, offset))
+	if (offset < endScan && audioStream.isHeaderAt(offset))
 		return offset;
 	for (int scan = curpos; scan < endScan; scan++) {
-		if (isHeader(audioStream, scan))
+		if (audioStream.isHeaderAt(scan))
 			return scan;
 	}
 
@@ -315,28 +331,35 @@ int MpegDemux::getNextAudioFrame(u8 **buf, int *headerCode1, int *headerCode2, s
 	int frameSize;
 	if (!hasNextAudioFrame(&gotsize, &frameSize, headerCode1, headerCode2))
 		return 0;
+	SpanReader spans;
+	m_audioStream.get_front_spans(&spans.buf1, &spans.size1, &spans.buf2, &spans.size2, 0x2000);
 	int audioPos = 8;
-	int nextHeader = getNextHeaderPosition(m_audioFrame, audioPos, gotsize, frameSize);
+	int nextHeader = getNextHeaderPosition(spans, audioPos, gotsize, frameSize);
 	if (nextHeader >= 0) {
 		audioPos = nextHeader;
 	} else {
 		audioPos = gotsize;
 	}
-	m_audioStream.pop_front(0, audioPos, pts);
 	if (buf) {
+		// Only the frame itself has to be contiguous for the caller.
+		m_audioStream.get_front(m_audioFrame, frameSize);
 		*buf = m_audioFrame + 8;
 	}
+	m_audioStream.pop_front(0, audioPos, pts);
 	return frameSize - 8;
 }
 
 bool MpegDemux::hasNextAudioFrame(int *gotsizeOut, int *frameSizeOut, int *headerCode1, int *headerCode2)
 {
-	int gotsize = m_audioStream.get_front(m_audioFrame, 0x2000);
-	if (gotsize < 4 || !isHeader(m_audioFrame, 0))
+	u8 header[4];
+	if (m_audioStream.get_front(header, 4) < 4 || !isHeader(header, 0))
 		return false;
-	u8 code1 = m_audioFrame[2];
-	u8 code2 = m_audioFrame[3];
+	u8 code1 = header[2];
+	u8 code2 = header[3];
 	int frameSize = (((code1 & 0x03) << 8) | (code2 * 8)) + 0x10;
+	int gotsize = m_audioStream.getQueueSize();
+	if (gotsize > 0x2000)
+		gotsize = 0x2000;
 	if (frameSize > gotsize)
 		return false;
 
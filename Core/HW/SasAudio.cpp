@@ -17,6 +17,8 @@
 
 #include <algorithm>
 
+#include "ppsspp_config.h"
+
 #include "base/basictypes.h"
 #include "profiler/profiler.h"
 
@@ -25,8 +27,20 @@
 #include "Core/Config.h"
 #include "Core/Reporting.h"
 #include "Core/Util/AudioFormat.h"
+#include "ext/xxhash.h"
 #include "SasAudio.h"
 
+#ifdef _M_SSE
+#include <emmintrin.h>
+#endif
+#if PPSSPP_ARCH(ARM_NEON)
+#if defined(_MSC_VER) && PPSSPP_ARCH(ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
 // #define AUDIO_TO_FILE
 
 static const u8 f[16][2] = {
@@ -50,6 +64,9 @@ static const u8 f[16][2] = {
 	{   0, 151 },
 };
 
+// Cap on how much decoded loop PCM a single voice may retain.
+static const int LOOP_CACHE_MAX_BYTES = 128 * 1024;
+
 void VagDecoder::Start(u32 data, u32 vagSize, bool loopEnabled) {
 	loopEnabled_ = loopEnabled;
 	loopAtNextBlock_ = false;
@@ -62,6 +79,18 @@ void VagDecoder::Start(u32 data, u32 vagSize, bool loopEnabled) {
 	curBlock_ = -1;
 	s_1 = 0;	// per block?
 	s_2 = 0;
+	InvalidateLoopCache();
+}
+
+void VagDecoder::InvalidateLoopCache() {
+	loopRecording_ = false;
+	loopCachePos_ = -1;
+	loopCacheBlocks_ = 0;
+	loopCachePcm_.clear();
+}
+
+u32 VagDecoder::HashLoopSource() const {
+	return XXH32(Memory::GetPointerUnchecked(loopCacheAddr_), loopCacheBlocks_ * 16, 0x53415356);
 }
 
 void VagDecoder::DecodeBlock(u8 *&read_pointer) {
@@ -120,32 +149,80 @@ void VagDecoder::GetSamples(s16 *outSamples, int numSamples) {
 		memset(outSamples, 0, numSamples * sizeof(s16));
 		return;
 	}
-	if (!Memory::IsValidAddress(read_)) {
-		WARN_LOG(SASMIX, "Bad VAG samples address?");
-		return;
-	}
-	u8 *readp = Memory::GetPointerUnchecked(read_);
-	u8 *origp = readp;
+	// Fetched lazily - when serving from the loop cache, guest memory isn't touched at all.
+	u8 *readp = nullptr;
+	u8 *origp = nullptr;
 
 	for (int i = 0; i < numSamples; i++) {
+		if (loopCachePos_ >= 0) {
+			// Replaying a previously decoded loop iteration.
+			outSamples[i] = loopCachePcm_[loopCachePos_++];
+			if (loopCachePos_ == (int)loopCachePcm_.size()) {
+				// Back at the loop entry. Revalidate the source bytes so writes to the
+				// sample data get picked up, then either go around again or re-decode.
+				if (HashLoopSource() == loopCacheHash_) {
+					loopCachePos_ = 0;
+				} else {
+					// The decoder state already equals the loop entry state, so we can
+					// seamlessly fall back to real decoding below.
+					InvalidateLoopCache();
+				}
+			}
+			continue;
+		}
 		if (curSample == 28) {
 			if (loopAtNextBlock_) {
 				VERBOSE_LOG(SASMIX, "Looping VAG from block %d/%d to %d", curBlock_, numBlocks_, loopStartBlock_);
 				// data_ starts at curBlock = -1.
 				read_ = data_ + 16 * loopStartBlock_ + 16;
-				readp = Memory::GetPointerUnchecked(read_);
-				origp = readp;
+				readp = nullptr;
 				curBlock_ = loopStartBlock_;
 				loopAtNextBlock_ = false;
+
+				if (loopRecording_ && loopCacheBlocks_ > 0 && read_ == loopCacheAddr_ && s_1 == loopCacheS1_ && s_2 == loopCacheS2_ && Memory::IsValidRange(loopCacheAddr_, loopCacheBlocks_ * 16)) {
+					// A full iteration came back to the same entry state, so from here on
+					// the decoded PCM just repeats. Hash the source and start replaying.
+					loopCacheHash_ = HashLoopSource();
+					loopRecording_ = false;
+					loopCachePos_ = 0;
+					i--;
+					continue;
+				}
+
+				// Entry state changed (or this is the first time around) - (re)record.
+				loopRecording_ = true;
+				loopCachePcm_.clear();
+				loopCacheBlocks_ = 0;
+				loopCacheAddr_ = read_;
+				loopCacheS1_ = s_1;
+				loopCacheS2_ = s_2;
+			}
+			if (!readp) {
+				if (!Memory::IsValidAddress(read_)) {
+					WARN_LOG(SASMIX, "Bad VAG samples address?");
+					return;
+				}
+				readp = Memory::GetPointerUnchecked(read_);
+				origp = readp;
 			}
 			DecodeBlock(readp);
 			if (end_) {
+				InvalidateLoopCache();
 				// Clear the rest of the buffer and return.
 				memset(&outSamples[i], 0, (numSamples - i) * sizeof(s16));
 				return;
 			}
+			if (loopRecording_) {
+				loopCacheBlocks_++;
+				// Don't let a degenerate loop structure eat memory without bound.
+				if (loopCacheBlocks_ * 16 > LOOP_CACHE_MAX_BYTES)
+					InvalidateLoopCache();
+			}
 		}
-		outSamples[i] = samples[curSample++];
+		s16 sample = samples[curSample++];
+		if (loopRecording_)
+			loopCachePcm_.push_back(sample);
+		outSamples[i] = sample;
 	}
 
 	if (readp > origp) {
@@ -181,6 +258,10 @@ void VagDecoder::DoState(PointerWrap &p) {
 	p.Do(loopEnabled_);
 	p.Do(loopAtNextBlock_);
 	p.Do(end_);
+
+	// The loop cache is transient and rebuilds itself, no need to save it.
+	if (p.mode == p.MODE_READ)
+		InvalidateLoopCache();
 }
 
 int SasAtrac3::setContext(u32 context) {
@@ -474,7 +555,59 @@ bool SasVoice::HaveSamplesEnded() const {
 	}
 }
 
-void SasInstance::MixVoice(SasVoice &voice) {
+#ifdef _M_SSE
+// Accumulates eight enveloped samples (duplicated into stereo pairs in s2) scaled by the
+// interleaved [L, R, L, R, ...] volumes in vol.
+static inline void AccumulateStereo(int *dst, __m128i s2, __m128i vol) {
+	__m128i lo = _mm_mullo_epi16(s2, vol);
+	__m128i hi = _mm_mulhi_epi16(s2, vol);
+	__m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 12);
+	__m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 12);
+	_mm_storeu_si128((__m128i *)dst, _mm_add_epi32(_mm_loadu_si128((const __m128i *)dst), p0));
+	_mm_storeu_si128((__m128i *)(dst + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(dst + 4)), p1));
+}
+#endif
+
+// Scales already-enveloped samples by the four channel volumes and accumulates them into
+// the interleaved stereo mix and send buffers. This is the hot inner loop of MixVoice.
+// All paths compute bit-identical results to the plain loop at the bottom.
+static void AccumulateVoice(int *mixBuf, int *sendBuf, const s16 *samples, int count, int volL, int volR, int effL, int effR) {
+	int i = 0;
+#ifdef _M_SSE
+	const __m128i volMix = _mm_setr_epi16((s16)volL, (s16)volR, (s16)volL, (s16)volR, (s16)volL, (s16)volR, (s16)volL, (s16)volR);
+	const __m128i volSend = _mm_setr_epi16((s16)effL, (s16)effR, (s16)effL, (s16)effR, (s16)effL, (s16)effR, (s16)effL, (s16)effR);
+	for (; i + 8 <= count; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)&samples[i]);
+		const __m128i sLo = _mm_unpacklo_epi16(s, s);
+		const __m128i sHi = _mm_unpackhi_epi16(s, s);
+		AccumulateStereo(&mixBuf[i * 2], sLo, volMix);
+		AccumulateStereo(&mixBuf[i * 2 + 8], sHi, volMix);
+		AccumulateStereo(&sendBuf[i * 2], sLo, volSend);
+		AccumulateStereo(&sendBuf[i * 2 + 8], sHi, volSend);
+	}
+#elif PPSSPP_ARCH(ARM_NEON)
+	for (; i + 4 <= count; i += 4) {
+		const int16x4_t s = vld1_s16(&samples[i]);
+		int32x4x2_t mix = vld2q_s32(&mixBuf[i * 2]);
+		mix.val[0] = vaddq_s32(mix.val[0], vshrq_n_s32(vmull_n_s16(s, (s16)volL), 12));
+		mix.val[1] = vaddq_s32(mix.val[1], vshrq_n_s32(vmull_n_s16(s, (s16)volR), 12));
+		vst2q_s32(&mixBuf[i * 2], mix);
+		int32x4x2_t send = vld2q_s32(&sendBuf[i * 2]);
+		send.val[0] = vaddq_s32(send.val[0], vshrq_n_s32(vmull_n_s16(s, (s16)effL), 12));
+		send.val[1] = vaddq_s32(send.val[1], vshrq_n_s32(vmull_n_s16(s, (s16)effR), 12));
+		vst2q_s32(&sendBuf[i * 2], send);
+	}
+#endif
+	for (; i < count; i++) {
+		const int sample = samples[i];
+		mixBuf[i * 2] += (sample * volL) >> 12;
+		mixBuf[i * 2 + 1] += (sample * volR) >> 12;
+		sendBuf[i * 2] += (sample * effL) >> 12;
+		sendBuf[i * 2 + 1] += (sample * effR) >> 12;
+	}
+}
+
+void SasInstance::MixVoice(SasVoice &voice, int *mixBuf, int *sendBuf, s16 *mixTemp) {
 	switch (voice.type) {
 	case VOICETYPE_VAG:
 		if (voice.type == VOICETYPE_VAG && !voice.vagAddr)
@@ -500,8 +633,8 @@ void SasInstance::MixVoice(SasVoice &voice) {
 		// TODO: Special case no-resample case (and 2x and 0.5x) for speed, it's not uncommon
 
 		// Two passes: First read, then resample.
-		mixTemp_[0] = voice.resampleHist[0];
-		mixTemp_[1] = voice.resampleHist[1];
+		mixTemp[0] = voice.resampleHist[0];
+		mixTemp[1] = voice.resampleHist[1];
 
 		int voicePitch = voice.pitch;
 		u32 sampleFrac = voice.sampleFrac;
@@ -515,7 +648,7 @@ void SasInstance::MixVoice(SasVoice &voice) {
 			readPos = 0;
 			samplesToRead += 2;
 		}
-		voice.ReadSamples(&mixTemp_[readPos], samplesToRead);
+		voice.ReadSamples(&mixTemp[readPos], samplesToRead);
 		int tempPos = readPos + samplesToRead;
 
 		for (int i = 0; i < delay; ++i) {
@@ -524,9 +657,13 @@ void SasInstance::MixVoice(SasVoice &voice) {
 			voice.envelope.Step();
 		}
 
+		// Resample and apply the envelope, leaving samples that only need the four volume
+		// scalings. That part vectorizes well, so it's split out into AccumulateVoice().
+		s16 scaled[PSP_SAS_MAX_GRAIN];
+		const int count = grainSize - delay;
 		const bool needsInterp = voicePitch != PSP_SAS_PITCH_BASE || (sampleFrac & PSP_SAS_PITCH_MASK) != 0;
-		for (int i = delay; i < grainSize; i++) {
-			const int16_t *s = mixTemp_ + (sampleFrac >> PSP_SAS_PITCH_BASE_SHIFT);
+		for (int i = 0; i < count; i++) {
+			const int16_t *s = mixTemp + (sampleFrac >> PSP_SAS_PITCH_BASE_SHIFT);
 
 			// Linear interpolation. Good enough. Need to make resampleHist bigger if we want more.
 			int sample = s[0];
@@ -544,19 +681,16 @@ void SasInstance::MixVoice(SasVoice &voice) {
 
 			// We just scale by the envelope before we scale by volumes.
 			// Again, we round up by adding (1 << 14) first (*after* multiplying.)
-			sample = ((sample * envelopeValue) + (1 << 14)) >> 15;
-
-			// We mix into this 32-bit temp buffer and clip in a second loop
-			// Ideally, the shift right should be there too but for now I'm concerned about
-			// not overflowing.
-			mixBuffer[i * 2] += (sample * voice.volumeLeft) >> 12;
-			mixBuffer[i * 2 + 1] += (sample * voice.volumeRight) >> 12;
-			sendBuffer[i * 2] += sample * voice.effectLeft >> 12;
-			sendBuffer[i * 2 + 1] += sample * voice.effectRight >> 12;
+			scaled[i] = (s16)(((sample * envelopeValue) + (1 << 14)) >> 15);
 		}
 
-		voice.resampleHist[0] = mixTemp_[tempPos - 2];
-		voice.resampleHist[1] = mixTemp_[tempPos - 1];
+		// We mix into a 32-bit temp buffer and clip in a second loop
+		// Ideally, the shift right should be there too but for now I'm concerned about
+		// not overflowing.
+		AccumulateVoice(mixBuf + delay * 2, sendBuf + delay * 2, scaled, count, voice.volumeLeft, voice.volumeRight, voice.effectLeft, voice.effectRight);
+
+		voice.resampleHist[0] = mixTemp[tempPos - 2];
+		voice.resampleHist[1] = mixTemp[tempPos - 1];
 
 		voice.sampleFrac = sampleFrac - (tempPos - 2) * PSP_SAS_PITCH_BASE;
 
@@ -571,14 +705,11 @@ void SasInstance::MixVoice(SasVoice &voice) {
 }
 
 void SasInstance::Mix(u32 outAddr, u32 inAddr, int leftVol, int rightVol) {
-	int voicesPlayingCount = 0;
-
 	for (int v = 0; v < PSP_SAS_VOICES_MAX; v++) {
 		SasVoice &voice = voices[v];
 		if (!voice.playing || voice.paused)
 			continue;
-		voicesPlayingCount++;
-		MixVoice(voice);
+		MixVoice(voice, mixBuffer, sendBuffer, mixTemp_);
 	}
 
 	// Then mix the send buffer in with the rest.
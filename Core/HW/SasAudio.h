@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Core/HW/BufferQueue.h"
 #include "Core/HW/SasReverb.h"
@@ -110,6 +112,9 @@ public:
 	u32 GetReadPtr() const { return read_; }
 
 private:
+	void InvalidateLoopCache();
+	u32 HashLoopSource() const;
+
 	s16 samples[28];
 	int curSample = 0;
 
@@ -126,6 +131,19 @@ private:
 	bool loopEnabled_ = false;
 	bool loopAtNextBlock_ = false;
 	bool end_ = false;
+
+	// Memoized PCM for the loop region (see GetSamples). Looping ambient SFX decode the
+	// exact same blocks thousands of times; once a full loop iteration repeats its entry
+	// state, we replay the decoded PCM and only re-hash the source bytes once per
+	// iteration to catch CPU writes to the sample data. Not saved - rebuilt on the fly.
+	std::vector<s16> loopCachePcm_;
+	u32 loopCacheAddr_ = 0;    // address of the first loop block.
+	int loopCacheBlocks_ = 0;
+	int loopCacheS1_ = 0;      // rolling state at the loop entry.
+	int loopCacheS2_ = 0;
+	u32 loopCacheHash_ = 0;
+	int loopCachePos_ = -1;    // >= 0 while serving from the cache.
+	bool loopRecording_ = false;
 };
 
 class SasAtrac3 {
@@ -294,7 +312,7 @@ public:
 	FILE *audioDump;
 
 	void Mix(u32 outAddr, u32 inAddr = 0, int leftVol = 0, int rightVol = 0);
-	void MixVoice(SasVoice &voice);
+	void MixVoice(SasVoice &voice, int *mixBuf, int *sendBuf, s16 *mixTemp);
 
 	// Applies reverb to send buffer, according to waveformEffect.
 	void ApplyWaveformEffect();
@@ -35,7 +35,6 @@
 #include "base/NativeApp.h"
 #include "Common/ChunkFile.h"
 #include "Common/MathUtil.h"
-#include "Common/Atomics.h"
 #include "Core/Config.h"
 #include "Core/ConfigValues.h"
 #include "Core/HW/StereoResampler.h"
@@ -157,6 +156,31 @@ void StereoResampler::Clear() {
 	memset(m_buffer, 0, m_bufsize * 2 * sizeof(int16_t));
 }
 
+#ifdef _M_SSE
+// 32-bit lane multiply - SSE2 only has the widening variant.
+static inline __m128i Mul32x4(__m128i a, __m128i b) {
+	__m128i lo = _mm_mul_epu32(a, b);
+	__m128i hi = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(lo, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+unsigned int StereoResampler::CopyFromRing(short *samples, unsigned int numHalfwords, u32 &indexR, u32 indexW) {
+	const int INDEX_MASK = (m_bufsize * 2 - 1);
+	u32 avail = (indexW - indexR) & INDEX_MASK;
+	// Like the interpolating path, always leave one frame in the buffer.
+	u32 toCopy = std::min(numHalfwords, avail > 2 ? avail - 2 : 0);
+	u32 copied = 0;
+	while (copied < toCopy) {
+		u32 base = indexR & INDEX_MASK;
+		u32 chunk = std::min(toCopy - copied, (u32)(m_bufsize * 2) - base);
+		memcpy(samples + copied, m_buffer + base, chunk * sizeof(s16));
+		indexR += chunk;
+		copied += chunk;
+	}
+	return copied;
+}
+
 // Executed from sound stream thread
 unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool consider_framelimit, int sample_rate) {
 	if (!samples)
@@ -164,27 +188,19 @@ unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool
 
 	unsigned int currentSample = 0;
 
-	// Cache access in non-volatile variable
-	// This is the only function changing the read value, so it's safe to
-	// cache it locally although it's written here.
-	// The writing pointer will be modified outside, but it will only increase,
-	// so we will just ignore new written data while interpolating.
-	// Without this cache, the compiler wouldn't be allowed to optimize the
-	// interpolation loop.
-	u32 indexR = Common::AtomicLoad(m_indexR);
-	u32 indexW = Common::AtomicLoad(m_indexW);
+	// Cache the cursors in locals for the duration of the mix. We're the only
+	// writer of m_indexR so a relaxed load is enough, and the acquire on
+	// m_indexW makes everything the producer wrote before advancing it
+	// visible to us. The writing pointer may advance concurrently, but we
+	// just ignore data pushed after this snapshot.
+	u32 indexR = m_indexR.load(std::memory_order_relaxed);
+	u32 indexW = m_indexW.load(std::memory_order_acquire);
 
 	const int INDEX_MASK = (m_bufsize * 2 - 1);
 
 	// We force on the audio resampler if the output sample rate doesn't match the input.
 	if (!g_Config.bAudioResampler && sample_rate == (int)m_input_sample_rate) {
-		for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2) {
-			s16 l1 = m_buffer[indexR & INDEX_MASK]; //current
-			s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK]; //current
-			samples[currentSample] = l1;
-			samples[currentSample + 1] = r1;
-			indexR += 2;
-		}
+		currentSample = CopyFromRing(samples, numSamples * 2, indexR, indexW);
 		sample_rate_ = (float)sample_rate;
 	} else {
 		// Drift prevention mechanism
@@ -198,20 +214,87 @@ unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool
 		const u32 ratio = (u32)(65536.0 * sample_rate_ / (double)sample_rate);
 
 		// TODO: consider a higher-quality resampling algorithm.
-		// TODO: Add a fast path for 1:1.
-		for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2) {
-			u32 indexR2 = indexR + 2; //next sample
-			s16 l1 = m_buffer[indexR & INDEX_MASK]; //current
-			s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK]; //current
-			s16 l2 = m_buffer[indexR2 & INDEX_MASK]; //next
-			s16 r2 = m_buffer[(indexR2 + 1) & INDEX_MASK]; //next
-			int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-			int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-			samples[currentSample] = sampleL;
-			samples[currentSample + 1] = sampleR;
-			m_frac += ratio;
-			indexR += 2 * (u16)(m_frac >> 16);
-			m_frac &= 0xffff;
+		if (ratio == 65536 && m_frac == 0) {
+			// Exact 1:1 after drift adjustment - reduces to a plain copy.
+			currentSample = CopyFromRing(samples, numSamples * 2, indexR, indexW);
+		} else {
+			while (true) {
+#if defined(_M_SSE) || PPSSPP_ARCH(ARM_NEON)
+				// Four output frames per iteration. Since the ratio is constant, the source
+				// offset and fraction of every frame in a batch follow in closed form from
+				// m_frac - no dependency chain, and the interpolation vectorizes.
+				while (currentSample + 8 <= numSamples * 2) {
+					const u32 f0 = m_frac & 0xffff;
+					const u32 f1 = f0 + ratio, f2 = f0 + 2 * ratio, f3 = f0 + 3 * ratio;
+					const u32 off1 = f1 >> 16, off2 = f2 >> 16, off3 = f3 >> 16;
+					if (((indexW - indexR) & INDEX_MASK) <= 2 * off3 + 2)
+						break;
+					const u32 base = indexR & INDEX_MASK;
+					if (base + 2 * off3 + 4 > (u32)(m_bufsize * 2))
+						break;  // The span wraps - let the scalar step below get us past it.
+					// Each u32 is one [L, R] frame. base is even, so these loads are aligned.
+					const u32 c0 = *(const u32 *)&m_buffer[base];
+					const u32 c1 = *(const u32 *)&m_buffer[base + 2 * off1];
+					const u32 c2 = *(const u32 *)&m_buffer[base + 2 * off2];
+					const u32 c3 = *(const u32 *)&m_buffer[base + 2 * off3];
+					const u32 n0 = *(const u32 *)&m_buffer[base + 2];
+					const u32 n1 = *(const u32 *)&m_buffer[base + 2 * off1 + 2];
+					const u32 n2 = *(const u32 *)&m_buffer[base + 2 * off2 + 2];
+					const u32 n3 = *(const u32 *)&m_buffer[base + 2 * off3 + 2];
+#ifdef _M_SSE
+					const __m128i cur = _mm_set_epi32(c3, c2, c1, c0);
+					const __m128i next = _mm_set_epi32(n3, n2, n1, n0);
+					const __m128i frac = _mm_set_epi32(f3 & 0xffff, f2 & 0xffff, f1 & 0xffff, f0);
+					const __m128i l1 = _mm_srai_epi32(_mm_slli_epi32(cur, 16), 16);
+					const __m128i r1 = _mm_srai_epi32(cur, 16);
+					const __m128i l2 = _mm_srai_epi32(_mm_slli_epi32(next, 16), 16);
+					const __m128i r2 = _mm_srai_epi32(next, 16);
+					const __m128i sampleL = _mm_add_epi32(l1, _mm_srai_epi32(Mul32x4(_mm_sub_epi32(l2, l1), frac), 16));
+					const __m128i sampleR = _mm_add_epi32(r1, _mm_srai_epi32(Mul32x4(_mm_sub_epi32(r2, r1), frac), 16));
+					const __m128i out = _mm_or_si128(_mm_and_si128(sampleL, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(sampleR, 16));
+					_mm_storeu_si128((__m128i *)&samples[currentSample], out);
+#else
+					const u32 curA[4] = { c0, c1, c2, c3 };
+					const u32 nextA[4] = { n0, n1, n2, n3 };
+					const u32 fracA[4] = { f0, f1 & 0xffff, f2 & 0xffff, f3 & 0xffff };
+					const int32x4_t cur = vreinterpretq_s32_u32(vld1q_u32(curA));
+					const int32x4_t next = vreinterpretq_s32_u32(vld1q_u32(nextA));
+					const int32x4_t frac = vreinterpretq_s32_u32(vld1q_u32(fracA));
+					const int32x4_t l1 = vshrq_n_s32(vshlq_n_s32(cur, 16), 16);
+					const int32x4_t r1 = vshrq_n_s32(cur, 16);
+					const int32x4_t l2 = vshrq_n_s32(vshlq_n_s32(next, 16), 16);
+					const int32x4_t r2 = vshrq_n_s32(next, 16);
+					const int32x4_t sampleL = vaddq_s32(l1, vshrq_n_s32(vmulq_s32(vsubq_s32(l2, l1), frac), 16));
+					const int32x4_t sampleR = vaddq_s32(r1, vshrq_n_s32(vmulq_s32(vsubq_s32(r2, r1), frac), 16));
+					const uint32x4_t out = vorrq_u32(vandq_u32(vreinterpretq_u32_s32(sampleL), vdupq_n_u32(0xFFFF)),
+						vreinterpretq_u32_s32(vshlq_n_s32(sampleR, 16)));
+					vst1q_u32((u32 *)&samples[currentSample], out);
+#endif
+					currentSample += 8;
+					const u32 fracEnd = f0 + 4 * ratio;
+					indexR += 2 * (fracEnd >> 16);
+					m_frac = fracEnd & 0xffff;
+				}
+#endif
+				// Scalar step - handles the tail and ring buffer wraparound.
+				if (currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2) {
+					u32 indexR2 = indexR + 2; //next sample
+					s16 l1 = m_buffer[indexR & INDEX_MASK]; //current
+					s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK]; //current
+					s16 l2 = m_buffer[indexR2 & INDEX_MASK]; //next
+					s16 r2 = m_buffer[(indexR2 + 1) & INDEX_MASK]; //next
+					int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+					int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+					samples[currentSample] = sampleL;
+					samples[currentSample + 1] = sampleR;
+					currentSample += 2;
+					m_frac += ratio;
+					indexR += 2 * (u16)(m_frac >> 16);
+					m_frac &= 0xffff;
+				} else {
+					break;
+				}
+			}
 		}
 	}
 
@@ -228,13 +311,15 @@ unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool
 		samples[currentSample + 1] = s[1];
 	}
 
-	// Flush cached variable
-	Common::AtomicStore(m_indexR, indexR);
+	// Publish the new read cursor. The release keeps our buffer reads from
+	// being reordered past it - once the producer sees this, it may overwrite
+	// the space we just consumed.
+	m_indexR.store(indexR, std::memory_order_release);
 
 	//if (realSamples != numSamples * 2) {
 	//	ILOG("Underrun! %i / %i", realSamples / 2, numSamples);
 	//}
-	lastBufSize_ = (m_indexW - m_indexR) & INDEX_MASK;
+	lastBufSize_ = (indexW - indexR) & INDEX_MASK;
 
 	return realSamples / 2;
 }
@@ -242,19 +327,22 @@ unsigned int StereoResampler::Mix(short* samples, unsigned int numSamples, bool
 void StereoResampler::PushSamples(const s32 *samples, unsigned int num_samples) {
 	UpdateBufferSize();
 	const int INDEX_MASK = (m_bufsize * 2 - 1);
-	// Cache access in non-volatile variable
-	// indexR isn't allowed to cache in the audio throttling loop as it
-	// needs to get updates to not deadlock.
-	u32 indexW = Common::AtomicLoad(m_indexW);
+	// We're the only writer of m_indexW, so a relaxed load is enough here.
+	u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
 	u32 cap = m_bufsize * 2;
 	// If unthottling, no need to fill up the entire buffer, just screws up timing after releasing unthrottle.
 	if (PSP_CoreParameter().unthrottle)
 		cap = m_lowwatermark * 2;
 
-	// Check if we have enough free space
-	// indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-	if (num_samples * 2 + ((indexW - Common::AtomicLoad(m_indexR)) & INDEX_MASK) >= cap) {
+	// Check if we have enough free space. The acquire pairs with the release
+	// in Mix() - once we see the advanced read cursor, the consumer is done
+	// with that part of the buffer and we may overwrite it.
+	// indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW.
+	// Overrun policy: if the block doesn't fit, drop it whole and count it -
+	// losing one push is less audible than a partial block, and blocking here
+	// would stall the emu thread.
+	if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >= cap) {
 		if (!PSP_CoreParameter().unthrottle)
 			overrunCount_++;
 		// TODO: "Timestretch" by doing a windowed overlap with existing buffer content?
@@ -269,7 +357,8 @@ void StereoResampler::PushSamples(const s32 *samples, unsigned int num_samples)
 		ClampBufferToS16WithVolume(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 2);
 	}
 
-	Common::AtomicAdd(m_indexW, num_samples * 2);
+	// The release publishes the samples written above along with the cursor.
+	m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
 	lastPushSize_ = num_samples;
 }
 
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "Common/ChunkFile.h"
@@ -47,13 +48,24 @@ public:
 protected:
 	void UpdateBufferSize();
 	void SetInputSampleRate(unsigned int rate);
+	// Fast path for 1:1 output - the buffer already holds converted s16 samples, so this
+	// is just a copy in at most two contiguous chunks. Returns the halfwords copied.
+	unsigned int CopyFromRing(short *samples, unsigned int numHalfwords, u32 &indexR, u32 indexW);
 
 	int m_bufsize;
 	int m_lowwatermark;
 	unsigned int m_input_sample_rate;
 	int16_t *m_buffer;
-	volatile u32 m_indexW;
-	volatile u32 m_indexR;
+	// The ring is a lock-free single-producer/single-consumer handoff: the emu
+	// thread only ever advances m_indexW (PushSamples) and the host audio
+	// thread only ever advances m_indexR (Mix). Release/acquire ordering pairs
+	// each cursor update with the buffer contents it covers, and each cursor
+	// gets its own cache line so the two threads don't false-share. Overrun
+	// policy: a push that doesn't fit is dropped whole (and counted) rather
+	// than blocking the emu thread. The fields after m_indexR are either
+	// consumer-side or cold (stats), so sharing its line is fine.
+	alignas(64) std::atomic<u32> m_indexW;
+	alignas(64) std::atomic<u32> m_indexR;
 	float m_numLeftI;
 	u32 m_frac;
 	int underrunCount_;
@@ -501,7 +501,9 @@ void Arm64Jit::Comp_Jump(MIPSOpcode op) {
 
 		gpr.SetImm(MIPS_REG_RA, GetCompilerPC() + 8);
 		CompileDelaySlot(DELAYSLOT_NICE);
-		if (jo.continueJumps && js.numInstructions < jo.continueMaxInstructions) {
+		// Small leaf functions get inlined here: compilation continues into the
+		// callee, and its jr ra continues back (RA is a known immediate.)
+		if ((jo.continueJumps && js.numInstructions < jo.continueMaxInstructions) || CanInlineJal(targetAddr)) {
 			AddContinuedBlock(targetAddr);
 			// Account for the increment in the loop.
 			js.compilerPC = targetAddr - 4;
@@ -561,7 +563,8 @@ void Arm64Jit::Comp_JumpReg(MIPSOpcode op)
 			gpr.DiscardR(MIPS_REG_T9);
 		}
 
-		if (jo.continueJumps && gpr.IsImm(rs) && js.numInstructions < jo.continueMaxInstructions) {
+		bool continueReturn = jo.inlineSmallFunctions && rs == MIPS_REG_RA && !andLink;
+		if ((jo.continueJumps || continueReturn) && gpr.IsImm(rs) && js.numInstructions < jo.continueMaxInstructions) {
 			AddContinuedBlock(gpr.GetImm(rs));
 			// Account for the increment in the loop.
 			js.compilerPC = gpr.GetImm(rs) - 4;
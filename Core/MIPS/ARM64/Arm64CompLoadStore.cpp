@@ -312,10 +312,10 @@ namespace MIPSComp {
 		case 41: //sh
 		case 43: //sw
 			if (jo.cachePointers && g_Config.bFastMemory) {
-				// ARM has smaller load/store immediate displacements than MIPS, 12 bits - and some memory ops only have 8 bits.
-				int offsetRange = 0x3ff;
-				if (o == 41 || o == 33 || o == 37 || o == 32)
-					offsetRange = 0xff;  // 8 bit offset only
+				// The INDEX_UNSIGNED encodings take a 12-bit offset scaled by the access size,
+				// so we can reach 16380 for words, 8190 for halfwords and 4095 for bytes -
+				// same range the FPU/VFPU load/store paths already use.
+				int offsetRange = 0xfff * dataSize;
 				if (!gpr.IsImm(rs) && rs != rt && (offset <= offsetRange) && offset >= 0 &&
 					  (dataSize == 1 || (offset & (dataSize - 1)) == 0)) {  // Check that the offset is aligned to the access size as that's required for INDEX_UNSIGNED encodings. we can get here through fallback from lwl/lwr
 					gpr.SpillLock(rs, rt);
@@ -1245,9 +1245,10 @@ namespace MIPSComp {
 					fpr.MapDirtyInInV(dregs[a * 4 + b], sregs[b * 4], tregs[a * 4], true);
 					fp.FMUL(fpr.V(dregs[a * 4 + b]), fpr.V(sregs[b * 4]), fpr.V(tregs[a * 4]));
 					for (int c = 1; c < n; c++) {
+						// Fused accumulate, like Comp_Vtfm. The compat flag for titles
+						// that need interpreter-exact rounding bailed out above.
 						fpr.MapDirtyInInV(dregs[a * 4 + b], sregs[b * 4 + c], tregs[a * 4 + c], false);
-						fp.FMUL(S0, fpr.V(sregs[b * 4 + c]), fpr.V(tregs[a * 4 + c]));
-						fp.FADD(fpr.V(dregs[a * 4 + b]), fpr.V(dregs[a * 4 + b]), S0);
+						fp.FMADD(fpr.V(dregs[a * 4 + b]), fpr.V(sregs[b * 4 + c]), fpr.V(tregs[a * 4 + c]), fpr.V(dregs[a * 4 + b]));
 					}
 				}
 			}
@@ -1256,7 +1257,40 @@ namespace MIPSComp {
 	}
 
 	void Arm64Jit::Comp_Vmscl(MIPSOpcode op) {
-		DISABLE;
+		CONDITIONAL_DISABLE(VFPU_MTX_VMSCL);
+		if (!js.HasNoPrefix()) {
+			DISABLE;
+		}
+
+		MatrixSize sz = GetMtxSize(op);
+		int n = GetMatrixSide(sz);
+
+		u8 sregs[16], dregs[16], treg;
+		GetMatrixRegs(sregs, sz, _VS);
+		GetVectorRegs(&treg, V_Single, _VT);
+		GetMatrixRegs(dregs, sz, _VD);
+
+		switch (GetMatrixOverlap(_VS, _VD, sz)) {
+		case OVERLAP_EQUAL:
+			// In-place scale, no temps needed since it's element-by-element.
+			break;
+		case OVERLAP_PARTIAL:
+			DISABLE;
+		case OVERLAP_NONE:
+		default:
+			break;
+		}
+
+		// Grab the scale factor first in case it lives inside the matrix.
+		fpr.LoadToRegV(S0, treg);
+
+		for (int a = 0; a < n; a++) {
+			for (int b = 0; b < n; b++) {
+				fpr.MapDirtyInV(dregs[a * 4 + b], sregs[a * 4 + b], false);
+				fp.FMUL(fpr.V(dregs[a * 4 + b]), fpr.V(sregs[a * 4 + b]), S0);
+			}
+		}
+		fpr.ReleaseSpillLocksAndDiscardTemps();
 	}
 
 	void Arm64Jit::Comp_Vtfm(MIPSOpcode op) {
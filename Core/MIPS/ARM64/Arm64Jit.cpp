@@ -388,6 +388,17 @@ const u8 *Arm64Jit::DoJit(u32 em_address, JitBlock *b) {
 	return b->normalEntry;
 }
 
+bool Arm64Jit::CanInlineJal(u32 targetAddr) {
+	if (!jo.inlineSmallFunctions || !targetAddr)
+		return false;
+	const int INLINE_FUNC_MAX_INSTRUCTIONS = 16;
+	if (js.numInstructions + INLINE_FUNC_MAX_INSTRUCTIONS >= jo.continueMaxInstructions)
+		return false;
+	// The return address stays a known immediate, so the callee's terminal
+	// jr ra folds right back to the call site and the whole call disappears.
+	return MIPSAnalyst::IsInlineableCallTarget(targetAddr, INLINE_FUNC_MAX_INSTRUCTIONS);
+}
+
 void Arm64Jit::AddContinuedBlock(u32 dest) {
 	// The first block is the root block.  When we continue, we create proxy blocks after that.
 	if (js.lastContinuedPC == 0)
@@ -196,6 +196,7 @@ private:
 	void CompileDelaySlot(int flags);
 	void EatInstruction(MIPSOpcode op);
 	void AddContinuedBlock(u32 dest);
+	bool CanInlineJal(u32 targetAddr);
 	MIPSOpcode GetOffsetInstruction(int offset);
 
 	void WriteDownCount(int offset = 0, bool updateFlags = true);
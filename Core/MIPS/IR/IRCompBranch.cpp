@@ -96,12 +96,25 @@ void IRFrontend::BranchRSRTComp(MIPSOpcode op, IRComparison cc, bool likely) {
 	js.downcountAmount = 0;
 
 	FlushAll();
+	bool idleLoop = (opts.disableFlags & (uint32_t)JitDisable::IDLELOOPS) == 0 &&
+		MIPSAnalyst::IsBusyWaitLoop(GetCompilerPC(), targetAddr);
+	if (!idleLoop && !likely && CanContinueBranch(targetAddr)) {
+		// Exit if taken, and keep compiling straight through the fallthrough.
+		ir.Write(ComparisonToExit(Invert(cc)), ir.AddConstant(targetAddr), lhs, rhs);
+		// Account for the delay slot.
+		js.compilerPC += 4;
+		return;
+	}
 	ir.Write(ComparisonToExit(cc), ir.AddConstant(GetCompilerPC() + 8), lhs, rhs);
 	// This makes the block "impure" :(
 	if (likely)
 		CompileDelaySlot();
 
 	FlushAll();
+	// Taking the branch means another spin through a side-effect-free poll
+	// loop - donate the rest of the timeslice instead.
+	if (idleLoop)
+		ir.Write(IROp::Idle);
 	ir.Write(IROp::ExitToConst, ir.AddConstant(targetAddr));
 
 	// Account for the delay slot.
@@ -137,11 +150,23 @@ void IRFrontend::BranchRSZeroComp(MIPSOpcode op, IRComparison cc, bool andLink,
 	js.downcountAmount = 0;
 
 	FlushAll();
+	bool idleLoop = !andLink && (opts.disableFlags & (uint32_t)JitDisable::IDLELOOPS) == 0 &&
+		MIPSAnalyst::IsBusyWaitLoop(GetCompilerPC(), targetAddr);
+	if (!idleLoop && !likely && CanContinueBranch(targetAddr)) {
+		// Exit if taken, and keep compiling straight through the fallthrough.
+		ir.Write(ComparisonToExit(Invert(cc)), ir.AddConstant(targetAddr), lhs);
+		// Account for the delay slot.
+		js.compilerPC += 4;
+		return;
+	}
 	ir.Write(ComparisonToExit(cc), ir.AddConstant(GetCompilerPC() + 8), lhs);
 	if (likely)
 		CompileDelaySlot();
-	// Taken
+	// Taken - for a side-effect-free poll loop, donate the rest of the
+	// timeslice instead of spinning through it.
 	FlushAll();
+	if (idleLoop)
+		ir.Write(IROp::Idle);
 	ir.Write(IROp::ExitToConst, ir.AddConstant(targetAddr));
 
 	// Account for the delay slot.
@@ -204,6 +229,13 @@ void IRFrontend::BranchFPFlag(MIPSOpcode op, IRComparison cc, bool likely) {
 	js.downcountAmount = 0;
 
 	FlushAll();
+	if (!likely && CanContinueBranch(targetAddr)) {
+		// Exit if taken, and keep compiling straight through the fallthrough.
+		ir.Write(ComparisonToExit(Invert(cc)), ir.AddConstant(targetAddr), IRTEMP_LHS, 0);
+		// Account for the delay slot.
+		js.compilerPC += 4;
+		return;
+	}
 	// Not taken
 	ir.Write(ComparisonToExit(cc), ir.AddConstant(GetCompilerPC() + 8), IRTEMP_LHS, 0);
 	// Taken
@@ -261,6 +293,13 @@ void IRFrontend::BranchVFPUFlag(MIPSOpcode op, IRComparison cc, bool likely) {
 
 	ir.Write(IROp::AndConst, IRTEMP_LHS, IRTEMP_LHS, ir.AddConstant(1 << imm3));
 	FlushAll();
+	if (!likely && !delaySlotIsBranch && CanContinueBranch(targetAddr)) {
+		// Exit if taken, and keep compiling straight through the fallthrough.
+		ir.Write(ComparisonToExit(Invert(cc)), ir.AddConstant(targetAddr), IRTEMP_LHS, 0);
+		// Account for the delay slot.
+		js.compilerPC += 4;
+		return;
+	}
 	ir.Write(ComparisonToExit(cc), ir.AddConstant(notTakenTarget), IRTEMP_LHS, 0);
 
 	if (likely)
@@ -95,6 +95,15 @@ void IRFrontend::EatInstruction(MIPSOpcode op) {
 	js.downcountAmount += MIPSGetInstructionCycleEstimate(op);
 }
 
+bool IRFrontend::CanContinueBranch(u32 targetAddr) {
+	if (!opts.continueBranches || targetAddr == 0)
+		return false;
+	// Need at least some room to fit the continuation.
+	if (js.numInstructions >= opts.continueMaxInstructions)
+		return false;
+	return true;
+}
+
 void IRFrontend::CompileDelaySlot() {
 	js.inDelaySlot = true;
 	CheckBreakpoint(GetCompilerPC() + 4);
@@ -263,6 +272,7 @@ void IRFrontend::DoJit(u32 em_address, std::vector<IRInst> &instructions, u32 &m
 			&RemoveLoadStoreLeftRight,
 			&OptimizeFPMoves,
 			&PropagateConstants,
+			&EliminateRedundantALU,
 			&PurgeTemps,
 			// &ReorderLoadStore,
 			// &MergeLoadStore,
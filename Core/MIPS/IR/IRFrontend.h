@@ -107,6 +107,7 @@ private:
 	void FlushPrefixV();
 
 	u32 GetCompilerPC();
+	bool CanContinueBranch(u32 targetAddr);
 	void CompileDelaySlot();
 	void EatInstruction(MIPSOpcode op);
 	MIPSOpcode GetOffsetInstruction(int offset);
@@ -162,6 +162,7 @@ static const IRMeta irMeta[] = {
 	{ IROp::CallReplacement, "CallRepl", "_C" },
 	{ IROp::Breakpoint, "Breakpoint", "", IRFLAG_EXIT },
 	{ IROp::MemoryCheck, "MemoryCheck", "_GC", IRFLAG_EXIT },
+	{ IROp::Idle, "Idle", "" },
 
 	{ IROp::RestoreRoundingMode, "RestoreRoundingMode", "" },
 	{ IROp::ApplyRoundingMode, "ApplyRoundingMode", "" },
@@ -215,6 +215,11 @@ enum class IROp : u8 {
 	Break,
 	Breakpoint,
 	MemoryCheck,
+
+	// Donates the rest of the timeslice to CoreTiming::Idle - emitted on the
+	// taken path of detected busy-wait loops. Appended last to keep opcode
+	// encodings stable for the persistent block cache.
+	Idle,
 };
 
 enum IRComparison {
@@ -371,6 +376,10 @@ private:
 struct IROptions {
 	uint32_t disableFlags;
 	bool unalignedLoadStore;
+	// Keep compiling through the not-taken side of conditional branches,
+	// forming larger blocks. The block's memory range stays contiguous.
+	bool continueBranches;
+	int continueMaxInstructions;
 };
 
 const IRMeta *GetIRMeta(IROp op);
@@ -210,6 +210,8 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			u32 base = mips->r[inst->src1] + inst->constant;
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_load_ps((const float *)Memory::GetPointerUnchecked(base)));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32(&mips->f[inst->dest], vld1q_f32((const float *)Memory::GetPointerUnchecked(base)));
 #else
 			for (int i = 0; i < 4; i++)
 				mips->f[inst->dest + i] = Memory::ReadUnchecked_Float(base + 4 * i);
@@ -221,6 +223,8 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			u32 base = mips->r[inst->src1] + inst->constant;
 #if defined(_M_SSE)
 			_mm_store_ps((float *)Memory::GetPointerUnchecked(base), _mm_load_ps(&mips->f[inst->dest]));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32((float *)Memory::GetPointerUnchecked(base), vld1q_f32(&mips->f[inst->dest]));
 #else
 			for (int i = 0; i < 4; i++)
 				Memory::WriteUnchecked_Float(mips->f[inst->dest + i], base + 4 * i);
@@ -232,6 +236,8 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_load_ps(vec4InitValues[inst->src1]));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32(&mips->f[inst->dest], vld1q_f32(vec4InitValues[inst->src1]));
 #else
 			memcpy(&mips->f[inst->dest], vec4InitValues[inst->src1], 4 * sizeof(float));
 #endif
@@ -302,6 +308,8 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_div_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2])));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32(&mips->f[inst->dest], vdivq_f32(vld1q_f32(&mips->f[inst->src1]), vld1q_f32(&mips->f[inst->src2])));
 #else
 			for (int i = 0; i < 4; i++)
 				mips->f[inst->dest + i] = mips->f[inst->src1 + i] / mips->f[inst->src2 + i];
@@ -313,6 +321,8 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 		{
 #if defined(_M_SSE)
 			_mm_store_ps(&mips->f[inst->dest], _mm_mul_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_set1_ps(mips->f[inst->src2])));
+#elif PPSSPP_ARCH(ARM64)
+			vst1q_f32(&mips->f[inst->dest], vmulq_n_f32(vld1q_f32(&mips->f[inst->src1]), mips->f[inst->src2]));
 #else
 			for (int i = 0; i < 4; i++)
 				mips->f[inst->dest + i] = mips->f[inst->src1 + i] * mips->f[inst->src2];
@@ -502,13 +512,28 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			}
 			break;
 
-		// Not quickly implementable on all platforms, unfortunately.
 		case IROp::Vec4Dot:
 		{
+			// We do the multiplies in parallel but add the lanes in order - a
+			// horizontal add would change rounding vs the scalar path.
+#if defined(_M_SSE)
+			__m128 m = _mm_mul_ps(_mm_load_ps(&mips->f[inst->src1]), _mm_load_ps(&mips->f[inst->src2]));
+			__m128 sum = _mm_add_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(m, m, _MM_SHUFFLE(3, 3, 3, 3)));
+			_mm_store_ss(&mips->f[inst->dest], sum);
+#elif PPSSPP_ARCH(ARM64)
+			float32x4_t m = vmulq_f32(vld1q_f32(&mips->f[inst->src1]), vld1q_f32(&mips->f[inst->src2]));
+			float dot = vgetq_lane_f32(m, 0) + vgetq_lane_f32(m, 1);
+			dot += vgetq_lane_f32(m, 2);
+			dot += vgetq_lane_f32(m, 3);
+			mips->f[inst->dest] = dot;
+#else
 			float dot = mips->f[inst->src1] * mips->f[inst->src2];
 			for (int i = 1; i < 4; i++)
 				dot += mips->f[inst->src1 + i] * mips->f[inst->src2 + i];
 			mips->f[inst->dest] = dot;
+#endif
 			break;
 		}
 
@@ -905,6 +930,12 @@ u32 IRInterpret(MIPSState *mips, const IRInst *inst, int count) {
 			mips->downcount -= inst->constant;
 			break;
 
+		case IROp::Idle:
+			// Busy-wait loop detected at compile time - hand the rest of the
+			// slice to the event queue instead of spinning on it.
+			CoreTiming::Idle();
+			break;
+
 		case IROp::SetPC:
 			mips->pc = mips->r[inst->src1];
 			break;
@@ -15,10 +15,14 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <algorithm>
+
 #include "base/logging.h"
+#include "base/timeutil.h"
 #include "ext/xxhash.h"
 #include "profiler/profiler.h"
 #include "Common/ChunkFile.h"
+#include "Common/FileUtil.h"
 #include "Common/StringUtils.h"
 
 #include "Core/Core.h"
@@ -46,6 +50,8 @@ IRJit::IRJit(MIPSState *mips) : frontend_(mips->HasDefaultPrefix()), mips_(mips)
 	IROptions opts{};
 	opts.disableFlags = g_Config.uJitDisableFlags;
 	opts.unalignedLoadStore = opts.disableFlags & (uint32_t)JitDisable::LSU_UNALIGNED;
+	opts.continueBranches = (opts.disableFlags & (uint32_t)JitDisable::SUPERBLOCKS) == 0;
+	opts.continueMaxInstructions = 300;
 	frontend_.SetOptions(opts);
 }
 
@@ -116,7 +122,7 @@ bool IRJit::CompileBlock(u32 em_address, std::vector<IRInst> &instructions, u32
 	}
 
 	IRBlock *b = blocks_.GetBlock(block_num);
-	b->SetInstructions(instructions);
+	b->SetInstructions(instructions, blocks_.AllocateInstructions((int)instructions.size()));
 	b->SetOriginalSize(mipsBytes);
 	if (preload) {
 		// Hash, then only update page stats, don't link yet.
@@ -204,6 +210,93 @@ void IRJit::CompileFunction(u32 start_address, u32 length) {
 	}
 }
 
+// Modeled on the GLES shader cache: we don't trust serialized IR across builds,
+// we only store where the blocks were. At boot those addresses get run back
+// through the frontend as preloads, so the game starts with its working set
+// already translated and stale code is caught by the normal preload hash check.
+#define BLOCK_CACHE_HEADER_MAGIC 0x524A4942
+#define BLOCK_CACHE_VERSION 1
+
+struct BlockCacheFileHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t numBlocks;
+	uint32_t reserved;
+};
+
+bool IRJit::SaveBlockCacheToFile(const std::string &filename) {
+	std::vector<std::pair<u32, u32>> ranges = blocks_.GetBlockRanges();
+	if (ranges.empty())
+		return false;
+
+	FILE *f = File::OpenCFile(filename, "wb");
+	if (!f) {
+		return false;
+	}
+	BlockCacheFileHeader header;
+	header.magic = BLOCK_CACHE_HEADER_MAGIC;
+	header.version = BLOCK_CACHE_VERSION;
+	header.numBlocks = (uint32_t)ranges.size();
+	header.reserved = 0;
+	fwrite(&header, sizeof(header), 1, f);
+	for (const auto &range : ranges) {
+		uint32_t entry[2]{ range.first, range.second };
+		fwrite(entry, sizeof(entry), 1, f);
+	}
+	fclose(f);
+	INFO_LOG(JIT, "Saved %d jit block addresses to '%s'", (int)ranges.size(), filename.c_str());
+	return true;
+}
+
+bool IRJit::LoadBlockCacheFromFile(const std::string &filename) {
+	File::IOFile f(filename, "rb");
+	if (!f.IsOpen()) {
+		return false;
+	}
+	BlockCacheFileHeader header;
+	if (!f.ReadArray(&header, 1)) {
+		return false;
+	}
+	if (header.magic != BLOCK_CACHE_HEADER_MAGIC || header.version != BLOCK_CACHE_VERSION) {
+		return false;
+	}
+	// Sanity check the file contents - way more blocks than any game's working set.
+	if (header.numBlocks > 200000) {
+		ERROR_LOG(JIT, "Corrupt jit block cache file header, aborting.");
+		return false;
+	}
+
+	time_update();
+	double start = time_now_d();
+
+	int translated = 0;
+	for (uint32_t i = 0; i < header.numBlocks; i++) {
+		uint32_t entry[2];
+		if (!f.ReadArray(entry, 2)) {
+			break;
+		}
+		const u32 addr = entry[0];
+		const u32 size = entry[1];
+		if (size == 0 || !Memory::IsValidAddress(addr) || !Memory::IsValidAddress(addr + size - 4)) {
+			continue;
+		}
+		if (blocks_.GetBlockNumberFromStartAddress(addr) >= 0) {
+			continue;
+		}
+		std::vector<IRInst> instructions;
+		u32 mipsBytes;
+		if (!CompileBlock(addr, instructions, mipsBytes, true)) {
+			ERROR_LOG(JIT, "Ran out of block numbers while pre-translating the block cache");
+			break;
+		}
+		translated++;
+	}
+
+	time_update();
+	NOTICE_LOG(JIT, "Pre-translated %d cached jit blocks in %0.1f milliseconds", translated, 1000.0 * (time_now_d() - start));
+	return true;
+}
+
 void IRJit::RunLoopUntil(u64 globalticks) {
 	PROFILE_THIS_SCOPE("jit");
 
@@ -259,6 +352,25 @@ void IRBlockCache::Clear() {
 	}
 	blocks_.clear();
 	byPage_.clear();
+
+	for (IRInst *chunk : arenaChunks_) {
+		delete[] chunk;
+	}
+	arenaChunks_.clear();
+	arenaChunkUsed_ = 0;
+	arenaChunkCapacity_ = 0;
+}
+
+IRInst *IRBlockCache::AllocateInstructions(int count) {
+	if (arenaChunkUsed_ + count > arenaChunkCapacity_) {
+		// Blocks bigger than a chunk simply get a chunk of their own.
+		arenaChunkCapacity_ = std::max(count, (int)ARENA_CHUNK_INSTS);
+		arenaChunks_.push_back(new IRInst[arenaChunkCapacity_]);
+		arenaChunkUsed_ = 0;
+	}
+	IRInst *result = arenaChunks_.back() + arenaChunkUsed_;
+	arenaChunkUsed_ += count;
+	return result;
 }
 
 void IRBlockCache::InvalidateICache(u32 address, u32 length) {
@@ -301,6 +413,20 @@ u32 IRBlockCache::AddressToPage(u32 addr) const {
 	return (addr & 0x3FFFFFFF) >> 10;
 }
 
+std::vector<std::pair<u32, u32>> IRBlockCache::GetBlockRanges() const {
+	std::vector<std::pair<u32, u32>> ranges;
+	ranges.reserve(blocks_.size());
+	for (const IRBlock &b : blocks_) {
+		if (!b.IsValid())
+			continue;
+		u32 start, size;
+		b.GetRange(start, size);
+		if (size != 0)
+			ranges.push_back(std::make_pair(start, size));
+	}
+	return ranges;
+}
+
 int IRBlockCache::FindPreloadBlock(u32 em_address) {
 	u32 page = AddressToPage(em_address);
 	auto iter = byPage_.find(page);
@@ -35,7 +35,6 @@
 
 namespace MIPSComp {
 
-// TODO : Use arena allocators. For now let's just malloc.
 class IRBlock {
 public:
 	IRBlock() : instr_(nullptr), numInstructions_(0), origAddr_(0), origSize_(0) {}
@@ -50,12 +49,9 @@ public:
 		b.instr_ = nullptr;
 	}
 
-	~IRBlock() {
-		delete[] instr_;
-	}
-
-	void SetInstructions(const std::vector<IRInst> &inst) {
-		instr_ = new IRInst[inst.size()];
+	// storage points into IRBlockCache's arena, which outlives the block.
+	void SetInstructions(const std::vector<IRInst> &inst, IRInst *storage) {
+		instr_ = storage;
 		numInstructions_ = (u16)inst.size();
 		if (!inst.empty()) {
 			memcpy(instr_, &inst[0], sizeof(IRInst) * inst.size());
@@ -101,6 +97,9 @@ private:
 class IRBlockCache : public JitBlockCacheDebugInterface {
 public:
 	IRBlockCache() {}
+	~IRBlockCache() {
+		Clear();
+	}
 	void Clear();
 	void InvalidateICache(u32 address, u32 length);
 	void FinalizeBlock(int i, bool preload = false);
@@ -119,6 +118,13 @@ public:
 
 	int FindPreloadBlock(u32 em_address);
 
+	// Bump-allocates instruction storage for a block. Blocks compiled in the
+	// same burst end up contiguous in memory; everything is freed in Clear().
+	IRInst *AllocateInstructions(int count);
+
+	// (start, size) of all valid blocks, for the persistent block cache.
+	std::vector<std::pair<u32, u32>> GetBlockRanges() const;
+
 	std::vector<u32> SaveAndClearEmuHackOps();
 	void RestoreSavedEmuHackOps(std::vector<u32> saved);
 
@@ -131,6 +137,16 @@ private:
 
 	std::vector<IRBlock> blocks_;
 	std::unordered_map<u32, std::vector<int>> byPage_;
+
+	// Arena chunks that block instruction storage draws from. Individual
+	// blocks are never freed (invalidation just unhooks them), so a plain
+	// bump allocator is all we need.
+	enum {
+		ARENA_CHUNK_INSTS = 64 * 1024,
+	};
+	std::vector<IRInst *> arenaChunks_;
+	int arenaChunkUsed_ = 0;
+	int arenaChunkCapacity_ = 0;
 };
 
 class IRJit : public JitInterface {
@@ -147,6 +163,9 @@ public:
 	void Compile(u32 em_address) override;	// Compiles a block at current MIPS PC
 	void CompileFunction(u32 start_address, u32 length) override;
 
+	bool SaveBlockCacheToFile(const std::string &filename) override;
+	bool LoadBlockCacheFromFile(const std::string &filename) override;
+
 	bool DescribeCodePtr(const u8 *ptr, std::string &name) override;
 	// Not using a regular block cache.
 	JitBlockCache *GetBlockCache() override { return nullptr; }
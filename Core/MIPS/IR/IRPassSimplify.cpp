@@ -782,6 +782,111 @@ bool IRMutatesDestGPR(const IRInst &inst, int reg) {
 	return (m->flags & IRFLAG_SRC3DST) != 0 && m->types[0] == 'G' && inst.src3 == reg;
 }
 
+// The IR only has extended basic blocks, so there's no real loop structure to
+// hoist invariants out of at this level. What we can do is catch the common
+// fallout: unrolled or "continued" loop bodies recomputing the same address or
+// index expression again and again. Simple local value numbering over the pure
+// ALU subset - anything still live in another register becomes a Mov, and
+// recomputations into the same register vanish. PurgeTemps cleans up after us.
+bool EliminateRedundantALU(const IRWriter &in, IRWriter &out, const IROptions &opts) {
+	struct Avail {
+		IRInst inst;
+		u8 dest;
+	};
+	std::vector<Avail> avail;
+
+	auto isCandidate = [](IROp op) {
+		switch (op) {
+		case IROp::Add: case IROp::Sub: case IROp::Neg: case IROp::Not:
+		case IROp::And: case IROp::Or: case IROp::Xor:
+		case IROp::AddConst: case IROp::SubConst:
+		case IROp::AndConst: case IROp::OrConst: case IROp::XorConst:
+		case IROp::Shl: case IROp::Shr: case IROp::Sar: case IROp::Ror:
+		case IROp::ShlImm: case IROp::ShrImm: case IROp::SarImm: case IROp::RorImm:
+		case IROp::Slt: case IROp::SltConst: case IROp::SltU: case IROp::SltUConst:
+		case IROp::Clz: case IROp::Max: case IROp::Min:
+		case IROp::BSwap16: case IROp::BSwap32:
+		case IROp::Ext8to32: case IROp::Ext16to32: case IROp::ReverseBits:
+			return true;
+		default:
+			return false;
+		}
+	};
+
+	bool logBlocks = false;
+	for (int i = 0, n = (int)in.GetInstructions().size(); i < n; i++) {
+		IRInst inst = in.GetInstructions()[i];
+		const IRMeta *m = GetIRMeta(inst.op);
+
+		// Anything that can touch arbitrary state invalidates everything.
+		if (inst.op == IROp::Interpret || inst.op == IROp::CallReplacement || inst.op == IROp::Syscall || inst.op == IROp::Break) {
+			avail.clear();
+			out.Write(inst);
+			continue;
+		}
+
+		bool candidate = isCandidate(inst.op) && inst.dest != 0;
+		if (candidate) {
+			for (size_t j = 0; j < avail.size(); j++) {
+				const Avail &a = avail[j];
+				if (a.inst.op == inst.op && a.inst.src1 == inst.src1 && a.inst.src2 == inst.src2 && a.inst.constant == inst.constant) {
+					logBlocks = true;
+					if (a.dest == inst.dest) {
+						// The value is already sitting in the right register.
+						inst.op = IROp::Mov;
+						inst.dest = 0;
+						inst.src1 = 0;
+					} else {
+						IRInst mov{ IROp::Mov };
+						mov.dest = inst.dest;
+						mov.src1 = a.dest;
+						mov.constant = 0;
+						inst = mov;
+					}
+					candidate = false;
+					break;
+				}
+			}
+		}
+
+		// Figure out which GPR this writes, if any, and kill stale entries.
+		int written = IRDestGPR(inst);
+		if (written < 0 && (m->flags & IRFLAG_SRC3DST) != 0 && m->types[0] == 'G') {
+			written = inst.src3;
+		}
+		if (written > 0) {
+			for (size_t j = 0; j < avail.size(); ) {
+				const Avail &a = avail[j];
+				const IRMeta *am = GetIRMeta(a.inst.op);
+				bool readsWritten = (am->types[1] == 'G' && a.inst.src1 == written) ||
+					(am->types[2] == 'G' && a.inst.src2 == written);
+				if (a.dest == written || readsWritten) {
+					avail.erase(avail.begin() + j);
+				} else {
+					j++;
+				}
+			}
+		}
+
+		// The expression only becomes available if it doesn't read its own dest
+		// (induction steps like "addiu a0, a0, 4" read the old value.)
+		if (candidate && !IRReadsFromGPR(inst, inst.dest)) {
+			if (avail.size() >= 64) {
+				avail.erase(avail.begin());
+			}
+			Avail a;
+			a.inst = inst;
+			a.dest = inst.dest;
+			avail.push_back(a);
+		}
+
+		if (inst.op != IROp::Mov || inst.dest != 0 || inst.src1 != 0) {
+			out.Write(inst);
+		}
+	}
+	return logBlocks;
+}
+
 bool PurgeTemps(const IRWriter &in, IRWriter &out, const IROptions &opts) {
 	std::vector<IRInst> insts;
 	insts.reserve(in.GetInstructions().size());
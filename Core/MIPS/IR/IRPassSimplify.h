@@ -8,6 +8,7 @@ bool IRApplyPasses(const IRPassFunc *passes, size_t c, const IRWriter &in, IRWri
 // Block optimizer passes of varying usefulness.
 bool RemoveLoadStoreLeftRight(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool PropagateConstants(const IRWriter &in, IRWriter &out, const IROptions &opts);
+bool EliminateRedundantALU(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool PurgeTemps(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool ReduceLoads(const IRWriter &in, IRWriter &out, const IROptions &opts);
 bool ThreeOpToTwoOp(const IRWriter &in, IRWriter &out, const IROptions &opts);
@@ -42,6 +42,7 @@
 
 #include "Core/MIPS/JitCommon/JitBlockCache.h"
 #include "Core/MIPS/JitCommon/JitCommon.h"
+#include "ext/xxhash.h"
 
 // #include "JitBase.h"
 
@@ -148,6 +149,9 @@ int JitBlockCache::AllocateBlock(u32 startAddress) {
 
 	b.invalid = false;
 	b.originalAddress = startAddress;
+	b.executions = 0;
+	b.compileTier = 0;
+	b.codeHash = 0;
 	for (int i = 0; i < MAX_JIT_BLOCK_EXITS; ++i) {
 		b.exitAddress[i] = INVALID_EXIT;
 		b.exitPtrs[i] = 0;
@@ -174,6 +178,9 @@ void JitBlockCache::ProxyBlock(u32 rootAddress, u32 startAddress, u32 size, cons
 	b.invalid = false;
 	b.originalAddress = startAddress;
 	b.originalSize = size;
+	b.executions = 0;
+	b.compileTier = 0;
+	b.codeHash = 0;
 	for (int i = 0; i < MAX_JIT_BLOCK_EXITS; ++i) {
 		b.exitAddress[i] = INVALID_EXIT;
 		b.exitPtrs[i] = 0;
@@ -227,6 +234,22 @@ static void ExpandRange(std::pair<u32, u32> &range, u32 newStart, u32 newEnd) {
 	range.second = std::max(range.second, newEnd);
 }
 
+u32 JitBlockCache::ComputeBlockHash(int block_num) const {
+	const JitBlock &b = blocks_[block_num];
+	if (!Memory::IsValidRange(b.originalAddress, b.originalSize * 4))
+		return 0;
+
+	XXH32_state_t state;
+	XXH32_reset(&state, 0xC0DEC0DE);
+	for (u32 i = 0; i < b.originalSize; i++) {
+		// Resolve emuhacks, so the hash doesn't depend on which overlapping
+		// blocks happen to be compiled at the time.
+		const u32 inst = Memory::ReadUnchecked_Instruction(b.originalAddress + i * 4, false).encoding;
+		XXH32_update(&state, &inst, sizeof(inst));
+	}
+	return XXH32_digest(&state);
+}
+
 void JitBlockCache::FinalizeBlock(int block_num, bool block_link) {
 	JitBlock &b = blocks_[block_num];
 
@@ -234,6 +257,8 @@ void JitBlockCache::FinalizeBlock(int block_num, bool block_link) {
 	MIPSOpcode opcode = GetEmuHackOpForBlock(block_num);
 	Memory::Write_Opcode_JIT(b.originalAddress, opcode);
 
+	b.codeHash = ComputeBlockHash(block_num);
+
 	AddBlockMap(block_num);
 
 	if (block_link) {
@@ -425,16 +450,24 @@ void JitBlockCache::LinkBlock(int i) {
 	}
 }
 
-void JitBlockCache::UnlinkBlock(int i) {
+void JitBlockCache::UnlinkBlock(int i, bool rewriteExits) {
 	JitBlock &b = blocks_[i];
 	auto ppp = links_to_.equal_range(b.originalAddress);
 	if (ppp.first == ppp.second)
 		return;
 	for (auto iter = ppp.first; iter != ppp.second; ++iter) {
 		JitBlock &sourceBlock = blocks_[iter->second];
+		if (sourceBlock.invalid)
+			continue;
 		for (int e = 0; e < MAX_JIT_BLOCK_EXITS; e++) {
-			if (sourceBlock.exitAddress[e] == b.originalAddress)
+			if (sourceBlock.exitAddress[e] == b.originalAddress && sourceBlock.linkStatus[e]) {
+				// Retarget the exit at the dispatcher again, so it doesn't hop through
+				// the dead block's entry trampoline forever. If a new block shows up
+				// at this address, FinalizeBlock will relink through links_to_.
+				if (rewriteExits)
+					MIPSComp::jit->UnlinkBlockExit(sourceBlock.exitPtrs[e], sourceBlock.exitAddress[e]);
 				sourceBlock.linkStatus[e] = false;
+			}
 		}
 	}
 }
@@ -531,7 +564,9 @@ void JitBlockCache::DestroyBlock(int block_num, DestroyType type) {
 	// It's not safe to set normalEntry to 0 here, since we use a binary search
 	// that looks at that later to find blocks. Marking it invalid is enough.
 
-	UnlinkBlock(block_num);
+	// When clearing the whole cache, the exits will be poisoned anyway - don't
+	// bother rewriting them one by one.
+	UnlinkBlock(block_num, type != DestroyType::CLEAR);
 
 	// Don't change the jit code when invalidating a pure proxy block.
 	if (b->IsPureProxy()) {
@@ -574,7 +609,19 @@ void JitBlockCache::InvalidateICache(u32 address, const u32 length) {
 			const u32 blockStart = next->first.second;
 			const u32 blockEnd = next->first.first;
 			if (blockStart < pEnd && blockEnd > pAddr) {
-				DestroyBlock(next->second, DestroyType::INVALIDATE);
+				const int block_num = next->second;
+				JitBlock &b = blocks_[block_num];
+				// Games routinely invalidate a much larger range than they wrote.
+				// If the block's code is intact, let it live.
+				if (!b.invalid && !b.IsPureProxy() && ComputeBlockHash(block_num) == b.codeHash) {
+					// The write may have replaced our entry emuhack with the
+					// identical original opcode - reinstall it.
+					const MIPSOpcode emuhack = GetEmuHackOpForBlock(block_num);
+					if (Memory::ReadUnchecked_U32(b.originalAddress) != emuhack.encoding)
+						Memory::Write_Opcode_JIT(b.originalAddress, emuhack);
+					continue;
+				}
+				DestroyBlock(block_num, DestroyType::INVALIDATE);
 				// Our iterator is now invalid.  Break and search again.
 				// Most of the time there shouldn't be a bunch of matching blocks.
 				goto restart;
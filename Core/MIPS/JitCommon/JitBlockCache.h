@@ -27,7 +27,8 @@
 #include "Core/MIPS/MIPSAnalyst.h"
 #include "Core/MIPS/MIPS.h"
 
-#if defined(ARM) || defined(ARM64)
+#if defined(ARM)
+// Keeps JitBlock small on memory-constrained 32-bit devices.
 const int MAX_JIT_BLOCK_EXITS = 2;
 #else
 const int MAX_JIT_BLOCK_EXITS = 8;
@@ -71,6 +72,15 @@ struct JitBlock {
 	u16 originalSize;
 	u16 blockNum;
 
+	// Tiered recompilation. Tier-0 block prologues bump the counter themselves,
+	// so this must stay cheap to address from generated code.
+	u32 executions;
+	u8 compileTier;  // 0 = baseline one-shot codegen, 1 = hot recompile
+
+	// XXH32 of the original MIPS words, so InvalidateICache() can tell blocks
+	// that were actually overwritten from ones merely inside the flushed range.
+	u32 codeHash;
+
 	bool invalid;
 	bool linkStatus[MAX_JIT_BLOCK_EXITS];
 
@@ -171,11 +181,13 @@ public:
 private:
 	void LinkBlockExits(int i);
 	void LinkBlock(int i);
-	void UnlinkBlock(int i);
+	void UnlinkBlock(int i, bool rewriteExits);
 
 	void AddBlockMap(int block_num);
 	void RemoveBlockMap(int block_num);
 
+	u32 ComputeBlockHash(int block_num) const;
+
 	MIPSOpcode GetEmuHackOpForBlock(int block_num) const;
 
 	CodeBlockCommon *codeBlock_;
@@ -130,10 +130,20 @@ namespace MIPSComp {
 		virtual void RunLoopUntil(u64 globalticks) = 0;
 		virtual void Compile(u32 em_address) = 0;
 		virtual void CompileFunction(u32 start_address, u32 length) { }
+		// Called at a safe point (no jit code running) so backends can batch up
+		// pending hot-block recompiles back-to-back, keeping the hot working set
+		// contiguous in the code arena. Optional.
+		virtual void CompactHotBlocks() { }
 		virtual void ClearCache() = 0;
 		virtual void UpdateFCR31() = 0;
 		virtual MIPSOpcode GetOriginalOp(MIPSOpcode op) = 0;
 
+		// Per-game persistent block cache, so the next boot of the same game can
+		// pre-translate the working set instead of compiling it from cold.
+		// Not supported by all backends.
+		virtual bool SaveBlockCacheToFile(const std::string &filename) { return false; }
+		virtual bool LoadBlockCacheFromFile(const std::string &filename) { return false; }
+
 		// No jit operations may be run between these calls.
 		// Meant to be used to make memory safe for savestates, memcpy, etc.
 		virtual std::vector<u32> SaveAndClearEmuHackOps() = 0;
@@ -143,6 +153,11 @@ namespace MIPSComp {
 		// like that.
 		virtual void LinkBlock(u8 *exitPoint, const u8 *entryPoint) = 0;
 		virtual void UnlinkBlock(u8 *checkedEntry, u32 originalAddress) = 0;
+		// Rewrites a previously linked exit back to a plain dispatcher exit, so
+		// transitions into invalidated code don't double-hop through the dead
+		// block's entry trampoline. Backends that don't implement this still
+		// work - the trampoline path stays correct, just slower.
+		virtual void UnlinkBlockExit(u8 *exitPoint, u32 destination) { }
 	};
 
 	typedef void (MIPSFrontendInterface::*MIPSCompileFunc)(MIPSOpcode opcode);
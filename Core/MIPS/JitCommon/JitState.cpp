@@ -52,6 +52,14 @@ namespace MIPSComp {
 		continueBranches = false;
 		continueJumps = false;
 		continueMaxInstructions = 300;
+		// Cheaper than full continueJumps - only follows jals to tiny straight
+		// leaf functions, where the jr ra then folds away entirely.
+		inlineSmallFunctions = !Disabled(JitDisable::INLINE);
+
+		// Very hot blocks get a second trip through codegen with the expensive
+		// "continue" options enabled, which tier-0 compiles don't pay for.
+		enableBlockReopt = !Disabled(JitDisable::REOPT);
+		blockReoptThreshold = 2000;
 
 		useStaticAlloc = false;
 		enablePointerify = false;
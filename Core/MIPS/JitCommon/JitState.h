@@ -207,6 +207,11 @@ namespace MIPSComp {
 		CACHE_POINTERS = 0x01000000,
 		REGALLOC_GPR = 0x02000000,  // Doesn't really disable regalloc, but flushes after every instr.
 		REGALLOC_FPR = 0x04000000,
+		REOPT = 0x00010000,
+		SUPERBLOCKS = 0x00020000,
+		INLINE = 0x00040000,
+		IDLELOOPS = 0x00080000,
+
 		VFPU_MTX_VMMOV = 0x08000000,
 		VFPU_MTX_VMMUL = 0x10000000,
 		VFPU_MTX_VMSCL = 0x20000000,
@@ -243,6 +248,11 @@ namespace MIPSComp {
 		bool continueBranches;
 		bool continueJumps;
 		int continueMaxInstructions;
+		bool inlineSmallFunctions;
+
+		// Tiered recompilation (so far only wired up in the x86 backend.)
+		bool enableBlockReopt;
+		int blockReoptThreshold;
 	};
 
 }
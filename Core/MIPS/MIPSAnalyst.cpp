@@ -24,6 +24,7 @@
 #include "base/timeutil.h"
 #include "ext/cityhash/city.h"
 #include "Common/FileUtil.h"
+#include "Common/ThreadPools.h"
 #include "Core/Config.h"
 #include "Core/MemMap.h"
 #include "Core/System.h"
@@ -44,10 +45,13 @@ typedef std::vector<MIPSAnalyst::AnalyzedFunction> FunctionsVector;
 static FunctionsVector functions;
 std::recursive_mutex functions_lock;
 
-// One function can appear in multiple copies in memory, and they will all have 
+// One function can appear in multiple copies in memory, and they will all have
 // the same hash and should all be replaced if possible.
 static std::unordered_multimap<u64, MIPSAnalyst::AnalyzedFunction *> hashToFunction;
 
+// Functions waiting to be precompiled, a time slice at a time. Guarded by functions_lock.
+static std::vector<u32> precompileQueue;
+
 struct HashMapFunc {
 	char name[64];
 	u64 hash;
@@ -569,6 +573,78 @@ namespace MIPSAnalyst {
 		return (op >> 26) == 0 && (op & 0x3f) == 12;
 	}
 
+	bool IsBusyWaitLoop(u32 branchAddr, u32 targetAddr) {
+		// Only self-loops or very tight backward loops qualify - the classic
+		// "spin until a flag in memory changes" idiom.
+		if (targetAddr > branchAddr || branchAddr - targetAddr > 8)
+			return false;
+		if (!Memory::IsValidRange(targetAddr, branchAddr + 8 - targetAddr))
+			return false;
+
+		// Everything in the loop body (and the delay slot) has to be free of
+		// side effects, or skipping iterations would be observable. We only
+		// accept nops and plain loads - the load being the flag poll.
+		for (u32 addr = targetAddr; addr <= branchAddr + 4; addr += 4) {
+			if (addr == branchAddr)
+				continue;  // The branch itself.
+			MIPSOpcode op = Memory::Read_Instruction(addr, true);
+			if (op == MIPS_MAKE_NOP())
+				continue;
+			MIPSInfo info = MIPSGetInfo(op);
+			if ((info & IN_MEM) != 0 && (info & OUT_MEM) == 0)
+				continue;
+			return false;
+		}
+		return true;
+	}
+
+	bool IsProvenRAMBase(MIPSGPReg reg, u32 addr, u32 segmentStart) {
+		// sp and gp are the stack and module small-data pointers - always main
+		// RAM, never MMIO. Nothing technically stops a game from pointing them
+		// at hardware, but none do.
+		if (reg == MIPS_REG_SP || reg == MIPS_REG_GP)
+			return true;
+
+		// Otherwise, walk backwards through the straight-line code looking for
+		// the op that produced the value. segmentStart must be the start of the
+		// current *contiguous* run of instructions - for continued/inlined
+		// blocks that's the last continuation target, not the block start,
+		// since instructions before a splice point are from a different part
+		// of the program entirely. Within a segment nothing can jump in
+		// between us and the producer: branch targets start new blocks (or new
+		// segments), and everything earlier in the segment has executed by the
+		// time we get here.
+		const int MAX_SCAN_OPS = 16;
+		u32 stop = addr - segmentStart > MAX_SCAN_OPS * 4 ? addr - MAX_SCAN_OPS * 4 : segmentStart;
+		if (!Memory::IsValidRange(stop, addr - stop))
+			return false;
+		for (u32 pc = addr; pc > stop; ) {
+			pc -= 4;
+			MIPSOpcode op = Memory::Read_Instruction(pc, true);
+			if (GetOutGPReg(op) != reg)
+				continue;
+
+			// addiu reg, sp/gp, imm - the common "address of local/global" op.
+			if ((op & MIPSTABLE_IMM_MASK) == 0x24000000) {
+				MIPSGPReg rs = MIPS_GET_RS(op);
+				return rs == MIPS_REG_SP || rs == MIPS_REG_GP;
+			}
+			// move reg, sp/gp (addu or or with zero.)
+			if ((op & 0xFC0007FF) == 0x00000021 || (op & 0xFC0007FF) == 0x00000025) {
+				MIPSGPReg rs = MIPS_GET_RS(op);
+				MIPSGPReg rt = MIPS_GET_RT(op);
+				if (rt == MIPS_REG_ZERO && (rs == MIPS_REG_SP || rs == MIPS_REG_GP))
+					return true;
+				if (rs == MIPS_REG_ZERO && (rt == MIPS_REG_SP || rt == MIPS_REG_GP))
+					return true;
+				return false;
+			}
+			// Produced some other way - can't prove anything.
+			return false;
+		}
+		return false;
+	}
+
 	static bool IsSWInstr(MIPSOpcode op) {
 		return (op & MIPSTABLE_IMM_MASK) == 0xAC000000;
 	}
@@ -748,6 +824,7 @@ namespace MIPSAnalyst {
 		std::lock_guard<std::recursive_mutex> guard(functions_lock);
 		functions.clear();
 		hashToFunction.clear();
+		precompileQueue.clear();
 	}
 
 	void UpdateHashToFunctionMap() {
@@ -872,40 +949,89 @@ namespace MIPSAnalyst {
 		return DetermineRegisterUsage(reg, addr, instrs) == USAGE_CLOBBERED;
 	}
 
+	static void HashFunction(AnalyzedFunction &f) {
+		if (!Memory::IsValidRange(f.start, f.end - f.start + 4)) {
+			return;
+		}
+
+		// This is unfortunate.  In case of emuhacks or relocs, we have to make a copy.
+		std::vector<u32> buffer;
+		buffer.resize((f.end - f.start + 4) / 4);
+		size_t pos = 0;
+		for (u32 addr = f.start; addr <= f.end; addr += 4) {
+			u32 validbits = 0xFFFFFFFF;
+			MIPSOpcode instr = Memory::ReadUnchecked_Instruction(addr, true);
+			if (MIPS_IS_EMUHACK(instr)) {
+				f.hasHash = false;
+				return;
+			}
+
+			MIPSInfo flags = MIPSGetInfo(instr);
+			if (flags & IN_IMM16)
+				validbits &= ~0xFFFF;
+			if (flags & IN_IMM26)
+				validbits &= ~0x03FFFFFF;
+			buffer[pos++] = instr & validbits;
+		}
+
+		f.hash = CityHash64((const char *) &buffer[0], buffer.size() * sizeof(u32));
+		f.hasHash = true;
+	}
+
 	void HashFunctions() {
 		std::lock_guard<std::recursive_mutex> guard(functions_lock);
-		std::vector<u32> buffer;
 
+		// Most calls only add a few functions (module loads, RegisterFunction),
+		// so skip the ones that are already hashed.
+		std::vector<AnalyzedFunction *> toHash;
+		toHash.reserve(functions.size());
 		for (auto iter = functions.begin(), end = functions.end(); iter != end; iter++) {
-			AnalyzedFunction &f = *iter;
-			if (!Memory::IsValidRange(f.start, f.end - f.start + 4)) {
-				continue;
+			if (!iter->hasHash)
+				toHash.push_back(&*iter);
+		}
+		if (toHash.empty())
+			return;
+
+		// Hashing reads back every instruction of every function, which is most
+		// of the analysis cost at load - and each function is independent, so
+		// spread them across the worker pool.
+		GlobalThreadPool::Loop([&toHash](int low, int high) {
+			for (int i = low; i < high; i++) {
+				HashFunction(*toHash[i]);
 			}
+		}, 0, (int)toHash.size());
+	}
 
-			// This is unfortunate.  In case of emuhacks or relocs, we have to make a copy.
-			buffer.resize((f.end - f.start + 4) / 4);
-			size_t pos = 0;
-			for (u32 addr = f.start; addr <= f.end; addr += 4) {
-				u32 validbits = 0xFFFFFFFF;
-				MIPSOpcode instr = Memory::ReadUnchecked_Instruction(addr, true);
-				if (MIPS_IS_EMUHACK(instr)) {
-					f.hasHash = false;
-					goto skip;
-				}
+	bool IsInlineableCallTarget(u32 addr, int maxInstructions) {
+		std::lock_guard<std::recursive_mutex> guard(functions_lock);
 
-				MIPSInfo flags = MIPSGetInfo(instr);
-				if (flags & IN_IMM16)
-					validbits &= ~0xFFFF;
-				if (flags & IN_IMM26)
-					validbits &= ~0x03FFFFFF;
-				buffer[pos++] = instr & validbits;
-			}
+		for (auto iter = functions.begin(), end = functions.end(); iter != end; iter++) {
+			if (iter->start != addr)
+				continue;
 
-			f.hash = CityHash64((const char *) &buffer[0], buffer.size() * sizeof(u32));
-			f.hasHash = true;
-skip:
-			;
+			u32 instrs = (iter->end - iter->start + 4) / 4;
+			if (!iter->isStraightLeaf || instrs < 2 || instrs > (u32)maxInstructions)
+				return false;
+			if (!Memory::IsValidRange(iter->start, instrs * 4))
+				return false;
+			// Must end in jr ra - a straight leaf could also fall off into a tail call.
+			if (Memory::Read_Instruction(iter->end - 4, true) != MIPS_MAKE_JR_RA())
+				return false;
+			// isStraightLeaf only rules out branches.  Also reject anything else
+			// that diverts or ends the block (jumps, syscalls, breaks.)
+			for (u32 ahead = iter->start; ahead <= iter->end; ahead += 4) {
+				if (ahead == iter->end - 4)
+					continue;
+				MIPSOpcode op = Memory::Read_Instruction(ahead, true);
+				if (MIPSGetInfo(op) & (DELAYSLOT | IS_JUMP | IS_CONDBRANCH))
+					return false;
+				// syscall / break
+				if ((op & 0xFC00003F) == 12 || (op & 0xFC00003F) == 13)
+					return false;
+			}
+			return true;
 		}
+		return false;
 	}
 
 	void PrecompileFunction(u32 startAddr, u32 length) {
@@ -923,15 +1049,45 @@ skip:
 
 		// TODO: Load from cache file if available instead.
 
-		double st = real_time_now();
+		// Compiling everything immediately can stall for hundreds of milliseconds
+		// when a game streams in an overlay mid-play, so just queue the functions
+		// here. ProcessPrecompileQueue() drains the queue a slice at a time.
+		precompileQueue.reserve(precompileQueue.size() + functions.size());
 		for (auto iter = functions.begin(), end = functions.end(); iter != end; iter++) {
-			const AnalyzedFunction &f = *iter;
+			precompileQueue.push_back(iter->start);
+		}
+
+		INFO_LOG(JIT, "Queued %d MIPS functions for precompile", (int)functions.size());
+	}
+
+	void ProcessPrecompileQueue(double maxTimeSlice) {
+		std::lock_guard<std::recursive_mutex> guard(functions_lock);
+		if (precompileQueue.empty() || !MIPSComp::jit) {
+			return;
+		}
+
+		double st = real_time_now();
+		int processed = 0;
+		while (!precompileQueue.empty()) {
+			u32 start = precompileQueue.back();
+			precompileQueue.pop_back();
+			processed++;
+
+			// The function may have been overwritten or forgotten since it was queued.
+			for (auto iter = functions.begin(), end = functions.end(); iter != end; iter++) {
+				if (iter->start == start) {
+					PrecompileFunction(iter->start, iter->end - iter->start + 4);
+					break;
+				}
+			}
 
-			PrecompileFunction(f.start, f.end - f.start + 4);
+			if (real_time_now() - st >= maxTimeSlice)
+				break;
 		}
-		double et = real_time_now();
 
-		NOTICE_LOG(JIT, "Precompiled %d MIPS functions in %0.2f milliseconds", (int)functions.size(), (et - st) * 1000.0);
+		if (precompileQueue.empty()) {
+			NOTICE_LOG(JIT, "Drained precompile queue (%d functions in the last %0.2f ms slice)", processed, (real_time_now() - st) * 1000.0);
+		}
 	}
 
 	static const char *DefaultFunctionName(char buffer[256], u32 startAddr) {
@@ -1211,7 +1367,7 @@ skip:
 		}
 
 		// Cheats a little.
-		AnalyzedFunction fun;
+		AnalyzedFunction fun{};
 		fun.start = startAddr;
 		fun.end = startAddr + size - 4;
 		fun.isStraightLeaf = false;  // dunno really
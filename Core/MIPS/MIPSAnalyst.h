@@ -111,6 +111,14 @@ namespace MIPSAnalyst
 	void ForgetFunctions(u32 startAddr, u32 endAddr);
 	void PrecompileFunctions();
 	void PrecompileFunction(u32 startAddr, u32 length);
+	// Compiles queued functions for at most maxTimeSlice seconds. Must be called
+	// from the CPU thread at a point where no jit code is running.
+	void ProcessPrecompileQueue(double maxTimeSlice);
+
+	// True if a scanned function starts at addr, is straight-line code ending in
+	// jr ra, and fits in maxInstructions. Used by the jit to inline tiny leaf
+	// callees at jal sites.
+	bool IsInlineableCallTarget(u32 addr, int maxInstructions);
 
 	void SetHashMapFilename(const std::string& filename = "");
 	void LoadBuiltinHashMap();
@@ -132,6 +140,16 @@ namespace MIPSAnalyst
 	bool IsDelaySlotNiceVFPU(MIPSOpcode branchOp, MIPSOpcode op);
 	bool IsDelaySlotNiceFPU(MIPSOpcode branchOp, MIPSOpcode op);
 	bool IsSyscall(MIPSOpcode op);
+	// True if branchAddr is the backward branch of a tight, side-effect-free
+	// busy-wait loop (just polling memory), so iterations can be skipped.
+	bool IsBusyWaitLoop(u32 branchAddr, u32 targetAddr);
+	// True if reg at addr provably holds a pointer into main RAM (sp, gp, or
+	// a constant offset off one of them), so the jit can skip the address
+	// bounds machinery. segmentStart bounds the backward scan for the
+	// producing op and must be the start of the current contiguous run of
+	// instructions - the last continuation target for continued/inlined
+	// blocks, not the block start.
+	bool IsProvenRAMBase(MIPSGPReg reg, u32 addr, u32 segmentStart);
 
 	bool OpWouldChangeMemory(u32 pc, u32 addr, u32 size);
 	int OpMemoryAccessSize(u32 pc);
@@ -939,9 +939,31 @@ void MIPSDisAsm(MIPSOpcode op, u32 pc, char *out, bool tabsToSpaces) {
 	}
 }
 
+// The table walk in MIPSGetInstruction costs more than many of the handlers it resolves,
+// and the tables are const - an instruction word always decodes the same way. So we keep a
+// small direct-mapped cache of resolved handlers, keyed on the full opcode encoding.
+enum {
+	INTERPRET_CACHE_SIZE = 4096,  // Must be a power of two.
+};
+
+struct InterpretCacheEntry {
+	u32 encoding;
+	MIPSInterpretFunc func;
+};
+
+static InterpretCacheEntry interpretCache[INTERPRET_CACHE_SIZE];
+
 void MIPSInterpret(MIPSOpcode op) {
+	// Fold the opcode/funct fields together - register fields alone shouldn't pick the slot.
+	InterpretCacheEntry &entry = interpretCache[(op.encoding ^ (op.encoding >> 19)) & (INTERPRET_CACHE_SIZE - 1)];
+	if (entry.encoding == op.encoding && entry.func) {
+		entry.func(op);
+		return;
+	}
 	const MIPSInstruction *instr = MIPSGetInstruction(op);
 	if (instr && instr->interpret) {
+		entry.encoding = op.encoding;
+		entry.func = instr->interpret;
 		instr->interpret(op);
 	} else {
 		ERROR_LOG_REPORT(CPU, "Unknown instruction %08x at %08x", op.encoding, currentMIPS->pc);
@@ -29,7 +29,7 @@
 #define V(i)   (currentMIPS->v[voffset[i]])
 #define VI(i)  (currentMIPS->vi[voffset[i]])
 
-void GetVectorRegs(u8 regs[4], VectorSize N, int vectorReg) {
+static void DecodeVectorRegs(u8 regs[4], VectorSize N, int vectorReg) {
 	int mtx = (vectorReg >> 2) & 7;
 	int col = vectorReg & 3;
 	int row = 0;
@@ -54,7 +54,7 @@ void GetVectorRegs(u8 regs[4], VectorSize N, int vectorReg) {
 	}
 }
 
-void GetMatrixRegs(u8 regs[16], MatrixSize N, int matrixReg) {
+static void DecodeMatrixRegs(u8 regs[16], MatrixSize N, int matrixReg) {
 	int mtx = (matrixReg >> 2) & 7;
 	int col = matrixReg & 3;
 
@@ -82,6 +82,41 @@ void GetMatrixRegs(u8 regs[16], MatrixSize N, int matrixReg) {
 	}
 }
 
+namespace {
+
+// The register-naming decode above runs for every VFPU op the jits compile and
+// in various overlap checks, so it's done once up front for all (size, reg)
+// combinations and the public functions just copy out the indices.
+struct VFPURegLayouts {
+	u8 vector[4][128][4];
+	u8 matrix[4][128][16];
+
+	VFPURegLayouts() {
+		memset(this, 0, sizeof(*this));
+		for (int reg = 0; reg < 128; reg++) {
+			for (int sz = 1; sz <= 4; sz++) {
+				DecodeVectorRegs(vector[sz - 1][reg], (VectorSize)sz, reg);
+				DecodeMatrixRegs(matrix[sz - 1][reg], (MatrixSize)sz, reg);
+			}
+		}
+	}
+};
+
+static const VFPURegLayouts vfpuRegLayouts;
+
+}  // namespace
+
+void GetVectorRegs(u8 regs[4], VectorSize N, int vectorReg) {
+	_assert_msg_(JIT, N >= V_Single && N <= V_Quad, "%s: Bad vector size", __FUNCTION__);
+	// Only N entries - some callers pass arrays sized to the vector length.
+	memcpy(regs, vfpuRegLayouts.vector[N - 1][vectorReg & 0x7F], N);
+}
+
+void GetMatrixRegs(u8 regs[16], MatrixSize N, int matrixReg) {
+	_assert_msg_(JIT, N >= M_1x1 && N <= M_4x4, "%s: Bad matrix size", __FUNCTION__);
+	memcpy(regs, vfpuRegLayouts.matrix[N - 1][matrixReg & 0x7F], 16);
+}
+
 int GetMatrixName(int matrix, MatrixSize msize, int column, int row, bool transposed) {
 	// TODO: Fix (?)
 	int name = (matrix * 4) | (transposed << 5);
@@ -633,13 +633,12 @@ void Jit::Comp_Jump(MIPSOpcode op) {
 		if (ReplaceJalTo(targetAddr))
 			return;
 
-		// Check for small function inlining (future)
-		
-
 		// Save return address - might be overwritten by delay slot.
 		gpr.SetImm(MIPS_REG_RA, GetCompilerPC() + 8);
 		CompileDelaySlot(DELAYSLOT_NICE);
-		if (CanContinueJump(targetAddr))
+		// Small leaf functions get inlined here: compilation continues into the
+		// callee, and its jr ra continues back (RA is a known immediate.)
+		if (CanContinueJump(targetAddr) || CanInlineJal(targetAddr))
 		{
 			AddContinuedBlock(targetAddr);
 			// Account for the increment in the loop.
@@ -709,7 +708,7 @@ void Jit::Comp_JumpReg(MIPSOpcode op)
 			gpr.DiscardRegContentsIfCached(MIPS_REG_T9);
 		}
 
-		if (gpr.IsImm(rs) && CanContinueJump(gpr.GetImm(rs)))
+		if (gpr.IsImm(rs) && (CanContinueJump(gpr.GetImm(rs)) || (rs == MIPS_REG_RA && !andLink && CanContinueImmReturn(gpr.GetImm(rs)))))
 		{
 			AddContinuedBlock(gpr.GetImm(rs));
 			// Account for the increment in the loop.
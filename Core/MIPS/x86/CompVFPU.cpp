@@ -2215,7 +2215,7 @@ void Jit::Comp_VV2Op(MIPSOpcode op) {
 #else
 		LEA(64, RDI, MIPSSTATE_VAR(sincostemp[0]));
 #endif
-		ABI_CallFunction(thunks.ProtectFunction((const void *)sinCosFunc, 0));
+		ABI_CallFunction(thunks.ProtectFunction((const void *)sinCosFunc, 0, gpr.GetInUseXRegMask(), fpr.GetInUseXRegMask()));
 #else
 		// Sigh, passing floats with cdecl isn't pretty, ends up on the stack.
 		if (fpr.V(sreg).IsSimpleReg()) {
@@ -2899,18 +2899,32 @@ void Jit::Comp_Vmmul(MIPSOpcode op) {
 		// Now, work our way through the matrix, loading things as we go.
 		// TODO: With more temp registers, can generate much more efficient code.
 		for (int i = 0; i < n; i++) {
-			MOVSS(XMM1, fpr.V(tregs[4 * i]));  // TODO: AVX broadcastss to replace this and the SHUFPS
-			MOVSS(XMM0, fpr.V(tregs[4 * i + 1]));
-			SHUFPS(XMM1, R(XMM1), _MM_SHUFFLE(0, 0, 0, 0));
-			SHUFPS(XMM0, R(XMM0), _MM_SHUFFLE(0, 0, 0, 0));
-			MULPS(XMM1, fpr.VS(scol[0]));
-			MULPS(XMM0, fpr.VS(scol[1]));
-			ADDPS(XMM1, R(XMM0));
-			for (int j = 2; j < n; j++) {
-				MOVSS(XMM0, fpr.V(tregs[4 * i + j]));
+			if (cpu_info.bFMA3) {
+				// One fused multiply-add per T column instead of a MULPS/ADDPS pair.
+				// The product isn't rounded separately, but this path is already not
+				// bit-exact (see the MoreAccurateVMMUL fallback above.)
+				MOVSS(XMM1, fpr.V(tregs[4 * i]));  // TODO: AVX broadcastss to replace this and the SHUFPS
+				SHUFPS(XMM1, R(XMM1), _MM_SHUFFLE(0, 0, 0, 0));
+				MULPS(XMM1, fpr.VS(scol[0]));
+				for (int j = 1; j < n; j++) {
+					MOVSS(XMM0, fpr.V(tregs[4 * i + j]));
+					SHUFPS(XMM0, R(XMM0), _MM_SHUFFLE(0, 0, 0, 0));
+					VFMADD231PS(XMM1, XMM0, fpr.VS(scol[j]));
+				}
+			} else {
+				MOVSS(XMM1, fpr.V(tregs[4 * i]));  // TODO: AVX broadcastss to replace this and the SHUFPS
+				MOVSS(XMM0, fpr.V(tregs[4 * i + 1]));
+				SHUFPS(XMM1, R(XMM1), _MM_SHUFFLE(0, 0, 0, 0));
 				SHUFPS(XMM0, R(XMM0), _MM_SHUFFLE(0, 0, 0, 0));
-				MULPS(XMM0, fpr.VS(scol[j]));
+				MULPS(XMM1, fpr.VS(scol[0]));
+				MULPS(XMM0, fpr.VS(scol[1]));
 				ADDPS(XMM1, R(XMM0));
+				for (int j = 2; j < n; j++) {
+					MOVSS(XMM0, fpr.V(tregs[4 * i + j]));
+					SHUFPS(XMM0, R(XMM0), _MM_SHUFFLE(0, 0, 0, 0));
+					MULPS(XMM0, fpr.VS(scol[j]));
+					ADDPS(XMM1, R(XMM0));
+				}
 			}
 			// Map the D column.
 			u8 dcol[4];
@@ -3123,8 +3137,13 @@ void Jit::Comp_Vtfm(MIPSOpcode op) {
 			if (!homogenous || j != n - 1) {
 				MOVSS(XMM0, fpr.V(tregs[j]));
 				SHUFPS(XMM0, R(XMM0), _MM_SHUFFLE(0, 0, 0, 0));
-				MULPS(XMM0, fpr.VS(scol[j]));
-				ADDPS(XMM1, R(XMM0));
+				if (cpu_info.bFMA3) {
+					// One fused multiply-add per column instead of a MULPS/ADDPS pair.
+					VFMADD231PS(XMM1, XMM0, fpr.VS(scol[j]));
+				} else {
+					MULPS(XMM0, fpr.VS(scol[j]));
+					ADDPS(XMM1, R(XMM0));
+				}
 			} else {
 				ADDPS(XMM1, fpr.VS(scol[j]));
 			}
@@ -100,6 +100,12 @@ static void JitLogMiss(MIPSOpcode op)
 	func(op);
 }
 
+static void JitBlockReoptimize(u32 blockNum) {
+	// Only ever called from code emitted by the x86 Jit below, so the global
+	// jit pointer is guaranteed to be ours.
+	static_cast<Jit *>(MIPSComp::jit)->RequestHotRecompile((int)blockNum);
+}
+
 #ifdef _MSC_VER
 // JitBlockCache doesn't use this, just stores it.
 #pragma warning(disable:4355)
@@ -209,10 +215,38 @@ void Jit::UpdateRoundingMode(u32 fcr31) {
 void Jit::ClearCache()
 {
 	blocks.Clear();
+	hotBlockAddrs_.clear();
+	pendingHotRecompiles_.clear();
 	ClearCodeSpace(0);
 	GenerateFixedCode(jo);
 }
 
+void Jit::RequestHotRecompile(int block_num) {
+	JitBlock *b = blocks.GetBlock(block_num);
+	DEBUG_LOG(JIT, "Hot block at %08x hit %d executions, requesting tier-1 recompile", b->originalAddress, b->executions);
+	hotBlockAddrs_.insert(b->originalAddress);
+	pendingHotRecompiles_.push_back(b->originalAddress);
+	blocks.DestroyBlock(block_num, DestroyType::INVALIDATE);
+}
+
+void Jit::CompactHotBlocks() {
+	if (!jo.enableBlockReopt || pendingHotRecompiles_.empty())
+		return;
+
+	// Compile() can ClearCache() if the arena is low, which clears the member
+	// vector - so iterate a local copy.
+	std::vector<u32> pending;
+	pending.swap(pendingHotRecompiles_);
+	for (u32 addr : pending) {
+		// Already recompiled on demand (or the code is gone) - nothing to do.
+		if (blocks.GetBlockNumberFromStartAddress(addr) >= 0)
+			continue;
+		if (!Memory::IsValidAddress(addr))
+			continue;
+		Compile(addr);
+	}
+}
+
 void Jit::SaveFlags() {
 	PUSHF();
 #if defined(_M_X64)
@@ -277,6 +311,9 @@ void Jit::Compile(u32 em_address) {
 
 	int block_num = blocks.AllocateBlock(em_address);
 	JitBlock *b = blocks.GetBlock(block_num);
+	compilingHotBlock_ = jo.enableBlockReopt && hotBlockAddrs_.find(em_address) != hotBlockAddrs_.end();
+	if (compilingHotBlock_)
+		b->compileTier = 1;
 	DoJit(em_address, b);
 	blocks.FinalizeBlock(block_num, jo.enableBlocklink);
 
@@ -344,6 +381,30 @@ const u8 *Jit::DoJit(u32 em_address, JitBlock *b) {
 
 	b->normalEntry = GetCodePtr();
 
+	// Tier-0 blocks count their own executions and bail to a hot recompile once
+	// past the threshold. Tier-1 blocks skip the counting entirely, and instead
+	// get the expensive "continue" codegen below.
+	bool continueBranches = jo.continueBranches;
+	bool continueJumps = jo.continueJumps;
+	if (jo.enableBlockReopt) {
+		if (compilingHotBlock_) {
+			jo.continueBranches = true;
+			jo.continueJumps = true;
+		} else {
+			// EAX is scratch at block entry, both from the dispatcher and from linked blocks.
+			MOV(PTRBITS, R(RAX), ImmPtr(&b->executions));
+			ADD(32, MatR(RAX), Imm8(1));
+			CMP(32, MatR(RAX), Imm32((u32)jo.blockReoptThreshold));
+			FixupBranch stillWarm = J_CC(CC_B);
+			MOV(32, MIPSSTATE_VAR(pc), Imm32(js.blockStart));
+			RestoreRoundingMode(true);
+			ABI_CallFunctionC(reinterpret_cast<const void *>(&JitBlockReoptimize), (u32)b->blockNum);
+			ApplyRoundingMode(true);
+			JMP(dispatcherNoCheck, true);
+			SetJumpTarget(stillWarm);
+		}
+	}
+
 	MIPSAnalyst::AnalysisResults analysis = MIPSAnalyst::Analyze(em_address);
 
 	gpr.Start(mips_, &js, &jo, analysis);
@@ -405,6 +466,9 @@ const u8 *Jit::DoJit(u32 em_address, JitBlock *b) {
 		}
 	}
 
+	jo.continueBranches = continueBranches;
+	jo.continueJumps = continueJumps;
+
 	b->codeSize = (u32)(GetCodePtr() - b->normalEntry);
 	NOP();
 	AlignCode4();
@@ -418,6 +482,18 @@ const u8 *Jit::DoJit(u32 em_address, JitBlock *b) {
 	return b->normalEntry;
 }
 
+bool Jit::CanInlineJal(u32 targetAddr) {
+	if (!jo.inlineSmallFunctions || !targetAddr)
+		return false;
+	const int INLINE_FUNC_MAX_INSTRUCTIONS = 16;
+	if (js.numInstructions + INLINE_FUNC_MAX_INSTRUCTIONS >= jo.continueMaxInstructions)
+		return false;
+	// The return address stays a known immediate, so the callee's terminal
+	// jr ra folds right back to the call site (see CanContinueImmReturn) and
+	// the whole call disappears.
+	return MIPSAnalyst::IsInlineableCallTarget(targetAddr, INLINE_FUNC_MAX_INSTRUCTIONS);
+}
+
 void Jit::AddContinuedBlock(u32 dest) {
 	// The first block is the root block.  When we continue, we create proxy blocks after that.
 	if (js.lastContinuedPC == 0)
@@ -516,6 +592,25 @@ void Jit::UnlinkBlock(u8 *checkedEntry, u32 originalAddress) {
 	}
 }
 
+void Jit::UnlinkBlockExit(u8 *exitPoint, u32 destination) {
+	if (PlatformIsWXExclusive()) {
+		ProtectMemoryPages(exitPoint, 32, MEM_PROT_READ | MEM_PROT_WRITE);
+	}
+	// Exits are always padded to the full exit size (see WriteExit), so we can
+	// safely write the whole dispatcher exit back.
+	XEmitter emit(exitPoint);
+	emit.MOV(32, MIPSSTATE_VAR(pc), Imm32(destination));
+	emit.JMP(dispatcher, true);
+	ptrdiff_t actualSize = emit.GetWritableCodePtr() - exitPoint;
+	int pad = JitBlockCache::GetBlockExitSize() - (int)actualSize;
+	for (int i = 0; i < pad; ++i) {
+		emit.INT3();
+	}
+	if (PlatformIsWXExclusive()) {
+		ProtectMemoryPages(exitPoint, 32, MEM_PROT_READ | MEM_PROT_EXEC);
+	}
+}
+
 bool Jit::ReplaceJalTo(u32 dest) {
 	const ReplacementTableEntry *entry = nullptr;
 	u32 funcSize = 0;
@@ -694,14 +789,15 @@ void Jit::WriteExit(u32 destination, int exit_num) {
 		// No blocklinking.
 		MOV(32, MIPSSTATE_VAR(pc), Imm32(destination));
 		JMP(dispatcher, true);
+	}
 
-		// Normally, exits are 15 bytes (MOV + &pc + dest + JMP + dest) on 64 or 32 bit.
-		// But just in case we somehow optimized, pad.
-		ptrdiff_t actualSize = GetWritableCodePtr() - b->exitPtrs[exit_num];
-		int pad = JitBlockCache::GetBlockExitSize() - (int)actualSize;
-		for (int i = 0; i < pad; ++i) {
-			INT3();
-		}
+	// Normally, exits are 15 bytes (MOV + &pc + dest + JMP + dest) on 64 or 32 bit.
+	// Pad the directly linked case too, so UnlinkBlockExit can always rewrite a
+	// full dispatcher exit in place.
+	ptrdiff_t actualSize = GetWritableCodePtr() - b->exitPtrs[exit_num];
+	int pad = JitBlockCache::GetBlockExitSize() - (int)actualSize;
+	for (int i = 0; i < pad; ++i) {
+		INT3();
 	}
 }
 
@@ -799,12 +895,13 @@ bool Jit::CheckJitBreakpoint(u32 addr, int downcountOffset) {
 
 void Jit::CallProtectedFunction(const void *func, const OpArg &arg1) {
 	// We don't regcache RCX, so the below is safe (and also faster, maybe branch prediction?)
-	ABI_CallFunctionA(thunks.ProtectFunction(func, 1), arg1);
+	// The reg caches know everything that's live here, so only those regs get spilled.
+	ABI_CallFunctionA(thunks.ProtectFunction(func, 1, gpr.GetInUseXRegMask(), fpr.GetInUseXRegMask()), arg1);
 }
 
 void Jit::CallProtectedFunction(const void *func, const OpArg &arg1, const OpArg &arg2) {
 	// We don't regcache RCX/RDX, so the below is safe (and also faster, maybe branch prediction?)
-	ABI_CallFunctionAA(thunks.ProtectFunction(func, 2), arg1, arg2);
+	ABI_CallFunctionAA(thunks.ProtectFunction(func, 2, gpr.GetInUseXRegMask(), fpr.GetInUseXRegMask()), arg1, arg2);
 }
 
 void Jit::CallProtectedFunction(const void *func, const u32 arg1, const u32 arg2, const u32 arg3) {
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "Common/CommonTypes.h"
 #include "Common/Thunk.h"
 #include "Common/x64Emitter.h"
@@ -179,6 +181,16 @@ public:
 
 	void LinkBlock(u8 *exitPoint, const u8 *checkedEntry) override;
 	void UnlinkBlock(u8 *checkedEntry, u32 originalAddress) override;
+	void UnlinkBlockExit(u8 *exitPoint, u32 destination) override;
+
+	// Called (through a thunk) from tier-0 block prologues when the execution
+	// counter trips the threshold. Tosses the block so the dispatcher recompiles it hot.
+	void RequestHotRecompile(int block_num);
+
+	// Batch-recompiles pending hot blocks back-to-back at a safe point, so the
+	// hot working set ends up contiguous instead of interleaved with whatever
+	// cold blocks compile in between.
+	void CompactHotBlocks() override;
 
 private:
 	void GenerateFixedCode(JitOptions &jo);
@@ -296,6 +308,14 @@ private:
 		}
 		return true;
 	}
+	bool CanInlineJal(u32 targetAddr);
+	bool CanContinueImmReturn(u32 targetAddr) {
+		// A jr ra with a known return address - happens after an inlined jal.
+		if (!jo.inlineSmallFunctions || js.numInstructions >= jo.continueMaxInstructions) {
+			return false;
+		}
+		return targetAddr != 0;
+	}
 	void SaveFlags();
 	void LoadFlags();
 
@@ -303,6 +323,14 @@ private:
 	JitOptions jo;
 	JitState js;
 
+	// Addresses that earned a hot recompile. Survives block invalidation so a
+	// re-jitted hot block goes straight back to tier 1.
+	std::unordered_set<u32> hotBlockAddrs_;
+	// Hot blocks waiting for the batched recompile in CompactHotBlocks(). Any
+	// that get executed (and thus recompiled) first simply drop out of the list.
+	std::vector<u32> pendingHotRecompiles_;
+	bool compilingHotBlock_ = false;
+
 	GPRRegCache gpr;
 	FPURegCache fpr;
 
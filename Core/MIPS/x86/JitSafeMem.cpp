@@ -23,6 +23,7 @@
 #include "Core/Debugger/Breakpoints.h"
 #include "Core/MemMap.h"
 #include "Core/MIPS/JitCommon/JitCommon.h"
+#include "Core/MIPS/MIPSAnalyst.h"
 #include "Core/MIPS/x86/Jit.h"
 #include "Core/MIPS/x86/JitSafeMem.h"
 #include "Core/System.h"
@@ -59,7 +60,13 @@ JitSafeMem::JitSafeMem(Jit *jit, MIPSGPReg raddr, s32 offset, u32 alignMask)
 	else
 		iaddr_ = (u32) -1;
 
-	fast_ = g_Config.bFastMemory || raddr == MIPS_REG_SP;
+	// Addresses proven to come from sp or gp can't hit MMIO, so the bounds
+	// machinery below is pure overhead for them. Blocks aren't straight-line
+	// when branch continuation or jal inlining spliced segments together, so
+	// the proof scan must not cross the last splice point - instructions
+	// before it came from somewhere else in the program.
+	const u32 segmentStart = jit_->js.lastContinuedPC != 0 ? jit_->js.lastContinuedPC : jit_->js.blockStart;
+	fast_ = g_Config.bFastMemory || MIPSAnalyst::IsProvenRAMBase(raddr_, jit_->GetCompilerPC(), segmentStart);
 
 	// If raddr_ is going to get loaded soon, load it now for more optimal code.
 	// We assume that it was already locked.
@@ -119,6 +119,16 @@ public:
 	void GetState(GPRRegCacheState &state) const;
 	void RestoreState(const GPRRegCacheState& state);
 
+	// Mask of host regs currently holding guest state, for masked thunks.
+	u32 GetInUseXRegMask() const {
+		u32 mask = 0;
+		for (u32 i = 0; i < X64JitConstants::NUM_X_REGS; i++) {
+			if (!xregs[i].free)
+				mask |= 1 << i;
+		}
+		return mask;
+	}
+
 	MIPSState *mips;
 
 private:
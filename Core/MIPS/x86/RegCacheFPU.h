@@ -124,6 +124,16 @@ public:
 	void Flush();
 	int SanityCheck() const;
 
+	// Mask of host regs currently holding guest state, for masked thunks.
+	u32 GetInUseXRegMask() const {
+		u32 mask = 0;
+		for (u32 i = 0; i < NUM_X_FPREGS; i++) {
+			if (xregs[i].mipsReg != -1)
+				mask |= 1 << i;
+		}
+		return mask;
+	}
+
 	const Gen::OpArg &R(int freg) const {return regs[freg].location;}
 	const Gen::OpArg &V(int vreg) const {
 		_dbg_assert_msg_(JIT, vregs[vreg].lane == 0, "SIMD reg %d used as V reg (use VS instead)", vreg);
@@ -15,6 +15,7 @@
 // Official git repository and contact information can be found at
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
+#include <climits>
 #include <cstring>
 #include <ctime>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "Common/FileUtil.h"
 #include "Common/StringUtils.h"
 #include "Core/Replay.h"
+#include "Core/System.h"
 #include "Core/FileSystems/FileSystem.h"
 #include "Core/HLE/sceCtrl.h"
 #include "Core/HLE/sceKernelTime.h"
@@ -127,6 +129,10 @@ static uint8_t lastAnalog[2][2]{};
 static size_t replayDiskPos = 0;
 static bool diskFailed = false;
 
+// Turbo seek: while >= 0, we're unthrottled with draws skipped and audio
+// muted until this vblank count is reached.  See ReplaySeekToVblank().
+static int replaySeekTargetVblank = -1;
+
 void ReplayExecuteBlob(const std::vector<u8> &data) {
 	ReplayAbort();
 
@@ -221,6 +227,10 @@ bool ReplayHasMoreEvents() {
 	return replayExecPos < replayItems.size();
 }
 
+bool ReplayIsExecuting() {
+	return replayState == ReplayState::EXECUTE;
+}
+
 void ReplayBeginSave() {
 	if (replayState != ReplayState::EXECUTE) {
 		// Restart any save operation.
@@ -308,6 +318,37 @@ void ReplayAbort() {
 
 	replayDiskPos = 0;
 	diskFailed = false;
+
+	if (replaySeekTargetVblank >= 0) {
+		replaySeekTargetVblank = -1;
+		PSP_CoreParameter().unthrottle = false;
+	}
+}
+
+void ReplaySeekToVblank(int vblank) {
+	if (vblank < 0) {
+		// Cancel any seek in progress.
+		ReplayNotifyVblank(INT_MAX);
+		return;
+	}
+
+	replaySeekTargetVblank = vblank;
+	// The display checks ReplayIsSeeking() to skip draws, and the audio mix
+	// pushes silence - we just need to let the core run flat out.
+	PSP_CoreParameter().unthrottle = true;
+	NOTICE_LOG(SYSTEM, "Replay: seeking to vblank %d", vblank);
+}
+
+bool ReplayIsSeeking() {
+	return replaySeekTargetVblank >= 0;
+}
+
+void ReplayNotifyVblank(int vCount) {
+	if (replaySeekTargetVblank >= 0 && vCount >= replaySeekTargetVblank) {
+		replaySeekTargetVblank = -1;
+		PSP_CoreParameter().unthrottle = false;
+		NOTICE_LOG(SYSTEM, "Replay: seek finished at vblank %d", vCount);
+	}
 }
 
 static void ReplaySaveCtrl(uint32_t &buttons, uint8_t analog[2][2], uint64_t t) {
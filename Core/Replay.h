@@ -52,6 +52,8 @@ void ReplayExecuteBlob(const std::vector<u8> &data);
 bool ReplayExecuteFile(const std::string &filename);
 // Returns whether there are unexected events to replay.
 bool ReplayHasMoreEvents();
+// True while replay data is being executed (not while recording.)
+bool ReplayIsExecuting();
 
 // Begin recording.  If currently executing, discards unexecuted events.
 void ReplayBeginSave();
@@ -65,6 +67,15 @@ bool ReplayFlushFile(const std::string &filename);
 // Abort any execute or record operation in progress.
 void ReplayAbort();
 
+// Turbo seek for long replays: unthrottle with all draws skipped (display
+// lists still execute for state) and audio muted until the given vblank
+// count, then resume normal rendering.  Pass a negative value to cancel.
+void ReplaySeekToVblank(int vblank);
+// True while a turbo seek is in progress.
+bool ReplayIsSeeking();
+// Called from the display each vblank so a seek can end at its target.
+void ReplayNotifyVblank(int vCount);
+
 void ReplayApplyCtrl(uint32_t &buttons, uint8_t analog[2][2], uint64_t t);
 uint32_t ReplayApplyDisk(ReplayAction action, uint32_t result, uint64_t t);
 uint64_t ReplayApplyDisk64(ReplayAction action, uint64_t result, uint64_t t);
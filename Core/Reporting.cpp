@@ -89,6 +89,13 @@ namespace Reporting
 	static Payload payloadBuffer[PAYLOAD_BUFFER_SIZE];
 	static int payloadBufferPos = 0;
 
+	// Single background sender that drains the payload ring, batching
+	// everything queued over one connection per wakeup.
+	static std::mutex senderLock;
+	static std::condition_variable senderCond;
+	static bool senderStarted = false;
+	static int senderReadPos = 0;
+
 	static std::mutex crcLock;
 	static std::condition_variable crcCond;
 	static std::string crcFilename;
@@ -218,28 +225,33 @@ namespace Reporting
 		return ++spamProtectionCount >= SPAM_LIMIT;
 	}
 
-	bool SendReportRequest(const char *uri, const std::string &data, const std::string &mimeType, Buffer *output = NULL)
+	bool SendReportRequest(const char *uri, const std::string &data, const std::string &mimeType, Buffer *output = NULL, http::Client *client = NULL)
 	{
-		bool result = false;
-		http::Client http;
+		http::Client ownHttp;
 		Buffer theVoid;
 
 		if (output == NULL)
 			output = &theVoid;
 
-		const char *serverHost = ServerHostname();
-		if (!serverHost)
-			return false;
+		// Without a caller-provided (already connected) client, use a one-shot
+		// connection of our own.
+		http::Client *http = client;
+		if (http == NULL) {
+			const char *serverHost = ServerHostname();
+			if (!serverHost)
+				return false;
+
+			if (!ownHttp.Resolve(serverHost, ServerPort()))
+				return false;
+			ownHttp.Connect();
+			http = &ownHttp;
+		}
 
-		if (http.Resolve(serverHost, ServerPort())) {
-			http.Connect();
-			int result = http.POST(uri, data, mimeType, output);
-			http.Disconnect();
+		int result = http->POST(uri, data, mimeType, output);
+		if (http == &ownHttp)
+			ownHttp.Disconnect();
 
-			return result >= 200 && result < 300;
-		} else {
-			return false;
-		}
+		return result >= 200 && result < 300;
 	}
 
 	std::string StripTrailingNull(const std::string &str)
@@ -391,10 +403,8 @@ namespace Reporting
 		}
 	}
 
-	int Process(int pos)
+	int Process(int pos, http::Client *client)
 	{
-		setCurrentThreadName("Report");
-
 		Payload &payload = payloadBuffer[pos];
 		Buffer output;
 
@@ -417,7 +427,7 @@ namespace Reporting
 
 			postdata.Finish();
 			serverWorking = true;
-			if (!SendReportRequest("/report/message", postdata.ToString(), postdata.GetMimeType()))
+			if (!SendReportRequest("/report/message", postdata.ToString(), postdata.GetMimeType(), NULL, client))
 				serverWorking = false;
 			break;
 
@@ -436,7 +446,7 @@ namespace Reporting
 
 			postdata.Finish();
 			serverWorking = true;
-			if (!SendReportRequest("/report/compat", postdata.ToString(), postdata.GetMimeType(), &output)) {
+			if (!SendReportRequest("/report/compat", postdata.ToString(), postdata.GetMimeType(), &output, client)) {
 				serverWorking = false;
 			} else {
 				std::string result;
@@ -459,6 +469,77 @@ namespace Reporting
 		return 0;
 	}
 
+	// Must hold senderLock. Returns the oldest queued payload, or -1.
+	static int NextPendingPos()
+	{
+		for (int i = 0; i < PAYLOAD_BUFFER_SIZE; ++i)
+		{
+			int pos = (senderReadPos + i) % PAYLOAD_BUFFER_SIZE;
+			if (payloadBuffer[pos].type != RequestType::NONE)
+			{
+				senderReadPos = (pos + 1) % PAYLOAD_BUFFER_SIZE;
+				return pos;
+			}
+		}
+
+		return -1;
+	}
+
+	static int SenderThread()
+	{
+		setCurrentThreadName("Report");
+
+		std::unique_lock<std::mutex> guard(senderLock);
+		while (true)
+		{
+			int pos = NextPendingPos();
+			if (pos == -1)
+			{
+				senderCond.wait(guard);
+				continue;
+			}
+
+			// Send everything queued so far over a single connection.
+			http::Client http;
+			http.SetKeepAlive(true);
+			bool connected = false;
+			do
+			{
+				guard.unlock();
+				if (!connected)
+				{
+					const char *serverHost = ServerHostname();
+					if (serverHost && http.Resolve(serverHost, ServerPort()))
+						connected = http.Connect();
+				}
+				// A failed connect still drains the queue - the requests fail
+				// fast and flag the server as not working.
+				Process(pos, &http);
+				guard.lock();
+				pos = NextPendingPos();
+			}
+			while (pos != -1);
+			if (connected)
+				http.Disconnect();
+		}
+
+		return 0;
+	}
+
+	// Must hold senderLock.
+	static void WakeSender()
+	{
+		if (!senderStarted)
+		{
+			// Runs for the lifetime of the process, like the other detached
+			// worker threads here.
+			std::thread th(SenderThread);
+			th.detach();
+			senderStarted = true;
+		}
+		senderCond.notify_one();
+	}
+
 	bool IsSupported()
 	{
 		// Disabled when using certain hacks, because they make for poor reports.
@@ -545,9 +626,6 @@ namespace Reporting
 	{
 		if (!IsEnabled() || CheckSpamLimited())
 			return;
-		int pos = NextFreePos();
-		if (pos == -1)
-			return;
 
 		const int MESSAGE_BUFFER_SIZE = 65536;
 		char temp[MESSAGE_BUFFER_SIZE];
@@ -558,50 +636,56 @@ namespace Reporting
 		temp[MESSAGE_BUFFER_SIZE - 1] = '\0';
 		va_end(args);
 
+		std::lock_guard<std::mutex> guard(senderLock);
+		int pos = NextFreePos();
+		if (pos == -1)
+			return;
+
 		Payload &payload = payloadBuffer[pos];
-		payload.type = RequestType::MESSAGE;
 		payload.string1 = message;
 		payload.string2 = temp;
+		payload.type = RequestType::MESSAGE;
 
-		std::thread th(Process, pos);
-		th.detach();
+		WakeSender();
 	}
 
 	void ReportMessageFormatted(const char *message, const char *formatted)
 	{
 		if (!IsEnabled() || CheckSpamLimited())
 			return;
+
+		std::lock_guard<std::mutex> guard(senderLock);
 		int pos = NextFreePos();
 		if (pos == -1)
 			return;
 
 		Payload &payload = payloadBuffer[pos];
-		payload.type = RequestType::MESSAGE;
 		payload.string1 = message;
 		payload.string2 = formatted;
+		payload.type = RequestType::MESSAGE;
 
-		std::thread th(Process, pos);
-		th.detach();
+		WakeSender();
 	}
 
 	void ReportCompatibility(const char *compat, int graphics, int speed, int gameplay, const std::string &screenshotFilename)
 	{
 		if (!IsEnabled())
 			return;
+
+		std::lock_guard<std::mutex> guard(senderLock);
 		int pos = NextFreePos();
 		if (pos == -1)
 			return;
 
 		Payload &payload = payloadBuffer[pos];
-		payload.type = RequestType::COMPAT;
 		payload.string1 = compat;
 		payload.string2 = screenshotFilename;
 		payload.int1 = graphics;
 		payload.int2 = speed;
 		payload.int3 = gameplay;
+		payload.type = RequestType::COMPAT;
 
-		std::thread th(Process, pos);
-		th.detach();
+		WakeSender();
 	}
 
 	std::vector<std::string> CompatibilitySuggestions() {
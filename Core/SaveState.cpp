@@ -46,6 +46,7 @@
 #include "Core/MIPS/JitCommon/JitBlockCache.h"
 #include "HW/MemoryStick.h"
 #include "GPU/GPUState.h"
+#include "GPU/Common/TextureDecoder.h"
 
 #ifndef MOBILE_DEVICE
 #include "Core/AVIDump.h"
@@ -83,10 +84,9 @@ namespace SaveState
 
 	CChunkFileReader::Error SaveToRam(std::vector<u8> &data) {
 		SaveStart state;
-		size_t sz = CChunkFileReader::MeasurePtr(state);
-		if (data.size() < sz)
-			data.resize(sz);
-		return CChunkFileReader::SavePtr(&data[0], state);
+		// Reuses the buffer's previous size; in steady state (rewind snapshots
+		// every few seconds) this does one write pass and no allocation.
+		return CChunkFileReader::MeasureAndSavePtr(data, state);
 	}
 
 	CChunkFileReader::Error LoadFromRam(std::vector<u8> &data) {
@@ -118,6 +118,8 @@ namespace SaveState
 			{
 				base_ = (base_ + 1) % ARRAY_SIZE(bases_);
 				baseUsage_ = 0;
+				// The compress thread rebuilds these from the fresh base.
+				baseHashesValid_[base_] = false;
 				err = SaveToRam(bases_[base_]);
 				// Let's not bother savestating twice.
 				compressBuffer = &bases_[base_];
@@ -126,7 +128,7 @@ namespace SaveState
 				err = SaveToRam(buffer);
 
 			if (err == CChunkFileReader::ERROR_NONE)
-				ScheduleCompress(&states_[n], compressBuffer, &bases_[base_]);
+				ScheduleCompress(&states_[n], compressBuffer, base_);
 			else
 				states_[n].clear();
 			baseMapping_[n] = base_;
@@ -150,34 +152,124 @@ namespace SaveState
 			return LoadFromRam(buffer);
 		}
 
-		void ScheduleCompress(std::vector<u8> *result, const std::vector<u8> *state, const std::vector<u8> *base)
+		void ScheduleCompress(std::vector<u8> *result, const std::vector<u8> *state, int baseIndex)
 		{
 			auto th = new std::thread([=]{
 				setCurrentThreadName("SaveStateCompress");
-				Compress(*result, *state, *base);
+				Compress(*result, *state, baseIndex);
 			});
 			th->detach();
 		}
 
-		void Compress(std::vector<u8> &result, const std::vector<u8> &state, const std::vector<u8> &base)
+		void Compress(std::vector<u8> &result, const std::vector<u8> &state, int baseIndex)
 		{
 			std::lock_guard<std::mutex> guard(lock_);
 			// Bail if we were cleared before locking.
 			if (first_ == 0 && next_ == 0)
 				return;
 
+			const std::vector<u8> &base = bases_[baseIndex];
+			std::vector<u32> &baseHashes = baseHashes_[baseIndex];
+
+			// When compressing the base itself (every base refresh), hash each block
+			// so that later snapshots can detect unchanged blocks with a single pass
+			// over their own data instead of a memcmp that reads the base too.
+			const bool hashingBase = &state == &base;
+			if (hashingBase)
+			{
+				baseHashes.clear();
+				baseHashes.reserve((state.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+			}
+
 			result.clear();
 			for (size_t i = 0; i < state.size(); i += BLOCK_SIZE)
 			{
 				int blockSize = std::min(BLOCK_SIZE, (int)(state.size() - i));
-				if (i + blockSize > base.size() || memcmp(&state[i], &base[i], blockSize) != 0)
+				// The hash kernel wants a 64-byte multiple, so partial tail blocks
+				// always take the memcmp path below.
+				u32 hash = 0;
+				if (blockSize == BLOCK_SIZE)
+					hash = StableQuickTexHash(&state[i], blockSize);
+				if (hashingBase)
+				{
+					// The base trivially matches itself.
+					baseHashes.push_back(hash);
+					result.push_back(0);
+					continue;
+				}
+
+				const size_t block = i / BLOCK_SIZE;
+				bool changed;
+				if (blockSize == BLOCK_SIZE && i + blockSize <= base.size() && baseHashesValid_[baseIndex] && block < baseHashes.size())
+					// In theory a changed block could collide with the base's hash and
+					// be dropped, but at 2^-32 per block that's acceptable for rewind.
+					changed = hash != baseHashes[block];
+				else
+					changed = i + blockSize > base.size() || memcmp(&state[i], &base[i], blockSize) != 0;
+				if (changed)
 				{
+					// Most blocks that change at all only change a few bytes, so
+					// try a skip/copy delta against the base first.
+					if (blockSize == BLOCK_SIZE && i + blockSize <= base.size() && CompressBlockDelta(result, &state[i], &base[i], blockSize))
+						continue;
 					result.push_back(1);
 					result.insert(result.end(), state.begin() + i, state.begin() +i + blockSize);
 				}
 				else
 					result.push_back(0);
 			}
+
+			if (hashingBase)
+				baseHashesValid_[baseIndex] = true;
+		}
+
+		// Tag 2 layout: u16 encodedLen, then (u16 skip, u16 copyLen, copyLen raw
+		// bytes) groups covering the block. Skipped bytes come from the base.
+		// Appends nothing and returns false if raw storage would be smaller.
+		bool CompressBlockDelta(std::vector<u8> &result, const u8 *state, const u8 *base, int blockSize)
+		{
+			std::vector<u8> &out = compressScratch_;
+			out.clear();
+
+			int pos = 0;
+			while (pos < blockSize)
+			{
+				int runStart = pos;
+				while (pos < blockSize && state[pos] == base[pos])
+					++pos;
+				int skip = pos - runStart;
+				// Take differing bytes until a run of matches long enough to be
+				// worth a new group's overhead.
+				int litStart = pos;
+				int matchRun = 0;
+				while (pos < blockSize && matchRun < 8)
+				{
+					if (state[pos] == base[pos])
+						++matchRun;
+					else
+						matchRun = 0;
+					++pos;
+				}
+				int litLen = pos - matchRun - litStart;
+				pos = litStart + litLen;
+				// A trailing matched run needs no group - the base covers it.
+				if (litLen == 0)
+					break;
+
+				if ((int)out.size() + 4 + litLen + 3 >= blockSize)
+					return false;
+				out.push_back(skip & 0xFF);
+				out.push_back((skip >> 8) & 0xFF);
+				out.push_back(litLen & 0xFF);
+				out.push_back((litLen >> 8) & 0xFF);
+				out.insert(out.end(), state + litStart, state + litStart + litLen);
+			}
+
+			result.push_back(2);
+			result.push_back(out.size() & 0xFF);
+			result.push_back((out.size() >> 8) & 0xFF);
+			result.insert(result.end(), out.begin(), out.end());
+			return true;
 		}
 
 		void LockedDecompress(std::vector<u8> &result, const std::vector<u8> &compressed, const std::vector<u8> &base)
@@ -194,6 +286,26 @@ namespace SaveState
 					result.insert(result.end(), basePos, basePos + blockSize);
 					basePos += blockSize;
 				}
+				else if (compressed[i] == 2)
+				{
+					++i;
+					size_t encodedEnd = i + 2 + (compressed[i] | (compressed[i + 1] << 8));
+					i += 2;
+					// Delta blocks are always full-sized: start from the base block,
+					// then patch in the literal runs.
+					size_t pos = result.size();
+					result.insert(result.end(), basePos, basePos + BLOCK_SIZE);
+					basePos += BLOCK_SIZE;
+					while (i < encodedEnd)
+					{
+						pos += compressed[i] | (compressed[i + 1] << 8);
+						int litLen = compressed[i + 2] | (compressed[i + 3] << 8);
+						i += 4;
+						memcpy(&result[pos], &compressed[i], litLen);
+						pos += litLen;
+						i += litLen;
+					}
+				}
 				else
 				{
 					++i;
@@ -230,6 +342,12 @@ namespace SaveState
 
 		std::vector<StateBuffer> states_;
 		StateBuffer bases_[2];
+		// Per-block hashes of each base, rebuilt by the compress thread whenever the
+		// base is refreshed. Invalid until then - compares fall back to memcmp.
+		std::vector<u32> baseHashes_[2];
+		bool baseHashesValid_[2] = { false, false };
+		// Only touched by the compress thread, under lock_.
+		StateBuffer compressScratch_;
 		std::vector<int> baseMapping_;
 		std::mutex lock_;
 
@@ -240,6 +358,29 @@ namespace SaveState
 	static bool needsProcess = false;
 	static std::vector<Operation> pending;
 	static std::mutex mutex;
+
+	// Background savestate writes: the state is serialized to RAM at the safe
+	// point in Process(), then compression and disk I/O happen on this thread.
+	// Completions are queued here and fired from Process() on the emu thread.
+	struct SaveCompletion
+	{
+		Status status;
+		std::string message;
+		Callback callback;
+		void *cbUserData;
+	};
+	static std::thread saveWriteThread;
+	static std::vector<SaveCompletion> saveCompletions;  // Guarded by mutex.
+
+	// Waits for any in-flight background save to hit the disk.  Called before
+	// starting another save (so they can't overlap or reorder), before anything
+	// reads, renames or deletes a state file, and at shutdown.
+	static void FinishSaveWrite()
+	{
+		if (saveWriteThread.joinable())
+			saveWriteThread.join();
+	}
+
 	static int screenshotFailures = 0;
 	static bool hasLoadedState = false;
 	static const int STALE_STATE_USES = 2;
@@ -501,6 +642,9 @@ namespace SaveState
 		std::string fnUndo = GenerateSaveSlotFilename(gameFilename, slot, UNDO_STATE_EXTENSION);
 		std::string shotUndo = GenerateSaveSlotFilename(gameFilename, slot, UNDO_SCREENSHOT_EXTENSION);
 
+		// Don't swap the files out from under a save that's still writing.
+		FinishSaveWrite();
+
 		// Do nothing if there's no undo.
 		if (File::Exists(fnUndo)) {
 			// Swap them so they can undo again to redo.  Mistakes happen.
@@ -705,6 +849,18 @@ namespace SaveState
 			return;
 		needsProcess = false;
 
+		// Deliver results of completed background save writes on the emu thread.
+		std::vector<SaveCompletion> completions;
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			completions.swap(saveCompletions);
+		}
+		for (const auto &done : completions)
+		{
+			if (done.callback)
+				done.callback(done.status, done.message, done.cbUserData);
+		}
+
 		if (!__KernelIsRunning())
 		{
 			ERROR_LOG(SAVESTATE, "Savestate failure: Unable to load without kernel, this should never happen.");
@@ -719,6 +875,7 @@ namespace SaveState
 			Operation &op = operations[i];
 			CChunkFileReader::Error result;
 			Status callbackResult;
+			bool callbackDeferred = false;
 			bool tempResult;
 			std::string callbackMessage;
 			std::string reason;
@@ -736,6 +893,8 @@ namespace SaveState
 			{
 			case SAVESTATE_LOAD:
 				INFO_LOG(SAVESTATE, "Loading state from %s", op.filename.c_str());
+				// The file might still be in flight from a save moments ago.
+				FinishSaveWrite();
 				// Use the state's latest version as a guess for saveStateInitialGitVersion.
 				result = CChunkFileReader::Load(op.filename, &saveStateInitialGitVersion, state, &reason);
 				if (result == CChunkFileReader::ERROR_NONE) {
@@ -779,6 +938,7 @@ namespace SaveState
 				break;
 
 			case SAVESTATE_SAVE:
+			{
 				INFO_LOG(SAVESTATE, "Saving state to %s", op.filename.c_str());
 				title = g_paramSFO.GetValueString("TITLE");
 				if (title.empty()) {
@@ -787,10 +947,16 @@ namespace SaveState
 					std::size_t lslash = title.find_last_of("/");
 					title = title.substr(lslash + 1);
 				}
-				result = CChunkFileReader::Save(op.filename, title, PPSSPP_GIT_VERSION, state);
+				// Serialize here at the safe point - that part is just memcpys.
+				// The compression and disk write happen on a background thread,
+				// and the callback fires once the write has completed.
+				FinishSaveWrite();
+				size_t sz = CChunkFileReader::MeasurePtr(state);
+				u8 *buffer = (u8 *)malloc(sz);
+				result = CChunkFileReader::ERROR_BAD_ALLOC;
+				if (buffer)
+					result = CChunkFileReader::SavePtr(buffer, state);
 				if (result == CChunkFileReader::ERROR_NONE) {
-					callbackMessage = sc->T("Saved State");
-					callbackResult = Status::SUCCESS;
 #ifndef MOBILE_DEVICE
 					if (g_Config.bSaveLoadResetsAVdumping) {
 						if (g_Config.bDumpFrames) {
@@ -802,7 +968,27 @@ namespace SaveState
 						}
 					}
 #endif
+					// Translate on this thread - i18n isn't safe from the worker.
+					std::string successMessage = sc->T("Saved State");
+					std::string failureMessage = i18nSaveFailure;
+					Operation opCopy = op;
+					saveWriteThread = std::thread([=] {
+						setCurrentThreadName("SaveStateWrite");
+						// SaveFile takes ownership of buffer.
+						CChunkFileReader::Error writeResult = CChunkFileReader::SaveFile(opCopy.filename, title, PPSSPP_GIT_VERSION, buffer, sz);
+						SaveCompletion done;
+						done.status = writeResult == CChunkFileReader::ERROR_NONE ? Status::SUCCESS : Status::FAILURE;
+						done.message = writeResult == CChunkFileReader::ERROR_NONE ? successMessage : failureMessage;
+						done.callback = opCopy.callback;
+						done.cbUserData = opCopy.cbUserData;
+						std::lock_guard<std::mutex> guard(mutex);
+						saveCompletions.push_back(done);
+						needsProcess = true;
+					});
+					callbackDeferred = true;
+					callbackResult = Status::SUCCESS;
 				} else if (result == CChunkFileReader::ERROR_BROKEN_STATE) {
+					free(buffer);
 					HandleFailure();
 					callbackMessage = i18nSaveFailure;
 					ERROR_LOG(SAVESTATE, "Save state failure: %s", reason.c_str());
@@ -812,6 +998,7 @@ namespace SaveState
 					callbackResult = Status::FAILURE;
 				}
 				break;
+			}
 
 			case SAVESTATE_VERIFY:
 				tempResult = CChunkFileReader::Verify(state) == CChunkFileReader::ERROR_NONE;
@@ -849,8 +1036,9 @@ namespace SaveState
 
 			case SAVESTATE_SAVE_SCREENSHOT:
 			{
+				// Thumbnails never need more than 2x; the worker shrinks further before encoding.
 				int maxRes = g_Config.iInternalResolution > 2 ? 2 : -1;
-				tempResult = TakeGameScreenshot(op.filename.c_str(), ScreenshotFormat::JPG, SCREENSHOT_DISPLAY, nullptr, nullptr, maxRes);
+				tempResult = TakeGameScreenshot(op.filename.c_str(), ScreenshotFormat::JPG, SCREENSHOT_DISPLAY, nullptr, nullptr, maxRes, true);
 				callbackResult = tempResult ? Status::SUCCESS : Status::FAILURE;
 				if (!tempResult) {
 					ERROR_LOG(SAVESTATE, "Failed to take a screenshot for the savestate! %s", op.filename.c_str());
@@ -869,7 +1057,7 @@ namespace SaveState
 				break;
 			}
 
-			if (op.callback)
+			if (op.callback && !callbackDeferred)
 				op.callback(callbackResult, callbackMessage, op.cbUserData);
 		}
 		if (operations.size()) {
@@ -883,6 +1071,9 @@ namespace SaveState
 		// Make sure there's a directory for save slots
 		File::CreateFullPath(GetSysDirectory(DIRECTORY_SAVESTATE));
 
+		// Join outside the lock - the write thread takes it when finishing.
+		FinishSaveWrite();
+
 		std::lock_guard<std::mutex> guard(mutex);
 		rewindStates.Clear();
 
@@ -893,6 +1084,9 @@ namespace SaveState
 
 	void Shutdown()
 	{
+		// Join outside the lock - the write thread takes it when finishing.
+		FinishSaveWrite();
+
 		std::lock_guard<std::mutex> guard(mutex);
 		rewindStates.Clear();
 	}
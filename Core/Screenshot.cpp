@@ -18,6 +18,8 @@
 #include "ppsspp_config.h"
 
 #include <algorithm>
+#include <memory>
+#include <thread>
 #ifdef USING_QT_UI
 #include <QtGui/QImage>
 #else
@@ -33,6 +35,7 @@
 #include "GPU/Common/GPUDebugInterface.h"
 #include "GPU/GPUInterface.h"
 #include "GPU/GPUState.h"
+#include "thread/threadutil.h"
 
 #ifndef USING_QT_UI
 // This is used to make non-ASCII paths work for filename.
@@ -306,7 +309,53 @@ const u8 *ConvertBufferToScreenshot(const GPUDebugBuffer &buf, bool alpha, u8 *&
 	return temp ? temp : buffer;
 }
 
-bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width, int *height, int maxRes) {
+// Averages each 2x2 block down to one pixel, in place.  Safe in place because the
+// destination never runs ahead of the source.
+static void HalveRGB888(u8 *pixels, u32 &w, u32 &h) {
+	u32 nw = w / 2;
+	u32 nh = h / 2;
+	for (u32 y = 0; y < nh; y++) {
+		for (u32 x = 0; x < nw; x++) {
+			u8 *dst = pixels + (y * nw + x) * 3;
+			const u8 *tl = pixels + (2 * y * w + 2 * x) * 3;
+			const u8 *bl = tl + w * 3;
+			for (int i = 0; i < 3; i++) {
+				dst[i] = (tl[i] + tl[3 + i] + bl[i] + bl[3 + i] + 2) / 4;
+			}
+		}
+	}
+	w = nw;
+	h = nh;
+}
+
+// Converts, optionally shrinks, encodes and writes an already grabbed framebuffer.
+// This part doesn't need the GPU anymore, so it can run on any thread.
+static bool WriteScreenshotBuffer(GPUDebugBuffer &buf, const std::string &filename, ScreenshotFormat fmt, u32 w, u32 h, bool thumbnail, int *width, int *height) {
+	u8 *flipbuffer = nullptr;
+	const u8 *buffer = ConvertBufferToScreenshot(buf, false, flipbuffer, w, h);
+	bool success = buffer != nullptr;
+	if (success) {
+		if (thumbnail) {
+			// Thumbnails don't need more than around the PSP's own resolution - shrinking
+			// first is much cheaper than encoding every rendered pixel.
+			u8 *pixels = flipbuffer ? flipbuffer : buf.GetData();
+			while (w >= 2 * 480 && h >= 2 * 272) {
+				HalveRGB888(pixels, w, h);
+			}
+			buffer = pixels;
+		}
+		if (width)
+			*width = w;
+		if (height)
+			*height = h;
+
+		success = Save888RGBScreenshot(filename.c_str(), fmt, buffer, w, h);
+	}
+	delete [] flipbuffer;
+	return success;
+}
+
+bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width, int *height, int maxRes, bool asyncEncode) {
 	if (!gpuDebug) {
 		ERROR_LOG(SYSTEM, "Can't take screenshots when GPU not running");
 		return false;
@@ -331,21 +380,23 @@ bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotTy
 		return false;
 	}
 
-	u8 *flipbuffer = nullptr;
-	if (success) {
-		const u8 *buffer = ConvertBufferToScreenshot(buf, false, flipbuffer, w, h);
-		success = buffer != nullptr;
-		if (success) {
-			if (width)
-				*width = w;
-			if (height)
-				*height = h;
-
-			success = Save888RGBScreenshot(filename, fmt, buffer, w, h);
-		}
+	if (asyncEncode) {
+		// The expensive part - convert, shrink, encode, write - happens off-thread.
+		// The grab above is the only part that needed the GPU.
+		std::shared_ptr<GPUDebugBuffer> shared(new GPUDebugBuffer(std::move(buf)));
+		std::string fn = filename;
+		std::thread([shared, fn, fmt, w, h] {
+			setCurrentThreadName("Screenshot");
+			u32 sw = w;
+			u32 sh = h;
+			if (!WriteScreenshotBuffer(*shared, fn, fmt, sw, sh, true, nullptr, nullptr)) {
+				ERROR_LOG(SYSTEM, "Failed to write screenshot.");
+			}
+		}).detach();
+		return true;
 	}
-	delete [] flipbuffer;
 
+	success = WriteScreenshotBuffer(buf, filename, fmt, w, h, false, width, height);
 	if (!success) {
 		ERROR_LOG(SYSTEM, "Failed to write screenshot.");
 	}
@@ -36,6 +36,9 @@ enum ScreenshotType {
 const u8 *ConvertBufferToScreenshot(const GPUDebugBuffer &buf, bool alpha, u8 *&temp, u32 &w, u32 &h);
 
 // Can only be used while in game.
-bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width = nullptr, int *height = nullptr, int maxRes = -1);
+// With asyncEncode, the framebuffer readback still happens on the calling thread, but the
+// conversion, encode and file write run on a worker.  The result then only covers the readback,
+// and width/height must be null.  Worker-encoded shots are also shrunk to thumbnail size.
+bool TakeGameScreenshot(const char *filename, ScreenshotFormat fmt, ScreenshotType type, int *width = nullptr, int *height = nullptr, int maxRes = -1, bool asyncEncode = false);
 bool Save888RGBScreenshot(const char *filename, ScreenshotFormat fmt, const u8 *bufferRGB888, int w, int h);
 bool Save8888RGBAScreenshot(const char *filename, const u8 *bufferRGBA8888, int w, int h);
@@ -40,6 +40,7 @@
 
 #include "Core/MIPS/MIPS.h"
 #include "Core/MIPS/MIPSAnalyst.h"
+#include "Core/MIPS/JitCommon/JitCommon.h"
 
 #include "Debugger/SymbolMap.h"
 #include "Core/Host.h"
@@ -175,6 +176,15 @@ bool CPU_HasPendingAction() {
 
 void CPU_Shutdown();
 
+// The CPU-side equivalent of the per-game shader cache files: where the jit
+// stores which blocks it translated last run, so we can pre-translate at boot.
+static std::string JitBlockCacheFilename() {
+	std::string discID = g_paramSFO.GetDiscID();
+	if (discID.empty())
+		return "";
+	return GetSysDirectory(DIRECTORY_APP_CACHE) + "/" + discID + ".jitblocks";
+}
+
 void CPU_Init() {
 	coreState = CORE_POWERUP;
 	currentMIPS = &mipsr4k;
@@ -256,6 +266,16 @@ void CPU_Init() {
 	if (coreParameter.updateRecent) {
 		g_Config.AddRecent(filename);
 	}
+
+	// Pre-translate the jit blocks from the last run of this game. We're on the
+	// loader thread here, so this overlaps GPU init and the shader cache compile.
+	if (g_Config.bPreloadFunctions && MIPSComp::jit) {
+		std::string cacheFilename = JitBlockCacheFilename();
+		if (!cacheFilename.empty()) {
+			File::CreateFullPath(GetSysDirectory(DIRECTORY_APP_CACHE));
+			MIPSComp::jit->LoadBlockCacheFromFile(cacheFilename);
+		}
+	}
 }
 
 PSP_LoadingLock::PSP_LoadingLock() {
@@ -274,6 +294,14 @@ void CPU_Shutdown() {
 		host->SaveSymbolMap();
 	}
 
+	if (g_Config.bPreloadFunctions && MIPSComp::jit) {
+		std::string cacheFilename = JitBlockCacheFilename();
+		if (!cacheFilename.empty()) {
+			File::CreateFullPath(GetSysDirectory(DIRECTORY_APP_CACHE));
+			MIPSComp::jit->SaveBlockCacheToFile(cacheFilename);
+		}
+	}
+
 	Replacement_Shutdown();
 
 	CoreTiming::Shutdown();
@@ -35,10 +35,41 @@
 #include "GPU/Common/TextureDecoder.h"
 
 static const std::string INI_FILENAME = "textures.ini";
+static const std::string CACHE_FILENAME = "textures.cache";
 static const std::string NEW_TEXTURE_DIR = "new/";
 static const int VERSION = 1;
+static const u32 CACHE_VERSION = 1;
 static const int MAX_MIP_LEVELS = 12;  // 12 should be plenty, 8 is the max mip levels supported by the PSP.
 
+void TextureAliasBloom::Clear() {
+	bits_.clear();
+	mask_ = 0;
+}
+
+void TextureAliasBloom::Init(size_t entries) {
+	// About 8 bits per entry keeps the false positive rate low with 2 probes.
+	size_t bits = 64;
+	while (bits < entries * 8)
+		bits <<= 1;
+	bits_.assign(bits / 8, 0);
+	mask_ = (u32)(bits - 1);
+}
+
+void TextureAliasBloom::Add(u32 value) {
+	u32 p1 = (value * 2654435761U) & mask_;
+	u32 p2 = ((value ^ 0x85EBCA6BU) * 2246822519U) & mask_;
+	bits_[p1 >> 3] |= 1 << (p1 & 7);
+	bits_[p2 >> 3] |= 1 << (p2 & 7);
+}
+
+bool TextureAliasBloom::MaybeContains(u32 value) const {
+	if (bits_.empty())
+		return false;
+	u32 p1 = (value * 2654435761U) & mask_;
+	u32 p2 = ((value ^ 0x85EBCA6BU) * 2246822519U) & mask_;
+	return (bits_[p1 >> 3] & (1 << (p1 & 7))) != 0 && (bits_[p2 >> 3] & (1 << (p2 & 7))) != 0;
+}
+
 TextureReplacer::TextureReplacer() {
 	none_.alphaStatus_ = ReplacedTextureAlpha::UNKNOWN;
 }
@@ -76,12 +107,20 @@ bool TextureReplacer::LoadIni() {
 	hash_ = ReplacedTextureHash::QUICK;
 	aliases_.clear();
 	hashranges_.clear();
+	aliasesBloom_.Clear();
 
 	allowVideo_ = false;
 	ignoreAddress_ = false;
 	reduceHash_ = false;
 
 	if (File::Exists(basePath_ + INI_FILENAME)) {
+		// Parsing a large pack's ini can take seconds, so the result is kept
+		// in a binary sidecar, validated against the ini file's size/mtime.
+		if (LoadCache()) {
+			BuildAliasBloom();
+			return true;
+		}
+
 		IniFile ini;
 		ini.LoadFromVFS(basePath_ + INI_FILENAME);
 
@@ -100,14 +139,190 @@ bool TextureReplacer::LoadIni() {
 				if (!LoadIniValues(overrideIni, true)) {
 					return false;
 				}
+			} else {
+				overrideFilename.clear();
 			}
 		}
+
+		BuildAliasBloom();
+		SaveCache(overrideFilename);
 	}
 
 	// The ini doesn't have to exist for it to be valid.
 	return true;
 }
 
+// Binary sidecar with the parsed result of textures.ini, so huge packs don't
+// pay the text parse on every boot.  Little-endian, regenerated whenever the
+// ini files on disk change.  Layout after the header: the override ini's
+// filename, then the alias and hashrange tables, then a string pool that the
+// alias entries index into.
+struct TexCacheHeader {
+	char magic[4];
+	u32 version;
+	u64 iniSize;
+	u64 iniMtime;
+	u64 overrideSize;
+	u64 overrideMtime;
+	u32 overrideNameLen;
+	u8 hashType;
+	u8 allowVideo;
+	u8 ignoreAddress;
+	u8 reduceHash;
+	u32 numAliases;
+	u32 numHashranges;
+	u32 stringPoolSize;
+};
+
+struct TexCacheAlias {
+	u64 cachekey;
+	u32 hash;
+	u32 level;
+	u32 nameOffset;
+	u32 nameLen;
+};
+
+struct TexCacheHashRange {
+	u64 key;
+	u32 w;
+	u32 h;
+};
+
+bool TextureReplacer::LoadCache() {
+	File::FileDetails iniDetails;
+	if (!File::GetFileDetails(basePath_ + INI_FILENAME, &iniDetails))
+		return false;
+
+	FILE *f = File::OpenCFile(basePath_ + CACHE_FILENAME, "rb");
+	if (!f)
+		return false;
+
+	TexCacheHeader header;
+	bool good = fread(&header, sizeof(header), 1, f) == 1;
+	good = good && memcmp(header.magic, "PTXC", 4) == 0 && header.version == CACHE_VERSION;
+	good = good && header.iniSize == iniDetails.size && header.iniMtime == iniDetails.mtime;
+	// Sanity caps, in case the file is corrupt.
+	good = good && header.overrideNameLen <= 0x1000 && header.numAliases <= 0x1000000;
+	good = good && header.numHashranges <= 0x1000000 && header.stringPoolSize <= 0x10000000;
+
+	if (good && header.overrideNameLen != 0) {
+		std::string overrideFilename;
+		overrideFilename.resize(header.overrideNameLen);
+		good = fread(&overrideFilename[0], 1, header.overrideNameLen, f) == header.overrideNameLen;
+
+		File::FileDetails overrideDetails;
+		good = good && File::GetFileDetails(basePath_ + overrideFilename, &overrideDetails);
+		good = good && header.overrideSize == overrideDetails.size && header.overrideMtime == overrideDetails.mtime;
+	}
+
+	std::vector<TexCacheAlias> aliases;
+	std::vector<TexCacheHashRange> ranges;
+	std::string pool;
+	if (good) {
+		aliases.resize(header.numAliases);
+		ranges.resize(header.numHashranges);
+		pool.resize(header.stringPoolSize);
+		if (header.numAliases != 0)
+			good = fread(&aliases[0], sizeof(TexCacheAlias), header.numAliases, f) == header.numAliases;
+		if (good && header.numHashranges != 0)
+			good = fread(&ranges[0], sizeof(TexCacheHashRange), header.numHashranges, f) == header.numHashranges;
+		if (good && header.stringPoolSize != 0)
+			good = fread(&pool[0], 1, header.stringPoolSize, f) == header.stringPoolSize;
+	}
+	fclose(f);
+	if (!good)
+		return false;
+
+	for (const TexCacheAlias &a : aliases) {
+		if ((u64)a.nameOffset + a.nameLen > pool.size()) {
+			aliases_.clear();
+			return false;
+		}
+		aliases_[ReplacementAliasKey(a.cachekey, a.hash, a.level)] = pool.substr(a.nameOffset, a.nameLen);
+	}
+	for (const TexCacheHashRange &r : ranges) {
+		hashranges_[r.key] = WidthHeightPair(r.w, r.h);
+	}
+
+	hash_ = (ReplacedTextureHash)header.hashType;
+	allowVideo_ = header.allowVideo != 0;
+	ignoreAddress_ = header.ignoreAddress != 0;
+	reduceHash_ = header.reduceHash != 0;
+	return true;
+}
+
+void TextureReplacer::SaveCache(const std::string &overrideFilename) {
+	File::FileDetails iniDetails;
+	if (!File::GetFileDetails(basePath_ + INI_FILENAME, &iniDetails))
+		return;
+
+	TexCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "PTXC", 4);
+	header.version = CACHE_VERSION;
+	header.iniSize = iniDetails.size;
+	header.iniMtime = iniDetails.mtime;
+	if (!overrideFilename.empty()) {
+		File::FileDetails overrideDetails;
+		if (!File::GetFileDetails(basePath_ + overrideFilename, &overrideDetails))
+			return;
+		header.overrideSize = overrideDetails.size;
+		header.overrideMtime = overrideDetails.mtime;
+		header.overrideNameLen = (u32)overrideFilename.size();
+	}
+	header.hashType = (u8)hash_;
+	header.allowVideo = allowVideo_ ? 1 : 0;
+	header.ignoreAddress = ignoreAddress_ ? 1 : 0;
+	header.reduceHash = reduceHash_ ? 1 : 0;
+	header.numAliases = (u32)aliases_.size();
+	header.numHashranges = (u32)hashranges_.size();
+
+	std::vector<TexCacheAlias> aliases;
+	std::string pool;
+	aliases.reserve(aliases_.size());
+	for (const auto &item : aliases_) {
+		TexCacheAlias a = { item.first.cachekey, item.first.hash, item.first.level, (u32)pool.size(), (u32)item.second.size() };
+		pool += item.second;
+		aliases.push_back(a);
+	}
+	header.stringPoolSize = (u32)pool.size();
+
+	std::vector<TexCacheHashRange> ranges;
+	ranges.reserve(hashranges_.size());
+	for (const auto &item : hashranges_) {
+		TexCacheHashRange r = { item.first, (u32)item.second.first, (u32)item.second.second };
+		ranges.push_back(r);
+	}
+
+	FILE *f = File::OpenCFile(basePath_ + CACHE_FILENAME, "wb");
+	if (!f) {
+		// Probably a read-only pack directory - we'll just parse each boot.
+		return;
+	}
+	bool good = fwrite(&header, sizeof(header), 1, f) == 1;
+	if (good && header.overrideNameLen != 0)
+		good = fwrite(overrideFilename.data(), 1, overrideFilename.size(), f) == overrideFilename.size();
+	if (good && !aliases.empty())
+		good = fwrite(&aliases[0], sizeof(TexCacheAlias), aliases.size(), f) == aliases.size();
+	if (good && !ranges.empty())
+		good = fwrite(&ranges[0], sizeof(TexCacheHashRange), ranges.size(), f) == ranges.size();
+	if (good && !pool.empty())
+		good = fwrite(&pool[0], 1, pool.size(), f) == pool.size();
+	fclose(f);
+
+	if (!good) {
+		// Don't leave a truncated cache behind.
+		File::Delete(basePath_ + CACHE_FILENAME);
+	}
+}
+
+void TextureReplacer::BuildAliasBloom() {
+	aliasesBloom_.Init(aliases_.size());
+	for (const auto &item : aliases_) {
+		aliasesBloom_.Add(item.first.hash);
+	}
+}
+
 bool TextureReplacer::LoadIniValues(IniFile &ini, bool isOverride) {
 	auto options = ini.GetOrCreateSection("options");
 	std::string hash;
@@ -518,6 +733,13 @@ void TextureReplacer::NotifyTextureDecoded(const ReplacedTextureDecodeInfo &repl
 }
 
 std::string TextureReplacer::LookupHashFile(u64 cachekey, u32 hash, int level) {
+	// Every probe below uses either this hash or zero, so if the bloom filter
+	// has neither, no alias can possibly match.  This is the common case for
+	// unreplaced textures, even in large packs.
+	if (!aliasesBloom_.MaybeContains(hash) && !aliasesBloom_.MaybeContains(0)) {
+		return HashName(cachekey, hash, level) + ".png";
+	}
+
 	ReplacementAliasKey key(cachekey, hash, level);
 	auto alias = aliases_.find(key);
 	if (alias == aliases_.end()) {
@@ -121,6 +121,19 @@ namespace std {
 	};
 }
 
+// A small bloom filter over the data hashes appearing in [hashes] aliases.
+// Most textures in most packs have no alias, and this answers that case
+// without touching the alias map - see TextureReplacer::LookupHashFile.
+struct TextureAliasBloom {
+	void Clear();
+	void Init(size_t entries);
+	void Add(u32 value);
+	bool MaybeContains(u32 value) const;
+
+	std::vector<u8> bits_;
+	u32 mask_ = 0;
+};
+
 struct ReplacedTexture {
 	inline bool Valid() {
 		return !levels_.empty();
@@ -192,6 +205,9 @@ public:
 protected:
 	bool LoadIni();
 	bool LoadIniValues(IniFile &ini, bool isOverride = false);
+	bool LoadCache();
+	void SaveCache(const std::string &overrideFilename);
+	void BuildAliasBloom();
 	void ParseHashRange(const std::string &key, const std::string &value);
 	bool LookupHashRange(u32 addr, int &w, int &h);
 	std::string LookupHashFile(u64 cachekey, u32 hash, int level);
@@ -209,6 +225,7 @@ protected:
 	typedef std::pair<int, int> WidthHeightPair;
 	std::unordered_map<u64, WidthHeightPair> hashranges_;
 	std::unordered_map<ReplacementAliasKey, std::string> aliases_;
+	TextureAliasBloom aliasesBloom_;
 
 	ReplacedTexture none_;
 	std::unordered_map<ReplacementCacheKey, ReplacedTexture> cache_;
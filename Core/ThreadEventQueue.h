@@ -17,16 +17,90 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
-#include <deque>
+#include <new>
+#include <thread>
+#include <type_traits>
 
 #include "Core/System.h"
 #include "Core/CoreTiming.h"
 
+// Bounded lock-free queue (multiple producers, one consumer), based on the
+// usual sequence-number ring. Push and Pop never take a lock - the consumer
+// only parks on a condvar when the ring is empty, see ThreadEventQueue below.
+template <typename T, size_t SIZE>
+struct LockFreeEventRing {
+	static_assert((SIZE & (SIZE - 1)) == 0, "SIZE must be a power of 2");
+
+	LockFreeEventRing() {
+		for (size_t i = 0; i < SIZE; ++i) {
+			cells_[i].seq.store((u64)i, std::memory_order_relaxed);
+		}
+		head_.store(0, std::memory_order_relaxed);
+		tail_.store(0, std::memory_order_relaxed);
+	}
+
+	// Any thread. Returns false if the ring is full.
+	bool Push(const T &v) {
+		u64 pos = tail_.load(std::memory_order_relaxed);
+		Cell *cell;
+		for (;;) {
+			cell = &cells_[pos & (SIZE - 1)];
+			u64 seq = cell->seq.load(std::memory_order_acquire);
+			s64 dif = (s64)seq - (s64)pos;
+			if (dif == 0) {
+				if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (dif < 0) {
+				return false;
+			} else {
+				pos = tail_.load(std::memory_order_relaxed);
+			}
+		}
+		new (&cell->value) T(v);
+		cell->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer thread only. Returns false if empty.
+	bool Pop(T *v) {
+		u64 pos = head_.load(std::memory_order_relaxed);
+		Cell *cell = &cells_[pos & (SIZE - 1)];
+		u64 seq = cell->seq.load(std::memory_order_acquire);
+		if ((s64)seq - (s64)(pos + 1) < 0)
+			return false;
+		T *stored = reinterpret_cast<T *>(&cell->value);
+		*v = *stored;
+		stored->~T();
+		cell->seq.store(pos + SIZE, std::memory_order_release);
+		head_.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Any thread. May briefly claim non-empty for a push still being written,
+	// which is no worse than the old locked deque.
+	bool Empty() const {
+		return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+	}
+
+private:
+	struct Cell {
+		std::atomic<u64> seq;
+		// Raw storage, since events need not be default constructible.
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+	};
+
+	Cell cells_[SIZE];
+	// head_ is only touched by the consumer, but read by Empty() on any thread.
+	std::atomic<u64> head_;
+	std::atomic<u64> tail_;
+};
+
 template <typename B, typename Event, typename EventType, EventType EVENT_INVALID, EventType EVENT_SYNC, EventType EVENT_FINISH>
 struct ThreadEventQueue : public B {
-	ThreadEventQueue() : threadEnabled_(false), eventsRunning_(false), eventsHaveRun_(false) {
+	ThreadEventQueue() : threadEnabled_(false), eventsRunning_(false), eventsHaveRun_(false), consumerWaiting_(false) {
 	}
 
 	void SetThreadEnabled(bool threadEnabled) {
@@ -39,25 +113,29 @@ struct ThreadEventQueue : public B {
 
 	void ScheduleEvent(Event ev) {
 		if (threadEnabled_) {
-			std::lock_guard<std::recursive_mutex> guard(eventsLock_);
-			events_.push_back(ev);
-			eventsWait_.notify_one();
+			while (!events_.Push(ev)) {
+				// Full - kick the consumer and give it a chance to drain.
+				{
+					std::lock_guard<std::recursive_mutex> guard(eventsLock_);
+					eventsWait_.notify_one();
+				}
+				std::this_thread::yield();
+			}
+			// Pairs with the fence in RunEventsUntil: either we see the consumer's
+			// waiting flag, or it sees our push before parking.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (consumerWaiting_.load(std::memory_order_relaxed)) {
+				std::lock_guard<std::recursive_mutex> guard(eventsLock_);
+				eventsWait_.notify_one();
+			}
 		} else {
-			events_.push_back(ev);
-		}
-
-		if (!threadEnabled_) {
+			events_.Push(ev);
 			RunEventsUntil(0);
 		}
 	}
 
 	bool HasEvents() {
-		if (threadEnabled_) {
-			std::lock_guard<std::recursive_mutex> guard(eventsLock_);
-			return !events_.empty();
-		} else {
-			return !events_.empty();
-		}
+		return !events_.Empty();
 	}
 
 	void NotifyDrain() {
@@ -68,24 +146,14 @@ struct ThreadEventQueue : public B {
 	}
 
 	Event GetNextEvent() {
-		if (threadEnabled_) {
-			std::lock_guard<std::recursive_mutex> guard(eventsLock_);
-			if (events_.empty()) {
+		Event ev(EVENT_INVALID);
+		if (!events_.Pop(&ev)) {
+			if (threadEnabled_) {
 				NotifyDrain();
-				return EVENT_INVALID;
 			}
-
-			Event ev = events_.front();
-			events_.pop_front();
-			return ev;
-		} else {
-			if (events_.empty()) {
-				return EVENT_INVALID;
-			}
-			Event ev = events_.front();
-			events_.pop_front();
-			return ev;
+			return EVENT_INVALID;
 		}
+		return ev;
 	}
 
 	void RunEventsUntil(u64 globalticks) {
@@ -98,28 +166,43 @@ struct ThreadEventQueue : public B {
 			return;
 		}
 
-		std::unique_lock<std::recursive_mutex> guard(eventsLock_);
-		eventsRunning_ = true;
-		eventsHaveRun_ = true;
+		{
+			std::lock_guard<std::recursive_mutex> guard(eventsLock_);
+			eventsRunning_ = true;
+			eventsHaveRun_ = true;
+		}
 		do {
-			while (events_.empty() && !ShouldExitEventLoop()) {
-				eventsWait_.wait(guard);
+			bool exiting = false;
+			{
+				std::unique_lock<std::recursive_mutex> guard(eventsLock_);
+				while (events_.Empty() && !ShouldExitEventLoop()) {
+					consumerWaiting_.store(true, std::memory_order_relaxed);
+					// Pairs with the fence in ScheduleEvent, see above.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (!events_.Empty()) {
+						break;
+					}
+					eventsWait_.wait(guard);
+				}
+				consumerWaiting_.store(false, std::memory_order_relaxed);
+				// Quit the loop if the queue is drained and coreState has tripped, or threading is disabled.
+				exiting = events_.Empty();
 			}
-			// Quit the loop if the queue is drained and coreState has tripped, or threading is disabled.
-			if (events_.empty()) {
+			if (exiting) {
 				break;
 			}
 
 			for (Event ev = GetNextEvent(); EventType(ev) != EVENT_INVALID; ev = GetNextEvent()) {
-				guard.unlock();
 				ProcessEventIfApplicable(ev, globalticks);
-				guard.lock();
 			}
 		} while (CoreTiming::GetTicks() < globalticks);
 
 		// This will force the waiter to check coreState, even if we didn't actually drain.
 		NotifyDrain();
-		eventsRunning_ = false;
+		{
+			std::lock_guard<std::recursive_mutex> guard(eventsLock_);
+			eventsRunning_ = false;
+		}
 	}
 
 	void SyncBeginFrame() {
@@ -198,7 +281,10 @@ private:
 	bool threadEnabled_;
 	bool eventsRunning_;
 	bool eventsHaveRun_;
-	std::deque<Event> events_;
+	// Push/pop is lock-free; eventsLock_ only guards the state flags above and
+	// parking on the condvars when the ring runs empty or full.
+	LockFreeEventRing<Event, 256> events_;
+	std::atomic<bool> consumerWaiting_;
 	std::recursive_mutex eventsLock_;  // TODO: Should really make this non-recursive - condition_variable_any is dangerous
 	std::condition_variable_any eventsWait_;
 	std::condition_variable_any eventsDrain_;
@@ -42,6 +42,7 @@ void BlockAllocator::Init(u32 rangeStart, u32 rangeSize)
 	//Initial block, covering everything
 	top_ = new Block(rangeStart_, rangeSize_, false, NULL, NULL);
 	bottom_ = top_;
+	RegisterFree(top_);
 }
 
 void BlockAllocator::Shutdown()
@@ -53,6 +54,7 @@ void BlockAllocator::Shutdown()
 		bottom_ = next;
 	}
 	top_ = NULL;
+	freeBlocks_.clear();
 }
 
 u32 BlockAllocator::AllocAligned(u32 &size, u32 sizeGrain, u32 grain, bool fromTop, const char *tag)
@@ -74,20 +76,22 @@ u32 BlockAllocator::AllocAligned(u32 &size, u32 sizeGrain, u32 grain, bool fromT
 
 	if (!fromTop)
 	{
-		//Allocate from bottom of mem
-		for (Block *bp = bottom_; bp != NULL; bp = bp->next)
+		// Allocate from bottom of mem. Still first-fit in address order, the index
+		// just lets us skip over all the taken blocks.
+		for (auto iter = freeBlocks_.begin(); iter != freeBlocks_.end(); ++iter)
 		{
-			Block &b = *bp;
+			Block &b = *iter->second;
 			u32 offset = b.start % grain;
 			if (offset != 0)
 				offset = grain - offset;
 			u32 needed = offset + size;
-			if (b.taken == false && b.size >= needed)
+			if (b.size >= needed)
 			{
 				if (b.size == needed)
 				{
 					if (offset >= grain_)
 						InsertFreeBefore(&b, offset);
+					UnregisterFree(&b);
 					b.taken = true;
 					b.SetTag(tag);
 					return b.start;
@@ -97,6 +101,7 @@ u32 BlockAllocator::AllocAligned(u32 &size, u32 sizeGrain, u32 grain, bool fromT
 					InsertFreeAfter(&b, b.size - needed);
 					if (offset >= grain_)
 						InsertFreeBefore(&b, offset);
+					UnregisterFree(&b);
 					b.taken = true;
 					b.SetTag(tag);
 					return b.start;
@@ -107,17 +112,18 @@ u32 BlockAllocator::AllocAligned(u32 &size, u32 sizeGrain, u32 grain, bool fromT
 	else
 	{
 		// Allocate from top of mem.
-		for (Block *bp = top_; bp != NULL; bp = bp->prev)
+		for (auto iter = freeBlocks_.rbegin(); iter != freeBlocks_.rend(); ++iter)
 		{
-			Block &b = *bp;
+			Block &b = *iter->second;
 			u32 offset = (b.start + b.size - size) % grain;
 			u32 needed = offset + size;
-			if (b.taken == false && b.size >= needed)
+			if (b.size >= needed)
 			{
 				if (b.size == needed)
 				{
 					if (offset >= grain_)
 						InsertFreeAfter(&b, offset);
+					UnregisterFree(&b);
 					b.taken = true;
 					b.SetTag(tag);
 					return b.start;
@@ -127,6 +133,7 @@ u32 BlockAllocator::AllocAligned(u32 &size, u32 sizeGrain, u32 grain, bool fromT
 					InsertFreeBefore(&b, b.size - needed);
 					if (offset >= grain_)
 						InsertFreeAfter(&b, offset);
+					UnregisterFree(&b);
 					b.taken = true;
 					b.SetTag(tag);
 					return b.start;
@@ -193,6 +200,7 @@ u32 BlockAllocator::AllocAt(u32 position, u32 size, const char *tag)
 			{
 				if (b.size != alignedSize)
 					InsertFreeAfter(&b, b.size - alignedSize);
+				UnregisterFree(&b);
 				b.taken = true;
 				b.SetTag(tag);
 				CheckBlocks();
@@ -203,6 +211,7 @@ u32 BlockAllocator::AllocAt(u32 position, u32 size, const char *tag)
 				InsertFreeBefore(&b, alignedPosition - b.start);
 				if (b.size > alignedSize)
 					InsertFreeAfter(&b, b.size - alignedSize);
+				UnregisterFree(&b);
 				b.taken = true;
 				b.SetTag(tag);
 
@@ -236,6 +245,7 @@ void BlockAllocator::MergeFreeBlocks(Block *fromBlock)
 		else
 			fromBlock->next->prev = prev;
 		prev->next = fromBlock->next;
+		UnregisterFree(fromBlock);
 		delete fromBlock;
 		fromBlock = prev;
 		prev = fromBlock->prev;
@@ -252,6 +262,7 @@ void BlockAllocator::MergeFreeBlocks(Block *fromBlock)
 		DEBUG_LOG(SCEKERNEL, "Block Alloc found adjacent free blocks - merging");
 		fromBlock->size += next->size;
 		fromBlock->next = next->next;
+		UnregisterFree(next);
 		delete next;
 		next = fromBlock->next;
 	}
@@ -260,6 +271,10 @@ void BlockAllocator::MergeFreeBlocks(Block *fromBlock)
 		top_ = fromBlock;
 	else
 		next->prev = fromBlock;
+
+	// Whether fromBlock is the newly freed block or a neighbor it merged into,
+	// this (re-)registers it under the right address.
+	RegisterFree(fromBlock);
 }
 
 bool BlockAllocator::Free(u32 position)
@@ -296,6 +311,9 @@ bool BlockAllocator::FreeExact(u32 position)
 
 BlockAllocator::Block *BlockAllocator::InsertFreeBefore(Block *b, u32 size)
 {
+	// b's start is about to move, so it changes key in the free index.
+	UnregisterFree(b);
+
 	Block *inserted = new Block(b->start, size, false, b->prev, b);
 	b->prev = inserted;
 	if (inserted->prev == NULL)
@@ -305,6 +323,9 @@ BlockAllocator::Block *BlockAllocator::InsertFreeBefore(Block *b, u32 size)
 
 	b->start += size;
 	b->size -= size;
+	RegisterFree(inserted);
+	if (!b->taken)
+		RegisterFree(b);
 	return inserted;
 }
 
@@ -318,6 +339,7 @@ BlockAllocator::Block *BlockAllocator::InsertFreeAfter(Block *b, u32 size)
 		inserted->next->prev = inserted;
 
 	b->size -= size;
+	RegisterFree(inserted);
 	return inserted;
 }
 
@@ -401,14 +423,11 @@ void BlockAllocator::ListBlocks() const
 u32 BlockAllocator::GetLargestFreeBlockSize() const
 {
 	u32 maxFreeBlock = 0;
-	for (const Block *bp = bottom_; bp != NULL; bp = bp->next)
+	for (auto iter = freeBlocks_.begin(); iter != freeBlocks_.end(); ++iter)
 	{
-		const Block &b = *bp;
-		if (!b.taken)
-		{
-			if (b.size > maxFreeBlock)
-				maxFreeBlock = b.size;
-		}
+		const Block &b = *iter->second;
+		if (b.size > maxFreeBlock)
+			maxFreeBlock = b.size;
 	}
 	if (maxFreeBlock & (grain_ - 1))
 		WARN_LOG_REPORT(HLE, "GetLargestFreeBlockSize: free size %08x does not align to grain %08x.", maxFreeBlock, grain_);
@@ -418,13 +437,9 @@ u32 BlockAllocator::GetLargestFreeBlockSize() const
 u32 BlockAllocator::GetTotalFreeBytes() const
 {
 	u32 sum = 0;
-	for (const Block *bp = bottom_; bp != NULL; bp = bp->next)
+	for (auto iter = freeBlocks_.begin(); iter != freeBlocks_.end(); ++iter)
 	{
-		const Block &b = *bp;
-		if (!b.taken)
-		{
-			sum += b.size;
-		}
+		sum += iter->second->size;
 	}
 	if (sum & (grain_ - 1))
 		WARN_LOG_REPORT(HLE, "GetTotalFreeBytes: free size %08x does not align to grain %08x.", sum, grain_);
@@ -476,6 +491,17 @@ void BlockAllocator::DoState(PointerWrap &p)
 	p.Do(rangeStart_);
 	p.Do(rangeSize_);
 	p.Do(grain_);
+
+	if (p.mode == p.MODE_READ)
+	{
+		// Rebuild the free index from the loaded chain.
+		freeBlocks_.clear();
+		for (Block *bp = bottom_; bp != NULL; bp = bp->next)
+		{
+			if (!bp->taken)
+				RegisterFree(bp);
+		}
+	}
 }
 
 BlockAllocator::Block::Block(u32 _start, u32 _size, bool _taken, Block *_prev, Block *_next)
@@ -19,6 +19,8 @@
 
 class PointerWrap;
 
+#include <map>
+
 #include "Common/CommonTypes.h"
 
 class BlockAllocator
@@ -79,6 +81,18 @@ private:
 
 	u32 grain_;
 
+	// Address-ordered index of the free blocks only, so allocations don't have to
+	// walk the taken ones. Note: can't be a best-fit structure - the first-fit
+	// address-order behavior is observable through the addresses games get back.
+	std::map<u32, Block *> freeBlocks_;
+
+	void RegisterFree(Block *b) {
+		freeBlocks_[b->start] = b;
+	}
+	void UnregisterFree(Block *b) {
+		freeBlocks_.erase(b->start);
+	}
+
 	void MergeFreeBlocks(Block *fromBlock);
 	Block *GetBlockFromAddress(u32 addr);
 	const Block *GetBlockFromAddress(u32 addr) const;
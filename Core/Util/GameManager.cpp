@@ -17,12 +17,20 @@
 
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
+#include <deque>
 #include <string>
 #include <set>
 #include <cstring>
+#include <mutex>
 #include <thread>
 
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
 #include "file/file_util.h"
+#include "thread/threadutil.h"
 #ifdef SHARED_LIBZIP
 #include <zip.h>
 #else
@@ -35,6 +43,7 @@
 #include "Common/StringUtils.h"
 #include "Core/Config.h"
 #include "Core/Loaders.h"
+#include "Core/FileSystems/BlockDevices.h"
 #include "Core/ELF/ParamSFO.h"
 #include "Core/ELF/PBPReader.h"
 #include "Core/System.h"
@@ -420,6 +429,99 @@ std::string GameManager::GetISOGameID(FileLoader *loader) const {
 	return sfo.GetValueString("DISC_ID");
 }
 
+namespace {
+
+// Writes queued buffers to a file on its own thread, so that inflating the
+// next chunk from the zip overlaps with flushing the previous one to disk.
+class AsyncFileWriter {
+public:
+	explicit AsyncFileWriter(FILE *f) : f_(f) {
+		thread_ = std::thread([this] {
+			setCurrentThreadName("ZipInstallWrite");
+			Run();
+		});
+	}
+
+	~AsyncFileWriter() {
+		Finish();
+	}
+
+	// Takes ownership of data, which must come from new[].
+	void Write(u8 *data, size_t size) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		// Keep only a few chunks in flight so memory use stays bounded.
+		while (queue_.size() >= 4 && !failed_) {
+			drained_.wait(lock);
+		}
+		if (failed_) {
+			delete[] data;
+			return;
+		}
+		queue_.push_back(Chunk{ data, size });
+		wake_.notify_one();
+	}
+
+	bool Failed() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return failed_;
+	}
+
+	// Waits for all queued writes. Returns false if any of them failed.
+	bool Finish() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			done_ = true;
+			wake_.notify_one();
+		}
+		if (thread_.joinable()) {
+			thread_.join();
+		}
+		return !failed_;
+	}
+
+private:
+	struct Chunk {
+		u8 *data;
+		size_t size;
+	};
+
+	void Run() {
+		while (true) {
+			Chunk chunk;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				while (queue_.empty() && !done_) {
+					wake_.wait(lock);
+				}
+				if (queue_.empty()) {
+					break;
+				}
+				chunk = queue_.front();
+				queue_.pop_front();
+			}
+			bool ok = fwrite(chunk.data, 1, chunk.size, f_) == chunk.size;
+			delete[] chunk.data;
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (!ok) {
+					failed_ = true;
+				}
+				drained_.notify_one();
+			}
+		}
+	}
+
+	FILE *f_;
+	std::thread thread_;
+	std::mutex mutex_;
+	std::condition_variable wake_, drained_;
+	std::deque<Chunk> queue_;
+	bool done_ = false;
+	bool failed_ = false;
+};
+
+}  // namespace
+
 bool GameManager::ExtractFile(struct zip *z, int file_index, std::string outFilename, size_t *bytesCopied, size_t allBytes) {
 	struct zip_stat zstat;
 	zip_stat_index(z, file_index, 0, &zstat);
@@ -433,40 +535,51 @@ bool GameManager::ExtractFile(struct zip *z, int file_index, std::string outFile
 	zip_file *zf = zip_fopen_index(z, file_index, 0);
 	FILE *f = File::OpenCFile(outFilename, "wb");
 	if (f) {
+#ifdef __linux__
+		// Reserve the final size up front, so the filesystem can hand us
+		// contiguous space instead of growing the file chunk by chunk.
+		if (size > 0) {
+			posix_fallocate(fileno(f), 0, (off_t)size);
+		}
+#endif
 		size_t pos = 0;
 		const size_t blockSize = 1024 * 128;
-		u8 *buffer = new u8[blockSize];
+		bool readFailed = false;
+		AsyncFileWriter writer(f);
 		while (pos < size) {
 			size_t readSize = std::min(blockSize, size - pos);
+			u8 *buffer = new u8[readSize];
 			ssize_t retval = zip_fread(zf, buffer, readSize);
 			if (retval < 0 || (size_t)retval < readSize) {
 				ERROR_LOG(HLE, "Failed to read %d bytes from zip (%d) - archive corrupt?", (int)readSize, (int)retval);
 				delete[] buffer;
-				fclose(f);
-				zip_fclose(zf);
-				File::Delete(outFilename.c_str());
-				return false;
+				readFailed = true;
+				break;
 			}
-			size_t written = fwrite(buffer, 1, readSize, f);
-			if (written != readSize) {
-				ERROR_LOG(HLE, "Wrote %d bytes out of %d - Disk full?", (int)written, (int)readSize);
-				delete[] buffer;
-				fclose(f);
-				zip_fclose(zf);
-				File::Delete(outFilename.c_str());
-				return false;
+			writer.Write(buffer, readSize);
+			if (writer.Failed()) {
+				// Error reported below.
+				break;
 			}
 			pos += readSize;
 
 			*bytesCopied += readSize;
 			installProgress_ = (float)*bytesCopied / (float)allBytes;
 		}
+		bool writeOk = writer.Finish();
 		zip_fclose(zf);
 		fclose(f);
-		delete[] buffer;
+		if (readFailed || !writeOk) {
+			if (!writeOk) {
+				ERROR_LOG(HLE, "Failed writing to '%s' - disk full?", outFilename.c_str());
+			}
+			File::Delete(outFilename.c_str());
+			return false;
+		}
 		return true;
 	} else {
 		ERROR_LOG(HLE, "Failed to open file for writing");
+		zip_fclose(zf);
 		return false;
 	}
 }
@@ -584,6 +697,14 @@ bool GameManager::InstallZippedISO(struct zip *z, int isoFileIndex, std::string
 	size_t bytesCopied = 0;
 	if (ExtractFile(z, isoFileIndex, outputISOFilename, &bytesCopied, allBytes)) {
 		ILOG("Successfully extracted ISO file to '%s'", outputISOFilename.c_str());
+		if (g_Config.bCompressISOOnInstall && endsWithNoCase(outputISOFilename, ".iso")) {
+			std::string csoFilename = outputISOFilename.substr(0, outputISOFilename.size() - 4) + ".cso";
+			installProgress_ = 0.0f;
+			if (ConvertISOToCISO(outputISOFilename, csoFilename, CSO_DEFAULT_WRITE_FRAME_SIZE, &installProgress_)) {
+				File::Delete(outputISOFilename.c_str());
+			}
+			// On failure the plain ISO is still in place, so nothing more to do.
+		}
 	}
 	zip_close(z);
 	if (deleteAfter) {
@@ -609,11 +730,18 @@ bool GameManager::InstallGameOnThread(std::string url, std::string fileName, boo
 
 bool GameManager::InstallRawISO(const std::string &file, const std::string &originalName, bool deleteAfter) {
 	std::string destPath = g_Config.currentDirectory + "/" + originalName;
+	bool installed = false;
+	if (g_Config.bCompressISOOnInstall && endsWithNoCase(originalName, ".iso")) {
+		std::string csoPath = destPath.substr(0, destPath.size() - 4) + ".cso";
+		installed = ConvertISOToCISO(file, csoPath, CSO_DEFAULT_WRITE_FRAME_SIZE, &installProgress_);
+		// On failure, fall through and install the plain ISO instead.
+	}
 	// TODO: To save disk space, we should probably attempt a move first.
-	if (File::Copy(file, destPath)) {
-		if (deleteAfter) {
-			File::Delete(file.c_str());
-		}
+	if (!installed) {
+		installed = File::Copy(file, destPath);
+	}
+	if (installed && deleteAfter) {
+		File::Delete(file.c_str());
 	}
 	installProgress_ = 1.0f;
 	installInProgress_ = false;
@@ -16,6 +16,8 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <map>
+#include <tuple>
 
 #include "base/stringutil.h"
 #include "image/zim_load.h"
@@ -99,6 +101,39 @@ static AtlasCharLine char_one_line;
 static AtlasLineArray char_lines;
 static AtlasTextMetrics char_lines_metrics;
 
+// The save dialog and OSK draw the same strings every frame, and BreakLines
+// is a full UTF-8 word-wrap pass - so cache shaped layouts by their inputs.
+// Entries unused for a while get decimated in PPGeEnd, like PPGeImage does.
+struct TextLayoutKey {
+	std::string text;
+	float x;
+	float y;
+	int align;
+	float scale;
+	float lineHeightScale;
+	int wrapType;
+	int wrapWidth;
+	bool dryRun;
+
+	bool operator <(const TextLayoutKey &other) const {
+		int cmp = text.compare(other.text);
+		if (cmp != 0)
+			return cmp < 0;
+		return std::tie(x, y, align, scale, lineHeightScale, wrapType, wrapWidth, dryRun) <
+			std::tie(other.x, other.y, other.align, other.scale, other.lineHeightScale, other.wrapType, other.wrapWidth, other.dryRun);
+	}
+};
+
+struct TextLayoutEntry {
+	AtlasLineArray lines;
+	AtlasTextMetrics metrics;
+	int lastFrame;
+};
+
+static std::map<TextLayoutKey, TextLayoutEntry> textLayoutCache;
+
+static void DecimateTextLayoutCache();
+
 //only 0xFFFFFF of data is used
 static void WriteCmd(u8 cmd, u32 data) {
 	Memory::Write_U32((cmd << 24) | (data & 0xFFFFFF), dlWritePtr);
@@ -280,6 +315,8 @@ void __PPGeShutdown()
 	dlPtr = 0;
 	savedContextPtr = 0;
 	listArgs = 0;
+
+	textLayoutCache.clear();
 }
 
 void PPGeBegin()
@@ -339,6 +376,8 @@ void PPGeEnd()
 		DEBUG_LOG(SCEGE, "PPGe enqueued display list %i", list);
 		gpu->EnableInterrupts(true);
 	}
+
+	DecimateTextLayoutCache();
 }
 
 static const AtlasChar *PPGeGetChar(const AtlasFont &atlasfont, unsigned int cval)
@@ -614,11 +653,32 @@ static AtlasTextMetrics BreakLines(const char *text, const AtlasFont &atlasfont,
 	return metrics;
 }
 
-void PPGeMeasureText(float *w, float *h, int *n, 
+static void DecimateTextLayoutCache() {
+	static const int TOO_OLD_AGE = 10;
+	int tooOldFrame = gpuStats.numFlips - TOO_OLD_AGE;
+	for (auto it = textLayoutCache.begin(); it != textLayoutCache.end(); ) {
+		if (it->second.lastFrame < tooOldFrame) {
+			it = textLayoutCache.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void PPGeMeasureText(float *w, float *h, int *n,
 					const char *text, float scale, int WrapType, int wrapWidth)
 {
 	const AtlasFont &atlasfont = *ppge_atlas.fonts[0];
-	AtlasTextMetrics metrics = BreakLines(text, atlasfont, 0, 0, 0, scale, scale, WrapType, wrapWidth, true);
+
+	TextLayoutKey key{ text, 0, 0, 0, scale, scale, WrapType, wrapWidth, true };
+	auto cached = textLayoutCache.find(key);
+	if (cached == textLayoutCache.end()) {
+		AtlasTextMetrics metrics = BreakLines(text, atlasfont, 0, 0, 0, scale, scale, WrapType, wrapWidth, true);
+		cached = textLayoutCache.emplace(std::move(key), TextLayoutEntry{ AtlasLineArray(), metrics, 0 }).first;
+	}
+	cached->second.lastFrame = gpuStats.numFlips;
+
+	const AtlasTextMetrics &metrics = cached->second.metrics;
 	if (w) *w = metrics.maxWidth;
 	if (h) *h = metrics.lineHeight;
 	if (n) *n = metrics.numLines;
@@ -627,7 +687,21 @@ void PPGeMeasureText(float *w, float *h, int *n,
 void PPGePrepareText(const char *text, float x, float y, int align, float scale, float lineHeightScale, int WrapType, int wrapWidth)
 {
 	const AtlasFont &atlasfont = *ppge_atlas.fonts[0];
-	char_lines_metrics = BreakLines(text, atlasfont, x, y, align, scale, lineHeightScale, WrapType, wrapWidth, false);
+
+	TextLayoutKey key{ text, x, y, align, scale, lineHeightScale, WrapType, wrapWidth, false };
+	auto cached = textLayoutCache.find(key);
+	if (cached == textLayoutCache.end()) {
+		// BreakLines appends to char_lines, so remember just the lines it added.
+		size_t linesBefore = char_lines.size();
+		AtlasTextMetrics metrics = BreakLines(text, atlasfont, x, y, align, scale, lineHeightScale, WrapType, wrapWidth, false);
+		AtlasLineArray lines(char_lines.begin() + linesBefore, char_lines.end());
+		cached = textLayoutCache.emplace(std::move(key), TextLayoutEntry{ std::move(lines), metrics, 0 }).first;
+	} else {
+		const AtlasLineArray &lines = cached->second.lines;
+		char_lines.insert(char_lines.end(), lines.begin(), lines.end());
+	}
+	cached->second.lastFrame = gpuStats.numFlips;
+	char_lines_metrics = cached->second.metrics;
 }
 
 void PPGeMeasureCurrentText(float *x, float *y, float *w, float *h, int *n)
@@ -883,28 +957,26 @@ void PPGeDisableTexture()
 std::vector<PPGeImage *> PPGeImage::loadedTextures_;
 
 PPGeImage::PPGeImage(const std::string &pspFilename)
-	: filename_(pspFilename), texture_(0) {
+	: filename_(pspFilename), texture_(0), pendingData_(NULL) {
 }
 
 PPGeImage::PPGeImage(u32 pngPointer, size_t pngSize)
-	: filename_(""), png_(pngPointer), size_(pngSize), texture_(0) {
+	: filename_(""), png_(pngPointer), size_(pngSize), texture_(0), pendingData_(NULL) {
 }
 
 PPGeImage::~PPGeImage() {
 	Free();
+	std::lock_guard<std::mutex> guard(pendingLock_);
+	if (pendingData_) {
+		free(pendingData_);
+		pendingData_ = NULL;
+	}
 }
 
-bool PPGeImage::Load() {
-	Free();
-
-	// In case it fails to load.
-	width_ = 0;
-	height_ = 0;
-
-	unsigned char *textureData;
+bool PPGeImage::ReadAndDecode(unsigned char **data, int *width, int *height) {
 	int success;
 	if (filename_.empty()) {
-		success = pngLoadPtr(Memory::GetPointer(png_), size_, &width_, &height_, &textureData, false);
+		success = pngLoadPtr(Memory::GetPointer(png_), size_, width, height, data, false);
 	} else {
 		std::vector<u8> pngData;
 		if (pspFileSystem.ReadEntireFile(filename_, pngData) < 0) {
@@ -912,12 +984,50 @@ bool PPGeImage::Load() {
 			return false;
 		}
 
-		success = pngLoadPtr((const unsigned char *)&pngData[0], pngData.size(), &width_, &height_, &textureData, false);
+		success = pngLoadPtr((const unsigned char *)&pngData[0], pngData.size(), width, height, data, false);
 	}
 	if (!success) {
 		WARN_LOG(SCEGE, "Bad PPGeImage - not a valid png");
 		return false;
 	}
+	return true;
+}
+
+void PPGeImage::Preload() {
+	unsigned char *data;
+	int width, height;
+	if (!ReadAndDecode(&data, &width, &height))
+		return;
+
+	std::lock_guard<std::mutex> guard(pendingLock_);
+	if (pendingData_)
+		free(pendingData_);
+	pendingData_ = data;
+	pendingWidth_ = width;
+	pendingHeight_ = height;
+}
+
+bool PPGeImage::Load() {
+	Free();
+
+	// In case it fails to load.
+	width_ = 0;
+	height_ = 0;
+
+	unsigned char *textureData = NULL;
+	{
+		// Usually already decoded by Preload on a worker thread - grab that.
+		std::lock_guard<std::mutex> guard(pendingLock_);
+		if (pendingData_) {
+			textureData = pendingData_;
+			width_ = pendingWidth_;
+			height_ = pendingHeight_;
+			pendingData_ = NULL;
+		}
+	}
+	if (!textureData && !ReadAndDecode(&textureData, &width_, &height_)) {
+		return false;
+	}
 
 	u32 texSize = width_ * height_ * 4;
 	texture_ = __PPGeDoAlloc(texSize, true, "Savedata Icon");
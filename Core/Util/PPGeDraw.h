@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 #include <string>
 #include "ppge_atlas.h"
@@ -117,6 +118,10 @@ public:
 	bool Load();
 	void Free();
 
+	// Reads and decodes the PNG ahead of time, off the emu thread, so that Load
+	// only has to upload into kernel RAM. Safe to call from a worker thread.
+	void Preload();
+
 	void DoState(PointerWrap &p);
 
 	// Do not use, only for savestate upgrading.
@@ -134,6 +139,8 @@ private:
 	static void Decimate();
 	static std::vector<PPGeImage *> loadedTextures_;
 
+	bool ReadAndDecode(unsigned char **data, int *width, int *height);
+
 	std::string filename_;
 
 	// Only valid if filename_.empty().
@@ -145,6 +152,12 @@ private:
 	int height_;
 
 	int lastFrame_;
+
+	// Decoded data waiting to be uploaded by Load, and the lock guarding it.
+	std::mutex pendingLock_;
+	unsigned char *pendingData_;
+	int pendingWidth_;
+	int pendingHeight_;
 };
 
 void PPGeDrawRect(float x1, float y1, float x2, float y2, u32 color);
@@ -19,6 +19,10 @@
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/sendfile.h>
+#endif
 #include "base/stringutil.h"
 #include "base/timeutil.h"
 #include "file/fd_util.h"
@@ -176,16 +180,46 @@ static void RegisterDiscHandlers(http::Server *http, std::unordered_map<std::str
 			sprintf(contentRange, "Content-Range: bytes %lld-%lld/%lld\r\n", begin, last, sz);
 			request.WriteHttpResponseHeader("1.0", 206, len, "application/octet-stream", contentRange);
 
-			const size_t CHUNK_SIZE = 16 * 1024;
-			char *buf = new char[CHUNK_SIZE];
-			for (s64 pos = 0; pos < len; pos += CHUNK_SIZE) {
-				s64 chunklen = std::min(len - pos, (s64)CHUNK_SIZE);
-				if (fread(buf, chunklen, 1, fp) != 1)
+			s64 remaining = len;
+#if defined(__linux__)
+			// Hand the body to the kernel directly instead of copying it
+			// through userspace - disc streaming otherwise keeps a core busy
+			// on the host.
+			request.Out()->Flush();
+			off_t offset = (off_t)begin;
+			while (remaining > 0) {
+				ssize_t sent = sendfile(request.fd(), fileno(fp), &offset, (size_t)std::min(remaining, (s64)(1 << 20)));
+				if (sent > 0) {
+					remaining -= sent;
+				} else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+					if (!fd_util::WaitUntilReady(request.fd(), 20.0, true))
+						break;
+				} else if (sent < 0 && (errno == EINVAL || errno == ENOSYS) && remaining == len) {
+					// Not supported here - fall back to the read/push loop below.
 					break;
-				request.Out()->Push(buf, chunklen);
+				} else {
+					// Connection lost (or read error) partway through the body.
+					fclose(fp);
+					return;
+				}
+			}
+			if (remaining > 0 && remaining != len) {
+				fclose(fp);
+				return;
+			}
+#endif
+			if (remaining > 0) {
+				const size_t CHUNK_SIZE = 16 * 1024;
+				char *buf = new char[CHUNK_SIZE];
+				for (s64 pos = 0; pos < remaining; pos += CHUNK_SIZE) {
+					s64 chunklen = std::min(remaining - pos, (s64)CHUNK_SIZE);
+					if (fread(buf, chunklen, 1, fp) != 1)
+						break;
+					request.Out()->Push(buf, chunklen);
+				}
+				delete [] buf;
 			}
 			fclose(fp);
-			delete [] buf;
 			request.Out()->Flush();
 		} else {
 			request.WriteHttpResponseHeader("1.0", 418, -1, "text/plain");
@@ -16,9 +16,16 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <cfloat>
+
+#if defined(_M_SSE)
+#include <emmintrin.h>
+#endif
 
 #include "profiler/profiler.h"
 #include "Common/ColorConv.h"
+#include "Common/CPUDetect.h"
+#include "Common/ThreadPools.h"
 #include "Core/Config.h"
 #include "GPU/Common/DrawEngineCommon.h"
 #include "GPU/Common/SplineCommon.h"
@@ -29,6 +36,10 @@
 
 #define QUAD_INDICES_MAX 65536
 
+// Don't bother frustum-testing draws smaller than this; the matrix and plane
+// setup would rival the decode cost saved.
+enum { PRECULL_MIN_VERTS = 32 };
+
 enum {
 	TRANSFORMED_VERTEX_BUFFER_SIZE = VERTEX_BUFFER_MAX * sizeof(TransformedVertex)
 };
@@ -90,10 +101,21 @@ int DrawEngineCommon::ComputeNumVertsToDecode() const {
 }
 
 void DrawEngineCommon::DecodeVerts(u8 *dest) {
+	// Batches that decoded identically last frame can skip the decode.
+	const bool cacheable = DecodedVertCacheUsable(dest) && decodeCounter_ == 0 && decodedVerts_ == 0;
+	u64 cacheKey = 0;
+	if (cacheable) {
+		cacheKey = ComputeDecodedVertCacheKey();
+		if (DecodeVertsFromCache(cacheKey, dest))
+			return;
+	}
+
 	const UVScale origUV = gstate_c.uv;
-	for (; decodeCounter_ < numDrawCalls; decodeCounter_++) {
-		gstate_c.uv = drawCalls[decodeCounter_].uvScale;
-		DecodeVertsStep(dest, decodeCounter_, decodedVerts_);  // NOTE! DecodeVertsStep can modify decodeCounter_!
+	if (!DecodeVertsThreaded(dest)) {
+		for (; decodeCounter_ < numDrawCalls; decodeCounter_++) {
+			gstate_c.uv = drawCalls[decodeCounter_].uvScale;
+			DecodeVertsStep(dest, decodeCounter_, decodedVerts_);  // NOTE! DecodeVertsStep can modify decodeCounter_!
+		}
 	}
 	gstate_c.uv = origUV;
 
@@ -103,6 +125,9 @@ void DrawEngineCommon::DecodeVerts(u8 *dest) {
 		// Force to points (0)
 		indexGen.AddPrim(GE_PRIM_POINTS, 0);
 	}
+
+	if (cacheable)
+		StoreDecodedVertsInCache(cacheKey, dest);
 }
 
 std::vector<std::string> DrawEngineCommon::DebugGetVertexLoaderIDs() {
@@ -253,6 +278,169 @@ bool DrawEngineCommon::TestBoundingBox(void* control_points, int vertexCount, u3
 	return true;
 }
 
+// Frustum pre-cull. Min/max the raw positions into a bounding box and reject the draw
+// when the whole box is outside one of the four side planes of the view frustum (the
+// same conservative test as TestBoundingBox). Near/far are deliberately left out -
+// PSP depth clamping isn't fully emulated, so culling on Z could drop visible geometry.
+bool DrawEngineCommon::DrawIsOutsideFrustum(const void *verts, int lowerBound, int upperBound) const {
+	const int stride = dec_->VertexSize();
+	const u8 *p = (const u8 *)verts + lowerBound * stride + dec_->posoff;
+	const int count = upperBound - lowerBound + 1;
+
+	float minPos[3], maxPos[3];
+	if (dec_->pos == (GE_VTYPE_POS_FLOAT >> GE_VTYPE_POS_SHIFT)) {
+#if defined(_M_SSE)
+		__m128 vmin = _mm_set_ps1(FLT_MAX);
+		__m128 vmax = _mm_set_ps1(-FLT_MAX);
+		int i = 0;
+		for (; i < count - 1; i++) {
+			const __m128 pos = _mm_loadu_ps((const float *)(p + i * stride));
+			vmin = _mm_min_ps(vmin, pos);
+			vmax = _mm_max_ps(vmax, pos);
+		}
+		// The last vertex separately - a full 16-byte load could read past the buffer.
+		const float *lastPos = (const float *)(p + i * stride);
+		const __m128 last = _mm_setr_ps(lastPos[0], lastPos[1], lastPos[2], 0.0f);
+		vmin = _mm_min_ps(vmin, last);
+		vmax = _mm_max_ps(vmax, last);
+		float lo[4], hi[4];
+		_mm_storeu_ps(lo, vmin);
+		_mm_storeu_ps(hi, vmax);
+		for (int c = 0; c < 3; c++) {
+			minPos[c] = lo[c];
+			maxPos[c] = hi[c];
+		}
+#else
+		for (int c = 0; c < 3; c++) {
+			minPos[c] = FLT_MAX;
+			maxPos[c] = -FLT_MAX;
+		}
+		for (int i = 0; i < count; i++) {
+			const float *pos = (const float *)(p + i * stride);
+			for (int c = 0; c < 3; c++) {
+				if (pos[c] < minPos[c]) minPos[c] = pos[c];
+				if (pos[c] > maxPos[c]) maxPos[c] = pos[c];
+			}
+		}
+#endif
+	} else if (dec_->pos == (GE_VTYPE_POS_16BIT >> GE_VTYPE_POS_SHIFT)) {
+		int mins[3] = { 32767, 32767, 32767 };
+		int maxs[3] = { -32768, -32768, -32768 };
+		for (int i = 0; i < count; i++) {
+			const s16 *pos = (const s16 *)(p + i * stride);
+			for (int c = 0; c < 3; c++) {
+				if (pos[c] < mins[c]) mins[c] = pos[c];
+				if (pos[c] > maxs[c]) maxs[c] = pos[c];
+			}
+		}
+		for (int c = 0; c < 3; c++) {
+			minPos[c] = mins[c] * (1.0f / 32768.0f);
+			maxPos[c] = maxs[c] * (1.0f / 32768.0f);
+		}
+	} else {
+		// 8-bit positions are rare and cheap to decode, not worth the test.
+		return false;
+	}
+
+	float world[16];
+	float view[16];
+	float worldview[16];
+	float worldviewproj[16];
+	ConvertMatrix4x3To4x4(world, gstate.worldMatrix);
+	ConvertMatrix4x3To4x4(view, gstate.viewMatrix);
+	Matrix4ByMatrix4(worldview, world, view);
+	Matrix4ByMatrix4(worldviewproj, worldview, gstate.projMatrix);
+
+	Plane planes[6];
+	PlanesFromMatrix(worldviewproj, planes);
+	for (int plane = 0; plane < 4; plane++) {
+		int out = 0;
+		for (int c = 0; c < 8; c++) {
+			float corner[3] = {
+				(c & 1) ? maxPos[0] : minPos[0],
+				(c & 2) ? maxPos[1] : minPos[1],
+				(c & 4) ? maxPos[2] : minPos[2],
+			};
+			if (planes[plane].Test(corner) < 0.0f)
+				out++;
+		}
+		if (out == 8)
+			return true;
+	}
+	return false;
+}
+
+// Overdraw elimination. Menu-heavy games like to render a full-screen background and then
+// stack further full-screen layers on top, which costs real time on fill-rate-limited
+// hardware. Since any render state change flushes the deferred batch, every queued call
+// shares the current state with the incoming draw - so when an opaque draw that covers the
+// whole scissor rectangle arrives, the queued calls below it can't contribute anything to
+// color, depth or stencil, and we can simply throw them away instead of rasterizing them.
+void DrawEngineCommon::DiscardDrawsCoveredBy(const void *verts, GEPrimitiveType prim, int vertexCount, u32 vertTypeID) {
+	// Only unindexed rectangles in throughmode are cheap enough to test at submit time.
+	if (prim != GE_PRIM_RECTANGLES || (vertTypeID & GE_VTYPE_IDX_MASK) != 0 || (vertTypeID & GE_VTYPE_THROUGH) == 0)
+		return;
+	// Under software skinning some of the queued calls may already be decoded, too late to drop.
+	if (decodeCounter_ > 0 || decodedVerts_ > 0)
+		return;
+
+	if (gstate.isModeClear()) {
+		// A clear only counts as a cover if it writes all of color, stencil and depth.
+		if (!gstate.isClearModeColorMask() || !gstate.isClearModeAlphaMask() || !gstate.isClearModeDepthMask())
+			return;
+	} else {
+		// The draw must not be able to skip or read back any covered pixel. Note that a
+		// per-channel color mask is fine - it applies to the dropped calls as well.
+		if (gstate.isAlphaBlendEnabled() || gstate.isAlphaTestEnabled() || gstate.isColorTestEnabled())
+			return;
+		if (gstate.isStencilTestEnabled())
+			return;
+		if (gstate.isDepthTestEnabled() && gstate.getDepthTestFunction() != GE_COMP_ALWAYS)
+			return;
+		if (gstate.isLogicOpEnabled() && gstate.getLogicOp() != GE_LOGIC_COPY)
+			return;
+		// If textured, texels can't discard pixels (no alpha test), so texturing is fine.
+	}
+
+	// Through positions are plain pixel coordinates, same space as the scissor rect.
+	const int posFmt = dec_->pos;
+	const int vertexSize = dec_->VertexSize();
+	const u8 *base = (const u8 *)verts + dec_->posoff;
+
+	// Rectangles cover [min, max), while the scissor bounds are inclusive.
+	const float covX1 = (float)gstate.getScissorX1();
+	const float covY1 = (float)gstate.getScissorY1();
+	const float covX2 = (float)(gstate.getScissorX2() + 1);
+	const float covY2 = (float)(gstate.getScissorY2() + 1);
+
+	bool covered = false;
+	for (int i = 0; i + 1 < vertexCount && !covered; i += 2) {
+		float x0, y0, x1, y1;
+		if (posFmt == (GE_VTYPE_POS_FLOAT >> GE_VTYPE_POS_SHIFT)) {
+			const float *p0 = (const float *)(base + i * vertexSize);
+			const float *p1 = (const float *)(base + (i + 1) * vertexSize);
+			x0 = p0[0]; y0 = p0[1];
+			x1 = p1[0]; y1 = p1[1];
+		} else if (posFmt == (GE_VTYPE_POS_16BIT >> GE_VTYPE_POS_SHIFT)) {
+			const u16 *p0 = (const u16 *)(base + i * vertexSize);
+			const u16 *p1 = (const u16 *)(base + (i + 1) * vertexSize);
+			x0 = p0[0]; y0 = p0[1];
+			x1 = p1[0]; y1 = p1[1];
+		} else {
+			// 8-bit through positions get truncated to garbage anyway, don't bother.
+			return;
+		}
+		covered = std::min(x0, x1) <= covX1 && std::min(y0, y1) <= covY1 &&
+			std::max(x0, x1) >= covX2 && std::max(y0, y1) >= covY2;
+	}
+
+	if (covered) {
+		numDrawCalls = 0;
+		vertexCountInDrawCalls_ = 0;
+		dcid_ = 0;
+	}
+}
+
 // TODO: This probably is not the best interface.
 bool DrawEngineCommon::GetCurrentSimpleVertices(int count, std::vector<GPUDebugVertex> &vertices, std::vector<u16> &indices) {
 	// This is always for the current vertices.
@@ -593,6 +781,221 @@ void DrawEngineCommon::DecodeVertsStep(u8 *dest, int &i, int &decodedVerts) {
 	}
 }
 
+bool DrawEngineCommon::DecodeVertsThreaded(u8 *dest) {
+	if (!g_Config.bThreadedVertexDecode || cpu_info.num_cores <= 2)
+		return false;
+	// Not worth waking the pool for small batches, or for a single span.
+	if (vertexCountInDrawCalls_ < 2048 || numDrawCalls - decodeCounter_ < 2)
+		return false;
+	// The interpreted decoder steps keep cursor state on the decoder object,
+	// and software skinning computes the skin matrix through a global.
+	if (!dec_->IsJitted())
+		return false;
+	if (g_Config.bSoftwareSkinning && (dec_->VertexType() & GE_VTYPE_WEIGHT_MASK) != 0)
+		return false;
+	// The decoder reads the UV prescale from gstate_c, which the workers share,
+	// so all the calls must agree on it. They nearly always do - it only varies
+	// mid-batch for splines/beziers.
+	for (int i = decodeCounter_ + 1; i < numDrawCalls; i++) {
+		if (memcmp(&drawCalls[i].uvScale, &drawCalls[decodeCounter_].uvScale, sizeof(UVScale)) != 0)
+			return false;
+	}
+	gstate_c.uv = drawCalls[decodeCounter_].uvScale;
+
+	// First the index translation, serially - it's cheap but order-dependent.
+	// While at it, record each independent vertex span and its dest offset.
+	// This mirrors DecodeVertsStep, minus the actual decoding.
+	decodeSpans_.clear();
+	for (; decodeCounter_ < numDrawCalls; decodeCounter_++) {
+		const DeferredDrawCall &dc = drawCalls[decodeCounter_];
+
+		indexGen.SetIndex(decodedVerts_);
+		int indexLowerBound = dc.indexLowerBound;
+		int indexUpperBound = dc.indexUpperBound;
+
+		if (dc.indexType == GE_VTYPE_IDX_NONE >> GE_VTYPE_IDX_SHIFT) {
+			decodeSpans_.push_back(DecodeSpan{ (const u8 *)dc.verts, indexLowerBound, indexUpperBound, decodedVerts_ });
+			decodedVerts_ += indexUpperBound - indexLowerBound + 1;
+
+			bool clockwise = true;
+			if (gstate.isCullEnabled() && gstate.getCullMode() != dc.cullMode) {
+				clockwise = false;
+			}
+			indexGen.AddPrim(dc.prim, dc.vertexCount, clockwise);
+		} else {
+			// Combine as many matching drawcalls as possible, like DecodeVertsStep.
+			int lastMatch = decodeCounter_;
+			const int total = numDrawCalls;
+			for (int j = decodeCounter_ + 1; j < total; ++j) {
+				if (drawCalls[j].verts != dc.verts)
+					break;
+
+				indexLowerBound = std::min(indexLowerBound, (int)drawCalls[j].indexLowerBound);
+				indexUpperBound = std::max(indexUpperBound, (int)drawCalls[j].indexUpperBound);
+				lastMatch = j;
+			}
+
+			switch (dc.indexType) {
+			case GE_VTYPE_IDX_8BIT >> GE_VTYPE_IDX_SHIFT:
+				for (int j = decodeCounter_; j <= lastMatch; j++) {
+					bool clockwise = true;
+					if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
+						clockwise = false;
+					}
+					indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u8 *)drawCalls[j].inds, indexLowerBound, clockwise);
+				}
+				break;
+			case GE_VTYPE_IDX_16BIT >> GE_VTYPE_IDX_SHIFT:
+				for (int j = decodeCounter_; j <= lastMatch; j++) {
+					bool clockwise = true;
+					if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
+						clockwise = false;
+					}
+					indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u16_le *)drawCalls[j].inds, indexLowerBound, clockwise);
+				}
+				break;
+			case GE_VTYPE_IDX_32BIT >> GE_VTYPE_IDX_SHIFT:
+				for (int j = decodeCounter_; j <= lastMatch; j++) {
+					bool clockwise = true;
+					if (gstate.isCullEnabled() && gstate.getCullMode() != drawCalls[j].cullMode) {
+						clockwise = false;
+					}
+					indexGen.TranslatePrim(drawCalls[j].prim, drawCalls[j].vertexCount, (const u32_le *)drawCalls[j].inds, indexLowerBound, clockwise);
+				}
+				break;
+			}
+
+			const int vertexCount = indexUpperBound - indexLowerBound + 1;
+
+			// Same Pangya Fantasy Golf workaround as in DecodeVertsStep.
+			if (decodedVerts_ + vertexCount > VERTEX_BUFFER_MAX) {
+				continue;
+			}
+
+			decodeSpans_.push_back(DecodeSpan{ (const u8 *)dc.verts, indexLowerBound, indexUpperBound, decodedVerts_ });
+			decodedVerts_ += vertexCount;
+			indexGen.Advance(vertexCount);
+			decodeCounter_ = lastMatch;
+		}
+	}
+
+	// Then shard the decoding itself, the expensive part, across the pool.
+	// Each span writes a disjoint range of dest.
+	PROFILE_THIS_SCOPE("vertdec");
+	const int stride = (int)dec_->GetDecVtxFmt().stride;
+	GlobalThreadPool::Loop([this, dest, stride](int l, int h) {
+		for (int j = l; j < h; j++) {
+			const DecodeSpan &span = decodeSpans_[j];
+			dec_->DecodeVerts(dest + span.destIndex * stride, span.verts, span.indexLowerBound, span.indexUpperBound);
+		}
+	}, 0, (int)decodeSpans_.size());
+	return true;
+}
+
+enum : size_t {
+	DEC_VERT_CACHE_BUDGET = 32 * 1024 * 1024,
+	DEC_VERT_CACHE_MAX_ENTRY = 2 * 1024 * 1024,
+	DEC_VERT_CACHE_MIN_VERTS = 512,
+};
+
+bool DrawEngineCommon::DecodedVertCacheUsable(const u8 *dest) const {
+	// Only the standard decode buffer is retained - frame-local push buffer
+	// destinations aren't.
+	if (!g_Config.bVertexCache || dest != decoded)
+		return false;
+	// Small batches decode fast enough that the bookkeeping isn't worth it.
+	if (vertexCountInDrawCalls_ < DEC_VERT_CACHE_MIN_VERTS)
+		return false;
+	// Decode output depends on the morph weights and (with software skinning)
+	// the bone matrices, which neither the key nor the hash covers.
+	if (dec_->morphcount != 1)
+		return false;
+	if (g_Config.bSoftwareSkinning && (dec_->VertexType() & GE_VTYPE_WEIGHT_MASK) != 0)
+		return false;
+	return true;
+}
+
+u64 DrawEngineCommon::ComputeDecodedVertCacheKey() const {
+	// dcid_ already mixes the pointers, counts, prims and vtype of the queued
+	// calls. Fold in the rest of what decode depends on: the cull mode (flips
+	// index winding) and the per-call UV prescale.
+	u32 extra = gstate.isCullEnabled() ? (0x10 | gstate.getCullMode()) : 0;
+	u32 h = DoReliableHash32(&extra, sizeof(extra), dcid_);
+	for (int i = 0; i < numDrawCalls; i++) {
+		h = DoReliableHash32(&drawCalls[i].uvScale, sizeof(UVScale), h);
+	}
+	return ((u64)h << 32) | dcid_;
+}
+
+bool DrawEngineCommon::DecodeVertsFromCache(u64 key, u8 *dest) {
+	DecimateDecodedVertCache();
+
+	auto iter = decVertCache_.find(key);
+	if (iter == decVertCache_.end())
+		return false;
+	DecodedVertsEntry &entry = iter->second;
+	if (entry.hash != ComputeHash()) {
+		// The source data changed underneath us - drop the entry, the decode
+		// below refreshes it.
+		decVertCacheSize_ -= entry.decoded.size() + entry.indices.size() * sizeof(u16);
+		decVertCache_.erase(iter);
+		return false;
+	}
+
+	memcpy(dest, entry.decoded.data(), entry.decoded.size());
+	memcpy(decIndex, entry.indices.data(), entry.indices.size() * sizeof(u16));
+	indexGen.RestoreTranslated(entry.indexCount, entry.maxIndex, entry.prim, entry.seenPrims, entry.pureCount);
+	// The decoder is what clears this flag, so a cached hit has to restore it -
+	// same idea as VAI_FLAG_VERTEXFULLALPHA in the backends.
+	gstate_c.vertexFullAlpha = entry.vertexFullAlpha;
+	decodedVerts_ = entry.decodedVerts;
+	decodeCounter_ = numDrawCalls;
+	entry.numFlipsLastUsed = gpuStats.numFlips;
+	return true;
+}
+
+void DrawEngineCommon::StoreDecodedVertsInCache(u64 key, const u8 *dest) {
+	const size_t vertBytes = (size_t)decodedVerts_ * dec_->GetDecVtxFmt().stride;
+	const size_t indexBytes = (size_t)indexGen.VertexCount() * sizeof(u16);
+	if (vertBytes + indexBytes > DEC_VERT_CACHE_MAX_ENTRY)
+		return;
+	if (decVertCacheSize_ + vertBytes + indexBytes > DEC_VERT_CACHE_BUDGET)
+		return;
+
+	DecodedVertsEntry &entry = decVertCache_[key];
+	decVertCacheSize_ -= entry.decoded.size() + entry.indices.size() * sizeof(u16);
+	entry.hash = ComputeHash();
+	entry.numFlipsLastUsed = gpuStats.numFlips;
+	entry.decodedVerts = decodedVerts_;
+	entry.indexCount = indexGen.VertexCount();
+	entry.maxIndex = indexGen.MaxIndex();
+	entry.seenPrims = indexGen.SeenPrims();
+	entry.pureCount = indexGen.PureCount();
+	entry.prim = indexGen.Prim();
+	entry.vertexFullAlpha = gstate_c.vertexFullAlpha;
+	entry.decoded.assign(dest, dest + vertBytes);
+	entry.indices.assign(decIndex, decIndex + indexGen.VertexCount());
+	decVertCacheSize_ += vertBytes + indexBytes;
+}
+
+void DrawEngineCommon::DecimateDecodedVertCache() {
+	// Once per frame, and only bother when we're near the budget.
+	if (gpuStats.numFlips == decVertCacheFrame_)
+		return;
+	decVertCacheFrame_ = gpuStats.numFlips;
+	if (decVertCacheSize_ < DEC_VERT_CACHE_BUDGET / 2)
+		return;
+
+	for (auto iter = decVertCache_.begin(); iter != decVertCache_.end(); ) {
+		if (gpuStats.numFlips - iter->second.numFlipsLastUsed > 3) {
+			decVertCacheSize_ -= iter->second.decoded.size() + iter->second.indices.size() * sizeof(u16);
+			iter = decVertCache_.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+}
+
 inline u32 ComputeMiniHashRange(const void *ptr, size_t sz) {
 	// Switch to u32 units.
 	const u32 *p = (const u32 *)ptr;
@@ -697,6 +1100,29 @@ void DrawEngineCommon::SubmitPrim(void *verts, void *inds, GEPrimitiveType prim,
 	if ((vertexCount < 2 && prim > 0) || (vertexCount < 3 && prim > 2 && prim != GE_PRIM_RECTANGLES))
 		return;
 
+	// A full-scissor opaque draw makes everything queued before it in the batch invisible,
+	// so it's cheaper to throw the queued calls away than to rasterize them.
+	if (numDrawCalls > 0)
+		DiscardDrawsCoveredBy(verts, prim, vertexCount, vertTypeID);
+
+	u16 indexLowerBound = 0;
+	u16 indexUpperBound = (u16)(vertexCount - 1);
+	if (inds)
+		GetIndexBounds(inds, vertexCount, vertTypeID, &indexLowerBound, &indexUpperBound);
+
+	// Pre-cull draws that are entirely offscreen - otherwise they still cost a full
+	// decode and a backend draw. Only plain positions can be tested straight from
+	// guest memory: skinning and morph move vertices during decode, and through-mode
+	// positions are already screen-space. Small draws aren't worth the plane setup.
+	if (prim != GE_PRIM_RECTANGLES &&
+		(vertTypeID & (GE_VTYPE_THROUGH | GE_VTYPE_WEIGHT_MASK | GE_VTYPE_MORPHCOUNT_MASK)) == 0 &&
+		indexUpperBound - indexLowerBound + 1 >= PRECULL_MIN_VERTS) {
+		if (DrawIsOutsideFrustum(verts, indexLowerBound, indexUpperBound)) {
+			gpuStats.numCulledDraws++;
+			return;
+		}
+	}
+
 	if (g_Config.bVertexCache) {
 		u32 dhash = dcid_;
 		dhash = __rotl(dhash ^ (u32)(uintptr_t)verts, 13);
@@ -714,13 +1140,8 @@ void DrawEngineCommon::SubmitPrim(void *verts, void *inds, GEPrimitiveType prim,
 	dc.vertexCount = vertexCount;
 	dc.uvScale = gstate_c.uv;
 	dc.cullMode = cullMode;
-
-	if (inds) {
-		GetIndexBounds(inds, vertexCount, vertTypeID, &dc.indexLowerBound, &dc.indexUpperBound);
-	} else {
-		dc.indexLowerBound = 0;
-		dc.indexUpperBound = vertexCount - 1;
-	}
+	dc.indexLowerBound = indexLowerBound;
+	dc.indexUpperBound = indexUpperBound;
 
 	numDrawCalls++;
 	vertexCountInDrawCalls_ += vertexCount;
@@ -115,9 +115,28 @@ protected:
 
 	// Vertex decoding
 	void DecodeVertsStep(u8 *dest, int &i, int &decodedVerts);
+	bool DecodeVertsThreaded(u8 *dest);
+
+	// Decoded-vertex cache (see DecodeVerts.)
+	bool DecodedVertCacheUsable(const u8 *dest) const;
+	u64 ComputeDecodedVertCacheKey() const;
+	bool DecodeVertsFromCache(u64 key, u8 *dest);
+	void StoreDecodedVertsInCache(u64 key, const u8 *dest);
+	void DecimateDecodedVertCache();
+
+	// Software tessellation result cache (see SubmitCurve in SplineCommon.cpp.)
+	bool TessFromCache(u64 key, u8 *destVerts, u16 *destIndices, int *count);
+	void StoreTessInCache(u64 key, const u8 *verts, int vertexBytes, const u16 *indices, int count);
+	void DecimateTessCache();
 
 	bool ApplyShaderBlending();
 
+	// Overdraw elimination (see SubmitPrim.)
+	void DiscardDrawsCoveredBy(const void *verts, GEPrimitiveType prim, int vertexCount, u32 vertTypeID);
+
+	// Frustum pre-cull (see SubmitPrim.)
+	bool DrawIsOutsideFrustum(const void *verts, int lowerBound, int upperBound) const;
+
 	inline int IndexSize(u32 vtype) const {
 		const u32 indexType = (vtype & GE_VTYPE_IDX_MASK);
 		if (indexType == GE_VTYPE_IDX_16BIT) {
@@ -167,6 +186,49 @@ protected:
 	// Vertex collector state
 	IndexGenerator indexGen;
 	int decodedVerts_ = 0;
+
+	// Independent vertex spans recorded for threaded decode, each writing a
+	// disjoint range of the dest buffer. See DecodeVertsThreaded().
+	struct DecodeSpan {
+		const u8 *verts;
+		int indexLowerBound;
+		int indexUpperBound;
+		int destIndex;
+	};
+	std::vector<DecodeSpan> decodeSpans_;
+
+	// Retained decode results for batches that repeat frame after frame
+	// (static scenery.) Validated by a full hash of the source data.
+	struct DecodedVertsEntry {
+		ReliableHashType hash;
+		int numFlipsLastUsed;
+		int decodedVerts;
+		int indexCount;
+		int maxIndex;
+		int seenPrims;
+		int pureCount;
+		GEPrimitiveType prim;
+		bool vertexFullAlpha;
+		std::vector<u8> decoded;
+		std::vector<u16> indices;
+	};
+	std::unordered_map<u64, DecodedVertsEntry> decVertCache_;
+	size_t decVertCacheSize_ = 0;
+	int decVertCacheFrame_ = -1;
+
+	// Retained software tessellation results for curve patches that come back
+	// identically frame after frame (terrain and the like.) The key is a full
+	// hash of the control points and tessellation parameters, so there's
+	// nothing further to validate on a hit.
+	struct TessCacheEntry {
+		int numFlipsLastUsed;
+		int count;
+		std::vector<u8> vertices;
+		std::vector<u16> indices;
+	};
+	std::unordered_map<u64, TessCacheEntry> tessCache_;
+	size_t tessCacheSize_ = 0;
+	int tessCacheFrame_ = -1;
 	GEPrimitiveType prevPrim_ = GE_PRIM_INVALID;
 
 	// Shader blending state
@@ -174,19 +174,38 @@ void FramebufferManagerCommon::SetDisplayFramebuffer(u32 framebuf, u32 stride, G
 
 VirtualFramebuffer *FramebufferManagerCommon::GetVFBAt(u32 addr) {
 	addr &= 0x3FFFFFFF;
+	auto iter = vfbsByAddress_.find(addr);
+	if (iter == vfbsByAddress_.end())
+		return nullptr;
 	VirtualFramebuffer *match = nullptr;
-	for (size_t i = 0; i < vfbs_.size(); ++i) {
-		VirtualFramebuffer *v = vfbs_[i];
-		if (v->fb_address == addr) {
-			// Could check w too but whatever
-			if (match == nullptr || match->last_frame_render < v->last_frame_render) {
-				match = v;
-			}
+	for (VirtualFramebuffer *v : iter->second) {
+		// Could check w too but whatever
+		if (match == nullptr || match->last_frame_render < v->last_frame_render) {
+			match = v;
 		}
 	}
 	return match;
 }
 
+void FramebufferManagerCommon::RegisterFramebuffer(VirtualFramebuffer *vfb) {
+	vfbsByAddress_[vfb->fb_address & 0x3FFFFFFF].push_back(vfb);
+}
+
+void FramebufferManagerCommon::UnregisterFramebuffer(VirtualFramebuffer *vfb) {
+	auto iter = vfbsByAddress_.find(vfb->fb_address & 0x3FFFFFFF);
+	if (iter == vfbsByAddress_.end())
+		return;
+	auto &bucket = iter->second;
+	for (size_t i = 0; i < bucket.size(); ++i) {
+		if (bucket[i] == vfb) {
+			bucket.erase(bucket.begin() + i);
+			break;
+		}
+	}
+	if (bucket.empty())
+		vfbsByAddress_.erase(iter);
+}
+
 u32 FramebufferManagerCommon::FramebufferByteSize(const VirtualFramebuffer *vfb) const {
 	return vfb->fb_stride * vfb->height * (vfb->format == GE_FORMAT_8888 ? 4 : 2);
 }
@@ -331,48 +350,51 @@ VirtualFramebuffer *FramebufferManagerCommon::DoSetRenderFrameBuffer(const Frame
 	gstate_c.SetCurRTOffsetX(0);
 	bool vfbFormatChanged = false;
 
-	// Find a matching framebuffer
+	// Find a matching framebuffer. Exact address matches are indexed, and take priority
+	// over render-to-offset matches.
 	VirtualFramebuffer *vfb = nullptr;
-	for (size_t i = 0; i < vfbs_.size(); ++i) {
-		VirtualFramebuffer *v = vfbs_[i];
-		if (v->fb_address == params.fb_address) {
-			vfb = v;
-			// Update fb stride in case it changed
-			if (vfb->fb_stride != params.fb_stride || vfb->format != params.fmt) {
-				vfbFormatChanged = true;
-				vfb->fb_stride = params.fb_stride;
-				vfb->format = params.fmt;
-			}
-
-			if (vfb->z_address == 0 && vfb->z_stride == 0) {
-				// Got one that was created by CreateRAMFramebuffer. Since it has no depth buffer,
-				// we just recreate it immediately.
-				ResizeFramebufFBO(vfb, vfb->width, vfb->height, true);
-			}
+	auto vfbIter = vfbsByAddress_.find(params.fb_address & 0x3FFFFFFF);
+	if (vfbIter != vfbsByAddress_.end()) {
+		vfb = vfbIter->second.front();
+		// Update fb stride in case it changed
+		if (vfb->fb_stride != params.fb_stride || vfb->format != params.fmt) {
+			vfbFormatChanged = true;
+			vfb->fb_stride = params.fb_stride;
+			vfb->format = params.fmt;
+		}
+
+		if (vfb->z_address == 0 && vfb->z_stride == 0) {
+			// Got one that was created by CreateRAMFramebuffer. Since it has no depth buffer,
+			// we just recreate it immediately.
+			ResizeFramebufFBO(vfb, vfb->width, vfb->height, true);
+		}
 
-			// Keep track, but this isn't really used.
-			vfb->z_stride = params.z_stride;
-			// Heuristic: In throughmode, a higher height could be used.  Let's avoid shrinking the buffer.
-			if (params.isModeThrough && (int)vfb->width <= params.fb_stride) {
-				vfb->width = std::max((int)vfb->width, drawing_width);
-				vfb->height = std::max((int)vfb->height, drawing_height);
-			} else {
-				vfb->width = drawing_width;
-				vfb->height = drawing_height;
-			}
-			break;
-		} else if (v->fb_address < params.fb_address && v->fb_address + v->fb_stride * 4 > params.fb_address) {
-			// Possibly a render-to-offset.
-			const u32 bpp = v->format == GE_FORMAT_8888 ? 4 : 2;
-			const int x_offset = (params.fb_address - v->fb_address) / bpp;
-			if (v->format == params.fmt && v->fb_stride == params.fb_stride && x_offset < params.fb_stride && v->height >= drawing_height) {
-				WARN_LOG_REPORT_ONCE(renderoffset, HLE, "Rendering to framebuffer offset: %08x +%dx%d", v->fb_address, x_offset, 0);
-				vfb = v;
-				gstate_c.SetCurRTOffsetX(x_offset);
-				vfb->width = std::max((int)vfb->width, x_offset + drawing_width);
-				// To prevent the newSize code from being confused.
-				drawing_width += x_offset;
-				break;
+		// Keep track, but this isn't really used.
+		vfb->z_stride = params.z_stride;
+		// Heuristic: In throughmode, a higher height could be used.  Let's avoid shrinking the buffer.
+		if (params.isModeThrough && (int)vfb->width <= params.fb_stride) {
+			vfb->width = std::max((int)vfb->width, drawing_width);
+			vfb->height = std::max((int)vfb->height, drawing_height);
+		} else {
+			vfb->width = drawing_width;
+			vfb->height = drawing_height;
+		}
+	} else {
+		for (size_t i = 0; i < vfbs_.size(); ++i) {
+			VirtualFramebuffer *v = vfbs_[i];
+			if (v->fb_address < params.fb_address && v->fb_address + v->fb_stride * 4 > params.fb_address) {
+				// Possibly a render-to-offset.
+				const u32 bpp = v->format == GE_FORMAT_8888 ? 4 : 2;
+				const int x_offset = (params.fb_address - v->fb_address) / bpp;
+				if (v->format == params.fmt && v->fb_stride == params.fb_stride && x_offset < params.fb_stride && v->height >= drawing_height) {
+					WARN_LOG_REPORT_ONCE(renderoffset, HLE, "Rendering to framebuffer offset: %08x +%dx%d", v->fb_address, x_offset, 0);
+					vfb = v;
+					gstate_c.SetCurRTOffsetX(x_offset);
+					vfb->width = std::max((int)vfb->width, x_offset + drawing_width);
+					// To prevent the newSize code from being confused.
+					drawing_width += x_offset;
+					break;
+				}
 			}
 		}
 	}
@@ -454,6 +476,7 @@ VirtualFramebuffer *FramebufferManagerCommon::DoSetRenderFrameBuffer(const Frame
 		vfb->last_frame_render = gpuStats.numFlips;
 		frameLastFramebufUsed_ = gpuStats.numFlips;
 		vfbs_.push_back(vfb);
+		RegisterFramebuffer(vfb);
 		currentRenderVfb_ = vfb;
 
 		if (useBufferedRendering_ && !g_Config.bDisableSlowFramebufEffects) {
@@ -520,6 +543,8 @@ VirtualFramebuffer *FramebufferManagerCommon::DoSetRenderFrameBuffer(const Frame
 }
 
 void FramebufferManagerCommon::DestroyFramebuf(VirtualFramebuffer *v) {
+	// No-op for bvfbs_, which are never registered.
+	UnregisterFramebuffer(v);
 	textureCache_->NotifyFramebuffer(v->fb_address, v, NOTIFY_FB_DESTROYED);
 	if (v->fbo) {
 		v->fbo->Release();
@@ -972,6 +997,29 @@ void FramebufferManagerCommon::CopyDisplayToOutput() {
 			// Fullscreen Image
 			SetViewport2D(0, 0, pixelWidth_, pixelHeight_);
 			DrawActiveTexture(x, y, w, h, (float)pixelWidth_, (float)pixelHeight_, u0, v0, u1, v1, uvRotation, flags);
+		} else if (usePostShader_ && !postShaderAtOutputResolution_ &&
+			(int)w == (int)renderWidth_ && (int)h == (int)renderHeight_ && uvRotation == ROTATION_LOCKED_HORIZONTAL) {
+			// The render-resolution pass would map 1:1 onto the output rect, so the
+			// shader samples the same texels either way. Fuse the post pass and the
+			// final blit into one draw to the backbuffer, saving a full-resolution
+			// read/write through the extra FBO.
+			shaderManager_->DirtyLastShader();
+			draw_->BindFramebufferAsRenderTarget(nullptr, { Draw::RPAction::CLEAR, Draw::RPAction::CLEAR, Draw::RPAction::CLEAR });
+			draw_->BindFramebufferAsTexture(vfb->fbo, 0, Draw::FB_COLOR_BIT, 0);
+			draw_->SetScissorRect(0, 0, pixelWidth_, pixelHeight_);
+			// We are doing the DrawActiveTexture call directly to the backbuffer here. Hence, we must
+			// flip V.
+			if (needBackBufferYSwap_)
+				std::swap(v0, v1);
+			DrawTextureFlags flags = g_Config.iBufFilter == SCALE_LINEAR ? DRAWTEX_LINEAR : DRAWTEX_NEAREST;
+			flags = flags | DRAWTEX_TO_BACKBUFFER;
+
+			PostShaderUniforms uniforms{};
+			CalculatePostShaderUniforms(vfb->bufferWidth, vfb->bufferHeight, renderWidth_, renderHeight_, &uniforms);
+			BindPostShader(uniforms);
+			// Fullscreen Image
+			SetViewport2D(0, 0, pixelWidth_, pixelHeight_);
+			DrawActiveTexture(x, y, w, h, (float)pixelWidth_, (float)pixelHeight_, u0, v0, u1, v1, uvRotation, flags);
 		} else if (usePostShader_ && extraFBOs_.size() == 1 && !postShaderAtOutputResolution_) {
 			// An additional pass, post-processing shader to the extra FBO.
 			shaderManager_->DirtyLastShader();  // dirty lastShader_
@@ -1050,7 +1098,10 @@ void FramebufferManagerCommon::DecimateFBOs() {
 		int age = frameLastFramebufUsed_ - std::max(vfb->last_frame_render, vfb->last_frame_used);
 
 		if (ShouldDownloadFramebuffer(vfb) && age == 0 && !vfb->memoryUpdated) {
-			bool sync = gl_extensions.IsGLES;
+			// These auto-downloads happen every frame once a game is known to read a buffer
+			// back, so slightly stale data is fine - backends without an async readback path
+			// just do it synchronously anyway.
+			bool sync = false;
 			ReadFramebufferToMemory(vfb, sync, 0, 0, vfb->width, vfb->height);
 			vfb->usageFlags = (vfb->usageFlags | FB_USAGE_DOWNLOAD) & ~FB_USAGE_DOWNLOAD_CLEAR;
 			vfb->firstFrameSaved = true;
@@ -1239,6 +1290,15 @@ bool FramebufferManagerCommon::NotifyFramebufferCopy(u32 src, u32 dst, int size,
 
 	if (dstBuffer && srcBuffer && !isMemset) {
 		if (srcBuffer == dstBuffer) {
+			if (srcY != dstY && srcH == dstH && Memory::IsVRAMAddress(src) && Memory::IsVRAMAddress(dst)) {
+				// Whole-row copy within the same buffer - handle it like the block transfer
+				// path does, with a blit to self.
+				WARN_LOG_ONCE(dstsrccpyblit, G3D, "Intra-buffer memcpy (blit) %08x -> %08x", src, dst);
+				BlitFramebuffer(dstBuffer, 0, dstY, srcBuffer, 0, srcY, srcBuffer->width, srcH, 0);
+				SetColorUpdated(dstBuffer, skipDrawReason);
+				RebindFramebuffer();
+				return true;
+			}
 			WARN_LOG_REPORT_ONCE(dstsrccpy, G3D, "Intra-buffer memcpy (not supported) %08x -> %08x", src, dst);
 		} else {
 			WARN_LOG_REPORT_ONCE(dstnotsrccpy, G3D, "Inter-buffer memcpy %08x -> %08x", src, dst);
@@ -1246,6 +1306,13 @@ bool FramebufferManagerCommon::NotifyFramebufferCopy(u32 src, u32 dst, int size,
 			BlitFramebuffer(dstBuffer, 0, dstY, srcBuffer, 0, srcY, srcBuffer->width, srcH, 0);
 			SetColorUpdated(dstBuffer, skipDrawReason);
 			RebindFramebuffer();
+			if (Memory::IsVRAMAddress(src) && Memory::IsVRAMAddress(dst)) {
+				// Both ends are backed by live framebuffers, so the blit did the whole job -
+				// skip the CPU memcpy behind it, which would only shuffle stale data around
+				// (and on some backends force a readback). Copies to actual RAM still fall
+				// through, since the game may read the destination with the CPU.
+				return true;
+			}
 		}
 		return false;
 	} else if (dstBuffer) {
@@ -1406,6 +1473,7 @@ VirtualFramebuffer *FramebufferManagerCommon::CreateRAMFramebuffer(uint32_t fbAd
 	textureCache_->NotifyFramebuffer(vfb->fb_address, vfb, NOTIFY_FB_CREATED);
 	vfb->fbo = draw_->CreateFramebuffer({ vfb->renderWidth, vfb->renderHeight, 1, 1, true, (Draw::FBColorDepth)vfb->colorDepth });
 	vfbs_.push_back(vfb);
+	RegisterFramebuffer(vfb);
 	return vfb;
 }
 
@@ -1998,7 +2066,7 @@ bool FramebufferManagerCommon::GetOutputFramebuffer(GPUDebugBuffer &buffer) {
 // (Except using the GPU might cause problems because of various implementations'
 // dithering behavior and games that expect exact colors like Danganronpa, so we
 // can't entirely be rid of the CPU path.) -- unknown
-void FramebufferManagerCommon::PackFramebufferSync_(VirtualFramebuffer *vfb, int x, int y, int w, int h) {
+void FramebufferManagerCommon::PackFramebufferSync_(VirtualFramebuffer *vfb, int x, int y, int w, int h, bool sync) {
 	if (!vfb->fbo) {
 		ERROR_LOG_REPORT_ONCE(vfbfbozero, SCEGE, "PackFramebufferSync_: vfb->fbo == 0");
 		return;
@@ -2028,7 +2096,12 @@ void FramebufferManagerCommon::PackFramebufferSync_(VirtualFramebuffer *vfb, int
 	DEBUG_LOG(G3D, "Reading framebuffer to mem, fb_address = %08x, ptr=%p", fb_address, destPtr);
 
 	if (destPtr) {
-		draw_->CopyFramebufferToMemorySync(vfb->fbo, Draw::FB_COLOR_BIT, x, y, w, h, destFormat, destPtr, vfb->fb_stride);
+		if (sync) {
+			draw_->CopyFramebufferToMemorySync(vfb->fbo, Draw::FB_COLOR_BIT, x, y, w, h, destFormat, destPtr, vfb->fb_stride);
+		} else {
+			// The backend may hand us pixels from a few frames back instead of stalling, if it can.
+			draw_->CopyFramebufferToMemoryAsync(vfb->fbo, Draw::FB_COLOR_BIT, x, y, w, h, destFormat, destPtr, vfb->fb_stride);
+		}
 	} else {
 		ERROR_LOG(G3D, "PackFramebufferSync_: Tried to readback to bad address %08x (stride = %d)", fb_address + dstByteOffset, vfb->fb_stride);
 	}
@@ -2049,11 +2122,11 @@ void FramebufferManagerCommon::ReadFramebufferToMemory(VirtualFramebuffer *vfb,
 		OptimizeDownloadRange(vfb, x, y, w, h);
 		if (vfb->renderWidth == vfb->width && vfb->renderHeight == vfb->height) {
 			// No need to blit
-			PackFramebufferSync_(vfb, x, y, w, h);
+			PackFramebufferSync_(vfb, x, y, w, h, sync);
 		} else {
 			VirtualFramebuffer *nvfb = FindDownloadTempBuffer(vfb);
 			BlitFramebuffer(nvfb, x, y, vfb, x, y, w, h, 0);
-			PackFramebufferSync_(nvfb, x, y, w, h);
+			PackFramebufferSync_(nvfb, x, y, w, h, sync);
 		}
 
 		textureCache_->ForgetLastTexture();
@@ -2104,7 +2177,8 @@ void FramebufferManagerCommon::DownloadFramebufferForClut(u32 fb_address, u32 lo
 			VirtualFramebuffer *nvfb = FindDownloadTempBuffer(vfb);
 			BlitFramebuffer(nvfb, x, y, vfb, x, y, w, h, 0);
 
-			PackFramebufferSync_(nvfb, x, y, w, h);
+			// Games read from the CLUT right away, so this must be synchronous.
+			PackFramebufferSync_(nvfb, x, y, w, h, true);
 
 			textureCache_->ForgetLastTexture();
 			RebindFramebuffer();
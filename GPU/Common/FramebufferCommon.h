@@ -107,6 +107,10 @@ struct VirtualFramebuffer {
 
 	bool dirtyAfterDisplay;
 	bool reallyDirtyAfterDisplay;  // takes frame skipping into account
+
+	// Bumped on every render to this framebuffer, so caches of derived data (like depal
+	// results) can tell whether the contents have changed since they were built.
+	int colorWriteSeq;
 };
 
 struct FramebufferHeuristicParams {
@@ -195,6 +199,8 @@ public:
 	virtual void BeginFrame();
 	void SetDisplayFramebuffer(u32 framebuf, u32 stride, GEBufferFormat format);
 	void DestroyFramebuf(VirtualFramebuffer *v);
+	void RegisterFramebuffer(VirtualFramebuffer *vfb);
+	void UnregisterFramebuffer(VirtualFramebuffer *vfb);
 
 	VirtualFramebuffer *DoSetRenderFrameBuffer(const FramebufferHeuristicParams &params, u32 skipDrawReason);	
 	VirtualFramebuffer *SetRenderFrameBuffer(bool framebufChanged, int skipDrawReason) {
@@ -308,7 +314,7 @@ public:
 	virtual bool GetOutputFramebuffer(GPUDebugBuffer &buffer);
 
 protected:
-	virtual void PackFramebufferSync_(VirtualFramebuffer *vfb, int x, int y, int w, int h);
+	virtual void PackFramebufferSync_(VirtualFramebuffer *vfb, int x, int y, int w, int h, bool sync);
 	virtual void SetViewport2D(int x, int y, int w, int h);
 	void CalculatePostShaderUniforms(int bufferWidth, int bufferHeight, int renderWidth, int renderHeight, PostShaderUniforms *uniforms);
 	virtual void MakePixelTexture(const u8 *srcPixels, GEBufferFormat srcPixelFormat, int srcStride, int width, int height, float &u1, float &v1) = 0;
@@ -358,10 +364,13 @@ protected:
 		dstBuffer->drawnWidth = dstBuffer->width;
 		dstBuffer->drawnHeight = dstBuffer->height;
 		dstBuffer->drawnFormat = dstBuffer->format;
+		dstBuffer->colorWriteSeq = ++colorWriteSeqCounter_;
 		if ((skipDrawReason & SKIPDRAW_SKIPFRAME) == 0)
 			dstBuffer->reallyDirtyAfterDisplay = true;
 	}
 
+	int colorWriteSeqCounter_ = 0;
+
 	Draw::DrawContext *draw_ = nullptr;
 	TextureCacheCommon *textureCache_ = nullptr;
 	ShaderManagerCommon *shaderManager_ = nullptr;
@@ -391,6 +400,11 @@ protected:
 	std::vector<VirtualFramebuffer *> vfbs_;
 	std::vector<VirtualFramebuffer *> bvfbs_; // blitting framebuffers (for download)
 
+	// Exact fb_address lookup so the hot paths don't have to scan vfbs_. Buckets keep
+	// vfbs_ insertion order, since several framebuffers can share an address. Only
+	// entries of vfbs_ are registered here, never bvfbs_.
+	std::unordered_map<u32, std::vector<VirtualFramebuffer *>> vfbsByAddress_;
+
 	bool gameUsesSequentialCopies_ = false;
 
 	// Sampled in BeginFrame for safety.
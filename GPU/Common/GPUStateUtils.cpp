@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 
 #include "base/display.h"
 
@@ -940,9 +941,56 @@ void ApplyStencilReplaceAndLogicOp(ReplaceAlphaType replaceAlphaWithStencil, Gen
 	}
 }
 
+// The blend conversion below is a steady cost on every draw flush, but games only ever use
+// a small number of distinct blend configurations. So we pack the relevant gstate bits into
+// a key, the same way ShaderId does, and cache the converted state.
+
+struct BlendStateKey {
+	u32 d[3];
+
+	bool operator < (const BlendStateKey &other) const {
+		for (int i = 0; i < 3; i++) {
+			if (d[i] < other.d[i])
+				return true;
+			if (d[i] > other.d[i])
+				return false;
+		}
+		return false;
+	}
+};
+
+static std::map<BlendStateKey, GenericBlendState> blendStateCache;
+static u32 blendStateCacheFeatureFlags;
+
+static void ComputeBlendStateKey(BlendStateKey &key, bool allowShaderBlend) {
+	// The fixed colors only matter when the corresponding factor actually selects them.
+	// Mask them out otherwise so games animating an unused fix color don't balloon the cache.
+	u32 fixA = gstate.getBlendFuncA() >= GE_SRCBLEND_FIXA ? gstate.getFixA() : 0;
+	u32 fixB = gstate.getBlendFuncB() >= GE_DSTBLEND_FIXB ? gstate.getFixB() : 0;
+
+	key.d[0] = (fixA & 0xFFFFFF) |
+		((u32)gstate.getBlendEq() << 24) |
+		((u32)gstate.FrameBufFormat() << 27) |
+		((u32)gstate.isModeClear() << 29) |
+		((u32)gstate.isAlphaBlendEnabled() << 30) |
+		((u32)allowShaderBlend << 31);
+	key.d[1] = (fixB & 0xFFFFFF) |
+		((u32)gstate.getBlendFuncA() << 24) |
+		((u32)gstate.getBlendFuncB() << 28);
+	key.d[2] = (gstate.pmska & 0xFF) |
+		((u32)gstate.getStencilTestRef() << 8) |
+		((u32)gstate.getStencilOpZPass() << 16) |
+		((u32)gstate.getStencilOpZFail() << 19) |
+		((u32)gstate.getStencilOpSFail() << 22) |
+		((u32)gstate.isStencilTestEnabled() << 25) |
+		((u32)gstate.isLogicOpEnabled() << 26) |
+		((u32)gstate.getLogicOp() << 27) |
+		((u32)(g_Config.iRenderingMode == FB_NON_BUFFERED_MODE) << 31);
+}
+
 // Called even if AlphaBlendEnable == false - it also deals with stencil-related blend state.
 
-void ConvertBlendState(GenericBlendState &blendState, bool allowShaderBlend) {
+static void ConvertBlendStateUncached(GenericBlendState &blendState, bool allowShaderBlend) {
 	// Blending is a bit complex to emulate.  This is due to several reasons:
 	//
 	//  * Doubled blend modes (src, dst, inversed) aren't supported in OpenGL.
@@ -1217,6 +1265,30 @@ void ConvertBlendState(GenericBlendState &blendState, bool allowShaderBlend) {
 	blendState.setEquation(colorEq, alphaEq);
 }
 
+void ConvertBlendState(GenericBlendState &blendState, bool allowShaderBlend) {
+	// The device caps feed the conversion too (dual source, minmax, logic ops...), so a
+	// cache built under different caps is stale. They only change on device init/restore.
+	if (blendStateCacheFeatureFlags != gstate_c.featureFlags) {
+		blendStateCache.clear();
+		blendStateCacheFeatureFlags = gstate_c.featureFlags;
+	}
+
+	BlendStateKey key;
+	ComputeBlendStateKey(key, allowShaderBlend);
+	auto iter = blendStateCache.find(key);
+	if (iter != blendStateCache.end()) {
+		blendState = iter->second;
+		return;
+	}
+
+	ConvertBlendStateUncached(blendState, allowShaderBlend);
+	if (blendStateCache.size() >= 4096) {
+		// Shouldn't happen with the fix color masking above, but let's not grow forever.
+		blendStateCache.clear();
+	}
+	blendStateCache[key] = blendState;
+}
+
 static void ConvertStencilFunc5551(GenericStencilFuncState &state) {
 	state.writeMask = state.writeMask >= 0x80 ? 0xff : 0x00;
 
@@ -20,6 +20,22 @@
 
 #include "Common/Common.h"
 
+#ifdef _M_SSE
+#include <emmintrin.h>
+
+// Translates a stream of u16 indices by a constant offset, 8 at a time.
+// Returns how many were handled; the caller finishes the tail.
+static inline int TranslateU16BulkSSE(u16 *dst, const u16 *src, int count, u16 offset) {
+	const __m128i off = _mm_set1_epi16((short)offset);
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_add_epi16(x, off));
+	}
+	return i;
+}
+#endif
+
 // Points don't need indexing...
 const u8 IndexGenerator::indexedPrimitiveType[7] = {
 	GE_PRIM_POINTS,
@@ -88,7 +104,31 @@ void IndexGenerator::AddStrip(int numVerts, bool clockwise) {
 	const int numTris = numVerts - 2;
 	u16 *outInds = inds_;
 	int ibase = index_;
-	for (int i = 0; i < numTris; i++) {
+	int i = 0;
+#ifdef _M_SSE
+	// Emit 8 triangles (24 indices) per iteration by adding the splatted base
+	// index to a precomputed pattern of two alternating-winding strip rounds.
+	alignas(16) static const u16 stripPatternCW[24] = {
+		0, 1, 2,  1, 3, 2,  2, 3, 4,  3, 5, 4,  4, 5, 6,  5, 7, 6,  6, 7, 8,  7, 9, 8,
+	};
+	alignas(16) static const u16 stripPatternCCW[24] = {
+		0, 2, 1,  1, 2, 3,  2, 4, 3,  3, 4, 5,  4, 6, 5,  5, 6, 7,  6, 8, 7,  7, 8, 9,
+	};
+	const u16 *pattern = clockwise ? stripPatternCW : stripPatternCCW;
+	const __m128i pat0 = _mm_load_si128((const __m128i *)pattern);
+	const __m128i pat1 = _mm_load_si128((const __m128i *)pattern + 1);
+	const __m128i pat2 = _mm_load_si128((const __m128i *)pattern + 2);
+	for (; i + 8 <= numTris; i += 8) {
+		const __m128i base = _mm_set1_epi16((short)ibase);
+		_mm_storeu_si128((__m128i *)outInds, _mm_add_epi16(base, pat0));
+		_mm_storeu_si128((__m128i *)outInds + 1, _mm_add_epi16(base, pat1));
+		_mm_storeu_si128((__m128i *)outInds + 2, _mm_add_epi16(base, pat2));
+		outInds += 24;
+		ibase += 8;
+	}
+	// 8 triangles per round leaves the winding toggle where it started.
+#endif
+	for (; i < numTris; i++) {
 		*outInds++ = ibase;
 		*outInds++ = ibase + wind;
 		wind ^= 3;  // toggle between 1 and 2
@@ -196,11 +236,17 @@ void IndexGenerator::TranslateLineList(int numInds, const ITypeLE *inds, int ind
 	indexOffset = index_ - indexOffset;
 	u16 *outInds = inds_;
 	numInds = numInds & ~1;
-	for (int i = 0; i < numInds; i += 2) {
-		*outInds++ = indexOffset + inds[i];
-		*outInds++ = indexOffset + inds[i + 1];
+	// The output keeps the input order, so this is a plain bulk translation.
+	int i = 0;
+#ifdef _M_SSE
+	if (sizeof(ITypeLE) == sizeof(u16))
+		i = TranslateU16BulkSSE(outInds, (const u16 *)inds, numInds, (u16)indexOffset);
+#endif
+	for (; i < numInds; i += 2) {
+		outInds[i] = indexOffset + inds[i];
+		outInds[i + 1] = indexOffset + inds[i + 1];
 	}
-	inds_ = outInds;
+	inds_ = outInds + numInds;
 	count_ += numInds;
 	prim_ = GE_PRIM_LINES;
 	seenPrims_ |= (1 << GE_PRIM_LINES) | flag;
@@ -230,16 +276,29 @@ void IndexGenerator::TranslateList(int numInds, const ITypeLE *inds, int indexOf
 		memcpy(inds_, inds, numInds * sizeof(ITypeLE));
 		inds_ += numInds;
 		count_ += numInds;
+	} else if (clockwise) {
+		// With unflipped winding the output keeps the input order, so this is
+		// a plain bulk translation too.
+		u16 *outInds = inds_;
+		int numTris = numInds / 3;  // Round to whole triangles
+		numInds = numTris * 3;
+		int i = 0;
+#ifdef _M_SSE
+		if (sizeof(ITypeLE) == sizeof(u16))
+			i = TranslateU16BulkSSE(outInds, (const u16 *)inds, numInds, (u16)indexOffset);
+#endif
+		for (; i < numInds; i++)
+			outInds[i] = indexOffset + inds[i];
+		inds_ = outInds + numInds;
+		count_ += numInds;
 	} else {
 		u16 *outInds = inds_;
 		int numTris = numInds / 3;  // Round to whole triangles
 		numInds = numTris * 3;
-		const int v1 = clockwise ? 1 : 2;
-		const int v2 = clockwise ? 2 : 1;
 		for (int i = 0; i < numInds; i += 3) {
 			*outInds++ = indexOffset + inds[i];
-			*outInds++ = indexOffset + inds[i + v1];
-			*outInds++ = indexOffset + inds[i + v2];
+			*outInds++ = indexOffset + inds[i + 2];
+			*outInds++ = indexOffset + inds[i + 1];
 		}
 		inds_ = outInds;
 		count_ += numInds;
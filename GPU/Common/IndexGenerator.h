@@ -59,6 +59,18 @@ public:
 	}
 
 	void SetIndex(int ind) { index_ = ind; }
+
+	// Restores results from the decoded-vertex cache. The caller has already
+	// copied numInds generated indices back into the index buffer.
+	void RestoreTranslated(int numInds, int maxIndex, GEPrimitiveType prim, int seenPrims, int pureCount) {
+		count_ = numInds;
+		index_ = maxIndex;
+		prim_ = prim;
+		seenPrims_ = seenPrims;
+		pureCount_ = pureCount;
+		inds_ = indsBase_ + numInds;
+	}
+
 	int MaxIndex() const { return index_; }  // Really NextIndex rather than MaxIndex, it's one more than the highest index generated
 	int VertexCount() const { return count_; }
 	bool Empty() const { return index_ == 0; }
@@ -17,6 +17,7 @@
 
 #include "ppsspp_config.h"
 
+#include <map>
 #include <memory>
 #include <vector>
 #include <sstream>
@@ -32,6 +33,9 @@
 #include "base/logging.h"
 #include "base/basictypes.h"
 #include "base/stringutil.h"
+#include "Common/FileUtil.h"
+#include "Core/System.h"
+#include "ext/xxhash.h"
 #include "ShaderTranslation.h"
 #include "ext/glslang/SPIRV/GlslangToSpv.h"
 #include "thin3d/thin3d.h"
@@ -59,6 +63,79 @@ static EShLanguage GetLanguage(const Draw::ShaderStage stage) {
 	}
 }
 
+// Running the source through glslang and SPIRV-Cross takes hundreds of ms on slow
+// devices, and we re-translate post shaders on every resolution change and backend
+// switch. The output is deterministic for a given source and target though, so we
+// memoize it in memory and mirror it in a small cache file that survives restarts.
+#define TRANSLATION_CACHE_MAGIC 0x52545353  // "SSTR"
+#define TRANSLATION_CACHE_VERSION 1
+// Sanity limit when reading back entries - no translated post shader gets close.
+#define TRANSLATION_CACHE_MAX_SIZE (1 * 1024 * 1024)
+
+static std::map<uint64_t, std::string> translationCache;
+static bool translationCacheLoaded = false;
+
+static std::string TranslationCacheFilename() {
+	return GetSysDirectory(DIRECTORY_APP_CACHE) + "/translatedshaders.cache";
+}
+
+static uint64_t TranslationCacheKey(const std::string &src, ShaderLanguage destLang, Draw::ShaderStage stage) {
+	// Fold everything besides the source text that affects the output into the seed.
+	uint64_t seed = (uint64_t)destLang | ((uint64_t)stage << 8);
+	if (destLang == GLSL_300) {
+		seed |= (uint64_t)gl_extensions.GLSLVersion() << 16;
+		seed |= (uint64_t)(gl_extensions.ARB_shading_language_420pack ? 1 : 0) << 32;
+	}
+	return XXH64(src.data(), src.size(), seed);
+}
+
+static void LoadTranslationCache() {
+	translationCacheLoaded = true;
+	FILE *f = File::OpenCFile(TranslationCacheFilename(), "rb");
+	if (!f)
+		return;
+	uint32_t magic = 0, version = 0, count = 0;
+	bool headerOK = fread(&magic, 4, 1, f) == 1 && fread(&version, 4, 1, f) == 1 && fread(&count, 4, 1, f) == 1;
+	if (!headerOK || magic != TRANSLATION_CACHE_MAGIC || version != TRANSLATION_CACHE_VERSION) {
+		fclose(f);
+		return;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		uint64_t key;
+		uint32_t size;
+		if (fread(&key, 8, 1, f) != 1 || fread(&size, 4, 1, f) != 1 || size > TRANSLATION_CACHE_MAX_SIZE) {
+			break;
+		}
+		std::string value;
+		value.resize(size);
+		if (fread(&value[0], 1, size, f) != size) {
+			break;
+		}
+		translationCache[key] = value;
+	}
+	fclose(f);
+}
+
+static void SaveTranslationCache() {
+	File::CreateFullPath(GetSysDirectory(DIRECTORY_APP_CACHE));
+	FILE *f = File::OpenCFile(TranslationCacheFilename(), "wb");
+	if (!f)
+		return;
+	uint32_t magic = TRANSLATION_CACHE_MAGIC;
+	uint32_t version = TRANSLATION_CACHE_VERSION;
+	uint32_t count = (uint32_t)translationCache.size();
+	fwrite(&magic, 4, 1, f);
+	fwrite(&version, 4, 1, f);
+	fwrite(&count, 4, 1, f);
+	for (const auto &entry : translationCache) {
+		uint32_t size = (uint32_t)entry.second.size();
+		fwrite(&entry.first, 8, 1, f);
+		fwrite(&size, 4, 1, f);
+		fwrite(entry.second.data(), 1, size, f);
+	}
+	fclose(f);
+}
+
 void ShaderTranslationInit() {
 	// TODO: We have TLS issues on UWP
 #if !PPSSPP_PLATFORM(UWP)
@@ -187,15 +264,7 @@ bool ConvertToVulkanGLSL(std::string *dest, TranslatedShaderMetadata *destMetada
 	return true;
 }
 
-bool TranslateShader(std::string *dest, ShaderLanguage destLang, TranslatedShaderMetadata *destMetadata, std::string src, ShaderLanguage srcLang, Draw::ShaderStage stage, std::string *errorMessage) {
-	if (srcLang != GLSL_300 && srcLang != GLSL_140)
-		return false;
-
-	if ((srcLang == GLSL_140 || srcLang == GLSL_300) && destLang == GLSL_VULKAN) {
-		// Let's just mess about at the string level, no need to recompile.
-		bool result = ConvertToVulkanGLSL(dest, destMetadata, src, stage, errorMessage);
-		return result;
-	}
+static bool TranslateShaderUncached(std::string *dest, ShaderLanguage destLang, std::string src, ShaderLanguage srcLang, Draw::ShaderStage stage, std::string *errorMessage) {
 	if (errorMessage) {
 		*errorMessage = "";
 	}
@@ -339,3 +408,35 @@ bool TranslateShader(std::string *dest, ShaderLanguage destLang, TranslatedShade
 		return false;
 	}
 }
+
+bool TranslateShader(std::string *dest, ShaderLanguage destLang, TranslatedShaderMetadata *destMetadata, std::string src, ShaderLanguage srcLang, Draw::ShaderStage stage, std::string *errorMessage) {
+	if (srcLang != GLSL_300 && srcLang != GLSL_140)
+		return false;
+
+	if ((srcLang == GLSL_140 || srcLang == GLSL_300) && destLang == GLSL_VULKAN) {
+		// Let's just mess about at the string level, no need to recompile.
+		// Cheap enough that there's no point caching the result.
+		bool result = ConvertToVulkanGLSL(dest, destMetadata, src, stage, errorMessage);
+		return result;
+	}
+
+	if (!translationCacheLoaded) {
+		LoadTranslationCache();
+	}
+	uint64_t cacheKey = TranslationCacheKey(src, destLang, stage);
+	auto cached = translationCache.find(cacheKey);
+	if (cached != translationCache.end()) {
+		*dest = cached->second;
+		return true;
+	}
+
+	if (!TranslateShaderUncached(dest, destLang, src, srcLang, stage, errorMessage)) {
+		return false;
+	}
+
+	translationCache[cacheKey] = *dest;
+	// Post shaders translate rarely and the cache stays small, so just rewrite the
+	// whole file - that way we can't lose entries to a skipped shutdown.
+	SaveTranslationCache();
+	return true;
+}
@@ -198,37 +198,72 @@ void SoftwareTransform(
 
 	VertexReader reader(decoded, decVtxFormat, vertType);
 	if (throughmode) {
-		for (int index = 0; index < maxIndex; index++) {
-			// Do not touch the coordinates or the colors. No lighting.
-			reader.Goto(index);
-			// TODO: Write to a flexible buffer, we don't always need all four components.
-			TransformedVertex &vert = transformed[index];
-			reader.ReadPos(vert.pos);
-
-			if (reader.hasColor0()) {
-				if (provokeIndOffset != 0 && index + provokeIndOffset < maxIndex) {
-					reader.Goto(index + provokeIndOffset);
-					reader.ReadColor0_8888(vert.color0);
-					reader.Goto(index);
+		const bool hasColor = reader.hasColor0();
+		const bool hasUV = reader.hasUV();
+		if (provokeIndOffset == 0 && decVtxFormat.posfmt == DEC_FLOAT_3 &&
+			(!hasColor || decVtxFormat.c0fmt == DEC_U8_4) &&
+			(!hasUV || decVtxFormat.uvfmt == DEC_FLOAT_2)) {
+			// Fast path for the common decoded layout. The conditions are uniform
+			// across the draw, so hoist them and walk the buffer directly instead
+			// of going through the per-vertex format dispatch in VertexReader.
+			const u32 materialAmbientRGBA = gstate.getMaterialAmbientRGBA();
+			const u8 *ptr = decoded;
+			const int stride = decVtxFormat.stride;
+			for (int index = 0; index < maxIndex; index++, ptr += stride) {
+				TransformedVertex &vert = transformed[index];
+				const float *posf = (const float *)(ptr + decVtxFormat.posoff);
+				vert.x = posf[0];
+				vert.y = posf[1];
+				// Integer value passed in a float. Clamped to 0, 65535.
+				const float z = (int)posf[2] * (1.0f / 65535.0f);
+				vert.z = z > 1.0f ? 1.0f : (z < 0.0f ? 0.0f : z);
+				if (hasColor) {
+					memcpy(vert.color0, ptr + decVtxFormat.c0off, 4);
 				} else {
-					reader.ReadColor0_8888(vert.color0);
+					vert.color0_32 = materialAmbientRGBA;
+				}
+				if (hasUV) {
+					const float *uvf = (const float *)(ptr + decVtxFormat.uvoff);
+					vert.u = uvf[0] * uscale;
+					vert.v = uvf[1] * vscale;
+				} else {
+					vert.u = 0.0f;
+					vert.v = 0.0f;
 				}
-			} else {
-				vert.color0_32 = gstate.getMaterialAmbientRGBA();
 			}
+		} else {
+			for (int index = 0; index < maxIndex; index++) {
+				// Do not touch the coordinates or the colors. No lighting.
+				reader.Goto(index);
+				// TODO: Write to a flexible buffer, we don't always need all four components.
+				TransformedVertex &vert = transformed[index];
+				reader.ReadPos(vert.pos);
+
+				if (reader.hasColor0()) {
+					if (provokeIndOffset != 0 && index + provokeIndOffset < maxIndex) {
+						reader.Goto(index + provokeIndOffset);
+						reader.ReadColor0_8888(vert.color0);
+						reader.Goto(index);
+					} else {
+						reader.ReadColor0_8888(vert.color0);
+					}
+				} else {
+					vert.color0_32 = gstate.getMaterialAmbientRGBA();
+				}
 
-			if (reader.hasUV()) {
-				reader.ReadUV(vert.uv);
+				if (reader.hasUV()) {
+					reader.ReadUV(vert.uv);
 
-				vert.u *= uscale;
-				vert.v *= vscale;
-			} else {
-				vert.u = 0.0f;
-				vert.v = 0.0f;
-			}
+					vert.u *= uscale;
+					vert.v *= vscale;
+				} else {
+					vert.u = 0.0f;
+					vert.v = 0.0f;
+				}
 
-			// Ignore color1 and fog, never used in throughmode anyway.
-			// The w of uv is also never used (hardcoded to 1.0.)
+				// Ignore color1 and fog, never used in throughmode anyway.
+				// The w of uv is also never used (hardcoded to 1.0.)
+			}
 		}
 	} else {
 		// Okay, need to actually perform the full transform.
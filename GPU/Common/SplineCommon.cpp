@@ -25,6 +25,7 @@
 #include "GPU/Common/GPUStateUtils.h"
 #include "GPU/Common/SplineCommon.h"
 #include "GPU/Common/DrawEngineCommon.h"
+#include "GPU/Common/TextureDecoder.h"  // for ReliableHash
 #include "GPU/ge_constants.h"
 #include "GPU/GPUState.h"  // only needed for UVScale stuff
 
@@ -488,6 +489,59 @@ void DrawEngineCommon::ClearSplineBezierWeights() {
 	Spline3DWeight::weightsCache.Clear();
 }
 
+enum {
+	TESS_CACHE_BUDGET = 8 * 1024 * 1024,
+	TESS_CACHE_MAX_ENTRY = 1024 * 1024,
+};
+
+bool DrawEngineCommon::TessFromCache(u64 key, u8 *destVerts, u16 *destIndices, int *count) {
+	DecimateTessCache();
+
+	auto iter = tessCache_.find(key);
+	if (iter == tessCache_.end())
+		return false;
+	TessCacheEntry &entry = iter->second;
+	memcpy(destVerts, entry.vertices.data(), entry.vertices.size());
+	memcpy(destIndices, entry.indices.data(), entry.indices.size() * sizeof(u16));
+	*count = entry.count;
+	entry.numFlipsLastUsed = gpuStats.numFlips;
+	return true;
+}
+
+void DrawEngineCommon::StoreTessInCache(u64 key, const u8 *verts, int vertexBytes, const u16 *indices, int count) {
+	const size_t totalBytes = vertexBytes + count * sizeof(u16);
+	if (totalBytes > TESS_CACHE_MAX_ENTRY)
+		return;
+	if (tessCacheSize_ + totalBytes > TESS_CACHE_BUDGET)
+		return;
+
+	TessCacheEntry &entry = tessCache_[key];
+	tessCacheSize_ -= entry.vertices.size() + entry.indices.size() * sizeof(u16);
+	entry.numFlipsLastUsed = gpuStats.numFlips;
+	entry.count = count;
+	entry.vertices.assign(verts, verts + vertexBytes);
+	entry.indices.assign(indices, indices + count);
+	tessCacheSize_ += totalBytes;
+}
+
+void DrawEngineCommon::DecimateTessCache() {
+	// Once per frame, and only bother when we're near the budget.
+	if (gpuStats.numFlips == tessCacheFrame_)
+		return;
+	tessCacheFrame_ = gpuStats.numFlips;
+	if (tessCacheSize_ < TESS_CACHE_BUDGET / 2)
+		return;
+
+	for (auto iter = tessCache_.begin(); iter != tessCache_.end(); ) {
+		if (gpuStats.numFlips - iter->second.numFlipsLastUsed > 3) {
+			tessCacheSize_ -= iter->second.vertices.size() + iter->second.indices.size() * sizeof(u16);
+			iter = tessCache_.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+}
+
 // Specialize to make instance (to avoid link error).
 template void DrawEngineCommon::SubmitCurve<BezierSurface>(const void *control_points, const void *indices, BezierSurface &surface, u32 vertType, int *bytesRead, const char *scope);
 template void DrawEngineCommon::SubmitCurve<SplineSurface>(const void *control_points, const void *indices, SplineSurface &surface, u32 vertType, int *bytesRead, const char *scope);
@@ -557,8 +611,26 @@ void DrawEngineCommon::SubmitCurve(const void *control_points, const void *indic
 	if (CanUseHardwareTessellation(surface.primType)) {
 		HardwareTessellation(output, surface, origVertType, points, tessDataTransfer);
 	} else {
-		ControlPoints cpoints(points, num_points, managedBuf);
-		SoftwareTessellation(output, surface, origVertType, cpoints);
+		// Games tend to resubmit the exact same patches every frame for terrain,
+		// so look for a cached result before burning CPU on tessellation. The key
+		// hashes everything the output depends on: the simplified control points
+		// (normalization already applied UV prescale) and the tess parameters.
+		const u32 state[] = {
+			(u32)surface.tess_u, (u32)surface.tess_v,
+			(u32)surface.type_u, (u32)surface.type_v,
+			(u32)surface.num_points_u, (u32)surface.num_points_v,
+			(u32)surface.primType, surface.patchFacing ? 1u : 0u,
+			origVertType,
+		};
+		u64 tessKey = DoReliableHash64(state, sizeof(state), 0xC0B9C52Bu);
+		for (int idx = 0; idx < num_points; idx++)
+			tessKey = DoReliableHash64(points[idx], sizeof(SimpleVertex), tessKey);
+
+		if (!TessFromCache(tessKey, (u8 *)output.vertices, output.indices, &output.count)) {
+			ControlPoints cpoints(points, num_points, managedBuf);
+			SoftwareTessellation(output, surface, origVertType, cpoints);
+			StoreTessInCache(tessKey, (const u8 *)output.vertices, surface.GetVertexCount() * (int)sizeof(SimpleVertex), output.indices, output.count);
+		}
 	}
 
 	u32 vertTypeWithIndex16 = (vertType & ~GE_VTYPE_IDX_MASK) | GE_VTYPE_IDX_16BIT;
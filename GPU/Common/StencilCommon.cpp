@@ -49,3 +49,40 @@ u8 StencilBits8888(const u8 *ptr8, u32 numPixels) {
 
 	return bits >> 24;
 }
+
+u8 StencilSingleValue8888(const u8 *ptr8, u32 numPixels) {
+	const u32 *ptr = (const u32 *)ptr8;
+	u32 orBits = 0;
+	u32 andBits = 0xFF000000;
+
+	for (u32 i = 0; i < numPixels; ++i) {
+		u32 v = ptr[i] & 0xFF000000;
+		orBits |= v;
+		if (v != 0) {
+			andBits &= v;
+		}
+	}
+
+	// OR and AND over the non-zero values agree only when they're all the same value.
+	if (orBits != 0 && orBits == andBits)
+		return orBits >> 24;
+	return 0;
+}
+
+u8 StencilSingleValue4444(const u8 *ptr8, u32 numPixels) {
+	const u16 *ptr = (const u16 *)ptr8;
+	u16 orBits = 0;
+	u16 andBits = 0xF000;
+
+	for (u32 i = 0; i < numPixels; ++i) {
+		u16 v = ptr[i] & 0xF000;
+		orBits |= v;
+		if (v != 0) {
+			andBits &= v;
+		}
+	}
+
+	if (orBits != 0 && orBits == andBits)
+		return orBits >> 12;
+	return 0;
+}
@@ -5,3 +5,9 @@
 u8 StencilBits8888(const u8 *ptr8, u32 numPixels);
 u8 StencilBits4444(const u8 *ptr8, u32 numPixels);
 u8 StencilBits5551(const u8 *ptr8, u32 numPixels);
+
+// If every pixel has either stencil value zero or one single other value, returns
+// that value, otherwise zero. Lets the backends upload all the bits in one pass
+// instead of one draw per bit.
+u8 StencilSingleValue8888(const u8 *ptr8, u32 numPixels);
+u8 StencilSingleValue4444(const u8 *ptr8, u32 numPixels);
@@ -56,12 +56,20 @@
 
 #define TEXTURE_CLUT_VARIANTS_MIN 6
 
+// Cached depal results are framebuffer-sized, so forget them quickly.
+#define DEPAL_RESULT_KILL_AGE 5
+
 // Try to be prime to other decimation intervals.
 #define TEXCACHE_DECIMATION_INTERVAL 13
 
 #define TEXCACHE_MIN_PRESSURE 16 * 1024 * 1024  // Total in VRAM
 #define TEXCACHE_SECOND_MIN_PRESSURE 4 * 1024 * 1024
 
+// Byte budget for the second, generational decimation pass. The default is plenty
+// for PSP-sized content; lowmem kicks in after the backend hits an allocation failure.
+#define TEXCACHE_DEFAULT_BUDGET (64 * 1024 * 1024)
+#define TEXCACHE_LOWMEM_BUDGET (16 * 1024 * 1024)
+
 // Just for reference
 
 // PSP Color formats:
@@ -91,6 +99,7 @@ TextureCacheCommon::TextureCacheCommon(Draw::DrawContext *draw)
 	: draw_(draw),
 		clearCacheNextFrame_(false),
 		lowMemoryMode_(false),
+		standardCacheBudget_(TEXCACHE_DEFAULT_BUDGET),
 		texelsScaledThisFrame_(0),
 		cacheSizeEstimate_(0),
 		secondCacheSizeEstimate_(0),
@@ -99,6 +108,8 @@ TextureCacheCommon::TextureCacheCommon(Draw::DrawContext *draw)
 		clutTotalBytes_(0),
 		clutMaxBytes_(0),
 		clutRenderAddress_(0xFFFFFFFF),
+		clutLastUploadAddr_(0xFFFFFFFF),
+		clutLastUploadBytes_(0),
 		clutAlphaLinear_(false),
 		isBgraBackend_(false) {
 	decimationCounter_ = TEXCACHE_DECIMATION_INTERVAL;
@@ -406,6 +417,21 @@ void TextureCacheCommon::SetTexture(bool force) {
 			rehash = false;
 		}
 
+		// Video buffers don't need hashing at all: the decoder notifies us of every
+		// frame it writes. A new frame always means a rebuild (a hash would just
+		// fail), and without one the contents can only have changed through a CPU
+		// write, which invalidation tracking catches like it does in backoff mode.
+		bool videoUnchanged = false;
+		auto video = videos_.find(entry->addr & 0x3FFFFFFF);
+		if (video != videos_.end()) {
+			if (entry->vidGeneration != video->second.generation) {
+				match = false;
+				reason = "video frame";
+			} else {
+				videoUnchanged = true;
+			}
+		}
+
 		if (match) {
 			if (entry->lastFrame != gpuStats.numFlips) {
 				u32 diff = gpuStats.numFlips - entry->lastFrame;
@@ -419,7 +445,12 @@ void TextureCacheCommon::SetTexture(bool force) {
 					} else {
 						entry->framesUntilNextFullHash = entry->numFrames;
 					}
-					rehash = true;
+					// In backoff mode, we already trust invalidations to catch changes -
+					// so if nothing has invalidated this texture's memory since the hash
+					// was last verified, skip the scheduled rehash. Doesn't apply if a
+					// rehash was already wanted for another reason (e.g. UNRELIABLE.)
+					if (rehash || !g_Config.bTextureBackoffCache || InvalidatedSinceLastHash(entry))
+						rehash = true;
 				} else {
 					entry->framesUntilNextFullHash -= diff;
 				}
@@ -431,6 +462,12 @@ void TextureCacheCommon::SetTexture(bool force) {
 				rehash = true;
 			}
 
+			// This overrides the periodic rehash schedule above - for video, the
+			// generation already told us the decoder hasn't touched the buffer.
+			if (videoUnchanged && !InvalidatedSinceLastHash(entry)) {
+				rehash = false;
+			}
+
 			if (texhash != entry->hash) {
 				match = false;
 			} else if (entry->GetHashStatus() == TexCacheEntry::STATUS_RELIABLE) {
@@ -456,6 +493,7 @@ void TextureCacheCommon::SetTexture(bool force) {
 				entry->sizeInRAM = (textureBitsPerPixel[format] * bufw * h / 2) / 8;
 				entry->bufw = bufw;
 				entry->cluthash = cluthash;
+				ExtendCacheBounds(entry);
 			}
 
 			nextTexture_ = entry;
@@ -518,6 +556,7 @@ void TextureCacheCommon::SetTexture(bool force) {
 	// to avoid excessive clearing caused by cache invalidations.
 	entry->sizeInRAM = (textureBitsPerPixel[format] * bufw * h / 2) / 8;
 	entry->bufw = bufw;
+	ExtendCacheBounds(entry);
 
 	entry->cluthash = cluthash;
 
@@ -543,6 +582,29 @@ void TextureCacheCommon::SetTexture(bool force) {
 	nextNeedsRebuild_ = true;
 }
 
+// Rough per-entry re-decode cost, expressed as extra frames of retention the entry
+// earns in the budget pass below. We don't time the decodes - the scaler and the
+// CLUT/depal conversion passes dominate, and the status bits and format tell us
+// which entries went through them.
+static int DecimateRetentionBonus(const TexCacheEntry *entry) {
+	int bonus = 0;
+	if (entry->status & TexCacheEntry::STATUS_IS_SCALED)
+		bonus += TEXTURE_KILL_AGE / 2;
+	if (entry->status & TexCacheEntry::STATUS_DEPALETTIZE)
+		bonus += TEXTURE_KILL_AGE / 4;
+	switch (entry->format) {
+	case GE_TFMT_CLUT4:
+	case GE_TFMT_CLUT8:
+	case GE_TFMT_CLUT16:
+	case GE_TFMT_CLUT32:
+		bonus += TEXTURE_KILL_AGE / 4;
+		break;
+	default:
+		break;
+	}
+	return bonus;
+}
+
 // Removes old textures.
 void TextureCacheCommon::Decimate(bool forcePressure) {
 	if (--decimationCounter_ <= 0) {
@@ -566,6 +628,30 @@ void TextureCacheCommon::Decimate(bool forcePressure) {
 			}
 		}
 
+		// Second generation: if the age pass left us above budget, trim oldest-first
+		// until we're back under it, with expensive-to-redecode entries earning extra
+		// retention. This evicts just enough instead of waiting for memory pressure
+		// and then flushing most of the cache at once, which caused re-decode storms.
+		const u32 budget = lowMemoryMode_ ? TEXCACHE_LOWMEM_BUDGET : standardCacheBudget_;
+		if (cacheSizeEstimate_ > budget) {
+			std::vector<std::pair<int, u64>> candidates;
+			candidates.reserve(cache_.size());
+			for (const auto &iter : cache_) {
+				// Never consider textures bound this frame.
+				if (iter.second->lastFrame >= gpuStats.numFlips)
+					continue;
+				candidates.push_back(std::make_pair(iter.second->lastFrame + DecimateRetentionBonus(iter.second.get()), iter.first));
+			}
+			std::sort(candidates.begin(), candidates.end());
+			for (const auto &candidate : candidates) {
+				if (cacheSizeEstimate_ <= budget)
+					break;
+				TexCache::iterator evict = cache_.find(candidate.second);
+				if (evict != cache_.end())
+					DeleteTexture(evict);
+			}
+		}
+
 		VERBOSE_LOG(G3D, "Decimated texture cache, saved %d estimated bytes - now %d bytes", had - cacheSizeEstimate_, cacheSizeEstimate_);
 	}
 
@@ -587,13 +673,14 @@ void TextureCacheCommon::Decimate(bool forcePressure) {
 		VERBOSE_LOG(G3D, "Decimated second texture cache, saved %d estimated bytes - now %d bytes", had - secondCacheSizeEstimate_, secondCacheSizeEstimate_);
 	}
 
+	DecimateDepalResults(false);
 	DecimateVideos();
 }
 
 void TextureCacheCommon::DecimateVideos() {
 	if (!videos_.empty()) {
 		for (auto iter = videos_.begin(); iter != videos_.end(); ) {
-			if (iter->second + VIDEO_DECIMATE_AGE < gpuStats.numFlips) {
+			if (iter->second.lastFrame + VIDEO_DECIMATE_AGE < gpuStats.numFlips) {
 				videos_.erase(iter++);
 			} else {
 				++iter;
@@ -602,6 +689,73 @@ void TextureCacheCommon::DecimateVideos() {
 	}
 }
 
+Draw::Framebuffer *TextureCacheCommon::GetDepalResultFBO(VirtualFramebuffer *framebuffer, u32 clutMode, bool *needsRender) {
+	*needsRender = true;
+	// Texture offsets shift where the pass samples and writes - don't bother caching those.
+	if (gstate_c.curTextureXOffset != 0 || gstate_c.curTextureYOffset != 0)
+		return nullptr;
+
+	// The region the depal pass will cover, in buffer coordinates. Matches the bounds
+	// logic the backends use for the draw. If min is not < max, we don't have bounds
+	// (they weren't set during decode) and the full buffer is covered.
+	u16 x1 = 0, y1 = 0, x2 = framebuffer->bufferWidth, y2 = framebuffer->bufferHeight;
+	if (gstate_c.vertBounds.minV < gstate_c.vertBounds.maxV) {
+		x1 = gstate_c.vertBounds.minU;
+		y1 = gstate_c.vertBounds.minV;
+		x2 = gstate_c.vertBounds.maxU;
+		y2 = gstate_c.vertBounds.maxV;
+	}
+
+	const u64 key = ((u64)clutHash_ << 32) | (framebuffer->fb_address & 0x3FFFFFFF);
+	auto it = depalResults_.find(key);
+	if (it != depalResults_.end()) {
+		DepalResult &result = it->second;
+		if (result.fboWidth != framebuffer->renderWidth || result.fboHeight != framebuffer->renderHeight) {
+			// Render size changed, recreate below.
+			result.fbo->Release();
+			depalResults_.erase(it);
+		} else {
+			result.lastFrame = gpuStats.numFlips;
+			if (result.clutMode == clutMode && result.fbWriteSeq == framebuffer->colorWriteSeq &&
+				result.x1 <= x1 && result.y1 <= y1 && result.x2 >= x2 && result.y2 >= y2) {
+				// Palette and framebuffer unchanged, and the cached pass covered at least
+				// the region this draw samples - reuse last frame's result.
+				*needsRender = false;
+				return result.fbo;
+			}
+			// Stale or doesn't cover this draw - the caller re-renders into the same FBO.
+			// No region union: the backends bind with DONT_CARE so old contents may be gone.
+			result.clutMode = clutMode;
+			result.fbWriteSeq = framebuffer->colorWriteSeq;
+			result.x1 = x1;
+			result.y1 = y1;
+			result.x2 = x2;
+			result.y2 = y2;
+			return result.fbo;
+		}
+	}
+
+	// FBO creation binds textures on some backends.
+	ForgetLastTexture();
+	Draw::Framebuffer *fbo = draw_->CreateFramebuffer({ framebuffer->renderWidth, framebuffer->renderHeight, 1, 1, false, Draw::FBO_8888 });
+	if (!fbo)
+		return nullptr;
+	const DepalResult result = { fbo, clutMode, framebuffer->colorWriteSeq, framebuffer->renderWidth, framebuffer->renderHeight, x1, y1, x2, y2, gpuStats.numFlips };
+	depalResults_[key] = result;
+	return fbo;
+}
+
+void TextureCacheCommon::DecimateDepalResults(bool forceAll) {
+	for (auto it = depalResults_.begin(); it != depalResults_.end(); ) {
+		if (forceAll || it->second.lastFrame + DEPAL_RESULT_KILL_AGE < gpuStats.numFlips) {
+			it->second.fbo->Release();
+			it = depalResults_.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
 void TextureCacheCommon::HandleTextureChange(TexCacheEntry *const entry, const char *reason, bool initialMatch, bool doDelete) {
 	cacheSizeEstimate_ -= EstimateTexMemoryUsage(entry);
 	entry->numInvalidated++;
@@ -982,7 +1136,9 @@ void TextureCacheCommon::NotifyConfigChanged() {
 
 void TextureCacheCommon::NotifyVideoUpload(u32 addr, int size, int width, GEBufferFormat fmt) {
 	addr &= 0x3FFFFFFF;
-	videos_[addr] = gpuStats.numFlips;
+	VideoInfo &info = videos_[addr];
+	info.lastFrame = gpuStats.numFlips;
+	info.generation = ++videoGeneration_;
 }
 
 void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes) {
@@ -1027,7 +1183,18 @@ void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes) {
 			if (bytes < loadBytes) {
 				memset((u8 *)clutBufRaw_ + bytes, 0x00, loadBytes - bytes);
 			}
+			// Render-to-CLUT can change without CPU writes, so don't allow skipping.
+			clutLastUploadAddr_ = 0xFFFFFFFF;
 		} else {
+			// Many games re-upload an identical palette every frame. If the data matches
+			// what's already in clutBufRaw_, we can keep the current conversion and hash
+			// and skip forcing an UpdateCurrentClut() on the next SetTexture().
+			if (bytes == loadBytes && clutAddr == clutLastUploadAddr_ && bytes == clutLastUploadBytes_ &&
+				memcmp(clutBufRaw_, Memory::GetPointerUnchecked(clutAddr), bytes) == 0) {
+				return;
+			}
+			clutLastUploadAddr_ = clutAddr;
+			clutLastUploadBytes_ = bytes == loadBytes ? bytes : 0;
 #ifdef _M_SSE
 			if (bytes == loadBytes) {
 				const __m128i *source = (const __m128i *)Memory::GetPointerUnchecked(clutAddr);
@@ -1071,6 +1238,7 @@ void TextureCacheCommon::LoadClut(u32 clutAddr, u32 loadBytes) {
 		}
 	} else {
 		memset(clutBufRaw_, 0x00, loadBytes);
+		clutLastUploadAddr_ = 0xFFFFFFFF;
 	}
 	// Reload the clut next time.
 	clutLastFormat_ = 0xFFFFFFFF;
@@ -1187,6 +1355,10 @@ static inline void ConvertFormatToRGBA8888(GEPaletteFormat format, u32 *dst, con
 }
 
 void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, bool reverseColors, bool useBGRA, bool expandTo32bit) {
+	DecodeTextureLevelBand(out, outPitch, format, clutformat, texaddr, level, bufw, reverseColors, useBGRA, expandTo32bit, 0, gstate.getTextureHeight(level), tmpTexBuf32_);
+}
+
+void TextureCacheCommon::DecodeTextureLevelBand(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, bool reverseColors, bool useBGRA, bool expandTo32bit, int yStart, int yEnd, SimpleBuf<u32> &scratch) {
 	bool swizzled = gstate.isTextureSwizzled();
 	if ((texaddr & 0x00600000) != 0 && Memory::IsVRAMAddress(texaddr)) {
 		// This means it's in a mirror, possibly a swizzled mirror.  Let's report.
@@ -1200,7 +1372,11 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 
 	int w = gstate.getTextureWidth(level);
 	int h = gstate.getTextureHeight(level);
+	const int bandH = yEnd - yStart;
 	const u8 *texptr = Memory::GetPointer(texaddr);
+	// When the band is unswizzled into scratch, only the band's rows are there, so
+	// source indexing becomes relative to srcYOffset.
+	int srcYOffset = 0;
 
 	switch (format) {
 	case GE_TFMT_CLUT4:
@@ -1209,9 +1385,11 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		const int clutSharingOffset = mipmapShareClut ? 0 : level * 16;
 
 		if (swizzled) {
-			tmpTexBuf32_.resize(bufw * ((h + 7) & ~7));
-			UnswizzleFromMem(tmpTexBuf32_.data(), bufw / 2, texptr, bufw, h, 0);
-			texptr = (u8 *)tmpTexBuf32_.data();
+			// Swizzled rows pack as tightly as linear ones, so the band starts at the same offset.
+			scratch.resize(bufw * ((bandH + 7) & ~7));
+			UnswizzleFromMem(scratch.data(), bufw / 2, texptr + yStart * (bufw / 2), bufw, bandH, 0);
+			texptr = (u8 *)scratch.data();
+			srcYOffset = yStart;
 		}
 
 		switch (clutformat) {
@@ -1223,24 +1401,26 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 			if (clutAlphaLinear_ && mipmapShareClut && !expandTo32bit) {
 				// Here, reverseColors means the CLUT is already reversed.
 				if (reverseColors) {
-					for (int y = 0; y < h; ++y) {
-						DeIndexTexture4Optimal((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clutAlphaLinearColor_);
+					for (int y = yStart; y < yEnd; ++y) {
+						DeIndexTexture4Optimal((u16 *)(out + outPitch * y), texptr + (bufw * (y - srcYOffset)) / 2, w, clutAlphaLinearColor_);
 					}
 				} else {
-					for (int y = 0; y < h; ++y) {
-						DeIndexTexture4OptimalRev((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clutAlphaLinearColor_);
+					for (int y = yStart; y < yEnd; ++y) {
+						DeIndexTexture4OptimalRev((u16 *)(out + outPitch * y), texptr + (bufw * (y - srcYOffset)) / 2, w, clutAlphaLinearColor_);
 					}
 				}
 			} else {
 				if (expandTo32bit && !reverseColors) {
 					// We simply expand the CLUT to 32-bit, then we deindex as usual. Probably the fastest way.
-					ConvertFormatToRGBA8888(clutformat, expandClut_, clut, 16);
-					for (int y = 0; y < h; ++y) {
-						DeIndexTexture4((u32 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, expandClut_);
+					// Expanded on the stack to stay reentrant for banded decode.
+					u32 expandClut[16];
+					ConvertFormatToRGBA8888(clutformat, expandClut, clut, 16);
+					for (int y = yStart; y < yEnd; ++y) {
+						DeIndexTexture4((u32 *)(out + outPitch * y), texptr + (bufw * (y - srcYOffset)) / 2, w, expandClut);
 					}
 				} else {
-					for (int y = 0; y < h; ++y) {
-						DeIndexTexture4((u16 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clut);
+					for (int y = yStart; y < yEnd; ++y) {
+						DeIndexTexture4((u16 *)(out + outPitch * y), texptr + (bufw * (y - srcYOffset)) / 2, w, clut);
 					}
 				}
 			}
@@ -1250,8 +1430,8 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		case GE_CMODE_32BIT_ABGR8888:
 		{
 			const u32 *clut = GetCurrentClut<u32>() + clutSharingOffset;
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture4((u32 *)(out + outPitch * y), texptr + (bufw * y) / 2, w, clut);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture4((u32 *)(out + outPitch * y), texptr + (bufw * (y - srcYOffset)) / 2, w, clut);
 			}
 		}
 		break;
@@ -1264,15 +1444,15 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 	break;
 
 	case GE_TFMT_CLUT8:
-		ReadIndexedTex(out, outPitch, level, texptr, 1, bufw, expandTo32bit);
+		ReadIndexedTex(out, outPitch, level, texptr, 1, bufw, expandTo32bit, yStart, yEnd, scratch);
 		break;
 
 	case GE_TFMT_CLUT16:
-		ReadIndexedTex(out, outPitch, level, texptr, 2, bufw, expandTo32bit);
+		ReadIndexedTex(out, outPitch, level, texptr, 2, bufw, expandTo32bit, yStart, yEnd, scratch);
 		break;
 
 	case GE_TFMT_CLUT32:
-		ReadIndexedTex(out, outPitch, level, texptr, 4, bufw, expandTo32bit);
+		ReadIndexedTex(out, outPitch, level, texptr, 4, bufw, expandTo32bit, yStart, yEnd, scratch);
 		break;
 
 	case GE_TFMT_4444:
@@ -1281,41 +1461,42 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		if (!swizzled) {
 			// Just a simple copy, we swizzle the color format.
 			if (reverseColors) {
-				for (int y = 0; y < h; ++y) {
+				for (int y = yStart; y < yEnd; ++y) {
 					ReverseColors(out + outPitch * y, texptr + bufw * sizeof(u16) * y, format, w, useBGRA);
 				}
 			} else if (expandTo32bit) {
-				for (int y = 0; y < h; ++y) {
+				for (int y = yStart; y < yEnd; ++y) {
 					ConvertFormatToRGBA8888(format, (u32 *)(out + outPitch * y), (const u16 *)texptr + bufw * y, w);
 				}
 			} else {
-				for (int y = 0; y < h; ++y) {
+				for (int y = yStart; y < yEnd; ++y) {
 					memcpy(out + outPitch * y, texptr + bufw * sizeof(u16) * y, w * sizeof(u16));
 				}
 			}
 		} else if (h >= 8 && !expandTo32bit) {
 			// Note: this is always safe since h must be a power of 2, so a multiple of 8.
-			UnswizzleFromMem((u32 *)out, outPitch, texptr, bufw, h, 2);
+			UnswizzleFromMem((u32 *)(out + outPitch * yStart), outPitch, texptr + yStart * bufw * 2, bufw, bandH, 2);
 			if (reverseColors) {
-				ReverseColors(out, out, format, h * outPitch / 2, useBGRA);
+				ReverseColors(out + outPitch * yStart, out + outPitch * yStart, format, bandH * outPitch / 2, useBGRA);
 			}
 		} else {
 			// We don't have enough space for all rows in out, so use a temp buffer.
-			tmpTexBuf32_.resize(bufw * ((h + 7) & ~7));
-			UnswizzleFromMem(tmpTexBuf32_.data(), bufw * 2, texptr, bufw, h, 2);
-			const u8 *unswizzled = (u8 *)tmpTexBuf32_.data();
+			scratch.resize(bufw * ((bandH + 7) & ~7));
+			UnswizzleFromMem(scratch.data(), bufw * 2, texptr + yStart * bufw * 2, bufw, bandH, 2);
+			const u8 *unswizzled = (u8 *)scratch.data();
+			srcYOffset = yStart;
 
 			if (reverseColors) {
-				for (int y = 0; y < h; ++y) {
-					ReverseColors(out + outPitch * y, unswizzled + bufw * sizeof(u16) * y, format, w, useBGRA);
+				for (int y = yStart; y < yEnd; ++y) {
+					ReverseColors(out + outPitch * y, unswizzled + bufw * sizeof(u16) * (y - srcYOffset), format, w, useBGRA);
 				}
 			} else if (expandTo32bit) {
-				for (int y = 0; y < h; ++y) {
-					ConvertFormatToRGBA8888(format, (u32 *)(out + outPitch * y), (const u16 *)unswizzled + bufw * y, w);
+				for (int y = yStart; y < yEnd; ++y) {
+					ConvertFormatToRGBA8888(format, (u32 *)(out + outPitch * y), (const u16 *)unswizzled + bufw * (y - srcYOffset), w);
 				}
 			} else {
-				for (int y = 0; y < h; ++y) {
-					memcpy(out + outPitch * y, unswizzled + bufw * sizeof(u16) * y, w * sizeof(u16));
+				for (int y = yStart; y < yEnd; ++y) {
+					memcpy(out + outPitch * y, unswizzled + bufw * sizeof(u16) * (y - srcYOffset), w * sizeof(u16));
 				}
 			}
 		}
@@ -1324,32 +1505,33 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 	case GE_TFMT_8888:
 		if (!swizzled) {
 			if (reverseColors) {
-				for (int y = 0; y < h; ++y) {
+				for (int y = yStart; y < yEnd; ++y) {
 					ReverseColors(out + outPitch * y, texptr + bufw * sizeof(u32) * y, format, w, useBGRA);
 				}
 			} else {
-				for (int y = 0; y < h; ++y) {
+				for (int y = yStart; y < yEnd; ++y) {
 					memcpy(out + outPitch * y, texptr + bufw * sizeof(u32) * y, w * sizeof(u32));
 				}
 			}
 		} else if (h >= 8) {
-			UnswizzleFromMem((u32 *)out, outPitch, texptr, bufw, h, 4);
+			UnswizzleFromMem((u32 *)(out + outPitch * yStart), outPitch, texptr + yStart * bufw * 4, bufw, bandH, 4);
 			if (reverseColors) {
-				ReverseColors(out, out, format, h * outPitch / 4, useBGRA);
+				ReverseColors(out + outPitch * yStart, out + outPitch * yStart, format, bandH * outPitch / 4, useBGRA);
 			}
 		} else {
 			// We don't have enough space for all rows in out, so use a temp buffer.
-			tmpTexBuf32_.resize(bufw * ((h + 7) & ~7));
-			UnswizzleFromMem(tmpTexBuf32_.data(), bufw * 4, texptr, bufw, h, 4);
-			const u8 *unswizzled = (u8 *)tmpTexBuf32_.data();
+			scratch.resize(bufw * ((bandH + 7) & ~7));
+			UnswizzleFromMem(scratch.data(), bufw * 4, texptr + yStart * bufw * 4, bufw, bandH, 4);
+			const u8 *unswizzled = (u8 *)scratch.data();
+			srcYOffset = yStart;
 
 			if (reverseColors) {
-				for (int y = 0; y < h; ++y) {
-					ReverseColors(out + outPitch * y, unswizzled + bufw * sizeof(u32) * y, format, w, useBGRA);
+				for (int y = yStart; y < yEnd; ++y) {
+					ReverseColors(out + outPitch * y, unswizzled + bufw * sizeof(u32) * (y - srcYOffset), format, w, useBGRA);
 				}
 			} else {
-				for (int y = 0; y < h; ++y) {
-					memcpy(out + outPitch * y, unswizzled + bufw * sizeof(u32) * y, w * sizeof(u32));
+				for (int y = yStart; y < yEnd; ++y) {
+					memcpy(out + outPitch * y, unswizzled + bufw * sizeof(u32) * (y - srcYOffset), w * sizeof(u32));
 				}
 			}
 		}
@@ -1362,7 +1544,7 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		int outPitch32 = outPitch / sizeof(u32);
 		DXT1Block *src = (DXT1Block*)texptr;
 
-		for (int y = 0; y < h; y += 4) {
+		for (int y = yStart; y < yEnd; y += 4) {
 			u32 blockIndex = (y / 4) * (bufw / 4);
 			int blockHeight = std::min(h - y, 4);
 			for (int x = 0; x < minw; x += 4) {
@@ -1372,7 +1554,7 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		}
 		w = (w + 3) & ~3;
 		if (reverseColors) {
-			ReverseColors(out, out, GE_TFMT_8888, outPitch32 * h, useBGRA);
+			ReverseColors(out + outPitch * yStart, out + outPitch * yStart, GE_TFMT_8888, outPitch32 * bandH, useBGRA);
 		}
 		break;
 	}
@@ -1384,7 +1566,7 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		int outPitch32 = outPitch / sizeof(u32);
 		DXT3Block *src = (DXT3Block*)texptr;
 
-		for (int y = 0; y < h; y += 4) {
+		for (int y = yStart; y < yEnd; y += 4) {
 			u32 blockIndex = (y / 4) * (bufw / 4);
 			int blockHeight = std::min(h - y, 4);
 			for (int x = 0; x < minw; x += 4) {
@@ -1394,7 +1576,7 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		}
 		w = (w + 3) & ~3;
 		if (reverseColors) {
-			ReverseColors(out, out, GE_TFMT_8888, outPitch32 * h, useBGRA);
+			ReverseColors(out + outPitch * yStart, out + outPitch * yStart, GE_TFMT_8888, outPitch32 * bandH, useBGRA);
 		}
 		break;
 	}
@@ -1406,7 +1588,7 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		int outPitch32 = outPitch / sizeof(u32);
 		DXT5Block *src = (DXT5Block*)texptr;
 
-		for (int y = 0; y < h; y += 4) {
+		for (int y = yStart; y < yEnd; y += 4) {
 			u32 blockIndex = (y / 4) * (bufw / 4);
 			int blockHeight = std::min(h - y, 4);
 			for (int x = 0; x < minw; x += 4) {
@@ -1416,7 +1598,7 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 		}
 		w = (w + 3) & ~3;
 		if (reverseColors) {
-			ReverseColors(out, out, GE_TFMT_8888, outPitch32 * h, useBGRA);
+			ReverseColors(out + outPitch * yStart, out + outPitch * yStart, GE_TFMT_8888, outPitch32 * bandH, useBGRA);
 		}
 		break;
 	}
@@ -1427,14 +1609,16 @@ void TextureCacheCommon::DecodeTextureLevel(u8 *out, int outPitch, GETextureForm
 	}
 }
 
-void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool expandTo32Bit) {
+void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool expandTo32Bit, int yStart, int yEnd, SimpleBuf<u32> &scratch) {
 	int w = gstate.getTextureWidth(level);
-	int h = gstate.getTextureHeight(level);
+	const int bandH = yEnd - yStart;
+	int srcYOffset = 0;
 
 	if (gstate.isTextureSwizzled()) {
-		tmpTexBuf32_.resize(bufw * ((h + 7) & ~7));
-		UnswizzleFromMem(tmpTexBuf32_.data(), bufw * bytesPerIndex, texptr, bufw, h, bytesPerIndex);
-		texptr = (u8 *)tmpTexBuf32_.data();
+		scratch.resize(bufw * ((bandH + 7) & ~7));
+		UnswizzleFromMem(scratch.data(), bufw * bytesPerIndex, texptr + yStart * bufw * bytesPerIndex, bufw, bandH, bytesPerIndex);
+		texptr = (u8 *)scratch.data();
+		srcYOffset = yStart;
 	}
 
 	int palFormat = gstate.getClutPaletteFormat();
@@ -1442,9 +1626,11 @@ void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const
 	const u16 *clut16 = (const u16 *)clutBuf_;
 	const u32 *clut32 = (const u32 *)clutBuf_;
 
+	// Expanded on the stack to stay reentrant for banded decode.
+	u32 expandClut[256];
 	if (expandTo32Bit && palFormat != GE_CMODE_32BIT_ABGR8888) {
-		ConvertFormatToRGBA8888(GEPaletteFormat(palFormat), expandClut_, clut16, 256);
-		clut32 = expandClut_;
+		ConvertFormatToRGBA8888(GEPaletteFormat(palFormat), expandClut, clut16, 256);
+		clut32 = expandClut;
 		palFormat = GE_CMODE_32BIT_ABGR8888;
 	}
 
@@ -1455,20 +1641,20 @@ void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const
 	{
 		switch (bytesPerIndex) {
 		case 1:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u16 *)(out + outPitch * y), (const u8 *)texptr + bufw * y, w, clut16);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture((u16 *)(out + outPitch * y), (const u8 *)texptr + bufw * (y - srcYOffset), w, clut16);
 			}
 			break;
 
 		case 2:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u16 *)(out + outPitch * y), (const u16_le *)texptr + bufw * y, w, clut16);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture((u16 *)(out + outPitch * y), (const u16_le *)texptr + bufw * (y - srcYOffset), w, clut16);
 			}
 			break;
 
 		case 4:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u16 *)(out + outPitch * y), (const u32_le *)texptr + bufw * y, w, clut16);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture((u16 *)(out + outPitch * y), (const u32_le *)texptr + bufw * (y - srcYOffset), w, clut16);
 			}
 			break;
 		}
@@ -1479,20 +1665,20 @@ void TextureCacheCommon::ReadIndexedTex(u8 *out, int outPitch, int level, const
 	{
 		switch (bytesPerIndex) {
 		case 1:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u32 *)(out + outPitch * y), (const u8 *)texptr + bufw * y, w, clut32);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture((u32 *)(out + outPitch * y), (const u8 *)texptr + bufw * (y - srcYOffset), w, clut32);
 			}
 			break;
 
 		case 2:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u32 *)(out + outPitch * y), (const u16_le *)texptr + bufw * y, w, clut32);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture((u32 *)(out + outPitch * y), (const u16_le *)texptr + bufw * (y - srcYOffset), w, clut32);
 			}
 			break;
 
 		case 4:
-			for (int y = 0; y < h; ++y) {
-				DeIndexTexture((u32 *)(out + outPitch * y), (const u32_le *)texptr + bufw * y, w, clut32);
+			for (int y = yStart; y < yEnd; ++y) {
+				DeIndexTexture((u32 *)(out + outPitch * y), (const u32_le *)texptr + bufw * (y - srcYOffset), w, clut32);
 			}
 			break;
 		}
@@ -1517,17 +1703,27 @@ void TextureCacheCommon::ApplyTexture() {
 	if (nextNeedsRebuild_) {
 		// Regardless of hash fails or otherwise, if this is a video, mark it frequently changing.
 		// This prevents temporary scaling perf hits on the first second of video.
-		bool isVideo = videos_.find(entry->addr & 0x3FFFFFFF) != videos_.end();
+		auto video = videos_.find(entry->addr & 0x3FFFFFFF);
+		bool isVideo = video != videos_.end();
 		if (isVideo) {
 			entry->status |= TexCacheEntry::STATUS_CHANGE_FREQUENT;
 		}
 
+		// For video we can skip the full hash - change tracking goes by decoder
+		// generation instead (fullhash can go stale, costing one extra rebuild
+		// when the buffer stops being used for video.) The replacer still needs
+		// real hashes though.
+		if (nextNeedsRehash_ && isVideo && !replacer_.Enabled()) {
+			nextNeedsRehash_ = false;
+		}
+
 		if (nextNeedsRehash_) {
 			PROFILE_THIS_SCOPE("texhash");
 			// Update the hash on the texture.
 			int w = gstate.getTextureWidth(0);
 			int h = gstate.getTextureHeight(0);
 			entry->fullhash = QuickTexHash(replacer_, entry->addr, entry->bufw, w, h, GETextureFormat(entry->format), entry);
+			entry->lastInvalidateGen = invalidateGenCounter_;
 
 			// TODO: Here we could check the secondary cache; maybe the texture is in there?
 			// We would need to abort the build if so.
@@ -1558,6 +1754,13 @@ void TextureCacheCommon::ApplyTexture() {
 		BuildTexture(entry);
 	}
 
+	// The contents now reflect the current decoder frame (whether we rebuilt or
+	// the hash verified them), so SetTexture can skip hashing until the next one.
+	auto videoNow = videos_.find(entry->addr & 0x3FFFFFFF);
+	if (videoNow != videos_.end()) {
+		entry->vidGeneration = videoNow->second.generation;
+	}
+
 	entry->lastFrame = gpuStats.numFlips;
 	if (entry->framebuffer) {
 		ApplyTextureFramebuffer(entry, entry->framebuffer);
@@ -1585,6 +1788,9 @@ void TextureCacheCommon::Clear(bool delete_them) {
 	}
 	fbTexInfo_.clear();
 	videos_.clear();
+	cacheMinAddress_ = 0xFFFFFFFF;
+	cacheMaxAddress_ = 0;
+	DecimateDepalResults(true);
 }
 
 void TextureCacheCommon::DeleteTexture(TexCache::iterator it) {
@@ -1607,6 +1813,7 @@ bool TextureCacheCommon::CheckFullHash(TexCacheEntry *entry, bool &doDelete) {
 	}
 
 	if (fullhash == entry->fullhash) {
+		entry->lastInvalidateGen = invalidateGenCounter_;
 		if (g_Config.bTextureBackoffCache) {
 			if (entry->GetHashStatus() != TexCacheEntry::STATUS_HASHING && entry->numFrames > TexCacheEntry::FRAMES_REGAIN_TRUST) {
 				// Reset to STATUS_HASHING.
@@ -1669,6 +1876,37 @@ bool TextureCacheCommon::CheckFullHash(TexCacheEntry *entry, bool &doDelete) {
 
 	// We know it failed, so update the full hash right away.
 	entry->fullhash = fullhash;
+	entry->lastInvalidateGen = invalidateGenCounter_;
+	return false;
+}
+
+void TextureCacheCommon::MarkInvalidated(u32 addr, u32 size) {
+	addr &= 0x3FFFFFFF;
+	if (size == 0 || addr >= ((u32)INVALIDATE_GEN_BLOCKS << INVALIDATE_GEN_SHIFT))
+		return;
+
+	const u32 gen = ++invalidateGenCounter_;
+	const u32 lastBlock = std::min((addr + size - 1) >> INVALIDATE_GEN_SHIFT, (u32)INVALIDATE_GEN_BLOCKS - 1);
+	for (u32 block = addr >> INVALIDATE_GEN_SHIFT; block <= lastBlock; ++block)
+		invalidateGen_[block] = gen;
+}
+
+bool TextureCacheCommon::InvalidatedSinceLastHash(const TexCacheEntry *entry) const {
+	// Never verified - can't trust it.
+	if (entry->lastInvalidateGen == 0)
+		return true;
+
+	const u32 addr = entry->addr & 0x3FFFFFFF;
+	const u32 size = entry->sizeInRAM ? entry->sizeInRAM : 1;
+	const u32 firstBlock = addr >> INVALIDATE_GEN_SHIFT;
+	if (firstBlock >= (u32)INVALIDATE_GEN_BLOCKS)
+		return true;
+
+	const u32 lastBlock = std::min((addr + size - 1) >> INVALIDATE_GEN_SHIFT, (u32)INVALIDATE_GEN_BLOCKS - 1);
+	for (u32 block = firstBlock; block <= lastBlock; ++block) {
+		if (invalidateGen_[block] > entry->lastInvalidateGen)
+			return true;
+	}
 	return false;
 }
 
@@ -1679,6 +1917,9 @@ void TextureCacheCommon::Invalidate(u32 addr, int size, GPUInvalidationType type
 	addr &= 0x3FFFFFFF;
 	const u32 addr_end = addr + size;
 
+	if (size > 0)
+		MarkInvalidated(addr, size);
+
 	if (type == GPU_INVALIDATE_ALL) {
 		// This is an active signal from the game that something in the texture cache may have changed.
 		gstate_c.Dirty(DIRTY_TEXTURE_IMAGE);
@@ -1690,6 +1931,13 @@ void TextureCacheCommon::Invalidate(u32 addr, int size, GPUInvalidationType type
 		}
 	}
 
+	// Ranges that can't overlap any cached texture - typically the DMA buffers
+	// audio and file streaming run cache-maintenance syscalls over, dozens of
+	// times per frame - don't need the cache walk at all.
+	if (addr >= cacheMaxAddress_ || addr_end <= cacheMinAddress_) {
+		return;
+	}
+
 	// If we're hashing every use, without backoff, then this isn't needed.
 	if (!g_Config.bTextureBackoffCache) {
 		return;
@@ -1729,6 +1977,11 @@ void TextureCacheCommon::Invalidate(u32 addr, int size, GPUInvalidationType type
 }
 
 void TextureCacheCommon::InvalidateAll(GPUInvalidationType /*unused*/) {
+	// Cheap enough to always keep in sync, even when backoff is off.
+	const u32 gen = ++invalidateGenCounter_;
+	for (int block = 0; block < INVALIDATE_GEN_BLOCKS; ++block)
+		invalidateGen_[block] = gen;
+
 	// If we're hashing every use, without backoff, then this isn't needed.
 	if (!g_Config.bTextureBackoffCache) {
 		return;
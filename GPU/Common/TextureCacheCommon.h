@@ -52,6 +52,7 @@ struct VirtualFramebuffer;
 
 namespace Draw {
 class DrawContext;
+class Framebuffer;
 }
 
 // Used by D3D11 and Vulkan, could be used by modern GL
@@ -146,6 +147,12 @@ struct TexCacheEntry {
 	u32 framesUntilNextFullHash;
 	u32 fullhash;
 	u32 cluthash;
+	// TextureCacheCommon::invalidateGenCounter_ at the time fullhash was last
+	// verified against RAM. 0 = never verified.
+	u32 lastInvalidateGen;
+	// TextureCacheCommon::videoGeneration_ of the decoder frame the contents
+	// were built or verified from. 0 = not sourced from a video buffer.
+	u32 vidGeneration;
 	u16 maxSeenV;
 
 	TexStatus GetHashStatus() {
@@ -235,8 +242,12 @@ protected:
 	};
 
 	void DecodeTextureLevel(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, bool reverseColors, bool useBGRA, bool expandTo32Bit);
+	// Decodes only the rows [yStart, yEnd) of a level, using caller-provided unswizzle
+	// scratch so that disjoint bands can be decoded concurrently on worker threads.
+	// yStart must be a multiple of 8 (the swizzle block height.)
+	void DecodeTextureLevelBand(u8 *out, int outPitch, GETextureFormat format, GEPaletteFormat clutformat, uint32_t texaddr, int level, int bufw, bool reverseColors, bool useBGRA, bool expandTo32Bit, int yStart, int yEnd, SimpleBuf<u32> &scratch);
 	void UnswizzleFromMem(u32 *dest, u32 destPitch, const u8 *texptr, u32 bufw, u32 height, u32 bytesPerPixel);
-	void ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool expandTo32Bit);
+	void ReadIndexedTex(u8 *out, int outPitch, int level, const u8 *texptr, int bytesPerIndex, int bufw, bool expandTo32Bit, int yStart, int yEnd, SimpleBuf<u32> &scratch);
 
 	template <typename T>
 	inline const T *GetCurrentClut() {
@@ -255,6 +266,13 @@ protected:
 
 	void SetTextureFramebuffer(TexCacheEntry *entry, VirtualFramebuffer *framebuffer);
 
+	// Returns an FBO to hold the depalettized copy of framebuffer for the current CLUT.
+	// If *needsRender comes back false, the cached contents are still valid (palette and
+	// framebuffer unchanged) and the depal pass can be skipped entirely. Returns nullptr
+	// if this combination shouldn't be cached - use a temp FBO then.
+	Draw::Framebuffer *GetDepalResultFBO(VirtualFramebuffer *framebuffer, u32 clutMode, bool *needsRender);
+	void DecimateDepalResults(bool forceAll);
+
 	void DecimateVideos();
 
 	inline u32 QuickTexHash(TextureReplacer &replacer, u32 addr, int bufw, int w, int h, GETextureFormat format, TexCacheEntry *entry) const {
@@ -270,6 +288,21 @@ protected:
 		const u32 *checkp = (const u32 *)Memory::GetPointer(addr);
 
 		if (Memory::IsValidAddress(addr + sizeInRAM)) {
+			// Huge textures (1MB+, think 512x512x32) dominate hashing time on the GPU
+			// thread, so hash those sparsely: 4K chunks, skipping every other one.
+			// Partial updates that land only in skipped chunks will be missed, but
+			// textures this large are in practice replaced wholesale (videos and the
+			// like) rather than patched.
+			if (sizeInRAM >= 1024 * 1024) {
+				u32 check = 0;
+				for (u32 offset = 0; offset < sizeInRAM; offset += 8192) {
+					u32 chunk = sizeInRAM - offset;
+					if (chunk > 4096)
+						chunk = 4096;
+					check = (check << 13 | check >> 19) ^ DoQuickTexHash((const u8 *)checkp + offset, chunk);
+				}
+				return check;
+			}
 			return DoQuickTexHash(checkp, sizeInRAM);
 		} else {
 			return 0;
@@ -280,12 +313,18 @@ protected:
 		return ptr[0];
 	}
 
+	void MarkInvalidated(u32 addr, u32 size);
+	bool InvalidatedSinceLastHash(const TexCacheEntry *entry) const;
+
 	Draw::DrawContext *draw_;
 	TextureReplacer replacer_;
 	FramebufferManagerCommon *framebufferManager_;
 
 	bool clearCacheNextFrame_;
 	bool lowMemoryMode_;
+	// Byte budget for Decimate's second, generational pass. Backends can lower this
+	// on devices where they know VRAM or address space is tight.
+	u32 standardCacheBudget_;
 
 	int decimationCounter_;
 	int texelsScaledThisFrame_;
@@ -300,7 +339,56 @@ protected:
 	std::vector<VirtualFramebuffer *> fbCache_;
 	std::map<u64, AttachedFramebufferInfo> fbTexInfo_;
 
-	std::map<u32, int> videos_;
+	// Cached depal results, keyed by framebuffer address and CLUT hash, so palette-static
+	// frames can reuse last frame's depalettized copy instead of re-running the pass.
+	struct DepalResult {
+		Draw::Framebuffer *fbo;
+		u32 clutMode;
+		int fbWriteSeq;   // framebuffer->colorWriteSeq when the pass was run.
+		u16 fboWidth;
+		u16 fboHeight;
+		// Region of the source actually covered by the pass (it may be restricted to the
+		// known vertex bounds). Reuse requires the needed region to be inside this.
+		u16 x1, y1, x2, y2;
+		int lastFrame;
+	};
+	std::map<u64, DepalResult> depalResults_;
+
+	// Buffers the video decoder writes into. The decoder notifies us of every
+	// frame it writes (NotifyVideoUpload), so changes to these can be tracked
+	// by generation instead of by hashing the pixels.
+	struct VideoInfo {
+		int lastFrame;   // gpuStats.numFlips at the last write, for decimation.
+		u32 generation;  // Bumped on every decoder write to this address.
+	};
+	std::map<u32, VideoInfo> videos_;
+	u32 videoGeneration_ = 0;
+
+	// Coarse invalidation generations for guest memory (masked addresses),
+	// so we can skip scheduled rehashes of textures whose backing range hasn't
+	// seen any invalidation since the hash was last verified.
+	enum {
+		INVALIDATE_GEN_SHIFT = 19,  // 512KB blocks.
+		// Enough to cover VRAM and RAM including the extra RAM on dev kits.
+		INVALIDATE_GEN_BLOCKS = 0x0C000000 >> INVALIDATE_GEN_SHIFT,
+	};
+	u32 invalidateGen_[INVALIDATE_GEN_BLOCKS] = {};
+	u32 invalidateGenCounter_ = 1;
+
+	// Conservative, grow-only bounds over the memory covered by cached textures.
+	// Lets Invalidate() skip the cache walk entirely for ranges that can't
+	// overlap any texture, like the DMA buffers that get cache-maintenance
+	// syscalls in bulk during streaming. Only reset on a full Clear(), so after
+	// decimation they can overestimate - safe, just less effective.
+	u32 cacheMinAddress_ = 0xFFFFFFFF;
+	u32 cacheMaxAddress_ = 0;
+
+	void ExtendCacheBounds(const TexCacheEntry *entry) {
+		if (entry->addr < cacheMinAddress_)
+			cacheMinAddress_ = entry->addr;
+		if (entry->addr + entry->sizeInRAM > cacheMaxAddress_)
+			cacheMaxAddress_ = entry->addr + entry->sizeInRAM;
+	}
 
 	SimpleBuf<u32> tmpTexBuf32_;
 	SimpleBuf<u16> tmpTexBuf16_;
@@ -320,6 +408,10 @@ protected:
 	u32 clutMaxBytes_;
 	u32 clutRenderAddress_;
 	u32 clutRenderOffset_;
+	// Identifies the upload currently sitting in clutBufRaw_, so that identical
+	// re-uploads (very common in 2D games) can skip the reload entirely.
+	u32 clutLastUploadAddr_;
+	u32 clutLastUploadBytes_;
 	// True if the clut is just alpha values in the same order (RGBA4444-bit only.)
 	bool clutAlphaLinear_;
 	u16 clutAlphaLinearColor_;
@@ -332,8 +424,6 @@ protected:
 	bool nextNeedsRebuild_;
 
 	bool isBgraBackend_;
-
-	u32 expandClut_[256];
 };
 
 inline bool TexCacheEntry::Matches(u16 dim2, u8 format2, u8 maxLevel2) const {
@@ -20,6 +20,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
 
+#include <functional>
 #include <vector>
 
 class TextureScalerCommon {
@@ -31,9 +32,15 @@ public:
 	bool Scale(u32 *&data, u32 &dstfmt, int &width, int &height, int factor);
 	bool ScaleInto(u32 *out, u32 *src, u32 &dstfmt, int &width, int &height, int factor);
 
+	// Runs the inner loops on the calling thread instead of the global pool. For
+	// scaler instances owned by background threads, which shouldn't hog pool time
+	// that the GPU thread wants.
+	void SetSingleThreaded() { useGlobalPool_ = false; }
+
 	enum { XBRZ = 0, HYBRID = 1, BICUBIC = 2, HYBRID_BICUBIC = 3 };
 
 protected:
+	void ParallelLoop(const std::function<void(int, int)> &loop, int lower, int upper);
 	virtual void ConvertTo8888(u32 format, u32 *source, u32 *&dest, int width, int height) = 0;
 	virtual int BytesPerPixel(u32 format) = 0;
 	virtual u32 Get8888Format() = 0;
@@ -48,8 +55,10 @@ protected:
 
 	bool IsEmptyOrFlat(u32* data, int pixels, int fmt);
 
-	// depending on the factor and texture sizes, these can get pretty large 
+	// depending on the factor and texture sizes, these can get pretty large
 	// maximum is (100 MB total for a 512 by 512 texture with scaling factor 5 and hybrid scaling)
 	// of course, scaling factor 5 is totally silly anyway
 	SimpleBuf<u32> bufInput, bufDeposter, bufOutput, bufTmp1, bufTmp2, bufTmp3;
+
+	bool useGlobalPool_ = true;
 };
@@ -48,8 +48,12 @@ Lighter::Lighter(int vertType) {
 	for (int l = 0; l < 4; l++) {
 		lcutoff[l] = getFloat24(gstate.lcutoff[l]);
 		lconv[l] = getFloat24(gstate.lconv[l]);
+		lightEnabled_[l] = gstate.isLightChanEnabled(l);
+		lightType_[l] = gstate.getLightType(l);
+		doSpecular_[l] = gstate.isUsingSpecularLight(l);
+		poweredDiffuse_[l] = gstate.isUsingPoweredDiffuseLight(l);
 		int i = l * 3;
-		if (gstate.isLightChanEnabled(l)) {
+		if (lightEnabled_[l]) {
 			lpos[i] = getFloat24(gstate.lpos[i]);
 			lpos[i + 1] = getFloat24(gstate.lpos[i + 1]);
 			lpos[i + 2] = getFloat24(gstate.lpos[i + 2]);
@@ -98,10 +102,10 @@ void Lighter::Light(float colorOut0[4], float colorOut1[4], const float colorIn[
 
 	for (int l = 0; l < 4; l++) {
 		// can we skip this light?
-		if (!gstate.isLightChanEnabled(l))
+		if (!lightEnabled_[l])
 			continue;
 
-		GELightType type = gstate.getLightType(l);
+		GELightType type = lightType_[l];
 
 		Vec3f toLight(0, 0, 0);
 		Vec3f lightDir(0, 0, 0);
@@ -111,8 +115,8 @@ void Lighter::Light(float colorOut0[4], float colorOut1[4], const float colorIn[
 		else
 			toLight = Vec3Packedf(&lpos[l * 3]) - pos;
 
-		bool doSpecular = gstate.isUsingSpecularLight(l);
-		bool poweredDiffuse = gstate.isUsingPoweredDiffuseLight(l);
+		bool doSpecular = doSpecular_[l];
+		bool poweredDiffuse = poweredDiffuse_[l];
 
 		float distanceToLight = toLight.Length();
 		float dot = 0.0f;
@@ -168,10 +172,8 @@ void Lighter::Light(float colorOut0[4], float colorOut1[4], const float colorIn[
 			}
 		}
 
-		if (gstate.isLightChanEnabled(l)) {
-			Color4 lightAmbient(lcolor[0][l], 0.0f);
-			lightSum0 += (lightAmbient * *ambient + diff) * lightScale;
-		}
+		Color4 lightAmbient(lcolor[0][l], 0.0f);
+		lightSum0 += (lightAmbient * *ambient + diff) * lightScale;
 	}
 
 	// The colors must eventually be clamped, but we expect the caller to do that.
@@ -80,6 +80,12 @@ private:
 	bool doShadeMapping_;
 	int materialUpdate_;
 
+	// Per-light state hoisted out of Light() - uniform across a draw call.
+	bool lightEnabled_[4];
+	bool doSpecular_[4];
+	bool poweredDiffuse_[4];
+	GELightType lightType_[4];
+
 	// Converted light parameters
 public:
 	float lpos[12];  // Used by shade UV mapping
@@ -458,6 +458,9 @@ public:
 	bool hasColor() const { return col != 0; }
 	bool hasTexcoord() const { return tc != 0; }
 	int VertexSize() const { return size; }  // PSP format size
+	// The jitted path is reentrant; the interpreted steps keep cursor state on
+	// the decoder object, so they can't run on several threads at once.
+	bool IsJitted() const { return jitted_ != nullptr; }
 
 	std::string GetString(DebugShaderStringType stringType);
 
@@ -681,6 +684,14 @@ public:
 	void Jit_PosS16Morph();
 	void Jit_PosFloatMorph();
 
+	void Jit_NormalS8MorphSkin();
+	void Jit_NormalS16MorphSkin();
+	void Jit_NormalFloatMorphSkin();
+
+	void Jit_PosS8MorphSkin();
+	void Jit_PosS16MorphSkin();
+	void Jit_PosFloatMorphSkin();
+
 	void Jit_Color8888Morph();
 	void Jit_Color4444Morph();
 	void Jit_Color565Morph();
@@ -698,6 +709,7 @@ private:
 	void Jit_AnyS8Morph(int srcoff, int dstoff);
 	void Jit_AnyS16Morph(int srcoff, int dstoff);
 	void Jit_AnyFloatMorph(int srcoff, int dstoff);
+	void Jit_AnyMorphSkin(int srcoff, int fmtBits);
 
 	const VertexDecoder *dec_;
 #if PPSSPP_ARCH(ARM64)
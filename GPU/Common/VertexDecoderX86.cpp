@@ -160,6 +160,14 @@ static const JitLookup jitLookup[] = {
 	{&VertexDecoder::Step_Color4444Morph, &VertexDecoderJitCache::Jit_Color4444Morph},
 	{&VertexDecoder::Step_Color565Morph, &VertexDecoderJitCache::Jit_Color565Morph},
 	{&VertexDecoder::Step_Color5551Morph, &VertexDecoderJitCache::Jit_Color5551Morph},
+
+	{&VertexDecoder::Step_NormalS8MorphSkin, &VertexDecoderJitCache::Jit_NormalS8MorphSkin},
+	{&VertexDecoder::Step_NormalS16MorphSkin, &VertexDecoderJitCache::Jit_NormalS16MorphSkin},
+	{&VertexDecoder::Step_NormalFloatMorphSkin, &VertexDecoderJitCache::Jit_NormalFloatMorphSkin},
+
+	{&VertexDecoder::Step_PosS8MorphSkin, &VertexDecoderJitCache::Jit_PosS8MorphSkin},
+	{&VertexDecoder::Step_PosS16MorphSkin, &VertexDecoderJitCache::Jit_PosS16MorphSkin},
+	{&VertexDecoder::Step_PosFloatMorphSkin, &VertexDecoderJitCache::Jit_PosFloatMorphSkin},
 };
 
 JittedVertexDecoder VertexDecoderJitCache::Compile(const VertexDecoder &dec, int32_t *jittedSize) {
@@ -1647,6 +1655,101 @@ void VertexDecoderJitCache::Jit_NormalFloatMorph() {
 	Jit_AnyFloatMorph(dec_->nrmoff, dec_->decFmt.nrmoff);
 }
 
+// Accumulates the morphed value into XMM3, ready for Jit_WriteMatrixMul.
+// Unlike the plain morph helpers, this can only touch XMM1-XMM3: XMM4-XMM7
+// hold the converted skin matrix, and XMM0 may hold the texcoord prescale.
+void VertexDecoderJitCache::Jit_AnyMorphSkin(int srcoff, int fmtBits) {
+	MOV(PTRBITS, R(tempReg1), ImmPtr(&gstate_c.morphWeights[0]));
+	const float *scale = nullptr;
+	if (fmtBits == 8)
+		scale = by128;
+	else if (fmtBits == 16)
+		scale = by32768;
+	if (scale && !RipAccessible(scale))
+		MOV(PTRBITS, R(tempReg2), ImmPtr(scale));
+
+	bool first = true;
+	for (int n = 0; n < dec_->morphcount; ++n) {
+		// Convert the nth morph target to floats in fpScratchReg2.
+		if (fmtBits == 8) {
+			MOVD_xmm(fpScratchReg2, MDisp(srcReg, dec_->onesize_ * n + srcoff));
+			if (cpu_info.bSSE4_1) {
+				PMOVSXBD(fpScratchReg2, R(fpScratchReg2));
+			} else {
+				// Self-unpack - the interleaved garbage is shifted back out.
+				PUNPCKLBW(fpScratchReg2, R(fpScratchReg2));
+				PUNPCKLWD(fpScratchReg2, R(fpScratchReg2));
+				PSLLD(fpScratchReg2, 24);
+				PSRAD(fpScratchReg2, 24);
+			}
+			CVTDQ2PS(fpScratchReg2, R(fpScratchReg2));
+		} else if (fmtBits == 16) {
+			MOVQ_xmm(fpScratchReg2, MDisp(srcReg, dec_->onesize_ * n + srcoff));
+			if (cpu_info.bSSE4_1) {
+				PMOVSXWD(fpScratchReg2, R(fpScratchReg2));
+			} else {
+				PUNPCKLWD(fpScratchReg2, R(fpScratchReg2));
+				PSLLD(fpScratchReg2, 16);
+				PSRAD(fpScratchReg2, 16);
+			}
+			CVTDQ2PS(fpScratchReg2, R(fpScratchReg2));
+		} else {
+			MOVUPS(fpScratchReg2, MDisp(srcReg, dec_->onesize_ * n + srcoff));
+		}
+
+		// Multiply by the morph weight, with the format scale folded in.
+		MOVSS(fpScratchReg3, MDisp(tempReg1, sizeof(float) * n));
+		if (scale) {
+			if (RipAccessible(scale)) {
+				MULSS(fpScratchReg3, M(scale));  // rip accessible
+			} else {
+				MULSS(fpScratchReg3, MatR(tempReg2));
+			}
+		}
+		SHUFPS(fpScratchReg3, R(fpScratchReg3), _MM_SHUFFLE(0, 0, 0, 0));
+		MULPS(fpScratchReg2, R(fpScratchReg3));
+
+		if (first) {
+			MOVAPS(fpScratchReg, R(fpScratchReg2));
+			first = false;
+		} else {
+			ADDPS(fpScratchReg, R(fpScratchReg2));
+		}
+	}
+
+	MOVAPS(fpScratchReg3, R(fpScratchReg));
+}
+
+void VertexDecoderJitCache::Jit_PosS8MorphSkin() {
+	Jit_AnyMorphSkin(dec_->posoff, 8);
+	Jit_WriteMatrixMul(dec_->decFmt.posoff, true);
+}
+
+void VertexDecoderJitCache::Jit_PosS16MorphSkin() {
+	Jit_AnyMorphSkin(dec_->posoff, 16);
+	Jit_WriteMatrixMul(dec_->decFmt.posoff, true);
+}
+
+void VertexDecoderJitCache::Jit_PosFloatMorphSkin() {
+	Jit_AnyMorphSkin(dec_->posoff, 32);
+	Jit_WriteMatrixMul(dec_->decFmt.posoff, true);
+}
+
+void VertexDecoderJitCache::Jit_NormalS8MorphSkin() {
+	Jit_AnyMorphSkin(dec_->nrmoff, 8);
+	Jit_WriteMatrixMul(dec_->decFmt.nrmoff, false);
+}
+
+void VertexDecoderJitCache::Jit_NormalS16MorphSkin() {
+	Jit_AnyMorphSkin(dec_->nrmoff, 16);
+	Jit_WriteMatrixMul(dec_->decFmt.nrmoff, false);
+}
+
+void VertexDecoderJitCache::Jit_NormalFloatMorphSkin() {
+	Jit_AnyMorphSkin(dec_->nrmoff, 32);
+	Jit_WriteMatrixMul(dec_->decFmt.nrmoff, false);
+}
+
 bool VertexDecoderJitCache::CompileStep(const VertexDecoder &dec, int step) {
 	// See if we find a matching JIT function
 	for (size_t i = 0; i < ARRAY_SIZE(jitLookup); i++) {
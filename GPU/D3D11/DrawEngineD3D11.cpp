@@ -720,7 +720,6 @@ void TessellationDataTransferD3D11::SendDataToShader(const SimpleVertex *const *
 		desc.StructureByteStride = sizeof(TessData);
 		device_->CreateBuffer(&desc, nullptr, &buf[0]);
 		device_->CreateShaderResourceView(buf[0], nullptr, &view[0]);
-		context_->VSSetShaderResources(0, 1, &view[0]);
 	}
 	D3D11_MAPPED_SUBRESOURCE map;
 	context_->Map(buf[0], 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
@@ -747,11 +746,16 @@ void TessellationDataTransferD3D11::SendDataToShader(const SimpleVertex *const *
 		desc.StructureByteStride = sizeof(Weight);
 		device_->CreateBuffer(&desc, nullptr, &buf[1]);
 		device_->CreateShaderResourceView(buf[1], nullptr, &view[1]);
-		context_->VSSetShaderResources(1, 1, &view[1]);
+		prevWeightsU_ = nullptr;
+	}
+	// Most patches in a frame share tess factors, so the cached weight array is
+	// usually the one already uploaded.
+	if (prevWeightsU_ != weights.u) {
+		prevWeightsU_ = weights.u;
+		context_->Map(buf[1], 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+		memcpy(map.pData, weights.u, weights.size_u * sizeof(Weight));
+		context_->Unmap(buf[1], 0);
 	}
-	context_->Map(buf[1], 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-	memcpy(map.pData, weights.u, weights.size_u * sizeof(Weight));
-	context_->Unmap(buf[1], 0);
 
 	// Weights V
 	if (prevSizeWV < weights.size_v) {
@@ -763,9 +767,16 @@ void TessellationDataTransferD3D11::SendDataToShader(const SimpleVertex *const *
 		desc.StructureByteStride = sizeof(Weight);
 		device_->CreateBuffer(&desc, nullptr, &buf[2]);
 		device_->CreateShaderResourceView(buf[2], nullptr, &view[2]);
-		context_->VSSetShaderResources(2, 1, &view[2]);
+		prevWeightsV_ = nullptr;
+	}
+	if (prevWeightsV_ != weights.v) {
+		prevWeightsV_ = weights.v;
+		context_->Map(buf[2], 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+		memcpy(map.pData, weights.v, weights.size_v * sizeof(Weight));
+		context_->Unmap(buf[2], 0);
 	}
-	context_->Map(buf[2], 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-	memcpy(map.pData, weights.v, weights.size_v * sizeof(Weight));
-	context_->Unmap(buf[2], 0);
+
+	// Bind all three views every time - cheap, and doesn't rely on the bindings
+	// surviving from whenever the buffers were last created.
+	context_->VSSetShaderResources(0, 3, view);
 }
@@ -108,6 +108,9 @@ private:
 	D3D11_BUFFER_DESC desc{};
 	int prevSize = 0;
 	int prevSizeWU = 0, prevSizeWV = 0;
+	// The weight arrays come from the spline weight cache, which lives until
+	// engine shutdown - same pointer means same contents, no re-upload needed.
+	const void *prevWeightsU_ = nullptr, *prevWeightsV_ = nullptr;
 public:
 	TessellationDataTransferD3D11(ID3D11DeviceContext *context, ID3D11Device *device);
 	~TessellationDataTransferD3D11();
@@ -89,6 +89,15 @@ std::string D3D11VertexShader::GetShaderString(DebugShaderStringType type) const
 	}
 }
 
+enum {
+	// Each of the three uniform blocks gets one slot per update; the static_asserts
+	// in the constructor guarantee they fit. 512 bytes keeps the offsets at the
+	// 256-byte alignment VSSetConstantBuffers1 requires.
+	UNIFORM_SLOT_SIZE = 512,
+	UNIFORM_PUSH_SIZE = UNIFORM_SLOT_SIZE * 3,
+	UNIFORM_RING_SIZE = 1024 * 1024,
+};
+
 ShaderManagerD3D11::ShaderManagerD3D11(Draw::DrawContext *draw, ID3D11Device *device, ID3D11DeviceContext *context, D3D_FEATURE_LEVEL featureLevel)
 	: ShaderManagerCommon(draw), device_(device), context_(context), featureLevel_(featureLevel), lastVShader_(nullptr), lastFShader_(nullptr) {
 	codeBuffer_ = new char[16384];
@@ -106,12 +115,24 @@ ShaderManagerD3D11::ShaderManagerD3D11(Draw::DrawContext *draw, ID3D11Device *de
 	ASSERT_SUCCESS(device_->CreateBuffer(&desc, nullptr, &push_lights));
 	desc.ByteWidth = sizeof(ub_bones);
 	ASSERT_SUCCESS(device_->CreateBuffer(&desc, nullptr, &push_bones));
+
+	// On D3D11.1 with the right driver support, we can treat uniforms like we do in
+	// Vulkan: write them into a big ring with NO_OVERWRITE maps and bind at offsets,
+	// instead of a serializing Map(DISCARD) per dirty block per draw.
+	ID3D11DeviceContext1 *context1 = (ID3D11DeviceContext1 *)draw->GetNativeObject(Draw::NativeObject::CONTEXT_EX);
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+	HRESULT hr = device_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	if (context1 && SUCCEEDED(hr) && options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer) {
+		pushUniforms_ = new PushBufferD3D11(device_, UNIFORM_RING_SIZE, D3D11_BIND_CONSTANT_BUFFER);
+		context1_ = context1;
+	}
 }
 
 ShaderManagerD3D11::~ShaderManagerD3D11() {
 	push_base->Release();
 	push_lights->Release();
 	push_bones->Release();
+	delete pushUniforms_;
 	ClearShaders();
 	delete[] codeBuffer_;
 }
@@ -144,27 +165,46 @@ void ShaderManagerD3D11::DirtyLastShader() {
 	gstate_c.Dirty(DIRTY_VERTEXSHADER_STATE | DIRTY_FRAGMENTSHADER_STATE);
 }
 
+void ShaderManagerD3D11::BeginFrame() {
+	if (pushUniforms_) {
+		pushUniforms_->Reset();
+	}
+}
+
 uint64_t ShaderManagerD3D11::UpdateUniforms() {
 	uint64_t dirty = gstate_c.GetDirtyUniforms();
 	if (dirty != 0) {
-		D3D11_MAPPED_SUBRESOURCE map;
-		if (dirty & DIRTY_BASE_UNIFORMS) {
+		if (dirty & DIRTY_BASE_UNIFORMS)
 			BaseUpdateUniforms(&ub_base, dirty, true);
-			context_->Map(push_base, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-			memcpy(map.pData, &ub_base, sizeof(ub_base));
-			context_->Unmap(push_base, 0);
-		}
-		if (dirty & DIRTY_LIGHT_UNIFORMS) {
+		if (dirty & DIRTY_LIGHT_UNIFORMS)
 			LightUpdateUniforms(&ub_lights, dirty);
-			context_->Map(push_lights, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-			memcpy(map.pData, &ub_lights, sizeof(ub_lights));
-			context_->Unmap(push_lights, 0);
-		}
-		if (dirty & DIRTY_BONE_UNIFORMS) {
+		if (dirty & DIRTY_BONE_UNIFORMS)
 			BoneUpdateUniforms(&ub_bones, dirty);
-			context_->Map(push_bones, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-			memcpy(map.pData, &ub_bones, sizeof(ub_bones));
-			context_->Unmap(push_bones, 0);
+		if (pushUniforms_) {
+			// Write all three blocks into fresh ring space - they get rebound together
+			// anyway, and the copies are small.
+			uint8_t *dest = pushUniforms_->BeginPush(context_, &uniformRingOffset_, UNIFORM_PUSH_SIZE, 256);
+			memcpy(dest, &ub_base, sizeof(ub_base));
+			memcpy(dest + UNIFORM_SLOT_SIZE, &ub_lights, sizeof(ub_lights));
+			memcpy(dest + 2 * UNIFORM_SLOT_SIZE, &ub_bones, sizeof(ub_bones));
+			pushUniforms_->EndPush(context_);
+		} else {
+			D3D11_MAPPED_SUBRESOURCE map;
+			if (dirty & DIRTY_BASE_UNIFORMS) {
+				context_->Map(push_base, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+				memcpy(map.pData, &ub_base, sizeof(ub_base));
+				context_->Unmap(push_base, 0);
+			}
+			if (dirty & DIRTY_LIGHT_UNIFORMS) {
+				context_->Map(push_lights, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+				memcpy(map.pData, &ub_lights, sizeof(ub_lights));
+				context_->Unmap(push_lights, 0);
+			}
+			if (dirty & DIRTY_BONE_UNIFORMS) {
+				context_->Map(push_bones, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+				memcpy(map.pData, &ub_bones, sizeof(ub_bones));
+				context_->Unmap(push_bones, 0);
+			}
 		}
 	}
 	gstate_c.CleanUniforms();
@@ -172,10 +212,25 @@ uint64_t ShaderManagerD3D11::UpdateUniforms() {
 }
 
 void ShaderManagerD3D11::BindUniforms() {
-	ID3D11Buffer *vs_cbs[3] = { push_base, push_lights, push_bones };
-	ID3D11Buffer *ps_cbs[1] = { push_base };
-	context_->VSSetConstantBuffers(0, 3, vs_cbs);
-	context_->PSSetConstantBuffers(0, 1, ps_cbs);
+	if (pushUniforms_) {
+		ID3D11Buffer *buf = pushUniforms_->Buf();
+		ID3D11Buffer *cbs[3] = { buf, buf, buf };
+		// Offsets and counts are in units of 16-byte constants, and must be multiples
+		// of 16 constants (256 bytes).
+		UINT firsts[3] = {
+			uniformRingOffset_ / 16,
+			(uniformRingOffset_ + UNIFORM_SLOT_SIZE) / 16,
+			(uniformRingOffset_ + 2 * UNIFORM_SLOT_SIZE) / 16,
+		};
+		UINT counts[3] = { UNIFORM_SLOT_SIZE / 16, UNIFORM_SLOT_SIZE / 16, UNIFORM_SLOT_SIZE / 16 };
+		context1_->VSSetConstantBuffers1(0, 3, cbs, firsts, counts);
+		context1_->PSSetConstantBuffers1(0, 1, cbs, firsts, counts);
+	} else {
+		ID3D11Buffer *vs_cbs[3] = { push_base, push_lights, push_bones };
+		ID3D11Buffer *ps_cbs[1] = { push_base };
+		context_->VSSetConstantBuffers(0, 3, vs_cbs);
+		context_->PSSetConstantBuffers(0, 1, ps_cbs);
+	}
 }
 
 void ShaderManagerD3D11::GetShaders(int prim, u32 vertType, D3D11VertexShader **vshader, D3D11FragmentShader **fshader, bool useHWTransform) {
@@ -20,6 +20,7 @@
 #include <map>
 
 #include <d3d11.h>
+#include <d3d11_1.h>
 
 #include "base/basictypes.h"
 #include "GPU/Common/ShaderCommon.h"
@@ -27,7 +28,7 @@
 #include "GPU/Common/ShaderUniforms.h"
 
 class D3D11Context;
-class D3D11PushBuffer;
+class PushBufferD3D11;
 
 class D3D11FragmentShader {
 public:
@@ -77,8 +78,6 @@ protected:
 	VShaderID id_;
 };
 
-class D3D11PushBuffer;
-
 class ShaderManagerD3D11 : public ShaderManagerCommon {
 public:
 	ShaderManagerD3D11(Draw::DrawContext *draw, ID3D11Device *device, ID3D11DeviceContext *context, D3D_FEATURE_LEVEL featureLevel);
@@ -94,6 +93,7 @@ public:
 	std::vector<std::string> DebugGetShaderIDs(DebugShaderType type);
 	std::string DebugGetShaderString(std::string id, DebugShaderType type, DebugShaderStringType stringType);
 
+	void BeginFrame();
 	uint64_t UpdateUniforms();
 	void BindUniforms();
 
@@ -123,11 +123,17 @@ private:
 	UB_VS_Lights ub_lights;
 	UB_VS_Bones ub_bones;
 
-	// Not actual pushbuffers, requires D3D11.1, let's try to live without that first.
+	// Not actual pushbuffers, used on plain D3D11 where we're stuck with per-draw Map(DISCARD).
 	ID3D11Buffer *push_base;
 	ID3D11Buffer *push_lights;
 	ID3D11Buffer *push_bones;
 
+	// D3D11.1 path: one big NO_OVERWRITE-mapped ring, bound at offsets with
+	// VSSetConstantBuffers1. Mirrors what Vulkan gets from VulkanPushBuffer.
+	ID3D11DeviceContext1 *context1_ = nullptr;
+	PushBufferD3D11 *pushUniforms_ = nullptr;
+	UINT uniformRingOffset_ = 0;
+
 	D3D11FragmentShader *lastFShader_;
 	D3D11VertexShader *lastVShader_;
 
@@ -197,23 +197,7 @@ bool FramebufferManagerD3D11::NotifyStencilUpload(u32 addr, int size, bool skipZ
 	context_->OMSetDepthStencilState(stockD3D11.depthDisabledStencilWrite, 0xFF);
 	gstate_c.Dirty(DIRTY_BLEND_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE);
 
-	for (int i = 1; i < values; i += i) {
-		if (!(usedBits & i)) {
-			// It's already zero, let's skip it.
-			continue;
-		}
-		uint8_t mask = 0;
-		uint8_t value = 0;
-		if (dstBuffer->format == GE_FORMAT_4444) {
-			mask = i | (i << 4);
-			value = i * 16;
-		} else if (dstBuffer->format == GE_FORMAT_5551) {
-			mask = 0xFF;
-			value = i * 128;
-		} else {
-			mask = i;
-			value = i;
-		}
+	auto maskState = [&](uint8_t mask) {
 		if (!stencilMaskStates_[mask]) {
 			D3D11_DEPTH_STENCIL_DESC desc{};
 			desc.DepthEnable = false;
@@ -227,15 +211,65 @@ bool FramebufferManagerD3D11::NotifyStencilUpload(u32 addr, int size, bool skipZ
 			desc.BackFace = desc.FrontFace;
 			device_->CreateDepthStencilState(&desc, &stencilMaskStates_[mask]);
 		}
-		context_->OMSetDepthStencilState(stencilMaskStates_[mask], 0xFF);
+		return stencilMaskStates_[mask];
+	};
 
+	auto setStencilValue = [&](uint32_t value) {
 		D3D11_MAPPED_SUBRESOURCE map;
 		context_->Map(stencilValueBuffer_, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
-		StencilValueUB ub{ (uint32_t)value };
+		StencilValueUB ub{ value };
 		memcpy(map.pData, &ub, sizeof(ub));
 		context_->Unmap(stencilValueBuffer_, 0);
 		context_->PSSetConstantBuffers(0, 1, &stencilValueBuffer_);
+	};
+
+	// When multiple bits are in use but every non-zero pixel has the same value, we can
+	// replace the whole value in a single pass instead of looping over the bits.
+	u8 singleValue = 0;
+	if (usedBits & (usedBits - 1)) {
+		if (dstBuffer->format == GE_FORMAT_4444) {
+			singleValue = StencilSingleValue4444(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
+		} else if (dstBuffer->format == GE_FORMAT_8888) {
+			singleValue = StencilSingleValue8888(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
+		}
+	}
+
+	if (singleValue != 0) {
+		uint8_t refValue = 0;
+		uint32_t value = 0;
+		if (dstBuffer->format == GE_FORMAT_4444) {
+			refValue = (singleValue << 4) | singleValue;
+			value = singleValue * 16;
+		} else {
+			refValue = singleValue;
+			value = singleValue;
+		}
+		// The shader discards the zero pixels and the rest all get refValue written.
+		context_->OMSetDepthStencilState(maskState(0xFF), refValue);
+		setStencilValue(value);
 		context_->Draw(4, 0);
+	} else {
+		for (int i = 1; i < values; i += i) {
+			if (!(usedBits & i)) {
+				// It's already zero, let's skip it.
+				continue;
+			}
+			uint8_t mask = 0;
+			uint8_t value = 0;
+			if (dstBuffer->format == GE_FORMAT_4444) {
+				mask = i | (i << 4);
+				value = i * 16;
+			} else if (dstBuffer->format == GE_FORMAT_5551) {
+				mask = 0xFF;
+				value = i * 128;
+			} else {
+				mask = i;
+				value = i;
+			}
+			context_->OMSetDepthStencilState(maskState(mask), 0xFF);
+			setStencilValue(value);
+			context_->Draw(4, 0);
+		}
 	}
 	RebindFramebuffer();
 	return true;
@@ -43,6 +43,11 @@ namespace GPURecord {
 static std::string lastExecFilename;
 static std::vector<Command> lastExecCommands;
 static std::vector<u8> lastExecPushbuf;
+// Command index of each frame's first command, built once per loaded dump.
+// Frames end at DISPLAY commands.
+static std::vector<u32> lastExecFrameStarts;
+static int execFirstFrame = 0;
+static int execLastFrame = -1;
 
 // This class maps pushbuffer (dump data) sections to PSP memory.
 // Dumps can be larger than available PSP memory, because they include generated data too.
@@ -277,9 +282,15 @@ public:
 	}
 	~DumpExecute();
 
-	bool Run();
+	// Fast-forwards the first skipCmds commands (memory and register state
+	// only, no draws), then executes normally up to endCmd.
+	bool Run(size_t skipCmds, size_t endCmd);
 
 private:
+	void FastForward(const Command &cmd);
+	void FastForwardRegisters(u32 ptr, u32 sz);
+	void FastForwardFramebuf(int level, u32 ptr, u32 sz);
+
 	void SyncStall();
 	bool SubmitCmds(const void *p, u32 sz);
 	void SubmitListEnd();
@@ -549,6 +560,101 @@ void DumpExecute::Display(u32 ptr, u32 sz) {
 	__DisplaySetFramebuf(disp->topaddr.ptr, disp->linesize, disp->pixelFormat, 0);
 }
 
+void DumpExecute::FastForwardRegisters(u32 ptr, u32 sz) {
+	const u32_le *ops = (const u32_le *)(pushbuf_.data() + ptr);
+	for (u32 i = 0; i < sz / 4; ++i) {
+		u32 op = ops[i];
+		u32 cmd = op >> 24;
+		switch (cmd) {
+		case GE_CMD_NOP:
+		case GE_CMD_PRIM:
+		case GE_CMD_BEZIER:
+		case GE_CMD_SPLINE:
+		case GE_CMD_BOUNDINGBOX:
+		case GE_CMD_JUMP:
+		case GE_CMD_BJUMP:
+		case GE_CMD_CALL:
+		case GE_CMD_RET:
+		case GE_CMD_END:
+		case GE_CMD_SIGNAL:
+		case GE_CMD_FINISH:
+		case GE_CMD_TRANSFERSTART:
+			// Draws and list flow, skipped entirely - the dump's FRAMEBUF
+			// commands reseed the targets each frame anyway.
+			break;
+
+		default:
+			// Plain state, latch it directly.  ReapplyGfxState() once the
+			// fast-forward is done picks it all up.
+			gstate.cmdmem[cmd] = op;
+			break;
+		}
+	}
+}
+
+void DumpExecute::FastForwardFramebuf(int level, u32 ptr, u32 sz) {
+	struct FramebufData {
+		u32 addr;
+		int bufw;
+		u32 flags;
+		u32 pad;
+	};
+
+	// Same memory upload as Framebuf(), minus the texture binding.
+	FramebufData *framebuf = (FramebufData *)(pushbuf_.data() + ptr);
+	lastBufw_[level] = framebuf->bufw;
+
+	u32 headerSize = (u32)sizeof(FramebufData);
+	u32 pspSize = sz - headerSize;
+	const bool isTarget = (framebuf->flags & 1) != 0;
+	if (Memory::IsValidRange(framebuf->addr, pspSize) && (!isTarget || !g_Config.bSoftwareRendering)) {
+		Memory::MemcpyUnchecked(framebuf->addr, pushbuf_.data() + ptr + headerSize, pspSize);
+	}
+}
+
+void DumpExecute::FastForward(const Command &cmd) {
+	switch (cmd.type) {
+	case CommandType::INIT:
+		Init(cmd.ptr, cmd.sz);
+		break;
+
+	case CommandType::REGISTERS:
+		FastForwardRegisters(cmd.ptr, cmd.sz);
+		break;
+
+	case CommandType::MEMSET:
+		Memset(cmd.ptr, cmd.sz);
+		break;
+
+	case CommandType::MEMCPYDEST:
+		MemcpyDest(cmd.ptr, cmd.sz);
+		break;
+
+	case CommandType::MEMCPYDATA:
+		Memcpy(cmd.ptr, cmd.sz);
+		break;
+
+	case CommandType::FRAMEBUF0:
+	case CommandType::FRAMEBUF1:
+	case CommandType::FRAMEBUF2:
+	case CommandType::FRAMEBUF3:
+	case CommandType::FRAMEBUF4:
+	case CommandType::FRAMEBUF5:
+	case CommandType::FRAMEBUF6:
+	case CommandType::FRAMEBUF7:
+		FastForwardFramebuf((int)cmd.type - (int)CommandType::FRAMEBUF0, cmd.ptr, cmd.sz);
+		break;
+
+	case CommandType::DISPLAY:
+		Display(cmd.ptr, cmd.sz);
+		break;
+
+	default:
+		// Textures, verts, inds, cluts - only inputs to the draws we skip.
+		break;
+	}
+}
+
 DumpExecute::~DumpExecute() {
 	execMemcpyDest = 0;
 	if (execListBuf) {
@@ -559,8 +665,21 @@ DumpExecute::~DumpExecute() {
 	mapping_.Reset();
 }
 
-bool DumpExecute::Run() {
-	for (const Command &cmd : commands_) {
+bool DumpExecute::Run(size_t skipCmds, size_t endCmd) {
+	{
+		PROFILE_THIS_SCOPE("ReplaySeek");
+		for (size_t i = 0; i < skipCmds; ++i) {
+			FastForward(commands_[i]);
+		}
+		if (skipCmds != 0) {
+			// FastForwardRegisters() latched into gstate directly, so resync
+			// the backend before the first real draw.
+			gpu->ReapplyGfxState();
+		}
+	}
+
+	for (size_t i = skipCmds; i < endCmd; ++i) {
+		const Command &cmd = commands_[i];
 		switch (cmd.type) {
 		case CommandType::INIT:
 			Init(cmd.ptr, cmd.sz);
@@ -657,6 +776,24 @@ static void ReplayStop() {
 	lastExecFilename.clear();
 	lastExecCommands.clear();
 	lastExecPushbuf.clear();
+	lastExecFrameStarts.clear();
+	execFirstFrame = 0;
+	execLastFrame = -1;
+}
+
+void SetFrameRange(int firstFrame, int lastFrame) {
+	execFirstFrame = firstFrame < 0 ? 0 : firstFrame;
+	execLastFrame = lastFrame;
+}
+
+static void BuildFrameIndex() {
+	lastExecFrameStarts.clear();
+	lastExecFrameStarts.push_back(0);
+	for (size_t i = 0; i + 1 < lastExecCommands.size(); ++i) {
+		if (lastExecCommands[i].type == CommandType::DISPLAY) {
+			lastExecFrameStarts.push_back((u32)(i + 1));
+		}
+	}
 }
 
 bool RunMountedReplay(const std::string &filename) {
@@ -697,10 +834,18 @@ bool RunMountedReplay(const std::string &filename) {
 		}
 
 		lastExecFilename = filename;
+		BuildFrameIndex();
 	}
 
+	int numFrames = (int)lastExecFrameStarts.size();
+	int firstFrame = std::min(execFirstFrame, numFrames - 1);
+	int lastFrame = execLastFrame < 0 ? numFrames - 1 : std::min(execLastFrame, numFrames - 1);
+	lastFrame = std::max(lastFrame, firstFrame);
+	size_t skipCmds = lastExecFrameStarts[firstFrame];
+	size_t endCmd = lastFrame + 1 < numFrames ? lastExecFrameStarts[lastFrame + 1] : lastExecCommands.size();
+
 	DumpExecute executor(lastExecPushbuf, lastExecCommands);
-	return executor.Run();
+	return executor.Run(skipCmds, endCmd);
 }
 
 };
@@ -23,4 +23,13 @@ namespace GPURecord {
 
 bool RunMountedReplay(const std::string &filename);
 
+// Restricts replay to the dump's frames [firstFrame, lastFrame], inclusive.
+// Frames are delimited by DISPLAY commands in the dump.  Frames before
+// firstFrame are fast-forwarded: memory uploads and register state still
+// apply, but no draws are executed, so seeking deep into a long dump is
+// cheap.  lastFrame = -1 means through the end.  Sticky until changed,
+// which makes looping a single frame for benchmarking work - each replay
+// run re-seeks and re-executes just that frame.
+void SetFrameRange(int firstFrame, int lastFrame);
+
 };
@@ -18,10 +18,16 @@
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <snappy-c.h>
 #include "base/stringutil.h"
+#include "ext/xxhash.h"
+#include "thread/threadutil.h"
 #include "Common/Common.h"
 #include "Common/FileUtil.h"
 #include "Common/Log.h"
@@ -48,9 +54,15 @@ static std::function<void(const std::string &)> writeCallback;
 static std::vector<u8> pushbuf;
 static std::vector<Command> commands;
 static std::vector<u32> lastRegisters;
-static std::vector<u32> lastTextures;
 static std::set<u32> lastRenderTargets;
 
+// Hash of an emitted block -> offset in pushbuf.  Lets us dedupe repeated
+// textures/verts with a lookup instead of scanning the whole pushbuf.
+static std::unordered_map<u64, u32> pushbufHashes;
+
+// Serializes writes if a new capture finishes before the last one hit disk.
+static std::mutex writeMutex;
+
 static void FlushRegisters() {
 	if (!lastRegisters.empty()) {
 		Command last{CommandType::REGISTERS};
@@ -83,8 +95,8 @@ static std::string GenRecordingFilename() {
 static void BeginRecording() {
 	active = true;
 	nextFrame = false;
-	lastTextures.clear();
 	lastRenderTargets.clear();
+	pushbufHashes.clear();
 	flipLastAction = gpuStats.numFlips;
 
 	u32 ptr = (u32)pushbuf.size();
@@ -107,9 +119,7 @@ static void WriteCompressed(FILE *fp, const void *p, size_t sz) {
 	delete [] compressed;
 }
 
-static std::string WriteRecording() {
-	FlushRegisters();
-
+static std::string WriteRecording(const std::vector<Command> &commands, const std::vector<u8> &pushbuf) {
 	const std::string filename = GenRecordingFilename();
 
 	NOTICE_LOG(G3D, "Recording filename: %s", filename.c_str());
@@ -155,48 +165,18 @@ static void GetVertDataSizes(int vcount, const void *indices, u32 &vbytes, u32 &
 	}
 }
 
-static const u8 *mymemmem(const u8 *haystack, size_t hlen, const u8 *needle, size_t nlen) {
-	if (!nlen) {
-		return nullptr;
-	}
-
-	const u8 *last_possible = haystack + hlen - nlen;
-	int first = *needle;
-	const u8 *p = haystack;
-	while (p <= last_possible) {
-		p = (const u8 *)memchr(p, first, last_possible - p + 1);
-		if (!p) {
-			return nullptr;
-		}
-		if (!memcmp(p, needle, nlen)) {
-			return p;
-		}
-
-		p++;
-	}
-
-	return nullptr;
-}
-
 static Command EmitCommandWithRAM(CommandType t, const void *p, u32 sz) {
 	FlushRegisters();
 
 	Command cmd{t, sz, 0};
 
 	if (sz) {
-		// If at all possible, try to find it already in the buffer.
-		const u8 *prev = nullptr;
-		const size_t NEAR_WINDOW = std::max((int)sz * 2, 1024 * 10);
-		// Let's try nearby first... it will often be nearby.
-		if (pushbuf.size() > NEAR_WINDOW) {
-			prev = mymemmem(pushbuf.data() + pushbuf.size() - NEAR_WINDOW, NEAR_WINDOW, (const u8 *)p, sz);
-		}
-		if (!prev) {
-			prev = mymemmem(pushbuf.data(), pushbuf.size(), (const u8 *)p, sz);
-		}
-
-		if (prev) {
-			cmd.ptr = (u32)(prev - pushbuf.data());
+		// If we've already emitted this exact block, just point at it again.
+		// Hashing is linear in sz, unlike the buffer scan this used to do.
+		const u64 hash = XXH64(p, sz, sz);
+		auto iter = pushbufHashes.find(hash);
+		if (iter != pushbufHashes.end() && iter->second + sz <= pushbuf.size() && memcmp(pushbuf.data() + iter->second, p, sz) == 0) {
+			cmd.ptr = iter->second;
 		} else {
 			cmd.ptr = (u32)pushbuf.size();
 			int pad = 0;
@@ -209,6 +189,7 @@ static Command EmitCommandWithRAM(CommandType t, const void *p, u32 sz) {
 				memset(pushbuf.data() + cmd.ptr - pad, 0, pad);
 			}
 			memcpy(pushbuf.data() + cmd.ptr, p, sz);
+			pushbufHashes[hash] = cmd.ptr;
 		}
 	}
 
@@ -253,24 +234,8 @@ static void EmitTextureData(int level, u32 texaddr) {
 	}
 
 	if (bytes > 0) {
-		FlushRegisters();
-
-		// Dumps are huge - let's try to find this already emitted.
-		for (u32 prevptr : lastTextures) {
-			if (pushbuf.size() < prevptr + bytes) {
-				continue;
-			}
-
-			if (memcmp(pushbuf.data() + prevptr, p, bytes) == 0) {
-				commands.push_back({type, bytes, prevptr});
-				// Okay, that was easy.  Bail out.
-				return;
-			}
-		}
-
-		// Not there, gotta emit anew.
-		Command cmd = EmitCommandWithRAM(type, p, bytes);
-		lastTextures.push_back(cmd.ptr);
+		// Dumps are huge, but the pushbuf hash takes care of deduping repeats.
+		EmitCommandWithRAM(type, p, bytes);
 	}
 }
 
@@ -384,17 +349,31 @@ void SetCallback(const std::function<void(const std::string &)> callback) {
 }
 
 static void FinishRecording() {
-	// We're done - this was just to write the result out.
-	std::string filename = WriteRecording();
+	FlushRegisters();
+
+	// Hand the capture off to a worker - compressing and writing a large one
+	// takes long enough to hitch the GPU thread.
+	std::shared_ptr<std::vector<Command>> commandsCopy(new std::vector<Command>(std::move(commands)));
+	std::shared_ptr<std::vector<u8>> pushbufCopy(new std::vector<u8>(std::move(pushbuf)));
+	auto callback = writeCallback;
+
+	std::thread([commandsCopy, pushbufCopy, callback] {
+		setCurrentThreadName("GERecord");
+
+		std::lock_guard<std::mutex> guard(writeMutex);
+		std::string filename = WriteRecording(*commandsCopy, *pushbufCopy);
+
+		NOTICE_LOG(SYSTEM, "Recording finished");
+		if (callback)
+			callback(filename);
+	}).detach();
+
 	commands.clear();
 	pushbuf.clear();
+	pushbufHashes.clear();
 
-	NOTICE_LOG(SYSTEM, "Recording finished");
 	active = false;
 	flipLastAction = gpuStats.numFlips;
-
-	if (writeCallback)
-		writeCallback(filename);
 	writeCallback = nullptr;
 }
 
@@ -225,27 +225,56 @@ bool FramebufferManagerDX9::NotifyStencilUpload(u32 addr, int size, bool skipZer
 	shaderManagerDX9_->DirtyLastShader();
 	textureCacheDX9_->ForgetLastTexture();
 
-	for (int i = 1; i < values; i += i) {
-		if (!(usedBits & i)) {
-			// It's already zero, let's skip it.
-			continue;
+	// When multiple bits are in use but every non-zero pixel has the same value, we can
+	// replace the whole value in a single pass instead of looping over the bits.
+	u8 singleValue = 0;
+	if (usedBits & (usedBits - 1)) {
+		if (dstBuffer->format == GE_FORMAT_4444) {
+			singleValue = StencilSingleValue4444(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
+		} else if (dstBuffer->format == GE_FORMAT_8888) {
+			singleValue = StencilSingleValue8888(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
 		}
+	}
+
+	if (singleValue != 0) {
+		// The shader discards the zero pixels and the rest all get the reference value written.
+		dxstate.stencilMask.set(0xFF);
 		if (dstBuffer->format == GE_FORMAT_4444) {
-			dxstate.stencilMask.set(i | (i << 4));
-			const float f[4] = {i * (16.0f / 255.0f)};
-			device_->SetPixelShaderConstantF(CONST_PS_STENCILVALUE, f, 1);
-		} else if (dstBuffer->format == GE_FORMAT_5551) {
-			dxstate.stencilMask.set(0xFF);
-			const float f[4] = {i * (128.0f / 255.0f)};
+			dxstate.stencilFunc.set(D3DCMP_ALWAYS, (singleValue << 4) | singleValue, 0xFF);
+			const float f[4] = {singleValue * (16.0f / 255.0f)};
 			device_->SetPixelShaderConstantF(CONST_PS_STENCILVALUE, f, 1);
 		} else {
-			dxstate.stencilMask.set(i);
-			const float f[4] = {i * (1.0f / 255.0f)};
+			dxstate.stencilFunc.set(D3DCMP_ALWAYS, singleValue, 0xFF);
+			const float f[4] = {singleValue * (1.0f / 255.0f)};
 			device_->SetPixelShaderConstantF(CONST_PS_STENCILVALUE, f, 1);
 		}
 		HRESULT hr = device_->DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, coord, 5 * sizeof(float));
 		if (FAILED(hr)) {
-			ERROR_LOG_REPORT(G3D, "Failed to draw stencil bit %x: %08x", i, hr);
+			ERROR_LOG_REPORT(G3D, "Failed to draw stencil value %02x: %08x", singleValue, hr);
+		}
+	} else {
+		for (int i = 1; i < values; i += i) {
+			if (!(usedBits & i)) {
+				// It's already zero, let's skip it.
+				continue;
+			}
+			if (dstBuffer->format == GE_FORMAT_4444) {
+				dxstate.stencilMask.set(i | (i << 4));
+				const float f[4] = {i * (16.0f / 255.0f)};
+				device_->SetPixelShaderConstantF(CONST_PS_STENCILVALUE, f, 1);
+			} else if (dstBuffer->format == GE_FORMAT_5551) {
+				dxstate.stencilMask.set(0xFF);
+				const float f[4] = {i * (128.0f / 255.0f)};
+				device_->SetPixelShaderConstantF(CONST_PS_STENCILVALUE, f, 1);
+			} else {
+				dxstate.stencilMask.set(i);
+				const float f[4] = {i * (1.0f / 255.0f)};
+				device_->SetPixelShaderConstantF(CONST_PS_STENCILVALUE, f, 1);
+			}
+			HRESULT hr = device_->DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, coord, 5 * sizeof(float));
+			if (FAILED(hr)) {
+				ERROR_LOG_REPORT(G3D, "Failed to draw stencil bit %x: %08x", i, hr);
+			}
 		}
 	}
 	dxstate.stencilMask.set(0xFF);
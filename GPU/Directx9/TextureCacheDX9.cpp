@@ -424,32 +424,40 @@ void TextureCacheDX9::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFrame
 
 	if (pshader) {
 		const GEPaletteFormat clutFormat = gstate.getClutPaletteFormat();
-		LPDIRECT3DTEXTURE9 clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
 
-		Draw::Framebuffer *depalFBO = framebufferManagerDX9_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
-		draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
-		shaderManager_->DirtyLastShader();
+		bool needsDepalRender = true;
+		Draw::Framebuffer *depalFBO = GetDepalResultFBO(framebuffer, clutMode, &needsDepalRender);
+		if (!depalFBO) {
+			// Not cacheable, use the shared scratch FBO.
+			depalFBO = framebufferManagerDX9_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
+		}
+		if (needsDepalRender) {
+			LPDIRECT3DTEXTURE9 clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
+
+			draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
+			shaderManager_->DirtyLastShader();
 
-		float xoff = -0.5f / framebuffer->renderWidth;
-		float yoff = 0.5f / framebuffer->renderHeight;
+			float xoff = -0.5f / framebuffer->renderWidth;
+			float yoff = 0.5f / framebuffer->renderHeight;
 
-		TextureShaderApplierDX9 shaderApply(device_, pshader, pFramebufferVertexDecl, framebuffer->bufferWidth, framebuffer->bufferHeight, framebuffer->renderWidth, framebuffer->renderHeight, xoff, yoff);
-		shaderApply.ApplyBounds(gstate_c.vertBounds, gstate_c.curTextureXOffset, gstate_c.curTextureYOffset, xoff, yoff);
-		shaderApply.Use(depalShaderCache_->GetDepalettizeVertexShader());
+			TextureShaderApplierDX9 shaderApply(device_, pshader, pFramebufferVertexDecl, framebuffer->bufferWidth, framebuffer->bufferHeight, framebuffer->renderWidth, framebuffer->renderHeight, xoff, yoff);
+			shaderApply.ApplyBounds(gstate_c.vertBounds, gstate_c.curTextureXOffset, gstate_c.curTextureYOffset, xoff, yoff);
+			shaderApply.Use(depalShaderCache_->GetDepalettizeVertexShader());
 
-		device_->SetTexture(1, clutTexture);
-		device_->SetSamplerState(1, D3DSAMP_MINFILTER, D3DTEXF_POINT);
-		device_->SetSamplerState(1, D3DSAMP_MAGFILTER, D3DTEXF_POINT);
-		device_->SetSamplerState(1, D3DSAMP_MIPFILTER, D3DTEXF_NONE);
+			device_->SetTexture(1, clutTexture);
+			device_->SetSamplerState(1, D3DSAMP_MINFILTER, D3DTEXF_POINT);
+			device_->SetSamplerState(1, D3DSAMP_MAGFILTER, D3DTEXF_POINT);
+			device_->SetSamplerState(1, D3DSAMP_MIPFILTER, D3DTEXF_NONE);
 
-		framebufferManagerDX9_->BindFramebufferAsColorTexture(0, framebuffer, BINDFBCOLOR_SKIP_COPY | BINDFBCOLOR_FORCE_SELF);
-		device_->SetSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_POINT);
-		device_->SetSamplerState(0, D3DSAMP_MAGFILTER, D3DTEXF_POINT);
-		device_->SetSamplerState(0, D3DSAMP_MIPFILTER, D3DTEXF_NONE);
-		device_->SetSamplerState(0, D3DSAMP_MIPMAPLODBIAS, 0);
-		device_->SetSamplerState(0, D3DSAMP_MAXMIPLEVEL, 0);
+			framebufferManagerDX9_->BindFramebufferAsColorTexture(0, framebuffer, BINDFBCOLOR_SKIP_COPY | BINDFBCOLOR_FORCE_SELF);
+			device_->SetSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_POINT);
+			device_->SetSamplerState(0, D3DSAMP_MAGFILTER, D3DTEXF_POINT);
+			device_->SetSamplerState(0, D3DSAMP_MIPFILTER, D3DTEXF_NONE);
+			device_->SetSamplerState(0, D3DSAMP_MIPMAPLODBIAS, 0);
+			device_->SetSamplerState(0, D3DSAMP_MAXMIPLEVEL, 0);
 
-		shaderApply.Shade();
+			shaderApply.Shade();
+		}
 
 		draw_->BindFramebufferAsTexture(depalFBO, 0, Draw::FB_COLOR_BIT, 0);
 
@@ -21,6 +21,7 @@
 
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <map>
 
 #include "math/dataconv.h"
@@ -44,6 +45,7 @@
 #include "GPU/GPUState.h"
 #include "GPU/ge_constants.h"
 #include "GPU/Common/ShaderUniforms.h"
+#include "GPU/Common/TextureDecoder.h"
 #include "GPU/GLES/ShaderManagerGLES.h"
 #include "GPU/GLES/DrawEngineGLES.h"
 #include "GPU/GLES/FramebufferManagerGLES.h"
@@ -67,7 +69,7 @@ Shader::~Shader() {
 	render_->DeleteShader(shader);
 }
 
-LinkedShader::LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs, FShaderID FSID, Shader *fs, bool useHWTransform, bool preloading)
+LinkedShader::LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs, FShaderID FSID, Shader *fs, bool useHWTransform, bool preloading, GLenum binaryFormat, std::vector<uint8_t> binary)
 		: render_(render), useHWTransform_(useHWTransform) {
 	PROFILE_THIS_SCOPE("shaderlink");
 
@@ -178,7 +180,12 @@ LinkedShader::LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs,
 	initialize.push_back({ &u_tess_weights_u, 0, 5 });
 	initialize.push_back({ &u_tess_weights_v, 0, 6 });
 
-	program = render->CreateProgram(shaders, semantics, queries, initialize, gstate_c.featureFlags & GPU_SUPPORTS_DUALSOURCE_BLEND);
+	// Where the driver supports it, keep the program binary around so the shader disk cache
+	// can store it and skip the link next time. A cached binary passed in here gets tried
+	// first, with a regular source link as the fallback.
+	bool keepBinary = gl_extensions.ARB_get_program_binary;
+	program = render->CreateProgram(shaders, semantics, queries, initialize, gstate_c.featureFlags & GPU_SUPPORTS_DUALSOURCE_BLEND,
+		keepBinary, binaryFormat, std::move(binary));
 
 	// The rest, use the "dirty" mechanism.
 	dirtyUniforms = DIRTY_ALL_UNIFORMS;
@@ -818,27 +825,39 @@ std::string ShaderManagerGLES::DebugGetShaderString(std::string id, DebugShaderT
 
 // Shader pseudo-cache.
 //
-// We simply store the IDs of the shaders used during gameplay. On next startup of
+// We store the IDs of the shaders used during gameplay. On next startup of
 // the same game, we simply compile all the shaders from the start, so we don't have to
-// compile them on the fly later. Ideally we would store the actual compiled shaders
-// rather than just their IDs, but OpenGL does not support this, except for a few obscure
-// vendor-specific extensions.
+// compile them on the fly later. Additionally, where the driver supports
+// ARB_get_program_binary (or GLES 3.0, where it's core), we store the linked program
+// binaries too, which lets us skip the actual compile and link next time - but only as
+// long as the same driver produced them, so those are keyed on the driver as well.
 //
 // If things like GPU supported features have changed since the last time, we discard the cache
 // as sometimes these features might have an effect on the ID bits.
 
 #define CACHE_HEADER_MAGIC 0x83277592
-#define CACHE_VERSION 14
+#define CACHE_VERSION 15
 struct CacheHeader {
 	uint32_t magic;
 	uint32_t version;
 	uint32_t featureFlags;
-	uint32_t reserved;
+	uint32_t driverVersionHash;
 	int numVertexShaders;
 	int numFragmentShaders;
 	int numLinkedPrograms;
 };
 
+// No driver will hand us a program binary this large - this is only to cap corrupt files.
+static const uint32_t MAX_PROGRAM_BINARY_SIZE = 1024 * 1024;
+
+// Program binaries are only valid for the exact driver that produced them, so key them on
+// what we know about it. If this doesn't match, the shader IDs are still used - we just
+// drop the binaries and link from source again.
+static uint32_t ShaderCacheDriverHash() {
+	uint32_t hash = DoReliableHash32(gl_extensions.model, (uint32_t)strlen(gl_extensions.model), 0x3119667b);
+	return DoReliableHash32((const char *)gl_extensions.ver, sizeof(gl_extensions.ver), hash);
+}
+
 void ShaderManagerGLES::Load(const std::string &filename) {
 	File::IOFile f(filename, "rb");
 	u64 sz = f.GetSize();
@@ -862,13 +881,14 @@ void ShaderManagerGLES::Load(const std::string &filename) {
 		return;
 	}
 
-	// Also make sure the size makes sense, in case there's corruption.
+	// Also make sure the size makes sense, in case there's corruption. The program
+	// binaries are variable size, so this is just a minimum.
 	u64 expectedSize = sizeof(header);
 	expectedSize += header.numVertexShaders * sizeof(VShaderID);
 	expectedSize += header.numFragmentShaders * sizeof(FShaderID);
-	expectedSize += header.numLinkedPrograms * (sizeof(VShaderID) + sizeof(FShaderID));
-	if (sz != expectedSize) {
-		ERROR_LOG(G3D, "Shader cache file is wrong size: %lld instead of %lld", sz, expectedSize);
+	expectedSize += header.numLinkedPrograms * (sizeof(VShaderID) + sizeof(FShaderID) + 2 * sizeof(uint32_t));
+	if (sz < expectedSize) {
+		ERROR_LOG(G3D, "Shader cache file is too small: %lld, expected at least %lld", sz, expectedSize);
 		return;
 	}
 
@@ -885,16 +905,38 @@ void ShaderManagerGLES::Load(const std::string &filename) {
 		return;
 	}
 
+	// If the driver has changed since the cache was written, its program binaries are
+	// useless to us, but the IDs are still good - so just drop the binaries.
+	const bool binariesUsable = header.driverVersionHash == ShaderCacheDriverHash() && gl_extensions.ARB_get_program_binary;
 	for (int i = 0; i < header.numLinkedPrograms; i++) {
-		VShaderID vsid;
-		FShaderID fsid;
-		if (!f.ReadArray(&vsid, 1)) {
+		PendingLink link;
+		if (!f.ReadArray(&link.vsid, 1)) {
+			return;
+		}
+		if (!f.ReadArray(&link.fsid, 1)) {
+			return;
+		}
+		uint32_t binaryFormat, binarySize;
+		if (!f.ReadArray(&binaryFormat, 1) || !f.ReadArray(&binarySize, 1)) {
 			return;
 		}
-		if (!f.ReadArray(&fsid, 1)) {
+		if (binarySize > MAX_PROGRAM_BINARY_SIZE) {
+			ERROR_LOG(G3D, "Corrupt shader cache file (%u byte program binary), aborting.", binarySize);
+			diskCachePending_.Clear();
 			return;
 		}
-		diskCachePending_.link.push_back(std::make_pair(vsid, fsid));
+		if (binarySize != 0) {
+			link.binary.resize(binarySize);
+			if (!f.ReadArray(&link.binary[0], binarySize)) {
+				return;
+			}
+			if (binariesUsable) {
+				link.binaryFormat = (GLenum)binaryFormat;
+			} else {
+				link.binary.clear();
+			}
+		}
+		diskCachePending_.link.push_back(std::move(link));
 	}
 
 	// Actual compilation happens in ContinuePrecompile(), called by GPU_GLES's IsReady.
@@ -964,12 +1006,11 @@ bool ShaderManagerGLES::ContinuePrecompile(float sliceTime) {
 			return false;
 		}
 
-		const VShaderID &vsid = pending.link[i].first;
-		const FShaderID &fsid = pending.link[i].second;
-		Shader *vs = vsCache_.Get(vsid);
-		Shader *fs = fsCache_.Get(fsid);
+		PendingLink &link = pending.link[i];
+		Shader *vs = vsCache_.Get(link.vsid);
+		Shader *fs = fsCache_.Get(link.fsid);
 		if (vs && fs) {
-			LinkedShader *ls = new LinkedShader(render_, vsid, vs, fsid, fs, vs->UseHWTransform(), true);
+			LinkedShader *ls = new LinkedShader(render_, link.vsid, vs, link.fsid, fs, vs->UseHWTransform(), true, link.binaryFormat, std::move(link.binary));
 			LinkedShaderCacheEntry entry(vs, fs, ls);
 			linkedShaderCache_.push_back(entry);
 		}
@@ -1006,7 +1047,7 @@ void ShaderManagerGLES::Save(const std::string &filename) {
 	CacheHeader header;
 	header.magic = CACHE_HEADER_MAGIC;
 	header.version = CACHE_VERSION;
-	header.reserved = 0;
+	header.driverVersionHash = ShaderCacheDriverHash();
 	header.featureFlags = gstate_c.featureFlags;
 	header.numVertexShaders = GetNumVertexShaders();
 	header.numFragmentShaders = GetNumFragmentShaders();
@@ -1030,6 +1071,22 @@ void ShaderManagerGLES::Save(const std::string &filename) {
 		});
 		fwrite(&vsid, 1, sizeof(vsid), f);
 		fwrite(&fsid, 1, sizeof(fsid), f);
+
+		// Write the linked program's binary if the GL thread has harvested one.
+		// binaryValid_ is only ever set once, after binary_ is final, so this is safe
+		// to read here even while rendering continues.
+		uint32_t binaryFormat = 0;
+		uint32_t binarySize = 0;
+		const GLRProgram *program = iter.ls->program;
+		if (program->binaryValid_ && program->binary_.size() <= MAX_PROGRAM_BINARY_SIZE) {
+			binaryFormat = (uint32_t)program->binaryFormat_;
+			binarySize = (uint32_t)program->binary_.size();
+		}
+		fwrite(&binaryFormat, 1, sizeof(binaryFormat), f);
+		fwrite(&binarySize, 1, sizeof(binarySize), f);
+		if (binarySize != 0) {
+			fwrite(program->binary_.data(), 1, binarySize, f);
+		}
 	}
 	fclose(f);
 	diskCacheDirty_ = false;
@@ -44,7 +44,7 @@ enum {
 
 class LinkedShader {
 public:
-	LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs, FShaderID FSID, Shader *fs, bool useHWTransform, bool preloading = false);
+	LinkedShader(GLRenderManager *render, VShaderID VSID, Shader *vs, FShaderID FSID, Shader *fs, bool useHWTransform, bool preloading = false, GLenum binaryFormat = 0, std::vector<uint8_t> binary = std::vector<uint8_t>());
 	~LinkedShader();
 
 	void use(const ShaderID &VSID);
@@ -214,10 +214,18 @@ private:
 	VSCache vsCache_;
 
 	bool diskCacheDirty_;
+	struct PendingLink {
+		VShaderID vsid;
+		FShaderID fsid;
+		// Cached program binary from a previous run, if the driver gave us one.
+		GLenum binaryFormat = 0;
+		std::vector<uint8_t> binary;
+	};
+
 	struct {
 		std::vector<VShaderID> vert;
 		std::vector<FShaderID> frag;
-		std::vector<std::pair<VShaderID, FShaderID>> link;
+		std::vector<PendingLink> link;
 
 		size_t vertPos = 0;
 		size_t fragPos = 0;
@@ -189,22 +189,46 @@ bool FramebufferManagerGLES::NotifyStencilUpload(u32 addr, int size, bool skipZe
 	render_->BindProgram(stencilUploadProgram_);
 	render_->SetNoBlendAndMask(0x8);
 
-	for (int i = 1; i < values; i += i) {
-		if (!(usedBits & i)) {
-			// It's already zero, let's skip it.
-			continue;
+	// When multiple bits are in use but every non-zero pixel has the same value, we can
+	// replace the whole value in a single pass instead of looping over the bits.
+	u8 singleValue = 0;
+	if (usedBits & (usedBits - 1)) {
+		if (dstBuffer->format == GE_FORMAT_4444) {
+			singleValue = StencilSingleValue4444(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
+		} else if (dstBuffer->format == GE_FORMAT_8888) {
+			singleValue = StencilSingleValue8888(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
 		}
+	}
+
+	if (singleValue != 0) {
+		// The shader discards the zero pixels and keeps the rest, which all share singleValue.
 		if (dstBuffer->format == GE_FORMAT_4444) {
-			render_->SetStencilOp((i << 4) | i, GL_REPLACE, GL_REPLACE, GL_REPLACE);
-			render_->SetUniformF1(&u_stencilValue, i * (16.0f / 255.0f));
-		} else if (dstBuffer->format == GE_FORMAT_5551) {
-			render_->SetStencilOp(0xFF, GL_REPLACE, GL_REPLACE, GL_REPLACE);
-			render_->SetUniformF1(&u_stencilValue, i * (128.0f / 255.0f));
+			render_->SetStencilFunc(GL_TRUE, GL_ALWAYS, (singleValue << 4) | singleValue, 0xFF);
+			render_->SetUniformF1(&u_stencilValue, singleValue * (16.0f / 255.0f));
 		} else {
-			render_->SetStencilOp(i, GL_REPLACE, GL_REPLACE, GL_REPLACE);
-			render_->SetUniformF1(&u_stencilValue, i * (1.0f / 255.0f));
+			render_->SetStencilFunc(GL_TRUE, GL_ALWAYS, singleValue, 0xFF);
+			render_->SetUniformF1(&u_stencilValue, singleValue * (1.0f / 255.0f));
 		}
+		render_->SetStencilOp(0xFF, GL_REPLACE, GL_REPLACE, GL_REPLACE);
 		DrawActiveTexture(0, 0, dstBuffer->width, dstBuffer->height, dstBuffer->bufferWidth, dstBuffer->bufferHeight, 0.0f, 0.0f, u1, v1, ROTATION_LOCKED_HORIZONTAL, DRAWTEX_NEAREST | DRAWTEX_KEEP_STENCIL_ALPHA);
+	} else {
+		for (int i = 1; i < values; i += i) {
+			if (!(usedBits & i)) {
+				// It's already zero, let's skip it.
+				continue;
+			}
+			if (dstBuffer->format == GE_FORMAT_4444) {
+				render_->SetStencilOp((i << 4) | i, GL_REPLACE, GL_REPLACE, GL_REPLACE);
+				render_->SetUniformF1(&u_stencilValue, i * (16.0f / 255.0f));
+			} else if (dstBuffer->format == GE_FORMAT_5551) {
+				render_->SetStencilOp(0xFF, GL_REPLACE, GL_REPLACE, GL_REPLACE);
+				render_->SetUniformF1(&u_stencilValue, i * (128.0f / 255.0f));
+			} else {
+				render_->SetStencilOp(i, GL_REPLACE, GL_REPLACE, GL_REPLACE);
+				render_->SetUniformF1(&u_stencilValue, i * (1.0f / 255.0f));
+			}
+			DrawActiveTexture(0, 0, dstBuffer->width, dstBuffer->height, dstBuffer->bufferWidth, dstBuffer->bufferHeight, 0.0f, 0.0f, u1, v1, ROTATION_LOCKED_HORIZONTAL, DRAWTEX_NEAREST | DRAWTEX_KEEP_STENCIL_ALPHA);
+		}
 	}
 
 	if (useBlit) {
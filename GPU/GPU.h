@@ -57,6 +57,7 @@ struct GPUStatistics {
 	}
 	void ResetFrame() {
 		numDrawCalls = 0;
+		numCulledDraws = 0;
 		numCachedDrawCalls = 0;
 		numVertsSubmitted = 0;
 		numCachedVertsDrawn = 0;
@@ -78,6 +79,7 @@ struct GPUStatistics {
 
 	// Per frame statistics
 	int numDrawCalls;
+	int numCulledDraws;
 	int numCachedDrawCalls;
 	int numFlushes;
 	int numVertsSubmitted;
@@ -776,7 +776,20 @@ u32 GPUCommon::UpdateStall(int listid, u32 newstall) {
 		return SCE_KERNEL_ERROR_ALREADY;
 
 	dl.stall = newstall & 0x0FFFFFFF;
-	
+
+	// Games drip-feed the GE by bumping the stall hundreds of times a frame.
+	// Only reprocess the queue when the head list can actually make progress -
+	// if it's still stalled or paused, InterpretList would just run through its
+	// setup and bail.
+	const int next = GetNextListIndex();
+	if (next != -1) {
+		const DisplayList &head = dls[next];
+		const bool headBlocked = head.state == PSP_GE_DL_STATE_PAUSED ||
+			(head.started && head.stall != 0 && head.pc == head.stall);
+		if (headBlocked)
+			return 0;
+	}
+
 	ProcessDLQueue();
 
 	return 0;
@@ -986,37 +999,68 @@ void GPUCommon::FastRunLoop(DisplayList &list) {
 	PROFILE_THIS_SCOPE("gpuloop");
 	const CommandInfo *cmdInfo = cmdInfo_;
 	int dc = downcount;
-	for (; dc > 0; --dc) {
+	while (dc > 0) {
 		// We know that display list PCs have the upper nibble == 0 - no need to mask the pointer
-		const u32 op = *(const u32 *)(Memory::base + list.pc);
-		const u32 cmd = op >> 24;
-		const CommandInfo &info = cmdInfo[cmd];
-		const u32 diff = op ^ gstate.cmdmem[cmd];
+		u32 op = *(const u32 *)(Memory::base + list.pc);
+		u32 cmd = op >> 24;
+		const CommandInfo *info = &cmdInfo[cmd];
+		u32 diff = op ^ gstate.cmdmem[cmd];
+		uint64_t flags = info->flags;
+
+		if ((flags & (FLAG_EXECUTE | FLAG_EXECUTEONCHANGE)) == 0) {
+			// A run of plain state-setting commands - the common shape between draws.
+			// Write them back to back, accumulating the dirtying in a local, and only
+			// poke gstate_c once at the end of the run. Nothing in such a run can
+			// queue new draws, so at most one flush check is needed.
+			uint64_t dirty = 0;
+			bool checkFlush = drawEngineCommon_->GetNumDrawCalls() != 0;
+			do {
+				if (diff != 0) {
+					if (checkFlush && (flags & FLAG_FLUSHBEFOREONCHANGE)) {
+						// The flush still has to see what earlier commands dirtied.
+						if (dirty) {
+							gstate_c.Dirty(dirty);
+							dirty = 0;
+						}
+						drawEngineCommon_->DispatchFlush();
+						checkFlush = false;
+					}
+					gstate.cmdmem[cmd] = op;
+					dirty |= flags >> 8;
+				}
+				list.pc += 4;
+				if (--dc == 0)
+					break;
+				op = *(const u32 *)(Memory::base + list.pc);
+				cmd = op >> 24;
+				info = &cmdInfo[cmd];
+				diff = op ^ gstate.cmdmem[cmd];
+				flags = info->flags;
+			} while ((flags & (FLAG_EXECUTE | FLAG_EXECUTEONCHANGE)) == 0);
+			if (dirty)
+				gstate_c.Dirty(dirty);
+			continue;
+		}
+
 		if (diff == 0) {
-			if (info.flags & FLAG_EXECUTE) {
+			if (flags & FLAG_EXECUTE) {
 				downcount = dc;
-				(this->*info.func)(op, diff);
+				(this->*info->func)(op, diff);
 				dc = downcount;
 			}
 		} else {
-			uint64_t flags = info.flags;
 			if (flags & FLAG_FLUSHBEFOREONCHANGE) {
 				if (drawEngineCommon_->GetNumDrawCalls()) {
 					drawEngineCommon_->DispatchFlush();
 				}
 			}
 			gstate.cmdmem[cmd] = op;
-			if (flags & (FLAG_EXECUTE | FLAG_EXECUTEONCHANGE)) {
-				downcount = dc;
-				(this->*info.func)(op, diff);
-				dc = downcount;
-			} else {
-				uint64_t dirty = flags >> 8;
-				if (dirty)
-					gstate_c.Dirty(dirty);
-			}
+			downcount = dc;
+			(this->*info->func)(op, diff);
+			dc = downcount;
 		}
 		list.pc += 4;
+		--dc;
 	}
 	downcount = 0;
 }
@@ -1124,7 +1168,15 @@ int GPUCommon::GetNextListIndex() {
 	}
 }
 
+// Lists run synchronously on the emu thread, by design: games poll list state
+// and read back results (bounding box tests, RAM framebuffers) immediately
+// after sceGe calls, and CoreTiming charges the cycles as we go. A dedicated
+// GE thread was tried historically and removed - fencing guest memory at stall
+// boundaries cost more than the parallelism won.
 void GPUCommon::ProcessDLQueue() {
+	// Deliver CPU-write hints batched up since we last ran, before any draws.
+	FlushPendingInvalidations();
+
 	startingTicks = CoreTiming::GetTicks();
 	cyclesExecuted = 0;
 
@@ -2357,6 +2409,9 @@ struct DisplayList_v2 {
 };
 
 void GPUCommon::DoState(PointerWrap &p) {
+	// Settle batched invalidations rather than serializing them.
+	FlushPendingInvalidations();
+
 	auto s = p.Section("GPUCommon", 1, 4);
 	if (!s)
 		return;
@@ -2721,6 +2776,40 @@ bool GPUCommon::PerformMemoryUpload(u32 dest, int size) {
 }
 
 void GPUCommon::InvalidateCache(u32 addr, int size, GPUInvalidationType type) {
+	// A HINT invalidation just means "the CPU wrote here" - it only influences
+	// re-hash decisions the next time a texture is bound, and never touches
+	// framebuffers. So instead of walking the texture cache on every little
+	// memcpy (games doing scatter copies flood us with these), batch the ranges
+	// up and deliver them merged before the display list queue next runs.
+	if (type == GPU_INVALIDATE_HINT && size > 0) {
+		const u32 start = addr & 0x3FFFFFFF;
+		const u32 end = start + size;
+		if (!pendingInvalidations_.empty()) {
+			InvalidationRange &last = pendingInvalidations_.back();
+			if (start <= last.end && end >= last.start) {
+				last.start = std::min(last.start, start);
+				last.end = std::max(last.end, end);
+				return;
+			}
+		}
+		pendingInvalidations_.push_back(InvalidationRange{ start, end });
+		// Don't grow without bound - collapse to one conservative range. Over-
+		// invalidating is safe, it only means some textures get re-hashed.
+		if (pendingInvalidations_.size() > 512) {
+			InvalidationRange merged = pendingInvalidations_[0];
+			for (size_t i = 1; i < pendingInvalidations_.size(); ++i) {
+				merged.start = std::min(merged.start, pendingInvalidations_[i].start);
+				merged.end = std::max(merged.end, pendingInvalidations_[i].end);
+			}
+			pendingInvalidations_.clear();
+			pendingInvalidations_.push_back(merged);
+		}
+		return;
+	}
+
+	// Deliver any batched hints first so ordering against stronger types holds.
+	FlushPendingInvalidations();
+
 	if (size > 0)
 		textureCache_->Invalidate(addr, size, type);
 	else
@@ -2734,6 +2823,35 @@ void GPUCommon::InvalidateCache(u32 addr, int size, GPUInvalidationType type) {
 	}
 }
 
+void GPUCommon::FlushPendingInvalidations() {
+	if (pendingInvalidations_.empty())
+		return;
+
+	std::sort(pendingInvalidations_.begin(), pendingInvalidations_.end(),
+		[](const InvalidationRange &a, const InvalidationRange &b) {
+			return a.start < b.start;
+		});
+
+	// Merge overlapping and adjacent ranges, then do one cache walk per range.
+	size_t out = 0;
+	for (size_t i = 1; i < pendingInvalidations_.size(); ++i) {
+		InvalidationRange &prev = pendingInvalidations_[out];
+		const InvalidationRange &next = pendingInvalidations_[i];
+		if (next.start <= prev.end) {
+			prev.end = std::max(prev.end, next.end);
+		} else {
+			pendingInvalidations_[++out] = next;
+		}
+	}
+	pendingInvalidations_.resize(out + 1);
+
+	for (size_t i = 0; i < pendingInvalidations_.size(); ++i) {
+		const InvalidationRange &range = pendingInvalidations_[i];
+		textureCache_->Invalidate(range.start, range.end - range.start, GPU_INVALIDATE_HINT);
+	}
+	pendingInvalidations_.clear();
+}
+
 void GPUCommon::NotifyVideoUpload(u32 addr, int size, int width, int format) {
 	if (Memory::IsVRAMAddress(addr)) {
 		framebufferManager_->NotifyVideoUpload(addr, size, width, (GEBufferFormat)format);
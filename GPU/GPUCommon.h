@@ -290,6 +290,9 @@ protected:
 	// TODO: Unify this.
 	virtual void FinishDeferred() {}
 
+	// Batched CPU-write hints, see InvalidateCache().
+	void FlushPendingInvalidations();
+
 	void DoBlockTransfer(u32 skipDrawReason);
 	void DoExecuteCall(u32 target);
 
@@ -319,6 +322,14 @@ protected:
 
 	typedef std::list<int> DisplayListQueue;
 
+	// Texture invalidation hints accumulated since the display list queue last
+	// ran, merged where they touch. [start, end) in masked addresses.
+	struct InvalidationRange {
+		u32 start;
+		u32 end;
+	};
+	std::vector<InvalidationRange> pendingInvalidations_;
+
 	int nextListID;
 	DisplayList dls[DisplayListMaxCount];
 	DisplayList *currentList;
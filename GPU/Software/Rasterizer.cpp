@@ -16,6 +16,7 @@
 // https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 #include "base/basictypes.h"
@@ -840,15 +841,18 @@ static inline Vec3<int> AlphaBlendingResult(const Vec4<int> &source, const Vec4<
 	}
 }
 
-template <bool clearMode>
-inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<int> &color_in) {
+// Specialized on the per-pixel state bits that matter most so that the checks
+// compile away inside the inner loop. The remaining gstate queries are cheap
+// relative to the work they gate. Resolved once per draw via GetSingleFunc().
+template <bool clearMode, bool alphaTestEnabled, bool stencilTestEnabled, bool depthTestEnabled, bool alphaBlendEnabled>
+void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<int> &color_in) {
 	Vec4<int> prim_color = color_in.Clamp(0, 255);
 	// Depth range test - applied in clear mode, if not through mode.
 	if (!gstate.isModeThrough())
 		if (z < gstate.getDepthRangeMin() || z > gstate.getDepthRangeMax())
 			return;
 
-	if (gstate.isAlphaTestEnabled() && !clearMode)
+	if (alphaTestEnabled && !clearMode)
 		if (!AlphaTestPassed(prim_color.a()))
 			return;
 
@@ -867,25 +871,25 @@ inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<in
 
 	// In clear mode, it uses the alpha color as stencil.
 	u8 stencil = clearMode ? prim_color.a() : GetPixelStencil(p.x, p.y);
-	if (!clearMode && (gstate.isStencilTestEnabled() || gstate.isDepthTestEnabled())) {
-		if (gstate.isStencilTestEnabled() && !StencilTestPassed(stencil)) {
+	if (!clearMode && (stencilTestEnabled || depthTestEnabled)) {
+		if (stencilTestEnabled && !StencilTestPassed(stencil)) {
 			stencil = ApplyStencilOp(gstate.getStencilOpSFail(), stencil);
 			SetPixelStencil(p.x, p.y, stencil);
 			return;
 		}
 
 		// Also apply depth at the same time.  If disabled, same as passing.
-		if (gstate.isDepthTestEnabled() && !DepthTestPassed(p.x, p.y, z)) {
-			if (gstate.isStencilTestEnabled()) {
+		if (depthTestEnabled && !DepthTestPassed(p.x, p.y, z)) {
+			if (stencilTestEnabled) {
 				stencil = ApplyStencilOp(gstate.getStencilOpZFail(), stencil);
 				SetPixelStencil(p.x, p.y, stencil);
 			}
 			return;
-		} else if (gstate.isStencilTestEnabled()) {
+		} else if (stencilTestEnabled) {
 			stencil = ApplyStencilOp(gstate.getStencilOpZPass(), stencil);
 		}
 
-		if (gstate.isDepthTestEnabled() && gstate.isDepthWriteEnabled()) {
+		if (depthTestEnabled && gstate.isDepthWriteEnabled()) {
 			SetPixelDepth(p.x, p.y, z);
 		}
 	} else if (clearMode && gstate.isClearModeDepthMask()) {
@@ -897,7 +901,7 @@ inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<in
 
 	// Dithering happens before the logic op and regardless of framebuffer format or clear mode.
 	// We do it while alpha blending because it happens before clamping.
-	if (gstate.isAlphaBlendEnabled() && !clearMode) {
+	if (alphaBlendEnabled && !clearMode) {
 		const Vec4<int> dst = Vec4<int>::FromRGBA(old_color);
 		Vec3<int> blended = AlphaBlendingResult(prim_color, dst);
 		if (gstate.isDitherEnabled()) {
@@ -935,6 +939,45 @@ inline void DrawSinglePixel(const DrawingCoords &p, u16 z, u8 fog, const Vec4<in
 	SetPixelColor(p.x, p.y, new_color);
 }
 
+typedef void (*SingleFunc)(const DrawingCoords &p, u16 z, u8 fog, const Vec4<int> &color_in);
+
+template <bool clearMode>
+static SingleFunc GetSingleFunc() {
+	if (clearMode) {
+		// All the specialized tests are skipped in clear mode anyway.
+		return &DrawSinglePixel<true, false, false, false, false>;
+	}
+
+	// Indexed by alphaTest << 3 | stencilTest << 2 | depthTest << 1 | alphaBlend.
+	static const SingleFunc singleFuncs[16] = {
+		&DrawSinglePixel<false, false, false, false, false>,
+		&DrawSinglePixel<false, false, false, false, true>,
+		&DrawSinglePixel<false, false, false, true, false>,
+		&DrawSinglePixel<false, false, false, true, true>,
+		&DrawSinglePixel<false, false, true, false, false>,
+		&DrawSinglePixel<false, false, true, false, true>,
+		&DrawSinglePixel<false, false, true, true, false>,
+		&DrawSinglePixel<false, false, true, true, true>,
+		&DrawSinglePixel<false, true, false, false, false>,
+		&DrawSinglePixel<false, true, false, false, true>,
+		&DrawSinglePixel<false, true, false, true, false>,
+		&DrawSinglePixel<false, true, false, true, true>,
+		&DrawSinglePixel<false, true, true, false, false>,
+		&DrawSinglePixel<false, true, true, false, true>,
+		&DrawSinglePixel<false, true, true, true, false>,
+		&DrawSinglePixel<false, true, true, true, true>,
+	};
+
+	int index = gstate.isAlphaBlendEnabled() ? 1 : 0;
+	if (gstate.isDepthTestEnabled())
+		index |= 2;
+	if (gstate.isStencilTestEnabled())
+		index |= 4;
+	if (gstate.isAlphaTestEnabled())
+		index |= 8;
+	return singleFuncs[index];
+}
+
 static inline void ApplyTexturing(Sampler::Funcs sampler, Vec4<int> &prim_color, float s, float t, int texlevel, int frac_texlevel, bool bilinear, u8 *texptr[], int texbufw[]) {
 	int u[8] = {0}, v[8] = {0};   // 1.23.8 fixed point
 	int frac_u[2], frac_v[2];
@@ -1159,6 +1202,8 @@ void DrawTriangleSlice(
 		}
 	}
 
+	const SingleFunc drawPixel = GetSingleFunc<clearMode>();
+
 	TriangleEdge e0;
 	TriangleEdge e1;
 	TriangleEdge e2;
@@ -1280,13 +1325,36 @@ void DrawTriangleSlice(
 					subp.x = p.x + (i & 1);
 					subp.y = p.y + (i / 2);
 
-					DrawSinglePixel<clearMode>(subp, (u16)z[i], fog[i], prim_color[i]);
+					drawPixel(subp, (u16)z[i], fog[i], prim_color[i]);
 				}
 			}
 		}
 	}
 }
 
+// Runs the slices of a triangle across the thread pool in small chunks that
+// the workers pull from a shared counter. Triangle coverage varies a lot
+// across the bounding box, so the static even split ParallelLoop would do
+// leaves most cores idle behind whichever one got the dense strip.
+template <bool clearMode>
+static void DrawTriangleSlices(
+	const VertexData& v0, const VertexData& v1, const VertexData& v2,
+	int minX, int minY, int maxX, int maxY, bool byY, int range)
+{
+	const int chunkSlices = 4;  // 8 pixels along the sliced axis per chunk.
+	const int numChunks = (range + chunkSlices - 1) / chunkSlices;
+	std::atomic<int> nextChunk(0);
+	auto bound = [&](int a, int b) -> void {
+		// The static range is ignored; chunks are claimed dynamically.
+		int chunk;
+		while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < numChunks) {
+			const int start = chunk * chunkSlices;
+			DrawTriangleSlice<clearMode>(v0, v1, v2, minX, minY, maxX, maxY, byY, start, start + chunkSlices);
+		}
+	};
+	GlobalThreadPool::Loop(bound, 0, numChunks);
+}
+
 // Draws triangle, vertices specified in counter-clockwise direction
 void DrawTriangle(const VertexData& v0, const VertexData& v1, const VertexData& v2)
 {
@@ -1315,29 +1383,15 @@ void DrawTriangle(const VertexData& v0, const VertexData& v1, const VertexData&
 	// 32 because we do two pixels at once, and we don't want overlap.
 	int rangeY = (maxY - minY) / 32 + 1;
 	int rangeX = (maxX - minX) / 32 + 1;
-	if (rangeY >= 12 && rangeX >= rangeY * 4) {
+	if (rangeX >= 12 || rangeY >= 12) {
+		// Slice along the longer axis (Y unless the triangle is much wider than
+		// tall, as columns walk the buffer less linearly.)
+		bool byY = rangeX < rangeY * 4;
+		int range = byY ? rangeY : rangeX;
 		if (gstate.isModeClear()) {
-			auto bound = [&](int a, int b) -> void {
-				DrawTriangleSlice<true>(v0, v1, v2, minX, minY, maxX, maxY, false, a, b);
-			};
-			GlobalThreadPool::Loop(bound, 0, rangeX);
+			DrawTriangleSlices<true>(v0, v1, v2, minX, minY, maxX, maxY, byY, range);
 		} else {
-			auto bound = [&](int a, int b) -> void {
-				DrawTriangleSlice<false>(v0, v1, v2, minX, minY, maxX, maxY, false, a, b);
-			};
-			GlobalThreadPool::Loop(bound, 0, rangeX);
-		}
-	} else if (rangeY >= 12 && rangeX >= 12) {
-		if (gstate.isModeClear()) {
-			auto bound = [&](int a, int b) -> void {
-				DrawTriangleSlice<true>(v0, v1, v2, minX, minY, maxX, maxY, true, a, b);
-			};
-			GlobalThreadPool::Loop(bound, 0, rangeY);
-		} else {
-			auto bound = [&](int a, int b) -> void {
-				DrawTriangleSlice<false>(v0, v1, v2, minX, minY, maxX, maxY, true, a, b);
-			};
-			GlobalThreadPool::Loop(bound, 0, rangeY);
+			DrawTriangleSlices<false>(v0, v1, v2, minX, minY, maxX, maxY, byY, range);
 		}
 	} else {
 		if (gstate.isModeClear()) {
@@ -1417,11 +1471,8 @@ void DrawPoint(const VertexData &v0)
 		fog = ClampFogDepth(v0.fogdepth);
 	}
 
-	if (clearMode) {
-		DrawSinglePixel<true>(p, z, fog, prim_color);
-	} else {
-		DrawSinglePixel<false>(p, z, fog, prim_color);
-	}
+	SingleFunc drawPixel = clearMode ? GetSingleFunc<true>() : GetSingleFunc<false>();
+	drawPixel(p, z, fog, prim_color);
 }
 
 void ClearRectangle(const VertexData &v0, const VertexData &v1)
@@ -1596,6 +1647,7 @@ void DrawLine(const VertexData &v0, const VertexData &v1)
 	}
 
 	Sampler::Funcs sampler = Sampler::GetFuncs();
+	const SingleFunc drawPixel = clearMode ? GetSingleFunc<true>() : GetSingleFunc<false>();
 
 	float x = a.x > b.x ? a.x - 1 : a.x;
 	float y = a.y > b.y ? a.y - 1 : a.y;
@@ -1670,11 +1722,7 @@ void DrawLine(const VertexData &v0, const VertexData &v1)
 			ScreenCoords pprime = ScreenCoords((int)x, (int)y, (int)z);
 
 			DrawingCoords p = TransformUnit::ScreenToDrawing(pprime);
-			if (clearMode) {
-				DrawSinglePixel<true>(p, z, fog, prim_color);
-			} else {
-				DrawSinglePixel<false>(p, z, fog, prim_color);
-			}
+			drawPixel(p, z, fog, prim_color);
 		}
 
 		x += xinc;
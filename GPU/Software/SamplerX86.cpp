@@ -100,26 +100,13 @@ LinearFunc SamplerJitCache::CompileLinear(const SamplerID &id) {
 	_assert_msg_(G3D, id.linear, "Linear should be set on sampler id");
 	BeginWrite();
 
-	// We'll first write the nearest sampler, which we will CALL.
-	// This may differ slightly based on the "linear" flag.
-	const u8 *nearest = AlignCode16();
-
-	if (!Jit_ReadTextureFormat(id)) {
-		EndWrite();
-		SetCodePtr(const_cast<u8 *>(nearest));
-		return nullptr;
-	}
-
-	RET();
-
-	// Now the actual linear func, which is exposed externally.
 	const u8 *start = AlignCode16();
 
 	// NOTE: This doesn't use the general register mapping.
 	// POSIX: arg1=uptr, arg2=vptr, arg3=frac_u, arg4=frac_v, arg5=src, arg6=bufw, stack+8=level
 	// Win64: arg1=uptr, arg2=vptr, arg3=frac_u, arg4=frac_v, stack+40=src, stack+48=bufw, stack+56=level
 	//
-	// We map these to nearest CALLs, with order: u, v, src, bufw, level
+	// The nearest fetch is emitted inline four times, in the same order as its args: u, v, src, bufw, level.
 
 	// Let's start by saving a bunch of registers.
 	PUSH(R15);
@@ -129,8 +116,7 @@ LinearFunc SamplerJitCache::CompileLinear(const SamplerID &id) {
 	// Won't need frac_u/frac_v for a while.
 	PUSH(arg4Reg);
 	PUSH(arg3Reg);
-	// Extra space to restore alignment and save resultReg for lerp.
-	// TODO: Maybe use XMMs instead?
+	// Extra space to keep the level argument's stack offset stable.
 	SUB(64, R(RSP), Imm8(24));
 
 	MOV(64, R(R12), R(arg1Reg));
@@ -160,38 +146,40 @@ LinearFunc SamplerJitCache::CompileLinear(const SamplerID &id) {
 	// At this point:
 	// R12=uptr, R13=vptr, stack+24=frac_u, stack+32=frac_v, R14=src, R15=bufw, stack+X=level
 
-	auto doNearestCall = [&](int off) {
+	// Fetch each of the four texels inline.  The fetch body only uses GPRs, so we
+	// can catch each result straight in an XMM instead of bouncing it through the
+	// stack like the old CALL-based version did.
+	auto doNearestFetch = [&](X64Reg dest, int off) {
 		MOV(32, R(uReg), MDisp(R12, off));
 		MOV(32, R(vReg), MDisp(R13, off));
 		MOV(64, R(srcReg), R(R14));
 		MOV(32, R(bufwReg), R(R15));
 		// Leave level, we just always load from RAM.  Separate CLUTs is uncommon.
 
-		CALL(nearest);
-		MOV(32, MDisp(RSP, off), R(resultReg));
+		if (!Jit_ReadTextureFormat(id))
+			return false;
+		MOVD_xmm(dest, R(resultReg));
+		return true;
 	};
 
-	doNearestCall(0);
-	doNearestCall(4);
-	doNearestCall(8);
-	doNearestCall(12);
-
-	// Convert TL, TR, BL, BR to floats for easier blending.
-	if (!cpu_info.bSSE4_1) {
-		PXOR(XMM0, R(XMM0));
+	bool success = doNearestFetch(fpScratchReg1, 0);
+	success = success && doNearestFetch(fpScratchReg2, 4);
+	success = success && doNearestFetch(fpScratchReg3, 8);
+	success = success && doNearestFetch(fpScratchReg4, 12);
+	if (!success) {
+		EndWrite();
+		SetCodePtr(const_cast<u8 *>(start));
+		return nullptr;
 	}
 
-	MOVD_xmm(fpScratchReg1, MDisp(RSP, 0));
-	MOVD_xmm(fpScratchReg2, MDisp(RSP, 4));
-	MOVD_xmm(fpScratchReg3, MDisp(RSP, 8));
-	MOVD_xmm(fpScratchReg4, MDisp(RSP, 12));
-
+	// Convert TL, TR, BL, BR to floats for easier blending.
 	if (cpu_info.bSSE4_1) {
 		PMOVZXBD(fpScratchReg1, R(fpScratchReg1));
 		PMOVZXBD(fpScratchReg2, R(fpScratchReg2));
 		PMOVZXBD(fpScratchReg3, R(fpScratchReg3));
 		PMOVZXBD(fpScratchReg4, R(fpScratchReg4));
 	} else {
+		PXOR(XMM0, R(XMM0));
 		PUNPCKLBW(fpScratchReg1, R(XMM0));
 		PUNPCKLBW(fpScratchReg2, R(XMM0));
 		PUNPCKLBW(fpScratchReg3, R(XMM0));
@@ -639,13 +627,13 @@ bool SamplerJitCache::Jit_ReadClutColor(const SamplerID &id) {
 	if (!id.useSharedClut) {
 		// TODO: Need to load from RAM, always.
 		if (id.linear) {
+			// We emit this inline inside CompileLinear(), so the linear func's
+			// stack frame (see its prologue) is what's live here.
 #ifdef _WIN32
 			const int argOffset = 24 + 48 + 8 + 32;
-			// Extra 8 to account for CALL.
-			MOV(32, R(tempReg2), MDisp(RSP, argOffset + 16 + 8));
+			MOV(32, R(tempReg2), MDisp(RSP, argOffset + 16));
 #else
-			// Extra 8 to account for CALL.
-			MOV(32, R(tempReg2), MDisp(RSP, 24 + 48 + 8 + 8));
+			MOV(32, R(tempReg2), MDisp(RSP, 24 + 48 + 8));
 #endif
 			LEA(32, tempReg2, MScaled(tempReg2, SCALE_4, 0));
 		} else {
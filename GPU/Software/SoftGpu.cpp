@@ -153,11 +153,6 @@ void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 	float u0 = 0.0f;
 	float u1;
 
-	if (fbTex) {
-		fbTex->Release();
-		fbTex = nullptr;
-	}
-
 	// For accuracy, try to handle 0 stride - sometimes used.
 	if (displayStride_ == 0) {
 		srcheight = 1;
@@ -170,6 +165,7 @@ void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 	desc.mipLevels = 1;
 	desc.tag = "SoftGPU";
 	bool hasImage = true;
+	bool texDirty = true;
 	if (!Memory::IsValidAddress(displayFramebuf_) || srcwidth == 0 || srcheight == 0) {
 		hasImage = false;
 		u1 = 1.0f;
@@ -179,6 +175,8 @@ void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 		desc.height = srcheight;
 		desc.initData.push_back(data);
 		desc.format = Draw::DataFormat::R8G8B8A8_UNORM;
+		// fbTex won't hold converted 16-bit data anymore.
+		fbTexSrcFormat_ = GE_FORMAT_INVALID;
 		if (displayStride_ != 0) {
 			u1 = (float)srcwidth / displayStride_;
 		} else {
@@ -189,10 +187,24 @@ void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 		fbTexBuffer.resize(srcwidth * srcheight);
 		FormatBuffer displayBuffer;
 		displayBuffer.data = Memory::GetPointer(displayFramebuf_);
+
+		// Visual-novel-class games leave most of the display untouched from frame to
+		// frame. We keep the lines we last converted around, and any line that still
+		// matches RAM can skip the conversion - if all of them do, the old texture is
+		// still good and we skip the re-upload entirely.
+		const bool cacheValid = fbTexSrcAddr_ == displayFramebuf_ && fbTexSrcStride_ == displayStride_ &&
+			fbTexSrcFormat_ == displayFormat_ && fbTexSource_.size() == (size_t)(srcwidth * srcheight);
+		fbTexSource_.resize(srcwidth * srcheight);
+		bool anyDirty = !cacheValid;
 		for (int y = 0; y < srcheight; ++y) {
-			u32 *buf_line = &fbTexBuffer[y * srcwidth];
 			const u16 *fb_line = &displayBuffer.as16[y * displayStride_];
+			u16 *cache_line = &fbTexSource_[y * srcwidth];
+			if (cacheValid && memcmp(cache_line, fb_line, srcwidth * sizeof(u16)) == 0)
+				continue;
+			memcpy(cache_line, fb_line, srcwidth * sizeof(u16));
+			anyDirty = true;
 
+			u32 *buf_line = &fbTexBuffer[y * srcwidth];
 			switch (displayFormat_) {
 			case GE_FORMAT_565:
 				ConvertRGBA565ToRGBA8888(buf_line, fb_line, srcwidth);
@@ -210,6 +222,10 @@ void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 				ERROR_LOG_REPORT(G3D, "Software: Unexpected framebuffer format: %d", displayFormat_);
 			}
 		}
+		fbTexSrcAddr_ = displayFramebuf_;
+		fbTexSrcStride_ = displayStride_;
+		fbTexSrcFormat_ = displayFormat_;
+		texDirty = anyDirty || !fbTex;
 
 		desc.width = srcwidth;
 		desc.height = srcheight;
@@ -217,11 +233,21 @@ void SoftGPU::CopyToCurrentFboFromDisplayRam(int srcwidth, int srcheight) {
 		u1 = 1.0f;
 	}
 	if (!hasImage) {
+		if (fbTex) {
+			fbTex->Release();
+			fbTex = nullptr;
+		}
 		draw_->BindFramebufferAsRenderTarget(nullptr, { Draw::RPAction::CLEAR, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
 		return;
 	}
 
-	fbTex = draw_->CreateTexture(desc);
+	if (texDirty) {
+		if (fbTex) {
+			fbTex->Release();
+			fbTex = nullptr;
+		}
+		fbTex = draw_->CreateTexture(desc);
+	}
 
 	float dstwidth = (float)PSP_CoreParameter().pixelWidth;
 	float dstheight = (float)PSP_CoreParameter().pixelHeight;
@@ -110,6 +110,13 @@ private:
 	Draw::Pipeline *texColor;
 	std::vector<u32> fbTexBuffer;
 
+	// Copy of the 16-bit display RAM lines fbTexBuffer was last converted from,
+	// so unchanged lines (and whole frames) can skip conversion and re-upload.
+	std::vector<u16> fbTexSource_;
+	u32 fbTexSrcAddr_ = 0;
+	u32 fbTexSrcStride_ = 0;
+	GEBufferFormat fbTexSrcFormat_ = GE_FORMAT_INVALID;
+
 	Draw::SamplerState *samplerNearest = nullptr;
 	Draw::SamplerState *samplerLinear = nullptr;
 	Draw::Buffer *vdata = nullptr;
@@ -319,6 +319,43 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 
 	VertexReader vreader(buf, vtxfmt, vertex_type);
 
+	// Post-transform reuse cache for indexed draws, like the hardware vertex cache.
+	// Direct-mapped on the low index bits - as good as a FIFO for the strip-ordered
+	// meshes games submit, and much cheaper to look up. Entries are only valid within
+	// this call since render state may change between calls, hence the generation tag.
+	struct CachedVertex {
+		u32 index;
+		u32 generation;
+		bool outsideRange;
+		VertexData v;
+	};
+	enum { VTX_CACHE_SIZE = 32 };
+	static CachedVertex vtxCache[VTX_CACHE_SIZE];
+	static u32 cacheGeneration = 0;
+	++cacheGeneration;
+
+	auto readVertexCached = [&](int vtx) -> VertexData {
+		if (!indices) {
+			vreader.Goto(vtx);
+			return ReadVertex(vreader);
+		}
+		const u32 idx = ConvertIndex(vtx);
+		CachedVertex &entry = vtxCache[idx & (VTX_CACHE_SIZE - 1)];
+		if (entry.generation == cacheGeneration && entry.index == idx) {
+			// outside_range_flag is always false when we get here (the callers reset
+			// it after each read), so only the set case needs replaying.
+			if (entry.outsideRange)
+				outside_range_flag = true;
+			return entry.v;
+		}
+		vreader.Goto(idx - index_lower_bound);
+		entry.v = ReadVertex(vreader);
+		entry.index = idx;
+		entry.generation = cacheGeneration;
+		entry.outsideRange = outside_range_flag;
+		return entry.v;
+	};
+
 	const int max_vtcs_per_prim = 3;
 	static VertexData data[max_vtcs_per_prim];
 	// This is the index of the next vert in data (or higher, may need modulus.)
@@ -351,13 +388,7 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 	case GE_PRIM_RECTANGLES:
 		{
 			for (int vtx = 0; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
-
-				data[data_index++] = ReadVertex(vreader);
+				data[data_index++] = readVertexCached(vtx);
 				if (data_index < vtcs_per_prim) {
 					// Keep reading.  Note: an incomplete prim will stay read for GE_PRIM_KEEP_PREVIOUS.
 					continue;
@@ -410,13 +441,7 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 			// If data_index is 1 or 2, etc., it means we're continuing a line strip.
 			int skip_count = data_index == 0 ? 1 : 0;
 			for (int vtx = 0; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
-
-				data[(data_index++) & 1] = ReadVertex(vreader);
+				data[(data_index++) & 1] = readVertexCached(vtx);
 				if (outside_range_flag) {
 					// Drop all primitives containing the current vertex
 					skip_count = 2;
@@ -440,14 +465,8 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 			int skip_count = data_index >= 2 ? 0 : 2 - data_index;
 
 			for (int vtx = 0; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
-
 				int provoking_index = (data_index++) % 3;
-				data[provoking_index] = ReadVertex(vreader);
+				data[provoking_index] = readVertexCached(vtx);
 				if (outside_range_flag) {
 					// Drop all primitives containing the current vertex
 					skip_count = 2;
@@ -483,25 +502,14 @@ void TransformUnit::SubmitPrimitive(void* vertices, void* indices, GEPrimitiveTy
 
 			// Only read the central vertex if we're not continuing.
 			if (data_index == 0) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(0) - index_lower_bound);
-				} else {
-					vreader.Goto(0);
-				}
-				data[0] = ReadVertex(vreader);
+				data[0] = readVertexCached(0);
 				data_index++;
 				start_vtx = 1;
 			}
 
 			for (int vtx = start_vtx; vtx < vertex_count; ++vtx) {
-				if (indices) {
-					vreader.Goto(ConvertIndex(vtx) - index_lower_bound);
-				} else {
-					vreader.Goto(vtx);
-				}
-
 				int provoking_index = 2 - ((data_index++) % 2);
-				data[provoking_index] = ReadVertex(vreader);
+				data[provoking_index] = readVertexCached(vtx);
 				if (outside_range_flag) {
 					// Drop all primitives containing the current vertex
 					skip_count = 2;
@@ -1037,13 +1037,22 @@ void TessellationDataTransferVulkan::SendDataToShader(const SimpleVertex *const
 
 	using Spline::Weight;
 
+	// Weights change rarely - most patches in a frame share tess factors - so
+	// reuse the copy already in the push buffer when we can.
+
 	// Weights U
-	data = (uint8_t *)push_->PushAligned(weights.size_u * sizeof(Weight), (uint32_t *)&bufInfo_[1].offset, &bufInfo_[1].buffer, ssboAlignment);
-	memcpy(data, weights.u, weights.size_u * sizeof(Weight));
-	bufInfo_[1].range = weights.size_u * sizeof(Weight);
+	if (lastWeightsU_ != weights.u) {
+		lastWeightsU_ = weights.u;
+		data = (uint8_t *)push_->PushAligned(weights.size_u * sizeof(Weight), (uint32_t *)&bufInfo_[1].offset, &bufInfo_[1].buffer, ssboAlignment);
+		memcpy(data, weights.u, weights.size_u * sizeof(Weight));
+		bufInfo_[1].range = weights.size_u * sizeof(Weight);
+	}
 
 	// Weights V
-	data = (uint8_t *)push_->PushAligned(weights.size_v * sizeof(Weight), (uint32_t *)&bufInfo_[2].offset, &bufInfo_[2].buffer, ssboAlignment);
-	memcpy(data, weights.v, weights.size_v * sizeof(Weight));
-	bufInfo_[2].range = weights.size_v * sizeof(Weight);
+	if (lastWeightsV_ != weights.v) {
+		lastWeightsV_ = weights.v;
+		data = (uint8_t *)push_->PushAligned(weights.size_v * sizeof(Weight), (uint32_t *)&bufInfo_[2].offset, &bufInfo_[2].buffer, ssboAlignment);
+		memcpy(data, weights.v, weights.size_v * sizeof(Weight));
+		bufInfo_[2].range = weights.size_v * sizeof(Weight);
+	}
 }
@@ -121,7 +121,12 @@ class TessellationDataTransferVulkan : public TessellationDataTransfer  {
 public:
 	TessellationDataTransferVulkan(VulkanContext *vulkan) : vulkan_(vulkan) {}
 
-	void SetPushBuffer(VulkanPushBuffer *push) { push_ = push; }
+	void SetPushBuffer(VulkanPushBuffer *push) {
+		push_ = push;
+		// The push buffer restarts each frame, so the cached weight uploads die with it.
+		lastWeightsU_ = nullptr;
+		lastWeightsV_ = nullptr;
+	}
 	// Send spline/bezier's control points and weights to vertex shader through structured shader buffer.
 	void SendDataToShader(const SimpleVertex *const *points, int size_u, int size_v, u32 vertType, const Spline::Weight2D &weights) override;
 	const VkDescriptorBufferInfo *GetBufferInfo() { return bufInfo_; }
@@ -129,6 +134,9 @@ private:
 	VulkanContext *vulkan_;
 	VulkanPushBuffer *push_;  // Updated each frame.
 	VkDescriptorBufferInfo bufInfo_[3]{};
+	// Weight arrays already pushed this frame; they come from the spline weight
+	// cache, which lives until engine shutdown, so the pointer identifies them.
+	const void *lastWeightsU_ = nullptr, *lastWeightsV_ = nullptr;
 };
 
 // Handles transform, lighting and drawing.
@@ -81,6 +81,27 @@ void main() {
 }
 )";
 
+// Vertex-less full screen triangle plus constant zero output, used to clear the
+// alpha channel in ReformatFramebufferFrom (color writes are masked to alpha there).
+static const char reformat_vs[] = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+out gl_PerVertex { vec4 gl_Position; };
+void main() {
+  vec2 pos = vec2((gl_VertexIndex == 2) ? 2.0 : 0.0, (gl_VertexIndex == 1) ? 2.0 : 0.0);
+  gl_Position = vec4(pos * vec2(2.0, 2.0) + vec2(-1.0, -1.0), 0.0, 1.0);
+}
+)";
+
+static const char reformat_fs[] = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+layout (location = 0) out vec4 fragColor0;
+void main() {
+  fragColor0 = vec4(0.0);
+}
+)";
+
 FramebufferManagerVulkan::FramebufferManagerVulkan(Draw::DrawContext *draw, VulkanContext *vulkan) :
 	FramebufferManagerCommon(draw),
 	vulkan_(vulkan) {
@@ -145,6 +166,14 @@ void FramebufferManagerVulkan::DestroyDeviceObjects() {
 		vulkan_->Delete().QueueDeleteShaderModule(stencilFs_);
 	if (stencilVs_ != VK_NULL_HANDLE)
 		vulkan_->Delete().QueueDeleteShaderModule(stencilVs_);
+	if (reformatFs_ != VK_NULL_HANDLE) {
+		vulkan_->Delete().QueueDeleteShaderModule(reformatFs_);
+		reformatFs_ = VK_NULL_HANDLE;
+	}
+	if (reformatVs_ != VK_NULL_HANDLE) {
+		vulkan_->Delete().QueueDeleteShaderModule(reformatVs_);
+		reformatVs_ = VK_NULL_HANDLE;
+	}
 
 	if (linearSampler_ != VK_NULL_HANDLE)
 		vulkan_->Delete().QueueDeleteSampler(linearSampler_);
@@ -187,22 +216,29 @@ void FramebufferManagerVulkan::Init() {
 }
 
 void FramebufferManagerVulkan::MakePixelTexture(const u8 *srcPixels, GEBufferFormat srcPixelFormat, int srcStride, int width, int height, float &u1, float &v1) {
-	if (drawPixelsTex_) {
+	// Games that DrawPixels every frame would otherwise create a fresh image
+	// (with its own device memory allocation) every time - keep the texture
+	// and just upload new contents as long as the size matches.
+	if (drawPixelsTex_ && (drawPixelsTex_->GetWidth() != width || drawPixelsTex_->GetHeight() != height)) {
 		delete drawPixelsTex_;
 		drawPixelsTex_ = nullptr;
 	}
 
 	VkCommandBuffer initCmd = (VkCommandBuffer)draw_->GetNativeObject(Draw::NativeObject::INIT_COMMANDBUFFER);
 
-	// There's only ever a few of these alive, don't need to stress the allocator with these big ones.
-	drawPixelsTex_ = new VulkanTexture(vulkan_);
-	drawPixelsTex_->SetTag("DrawPixels");
-	if (!drawPixelsTex_->CreateDirect(initCmd, nullptr, width, height, 1, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)) {
-		// out of memory?
-		delete drawPixelsTex_;
-		drawPixelsTex_ = nullptr;
-		overrideImageView_ = VK_NULL_HANDLE;
-		return;
+	if (!drawPixelsTex_) {
+		// There's only ever a few of these alive, don't need to stress the allocator with these big ones.
+		drawPixelsTex_ = new VulkanTexture(vulkan_);
+		drawPixelsTex_->SetTag("DrawPixels");
+		if (!drawPixelsTex_->CreateDirect(initCmd, nullptr, width, height, 1, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)) {
+			// out of memory?
+			delete drawPixelsTex_;
+			drawPixelsTex_ = nullptr;
+			overrideImageView_ = VK_NULL_HANDLE;
+			return;
+		}
+	} else {
+		drawPixelsTex_->PrepareForUpload(initCmd);
 	}
 	// Initialize backbuffer texture for DrawPixels
 	drawPixelsTexFormat_ = srcPixelFormat;
@@ -381,9 +417,35 @@ void FramebufferManagerVulkan::ReformatFramebufferFrom(VirtualFramebuffer *vfb,
 	// to exactly reproduce in 4444 and 8888 formats.
 
 	if (old == GE_FORMAT_565) {
-		// TODO: To match other backends, would be ideal to clear alpha only and not color.
-		// But probably doesn't matter that much...
-		draw_->BindFramebufferAsRenderTarget(vfb->fbo, { Draw::RPAction::CLEAR, Draw::RPAction::KEEP, Draw::RPAction::CLEAR });
+		// Clear alpha and stencil while preserving the color channels, same as the other
+		// backends. A render pass can't clear just one channel of a color attachment, so
+		// after the stencil clear we draw a full screen triangle through the stencil
+		// pipeline mode, which masks color writes to alpha.
+		if (!reformatVs_) {
+			std::string error;
+			reformatVs_ = CompileShaderModule(vulkan_, VK_SHADER_STAGE_VERTEX_BIT, reformat_vs, &error);
+			reformatFs_ = CompileShaderModule(vulkan_, VK_SHADER_STAGE_FRAGMENT_BIT, reformat_fs, &error);
+		}
+
+		VkRenderPass rp = (VkRenderPass)draw_->GetNativeObject(Draw::NativeObject::FRAMEBUFFER_RENDERPASS);
+		VulkanRenderManager *renderManager = (VulkanRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
+
+		shaderManagerVulkan_->DirtyLastShader();
+		textureCacheVulkan_->ForgetLastTexture();
+
+		draw_->BindFramebufferAsRenderTarget(vfb->fbo, { Draw::RPAction::KEEP, Draw::RPAction::KEEP, Draw::RPAction::CLEAR });
+
+		// With the stencil ref at zero this also rewrites the just-cleared stencil, which is harmless.
+		VkPipeline pipeline = vulkan2D_->GetPipeline(rp, reformatVs_, reformatFs_, false, Vulkan2D::VK2DDepthStencilMode::STENCIL_REPLACE_ALWAYS);
+		renderManager->BindPipeline(pipeline);
+		renderManager->SetViewport({ 0.0f, 0.0f, (float)vfb->renderWidth, (float)vfb->renderHeight, 0.0f, 1.0f });
+		renderManager->SetScissor({ { 0, 0 }, { (uint32_t)vfb->renderWidth, (uint32_t)vfb->renderHeight } });
+		renderManager->SetStencilParams(0xFF, 0xFF, 0x00);
+		// The shaders have no bindings, so an unwritten descriptor set is fine.
+		VkDescriptorSet descSet = vulkan2D_->GetDescriptorSet(VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+		renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
+
+		gstate_c.Dirty(DIRTY_VIEWPORTSCISSOR_STATE | DIRTY_BLEND_STATE | DIRTY_RASTER_STATE | DIRTY_DEPTHSTENCIL_STATE);
 	}
 }
 
@@ -117,6 +117,10 @@ private:
 	VkShaderModule stencilVs_ = VK_NULL_HANDLE;
 	VkShaderModule stencilFs_ = VK_NULL_HANDLE;
 
+	// For the alpha clear in ReformatFramebufferFrom.
+	VkShaderModule reformatVs_ = VK_NULL_HANDLE;
+	VkShaderModule reformatFs_ = VK_NULL_HANDLE;
+
 
 	VkPipeline cur2DPipeline_ = VK_NULL_HANDLE;
 
@@ -6,6 +6,7 @@
 
 #include "Common/Log.h"
 #include "Common/StringUtils.h"
+#include "Common/ThreadPools.h"
 #include "Common/Vulkan/VulkanContext.h"
 #include "GPU/Vulkan/VulkanUtil.h"
 #include "GPU/Vulkan/PipelineManagerVulkan.h"
@@ -718,6 +719,28 @@ bool PipelineManagerVulkan::LoadCache(FILE *file, bool loadRawPipelineCache, Sha
 	bool failed = fread(&size, sizeof(size), 1, file) != 1;
 
 	NOTICE_LOG(G3D, "Creating %d pipelines...", size);
+	if (!failed && size > 0 && size < 100000) {
+		// We know the steady-state size now, so the map never has to grow mid-game.
+		pipelines_.Reserve((int)size);
+	}
+
+	// Read and resolve all the keys up front, then create the actual pipelines
+	// across the thread pool. Sharing a VkPipelineCache between threads is
+	// explicitly allowed, and drivers spend real time in here even with a warm
+	// cache, so this cuts boot-time pre-warming by roughly the core count.
+	// The pipelines_ map isn't thread-safe, so inserts stay on this thread.
+	struct PendingPipeline {
+		VulkanPipelineRasterStateKey raster;
+		DecVtxFormat fmt;
+		VulkanVertexShader *vs;
+		VulkanFragmentShader *fs;
+		VkRenderPass rp;
+		bool useHWTransform;
+		VulkanPipeline *result = nullptr;
+	};
+	std::vector<PendingPipeline> pending;
+	pending.reserve(size);
+
 	for (uint32_t i = 0; i < size; i++) {
 		if (failed || cancelCache_) {
 			break;
@@ -736,18 +759,50 @@ bool PipelineManagerVulkan::LoadCache(FILE *file, bool loadRawPipelineCache, Sha
 			continue;
 		}
 
-		VkRenderPass rp;
+		PendingPipeline pp{};
+		pp.raster = key.raster;
+		pp.vs = vs;
+		pp.fs = fs;
+		pp.useHWTransform = key.useHWTransform;
 		if (key.backbufferPass) {
-			rp = queueRunner->GetBackbufferRenderPass();
+			pp.rp = queueRunner->GetBackbufferRenderPass();
 		} else {
-			rp = queueRunner->GetRenderPass(key.renderPassKey);
+			pp.rp = queueRunner->GetRenderPass(key.renderPassKey);
 		}
+		pp.fmt.InitializeFromID(key.vtxFmtId);
+		pending.push_back(pp);
+	}
 
-		DecVtxFormat fmt;
-		fmt.InitializeFromID(key.vtxFmtId);
-		GetOrCreatePipeline(layout, rp, key.raster,
-			key.useHWTransform ? &fmt : 0,
-			vs, fs, key.useHWTransform);
+	GlobalThreadPool::Loop([&](int lo, int hi) {
+		for (int i = lo; i < hi; i++) {
+			if (cancelCache_)
+				continue;
+			PendingPipeline &pp = pending[i];
+			pp.result = CreateVulkanPipeline(
+				vulkan_->GetDevice(), pipelineCache_, layout, pp.rp,
+				pp.raster, pp.useHWTransform ? &pp.fmt : 0,
+				pp.vs, pp.fs, pp.useHWTransform, lineWidth_);
+		}
+	}, 0, (int)pending.size());
+
+	for (auto &pp : pending) {
+		if (!pp.result)
+			continue;
+		VulkanPipelineKey key{};
+		key.raster = pp.raster;
+		key.renderPass = pp.rp;
+		key.useHWTransform = pp.useHWTransform;
+		key.vShader = pp.vs->GetModule();
+		key.fShader = pp.fs->GetModule();
+		key.vtxFmtId = pp.useHWTransform ? pp.fmt.id : 0;
+		if (!pipelines_.Get(key)) {
+			pipelines_.Insert(key, pp.result);
+		} else {
+			// Duplicate in the file somehow - don't leak the extra pipeline.
+			if (pp.result->pipeline)
+				vulkan_->Delete().QueueDeletePipeline(pp.result->pipeline);
+			delete pp.result;
+		}
 	}
 	NOTICE_LOG(G3D, "Recreated Vulkan pipeline cache (%d pipelines).", (int)size);
 	return true;
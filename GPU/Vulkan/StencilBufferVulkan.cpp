@@ -185,31 +185,58 @@ bool FramebufferManagerVulkan::NotifyStencilUpload(u32 addr, int size, bool skip
 	renderManager->SetStencilParams(0xFF, 0xFF, 0x00);
 	renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
 
-	for (int i = 1; i < values; i += i) {
-		if (!(usedBits & i)) {
-			// It's already zero, let's skip it.
-			continue;
+	// When multiple bits are in use but every non-zero pixel has the same value, we can
+	// replace the whole value in a single pass instead of looping over the bits.
+	u8 singleValue = 0;
+	if (usedBits & (usedBits - 1)) {
+		if (dstBuffer->format == GE_FORMAT_4444) {
+			singleValue = StencilSingleValue4444(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
+		} else if (dstBuffer->format == GE_FORMAT_8888) {
+			singleValue = StencilSingleValue8888(src, dstBuffer->fb_stride * dstBuffer->bufferHeight);
 		}
+	}
 
-		// These are the stencil bits that will be written.  We discard when the bit doesn't match.
-		uint8_t writeMask = 0;
-		// This is the value to test the texture alpha against in the shader.
+	if (singleValue != 0) {
+		uint8_t refValue = 0;
 		uint32_t value = 0;
 		if (dstBuffer->format == GE_FORMAT_4444) {
-			writeMask = i | (i << 4);
-			value = i * 16;
-		} else if (dstBuffer->format == GE_FORMAT_5551) {
-			writeMask = 0xFF;
-			value = i * 128;
+			refValue = (singleValue << 4) | singleValue;
+			value = singleValue * 16;
 		} else {
-			writeMask = i;
-			value = i;
+			refValue = singleValue;
+			value = singleValue;
 		}
-		renderManager->SetStencilParams(writeMask, 0xFF, 0xFF);
-		// Need to specify both VERTEX and FRAGMENT bits here since that's what we set up in the pipeline layout, and we need
-		// that for the post shaders. There's probably not really a cost to this.
+		// The shader discards the zero pixels and the rest all get refValue written.
+		renderManager->SetStencilParams(0xFF, 0xFF, refValue);
 		renderManager->PushConstants(vulkan2D_->GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT, 0, 4, &value);
 		renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
+	} else {
+		for (int i = 1; i < values; i += i) {
+			if (!(usedBits & i)) {
+				// It's already zero, let's skip it.
+				continue;
+			}
+
+			// These are the stencil bits that will be written.  We discard when the bit doesn't match.
+			uint8_t writeMask = 0;
+			// This is the value to test the texture alpha against in the shader.
+			uint32_t value = 0;
+			if (dstBuffer->format == GE_FORMAT_4444) {
+				writeMask = i | (i << 4);
+				value = i * 16;
+			} else if (dstBuffer->format == GE_FORMAT_5551) {
+				writeMask = 0xFF;
+				value = i * 128;
+			} else {
+				writeMask = i;
+				value = i;
+			}
+			renderManager->SetStencilParams(writeMask, 0xFF, 0xFF);
+			// Need to specify both VERTEX and FRAGMENT bits here since that's what we set up in the pipeline layout, and we need
+			// that for the post shaders. There's probably not really a cost to this.
+			renderManager->PushConstants(vulkan2D_->GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT, 0, 4, &value);
+			renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, VK_NULL_HANDLE, 0, 3);  // full screen triangle
+		}
 	}
 
 	overrideImageView_ = VK_NULL_HANDLE;
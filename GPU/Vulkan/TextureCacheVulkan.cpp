@@ -22,11 +22,18 @@
 #include "i18n/i18n.h"
 #include "math/math_util.h"
 #include "profiler/profiler.h"
+#include "thread/threadutil.h"
 #include "thin3d/thin3d.h"
 #include "thin3d/VulkanRenderManager.h"
 
+#include <snappy-c.h>
+
 #include "Common/ColorConv.h"
+#include "Common/CPUDetect.h"
+#include "Common/FileUtil.h"
+#include "Common/ThreadPools.h"
 #include "Core/Config.h"
+#include "Core/ELF/ParamSFO.h"
 #include "Core/Host.h"
 #include "Core/MemMap.h"
 #include "Core/Reporting.h"
@@ -143,11 +150,14 @@ TextureCacheVulkan::TextureCacheVulkan(Draw::DrawContext *draw, VulkanContext *v
 		vulkan_(vulkan),
 		samplerCache_(vulkan) {
 	timesInvalidatedAllThisFrame_ = 0;
+	// The async scaler runs on its own thread, so it mustn't hog the global pool.
+	asyncScaler_.SetSingleThreaded();
 	DeviceRestore(vulkan, draw);
 	SetupTextureDecoder();
 }
 
 TextureCacheVulkan::~TextureCacheVulkan() {
+	StopScaleThread();
 	DeviceLost();
 }
 
@@ -259,6 +269,8 @@ void TextureCacheVulkan::StartFrame() {
 	timesInvalidatedAllThisFrame_ = 0;
 	texelsScaledThisFrame_ = 0;
 
+	NotifyFinishedScaleJobs();
+
 	if (clearCacheNextFrame_) {
 		Clear(true);
 		clearCacheNextFrame_ = false;
@@ -375,78 +387,88 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 		}
 	}
 	if (depalShader) {
-		depalShaderCache_->SetPushBuffer(drawEngine_->GetPushBufferForTextureData());
 		const GEPaletteFormat clutFormat = gstate.getClutPaletteFormat();
-		VulkanTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
-
-		Draw::Framebuffer *depalFBO = framebufferManager_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
-		draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
-
-		Vulkan2D::Vertex verts[4] = {
-			{ -1, -1, 0.0f, 0, 0 },
-			{  1, -1, 0.0f, 1, 0 },
-			{ -1,  1, 0.0f, 0, 1 },
-			{  1,  1, 0.0f, 1, 1 },
-		};
-
-		// If min is not < max, then we don't have values (wasn't set during decode.)
-		if (gstate_c.vertBounds.minV < gstate_c.vertBounds.maxV) {
-			const float invWidth = 1.0f / (float)framebuffer->bufferWidth;
-			const float invHeight = 1.0f / (float)framebuffer->bufferHeight;
-			// Inverse of half = double.
-			const float invHalfWidth = invWidth * 2.0f;
-			const float invHalfHeight = invHeight * 2.0f;
-
-			const int u1 = gstate_c.vertBounds.minU + gstate_c.curTextureXOffset;
-			const int v1 = gstate_c.vertBounds.minV + gstate_c.curTextureYOffset;
-			const int u2 = gstate_c.vertBounds.maxU + gstate_c.curTextureXOffset;
-			const int v2 = gstate_c.vertBounds.maxV + gstate_c.curTextureYOffset;
-
-			const float left = u1 * invHalfWidth - 1.0f;
-			const float right = u2 * invHalfWidth - 1.0f;
-			const float top = v1 * invHalfHeight - 1.0f;
-			const float bottom = v2 * invHalfHeight - 1.0f;
-			// Points are: BL, BR, TR, TL.
-			verts[0].x = left;
-			verts[0].y = bottom;
-			verts[1].x = right;
-			verts[1].y = bottom;
-			verts[2].x = left;
-			verts[2].y = top;
-			verts[3].x = right;
-			verts[3].y = top;
-
-			// And also the UVs, same order.
-			const float uvleft = u1 * invWidth;
-			const float uvright = u2 * invWidth;
-			const float uvtop = v1 * invHeight;
-			const float uvbottom = v2 * invHeight;
-			verts[0].u = uvleft;
-			verts[0].v = uvbottom;
-			verts[1].u = uvright;
-			verts[1].v = uvbottom;
-			verts[2].u = uvleft;
-			verts[2].v = uvtop;
-			verts[3].u = uvright;
-			verts[3].v = uvtop;
-
-			// We need to reapply the texture next time since we cropped UV.
-			gstate_c.Dirty(DIRTY_TEXTURE_PARAMS);
+
+		bool needsDepalRender = true;
+		Draw::Framebuffer *depalFBO = GetDepalResultFBO(framebuffer, clutMode, &needsDepalRender);
+		if (!depalFBO) {
+			// Not cacheable, use the shared scratch FBO.
+			depalFBO = framebufferManager_->GetTempFBO(TempFBO::DEPAL, framebuffer->renderWidth, framebuffer->renderHeight, Draw::FBO_8888);
 		}
+		if (needsDepalRender) {
+			depalShaderCache_->SetPushBuffer(drawEngine_->GetPushBufferForTextureData());
+			VulkanTexture *clutTexture = depalShaderCache_->GetClutTexture(clutFormat, clutHash_, clutBuf_);
 
-		VkBuffer pushed;
-		uint32_t offset = push_->PushAligned(verts, sizeof(verts), 4, &pushed);
+			draw_->BindFramebufferAsRenderTarget(depalFBO, { Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE, Draw::RPAction::DONT_CARE });
+
+			Vulkan2D::Vertex verts[4] = {
+				{ -1, -1, 0.0f, 0, 0 },
+				{  1, -1, 0.0f, 1, 0 },
+				{ -1,  1, 0.0f, 0, 1 },
+				{  1,  1, 0.0f, 1, 1 },
+			};
+
+			// If min is not < max, then we don't have values (wasn't set during decode.)
+			if (gstate_c.vertBounds.minV < gstate_c.vertBounds.maxV) {
+				const float invWidth = 1.0f / (float)framebuffer->bufferWidth;
+				const float invHeight = 1.0f / (float)framebuffer->bufferHeight;
+				// Inverse of half = double.
+				const float invHalfWidth = invWidth * 2.0f;
+				const float invHalfHeight = invHeight * 2.0f;
+
+				const int u1 = gstate_c.vertBounds.minU + gstate_c.curTextureXOffset;
+				const int v1 = gstate_c.vertBounds.minV + gstate_c.curTextureYOffset;
+				const int u2 = gstate_c.vertBounds.maxU + gstate_c.curTextureXOffset;
+				const int v2 = gstate_c.vertBounds.maxV + gstate_c.curTextureYOffset;
+
+				const float left = u1 * invHalfWidth - 1.0f;
+				const float right = u2 * invHalfWidth - 1.0f;
+				const float top = v1 * invHalfHeight - 1.0f;
+				const float bottom = v2 * invHalfHeight - 1.0f;
+				// Points are: BL, BR, TR, TL.
+				verts[0].x = left;
+				verts[0].y = bottom;
+				verts[1].x = right;
+				verts[1].y = bottom;
+				verts[2].x = left;
+				verts[2].y = top;
+				verts[3].x = right;
+				verts[3].y = top;
+
+				// And also the UVs, same order.
+				const float uvleft = u1 * invWidth;
+				const float uvright = u2 * invWidth;
+				const float uvtop = v1 * invHeight;
+				const float uvbottom = v2 * invHeight;
+				verts[0].u = uvleft;
+				verts[0].v = uvbottom;
+				verts[1].u = uvright;
+				verts[1].v = uvbottom;
+				verts[2].u = uvleft;
+				verts[2].v = uvtop;
+				verts[3].u = uvright;
+				verts[3].v = uvtop;
+
+				// We need to reapply the texture next time since we cropped UV.
+				gstate_c.Dirty(DIRTY_TEXTURE_PARAMS);
+			}
 
-		draw_->BindFramebufferAsTexture(framebuffer->fbo, 0, Draw::FB_COLOR_BIT, 0);
-		VkImageView fbo = (VkImageView)draw_->GetNativeObject(Draw::NativeObject::BOUND_TEXTURE0_IMAGEVIEW);
+			VkBuffer pushed;
+			uint32_t offset = push_->PushAligned(verts, sizeof(verts), 4, &pushed);
 
-		VkDescriptorSet descSet = vulkan2D_->GetDescriptorSet(fbo, samplerNearest_, clutTexture->GetImageView(), samplerNearest_);
-		VulkanRenderManager *renderManager = (VulkanRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
-		renderManager->BindPipeline(depalShader->pipeline);
-		renderManager->SetScissor(VkRect2D{ {0, 0}, { framebuffer->renderWidth, framebuffer->renderHeight} });
-		renderManager->SetViewport(VkViewport{ 0.f, 0.f, (float)framebuffer->renderWidth, (float)framebuffer->renderHeight, 0.f, 1.f });
-		renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, pushed, offset, 4);
-		shaderManagerVulkan_->DirtyLastShader();
+			draw_->BindFramebufferAsTexture(framebuffer->fbo, 0, Draw::FB_COLOR_BIT, 0);
+			VkImageView fbo = (VkImageView)draw_->GetNativeObject(Draw::NativeObject::BOUND_TEXTURE0_IMAGEVIEW);
+
+			VkDescriptorSet descSet = vulkan2D_->GetDescriptorSet(fbo, samplerNearest_, clutTexture->GetImageView(), samplerNearest_);
+			VulkanRenderManager *renderManager = (VulkanRenderManager *)draw_->GetNativeObject(Draw::NativeObject::RENDER_MANAGER);
+			renderManager->BindPipeline(depalShader->pipeline);
+			renderManager->SetScissor(VkRect2D{ {0, 0}, { framebuffer->renderWidth, framebuffer->renderHeight} });
+			renderManager->SetViewport(VkViewport{ 0.f, 0.f, (float)framebuffer->renderWidth, (float)framebuffer->renderHeight, 0.f, 1.f });
+			renderManager->Draw(vulkan2D_->GetPipelineLayout(), descSet, 0, nullptr, pushed, offset, 4);
+			shaderManagerVulkan_->DirtyLastShader();
+
+			framebufferManager_->RebindFramebuffer();
+		}
 
 		const u32 bytesPerColor = clutFormat == GE_CMODE_32BIT_ABGR8888 ? sizeof(u32) : sizeof(u16);
 		const u32 clutTotalColors = clutMaxBytes_ / bytesPerColor;
@@ -454,7 +476,6 @@ void TextureCacheVulkan::ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFr
 		TexCacheEntry::TexStatus alphaStatus = CheckAlpha(clutBuf_, getClutDestFormatVulkan(clutFormat), clutTotalColors, clutTotalColors, 1);
 		gstate_c.SetTextureFullAlpha(alphaStatus == TexCacheEntry::STATUS_ALPHA_FULL);
 
-		framebufferManager_->RebindFramebuffer();
 		draw_->BindFramebufferAsTexture(depalFBO, 0, Draw::FB_COLOR_BIT, 0);
 		imageView_ = (VkImageView)draw_->GetNativeObject(Draw::NativeObject::BOUND_TEXTURE0_IMAGEVIEW);
 
@@ -576,10 +597,40 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 		scaleFactor = 1;
 	}
 
+	// Scaling happens asynchronously: the first build uploads the texture unscaled and
+	// queues the decoded pixels for a worker thread. Once the worker finishes,
+	// NotifyFinishedScaleJobs() sets STATUS_TO_SCALE and the regular deferred-scaling
+	// rebuild swaps the scaled image in - the GPU thread never waits on xBRZ.
+	consumeScaleJob_ = nullptr;
+	queueScaleJob_ = false;
+	if (scaleFactor != 1 && !replaced.Valid()) {
+		std::lock_guard<std::mutex> guard(scaleMutex_);
+		auto it = scaleJobs_.find(entry->CacheKey());
+		if (it != scaleJobs_.end() && it->second->done && it->second->fullhash == entry->fullhash &&
+			it->second->factor == scaleFactor && it->second->w == w * scaleFactor && it->second->h == h * scaleFactor) {
+			consumeScaleJob_ = it->second;
+		} else {
+			if (it != scaleJobs_.end() && it->second->done) {
+				// Stale result - the texture changed while the job was in flight.
+				delete it->second;
+				scaleJobs_.erase(it);
+				it = scaleJobs_.end();
+			}
+			if (it == scaleJobs_.end()) {
+				// LoadTextureLevel queues the job once it has the decoded pixels.
+				queueScaleJob_ = true;
+				queueScaleFactor_ = scaleFactor;
+			}
+			entry->status &= ~TexCacheEntry::STATUS_TO_SCALE;
+			scaleFactor = 1;
+		}
+	}
+
 	if (scaleFactor != 1) {
 		if (texelsScaledThisFrame_ >= TEXCACHE_MAX_TEXELS_SCALED) {
 			entry->status |= TexCacheEntry::STATUS_TO_SCALE;
 			scaleFactor = 1;
+			consumeScaleJob_ = nullptr;
 		} else {
 			entry->status &= ~TexCacheEntry::STATUS_TO_SCALE;
 			entry->status |= TexCacheEntry::STATUS_IS_SCALED;
@@ -670,36 +721,44 @@ void TextureCacheVulkan::BuildTexture(TexCacheEntry *const entry) {
 		// NOTE: Since the level is not part of the cache key, we assume it never changes.
 		u8 level = std::max(0, gstate.getTexLevelOffset16() / 16);
 		bool fakeMipmap = IsFakeMipmapChange() && level > 0;
-		// Upload the texture data.
-		for (int i = 0; i <= maxLevel; i++) {
-			int mipWidth = gstate.getTextureWidth(i) * scaleFactor;
-			int mipHeight = gstate.getTextureHeight(i) * scaleFactor;
-			if (replaced.Valid()) {
-				replaced.GetSize(i, mipWidth, mipHeight);
-			}
-			int bpp = actualFmt == VULKAN_8888_FORMAT ? 4 : 2;
-			int stride = (mipWidth * bpp + 15) & ~15;
-			int size = stride * mipHeight;
-			uint32_t bufferOffset;
-			VkBuffer texBuf;
-			// nvidia returns 1 but that can't be healthy... let's align by 16 as a minimum.
-			int pushAlignment = std::max(16, (int)vulkan_->GetPhysicalDeviceProperties().properties.limits.optimalBufferCopyOffsetAlignment);
-			void *data = drawEngine_->GetPushBufferForTextureData()->PushAligned(size, &bufferOffset, &texBuf, pushAlignment);
-			if (replaced.Valid()) {
-				replaced.Load(i, data, stride);
-			} else {
-				if (fakeMipmap) {
-					LoadTextureLevel(*entry, (uint8_t *)data, stride, level, scaleFactor, dstFmt);
-					entry->vkTex->UploadMip(cmdInit, 0, mipWidth, mipHeight, texBuf, bufferOffset, stride / bpp);
-					break;
-				} else {
-					LoadTextureLevel(*entry, (uint8_t *)data, stride, i, scaleFactor, dstFmt);
+		// Large unscaled textures decode fastest split across the thread pool, each worker
+		// writing its own rows of the already-mapped staging memory. Replacement and
+		// scaling want whole levels in one piece, so those stay on the serial path.
+		bool threadedDecode = cpu_info.num_cores > 2 && scaleFactor == 1 && !replaced.Valid() && !fakeMipmap && w * h >= 256 * 256;
+		if (threadedDecode) {
+			LoadTextureLevelsThreaded(*entry, cmdInit, maxLevel, dstFmt, replacedInfo);
+		} else {
+			// Upload the texture data.
+			for (int i = 0; i <= maxLevel; i++) {
+				int mipWidth = gstate.getTextureWidth(i) * scaleFactor;
+				int mipHeight = gstate.getTextureHeight(i) * scaleFactor;
+				if (replaced.Valid()) {
+					replaced.GetSize(i, mipWidth, mipHeight);
 				}
-				if (replacer_.Enabled()) {
-					replacer_.NotifyTextureDecoded(replacedInfo, data, stride, i, mipWidth, mipHeight);
+				int bpp = actualFmt == VULKAN_8888_FORMAT ? 4 : 2;
+				int stride = (mipWidth * bpp + 15) & ~15;
+				int size = stride * mipHeight;
+				uint32_t bufferOffset;
+				VkBuffer texBuf;
+				// nvidia returns 1 but that can't be healthy... let's align by 16 as a minimum.
+				int pushAlignment = std::max(16, (int)vulkan_->GetPhysicalDeviceProperties().properties.limits.optimalBufferCopyOffsetAlignment);
+				void *data = drawEngine_->GetPushBufferForTextureData()->PushAligned(size, &bufferOffset, &texBuf, pushAlignment);
+				if (replaced.Valid()) {
+					replaced.Load(i, data, stride);
+				} else {
+					if (fakeMipmap) {
+						LoadTextureLevel(*entry, (uint8_t *)data, stride, level, scaleFactor, dstFmt);
+						entry->vkTex->UploadMip(cmdInit, 0, mipWidth, mipHeight, texBuf, bufferOffset, stride / bpp);
+						break;
+					} else {
+						LoadTextureLevel(*entry, (uint8_t *)data, stride, i, scaleFactor, dstFmt);
+					}
+					if (replacer_.Enabled()) {
+						replacer_.NotifyTextureDecoded(replacedInfo, data, stride, i, mipWidth, mipHeight);
+					}
 				}
+				entry->vkTex->UploadMip(cmdInit, i, mipWidth, mipHeight, texBuf, bufferOffset, stride / bpp);
 			}
-			entry->vkTex->UploadMip(cmdInit, i, mipWidth, mipHeight, texBuf, bufferOffset, stride / bpp);
 		}
 
 		if (maxLevel == 0) {
@@ -764,6 +823,20 @@ void TextureCacheVulkan::LoadTextureLevel(TexCacheEntry &entry, uint8_t *writePt
 	int w = gstate.getTextureWidth(level);
 	int h = gstate.getTextureHeight(level);
 
+	if (scaleFactor > 1 && consumeScaleJob_) {
+		// The worker already scaled this texture; just copy the rows in.
+		AsyncScaleJob *job = consumeScaleJob_;
+		consumeScaleJob_ = nullptr;
+		for (int y = 0; y < job->h; y++) {
+			memcpy(writePtr + rowPitch * y, &job->data[y * job->w], job->w * sizeof(u32));
+		}
+		entry.SetAlphaStatus(job->alphaStatus, level);
+		std::lock_guard<std::mutex> guard(scaleMutex_);
+		scaleJobs_.erase(job->cachekey);
+		delete job;
+		return;
+	}
+
 	{
 		PROFILE_THIS_SCOPE("decodetex");
 
@@ -795,6 +868,11 @@ void TextureCacheVulkan::LoadTextureLevel(TexCacheEntry &entry, uint8_t *writePt
 			entry.SetAlphaStatus(TexCacheEntry::STATUS_ALPHA_UNKNOWN);
 		}
 
+		if (queueScaleJob_ && level == 0 && scaleFactor == 1) {
+			queueScaleJob_ = false;
+			QueueAsyncScale(entry, (const u8 *)pixelData, decPitch, w, h, dstFmt, entry.GetAlphaStatus());
+		}
+
 		if (scaleFactor > 1) {
 			u32 fmt = dstFmt;
 			scaler.ScaleAlways((u32 *)writePtr, pixelData, fmt, w, h, scaleFactor);
@@ -818,6 +896,266 @@ void TextureCacheVulkan::LoadTextureLevel(TexCacheEntry &entry, uint8_t *writePt
 	}
 }
 
+// Decodes every level straight into staging memory, split into horizontal bands across
+// the thread pool. The bands are disjoint rows of the mapped buffer so the workers never
+// step on each other - only the alpha check and command recording stay on this thread.
+void TextureCacheVulkan::LoadTextureLevelsThreaded(TexCacheEntry &entry, VkCommandBuffer cmdInit, int maxLevel, VkFormat dstFmt, const ReplacedTextureDecodeInfo &replacedInfo) {
+	struct MipStaging {
+		uint8_t *data;
+		uint32_t bufferOffset;
+		VkBuffer texBuf;
+		int width;
+		int height;
+		int stride;
+		u32 texaddr;
+		int bufw;
+	};
+	struct DecodeBand {
+		int level;
+		int y0;
+		int y1;
+	};
+
+	GETextureFormat tfmt = (GETextureFormat)entry.format;
+	GEPaletteFormat clutformat = gstate.getClutPaletteFormat();
+	int bpp = dstFmt == VULKAN_8888_FORMAT ? 4 : 2;
+	// nvidia returns 1 but that can't be healthy... let's align by 16 as a minimum.
+	int pushAlignment = std::max(16, (int)vulkan_->GetPhysicalDeviceProperties().properties.limits.optimalBufferCopyOffsetAlignment);
+
+	// Grab staging memory for every level up front so the workers have somewhere to write.
+	MipStaging mips[8]{};
+	std::vector<DecodeBand> bands;
+	for (int i = 0; i <= maxLevel; i++) {
+		MipStaging &m = mips[i];
+		m.width = gstate.getTextureWidth(i);
+		m.height = gstate.getTextureHeight(i);
+		m.texaddr = gstate.getTextureAddress(i);
+		m.bufw = GetTextureBufw(i, m.texaddr, tfmt);
+		m.stride = (m.width * bpp + 15) & ~15;
+		m.data = (uint8_t *)drawEngine_->GetPushBufferForTextureData()->PushAligned(m.stride * m.height, &m.bufferOffset, &m.texBuf, pushAlignment);
+
+		// Bands have to start on swizzle block boundaries. 64 rows keeps the task count
+		// low while still splitting a 512-high texture eight ways.
+		const int bandRows = 64;
+		for (int y = 0; y < m.height; y += bandRows) {
+			bands.push_back(DecodeBand{ i, y, std::min(y + bandRows, m.height) });
+		}
+	}
+
+	{
+		PROFILE_THIS_SCOPE("decodetex");
+		GlobalThreadPool::Loop([&](int lo, int hi) {
+			SimpleBuf<u32> scratch;
+			for (int j = lo; j < hi; j++) {
+				const DecodeBand &b = bands[j];
+				const MipStaging &m = mips[b.level];
+				DecodeTextureLevelBand(m.data, m.stride, tfmt, clutformat, m.texaddr, b.level, m.bufw, false, false, false, b.y0, b.y1, scratch);
+			}
+		}, 0, (int)bands.size());
+	}
+
+	for (int i = 0; i <= maxLevel; i++) {
+		const MipStaging &m = mips[i];
+		gpuStats.numTexturesDecoded++;
+		if ((entry.status & TexCacheEntry::STATUS_CHANGE_FREQUENT) == 0) {
+			TexCacheEntry::TexStatus alphaStatus = CheckAlpha((const u32 *)m.data, dstFmt, m.stride / bpp, m.width, m.height);
+			entry.SetAlphaStatus(alphaStatus, i);
+		} else {
+			entry.SetAlphaStatus(TexCacheEntry::STATUS_ALPHA_UNKNOWN);
+		}
+		if (queueScaleJob_ && i == 0) {
+			queueScaleJob_ = false;
+			QueueAsyncScale(entry, m.data, m.stride, m.width, m.height, dstFmt, entry.GetAlphaStatus());
+		}
+		if (replacer_.Enabled()) {
+			replacer_.NotifyTextureDecoded(replacedInfo, m.data, m.stride, i, m.width, m.height);
+		}
+		entry.vkTex->UploadMip(cmdInit, i, m.width, m.height, m.texBuf, m.bufferOffset, m.stride / bpp);
+	}
+}
+
+// On-disk cache of post-scaled textures, so texture-heavy sessions don't redo
+// identical xBRZ work every time. Keyed the same way as texture replacement -
+// cachekey plus content hash - with the scaling settings baked into the filename.
+// Snappy-compressed raw pixels; GPU-native compressed formats would need an
+// encoder we don't ship.
+
+struct ScaledTexCacheHeader {
+	char magic[4];
+	u32 fmt;
+	u32 w;
+	u32 h;
+	u32 dataSize;  // Uncompressed, in bytes.
+};
+
+static const char SCALED_TEX_CACHE_MAGIC[4] = { 'P', 'T', 'C', '1' };
+
+static std::string ScaledTexCacheFilename(u64 cachekey, u32 fullhash, int factor) {
+	char name[64];
+	snprintf(name, sizeof(name), "%016llx%08x_%dx_t%d%s.stc", cachekey, fullhash, factor, g_Config.iTexScalingType, g_Config.bTexDeposterize ? "_d" : "");
+	return GetSysDirectory(DIRECTORY_CACHE) + "TEXSCALE/" + g_paramSFO.GetDiscID() + "/" + name;
+}
+
+// Returns true and fills in the scaled result on a hit. Runs on the scale thread.
+static bool LoadScaledTexFromDisk(const std::string &filename, int factor, u32 *fmt, int *w, int *h, std::vector<u32> *data) {
+	FILE *f = File::OpenCFile(filename, "rb");
+	if (!f)
+		return false;
+
+	ScaledTexCacheHeader header{};
+	bool success = fread(&header, sizeof(header), 1, f) == 1;
+	success = success && memcmp(header.magic, SCALED_TEX_CACHE_MAGIC, sizeof(header.magic)) == 0;
+	success = success && header.w == (u32)(*w * factor) && header.h == (u32)(*h * factor);
+	success = success && header.dataSize == header.w * header.h * sizeof(u32);
+	if (success) {
+		fseek(f, 0, SEEK_END);
+		size_t compressedSize = ftell(f) - sizeof(header);
+		fseek(f, sizeof(header), SEEK_SET);
+
+		std::vector<char> compressed(compressedSize);
+		success = fread(compressed.data(), 1, compressedSize, f) == compressedSize;
+		if (success) {
+			data->resize(header.dataSize / sizeof(u32));
+			size_t uncompSize = header.dataSize;
+			success = snappy_uncompress(compressed.data(), compressedSize, (char *)data->data(), &uncompSize) == SNAPPY_OK && uncompSize == header.dataSize;
+		}
+	}
+	fclose(f);
+
+	if (success) {
+		*fmt = header.fmt;
+		*w = (int)header.w;
+		*h = (int)header.h;
+	} else {
+		// Corrupt or stale format - drop it, we'll rewrite it below.
+		File::Delete(filename);
+	}
+	return success;
+}
+
+// Runs on the scale thread. Failures just mean we rescale next session.
+static void SaveScaledTexToDisk(const std::string &filename, u32 fmt, int w, int h, const std::vector<u32> &data) {
+	const std::string dir = GetSysDirectory(DIRECTORY_CACHE) + "TEXSCALE/" + g_paramSFO.GetDiscID();
+	if (!File::Exists(dir))
+		File::CreateFullPath(dir);
+
+	ScaledTexCacheHeader header{};
+	memcpy(header.magic, SCALED_TEX_CACHE_MAGIC, sizeof(header.magic));
+	header.fmt = fmt;
+	header.w = w;
+	header.h = h;
+	header.dataSize = (u32)(data.size() * sizeof(u32));
+
+	size_t compressedSize = snappy_max_compressed_length(header.dataSize);
+	std::vector<char> compressed(compressedSize);
+	if (snappy_compress((const char *)data.data(), header.dataSize, compressed.data(), &compressedSize) != SNAPPY_OK)
+		return;
+
+	FILE *f = File::OpenCFile(filename, "wb");
+	if (!f)
+		return;
+	bool success = fwrite(&header, sizeof(header), 1, f) == 1;
+	success = success && fwrite(compressed.data(), 1, compressedSize, f) == compressedSize;
+	fclose(f);
+	if (!success)
+		File::Delete(filename);
+}
+
+void TextureCacheVulkan::QueueAsyncScale(TexCacheEntry &entry, const u8 *data, int pitch, int w, int h, u32 fmt, TexCacheEntry::TexStatus alphaStatus) {
+	AsyncScaleJob *job = new AsyncScaleJob();
+	job->cachekey = entry.CacheKey();
+	job->fullhash = entry.fullhash;
+	job->factor = queueScaleFactor_;
+	job->fmt = fmt;
+	job->w = w;
+	job->h = h;
+	job->alphaStatus = alphaStatus;
+	// Pack the rows tightly - the scaler doesn't deal in pitches.
+	int rowBytes = w * (fmt == VULKAN_8888_FORMAT ? 4 : 2);
+	job->data.resize((rowBytes * h + 3) / 4);
+	for (int y = 0; y < h; y++) {
+		memcpy((u8 *)job->data.data() + y * rowBytes, data + y * pitch, rowBytes);
+	}
+
+	std::lock_guard<std::mutex> guard(scaleMutex_);
+	scaleJobs_[job->cachekey] = job;
+	scaleQueue_.push_back(job);
+	if (!scaleThread_.joinable()) {
+		scaleThread_ = std::thread(&TextureCacheVulkan::ScaleThreadFunc, this);
+	}
+	scaleSignal_.notify_one();
+}
+
+void TextureCacheVulkan::ScaleThreadFunc() {
+	setCurrentThreadName("TexScale");
+	std::unique_lock<std::mutex> lock(scaleMutex_);
+	while (!scaleThreadExit_) {
+		if (scaleQueue_.empty()) {
+			scaleSignal_.wait(lock);
+			continue;
+		}
+		AsyncScaleJob *job = scaleQueue_.front();
+		scaleQueue_.pop_front();
+		lock.unlock();
+
+		u32 fmt = job->fmt;
+		int w = job->w;
+		int h = job->h;
+		std::vector<u32> scaled;
+		std::string cacheFilename;
+		if (g_Config.bScaledTextureCache)
+			cacheFilename = ScaledTexCacheFilename(job->cachekey, job->fullhash, job->factor);
+		if (cacheFilename.empty() || !LoadScaledTexFromDisk(cacheFilename, job->factor, &fmt, &w, &h, &scaled)) {
+			scaled.resize(w * job->factor * h * job->factor);
+			asyncScaler_.ScaleAlways(scaled.data(), job->data.data(), fmt, w, h, job->factor);
+			if (!cacheFilename.empty())
+				SaveScaledTexToDisk(cacheFilename, fmt, w, h, scaled);
+		}
+
+		lock.lock();
+		job->data.swap(scaled);
+		job->fmt = fmt;
+		job->w = w;
+		job->h = h;
+		job->done = true;
+	}
+}
+
+// Called once a frame. Completed jobs flag their entry for the regular deferred-scaling
+// rebuild, which then consumes the result; jobs whose entry is gone are dropped.
+void TextureCacheVulkan::NotifyFinishedScaleJobs() {
+	std::lock_guard<std::mutex> guard(scaleMutex_);
+	for (auto it = scaleJobs_.begin(); it != scaleJobs_.end(); ) {
+		AsyncScaleJob *job = it->second;
+		if (!job->done) {
+			++it;
+			continue;
+		}
+		auto entryIter = cache_.find(job->cachekey);
+		if (entryIter == cache_.end()) {
+			delete job;
+			it = scaleJobs_.erase(it);
+			continue;
+		}
+		entryIter->second->status |= TexCacheEntry::STATUS_TO_SCALE;
+		++it;
+	}
+}
+
+void TextureCacheVulkan::StopScaleThread() {
+	{
+		std::lock_guard<std::mutex> guard(scaleMutex_);
+		scaleThreadExit_ = true;
+		scaleSignal_.notify_all();
+	}
+	if (scaleThread_.joinable())
+		scaleThread_.join();
+	for (auto &iter : scaleJobs_)
+		delete iter.second;
+	scaleJobs_.clear();
+	scaleQueue_.clear();
+}
+
 bool TextureCacheVulkan::GetCurrentTextureDebug(GPUDebugBuffer &buffer, int level) {
 	SetTexture(false);
 	if (!nextTexture_)
@@ -17,7 +17,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/Hashmaps.h"
 #include "GPU/GPUInterface.h"
@@ -115,6 +120,7 @@ protected:
 
 private:
 	void LoadTextureLevel(TexCacheEntry &entry, uint8_t *writePtr, int rowPitch,  int level, int scaleFactor, VkFormat dstFmt);
+	void LoadTextureLevelsThreaded(TexCacheEntry &entry, VkCommandBuffer cmdInit, int maxLevel, VkFormat dstFmt, const ReplacedTextureDecodeInfo &replacedInfo);
 	VkFormat GetDestFormat(GETextureFormat format, GEPaletteFormat clutFormat) const;
 	TexCacheEntry::TexStatus CheckAlpha(const u32 *pixelData, VkFormat dstFmt, int stride, int w, int h);
 	void UpdateCurrentClut(GEPaletteFormat clutFormat, u32 clutBase, bool clutIndexIsSimple) override;
@@ -122,6 +128,26 @@ private:
 	void ApplyTextureFramebuffer(TexCacheEntry *entry, VirtualFramebuffer *framebuffer) override;
 	void BuildTexture(TexCacheEntry *const entry) override;
 
+	// Asynchronous texture scaling. The first build of a texture that wants scaling
+	// uploads unscaled and queues the decoded pixels here; a worker thread scales them,
+	// and the result is swapped in through the regular STATUS_TO_SCALE rebuild.
+	struct AsyncScaleJob {
+		u64 cachekey;
+		u32 fullhash;
+		int factor;
+		// Written by the worker, along with data. The GPU thread stays away until done.
+		u32 fmt;
+		int w;
+		int h;
+		TexCacheEntry::TexStatus alphaStatus;
+		std::vector<u32> data;
+		bool done = false;
+	};
+	void QueueAsyncScale(TexCacheEntry &entry, const u8 *data, int pitch, int w, int h, u32 fmt, TexCacheEntry::TexStatus alphaStatus);
+	void NotifyFinishedScaleJobs();
+	void ScaleThreadFunc();
+	void StopScaleThread();
+
 	VulkanContext *vulkan_ = nullptr;
 	VulkanDeviceAllocator *allocator_ = nullptr;
 	VulkanPushBuffer *push_ = nullptr;
@@ -130,6 +156,20 @@ private:
 
 	TextureScalerVulkan scaler;
 
+	// Owned by the scale thread once queued; the map itself is guarded by scaleMutex_.
+	std::map<u64, AsyncScaleJob *> scaleJobs_;
+	std::deque<AsyncScaleJob *> scaleQueue_;
+	std::thread scaleThread_;
+	std::mutex scaleMutex_;
+	std::condition_variable scaleSignal_;
+	bool scaleThreadExit_ = false;
+	TextureScalerVulkan asyncScaler_;
+
+	// Set up by BuildTexture for LoadTextureLevel(sThreaded) to act on.
+	AsyncScaleJob *consumeScaleJob_ = nullptr;
+	bool queueScaleJob_ = false;
+	int queueScaleFactor_ = 0;
+
 	VulkanTexture *lastBoundTexture = nullptr;
 
 	int decimationCounter_ = 0;
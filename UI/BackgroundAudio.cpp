@@ -1,14 +1,18 @@
-#include <string>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/timeutil.h"
 #include "file/chunk_file.h"
+#include "thread/threadutil.h"
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/SimpleAudioDec.h"
 #include "Core/HLE/__sceAudio.h"
-#include "Common/FixedSizeQueue.h"
 #include "GameInfoCache.h"
 #include "Core/Config.h"
 
@@ -125,31 +129,20 @@ public:
 
 	bool IsOK() { return raw_data_ != 0; }
 
-	bool Read(int *buffer, int len) {
+	// Decodes the whole stream in one pass. Playback loops by wrapping the read
+	// offset in the resulting buffer instead of re-decoding.
+	bool ReadAll(std::vector<s16> *pcm) {
 		if (!raw_data_)
 			return false;
 
-		while (bgQueue.size() < (size_t)(len * 2)) {
-			int outBytes;
-			decoder_->Decode(raw_data_ + raw_offset_, raw_bytes_per_frame_, (uint8_t *)buffer_, &outBytes);
+		for (int offset = 0; offset + raw_bytes_per_frame_ <= raw_data_size_; offset += raw_bytes_per_frame_) {
+			int outBytes = 0;
+			decoder_->Decode(raw_data_ + offset, raw_bytes_per_frame_, (uint8_t *)buffer_, &outBytes);
 			if (!outBytes)
-				return false;
-
-			for (int i = 0; i < outBytes / 2; i++) {
-				bgQueue.push(buffer_[i]);
-			}
-
-			// loop!
-			raw_offset_ += raw_bytes_per_frame_;
-			if (raw_offset_ >= raw_data_size_) {
-				raw_offset_ = 0;
-			}
-		}
-
-		for (int i = 0; i < len * 2; i++) {
-			buffer[i] = bgQueue.pop_front();
+				break;
+			pcm->insert(pcm->end(), buffer_, buffer_ + outBytes / 2);
 		}
-		return true;
+		return !pcm->empty();
 	}
 
 private:
@@ -158,15 +151,22 @@ private:
 	int raw_data_size_;
 	int raw_offset_;
 	int raw_bytes_per_frame_;
-	FixedSizeQueue<s16, 128 * 1024> bgQueue;
 	short *buffer_;
 	SimpleAudio *decoder_;
 };
 
+// Decoded PCM for one game's SND0.AT3, produced by the decode worker below.
+// An empty pcm means the decode failed (or the file had no sound), which we
+// also cache so we don't retry every mix callback.
+struct DecodedSnd {
+	std::string path;
+	std::vector<s16> pcm;
+};
+
 static std::mutex bgMutex;
 static std::string bgGamePath;
 static int playbackOffset;
-static AT3PlusReader *at3Reader;
+static std::shared_ptr<DecodedSnd> playingSnd;
 static double gameLastChanged;
 static double lastPlaybackTime;
 static int buffer[44100];
@@ -174,17 +174,84 @@ static bool fadingOut = true;
 static float volume;
 static float delta = -0.0001f;
 
+// Decoding happens on a worker thread so the audio callback never calls into
+// the codec, and recently decoded previews are kept around so moving back and
+// forth in the game list doesn't re-decode.
+static std::mutex sndCacheLock;
+static std::condition_variable sndCacheCond;
+static bool sndThreadStarted;
+static bool sndDecodePending;
+static std::string sndPendingPath;
+static std::string sndPendingData;
+static std::string sndQueuedPath;
+static std::vector<std::shared_ptr<DecodedSnd>> sndCache;
+
+static const size_t SND_CACHE_SIZE = 4;
+
+// sndCacheLock must be held.
+static std::shared_ptr<DecodedSnd> FindCachedSnd(const std::string &path) {
+	for (size_t i = 0; i < sndCache.size(); i++) {
+		if (sndCache[i]->path == path) {
+			// Move to the front - the back is what gets evicted.
+			std::shared_ptr<DecodedSnd> snd = sndCache[i];
+			sndCache.erase(sndCache.begin() + i);
+			sndCache.insert(sndCache.begin(), snd);
+			return snd;
+		}
+	}
+	return std::shared_ptr<DecodedSnd>();
+}
+
+static void SndDecodeThread() {
+	setCurrentThreadName("SndDecode");
+	std::unique_lock<std::mutex> guard(sndCacheLock);
+	while (true) {
+		while (!sndDecodePending)
+			sndCacheCond.wait(guard);
+
+		std::string path = sndPendingPath;
+		std::string data = std::move(sndPendingData);
+		sndPendingData.clear();
+		sndDecodePending = false;
+		guard.unlock();
+
+		std::shared_ptr<DecodedSnd> snd(new DecodedSnd());
+		snd->path = path;
+		AT3PlusReader reader(data);
+		if (reader.IsOK()) {
+			reader.ReadAll(&snd->pcm);
+		}
+		reader.Shutdown();
+
+		guard.lock();
+		sndCache.insert(sndCache.begin(), snd);
+		while (sndCache.size() > SND_CACHE_SIZE) {
+			sndCache.pop_back();
+		}
+	}
+}
+
+// sndCacheLock must be held.
+static void QueueSndDecode(const std::string &path, const std::string &data) {
+	if (!sndThreadStarted) {
+		std::thread(&SndDecodeThread).detach();
+		sndThreadStarted = true;
+	}
+	sndPendingPath = path;
+	sndPendingData = data;
+	sndDecodePending = true;
+	sndQueuedPath = path;
+	sndCacheCond.notify_one();
+}
+
 static void ClearBackgroundAudio(bool hard) {
 	if (!hard) {
 		fadingOut = true;
 		volume = 1.0f;
 		return;
 	}
-	if (at3Reader) {
-		at3Reader->Shutdown();
-		delete at3Reader;
-		at3Reader = nullptr;
-	}
+	// The decoded data stays in the cache so coming back to the game is instant.
+	playingSnd.reset();
 	playbackOffset = 0;
 }
 
@@ -223,47 +290,58 @@ int PlayBackgroundAudio() {
 
 	// If there's a game, and some time has passed since the selected game
 	// last changed... (to prevent crazy amount of reads when skipping through a list)
-	if (!at3Reader && bgGamePath.size() && (time_now_d() - gameLastChanged > 0.5)) {
-		// Grab some audio from the current game and play it.
-		if (!g_gameInfoCache)
-			return 0;  // race condition?
-
-		std::shared_ptr<GameInfo> gameInfo = g_gameInfoCache->GetInfo(NULL, bgGamePath, GAMEINFO_WANTSND);
-		if (!gameInfo)
-			return 0;
-
-		if (gameInfo->pending) {
-			// Should try again shortly..
-			return 0;
-		}
-
-		if (gameInfo->sndFileData.size()) {
-			const std::string &data = gameInfo->sndFileData;
-			at3Reader = new AT3PlusReader(data);
+	if (!playingSnd && bgGamePath.size() && (time_now_d() - gameLastChanged > 0.5)) {
+		std::lock_guard<std::mutex> cacheGuard(sndCacheLock);
+		playingSnd = FindCachedSnd(bgGamePath);
+		if (playingSnd) {
+			playbackOffset = 0;
 			lastPlaybackTime = 0.0;
+		} else if (sndQueuedPath != bgGamePath) {
+			// Not cached and not being decoded - grab the file data and hand it
+			// to the worker. The actual decode never runs on this thread.
+			if (!g_gameInfoCache)
+				return 0;  // race condition?
+
+			std::shared_ptr<GameInfo> gameInfo = g_gameInfoCache->GetInfo(NULL, bgGamePath, GAMEINFO_WANTSND);
+			if (!gameInfo)
+				return 0;
+
+			if (gameInfo->pending) {
+				// Should try again shortly..
+				return 0;
+			}
+
+			if (gameInfo->sndFileData.size()) {
+				QueueSndDecode(bgGamePath, gameInfo->sndFileData);
+			}
 		}
 	}
 
 	double now = time_now();
-	if (at3Reader) {
+	if (playingSnd && !playingSnd->pcm.empty()) {
+		const std::vector<s16> &pcm = playingSnd->pcm;
 		int sz = lastPlaybackTime <= 0.0 ? 44100 / 60 : (int)((now - lastPlaybackTime) * 44100);
 		sz = std::min((int)ARRAY_SIZE(buffer) / 2, sz);
 		if (sz >= 16) {
-			if (at3Reader->Read(buffer, sz)) {
-				if (!fadingOut) {
-					__PushExternalAudio(buffer, sz);
-				} else {
-					for (int i = 0; i < sz*2; i += 2) {
-						buffer[i] *= volume;
-						buffer[i + 1] *= volume;
-						volume += delta;
-					}
-					__PushExternalAudio(buffer, sz);
-					if (volume <= 0.0f) {
-						ClearBackgroundAudio(true);
-						fadingOut = false;
-						gameLastChanged = 0;
-					}
+			for (int i = 0; i < sz * 2; i++) {
+				buffer[i] = pcm[playbackOffset];
+				// loop!
+				if (++playbackOffset >= (int)pcm.size())
+					playbackOffset = 0;
+			}
+			if (!fadingOut) {
+				__PushExternalAudio(buffer, sz);
+			} else {
+				for (int i = 0; i < sz*2; i += 2) {
+					buffer[i] *= volume;
+					buffer[i + 1] *= volume;
+					volume += delta;
+				}
+				__PushExternalAudio(buffer, sz);
+				if (volume <= 0.0f) {
+					ClearBackgroundAudio(true);
+					fadingOut = false;
+					gameLastChanged = 0;
 				}
 			}
 			lastPlaybackTime = now;
@@ -28,6 +28,7 @@
 
 #include "Common/LogManager.h"
 #include "Common/CPUDetect.h"
+#include "Common/FileUtil.h"
 
 #include "Core/MemMap.h"
 #include "Core/Config.h"
@@ -82,8 +83,10 @@ void DevMenu::CreatePopupContents(UI::ViewGroup *parent) {
 	items->Add(new Choice(dev->T("Toggle Freeze")))->OnClick.Handle(this, &DevMenu::OnFreezeFrame);
 	items->Add(new Choice(dev->T("Dump Frame GPU Commands")))->OnClick.Handle(this, &DevMenu::OnDumpFrame);
 	items->Add(new Choice(dev->T("Toggle Audio Debug")))->OnClick.Handle(this, &DevMenu::OnToggleAudioDebug);
+	items->Add(new CheckBox(&g_Config.bShowPerfStats, dev->T("Frame Time Stats"), ""));
 #ifdef USE_PROFILER
 	items->Add(new CheckBox(&g_Config.bShowFrameProfiler, dev->T("Frame Profiler"), ""));
+	items->Add(new Choice(dev->T("Dump Frame Profile")))->OnClick.Handle(this, &DevMenu::OnDumpProfile);
 #endif
 
 	scroll->Add(items);
@@ -95,6 +98,15 @@ void DevMenu::CreatePopupContents(UI::ViewGroup *parent) {
 	}
 }
 
+#ifdef USE_PROFILER
+UI::EventReturn DevMenu::OnDumpProfile(UI::EventParams &e) {
+	std::string path = GetSysDirectory(DIRECTORY_DUMP);
+	File::CreateFullPath(path);
+	Profiler_DumpHistory((path + "frame_profile.bin").c_str());
+	return UI::EVENT_DONE;
+}
+#endif
+
 UI::EventReturn DevMenu::OnToggleAudioDebug(UI::EventParams &e) {
 	g_Config.bShowAudioDebug = !g_Config.bShowAudioDebug;
 	return UI::EVENT_DONE;
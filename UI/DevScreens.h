@@ -45,6 +45,7 @@ protected:
 	UI::EventReturn OnDumpFrame(UI::EventParams &e);
 	UI::EventReturn OnDeveloperTools(UI::EventParams &e);
 	UI::EventReturn OnToggleAudioDebug(UI::EventParams &e);
+	UI::EventReturn OnDumpProfile(UI::EventParams &e);
 };
 
 class JitDebugScreen : public UIDialogScreenWithBackground {
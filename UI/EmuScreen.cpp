@@ -1180,6 +1180,100 @@ static void DrawFPS(DrawBuffer *draw2d, const Bounds &bounds) {
 	draw2d->SetFontScale(1.0f, 1.0f);
 }
 
+// Tracks the time between calls (we get called once per rendered frame) and
+// shows percentile frame times over a sliding window, plus the last few
+// hitches attributed to the profiler category that ate the most time that
+// frame. Cheaper than hooking up capture hardware when chasing stutters.
+static void DrawFrameTimeStats(DrawBuffer *draw2d, const Bounds &bounds) {
+	enum {
+		WINDOW_SIZE = 512,
+		MAX_HITCHES = 6,
+	};
+	struct Hitch {
+		int frame;
+		float ms;
+		const char *category;
+	};
+	static double frameTimes[WINDOW_SIZE];
+	static int framePos = 0;
+	static int frameCount = 0;
+	static double lastFrameTime = 0.0;
+	static Hitch hitches[MAX_HITCHES];
+	static int numHitches = 0;
+
+	double now = time_now_d();
+	double ft = now - lastFrameTime;
+	lastFrameTime = now;
+	// First call, or we sat in a menu / were stepping - not a frame.
+	if (ft <= 0.0 || ft > 1.0)
+		return;
+
+	frameTimes[framePos] = ft;
+	framePos = (framePos + 1) % WINDOW_SIZE;
+	frameCount++;
+
+	int n = frameCount < WINDOW_SIZE ? frameCount : WINDOW_SIZE;
+	static double sorted[WINDOW_SIZE];
+	std::copy(frameTimes, frameTimes + n, sorted);
+	std::nth_element(sorted, sorted + n / 2, sorted + n);
+	double p50 = sorted[n / 2];
+	std::nth_element(sorted, sorted + n * 95 / 100, sorted + n);
+	double p95 = sorted[n * 95 / 100];
+	std::nth_element(sorted, sorted + n * 99 / 100, sorted + n);
+	double p99 = sorted[n * 99 / 100];
+
+	// A hitch is a frame that took half again the typical time, and long
+	// enough to be visible at all. Wait for the window to warm up first.
+	double hitchThreshold = std::max(p50 * 1.5, 0.020);
+	if (ft > hitchThreshold && n >= 60) {
+		const char *category = "?";
+#ifdef USE_PROFILER
+		// Find the category that ate the most time, summed across threads, in
+		// the frame that just completed. Since entering a child scope suspends
+		// the parent, these times are exclusive - so this names the actual
+		// work (shadercomp, decodetex, io_rw...), not some outer loop.
+		int historyLength = Profiler_GetHistoryLength();
+		static std::vector<float> buf;
+		buf.resize(historyLength);
+		float maxTime = 0.0f;
+		for (int c = 0; c < Profiler_GetNumCategories(); c++) {
+			const char *name = Profiler_GetCategoryName(c);
+			if (!strcmp(name, "timing"))
+				continue;
+			float sum = 0.0f;
+			for (int t = 0; t < Profiler_GetNumThreads(); t++) {
+				Profiler_GetHistory(c, t, &buf[0], historyLength);
+				sum += buf[historyLength - 2];
+			}
+			if (sum > maxTime) {
+				maxTime = sum;
+				category = name;
+			}
+		}
+#endif
+		if (numHitches == MAX_HITCHES) {
+			std::copy(hitches + 1, hitches + MAX_HITCHES, hitches);
+			numHitches--;
+		}
+		hitches[numHitches++] = Hitch{ gpuStats.numFlips, (float)(ft * 1000.0), category };
+	}
+
+	char statbuf[1024];
+	int len = snprintf(statbuf, sizeof(statbuf),
+		"Frame: p50 %0.1fms  p95 %0.1fms  p99 %0.1fms\n",
+		p50 * 1000.0, p95 * 1000.0, p99 * 1000.0);
+	for (int i = numHitches - 1; i >= 0 && len < (int)sizeof(statbuf); i--) {
+		len += snprintf(statbuf + len, sizeof(statbuf) - len, "%0.1fms @ frame %d: %s\n",
+			hitches[i].ms, hitches[i].frame, hitches[i].category);
+	}
+
+	float y = bounds.y2() - 160.0f;
+	draw2d->SetFontScale(0.7f, 0.7f);
+	draw2d->DrawText(UBUNTU24, statbuf, bounds.x + 11, y + 1, 0xc0000000, FLAG_DYNAMIC_ASCII);
+	draw2d->DrawText(UBUNTU24, statbuf, bounds.x + 10, y, 0xFFFFFFFF, FLAG_DYNAMIC_ASCII);
+	draw2d->SetFontScale(1.0f, 1.0f);
+}
+
 void EmuScreen::preRender() {
 	using namespace Draw;
 	DrawContext *draw = screenManager()->getDrawContext();
@@ -1313,7 +1407,7 @@ bool EmuScreen::hasVisibleUI() {
 		return true;
 
 	// Debug UI.
-	if (g_Config.bShowDebugStats || g_Config.bShowDeveloperMenu || g_Config.bShowAudioDebug || g_Config.bShowFrameProfiler)
+	if (g_Config.bShowDebugStats || g_Config.bShowDeveloperMenu || g_Config.bShowAudioDebug || g_Config.bShowFrameProfiler || g_Config.bShowPerfStats)
 		return true;
 
 	return false;
@@ -1355,6 +1449,10 @@ void EmuScreen::renderUI() {
 		DrawFPS(draw2d, ctx->GetBounds());
 	}
 
+	if (g_Config.bShowPerfStats && !invalid_) {
+		DrawFrameTimeStats(draw2d, ctx->GetBounds());
+	}
+
 #if !PPSSPP_PLATFORM(UWP)
 	if (g_Config.iGPUBackend == (int)GPUBackend::VULKAN && g_Config.bShowAllocatorDebug) {
 		DrawAllocatorVis(ctx, gpu);
@@ -332,6 +332,156 @@ static bool ReadVFSToString(const char *filename, std::string *contents, std::mu
 }
 
 
+// Persistent store of the cheap-to-display metadata (SFO fields and icon
+// data), keyed by game path and validated against the file's size and mtime.
+// Without it, cold-starting the games grid has to crack open every ISO/PBP
+// again just to show the same icons and titles as last session.
+
+struct StoredGameInfo {
+	u64 size = 0;
+	u64 mtime = 0;
+	int fileType = 0;
+	int region = -1;
+	int disc_total = 0;
+	int disc_number = 0;
+	std::string title;
+	std::string id;
+	std::string id_version;
+	std::string sfo;
+	std::string icon;
+};
+
+class GameInfoStore {
+public:
+	void Load();
+	void SaveIfDirty();
+
+	bool Get(const std::string &path, u64 size, u64 mtime, StoredGameInfo *out) {
+		std::lock_guard<std::mutex> guard(lock_);
+		auto iter = entries_.find(path);
+		if (iter == entries_.end() || iter->second.size != size || iter->second.mtime != mtime)
+			return false;
+		*out = iter->second;
+		return true;
+	}
+
+	void Set(const std::string &path, const StoredGameInfo &entry) {
+		std::lock_guard<std::mutex> guard(lock_);
+		entries_[path] = entry;
+		dirty_ = true;
+	}
+
+private:
+	std::string Filename() const {
+		return GetSysDirectory(DIRECTORY_CACHE) + "gameinfo.cache";
+	}
+
+	std::mutex lock_;
+	std::map<std::string, StoredGameInfo> entries_;
+	bool dirty_ = false;
+};
+
+static GameInfoStore g_gameInfoStore;
+
+// Fixed-size part of a stored entry, for fread/fwrite convenience.
+struct StoredGameInfoHeader {
+	u64 size;
+	u64 mtime;
+	s32 fileType;
+	s32 region;
+	s32 disc_total;
+	s32 disc_number;
+};
+
+static void WriteLenString(FILE *f, const std::string &str) {
+	u32 len = (u32)str.size();
+	fwrite(&len, sizeof(len), 1, f);
+	if (len)
+		fwrite(str.data(), 1, len, f);
+}
+
+static bool ReadLenString(FILE *f, std::string *str) {
+	u32 len;
+	if (fread(&len, sizeof(len), 1, f) != 1 || len > 0x4000000)
+		return false;
+	str->resize(len);
+	return len == 0 || fread(&(*str)[0], 1, len, f) == len;
+}
+
+void GameInfoStore::Load() {
+	std::lock_guard<std::mutex> guard(lock_);
+	entries_.clear();
+	dirty_ = false;
+
+	FILE *f = File::OpenCFile(Filename(), "rb");
+	if (!f)
+		return;
+
+	char magic[4];
+	u32 version = 0, count = 0;
+	bool good = fread(magic, 4, 1, f) == 1 && memcmp(magic, "PGIC", 4) == 0;
+	good = good && fread(&version, 4, 1, f) == 1 && version == 1;
+	good = good && fread(&count, 4, 1, f) == 1 && count <= 100000;
+
+	for (u32 i = 0; good && i < count; ++i) {
+		std::string path;
+		StoredGameInfoHeader header;
+		StoredGameInfo entry;
+		good = ReadLenString(f, &path);
+		good = good && fread(&header, sizeof(header), 1, f) == 1;
+		good = good && ReadLenString(f, &entry.title);
+		good = good && ReadLenString(f, &entry.id);
+		good = good && ReadLenString(f, &entry.id_version);
+		good = good && ReadLenString(f, &entry.sfo);
+		good = good && ReadLenString(f, &entry.icon);
+		if (good) {
+			entry.size = header.size;
+			entry.mtime = header.mtime;
+			entry.fileType = header.fileType;
+			entry.region = header.region;
+			entry.disc_total = header.disc_total;
+			entry.disc_number = header.disc_number;
+			entries_[path] = std::move(entry);
+		}
+	}
+	fclose(f);
+
+	if (!good) {
+		// Corrupt - drop it, the data will simply be regenerated.
+		entries_.clear();
+	}
+}
+
+void GameInfoStore::SaveIfDirty() {
+	std::lock_guard<std::mutex> guard(lock_);
+	if (!dirty_)
+		return;
+
+	File::CreateFullPath(GetSysDirectory(DIRECTORY_CACHE));
+	FILE *f = File::OpenCFile(Filename(), "wb");
+	if (!f)
+		return;
+
+	u32 version = 1;
+	u32 count = (u32)entries_.size();
+	fwrite("PGIC", 4, 1, f);
+	fwrite(&version, 4, 1, f);
+	fwrite(&count, 4, 1, f);
+	for (const auto &item : entries_) {
+		const StoredGameInfo &entry = item.second;
+		WriteLenString(f, item.first);
+		StoredGameInfoHeader header = { entry.size, entry.mtime, entry.fileType, entry.region, entry.disc_total, entry.disc_number };
+		fwrite(&header, sizeof(header), 1, f);
+		WriteLenString(f, entry.title);
+		WriteLenString(f, entry.id);
+		WriteLenString(f, entry.id_version);
+		WriteLenString(f, entry.sfo);
+		WriteLenString(f, entry.icon);
+	}
+	fclose(f);
+	dirty_ = false;
+}
+
 class GameInfoWorkItem : public PrioritizedWorkQueueItem {
 public:
 	GameInfoWorkItem(const std::string &gamePath, std::shared_ptr<GameInfo> &info)
@@ -354,6 +504,48 @@ public:
 		}
 
 		info_->working = true;
+
+		// Try the persistent store first - a hit means we don't need to open
+		// the ISO/PBP at all.  Only the plain grid lookup goes through it;
+		// backgrounds, sound, and sizes still require the real file.
+		const bool storeUsable = (info_->wantFlags & (GAMEINFO_WANTBG | GAMEINFO_WANTSND | GAMEINFO_WANTSIZE | GAMEINFO_WANTBGDATA)) == 0 && !info_->GetFileLoader()->IsRemote();
+		u64 storeSize = 0;
+		u64 storeMtime = 0;
+		if (storeUsable) {
+			std::string statPath = gamePath_;
+			if (File::IsDirectory(statPath)) {
+				// Validate against the EBOOT when there is one.
+				const std::string eboot = ResolvePBPFile(statPath);
+				if (File::Exists(eboot))
+					statPath = eboot;
+			}
+			File::FileDetails details;
+			if (File::GetFileDetails(statPath, &details)) {
+				storeSize = details.size;
+				storeMtime = details.mtime;
+				StoredGameInfo stored;
+				if (g_gameInfoStore.Get(gamePath_, storeSize, storeMtime, &stored)) {
+					info_->SetTitle(stored.title);
+					std::lock_guard<std::mutex> lock(info_->lock);
+					info_->fileType = (IdentifiedFileType)stored.fileType;
+					if (!stored.sfo.empty())
+						info_->paramSFO.ReadSFO((const u8 *)stored.sfo.data(), stored.sfo.size());
+					info_->id = stored.id;
+					info_->id_version = stored.id_version;
+					info_->disc_total = stored.disc_total;
+					info_->disc_number = stored.disc_number;
+					info_->region = stored.region;
+					info_->paramSFOLoaded = true;
+					info_->icon.data = stored.icon;
+					info_->icon.dataLoaded = true;
+					info_->hasConfig = g_Config.hasGameConfig(info_->id);
+					info_->pending = false;
+					info_->working = false;
+					return;
+				}
+			}
+		}
+
 		info_->fileType = Identify_File(info_->GetFileLoader().get());
 		switch (info_->fileType) {
 		case IdentifiedFileType::PSP_PBP:
@@ -623,6 +815,43 @@ handleELF:
 
 		info_->hasConfig = g_Config.hasGameConfig(info_->id);
 
+		// Remember what we just dug out for next session.  Only the common
+		// formats - savestates, archives, and the like stay cheap anyway.
+		if (storeUsable && storeSize != 0) {
+			switch (info_->fileType) {
+			case IdentifiedFileType::PSP_ISO:
+			case IdentifiedFileType::PSP_ISO_NP:
+			case IdentifiedFileType::PSP_PBP:
+			case IdentifiedFileType::PSP_PBP_DIRECTORY:
+			{
+				StoredGameInfo stored;
+				stored.size = storeSize;
+				stored.mtime = storeMtime;
+				stored.title = info_->GetTitle();
+
+				std::lock_guard<std::mutex> lock(info_->lock);
+				stored.fileType = (int)info_->fileType;
+				stored.region = info_->region;
+				stored.disc_total = info_->disc_total;
+				stored.disc_number = info_->disc_number;
+				stored.id = info_->id;
+				stored.id_version = info_->id_version;
+				if (info_->paramSFOLoaded) {
+					u8 *sfoData = nullptr;
+					size_t sfoSize = 0;
+					if (info_->paramSFO.WriteSFO(&sfoData, &sfoSize))
+						stored.sfo.assign((const char *)sfoData, sfoSize);
+					delete[] sfoData;
+				}
+				stored.icon = info_->icon.data;
+				g_gameInfoStore.Set(gamePath_, stored);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
 		if (info_->wantFlags & GAMEINFO_WANTSIZE) {
 			std::lock_guard<std::mutex> lock(info_->lock);
 			info_->gameSize = info_->GetGameSizeInBytes();
@@ -660,6 +889,7 @@ GameInfoCache::~GameInfoCache() {
 }
 
 void GameInfoCache::Init() {
+	g_gameInfoStore.Load();
 	gameInfoWQ_ = new PrioritizedWorkQueue();
 	ProcessWorkQueueOnThreadWhile(gameInfoWQ_);
 }
@@ -672,6 +902,7 @@ void GameInfoCache::Shutdown() {
 		delete gameInfoWQ_;
 		gameInfoWQ_ = nullptr;
 	}
+	g_gameInfoStore.SaveIfDirty();
 }
 
 void GameInfoCache::Clear() {
@@ -682,6 +913,8 @@ void GameInfoCache::Clear() {
 		gameInfoWQ_->WaitUntilDone();
 	}
 	info_.clear();
+	// A good moment to flush the persistent store, too.
+	g_gameInfoStore.SaveIfDirty();
 }
 
 void GameInfoCache::CancelAll() {
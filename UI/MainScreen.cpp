@@ -458,6 +458,13 @@ void GameBrowser::SetPath(const std::string &path) {
 	Refresh();
 }
 
+void GameBrowser::Update() {
+	LinearLayout::Update();
+	if (listingPending_ && path_.IsListingReady()) {
+		Refresh();
+	}
+}
+
 UI::EventReturn GameBrowser::LayoutChange(UI::EventParams &e) {
 	*gridStyle_ = e.a == 0 ? true : false;
 	Refresh();
@@ -556,11 +563,18 @@ void GameBrowser::Refresh() {
 	std::vector<DirButton *> dirButtons;
 	std::vector<GameButton *> gameButtons;
 
+	listingPending_ = false;
+
 	std::vector<std::string> filenames;
 	if (HasSpecialFiles(filenames)) {
 		for (size_t i = 0; i < filenames.size(); i++) {
 			gameButtons.push_back(new GameButton(filenames[i], *gridStyle_, new UI::LinearLayoutParams(*gridStyle_ == true ? UI::WRAP_CONTENT : UI::FILL_PARENT, UI::WRAP_CONTENT)));
 		}
+	} else if (!path_.IsListingReady()) {
+		// The scan runs on the browser's worker thread so that slow paths (like
+		// network mounts) don't hang the menu. Update() re-runs Refresh() when done.
+		listingPending_ = true;
+		gameList_->Add(new UI::TextView(mm->T("Loading..."), ALIGN_CENTER, true, new UI::LinearLayoutParams(UI::FILL_PARENT, UI::FILL_PARENT)));
 	} else {
 		std::vector<FileInfo> fileInfo;
 		path_.GetListing(fileInfo, "iso:cso:pbp:elf:prx:ppdmp:");
@@ -36,6 +36,7 @@ public:
 
 	void FocusGame(const std::string &gamePath);
 	void SetPath(const std::string &path);
+	void Update() override;
 
 protected:
 	virtual bool DisplayTopBar();
@@ -66,6 +67,8 @@ private:
 	int flags_;
 	UI::Choice *homebrewStoreButton_;
 	std::string focusGamePath_;
+	// The directory is still being scanned on the browser's worker thread.
+	bool listingPending_ = false;
 };
 
 class RemoteISOBrowseScreen;
@@ -120,8 +120,12 @@ void AsyncImageFileView::Draw(UIContext &dc) {
 	using namespace Draw;
 	if (!texture_ && !textureFailed_ && !filename_.empty()) {
 		texture_ = CreateTextureFromFile(dc.GetDrawContext(), filename_.c_str(), DETECT, true);
-		if (!texture_.get())
+		if (!texture_.get()) {
 			textureFailed_ = true;
+		} else {
+			// The content size just became known, so remeasure.
+			UI::RequestLayout();
+		}
 	}
 
 	if (HasFocus()) {
@@ -140,8 +140,12 @@ void HttpImageFileView::Draw(UIContext &dc) {
 
 	if (!textureData_.empty()) {
 		texture_ = CreateTextureFromFileData(dc.GetDrawContext(), (const uint8_t *)(textureData_.data()), (int)textureData_.size(), DETECT);
-		if (!texture_)
+		if (!texture_) {
 			textureFailed_ = true;
+		} else {
+			// The content size just became known, so remeasure.
+			UI::RequestLayout();
+		}
 		textureData_.clear();
 		download_.reset();
 	}
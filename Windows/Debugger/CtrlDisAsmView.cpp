@@ -984,7 +984,7 @@ void CtrlDisAsmView::onMouseUp(WPARAM wParam, LPARAM lParam, int button)
 						MIPSAnalyst::RegisterFunction(funcBegin, funcSize, newname.c_str());
 						MIPSAnalyst::UpdateHashMap();
 						MIPSAnalyst::ApplyHashMap();
-						SendMessage(GetParent(wnd),WM_DEB_MAPLOADED,0,0);
+						SendMessage(GetParent(wnd),WM_DEB_MAPLOADED,funcBegin,funcSize);
 						redraw();
 					}
 				}
@@ -1000,18 +1000,21 @@ void CtrlDisAsmView::onMouseUp(WPARAM wParam, LPARAM lParam, int button)
 				u32 funcBegin = g_symbolMap->GetFunctionStart(curAddress);
 				if (funcBegin != -1)
 				{
+					u32 funcSize = g_symbolMap->GetFunctionSize(funcBegin);
 					u32 prevBegin = g_symbolMap->GetFunctionStart(funcBegin-1);
 					if (prevBegin != -1)
 					{
-						u32 expandedSize = g_symbolMap->GetFunctionSize(prevBegin) + g_symbolMap->GetFunctionSize(funcBegin);
+						u32 expandedSize = g_symbolMap->GetFunctionSize(prevBegin) + funcSize;
 						g_symbolMap->SetFunctionSize(prevBegin,expandedSize);
 					}
-					
+
 					g_symbolMap->RemoveFunction(funcBegin,true);
 					g_symbolMap->SortSymbols();
-					manager.clear();
 
-					SendMessage(GetParent(wnd), WM_DEB_MAPLOADED, 0, 0);
+					// Only the removed function (and the one that may have
+					// absorbed it) changed.
+					u32 rangeStart = prevBegin != -1 ? prevBegin : funcBegin;
+					SendMessage(GetParent(wnd), WM_DEB_MAPLOADED, rangeStart, funcBegin + funcSize - rangeStart);
 				}
 				else
 				{
@@ -1043,9 +1046,9 @@ void CtrlDisAsmView::onMouseUp(WPARAM wParam, LPARAM lParam, int button)
 						snprintf(symname,128,"u_un_%08X",curAddress);
 						g_symbolMap->AddFunction(symname,curAddress,newSize);
 						g_symbolMap->SortSymbols();
-						manager.clear();
 
-						SendMessage(GetParent(wnd), WM_DEB_MAPLOADED, 0, 0);
+						// The split only affects the original function's range.
+						SendMessage(GetParent(wnd), WM_DEB_MAPLOADED, prevBegin, prevSize);
 					}
 				}
 				else
@@ -1056,7 +1059,7 @@ void CtrlDisAsmView::onMouseUp(WPARAM wParam, LPARAM lParam, int button)
 					g_symbolMap->AddFunction(symname, selectRangeStart, newSize);
 					g_symbolMap->SortSymbols();
 
-					SendMessage(GetParent(wnd), WM_DEB_MAPLOADED, 0, 0);
+					SendMessage(GetParent(wnd), WM_DEB_MAPLOADED, selectRangeStart, newSize);
 				}
 				redraw();
 			}
@@ -102,6 +102,7 @@ public:
 	void redraw();
 	void scanFunctions();
 	void clearFunctions() { manager.clear(); };
+	void invalidateFunctions(u32 address, u32 size) { manager.invalidate(address, size); };
 
 	void getOpcodeText(u32 address, char* dest, int bufsize);
 	int getRowHeight() { return rowHeight; };
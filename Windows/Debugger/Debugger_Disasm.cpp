@@ -608,7 +608,7 @@ BOOL CDisasm::DlgProc(UINT message, WPARAM wParam, LPARAM lParam)
 		}
 
 	case WM_DEB_MAPLOADED:
-		NotifyMapLoaded();
+		NotifyMapLoaded((u32)wParam, (u32)lParam);
 		break;
 
 	case WM_DEB_GOTOWPARAM:
@@ -860,11 +860,14 @@ void CDisasm::SetDebugMode(bool _bDebug, bool switchPC)
 	}
 }
 
-void CDisasm::NotifyMapLoaded()
+void CDisasm::NotifyMapLoaded(u32 address, u32 size)
 {
 	g_symbolMap->FillSymbolListBox(GetDlgItem(m_hDlg, IDC_FUNCTIONLIST),ST_FUNCTION);
 	CtrlDisAsmView *ptr = CtrlDisAsmView::getFrom(GetDlgItem(m_hDlg,IDC_DISASMVIEW));
-	ptr->clearFunctions();
+	if (size != 0)
+		ptr->invalidateFunctions(address, size);
+	else
+		ptr->clearFunctions();
 	ptr->redraw();
 }
 
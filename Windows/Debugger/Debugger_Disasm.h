@@ -60,5 +60,7 @@ public:
 	void SetDebugMode(bool _bDebug, bool switchPC);
 	// show dialog
 	void Goto(u32 addr);
-	void NotifyMapLoaded();
+	// With a non-zero size, only the given range is reanalyzed (for symbol
+	// edits that touch a known range.) Otherwise everything is rebuilt.
+	void NotifyMapLoaded(u32 address = 0, u32 size = 0);
 };
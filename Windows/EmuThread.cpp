@@ -69,6 +69,7 @@ bool MainThread_Ready() {
 
 static void EmuThreadFunc(GraphicsContext *graphicsContext) {
 	setCurrentThreadName("Emu");
+	setCurrentThreadRole(ThreadRole::EMULATION);
 
 	// There's no real requirement that NativeInit happen on this thread.
 	// We just call the update/render loop here.
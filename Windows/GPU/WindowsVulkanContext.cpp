@@ -96,6 +96,8 @@ bool WindowsVulkanContext::Init(HINSTANCE hInst, HWND hWnd, std::string *error_m
 		g_Vulkan = nullptr;
 		return false;
 	}
+	g_Vulkan->UpdateInflightFrames(g_Config.iInflightFrames);
+
 	// int vulkanFlags = VULKAN_FLAG_PRESENT_FIFO_RELAXED;
 	VulkanContext::CreateInfo info{};
 	info.app_name = "PPSSPP";
@@ -95,6 +95,8 @@ bool AndroidVulkanContext::InitAPI() {
 	if (!g_Vulkan) {
 		g_Vulkan = new VulkanContext();
 	}
+	g_Vulkan->UpdateInflightFrames(g_Config.iInflightFrames);
+
 	VulkanContext::CreateInfo info{};
 	info.app_name = "PPSSPP";
 	info.app_ver = gitVer.ToInteger();
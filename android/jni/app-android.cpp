@@ -172,6 +172,7 @@ static void EmuThreadFunc() {
 	gJvm->AttachCurrentThread(&env, nullptr);
 
 	setCurrentThreadName("Emu");
+	setCurrentThreadRole(ThreadRole::EMULATION);
 	ILOG("Entering emu thread");
 
 	// Wait for render loop to get started.
@@ -670,6 +671,7 @@ extern "C" void Java_org_ppsspp_ppsspp_NativeRenderer_displayRender(JNIEnv *env,
 	if (!hasSetThreadName) {
 		hasSetThreadName = true;
 		setCurrentThreadName("AndroidRender");
+		setCurrentThreadRole(ThreadRole::RENDER);
 	}
 	
 	if (useCPUThread) {
@@ -995,6 +997,7 @@ retry:
 		if (!hasSetThreadName) {
 			hasSetThreadName = true;
 			setCurrentThreadName("AndroidRender");
+			setCurrentThreadRole(ThreadRole::RENDER);
 		}
 	}
 
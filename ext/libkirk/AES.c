@@ -1279,6 +1279,138 @@ rijndael_encrypt(rijndael_ctx *ctx, const u8 *src, u8 *dst)
 	rijndaelEncrypt(ctx->ek, ctx->Nr, src, dst);
 }
 
+/*
+ * AES-NI acceleration, runtime-detected. The key schedules above store each
+ * round key word as a big-endian u32 (GETU32), so they are byte-swapped into
+ * the 128-bit layout the instructions expect. The decrypt schedule from
+ * rijndaelKeySetupDec is already in "equivalent inverse cipher" form, which
+ * is exactly what AESDEC wants.
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER) || defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+#define AES_USE_AESNI 1
+#endif
+#endif
+
+#ifdef AES_USE_AESNI
+
+#include <wmmintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AES_AESNI_ATTR
+#else
+#include <cpuid.h>
+/* Not compiled with AES enabled globally - enable it for just these functions. */
+#define AES_AESNI_ATTR __attribute__((target("aes,sse2")))
+#endif
+
+static int aes_has_aesni(void)
+{
+	static int supported = -1;
+	if (supported < 0) {
+#ifdef _MSC_VER
+		int regs[4];
+		__cpuid(regs, 1);
+		supported = (regs[2] >> 25) & 1;
+#else
+		unsigned int a, b, c, d;
+		if (__get_cpuid(1, &a, &b, &c, &d))
+			supported = (c >> 25) & 1;
+		else
+			supported = 0;
+#endif
+	}
+	return supported;
+}
+
+static u32 aes_swap32(u32 v)
+{
+	return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+AES_AESNI_ATTR
+static void aes_load_schedule(__m128i *key, const u32 *rk, int Nr)
+{
+	int i;
+	for (i = 0; i <= Nr; i++)
+		key[i] = _mm_set_epi32(aes_swap32(rk[i * 4 + 3]), aes_swap32(rk[i * 4 + 2]),
+		                       aes_swap32(rk[i * 4 + 1]), aes_swap32(rk[i * 4]));
+}
+
+AES_AESNI_ATTR
+static __m128i aes_encrypt_aesni(const __m128i *key, int Nr, __m128i s)
+{
+	int i;
+	s = _mm_xor_si128(s, key[0]);
+	for (i = 1; i < Nr; i++)
+		s = _mm_aesenc_si128(s, key[i]);
+	return _mm_aesenclast_si128(s, key[Nr]);
+}
+
+AES_AESNI_ATTR
+static __m128i aes_decrypt_aesni(const __m128i *key, int Nr, __m128i s)
+{
+	int i;
+	s = _mm_xor_si128(s, key[0]);
+	for (i = 1; i < Nr; i++)
+		s = _mm_aesdec_si128(s, key[i]);
+	return _mm_aesdeclast_si128(s, key[Nr]);
+}
+
+AES_AESNI_ATTR
+static void aes_encrypt_block_aesni(const AES_ctx *ctx, const u8 *src, u8 *dst)
+{
+	__m128i key[AES_MAXROUNDS + 1];
+	aes_load_schedule(key, ctx->ek, ctx->Nr);
+	_mm_storeu_si128((__m128i *)dst,
+	    aes_encrypt_aesni(key, ctx->Nr, _mm_loadu_si128((const __m128i *)src)));
+}
+
+AES_AESNI_ATTR
+static void aes_decrypt_block_aesni(const AES_ctx *ctx, const u8 *src, u8 *dst)
+{
+	__m128i key[AES_MAXROUNDS + 1];
+	aes_load_schedule(key, ctx->dk, ctx->Nr);
+	_mm_storeu_si128((__m128i *)dst,
+	    aes_decrypt_aesni(key, ctx->Nr, _mm_loadu_si128((const __m128i *)src)));
+}
+
+/* The schedule is converted once per buffer here, not once per block. */
+AES_AESNI_ATTR
+static void aes_cbc_encrypt_aesni(const AES_ctx *ctx, const u8 *src, u8 *dst, int size)
+{
+	__m128i key[AES_MAXROUNDS + 1];
+	/* No IV, matching AES_cbc_encrypt below: the first block is not chained. */
+	__m128i block = _mm_setzero_si128();
+	int i;
+	aes_load_schedule(key, ctx->ek, ctx->Nr);
+	for (i = 0; i < size; i += 16) {
+		block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i *)(src + i)));
+		block = aes_encrypt_aesni(key, ctx->Nr, block);
+		_mm_storeu_si128((__m128i *)(dst + i), block);
+	}
+}
+
+AES_AESNI_ATTR
+static void aes_cbc_decrypt_aesni(const AES_ctx *ctx, const u8 *src, u8 *dst, int size)
+{
+	__m128i key[AES_MAXROUNDS + 1];
+	__m128i prev, cur;
+	int i;
+	aes_load_schedule(key, ctx->dk, ctx->Nr);
+	prev = _mm_loadu_si128((const __m128i *)src);
+	_mm_storeu_si128((__m128i *)dst, aes_decrypt_aesni(key, ctx->Nr, prev));
+	for (i = 16; i < size; i += 16) {
+		cur = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_si128((__m128i *)(dst + i),
+		    _mm_xor_si128(aes_decrypt_aesni(key, ctx->Nr, cur), prev));
+		prev = cur;
+	}
+}
+
+#endif /* AES_USE_AESNI */
+
 int AES_set_key(AES_ctx *ctx, const u8 *key, int bits)
 {
 	return rijndael_set_key((rijndael_ctx *)ctx, key, bits);
@@ -1286,11 +1418,23 @@ int AES_set_key(AES_ctx *ctx, const u8 *key, int bits)
 
 void AES_decrypt(AES_ctx *ctx, const u8 *src, u8 *dst)
 {
+#ifdef AES_USE_AESNI
+	if (aes_has_aesni()) {
+		aes_decrypt_block_aesni(ctx, src, dst);
+		return;
+	}
+#endif
 	rijndaelDecrypt(ctx->dk, ctx->Nr, src, dst);
 }
 
 void AES_encrypt(AES_ctx *ctx, const u8 *src, u8 *dst)
 {
+#ifdef AES_USE_AESNI
+	if (aes_has_aesni()) {
+		aes_encrypt_block_aesni(ctx, src, dst);
+		return;
+	}
+#endif
 	rijndaelEncrypt(ctx->ek, ctx->Nr, src, dst);
 }
 
@@ -1307,8 +1451,14 @@ void xor_128(const unsigned char *a, const unsigned char *b, unsigned char *out)
 void AES_cbc_encrypt(AES_ctx *ctx, u8 *src, u8 *dst, int size)
 {
 	u8 block_buff[16];
-	
+
 	int i;
+#ifdef AES_USE_AESNI
+	if (aes_has_aesni()) {
+		aes_cbc_encrypt_aesni(ctx, src, dst, size);
+		return;
+	}
+#endif
 	for(i = 0; i < size; i+=16)
 	{
 		//step 1: copy block to dst
@@ -1330,7 +1480,13 @@ void AES_cbc_decrypt(AES_ctx *ctx, u8 *src, u8 *dst, int size)
 	u8 block_buff[16];
 	u8 block_buff_previous[16];
 	int i;
-	
+
+#ifdef AES_USE_AESNI
+	if (aes_has_aesni()) {
+		aes_cbc_decrypt_aesni(ctx, src, dst, size);
+		return;
+	}
+#endif
 	memcpy(block_buff, src, 16);
 	memcpy(block_buff_previous, src, 16);
 	AES_decrypt(ctx, src, dst);
@@ -222,7 +222,8 @@ bool Buffer::ReadAllWithProgress(int fd, int knownSize, float *progress, bool *c
 }
 
 int Buffer::Read(int fd, size_t sz) {
-	char buf[1024];
+	// Big enough that bounded entity reads don't splinter into tiny recvs.
+	char buf[16 * 1024];
 	int retval;
 	size_t received = 0;
 	while ((retval = recv(fd, buf, (int)std::min(sz, sizeof(buf)), 0)) > 0) {
@@ -21,6 +21,7 @@
 #include "file/vfs.h"
 
 #ifdef _WIN32
+#include <windows.h>
 #include "../util/text/utf8.h"
 	// Function Cross-Compatibility
 #define strcasecmp _stricmp
@@ -148,21 +149,48 @@ static std::string EscapeComments(const std::string &value) {
 	return result;
 }
 
+// Key and section lookups are case insensitive, so the indices are keyed on
+// the lowercased name.
+static std::string LowerKey(const std::string &key) {
+	std::string result = key;
+	for (size_t i = 0; i < result.size(); i++) {
+		if (result[i] >= 'A' && result[i] <= 'Z')
+			result[i] += 'a' - 'A';
+	}
+	return result;
+}
+
+void IniFile::Section::RebuildKeyIndex() const {
+	keyIndex_.clear();
+	for (size_t i = 0; i < lines.size(); i++) {
+		std::string lineKey;
+		ParseLine(lines[i], &lineKey, NULL, NULL);
+		if (!lineKey.empty()) {
+			// On duplicate keys, keep the first like the old linear scan did.
+			keyIndex_.insert(std::make_pair(LowerKey(lineKey), i));
+		}
+	}
+	keyIndexValid_ = true;
+}
+
 void IniFile::Section::Clear() {
+	if (!lines.empty())
+		dirty_ = true;
 	lines.clear();
+	keyIndex_.clear();
+	keyIndexValid_ = true;
 }
 
 std::string* IniFile::Section::GetLine(const char* key, std::string* valueOut, std::string* commentOut)
 {
-	for (std::vector<std::string>::iterator iter = lines.begin(); iter != lines.end(); ++iter)
-	{
-		std::string& line = *iter;
-		std::string lineKey;
-		ParseLine(line, &lineKey, valueOut, commentOut);
-		if (!strcasecmp(lineKey.c_str(), key))
-			return &line;
-	}
-	return 0;
+	if (!keyIndexValid_)
+		RebuildKeyIndex();
+	auto iter = keyIndex_.find(LowerKey(key));
+	if (iter == keyIndex_.end())
+		return 0;
+	std::string &line = lines[iter->second];
+	ParseLine(line, NULL, valueOut, commentOut);
+	return &line;
 }
 
 void IniFile::Section::Set(const char* key, const char* newValue)
@@ -171,13 +199,22 @@ void IniFile::Section::Set(const char* key, const char* newValue)
 	std::string* line = GetLine(key, &value, &commented);
 	if (line)
 	{
-		// Change the value - keep the key and comment
-		*line = StripSpaces(key) + " = " + EscapeComments(newValue) + commented;
+		// Change the value - keep the key and comment.  Only mark the section
+		// dirty if the line actually changed, so that saving an unchanged
+		// config can be skipped entirely.
+		std::string newLine = StripSpaces(key) + " = " + EscapeComments(newValue) + commented;
+		if (*line != newLine) {
+			*line = newLine;
+			dirty_ = true;
+		}
 	}
 	else
 	{
 		// The key did not already exist in this section - let's add it.
 		lines.push_back(std::string(key) + " = " + EscapeComments(newValue));
+		if (keyIndexValid_)
+			keyIndex_.insert(std::make_pair(LowerKey(StripSpaces(key)), lines.size() - 1));
+		dirty_ = true;
 	}
 }
 
@@ -243,7 +280,9 @@ void IniFile::Section::Set(const char* key, const std::vector<std::string>& newV
 }
 
 void IniFile::Section::AddComment(const std::string &comment) {
+	// Comment lines have no key, so the key index stays valid.
 	lines.push_back("# " + comment);
+	dirty_ = true;
 }
 
 bool IniFile::Section::Get(const char* key, std::vector<std::string>& values) 
@@ -326,14 +365,9 @@ bool IniFile::Section::Get(const char* key, double* value, double defaultValue)
 
 bool IniFile::Section::Exists(const char *key) const
 {
-	for (std::vector<std::string>::const_iterator iter = lines.begin(); iter != lines.end(); ++iter)
-	{
-		std::string lineKey;
-		ParseLine(*iter, &lineKey, NULL, NULL);
-		if (!strcasecmp(lineKey.c_str(), key))
-			return true;
-	}
-	return false;
+	if (!keyIndexValid_)
+		RebuildKeyIndex();
+	return keyIndex_.find(LowerKey(key)) != keyIndex_.end();
 }
 
 std::map<std::string, std::string> IniFile::Section::ToMap() const
@@ -352,34 +386,47 @@ std::map<std::string, std::string> IniFile::Section::ToMap() const
 
 bool IniFile::Section::Delete(const char *key)
 {
-	std::string* line = GetLine(key, 0, 0);
-	for (std::vector<std::string>::iterator liter = lines.begin(); liter != lines.end(); ++liter)
-	{
-		if (line == &*liter)
-		{
-			lines.erase(liter);
-			return true;
-		}
-	}
-	return false;
+	if (!keyIndexValid_)
+		RebuildKeyIndex();
+	auto iter = keyIndex_.find(LowerKey(key));
+	if (iter == keyIndex_.end())
+		return false;
+	lines.erase(lines.begin() + iter->second);
+	// The indices of all lines after the erased one just shifted.
+	keyIndexValid_ = false;
+	dirty_ = true;
+	return true;
 }
 
 // IniFile
 
+void IniFile::RebuildSectionIndex() const {
+	sectionIndex_.clear();
+	for (size_t i = 0; i < sections.size(); i++) {
+		// On duplicate names, keep the first like the old linear scan did.
+		sectionIndex_.insert(std::make_pair(LowerKey(sections[i].name()), i));
+	}
+	sectionIndexValid_ = true;
+}
+
 const IniFile::Section* IniFile::GetSection(const char* sectionName) const
 {
-	for (std::vector<Section>::const_iterator iter = sections.begin(); iter != sections.end(); ++iter)
-		if (!strcasecmp(iter->name().c_str(), sectionName))
-			return (&(*iter));
-	return 0;
+	if (!sectionIndexValid_)
+		RebuildSectionIndex();
+	auto iter = sectionIndex_.find(LowerKey(sectionName));
+	if (iter == sectionIndex_.end())
+		return 0;
+	return &sections[iter->second];
 }
 
 IniFile::Section* IniFile::GetSection(const char* sectionName)
 {
-	for (std::vector<Section>::iterator iter = sections.begin(); iter != sections.end(); ++iter)
-		if (!strcasecmp(iter->name().c_str(), sectionName))
-			return (&(*iter));
-	return 0;
+	if (!sectionIndexValid_)
+		RebuildSectionIndex();
+	auto iter = sectionIndex_.find(LowerKey(sectionName));
+	if (iter == sectionIndex_.end())
+		return 0;
+	return &sections[iter->second];
 }
 
 IniFile::Section* IniFile::GetOrCreateSection(const char* sectionName)
@@ -389,6 +436,9 @@ IniFile::Section* IniFile::GetOrCreateSection(const char* sectionName)
 	{
 		sections.push_back(Section(sectionName));
 		section = &sections[sections.size() - 1];
+		if (sectionIndexValid_)
+			sectionIndex_.insert(std::make_pair(LowerKey(sectionName), sections.size() - 1));
+		// An empty section isn't written out, so the file isn't dirty yet.
 	}
 	return section;
 }
@@ -403,6 +453,8 @@ bool IniFile::DeleteSection(const char* sectionName)
 		if (&(*iter) == s)
 		{
 			sections.erase(iter);
+			sectionIndexValid_ = false;
+			dirty_ = true;
 			return true;
 		}
 	}
@@ -420,10 +472,10 @@ bool IniFile::Exists(const char* sectionName, const char* key) const
 void IniFile::SetLines(const char* sectionName, const std::vector<std::string> &lines)
 {
 	Section* section = GetOrCreateSection(sectionName);
-	section->lines.clear();
-	for (std::vector<std::string>::const_iterator iter = lines.begin(); iter != lines.end(); ++iter)
-	{
-		section->lines.push_back(*iter);
+	if (section->lines != lines) {
+		section->lines = lines;
+		section->keyIndexValid_ = false;
+		section->dirty_ = true;
 	}
 }
 
@@ -432,16 +484,7 @@ bool IniFile::DeleteKey(const char* sectionName, const char* key)
 	Section* section = GetSection(sectionName);
 	if (!section)
 		return false;
-	std::string* line = section->GetLine(key, 0, 0);
-	for (std::vector<std::string>::iterator liter = section->lines.begin(); liter != section->lines.end(); ++liter)
-	{
-		if (line == &(*liter))
-		{
-			section->lines.erase(liter);
-			return true;
-		}
-	}
-	return false; //shouldn't happen
+	return section->Delete(key);
 }
 
 // Return a list of all keys in a section
@@ -496,12 +539,17 @@ bool IniFile::GetLines(const char* sectionName, std::vector<std::string>& lines,
 
 void IniFile::SortSections()
 {
+	if (std::is_sorted(sections.begin(), sections.end()))
+		return;
 	std::sort(sections.begin(), sections.end());
+	sectionIndexValid_ = false;
+	dirty_ = true;
 }
 
 bool IniFile::Load(const char* filename)
 {
 	sections.clear();
+	sectionIndexValid_ = false;
 	sections.push_back(Section(""));
 	// first section consists of the comments before the first real section
 
@@ -576,16 +624,23 @@ bool IniFile::Load(std::istream &in) {
 		}
 	}
 
+	// What we just loaded matches the file, nothing to save yet.
+	sectionIndexValid_ = false;
+	dirty_ = false;
 	return true;
 }
 
 bool IniFile::Save(const char* filename)
 {
+	// Write to a temporary file first, then replace the old file in one go.
+	// That way a crash or power loss mid-write can't truncate the config.
+	std::string tempFilename = std::string(filename) + ".tmp";
+
 	std::ofstream out;
 #if defined(_WIN32) && !defined(__MINGW32__)
-	out.open(ConvertUTF8ToWString(filename), std::ios::out);
+	out.open(ConvertUTF8ToWString(tempFilename), std::ios::out);
 #else
-	out.open(filename, std::ios::out);
+	out.open(tempFilename.c_str(), std::ios::out);
 #endif
 
 	if (out.fail())
@@ -607,6 +662,40 @@ bool IniFile::Save(const char* filename)
 	}
 
 	out.close();
+	if (out.fail()) {
+		remove(tempFilename.c_str());
+		return false;
+	}
+
+#ifdef _WIN32
+	std::wstring tempW = ConvertUTF8ToWString(tempFilename);
+	if (!MoveFileExW(tempW.c_str(), ConvertUTF8ToWString(filename).c_str(), MOVEFILE_REPLACE_EXISTING)) {
+		_wremove(tempW.c_str());
+		return false;
+	}
+#else
+	if (rename(tempFilename.c_str(), filename) != 0) {
+		remove(tempFilename.c_str());
+		return false;
+	}
+#endif
+
+	// The file now matches what we have in memory.
+	dirty_ = false;
+	for (Section &section : sections) {
+		section.dirty_ = false;
+	}
+	return true;
+}
+
+bool IniFile::Clean() const
+{
+	if (dirty_)
+		return false;
+	for (const Section &section : sections) {
+		if (section.dirty_)
+			return false;
+	}
 	return true;
 }
 
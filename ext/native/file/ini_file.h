@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include "base/stringutil.h"
 
@@ -119,9 +120,21 @@ public:
 		}
 
 	protected:
+		void RebuildKeyIndex() const;
+		void InvalidateKeyIndex() {
+			keyIndexValid_ = false;
+		}
+
 		std::vector<std::string> lines;
 		std::string name_;
 		std::string comment;
+
+		// Lowercased key -> index into lines, built lazily.  Saves the
+		// quadratic reparse when Config sets hundreds of keys per section.
+		mutable std::unordered_map<std::string, size_t> keyIndex_;
+		mutable bool keyIndexValid_ = false;
+		// Set when the section's contents actually change, cleared on save.
+		bool dirty_ = false;
 	};
 
 	bool Load(const char* filename);
@@ -132,6 +145,10 @@ public:
 	bool Save(const char* filename);
 	bool Save(const std::string &filename) { return Save(filename.c_str()); }
 
+	// True if nothing has changed since Load() or the last successful Save() -
+	// the file on disk is already up to date and a save can be skipped.
+	bool Clean() const;
+
 	// Returns true if key exists in section
 	bool Exists(const char* sectionName, const char* key) const;
 
@@ -185,8 +202,16 @@ public:
 	Section* GetOrCreateSection(const char* section);
 
 private:
+	void RebuildSectionIndex() const;
+
 	std::vector<Section> sections;
 
+	// Lowercased section name -> index into sections, built lazily.
+	mutable std::unordered_map<std::string, size_t> sectionIndex_;
+	mutable bool sectionIndexValid_ = false;
+	// Structural changes (deleted sections, reordering), see Clean().
+	bool dirty_ = false;
+
 	const Section* GetSection(const char* section) const;
 	Section* GetSection(const char* section);
 	std::string* GetLine(const char* section, const char* key);
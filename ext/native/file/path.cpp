@@ -1,22 +1,19 @@
+#include <set>
+
+#include "base/timeutil.h"
 #include "file/path.h"
+#include "thread/threadutil.h"
 
-// Normalize slashes.
-void PathBrowser::SetPath(const std::string &path) {
-	if (path[0] == '!') {
-		path_ = path;
-		return;
-	}
-	path_ = path;
-	for (size_t i = 0; i < path_.size(); i++) {
-		if (path_[i] == '\\') path_[i] = '/';
-	}
-	if (!path_.size() || (path_[path_.size() - 1] != '/'))
-		path_ += "/";
-}
+// A path that scanned up empty is likely dead (opendir failed), so don't
+// retry it for a while. Rescanning a genuinely empty directory a bit late
+// is harmless; rescanning a dead SMB mount hangs the scan thread for ages.
+static const double FAILED_RESCAN_INTERVAL_S = 10.0;
 
-void PathBrowser::GetListing(std::vector<FileInfo> &fileInfo, const char *filter) {
+// The actual scan, run without the lock held. Returns false when nothing was
+// found, which for our purposes includes the directory not being readable.
+static bool ScanPath(const std::string &path, std::vector<FileInfo> *fileInfo) {
 #ifdef _WIN32
-	if (path_ == "/") {
+	if (path == "/") {
 		// Special path that means root of file system.
 		std::vector<std::string> drives = getWindowsDrives();
 		for (auto drive = drives.begin(); drive != drives.end(); ++drive) {
@@ -29,12 +26,156 @@ void PathBrowser::GetListing(std::vector<FileInfo> &fileInfo, const char *filter
 			fake.exists = true;
 			fake.size = 0;
 			fake.isWritable = false;
-			fileInfo.push_back(fake);
+			fileInfo->push_back(fake);
 		}
+		return true;
 	}
 #endif
 
-	getFilesInDir(path_.c_str(), &fileInfo, filter);
+	return getFilesInDir(path.c_str(), fileInfo) != 0;
+}
+
+// The scan runs unfiltered so that one listing can serve several filters,
+// so this applies the same extension filter getFilesInDir() would have.
+static void ApplyFilter(const std::vector<FileInfo> &files, const char *filter, std::vector<FileInfo> *results) {
+	std::set<std::string> filters;
+	if (filter) {
+		std::string tmp;
+		while (*filter) {
+			if (*filter == ':') {
+				filters.insert(tmp);
+				tmp.clear();
+			} else {
+				tmp.push_back(*filter);
+			}
+			filter++;
+		}
+		if (!tmp.empty())
+			filters.insert(tmp);
+	}
+
+	for (auto iter = files.begin(); iter != files.end(); ++iter) {
+		if (!iter->isDirectory && !filters.empty()) {
+			std::string ext = getFileExtension(iter->fullName);
+			if (filters.find(ext) == filters.end())
+				continue;
+		}
+		results->push_back(*iter);
+	}
+}
+
+PathBrowser::~PathBrowser() {
+	std::unique_lock<std::mutex> guard(pendingLock_);
+	pendingCancel_ = true;
+	pendingStop_ = true;
+	pendingCond_.notify_all();
+	guard.unlock();
+	if (pendingThread_.joinable())
+		pendingThread_.join();
+}
+
+// Normalize slashes.
+void PathBrowser::SetPath(const std::string &path) {
+	if (path[0] == '!') {
+		path_ = path;
+		HandlePath();
+		return;
+	}
+	path_ = path;
+	for (size_t i = 0; i < path_.size(); i++) {
+		if (path_[i] == '\\') path_[i] = '/';
+	}
+	if (!path_.size() || (path_[path_.size() - 1] != '/'))
+		path_ += "/";
+	HandlePath();
+}
+
+void PathBrowser::HandlePath() {
+	std::lock_guard<std::mutex> guard(pendingLock_);
+
+	if (!path_.empty() && path_[0] == '!') {
+		// Pseudo paths (like "!RECENT") have no listing of their own.
+		pendingPath_.clear();
+		pendingFiles_.clear();
+		ready_ = true;
+		return;
+	}
+	if (path_ == failedPath_ && time_now_d() < failedTime_ + FAILED_RESCAN_INTERVAL_S) {
+		// Don't hang on a path that just came up dead, serve the empty result.
+		pendingPath_.clear();
+		pendingFiles_.clear();
+		ready_ = true;
+		return;
+	}
+
+	ready_ = false;
+	pendingCancel_ = false;
+	pendingFiles_.clear();
+	pendingPath_ = path_;
+	pendingCond_.notify_all();
+
+	if (pendingThread_.joinable())
+		return;
+
+	pendingThread_ = std::thread([&] {
+		setCurrentThreadName("PathBrowser");
+
+		std::unique_lock<std::mutex> guard(pendingLock_);
+		std::vector<FileInfo> results;
+		std::string lastPath;
+		while (!pendingStop_) {
+			while (lastPath == pendingPath_ && !pendingCancel_) {
+				pendingCond_.wait(guard);
+				if (pendingStop_)
+					return;
+			}
+			lastPath = pendingPath_;
+
+			bool found = true;
+			if (!lastPath.empty()) {
+				guard.unlock();
+				results.clear();
+				found = ScanPath(lastPath, &results);
+				guard.lock();
+			}
+
+			// A newer request may have arrived while we were scanning.
+			if (pendingPath_ == lastPath) {
+				if (!lastPath.empty() && !pendingCancel_) {
+					pendingFiles_ = std::move(results);
+					results.clear();
+					if (!found) {
+						failedPath_ = lastPath;
+						failedTime_ = time_now_d();
+					}
+				}
+				pendingPath_.clear();
+				lastPath.clear();
+				ready_ = true;
+			}
+		}
+	});
+}
+
+bool PathBrowser::IsListingReady() {
+	std::lock_guard<std::mutex> guard(pendingLock_);
+	return ready_;
+}
+
+bool PathBrowser::GetListing(std::vector<FileInfo> &fileInfo, const char *filter, bool *cancel) {
+	std::unique_lock<std::mutex> guard(pendingLock_);
+	while (!ready_ && (!cancel || !*cancel)) {
+		// Can't wait on pendingCond_ here - the scan thread only signals it
+		// the other way. The UI polls IsListingReady() so this rarely spins.
+		guard.unlock();
+		sleep_ms(50);
+		guard.lock();
+	}
+	if (!ready_)
+		return false;
+
+	ApplyFilter(pendingFiles_, filter, &fileInfo);
+	return true;
 }
 
 // TODO: Support paths like "../../hello"
@@ -59,4 +200,5 @@ void PathBrowser::Navigate(const std::string &path) {
 		if (path_[path_.size() - 1] != '/')
 			path_ += "/";
 	}
+	HandlePath();
 }
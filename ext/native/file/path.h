@@ -1,7 +1,10 @@
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <string.h>
+#include <thread>
 #include <vector>
 #include <stdlib.h>
 
@@ -10,13 +13,21 @@
 // Abstraction above path that lets you navigate easily.
 // "/" is a special path that means the root of the file system. On Windows,
 // listing this will yield drives.
+//
+// Listings happen on a background thread: SetPath() and Navigate() kick off
+// a scan, and IsListingReady() tells you when GetListing() won't block.
+// This matters for network mounts, where a single directory read can take
+// many seconds to complete or time out.
 class PathBrowser {
 public:
 	PathBrowser() {}
 	PathBrowser(std::string path) { SetPath(path); }
+	~PathBrowser();
 
 	void SetPath(const std::string &path);
-	void GetListing(std::vector<FileInfo> &fileInfo, const char *filter = 0);
+	bool IsListingReady();
+	// Blocks until the listing is ready, unless *cancel gets set.
+	bool GetListing(std::vector<FileInfo> &fileInfo, const char *filter = nullptr, bool *cancel = nullptr);
 	void Navigate(const std::string &path);
 
 	std::string GetPath() const {
@@ -40,5 +51,21 @@ public:
 	}
 
 	std::string path_;
-};
 
+private:
+	void HandlePath();
+
+	// One long-lived scan thread per browser, fed through pendingPath_.
+	std::thread pendingThread_;
+	std::mutex pendingLock_;
+	std::condition_variable pendingCond_;
+	std::string pendingPath_;
+	std::vector<FileInfo> pendingFiles_;
+	bool pendingCancel_ = false;
+	bool pendingStop_ = false;
+	bool ready_ = false;
+	// Last path that scanned up empty, so re-entering the menu doesn't hang
+	// the scan thread on a dead share over and over.
+	std::string failedPath_;
+	double failedTime_ = 0.0;
+};
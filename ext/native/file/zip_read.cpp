@@ -68,6 +68,22 @@ ZipAssetReader::ZipAssetReader(const char *zip_file, const char *in_zip_path) {
 	strcpy(in_zip_path_, in_zip_path);
 	if (!zip_file_) {
 		ELOG("Failed to open %s as a zip file", zip_file);
+		return;
+	}
+
+	// Index the central directory once up front, so per-asset lookups are a
+	// hash probe instead of libzip scanning every entry for a NOCASE match.
+	int numFiles = zip_get_num_files(zip_file_);
+	entries_.reserve(numFiles);
+	for (int i = 0; i < numFiles; i++) {
+		const char *name = zip_get_name(zip_file_, i, 0);
+		if (!name)
+			continue;
+		std::string key = name;
+		for (size_t j = 0; j < key.size(); j++) {
+			key[j] = tolower(key[j]);
+		}
+		entries_[key] = i;
 	}
 
 	std::vector<FileInfo> info;
@@ -85,11 +101,41 @@ ZipAssetReader::~ZipAssetReader() {
 	zip_close(zip_file_);
 }
 
+int ZipAssetReader::FindEntry(const char *path) const {
+	std::string key = path;
+	for (size_t i = 0; i < key.size(); i++) {
+		key[i] = tolower(key[i]);
+	}
+	auto iter = entries_.find(key);
+	return iter != entries_.end() ? iter->second : -1;
+}
+
 uint8_t *ZipAssetReader::ReadAsset(const char *path, size_t *size) {
 	char temp_path[1024];
 	strcpy(temp_path, in_zip_path_);
 	strcat(temp_path, path);
-	return ReadFromZip(zip_file_, temp_path, size);
+
+	int index = FindEntry(temp_path);
+	if (index < 0) {
+		ELOG("Error opening %s from ZIP", temp_path);
+		return 0;
+	}
+
+	struct zip_stat zstat;
+	zip_stat_index(zip_file_, index, ZIP_FL_UNCHANGED, &zstat);
+	zip_file *file = zip_fopen_index(zip_file_, index, ZIP_FL_UNCHANGED);
+	if (!file) {
+		ELOG("Error opening %s from ZIP", temp_path);
+		return 0;
+	}
+
+	uint8_t *contents = new uint8_t[zstat.size + 1];
+	zip_fread(file, contents, zstat.size);
+	zip_fclose(file);
+	contents[zstat.size] = 0;
+
+	*size = zstat.size;
+	return contents;
 }
 
 bool ZipAssetReader::GetFileListing(const char *orig_path, std::vector<FileInfo> *listing, const char *filter = 0) {
@@ -182,7 +228,8 @@ bool ZipAssetReader::GetFileInfo(const char *path, FileInfo *info) {
 	char temp_path[1024];
 	strcpy(temp_path, in_zip_path_);
 	strcat(temp_path, path);
-	if (0 != zip_stat(zip_file_, temp_path, ZIP_FL_NOCASE|ZIP_FL_UNCHANGED, &zstat)) {
+	int index = FindEntry(temp_path);
+	if (index < 0 || 0 != zip_stat_index(zip_file_, index, ZIP_FL_UNCHANGED, &zstat)) {
 		// ZIP files do not have real directories, so we'll end up here if we
 		// try to stat one. For now that's fine.
 		info->exists = false;
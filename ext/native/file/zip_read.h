@@ -7,6 +7,7 @@
 
 #include <string.h>
 #include <string>
+#include <unordered_map>
 
 #include "base/basictypes.h"
 #include "file/vfs.h"
@@ -41,8 +42,15 @@ public:
 	}
 
 private:
+	// Looks up a zip entry index by path (case-insensitively), using the index
+	// built at construction. Returns -1 if not found.
+	int FindEntry(const char *path) const;
+
 	zip *zip_file_;
 	char in_zip_path_[256];
+	// Lowercased entry name -> zip index. Built once so lookups don't scan the
+	// whole central directory like zip_stat(..., ZIP_FL_NOCASE) does.
+	std::unordered_map<std::string, int> entries_;
 };
 #endif
 
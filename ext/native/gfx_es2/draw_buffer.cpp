@@ -11,12 +11,16 @@
 #include "gfx/gl_debug_log.h"
 #include "gfx_es2/draw_buffer.h"
 #include "gfx_es2/draw_text.h"
+#include "util/hash/hash.h"
 #include "util/text/utf8.h"
 #include "util/text/wrap_text.h"
 
 enum {
 	// Enough?
 	MAX_VERTS = 65536,
+	// Past this many flushes in one frame, fall back to re-uploading into the
+	// shared buffer so we don't hold an unbounded number of buffers.
+	MAX_FLUSH_BUFFERS = 64,
 };
 
 DrawBuffer::DrawBuffer() : count_(0), atlas(0) {
@@ -67,6 +71,12 @@ void DrawBuffer::Shutdown() {
 		vbuf_->Release();
 		vbuf_ = nullptr;
 	}
+	for (auto &fb : flushBuffers_) {
+		if (fb.vbuf)
+			fb.vbuf->Release();
+	}
+	flushBuffers_.clear();
+	flushIndex_ = 0;
 	inited_ = false;
 	alphaStack_.clear();
 	drawMatrixStack_.clear();
@@ -80,6 +90,11 @@ void DrawBuffer::Begin(Draw::Pipeline *program) {
 	count_ = 0;
 }
 
+void DrawBuffer::BeginFrame() {
+	// Restart matching flushes against last frame's buffers.
+	flushIndex_ = 0;
+}
+
 void DrawBuffer::Flush(bool set_blend_state) {
 	using namespace Draw;
 	if (count_ == 0)
@@ -95,8 +110,34 @@ void DrawBuffer::Flush(bool set_blend_state) {
 	memcpy(ub.WorldViewProj, drawMatrix_.getReadPtr(), sizeof(Matrix4x4));
 	draw_->UpdateDynamicUniformBuffer(&ub, sizeof(ub));
 	if (vbuf_) {
-		draw_->UpdateBuffer(vbuf_, (const uint8_t *)verts_, 0, sizeof(Vertex) * count_, Draw::UPDATE_DISCARD);
-		draw_->BindVertexBuffers(0, 1, &vbuf_, nullptr);
+		Buffer *vbuf = vbuf_;
+		if (flushIndex_ < MAX_FLUSH_BUFFERS) {
+			// Use this flush's own buffer, and only upload if the geometry
+			// changed since the same flush last frame.
+			if (flushIndex_ == flushBuffers_.size()) {
+				flushBuffers_.push_back(FlushBuffer());
+			}
+			FlushBuffer &fb = flushBuffers_[flushIndex_];
+			if (!fb.vbuf || fb.capacity < count_) {
+				if (fb.vbuf)
+					fb.vbuf->Release();
+				fb.capacity = (count_ + 1023) & ~1023;
+				fb.vbuf = draw_->CreateBuffer(fb.capacity * sizeof(Vertex), BufferUsageFlag::DYNAMIC | BufferUsageFlag::VERTEXDATA);
+				fb.count = 0;
+				fb.hash = 0;
+			}
+			uint32_t h = hash::Adler32((const uint8_t *)verts_, sizeof(Vertex) * count_);
+			if (fb.count != count_ || fb.hash != h) {
+				draw_->UpdateBuffer(fb.vbuf, (const uint8_t *)verts_, 0, sizeof(Vertex) * count_, Draw::UPDATE_DISCARD);
+				fb.count = count_;
+				fb.hash = h;
+			}
+			vbuf = fb.vbuf;
+			flushIndex_++;
+		} else {
+			draw_->UpdateBuffer(vbuf_, (const uint8_t *)verts_, 0, sizeof(Vertex) * count_, Draw::UPDATE_DISCARD);
+		}
+		draw_->BindVertexBuffers(0, 1, &vbuf, nullptr);
 		int offset = 0;
 		draw_->Draw(count_, offset);
 	} else {
@@ -65,6 +65,10 @@ public:
 	void Begin(Draw::Pipeline *pipeline);
 	void Flush(bool set_blend_state = true);
 
+	// Call once per frame so flushes can be matched up with last frame's and
+	// re-use their vertex buffers when the geometry didn't change.
+	void BeginFrame();
+
 	// TODO: Enforce these. Now Init is autocalled and shutdown not called.
 	void Init(Draw::DrawContext *t3d, Draw::Pipeline *pipeline);
 	void Shutdown();
@@ -187,6 +191,19 @@ private:
 	Draw::Buffer *vbuf_;
 	Draw::Pipeline *pipeline_;
 
+	// One buffer per Flush() within a frame. A static UI regenerates identical
+	// geometry every frame, so when the contents match we skip the upload and
+	// draw from last frame's buffer. Only used when the pipeline requires a
+	// buffer (other backends draw directly from the vertex array).
+	struct FlushBuffer {
+		Draw::Buffer *vbuf = nullptr;
+		int capacity = 0;
+		int count = 0;
+		uint32_t hash = 0;
+	};
+	std::vector<FlushBuffer> flushBuffers_;
+	size_t flushIndex_ = 0;
+
 	Vertex *verts_;
 	int count_;
 	DrawBufferPrimitiveMode mode_;
@@ -11,13 +11,70 @@
 #include "gfx_es2/draw_text_qt.h"
 #include "gfx_es2/draw_text_android.h"
 
-TextDrawer::TextDrawer(Draw::DrawContext *draw) : draw_(draw) {
+// Don't hold more string textures than this. Lists with lots of distinct labels
+// can otherwise accumulate a texture per string until the age-out kicks in.
+static const size_t MAX_STRING_TEXTURES = 512;
+
+TextDrawer::TextDrawer(Draw::DrawContext *draw) : draw_(draw), frameCount_(0), fontScaleX_(1.0f), fontScaleY_(1.0f) {
 	// These probably shouldn't be state.
 	dpiScale_ = CalculateDPIScale();
 }
 TextDrawer::~TextDrawer() {
 }
 
+void TextDrawer::ClearCache() {
+	for (auto &iter : cache_) {
+		if (iter.second->texture)
+			iter.second->texture->Release();
+	}
+	cache_.clear();
+	sizeCache_.clear();
+}
+
+void TextDrawer::OncePerFrame() {
+	frameCount_++;
+	// If DPI changed (small-mode, future proper monitor DPI support), drop everything.
+	float newDpiScale = CalculateDPIScale();
+	if (newDpiScale != dpiScale_) {
+		dpiScale_ = newDpiScale;
+		ClearCache();
+		RecreateFonts();
+	}
+
+	// Drop old strings. Use a prime number to reduce clashing with other rhythms
+	if (frameCount_ % 23 == 0) {
+		for (auto iter = cache_.begin(); iter != cache_.end();) {
+			if (frameCount_ - iter->second->lastUsedFrame > 100) {
+				if (iter->second->texture)
+					iter->second->texture->Release();
+				cache_.erase(iter++);
+			} else {
+				iter++;
+			}
+		}
+
+		for (auto iter = sizeCache_.begin(); iter != sizeCache_.end(); ) {
+			if (frameCount_ - iter->second->lastUsedFrame > 100) {
+				sizeCache_.erase(iter++);
+			} else {
+				iter++;
+			}
+		}
+
+		// Also cap the total texture count, evicting the least recently used first.
+		while (cache_.size() > MAX_STRING_TEXTURES) {
+			auto oldest = cache_.begin();
+			for (auto iter = cache_.begin(); iter != cache_.end(); ++iter) {
+				if (iter->second->lastUsedFrame < oldest->second->lastUsedFrame)
+					oldest = iter;
+			}
+			if (oldest->second->texture)
+				oldest->second->texture->Release();
+			cache_.erase(oldest);
+		}
+	}
+}
+
 float TextDrawerWordWrapper::MeasureWidth(const char *str, size_t bytes) {
 	float w, h;
 	drawer_->MeasureString(str, bytes, &w, &h);
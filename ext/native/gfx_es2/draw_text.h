@@ -60,7 +60,7 @@ public:
 	virtual void DrawString(DrawBuffer &target, const char *str, float x, float y, uint32_t color, int align = ALIGN_TOPLEFT) = 0;
 	virtual void DrawStringRect(DrawBuffer &target, const char *str, const Bounds &bounds, uint32_t color, int align) = 0;
 	// Use for housekeeping like throwing out old strings.
-	virtual void OncePerFrame() = 0;
+	void OncePerFrame();
 
 	float CalculateDPIScale();
 
@@ -71,7 +71,8 @@ protected:
 	TextDrawer(Draw::DrawContext *draw);
 
 	Draw::DrawContext *draw_;
-	virtual void ClearCache() = 0;
+	virtual void ClearCache();
+	virtual void RecreateFonts() {}  // Called on DPI change, after the cache has been wiped.
 	void WrapString(std::string &out, const char *str, float maxWidth);
 
 	struct CacheKey {
@@ -86,6 +87,11 @@ protected:
 		uint32_t fontHash;
 	};
 
+	// The same string/measurement caches are used by all the platform
+	// implementations, so they live here along with the eviction logic.
+	std::map<CacheKey, std::unique_ptr<TextStringEntry>> cache_;
+	std::map<CacheKey, std::unique_ptr<TextMeasureEntry>> sizeCache_;
+
 	int frameCount_;
 	float fontScaleX_;
 	float fontScaleY_;
@@ -241,13 +241,10 @@ void TextDrawerAndroid::DrawString(DrawBuffer &target, const char *str, float x,
 	}
 }
 
-void TextDrawerAndroid::ClearCache() {
-	for (auto &iter : cache_) {
-		if (iter.second->texture)
-			iter.second->texture->Release();
-	}
-	cache_.clear();
-	sizeCache_.clear();
+void TextDrawerAndroid::RecreateFonts() {
+	// Font sizes are precomputed using dpiScale_, so just drop them - they'll be
+	// recreated at the new scale on demand.
+	fontMap_.clear();
 }
 
 void TextDrawerAndroid::DrawStringRect(DrawBuffer &target, const char *str, const Bounds &bounds, uint32_t color, int align) {
@@ -273,38 +270,4 @@ void TextDrawerAndroid::DrawStringRect(DrawBuffer &target, const char *str, cons
 	DrawString(target, toDraw.c_str(), x, y, color, align);
 }
 
-void TextDrawerAndroid::OncePerFrame() {
-	frameCount_++;
-	// If DPI changed (small-mode, future proper monitor DPI support), drop everything.
-	float newDpiScale = CalculateDPIScale();
-	if (newDpiScale != dpiScale_) {
-		// TODO: Don't bother if it's a no-op (cache already empty)
-		ILOG("DPI Scale changed (%f to %f) - wiping font cache (%d items, %d fonts)", dpiScale_, newDpiScale, (int)cache_.size(), (int)fontMap_.size());
-		dpiScale_ = newDpiScale;
-		ClearCache();
-		fontMap_.clear();  // size is precomputed using dpiScale_.
-	}
-
-	// Drop old strings. Use a prime number to reduce clashing with other rhythms
-	if (frameCount_ % 23 == 0) {
-		for (auto iter = cache_.begin(); iter != cache_.end();) {
-			if (frameCount_ - iter->second->lastUsedFrame > 100) {
-				if (iter->second->texture)
-					iter->second->texture->Release();
-				cache_.erase(iter++);
-			} else {
-				iter++;
-			}
-		}
-
-		for (auto iter = sizeCache_.begin(); iter != sizeCache_.end(); ) {
-			if (frameCount_ - iter->second->lastUsedFrame > 100) {
-				sizeCache_.erase(iter++);
-			} else {
-				iter++;
-			}
-		}
-	}
-}
-
 #endif
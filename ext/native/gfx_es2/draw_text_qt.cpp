@@ -20,6 +20,7 @@ TextDrawerQt::TextDrawerQt(Draw::DrawContext *draw) : TextDrawer(draw) {
 
 TextDrawerQt::~TextDrawerQt() {
 	ClearCache();
+	RecreateFonts();
 }
 
 uint32_t TextDrawerQt::SetFont(const char *fontName, int size, int flags) {
@@ -71,14 +72,13 @@ void TextDrawerQt::DrawString(DrawBuffer &target, const char *str, float x, floa
 	if (!strlen(str))
 		return;
 
-	uint32_t stringHash = hash::Adler32((const uint8_t *)str, strlen(str));
-	uint32_t entryHash = stringHash ^ fontHash_ ^ (align << 24);
+	CacheKey key{ std::string(str), fontHash_ };
 
 	target.Flush(true);
 
 	TextStringEntry *entry;
 
-	auto iter = cache_.find(entryHash);
+	auto iter = cache_.find(key);
 	if (iter != cache_.end()) {
 		entry = iter->second.get();
 	} else {
@@ -121,7 +121,7 @@ void TextDrawerQt::DrawString(DrawBuffer &target, const char *str, float x, floa
 		desc.initData.push_back((uint8_t *)bitmapData);
 		entry->texture = draw_->CreateTexture(desc);
 		delete[] bitmapData;
-		cache_[entryHash] = std::unique_ptr<TextStringEntry>(entry);
+		cache_[key] = std::unique_ptr<TextStringEntry>(entry);
 	}
 
 	float w = entry->bmWidth * fontScaleX_;
@@ -133,14 +133,8 @@ void TextDrawerQt::DrawString(DrawBuffer &target, const char *str, float x, floa
 	target.Flush(true);
 }
 
-void TextDrawerQt::ClearCache() {
-	for (auto &iter : cache_) {
-		if (iter.second->texture)
-			iter.second->texture->Release();
-	}
-	cache_.clear();
-	sizeCache_.clear();
-	// Also wipe the font map.
+void TextDrawerQt::RecreateFonts() {
+	// Just wipe the font map - fonts are recreated on demand at the current scale.
 	for (auto iter : fontMap_) {
 		delete iter.second;
 	}
@@ -171,35 +165,4 @@ void TextDrawerQt::DrawStringRect(DrawBuffer &target, const char *str, const Bou
 	DrawString(target, toDraw.c_str(), x, y, color, align);
 }
 
-void TextDrawerQt::OncePerFrame() {
-	frameCount_++;
-	// If DPI changed (small-mode, future proper monitor DPI support), drop everything.
-	float newDpiScale = CalculateDPIScale();
-	if (newDpiScale != dpiScale_) {
-		dpiScale_ = newDpiScale;
-		ClearCache();
-	}
-
-	// Drop old strings. Use a prime number to reduce clashing with other rhythms
-	if (frameCount_ % 23 == 0) {
-		for (auto iter = cache_.begin(); iter != cache_.end();) {
-			if (frameCount_ - iter->second->lastUsedFrame > 100) {
-				if (iter->second->texture)
-					iter->second->texture->Release();
-				cache_.erase(iter++);
-			} else {
-				iter++;
-			}
-		}
-
-		for (auto iter = sizeCache_.begin(); iter != sizeCache_.end(); ) {
-			if (frameCount_ - iter->second->lastUsedFrame > 100) {
-				sizeCache_.erase(iter++);
-			} else {
-				iter++;
-			}
-		}
-	}
-}
-
 #endif
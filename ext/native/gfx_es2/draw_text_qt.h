@@ -18,18 +18,12 @@ public:
 	void MeasureStringRect(const char *str, size_t len, const Bounds &bounds, float *w, float *h, int align = ALIGN_TOPLEFT) override;
 	void DrawString(DrawBuffer &target, const char *str, float x, float y, uint32_t color, int align = ALIGN_TOPLEFT) override;
 	void DrawStringRect(DrawBuffer &target, const char *str, const Bounds &bounds, uint32_t color, int align) override;
-	// Use for housekeeping like throwing out old strings.
-	void OncePerFrame() override;
 
 protected:
-	void ClearCache() override;
+	void RecreateFonts() override;
 
 	uint32_t fontHash_;
 	std::map<uint32_t, QFont *> fontMap_;
-
-	// The key is the CityHash of the string xor the fontHash_.
-	std::map<uint32_t, std::unique_ptr<TextStringEntry>> cache_;
-	std::map<uint32_t, std::unique_ptr<TextMeasureEntry>> sizeCache_;
 };
 
 #endif
\ No newline at end of file
@@ -25,20 +25,15 @@ public:
 	void MeasureStringRect(const char *str, size_t len, const Bounds &bounds, float *w, float *h, int align = ALIGN_TOPLEFT) override;
 	void DrawString(DrawBuffer &target, const char *str, float x, float y, uint32_t color, int align = ALIGN_TOPLEFT) override;
 	void DrawStringRect(DrawBuffer &target, const char *str, const Bounds &bounds, uint32_t color, int align) override;
-	// Use for housekeeping like throwing out old strings.
-	void OncePerFrame() override;
 
 protected:
-	void ClearCache() override;
-	void RecreateFonts();  // On DPI change
+	void RecreateFonts() override;  // On DPI change
 
 	TextDrawerContext *ctx_;
 	std::map<uint32_t, std::unique_ptr<TextDrawerFontContext>> fontMap_;
 
 	uint32_t fontHash_;
-	std::map<CacheKey, std::unique_ptr<TextStringEntry>> cache_;
-	std::map<CacheKey, std::unique_ptr<TextMeasureEntry>> sizeCache_;
-	
+
 
 	// Direct2D drawing components.
 	ID2D1Factory5*        m_d2dFactory;
@@ -26,6 +26,7 @@ PFNGLBLITFRAMEBUFFERNVPROC glBlitFramebufferNV;
 PFNGLMAPBUFFERPROC glMapBuffer;
 
 PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
 PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOES;
 PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOES;
 PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOES;
@@ -353,6 +354,9 @@ void CheckGLExtensions() {
 	gl_extensions.EXT_draw_instanced = g_set_gl_extensions.count("GL_EXT_draw_instanced") != 0;
 	gl_extensions.ARB_draw_instanced = g_set_gl_extensions.count("GL_ARB_draw_instanced") != 0;
 	gl_extensions.ARB_cull_distance = g_set_gl_extensions.count("GL_ARB_cull_distance") != 0;
+	gl_extensions.ARB_parallel_shader_compile = g_set_gl_extensions.count("GL_ARB_parallel_shader_compile") != 0;
+	gl_extensions.KHR_parallel_shader_compile = g_set_gl_extensions.count("GL_KHR_parallel_shader_compile") != 0;
+	gl_extensions.ARB_get_program_binary = g_set_gl_extensions.count("GL_ARB_get_program_binary") != 0;
 
 	if (gl_extensions.IsGLES) {
 		gl_extensions.OES_texture_npot = g_set_gl_extensions.count("GL_OES_texture_npot") != 0;
@@ -368,6 +372,8 @@ void CheckGLExtensions() {
 		gl_extensions.OES_texture_float = g_set_gl_extensions.count("GL_OES_texture_float") != 0;
 		gl_extensions.EXT_buffer_storage = g_set_gl_extensions.count("GL_EXT_buffer_storage") != 0;
 		gl_extensions.EXT_clip_cull_distance = g_set_gl_extensions.count("GL_EXT_clip_cull_distance") != 0;
+		// glGetProgramBinary and friends are core in ES 3.0 (the entry points come from gl3stub on Android.)
+		gl_extensions.ARB_get_program_binary = gl_extensions.GLES3;
 
 #if defined(__ANDROID__)
 		// On Android, incredibly, this is not consistently non-zero! It does seem to have the same value though.
@@ -404,9 +410,17 @@ void CheckGLExtensions() {
 		if (gl_extensions.EXT_discard_framebuffer) {
 			glDiscardFramebufferEXT = (PFNGLDISCARDFRAMEBUFFEREXTPROC)eglGetProcAddress("glDiscardFramebufferEXT");
 		}
+
+		if (gl_extensions.KHR_parallel_shader_compile) {
+			glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)eglGetProcAddress("glMaxShaderCompilerThreadsKHR");
+			if (!glMaxShaderCompilerThreadsKHR) {
+				gl_extensions.KHR_parallel_shader_compile = false;
+			}
+		}
 #else
 		gl_extensions.OES_vertex_array_object = false;
 		gl_extensions.EXT_discard_framebuffer = false;
+		gl_extensions.KHR_parallel_shader_compile = false;
 #endif
 	} else {
 		// Desktops support minmax and subimage unpack (GL_UNPACK_ROW_LENGTH etc)
@@ -510,7 +524,7 @@ void CheckGLExtensions() {
 			// ARB_gpu_shader5 = true;
 		}
 		if (gl_extensions.VersionGEThan(4, 1)) {
-			// ARB_get_program_binary = true;
+			gl_extensions.ARB_get_program_binary = true;
 			// ARB_separate_shader_objects = true;
 			// ARB_shader_precision = true;
 			// ARB_viewport_array = true;
@@ -65,6 +65,9 @@ struct GLExtensions {
 	bool ARB_draw_instanced;
 	bool ARB_buffer_storage;
 	bool ARB_cull_distance;
+	bool ARB_parallel_shader_compile;
+	bool KHR_parallel_shader_compile;
+	bool ARB_get_program_binary;  // Also set on GLES 3.0, where the functionality is core.
 
 	// EXT
 	bool EXT_swap_control_tear;
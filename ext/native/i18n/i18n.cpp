@@ -25,18 +25,21 @@ const char *I18NCategory::T(const char *key, const char *def) {
 		return "ERROR";
 	}
 	// Replace the \n's with \\n's so that key values with newlines will be found correctly.
+	// Almost no keys contain newlines, so don't pay for the replacement scan unless needed.
 	std::string modifiedKey = key;
-	modifiedKey = ReplaceAll(modifiedKey, "\n", "\\n");
+	if (modifiedKey.find('\n') != std::string::npos)
+		modifiedKey = ReplaceAll(modifiedKey, "\n", "\\n");
 
 	auto iter = map_.find(modifiedKey);
 	if (iter != map_.end()) {
 //		ILOG("translation key found in %s: %s", name_.c_str(), key);
 		return iter->second.text.c_str();
 	} else {
-		if (def)
-			missedKeyLog_[key] = def;
-		else
-			missedKeyLog_[key] = modifiedKey.c_str();
+		// Only record each miss once - UI that draws untranslated values can
+		// come through here repeatedly with the same key.
+		auto missed = missedKeyLog_.find(key);
+		if (missed == missedKeyLog_.end())
+			missedKeyLog_[key] = def ? def : modifiedKey;
 //		ILOG("Missed translation key in %s: %s", name_.c_str(), key);
 		return def ? def : key;
 	}
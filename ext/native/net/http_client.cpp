@@ -14,7 +14,9 @@
 #include <io.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -298,7 +300,7 @@ int Client::SendRequestWithData(const char *method, const char *resource, const
 		"%s %s HTTP/%s\r\n"
 		"Host: %s\r\n"
 		"User-Agent: %s\r\n"
-		"Connection: close\r\n"
+		"Connection: %s\r\n"
 		"%s"
 		"\r\n";
 
@@ -306,6 +308,7 @@ int Client::SendRequestWithData(const char *method, const char *resource, const
 		method, resource, httpVersion_,
 		host_.c_str(),
 		userAgent_,
+		keepAlive_ ? "keep-alive" : "close",
 		otherHeaders ? otherHeaders : "");
 	buffer.Append(data);
 	bool flushed = buffer.FlushSocket(sock(), dataTimeout_);
@@ -390,7 +393,24 @@ int Client::ReadResponseEntity(Buffer *readbuf, const std::vector<std::string> &
 		*progress = 0.1f;
 	}
 
-	if (!contentLength || !progress) {
+	if (keepAlive_ && !chunked && contentLength > 0) {
+		// Bounded read of exactly the entity, so the connection stays usable for
+		// the next request instead of waiting for the server to close it.
+		while ((int)readbuf->size() < contentLength) {
+			if (dataTimeout_ >= 0.0 && !fd_util::WaitUntilReady(sock(), dataTimeout_, false)) {
+				ELOG("HTTP response entity timed out");
+				return -1;
+			}
+			size_t sizeBefore = readbuf->size();
+			readbuf->Read(sock(), contentLength - sizeBefore);
+			if (readbuf->size() == sizeBefore) {
+				ELOG("Connection lost reading HTTP response entity");
+				return -1;
+			}
+		}
+		if (progress)
+			*progress = 1.0f;
+	} else if (!contentLength || !progress) {
 		// No way to know how far along we are. Let's just not update the progress counter.
 		if (!readbuf->ReadAll(sock(), contentLength))
 			return -1;
@@ -474,6 +494,118 @@ int Download::PerformGET(const std::string &url) {
 	return client.GET(fileUrl.Resource().c_str(), &buffer_, responseHeaders_, &progress_, &cancelled_);
 }
 
+// Files at least this big are split across parallel range requests when the
+// server advertises byte-range support.
+static const int64_t SEGMENT_MIN_SIZE = 16 * 1024 * 1024;
+static const int SEGMENT_COUNT = 4;
+
+void Download::DownloadSegment(const std::string &url, int64_t begin, int64_t last, Buffer *output, float *progress, int *result) {
+	*result = -1;
+
+	Url fileUrl(url);
+	http::Client client;
+	if (!client.Resolve(fileUrl.Host().c_str(), fileUrl.Port()))
+		return;
+	if (cancelled_ || !client.Connect(2, 20.0, &cancelled_))
+		return;
+
+	// The Range header is inclusive. No Accept-Encoding - ranges address the
+	// raw bytes of the file.
+	char requestHeaders[1024];
+	snprintf(requestHeaders, sizeof(requestHeaders), "Range: bytes=%lld-%lld\r\n", (long long)begin, (long long)last);
+	if (client.SendRequest("GET", fileUrl.Resource().c_str(), requestHeaders) < 0)
+		return;
+
+	Buffer readbuf;
+	std::vector<std::string> responseHeaders;
+	int code = client.ReadResponseHeaders(&readbuf, responseHeaders);
+	if (code != 206)
+		return;
+	if (client.ReadResponseEntity(&readbuf, responseHeaders, output, progress, &cancelled_) < 0)
+		return;
+
+	*result = code;
+}
+
+int Download::PerformSegmentedGET(const std::string &url) {
+	Url fileUrl(url);
+	if (!fileUrl.Valid())
+		return 0;
+
+	// Probe the size and range support with a HEAD request first.
+	http::Client client;
+	if (!client.Resolve(fileUrl.Host().c_str(), fileUrl.Port()))
+		return 0;
+	if (cancelled_ || !client.Connect(2, 20.0, &cancelled_))
+		return 0;
+	if (client.SendRequest("HEAD", fileUrl.Resource().c_str()) < 0)
+		return 0;
+	Buffer readbuf;
+	responseHeaders_.clear();
+	int code = client.ReadResponseHeaders(&readbuf, responseHeaders_);
+	client.Disconnect();
+
+	// Redirects and errors take the regular single-connection path.
+	if (code != 200)
+		return 0;
+
+	std::string lengthStr, ranges;
+	if (!GetHeaderValue(responseHeaders_, "Content-Length", &lengthStr) || !GetHeaderValue(responseHeaders_, "Accept-Ranges", &ranges))
+		return 0;
+	int64_t size = atoll(lengthStr.c_str());
+	if (size < SEGMENT_MIN_SIZE || ranges.find("bytes") == ranges.npos)
+		return 0;
+
+	Buffer segments[SEGMENT_COUNT];
+	float segProgress[SEGMENT_COUNT] = {};
+	int segResult[SEGMENT_COUNT] = {};
+	bool segDone[SEGMENT_COUNT] = {};
+	std::thread threads[SEGMENT_COUNT];
+	int64_t chunk = (size + SEGMENT_COUNT - 1) / SEGMENT_COUNT;
+	for (int i = 0; i < SEGMENT_COUNT; i++) {
+		int64_t begin = i * chunk;
+		int64_t last = std::min(begin + chunk, size) - 1;
+		threads[i] = std::thread([=, &segments, &segProgress, &segResult, &segDone] {
+			DownloadSegment(url, begin, last, &segments[i], &segProgress[i], &segResult[i]);
+			segDone[i] = true;
+		});
+	}
+
+	// Aggregate progress at a gentle rate while the segments run, so pollers
+	// of Progress() aren't updated per received chunk.
+	bool allDone = false;
+	while (!allDone) {
+		sleep_ms(100);
+		allDone = true;
+		float total = 0.0f;
+		for (int i = 0; i < SEGMENT_COUNT; i++) {
+			if (!segDone[i])
+				allDone = false;
+			total += segProgress[i];
+		}
+		progress_ = total / SEGMENT_COUNT;
+	}
+	for (int i = 0; i < SEGMENT_COUNT; i++)
+		threads[i].join();
+
+	if (cancelled_)
+		return -1;
+	for (int i = 0; i < SEGMENT_COUNT; i++) {
+		if (segResult[i] != 206) {
+			WLOG("Segment %d of %s failed (%d), falling back to a single connection", i, url.c_str(), segResult[i]);
+			return 0;
+		}
+	}
+
+	// Stitch the segments together in order.
+	for (int i = 0; i < SEGMENT_COUNT; i++) {
+		buffer_.Append(segments[i]);
+		segments[i].clear();
+	}
+	ILOG("Completed segmented download of %s (%lld bytes over %d connections)", url.c_str(), (long long)size, SEGMENT_COUNT);
+	return 200;
+}
+
 std::string Download::RedirectLocation(const std::string &baseUrl) {
 	std::string redirectUrl;
 	if (GetHeaderValue(responseHeaders_, "Location", &redirectUrl)) {
@@ -494,7 +626,9 @@ void Download::Do(std::shared_ptr<Download> self) {
 
 	std::string downloadURL = url_;
 	while (resultCode_ == 0) {
-		int resultCode = PerformGET(downloadURL);
+		int resultCode = PerformSegmentedGET(downloadURL);
+		if (resultCode == 0)
+			resultCode = PerformGET(downloadURL);
 		if (resultCode == -1) {
 			SetFailed(resultCode);
 			return;
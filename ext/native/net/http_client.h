@@ -81,10 +81,18 @@ public:
 		dataTimeout_ = t;
 	}
 
+	// Keeps the connection open after a request, so several requests can reuse it.
+	// Only safe when responses carry a Content-Length and aren't chunked - we fall
+	// back to a close-delimited read (and the caller should disconnect) otherwise.
+	void SetKeepAlive(bool keepAlive) {
+		keepAlive_ = keepAlive;
+	}
+
 protected:
 	const char *userAgent_;
 	const char *httpVersion_;
 	double dataTimeout_ = -1.0;
+	bool keepAlive_ = false;
 };
 
 // Not particularly efficient, but hey - it's a background download, that's pretty cool :P
@@ -140,6 +148,11 @@ public:
 private:
 	void Do(std::shared_ptr<Download> self);  // Actually does the download. Runs on thread.
 	int PerformGET(const std::string &url);
+	// Downloads large files over several parallel range-request connections.
+	// Returns 0 when not applicable (small file, no range support, redirect),
+	// in which case the caller should fall back to PerformGET.
+	int PerformSegmentedGET(const std::string &url);
+	void DownloadSegment(const std::string &url, int64_t begin, int64_t last, Buffer *output, float *progress, int *result);
 	std::string RedirectLocation(const std::string &baseUrl);
 	void SetFailed(int code);
 	float progress_;
@@ -37,6 +37,7 @@
 #include "base/logging.h"
 #include "base/buffer.h"
 #include "file/fd_util.h"
+#include "base/stringutil.h"
 #include "net/http_server.h"
 #include "net/sinks.h"
 #include "thread/executor.h"
@@ -47,7 +48,7 @@ namespace http {
 const char *const DEFAULT_MIME_TYPE = "text/html; charset=utf-8";
 
 Request::Request(int fd)
-    : fd_(fd) {
+    : fd_(fd), keepAlive_(false) {
 	in_ = new net::InputSink(fd);
 	out_ = new net::OutputSink(fd);
 	header_.ParseHeaders(in_);
@@ -96,7 +97,15 @@ void Request::WriteHttpResponseHeader(const char *ver, int status, int64_t size,
 	buffer->Push("Server: PPSSPPServer v0.1\r\n");
 	if (!mimeType || strcmp(mimeType, "websocket") != 0) {
 		buffer->Printf("Content-Type: %s\r\n", mimeType ? mimeType : DEFAULT_MIME_TYPE);
-		buffer->Push("Connection: close\r\n");
+		// A response with a known length can leave the connection open for the
+		// client's next request. Anything else is delimited by the close.
+		std::string connection;
+		if (size >= 0 && header_.GetOther("connection", &connection) && startsWithNoCase(connection, "keep-alive")) {
+			keepAlive_ = true;
+			buffer->Push("Connection: keep-alive\r\n");
+		} else {
+			buffer->Push("Connection: close\r\n");
+		}
 	}
 	if (size >= 0) {
 		buffer->Printf("Content-Length: %llu\r\n", size);
@@ -125,6 +134,12 @@ void Request::Close() {
   }
 }
 
+void Request::Release() {
+  CHECK(fd_);
+  out_->Flush();
+  fd_ = 0;
+}
+
 Server::Server(threading::Executor *executor)
   : port_(0), executor_(executor) {
   RegisterHandler("/", std::bind(&Server::HandleListing, this, std::placeholders::_1));
@@ -281,18 +296,35 @@ void Server::Stop() {
 }
 
 void Server::HandleConnection(int conn_fd) {
-  Request request(conn_fd);
-  if (!request.IsOK()) {
-    WLOG("Bad request, ignoring.");
-    return;
+  // Serve requests on this connection until the client stops asking for
+  // keep-alive (or goes quiet - idle connections shouldn't pin a thread.)
+  bool first = true;
+  while (true) {
+    if (!first && !fd_util::WaitUntilReady(conn_fd, 10.0, false)) {
+      closesocket(conn_fd);
+      return;
+    }
+
+    Request request(conn_fd);
+    if (!request.IsOK()) {
+      // On a reused connection, this is just the client hanging up.
+      if (first)
+        WLOG("Bad request, ignoring.");
+      return;
+    }
+    first = false;
+    HandleRequest(request);
+
+    // TODO: Way to mark the content body as read, read it here if never read.
+    // This allows the handler to stream if need be.
+
+    if (request.KeepAlive() && request.In()->Empty()) {
+      request.Release();
+    } else {
+      request.Write();
+      return;
+    }
   }
-  HandleRequest(request);
-
-  // TODO: Way to mark the content body as read, read it here if never read.
-  // This allows the handler to stream if need be.
-
-  // TODO: Could handle keep alive here.
-  request.Write();
 }
 
 void Server::HandleRequest(const Request &request) {
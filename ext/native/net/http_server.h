@@ -49,6 +49,15 @@ class Request {
 
   bool IsOK() const { return fd_ > 0; }
 
+  // True if the client asked for the connection to be kept open and the
+  // response header we wrote allows it (known length, so the client can tell
+  // where the body ends.)
+  bool KeepAlive() const { return keepAlive_; }
+
+  // Flush and hand the still-open socket back to the caller, so the next
+  // Request can be served on it.
+  void Release();
+
   // If size is negative, no Content-Length: line is written.
   void WriteHttpResponseHeader(const char *ver, int status, int64_t size = -1, const char *mimeType = nullptr, const char *otherHeaders = nullptr) const;
 
@@ -57,6 +66,7 @@ private:
 	net::OutputSink *out_;
 	RequestHeader header_;
 	int fd_;
+	mutable bool keepAlive_;
 };
 
 // Register handlers on this class to serve stuff.
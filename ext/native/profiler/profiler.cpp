@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include <stdio.h>
 #include <string.h>
 
 #include "base/logging.h"
@@ -22,7 +23,10 @@
 #else
 #define MAX_THREADS 4     // Can be any number, represents concurrent threads calling the profiler.
 #endif
-#define HISTORY_SIZE 128 // Must be power of 2
+#define HISTORY_SIZE 128 // Must be power of 2. The window the on-screen graph shows.
+// The full ring we keep and can dump for offline analysis. At 60 fps this is
+// a bit over a minute. Must be a power of 2.
+#define DEEP_HISTORY_SIZE 4096
 
 #ifndef _DEBUG
 // If the compiler can collapse identical strings, we don't even need the strcmp.
@@ -35,15 +39,24 @@ struct Category {
 
 struct CategoryFrame {
 	CategoryFrame() {
+		Reset();
+	}
+	void Reset() {
 		memset(time_taken, 0, sizeof(time_taken));
 		memset(count, 0, sizeof(count));
+		// -1 = entered at the root (or not at all) this frame.
+		memset(parent, 0xFF, sizeof(parent));
 	}
 	float time_taken[MAX_CATEGORIES];
 	int count[MAX_CATEGORIES];
+	// The parent category each category was (first) entered under this frame.
+	// Enough to reconstruct the scope tree offline.
+	int8_t parent[MAX_CATEGORIES];
 };
 
 struct Profiler {
 	int historyPos;
+	int frameCount;  // Total frames since init, so dumps have absolute frame numbers.
 	int depth[MAX_THREADS];
 	int parentCategory[MAX_THREADS][MAX_DEPTH];
 	double eventStart[MAX_THREADS][MAX_CATEGORIES];
@@ -56,6 +69,9 @@ static std::mutex categoriesLock;
 static int threadIdAfterLast = 0;
 static std::mutex threadsLock;
 static CategoryFrame *history;
+// Per-frame metadata, same ring position as history.
+static double frameStartTime[DEEP_HISTORY_SIZE];
+static int frameNumber[DEEP_HISTORY_SIZE];
 #if MAX_THREADS > 1
 thread_local int profilerThreadId = -1;
 #else
@@ -72,7 +88,10 @@ void internal_profiler_init() {
 			profiler.parentCategory[i][j] = -1;
 		}
 	}
-	history = new CategoryFrame[HISTORY_SIZE * MAX_THREADS];
+	history = new CategoryFrame[DEEP_HISTORY_SIZE * MAX_THREADS];
+	memset(frameStartTime, 0, sizeof(frameStartTime));
+	memset(frameNumber, 0, sizeof(frameNumber));
+	frameStartTime[0] = real_time_now();
 }
 
 static int internal_profiler_find_thread() {
@@ -130,8 +149,21 @@ static void internal_profiler_resume(int thread_id, int category, double now) {
 	profiler.eventStart[thread_id][category] = now;
 }
 
-int internal_profiler_enter(const char *category_name, int *out_thread_id) {
-	int category = internal_profiler_find_cat(category_name, true);
+int internal_profiler_resolve(const char *category_name) {
+	return internal_profiler_find_cat(category_name, true);
+}
+
+void internal_profiler_add_time(int category, double seconds) {
+	if (category == -1 || !history) {
+		return;
+	}
+	int thread_id = internal_profiler_find_thread();
+	CategoryFrame &frame = history[MAX_THREADS * profiler.historyPos + thread_id];
+	frame.time_taken[category] += (float)seconds;
+	frame.count[category]++;
+}
+
+int internal_profiler_enter_cat(int category, int *out_thread_id) {
 	int thread_id = internal_profiler_find_thread();
 	if (category == -1 || !history) {
 		return category;
@@ -146,8 +178,14 @@ int internal_profiler_enter(const char *category_name, int *out_thread_id) {
 			internal_profiler_suspend(thread_id, parent, now);
 		}
 		internal_profiler_resume(thread_id, category, now);
+		// Remember where in the tree this category sits this frame. First
+		// enter wins - good enough to reconstruct the hierarchy offline.
+		CategoryFrame &frame = history[MAX_THREADS * profiler.historyPos + thread_id];
+		if (parent >= 0 && frame.parent[category] < 0) {
+			frame.parent[category] = (int8_t)parent;
+		}
 	} else {
-		DLOG("profiler: recursive enter (%i - %s)", category, category_name);
+		DLOG("profiler: recursive enter (%i - %s)", category, categories[category].name);
 	}
 
 	depth++;
@@ -157,6 +195,10 @@ int internal_profiler_enter(const char *category_name, int *out_thread_id) {
 	return category;
 }
 
+int internal_profiler_enter(const char *category_name, int *out_thread_id) {
+	return internal_profiler_enter_cat(internal_profiler_find_cat(category_name, true), out_thread_id);
+}
+
 void internal_profiler_leave(int thread_id, int category) {
 	if (category == -1 || !history) {
 		return;
@@ -196,9 +238,14 @@ void internal_profiler_end_frame() {
 		FLOG("Can't be inside a profiler scope at end of frame!");
 	}
 	profiler.curFrameStart = real_time_now();
+	profiler.frameCount++;
 	profiler.historyPos++;
-	profiler.historyPos &= (HISTORY_SIZE - 1);
-	memset(&history[MAX_THREADS * profiler.historyPos], 0, sizeof(CategoryFrame) * MAX_THREADS);
+	profiler.historyPos &= (DEEP_HISTORY_SIZE - 1);
+	for (int i = 0; i < MAX_THREADS; i++) {
+		history[MAX_THREADS * profiler.historyPos + i].Reset();
+	}
+	frameStartTime[profiler.historyPos] = profiler.curFrameStart;
+	frameNumber[profiler.historyPos] = profiler.frameCount;
 }
 
 const char *Profiler_GetCategoryName(int i) {
@@ -226,9 +273,9 @@ void Profiler_GetSlowestThreads(int *data, int count) {
 	for (int i = 0; i < HISTORY_SIZE; i++) {
 		int x = i - count + profiler.historyPos + 1;
 		while (x < 0)
-			x += HISTORY_SIZE;
-		while (x >= HISTORY_SIZE)
-			x -= HISTORY_SIZE;
+			x += DEEP_HISTORY_SIZE;
+		while (x >= DEEP_HISTORY_SIZE)
+			x -= DEEP_HISTORY_SIZE;
 
 		float slowestTime = 0.0f;
 		data[i] = 0;
@@ -249,22 +296,72 @@ void Profiler_GetSlowestHistory(int category, int *slowestThreads, float *data,
 	for (int i = 0; i < HISTORY_SIZE; i++) {
 		int x = i - count + profiler.historyPos + 1;
 		while (x < 0)
-			x += HISTORY_SIZE;
-		while (x >= HISTORY_SIZE)
-			x -= HISTORY_SIZE;
+			x += DEEP_HISTORY_SIZE;
+		while (x >= DEEP_HISTORY_SIZE)
+			x -= DEEP_HISTORY_SIZE;
 
 		int thread = slowestThreads[i];
 		data[i] = history[MAX_THREADS * x + thread].time_taken[category];
 	}
 }
 
+bool Profiler_DumpHistory(const char *filename) {
+	if (!history) {
+		return false;
+	}
+	FILE *f = fopen(filename, "wb");
+	if (!f) {
+		ELOG("Profiler: failed to open '%s' for writing", filename);
+		return false;
+	}
+
+	int numCategories = Profiler_GetNumCategories();
+	int numThreads = threadIdAfterLast;
+	// The frame at historyPos is still being written, so don't include it.
+	int numFrames = profiler.frameCount < DEEP_HISTORY_SIZE ? profiler.frameCount : DEEP_HISTORY_SIZE - 1;
+
+	// Format: magic, a few u32 counts, then len-prefixed category names, then
+	// the frames oldest to newest. Per frame: frame number (u32), start time
+	// (double), then per thread: times (float), counts (u32), parents (int8),
+	// each numCategories long. Everything in host endianness - these files
+	// get analyzed offline, not shipped around.
+	fwrite("PPRF", 4, 1, f);
+	uint32_t counts[4] = { 1, (uint32_t)numCategories, (uint32_t)numThreads, (uint32_t)numFrames };
+	fwrite(counts, sizeof(counts), 1, f);
+	for (int i = 0; i < numCategories; i++) {
+		uint32_t len = (uint32_t)strlen(categories[i].name);
+		fwrite(&len, sizeof(len), 1, f);
+		fwrite(categories[i].name, 1, len, f);
+	}
+
+	for (int i = 0; i < numFrames; i++) {
+		int x = profiler.historyPos - numFrames + i;
+		while (x < 0)
+			x += DEEP_HISTORY_SIZE;
+		uint32_t number = (uint32_t)frameNumber[x];
+		fwrite(&number, sizeof(number), 1, f);
+		fwrite(&frameStartTime[x], sizeof(double), 1, f);
+		for (int thread = 0; thread < numThreads; thread++) {
+			const CategoryFrame &frame = history[MAX_THREADS * x + thread];
+			fwrite(frame.time_taken, sizeof(float), numCategories, f);
+			fwrite(frame.count, sizeof(int), numCategories, f);
+			fwrite(frame.parent, sizeof(int8_t), numCategories, f);
+		}
+	}
+
+	bool ok = ferror(f) == 0;
+	fclose(f);
+	ILOG("Profiler: wrote %d frames of history to '%s'", numFrames, filename);
+	return ok;
+}
+
 void Profiler_GetHistory(int category, int thread, float *data, int count) {
 	for (int i = 0; i < HISTORY_SIZE; i++) {
 		int x = i - count + profiler.historyPos + 1;
 		while (x < 0)
-			x += HISTORY_SIZE;
-		while (x >= HISTORY_SIZE)
-			x -= HISTORY_SIZE;
+			x += DEEP_HISTORY_SIZE;
+		while (x >= DEEP_HISTORY_SIZE)
+			x -= DEEP_HISTORY_SIZE;
 		data[i] = history[MAX_THREADS * x + thread].time_taken[category];
 	}
 }
@@ -12,7 +12,12 @@ void internal_profiler_init();
 void internal_profiler_end_frame();
 
 int internal_profiler_enter(const char *category_name, int *thread_id);  // Returns the category number.
+int internal_profiler_enter_cat(int category, int *thread_id);  // Same, with a pre-resolved category.
 void internal_profiler_leave(int thread_id, int category);
+int internal_profiler_resolve(const char *category_name);  // Registers the category if new.
+// Credits externally measured time (e.g. GPU timestamp query results) to a
+// category in the current frame. Can be called from any thread, outside scopes.
+void internal_profiler_add_time(int category, double seconds);
 
 const char *Profiler_GetCategoryName(int i);
 int Profiler_GetNumCategories();
@@ -22,11 +27,18 @@ void Profiler_GetSlowestThreads(int *data, int count);
 void Profiler_GetSlowestHistory(int category, int *slowestThreads, float *data, int count);
 void Profiler_GetHistory(int category, int thread, float *data, int count);
 
+// Dumps the whole deep history ring (several thousand frames, including the
+// per-frame scope tree) in a simple binary format, for offline analysis.
+bool Profiler_DumpHistory(const char *filename);
+
 class ProfileThis {
 public:
 	ProfileThis(const char *category) {
 		cat_ = internal_profiler_enter(category, &thread_);
 	}
+	ProfileThis(int category) {
+		cat_ = internal_profiler_enter_cat(category, &thread_);
+	}
 	~ProfileThis() {
 		internal_profiler_leave(thread_, cat_);
 	}
@@ -36,7 +48,12 @@ private:
 };
 
 #define PROFILE_INIT() internal_profiler_init();
-#define PROFILE_THIS_SCOPE(cat) ProfileThis _profile_scoped(cat);
+// The category is resolved once per call site, so steady-state enters don't
+// rescan the category table. This means the name must be the same on every
+// call through a given site (template instantiations count as separate sites.)
+#define PROFILE_THIS_SCOPE(cat) \
+	static int _profile_category = internal_profiler_resolve(cat); \
+	ProfileThis _profile_scoped(_profile_category);
 #define PROFILE_END_FRAME() internal_profiler_end_frame();
 
 #else
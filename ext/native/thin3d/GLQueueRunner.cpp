@@ -181,56 +181,96 @@ void GLQueueRunner::RunInitSteps(const std::vector<GLRInitStep> &steps, bool ski
 				glAttachShader(program->program, step.create_program.shaders[j]->shader);
 			}
 
-			for (auto iter : program->semantics_) {
-				glBindAttribLocation(program->program, iter.location, iter.attrib);
+			bool linkedFromBinary = false;
+			if (program->useBinary_) {
+				glProgramBinary(program->program, program->binaryFormat_, program->binary_.data(), (GLsizei)program->binary_.size());
+				// A binary from another driver version fails the link (an unknown format may
+				// additionally raise an error - swallow it.) Fall back to a source link below.
+				glGetError();
+				GLint binaryStatus = GL_FALSE;
+				glGetProgramiv(program->program, GL_LINK_STATUS, &binaryStatus);
+				if (binaryStatus == GL_TRUE) {
+					linkedFromBinary = true;
+					// The binary we were given is still what this program links from - reusable.
+					program->binaryValid_ = true;
+				} else {
+					program->binary_.clear();
+				}
 			}
 
+			if (!linkedFromBinary) {
+				for (auto iter : program->semantics_) {
+					glBindAttribLocation(program->program, iter.location, iter.attrib);
+				}
+
 #if !defined(USING_GLES2)
-			if (step.create_program.support_dual_source) {
-				// Dual source alpha
-				glBindFragDataLocationIndexed(program->program, 0, 0, "fragColor0");
-				glBindFragDataLocationIndexed(program->program, 0, 1, "fragColor1");
-			} else if (gl_extensions.VersionGEThan(3, 3, 0)) {
-				glBindFragDataLocation(program->program, 0, "fragColor0");
-			}
+				if (step.create_program.support_dual_source) {
+					// Dual source alpha
+					glBindFragDataLocationIndexed(program->program, 0, 0, "fragColor0");
+					glBindFragDataLocationIndexed(program->program, 0, 1, "fragColor1");
+				} else if (gl_extensions.VersionGEThan(3, 3, 0)) {
+					glBindFragDataLocation(program->program, 0, "fragColor0");
+				}
 #elif !defined(IOS)
-			if (gl_extensions.GLES3 && step.create_program.support_dual_source) {
-				glBindFragDataLocationIndexedEXT(program->program, 0, 0, "fragColor0");
-				glBindFragDataLocationIndexedEXT(program->program, 0, 1, "fragColor1");
-			}
+				if (gl_extensions.GLES3 && step.create_program.support_dual_source) {
+					glBindFragDataLocationIndexedEXT(program->program, 0, 0, "fragColor0");
+					glBindFragDataLocationIndexedEXT(program->program, 0, 1, "fragColor1");
+				}
 #endif
-			glLinkProgram(program->program);
-
-			GLint linkStatus = GL_FALSE;
-			glGetProgramiv(program->program, GL_LINK_STATUS, &linkStatus);
-			if (linkStatus != GL_TRUE) {
-				std::string infoLog = GetInfoLog(program->program, glGetProgramiv, glGetProgramInfoLog);
-
-				// TODO: Could be other than vs/fs.  Also, we're assuming order here...
-				GLRShader *vs = step.create_program.shaders[0];
-				GLRShader *fs = step.create_program.num_shaders > 1 ? step.create_program.shaders[1] : nullptr;
-				std::string vsDesc = vs->desc + (vs->failed ? " (failed)" : "");
-				std::string fsDesc = fs ? (fs->desc + (fs->failed ? " (failed)" : "")) : "(none)";
-				const char *vsCode = vs->code.c_str();
-				const char *fsCode = fs ? fs->code.c_str() : "(none)";
-				if (!anyFailed)
-					Reporting::ReportMessage("Error in shader program link: info: %s\nfs: %s\n%s\nvs: %s\n%s", infoLog.c_str(), fsDesc.c_str(), fsCode, vsDesc.c_str(), vsCode);
-
-				ELOG("Could not link program:\n %s", infoLog.c_str());
-				ERROR_LOG(G3D, "VS desc:\n%s", vsDesc.c_str());
-				ERROR_LOG(G3D, "FS desc:\n%s", fsDesc.c_str());
-				ERROR_LOG(G3D, "VS:\n%s\n", vsCode);
-				ERROR_LOG(G3D, "FS:\n%s\n", fsCode);
+				if (program->keepBinary_) {
+					glProgramParameteri(program->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+				}
+				glLinkProgram(program->program);
+
+				GLint linkStatus = GL_FALSE;
+				glGetProgramiv(program->program, GL_LINK_STATUS, &linkStatus);
+				if (linkStatus != GL_TRUE) {
+					std::string infoLog = GetInfoLog(program->program, glGetProgramiv, glGetProgramInfoLog);
+
+					// TODO: Could be other than vs/fs.  Also, we're assuming order here...
+					GLRShader *vs = step.create_program.shaders[0];
+					GLRShader *fs = step.create_program.num_shaders > 1 ? step.create_program.shaders[1] : nullptr;
+					std::string vsDesc = vs->desc + (vs->failed ? " (failed)" : "");
+					std::string fsDesc = fs ? (fs->desc + (fs->failed ? " (failed)" : "")) : "(none)";
+					const char *vsCode = vs->code.c_str();
+					const char *fsCode = fs ? fs->code.c_str() : "(none)";
+					if (!anyFailed)
+						Reporting::ReportMessage("Error in shader program link: info: %s\nfs: %s\n%s\nvs: %s\n%s", infoLog.c_str(), fsDesc.c_str(), fsCode, vsDesc.c_str(), vsCode);
+
+					ELOG("Could not link program:\n %s", infoLog.c_str());
+					ERROR_LOG(G3D, "VS desc:\n%s", vsDesc.c_str());
+					ERROR_LOG(G3D, "FS desc:\n%s", fsDesc.c_str());
+					ERROR_LOG(G3D, "VS:\n%s\n", vsCode);
+					ERROR_LOG(G3D, "FS:\n%s\n", fsCode);
 
 #ifdef _WIN32
-				OutputDebugStringUTF8(infoLog.c_str());
-				if (vsCode)
-					OutputDebugStringUTF8(LineNumberString(vsCode).c_str());
-				if (fsCode)
-					OutputDebugStringUTF8(LineNumberString(fsCode).c_str());
+					OutputDebugStringUTF8(infoLog.c_str());
+					if (vsCode)
+						OutputDebugStringUTF8(LineNumberString(vsCode).c_str());
+					if (fsCode)
+						OutputDebugStringUTF8(LineNumberString(fsCode).c_str());
 #endif
-				CHECK_GL_ERROR_IF_DEBUG();
-				break;
+					CHECK_GL_ERROR_IF_DEBUG();
+					break;
+				}
+
+				if (program->keepBinary_) {
+					GLint binaryLength = 0;
+					glGetProgramiv(program->program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+					if (binaryLength > 0) {
+						program->binary_.resize(binaryLength);
+						GLsizei bytesWritten = 0;
+						glGetProgramBinary(program->program, binaryLength, &bytesWritten, &program->binaryFormat_, program->binary_.data());
+						if (bytesWritten > 0) {
+							program->binary_.resize(bytesWritten);
+							program->binaryValid_ = true;
+						} else {
+							program->binary_.clear();
+						}
+					}
+					// Some drivers expose the functions but no binary formats - not an error.
+					glGetError();
+				}
 			}
 
 			glUseProgram(program->program);
@@ -547,7 +587,7 @@ retry_depth:
 	currentReadHandle_ = fbo->handle;
 }
 
-void GLQueueRunner::RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCalls) {
+void GLQueueRunner::RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCalls, GLQueueProfileContext *profile) {
 	if (skipGLCalls) {
 		// Dry run
 		for (size_t i = 0; i < steps.size(); i++) {
@@ -575,10 +615,22 @@ void GLQueueRunner::RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCal
 	}
 
 	CHECK_GL_ERROR_IF_DEBUG();
+#ifndef USING_GLES2
+	if (profile) {
+		profile->stepTypes.clear();
+		size_t firstNew = profile->queries.size();
+		if (firstNew < steps.size() + 1) {
+			profile->queries.resize(steps.size() + 1);
+			glGenQueries((GLsizei)(profile->queries.size() - firstNew), &profile->queries[firstNew]);
+		}
+		glQueryCounter(profile->queries[0], GL_TIMESTAMP);
+	}
+#endif
 	for (size_t i = 0; i < steps.size(); i++) {
 		const GLRStep &step = *steps[i];
 		switch (step.stepType) {
 		case GLRStepType::RENDER:
+			RemoveRedundantStateCommands(steps[i]);
 			PerformRenderPass(step);
 			break;
 		case GLRStepType::COPY:
@@ -597,6 +649,14 @@ void GLQueueRunner::RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCal
 			Crash();
 			break;
 		}
+#ifndef USING_GLES2
+		// One timestamp after each step - the delta to the previous one is
+		// this step's GPU time (modulo overlap, which GL doesn't let us see.)
+		if (profile) {
+			glQueryCounter(profile->queries[profile->stepTypes.size() + 1], GL_TIMESTAMP);
+			profile->stepTypes.push_back(step.stepType);
+		}
+#endif
 		delete steps[i];
 	}
 	CHECK_GL_ERROR_IF_DEBUG();
@@ -636,6 +696,46 @@ void GLQueueRunner::PerformBlit(const GLRStep &step) {
 	}
 }
 
+// The draw engine dirty-flag mechanism doesn't stop a piece of state from being set
+// several times between draws, and with depal and framebuffer copies in the mix those
+// runs can get long. Scan each pass backwards and mark state commands REMOVED when a
+// later command of the same kind fully overwrites them before any draw or clear can
+// consume them, so the replay loop (and the driver) never sees them. Only commands
+// whose effect is self-contained participate - uniforms depend on the bound program,
+// and texture binds on the active slot, so those are left to the replay-time filtering.
+void GLQueueRunner::RemoveRedundantStateCommands(GLRStep *pass) {
+	bool overwritten[(int)GLRRenderCommand::REMOVED]{};
+	auto &commands = pass->commands;
+	for (int i = (int)commands.size() - 1; i >= 0; i--) {
+		const GLRRenderCommand cmd = commands[i].cmd;
+		switch (cmd) {
+		case GLRRenderCommand::DRAW:
+		case GLRRenderCommand::DRAW_INDEXED:
+		case GLRRenderCommand::CLEAR:
+			// Consumes all pending state - everything before this is live again.
+			memset(overwritten, 0, sizeof(overwritten));
+			break;
+		case GLRRenderCommand::DEPTH:
+		case GLRRenderCommand::STENCILFUNC:
+		case GLRRenderCommand::STENCILOP:
+		case GLRRenderCommand::BLEND:
+		case GLRRenderCommand::BLENDCOLOR:
+		case GLRRenderCommand::LOGICOP:
+		case GLRRenderCommand::VIEWPORT:
+		case GLRRenderCommand::SCISSOR:
+		case GLRRenderCommand::RASTER:
+			if (overwritten[(int)cmd]) {
+				commands[i].cmd = GLRRenderCommand::REMOVED;
+			} else {
+				overwritten[(int)cmd] = true;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
 void GLQueueRunner::PerformRenderPass(const GLRStep &step) {
 	CHECK_GL_ERROR_IF_DEBUG();
 	// Don't execute empty renderpasses.
@@ -1143,6 +1243,8 @@ void GLQueueRunner::PerformRenderPass(const GLRStep &step) {
 			}
 			CHECK_GL_ERROR_IF_DEBUG();
 			break;
+		case GLRRenderCommand::REMOVED:
+			break;
 		default:
 			Crash();
 			break;
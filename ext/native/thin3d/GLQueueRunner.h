@@ -59,6 +59,7 @@ enum class GLRRenderCommand : uint8_t {
 	DRAW_INDEXED,
 	PUSH_CONSTANTS,
 	TEXTURE_SUBIMAGE,
+	REMOVED,  // Dead command eliminated before replay, see RemoveRedundantStateCommands.
 };
 
 // TODO: Bloated since the biggest struct decides the size. Will need something more efficient (separate structs with shared
@@ -332,13 +333,24 @@ struct GLRStep {
 	};
 };
 
+// GL_TIMESTAMP queries bracketing each executed step, so GPU time can be
+// attributed per step type. One of these lives in each in-flight frame's data;
+// the results are read the next time the slot comes around, without stalling.
+struct GLQueueProfileContext {
+	bool enabled = false;
+	// [0] is issued before the first step, then one after each.
+	std::vector<GLuint> queries;
+	std::vector<GLRStepType> stepTypes;
+};
+
 class GLQueueRunner {
 public:
 	GLQueueRunner() {}
 
 	void RunInitSteps(const std::vector<GLRInitStep> &steps, bool skipGLCalls);
 
-	void RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCalls);
+	// If profile is set, issues a timestamp query after each executed step.
+	void RunSteps(const std::vector<GLRStep *> &steps, bool skipGLCalls, GLQueueProfileContext *profile = nullptr);
 	void LogSteps(const std::vector<GLRStep *> &steps);
 
 	void CreateDeviceObjects();
@@ -367,6 +379,7 @@ public:
 private:
 	void InitCreateFramebuffer(const GLRInitStep &step);
 
+	void RemoveRedundantStateCommands(GLRStep *pass);
 	void PerformBindFramebufferAsRenderTarget(const GLRStep &pass);
 	void PerformRenderPass(const GLRStep &pass);
 	void PerformCopy(const GLRStep &pass);
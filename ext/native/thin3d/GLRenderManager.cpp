@@ -2,6 +2,7 @@
 
 #include "GLRenderManager.h"
 #include "gfx_es2/gpu_features.h"
+#include "profiler/profiler.h"
 #include "thin3d/thin3d.h"
 #include "thread/threadutil.h"
 #include "base/logging.h"
@@ -14,6 +15,14 @@
 #define VLOG(...)
 #endif
 
+// Not in all GL headers we build against.
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
 static std::thread::id renderThreadId;
 #if MAX_LOGLEVEL >= DEBUG_LEVEL
 static bool OnRenderThread() {
@@ -95,6 +104,19 @@ void GLRenderManager::ThreadStart(Draw::DrawContext *draw) {
 	threadFrame_ = threadInitFrame_;
 	renderThreadId = std::this_thread::get_id();
 
+	// Let the driver compile shaders on its own worker threads where supported.
+	// Makes a big difference for shader cache preload time on some drivers.
+#if defined(__ANDROID__) || !defined(USING_GLES2)
+	if (gl_extensions.KHR_parallel_shader_compile && glMaxShaderCompilerThreadsKHR) {
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+	}
+#ifndef USING_GLES2
+	else if (gl_extensions.ARB_parallel_shader_compile && glMaxShaderCompilerThreadsARB) {
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+	}
+#endif
+#endif
+
 	// Don't save draw, we don't want any thread safety confusion.
 	bool mapBuffers = draw->GetBugs().Has(Draw::Bugs::ANY_MAP_BUFFER_RANGE_SLOW);
 	bool hasBufferStorage = gl_extensions.ARB_buffer_storage || gl_extensions.EXT_buffer_storage;
@@ -124,6 +146,13 @@ void GLRenderManager::ThreadStart(Draw::DrawContext *draw) {
 		default:
 			bufferStrategy_ = GLBufferStrategy::SUBDATA;
 		}
+	} else if (hasBufferStorage && !gl_extensions.IsGLES) {
+		// With buffer storage we map the pushbuffers persistent-coherent, so
+		// writes go straight into GPU-visible memory with no orphaning or
+		// glBufferSubData copy. Reuse is guarded by a fence in Submit().
+		// Desktop only for now - on Android, mapped buffers don't survive a
+		// task switch (see the Qualcomm note above).
+		bufferStrategy_ = GLBufferStrategy::FRAME_UNMAP;
 	} else {
 		bufferStrategy_ = GLBufferStrategy::SUBDATA;
 	}
@@ -147,6 +176,14 @@ void GLRenderManager::ThreadEnd() {
 		}
 		frameData_[i].steps.clear();
 		frameData_[i].initSteps.clear();
+#ifndef USING_GLES2
+		if (!frameData_[i].profile.queries.empty()) {
+			if (!skipGLCalls_)
+				glDeleteQueries((GLsizei)frameData_[i].profile.queries.size(), &frameData_[i].profile.queries[0]);
+			frameData_[i].profile.queries.clear();
+			frameData_[i].profile.stepTypes.clear();
+		}
+#endif
 	}
 	deleter_.Perform(this, skipGLCalls_);
 
@@ -471,6 +508,24 @@ void GLRenderManager::Submit(int frame, bool triggerFence) {
 	// When !triggerFence, we notify after syncing with Vulkan.
 
 	if (triggerFence) {
+		// Persistently mapped pushbuffers have no orphaning to protect their
+		// old contents, so don't hand the frame slot back for writing until
+		// the GPU has finished reading this frame's data.
+		bool hasPersistent = false;
+		for (auto iter : frameData.activePushBuffers) {
+			if (iter->HasPersistentBuffers()) {
+				hasPersistent = true;
+				break;
+			}
+		}
+		if (hasPersistent) {
+			GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			if (sync) {
+				glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ULL);
+				glDeleteSync(sync);
+			}
+		}
+
 		VLOG("PULL: Frame %d.readyForFence = true", frame);
 
 		std::unique_lock<std::mutex> lock(frameData.push_mutex);
@@ -511,6 +566,36 @@ void GLRenderManager::Run(int frame) {
 
 	auto &stepsOnThread = frameData_[frame].steps;
 	auto &initStepsOnThread = frameData_[frame].initSteps;
+
+#if defined(USE_PROFILER) && !defined(USING_GLES2)
+	// Decided here since gl_extensions isn't populated until the render thread
+	// has a context. Desktop only for now - the GLES path would need the
+	// EXT_disjoint_timer_query entry points, which we don't load.
+	frameData.profile.enabled = !gl_extensions.IsGLES && gl_extensions.VersionGEThan(3, 3) && !skipGLCalls_;
+	if (!frameData.profile.stepTypes.empty()) {
+		// Timestamps issued the last time this slot was used. The GPU has
+		// normally long finished them; if not, skip rather than stall.
+		GLuint available = GL_FALSE;
+		glGetQueryObjectuiv(frameData.profile.queries[frameData.profile.stepTypes.size()], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available) {
+			// Indexed by GLRStepType, to credit each step's GPU time so the
+			// overlay can show the CPU/GPU split.
+			static const char * const stepCategories[] = {
+				"gpu_render", "gpu_copy", "gpu_blit", "gpu_readback", "gpu_readback",
+			};
+			GLuint64 prev = 0;
+			glGetQueryObjectui64v(frameData.profile.queries[0], GL_QUERY_RESULT, &prev);
+			for (size_t i = 0; i < frameData.profile.stepTypes.size(); i++) {
+				GLuint64 stamp = 0;
+				glGetQueryObjectui64v(frameData.profile.queries[i + 1], GL_QUERY_RESULT, &stamp);
+				internal_profiler_add_time(internal_profiler_resolve(stepCategories[(int)frameData.profile.stepTypes[i]]), (double)(stamp - prev) * 1e-9);
+				prev = stamp;
+			}
+		}
+		frameData.profile.stepTypes.clear();
+	}
+#endif
+
 	// queueRunner_.LogSteps(stepsOnThread);
 	queueRunner_.RunInitSteps(initStepsOnThread, skipGLCalls_);
 	initStepsOnThread.clear();
@@ -523,7 +608,7 @@ void GLRenderManager::Run(int frame) {
 		}
 	}
 
-	queueRunner_.RunSteps(stepsOnThread, skipGLCalls_);
+	queueRunner_.RunSteps(stepsOnThread, skipGLCalls_, frameData.profile.enabled ? &frameData.profile : nullptr);
 	stepsOnThread.clear();
 
 	if (!skipGLCalls_) {
@@ -811,7 +896,7 @@ void GLPushBuffer::UnmapDevice() {
 	_dbg_assert_msg_(G3D, OnRenderThread(), "UnmapDevice must run on render thread");
 
 	for (auto &info : buffers_) {
-		if (info.deviceMemory) {
+		if (info.deviceMemory && !info.buffer->IsPersistentlyMapped()) {
 			// TODO: Technically this can return false?
 			info.buffer->Unmap();
 			info.deviceMemory = nullptr;
@@ -819,6 +904,14 @@ void GLPushBuffer::UnmapDevice() {
 	}
 }
 
+bool GLPushBuffer::HasPersistentBuffers() const {
+	for (auto &info : buffers_) {
+		if (info.buffer && info.buffer->IsPersistentlyMapped())
+			return true;
+	}
+	return false;
+}
+
 void *GLRBuffer::Map(GLBufferStrategy strategy) {
 	assert(buffer_ != 0);
 
@@ -833,12 +926,22 @@ void *GLRBuffer::Map(GLBufferStrategy strategy) {
 	void *p = nullptr;
 	bool allowNativeBuffer = strategy != GLBufferStrategy::SUBDATA;
 	if (allowNativeBuffer) {
+		if (persistentPtr_) {
+			// Already mapped for the buffer's lifetime, just keep using it.
+			mapped_ = true;
+			return persistentPtr_;
+		}
+
 		glBindBuffer(target_, buffer_);
 
 		if (gl_extensions.ARB_buffer_storage || gl_extensions.EXT_buffer_storage) {
 #ifndef IOS
+			// Persistent-coherent: the mapping stays valid while the GPU reads
+			// from the buffer, and writes become visible without flushing.
+			// Invalidate/flush bits aren't valid together with persistent.
+			access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
 			if (!hasStorage_) {
-				GLbitfield storageFlags = access & ~(GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+				GLbitfield storageFlags = access;
 #ifdef USING_GLES2
 #ifdef GL_EXT_buffer_storage
 				glBufferStorageEXT(target_, size_, nullptr, storageFlags);
@@ -850,6 +953,7 @@ void *GLRBuffer::Map(GLBufferStrategy strategy) {
 			}
 #endif
 			p = glMapBufferRange(target_, 0, size_, access);
+			persistentPtr_ = p;
 		} else if (gl_extensions.VersionGEThan(3, 0, 0)) {
 			// GLES3 or desktop 3.
 			p = glMapBufferRange(target_, 0, size_, access);
@@ -867,5 +971,6 @@ void *GLRBuffer::Map(GLBufferStrategy strategy) {
 bool GLRBuffer::Unmap() {
 	glBindBuffer(target_, buffer_);
 	mapped_ = false;
+	persistentPtr_ = nullptr;
 	return glUnmapBuffer(target_) == GL_TRUE;
 }
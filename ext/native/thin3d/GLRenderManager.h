@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -117,6 +118,17 @@ public:
 	std::vector<UniformLocQuery> queries_;
 	std::vector<Initializer> initialize_;
 
+	// Program binary support (ARB_get_program_binary / ES 3.0), used by the shader disk cache.
+	// If useBinary_ is set, the queue runner feeds binary_ to glProgramBinary before falling back
+	// to a regular source link. If keepBinary_ is set, binary_ holds the linked program's binary
+	// afterwards. binaryValid_ is set once on the GL thread after binary_ is final, and read on
+	// the emu thread when saving the cache, hence atomic.
+	bool useBinary_ = false;
+	bool keepBinary_ = false;
+	GLenum binaryFormat_ = 0;
+	std::vector<uint8_t> binary_;
+	std::atomic<bool> binaryValid_{ false };
+
 	struct UniformInfo {
 		int loc_;
 	};
@@ -175,6 +187,12 @@ public:
 		return mapped_;
 	}
 
+	// Buffers with immutable storage stay mapped persistent-coherent for
+	// their whole lifetime, so there's no per-frame map/unmap or flushing.
+	bool IsPersistentlyMapped() const {
+		return persistentPtr_ != nullptr;
+	}
+
 	GLuint buffer_ = 0;
 	GLuint target_;
 	int size_;
@@ -182,6 +200,7 @@ public:
 private:
 	bool mapped_ = false;
 	bool hasStorage_ = false;
+	void *persistentPtr_ = nullptr;
 };
 
 class GLRenderManager;
@@ -285,6 +304,10 @@ public:
 
 	size_t GetTotalSize() const;
 
+	// True if any of the backing buffers are persistently mapped - reuse of
+	// those must be fence-guarded since there's no orphaning.
+	bool HasPersistentBuffers() const;
+
 	void Destroy(bool onRenderThread);
 	void Flush();
 
@@ -425,13 +448,20 @@ public:
 	// not be an active render pass.
 	GLRProgram *CreateProgram(
 		std::vector<GLRShader *> shaders, std::vector<GLRProgram::Semantic> semantics, std::vector<GLRProgram::UniformLocQuery> queries,
-		std::vector<GLRProgram::Initializer> initalizers, bool supportDualSource) {
+		std::vector<GLRProgram::Initializer> initalizers, bool supportDualSource,
+		bool keepProgramBinary = false, GLenum programBinaryFormat = 0, std::vector<uint8_t> programBinary = std::vector<uint8_t>()) {
 		GLRInitStep step{ GLRInitStepType::CREATE_PROGRAM };
 		assert(shaders.size() <= ARRAY_SIZE(step.create_program.shaders));
 		step.create_program.program = new GLRProgram();
 		step.create_program.program->semantics_ = semantics;
 		step.create_program.program->queries_ = queries;
 		step.create_program.program->initialize_ = initalizers;
+		step.create_program.program->keepBinary_ = keepProgramBinary;
+		if (!programBinary.empty()) {
+			step.create_program.program->useBinary_ = true;
+			step.create_program.program->binaryFormat_ = programBinaryFormat;
+			step.create_program.program->binary_ = std::move(programBinary);
+		}
 		step.create_program.support_dual_source = supportDualSource;
 		_assert_msg_(G3D, shaders.size() > 0, "Can't create a program with zero shaders");
 		for (size_t i = 0; i < shaders.size(); i++) {
@@ -955,6 +985,10 @@ private:
 		GLDeleter deleter;
 		GLDeleter deleter_prev;
 		std::set<GLPushBuffer *> activePushBuffers;
+
+		// GPU time attribution (USE_PROFILER). Timer queries from this slot's
+		// last use are read the next time it comes around in Run().
+		GLQueueProfileContext profile;
 	};
 
 	FrameData frameData_[MAX_INFLIGHT_FRAMES];
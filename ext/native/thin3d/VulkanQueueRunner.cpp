@@ -26,29 +26,17 @@ void VulkanQueueRunner::CreateDeviceObjects() {
 #endif
 }
 
-void VulkanQueueRunner::ResizeReadbackBuffer(VkDeviceSize requiredSize) {
-	if (readbackBuffer_ && requiredSize <= readbackBufferSize_) {
-		return;
-	}
-	if (readbackMemory_) {
-		vulkan_->Delete().QueueDeleteDeviceMemory(readbackMemory_);
-	}
-	if (readbackBuffer_) {
-		vulkan_->Delete().QueueDeleteBuffer(readbackBuffer_);
-	}
-
-	readbackBufferSize_ = requiredSize;
-
+void VulkanQueueRunner::AllocateReadbackBuffer(VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, bool *isCoherent) {
 	VkDevice device = vulkan_->GetDevice();
 
 	VkBufferCreateInfo buf{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-	buf.size = readbackBufferSize_;
+	buf.size = size;
 	buf.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-	vkCreateBuffer(device, &buf, nullptr, &readbackBuffer_);
+	vkCreateBuffer(device, &buf, nullptr, buffer);
 
 	VkMemoryRequirements reqs{};
-	vkGetBufferMemoryRequirements(device, readbackBuffer_, &reqs);
+	vkGetBufferMemoryRequirements(device, *buffer, &reqs);
 
 	VkMemoryAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
 	allocInfo.allocationSize = reqs.size;
@@ -69,17 +57,32 @@ void VulkanQueueRunner::ResizeReadbackBuffer(VkDeviceSize requiredSize) {
 		}
 	}
 	_assert_(successTypeReqs != 0);
-	readbackBufferIsCoherent_ = (successTypeReqs & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+	*isCoherent = (successTypeReqs & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
 
-	VkResult res = vkAllocateMemory(device, &allocInfo, nullptr, &readbackMemory_);
+	VkResult res = vkAllocateMemory(device, &allocInfo, nullptr, memory);
 	if (res != VK_SUCCESS) {
-		readbackMemory_ = VK_NULL_HANDLE;
-		vkDestroyBuffer(device, readbackBuffer_, nullptr);
-		readbackBuffer_ = VK_NULL_HANDLE;
+		*memory = VK_NULL_HANDLE;
+		vkDestroyBuffer(device, *buffer, nullptr);
+		*buffer = VK_NULL_HANDLE;
 		return;
 	}
 	uint32_t offset = 0;
-	vkBindBufferMemory(device, readbackBuffer_, readbackMemory_, offset);
+	vkBindBufferMemory(device, *buffer, *memory, offset);
+}
+
+void VulkanQueueRunner::ResizeReadbackBuffer(VkDeviceSize requiredSize) {
+	if (readbackBuffer_ && requiredSize <= readbackBufferSize_) {
+		return;
+	}
+	if (readbackMemory_) {
+		vulkan_->Delete().QueueDeleteDeviceMemory(readbackMemory_);
+	}
+	if (readbackBuffer_) {
+		vulkan_->Delete().QueueDeleteBuffer(readbackBuffer_);
+	}
+
+	readbackBufferSize_ = requiredSize;
+	AllocateReadbackBuffer(readbackBufferSize_, &readbackBuffer_, &readbackMemory_, &readbackBufferIsCoherent_);
 }
 
 void VulkanQueueRunner::DestroyDeviceObjects() {
@@ -88,6 +91,19 @@ void VulkanQueueRunner::DestroyDeviceObjects() {
 	vulkan_->Delete().QueueDeleteBuffer(readbackBuffer_);
 	readbackBufferSize_ = 0;
 
+	{
+		std::lock_guard<std::mutex> guard(delayedReadbackMutex_);
+		for (auto &iter : delayedReadbacks_) {
+			for (int i = 0; i < VulkanContext::MAX_INFLIGHT_FRAMES; i++) {
+				if (iter.second.memory[i])
+					vulkan_->Delete().QueueDeleteDeviceMemory(iter.second.memory[i]);
+				if (iter.second.buffer[i])
+					vulkan_->Delete().QueueDeleteBuffer(iter.second.buffer[i]);
+			}
+		}
+		delayedReadbacks_.clear();
+	}
+
 	renderPasses_.Iterate([&](const RPKey &rpkey, VkRenderPass rp) {
 		_assert_(rp != VK_NULL_HANDLE);
 		vulkan_->Delete().QueueDeleteRenderPass(rp);
@@ -374,7 +390,7 @@ VkRenderPass VulkanQueueRunner::GetRenderPass(const RPKey &key) {
 	return pass;
 }
 
-void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &steps) {
+void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &steps, QueueProfileContext *profile) {
 	// Optimizes renderpasses, then sequences them.
 	// Planned optimizations: 
 	//  * Create copies of render target that are rendered to multiple times and textured from in sequence, and push those render passes
@@ -441,6 +457,43 @@ void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &st
 		}
 	}
 
+	// Merge consecutive render passes to the same framebuffer (the passes above often
+	// leave RENDER_SKIPs between two such). Each pass costs a full tile load/store on
+	// tiled GPUs, so games that ping-pong between targets gain a lot from this.
+	for (int j = 0; j < (int)steps.size() - 1; j++) {
+		if (steps[j]->stepType != VKRStepType::RENDER || !steps[j]->render.framebuffer)
+			continue;
+		// Only merge when nothing can have observed the attachments in between - any
+		// step other than RENDER_SKIP might read or write this framebuffer.
+		int i = j + 1;
+		while (i < (int)steps.size() && steps[i]->stepType == VKRStepType::RENDER_SKIP)
+			i++;
+		if (i >= (int)steps.size() || steps[i]->stepType != VKRStepType::RENDER)
+			continue;
+		VKRStep *dst = steps[j];
+		VKRStep *src = steps[i];
+		if (src->render.framebuffer != dst->render.framebuffer)
+			continue;
+		// A clear in the second pass would need vkCmdClearAttachments to merge. Skip.
+		if (src->render.color == VKRRenderPassAction::CLEAR ||
+			src->render.depth == VKRRenderPassAction::CLEAR ||
+			src->render.stencil == VKRRenderPassAction::CLEAR)
+			continue;
+		// If the first pass is expected to end in some other layout, something samples
+		// the framebuffer before the second pass gets to run. Can't merge then.
+		if (dst->render.finalColorLayout != VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)
+			continue;
+		for (size_t k = 0; k < src->commands.size(); k++) {
+			dst->commands.push_back(src->commands[k]);
+		}
+		dst->render.numDraws += src->render.numDraws;
+		dst->render.numReads += src->render.numReads;
+		dst->render.finalColorLayout = src->render.finalColorLayout;
+		src->stepType = VKRStepType::RENDER_SKIP;
+		// Retry from the merged step - there might be another pass to pull in.
+		j--;
+	}
+
 	for (size_t i = 0; i < steps.size(); i++) {
 		const VKRStep &step = *steps[i];
 		switch (step.stepType) {
@@ -462,6 +515,13 @@ void VulkanQueueRunner::RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &st
 		case VKRStepType::RENDER_SKIP:
 			break;
 		}
+		// One timestamp after each executed step - the delta to the previous
+		// one is this step's GPU time.
+		if (profile && step.stepType != VKRStepType::RENDER_SKIP &&
+			profile->stepTypes.size() < MAX_TIMESTAMP_QUERIES - 1) {
+			vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, profile->queryPool, 1 + (uint32_t)profile->stepTypes.size());
+			profile->stepTypes.push_back(step.stepType);
+		}
 	}
 
 	// Deleting all in one go should be easier on the instruction cache than deleting
@@ -1313,7 +1373,36 @@ void VulkanQueueRunner::SetupTransitionToTransferDst(VKRImage &img, VkImageMemor
 }
 
 void VulkanQueueRunner::PerformReadback(const VKRStep &step, VkCommandBuffer cmd) {
-	ResizeReadbackBuffer(sizeof(uint32_t) * step.readback.srcRect.extent.width * step.readback.srcRect.extent.height);
+	VkDeviceSize requiredSize = sizeof(uint32_t) * step.readback.srcRect.extent.width * step.readback.srcRect.extent.height;
+
+	VkBuffer destBuffer;
+	if (step.readback.delayed) {
+		// Copy into this frame's ring slot for the source framebuffer, where the emu thread
+		// will pick it up a few frames from now.
+		std::lock_guard<std::mutex> guard(delayedReadbackMutex_);
+		DelayedReadback &ring = delayedReadbacks_[step.readback.src];
+		int slot = curFrame_;
+		if (ring.buffer[slot] && ring.size[slot] < requiredSize) {
+			vulkan_->Delete().QueueDeleteDeviceMemory(ring.memory[slot]);
+			vulkan_->Delete().QueueDeleteBuffer(ring.buffer[slot]);
+			ring.size[slot] = 0;
+		}
+		if (!ring.buffer[slot]) {
+			AllocateReadbackBuffer(requiredSize, &ring.buffer[slot], &ring.memory[slot], &ring.isCoherent[slot]);
+			if (!ring.buffer[slot]) {
+				ring.width[slot] = 0;
+				ring.height[slot] = 0;
+				return;
+			}
+			ring.size[slot] = requiredSize;
+		}
+		ring.width[slot] = step.readback.srcRect.extent.width;
+		ring.height[slot] = step.readback.srcRect.extent.height;
+		destBuffer = ring.buffer[slot];
+	} else {
+		ResizeReadbackBuffer(requiredSize);
+		destBuffer = readbackBuffer_;
+	}
 
 	VkBufferImageCopy region{};
 	region.imageOffset = { step.readback.srcRect.offset.x, step.readback.srcRect.offset.y, 0 };
@@ -1357,7 +1446,7 @@ void VulkanQueueRunner::PerformReadback(const VKRStep &step, VkCommandBuffer cmd
 		copyLayout = srcImage->layout;
 	}
 
-	vkCmdCopyImageToBuffer(cmd, image, copyLayout, readbackBuffer_, 1, &region);
+	vkCmdCopyImageToBuffer(cmd, image, copyLayout, destBuffer, 1, &region);
 
 	// NOTE: Can't read the buffer using the CPU here - need to sync first.
 
@@ -1430,25 +1519,63 @@ void VulkanQueueRunner::CopyReadbackBuffer(int width, int height, Draw::DataForm
 		return;
 	}
 
+	ConvertReadbackData((const uint8_t *)mappedData, width, height, srcFormat, destFormat, pixelStride, pixels);
+	vkUnmapMemory(vulkan_->GetDevice(), readbackMemory_);
+}
+
+void VulkanQueueRunner::ConvertReadbackData(const uint8_t *mappedData, int width, int height, Draw::DataFormat srcFormat, Draw::DataFormat destFormat, int pixelStride, uint8_t *pixels) {
+	const size_t srcPixelSize = DataFormatSizeInBytes(srcFormat);
+
 	// TODO: Perform these conversions in a compute shader on the GPU.
 	if (srcFormat == Draw::DataFormat::R8G8B8A8_UNORM) {
-		ConvertFromRGBA8888(pixels, (const uint8_t *)mappedData, pixelStride, width, width, height, destFormat);
+		ConvertFromRGBA8888(pixels, mappedData, pixelStride, width, width, height, destFormat);
 	} else if (srcFormat == Draw::DataFormat::B8G8R8A8_UNORM) {
-		ConvertFromBGRA8888(pixels, (const uint8_t *)mappedData, pixelStride, width, width, height, destFormat);
+		ConvertFromBGRA8888(pixels, mappedData, pixelStride, width, width, height, destFormat);
 	} else if (srcFormat == destFormat) {
 		uint8_t *dst = pixels;
-		const uint8_t *src = (const uint8_t *)mappedData;
+		const uint8_t *src = mappedData;
 		for (int y = 0; y < height; ++y) {
 			memcpy(dst, src, width * srcPixelSize);
 			src += width * srcPixelSize;
 			dst += pixelStride * srcPixelSize;
 		}
 	} else if (destFormat == Draw::DataFormat::D32F) {
-		ConvertToD32F(pixels, (const uint8_t *)mappedData, pixelStride, width, width, height, srcFormat);
+		ConvertToD32F(pixels, mappedData, pixelStride, width, width, height, srcFormat);
 	} else {
 		// TODO: Maybe a depth conversion or something?
-		ELOG("CopyReadbackBuffer: Unknown format");
+		ELOG("ConvertReadbackData: Unknown format");
 		assert(false);
 	}
-	vkUnmapMemory(vulkan_->GetDevice(), readbackMemory_);
+}
+
+bool VulkanQueueRunner::CopyDelayedReadbackData(VKRFramebuffer *src, int slot, int width, int height, Draw::DataFormat srcFormat, Draw::DataFormat destFormat, int pixelStride, uint8_t *pixels) {
+	std::lock_guard<std::mutex> guard(delayedReadbackMutex_);
+	auto iter = delayedReadbacks_.find(src);
+	if (iter == delayedReadbacks_.end())
+		return false;
+	DelayedReadback &ring = iter->second;
+	// If the dimensions don't match, the slot hasn't been written with a readback of this
+	// rectangle yet - tell the caller so it can fall back to a synchronous readback.
+	if (!ring.memory[slot] || ring.width[slot] != width || ring.height[slot] != height)
+		return false;
+
+	void *mappedData;
+	const size_t srcPixelSize = DataFormatSizeInBytes(srcFormat);
+
+	VkResult res = vkMapMemory(vulkan_->GetDevice(), ring.memory[slot], 0, width * height * srcPixelSize, 0, &mappedData);
+	if (res != VK_SUCCESS) {
+		ELOG("CopyDelayedReadbackData: vkMapMemory failed! result=%d", (int)res);
+		return false;
+	}
+	if (!ring.isCoherent[slot]) {
+		VkMappedMemoryRange range{};
+		range.memory = ring.memory[slot];
+		range.offset = 0;
+		range.size = width * height * srcPixelSize;
+		vkInvalidateMappedMemoryRanges(vulkan_->GetDevice(), 1, &range);
+	}
+
+	ConvertReadbackData((const uint8_t *)mappedData, width, height, srcFormat, destFormat, pixelStride, pixels);
+	vkUnmapMemory(vulkan_->GetDevice(), ring.memory[slot]);
+	return true;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
+#include <mutex>
 
 #include "Common/Hashmaps.h"
 #include "Common/Vulkan/VulkanContext.h"
@@ -102,6 +104,20 @@ enum class VKRRenderPassAction : uint8_t {
 	KEEP,
 };
 
+// Timestamp queries bracketing each executed step, so GPU time can be
+// attributed per step type. One of these lives in each in-flight frame's data;
+// the results are read back after the frame's fence in BeginFrame.
+struct QueueProfileContext {
+	bool enabled = false;
+	VkQueryPool queryPool = VK_NULL_HANDLE;
+	// Step type per timestamp written after query 0 (which starts the frame.)
+	std::vector<VKRStepType> stepTypes;
+};
+
+enum {
+	MAX_TIMESTAMP_QUERIES = 1024,
+};
+
 struct TransitionRequest {
 	VKRFramebuffer *fb;
 	VkImageLayout targetLayout;
@@ -145,6 +161,9 @@ struct VKRStep {
 			int aspectMask;
 			VKRFramebuffer *src;
 			VkRect2D srcRect;
+			// If set, copies into the per-framebuffer ring of buffers instead of the shared
+			// readback buffer, so the CPU can read the result a few frames later without a stall.
+			bool delayed;
 		} readback;
 		struct {
 			VkImage image;
@@ -163,7 +182,8 @@ public:
 	}
 
 	// RunSteps can modify steps but will leave it in a valid state.
-	void RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &steps);
+	// If profile is set, writes a timestamp after each executed step.
+	void RunSteps(VkCommandBuffer cmd, std::vector<VKRStep *> &steps, QueueProfileContext *profile = nullptr);
 	void LogSteps(const std::vector<VKRStep *> &steps);
 
 	void CreateDeviceObjects();
@@ -185,6 +205,16 @@ public:
 
 	void CopyReadbackBuffer(int width, int height, Draw::DataFormat srcFormat, Draw::DataFormat destFormat, int pixelStride, uint8_t *pixels);
 
+	// Retrieves the result of a delayed readback queued GetInflightFrames() frames ago - the
+	// slot's fence has already been waited for in BeginFrame so no stall. Returns false if
+	// there's nothing usable in the ring yet (first readback from src, or the size changed).
+	bool CopyDelayedReadbackData(VKRFramebuffer *src, int slot, int width, int height, Draw::DataFormat srcFormat, Draw::DataFormat destFormat, int pixelStride, uint8_t *pixels);
+
+	// Delayed readbacks land in the ring slot of the frame being run. Called from Run().
+	void SetCurrentFrame(int frame) {
+		curFrame_ = frame;
+	}
+
 	struct RPKey {
 		VKRRenderPassAction colorLoadAction;
 		VKRRenderPassAction depthLoadAction;
@@ -236,7 +266,9 @@ private:
 	void LogReadback(const VKRStep &pass);
 	void LogReadbackImage(const VKRStep &pass);
 
+	void AllocateReadbackBuffer(VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, bool *isCoherent);
 	void ResizeReadbackBuffer(VkDeviceSize requiredSize);
+	void ConvertReadbackData(const uint8_t *mappedData, int width, int height, Draw::DataFormat srcFormat, Draw::DataFormat destFormat, int pixelStride, uint8_t *pixels);
 
 	void ApplyMGSHack(std::vector<VKRStep *> &steps);
 	void ApplySonicHack(std::vector<VKRStep *> &steps);
@@ -256,13 +288,33 @@ private:
 	// TODO: Create these on demand.
 	DenseHashMap<RPKey, VkRenderPass, (VkRenderPass)VK_NULL_HANDLE> renderPasses_;
 
-	// Readback buffer. Currently we only support synchronous readback, so we only really need one.
-	// We size it generously.
+	// Readback buffer for synchronous readbacks. We size it generously.
 	VkDeviceMemory readbackMemory_ = VK_NULL_HANDLE;
 	VkBuffer readbackBuffer_ = VK_NULL_HANDLE;
 	VkDeviceSize readbackBufferSize_ = 0;
 	bool readbackBufferIsCoherent_ = false;
 
+	// One ring of host-visible buffers per delayed-readback source. The slot written while
+	// running frame N is read by the emu thread during frame N + GetInflightFrames(), right
+	// after BeginFrame waited for that slot's fence - so the contents are always complete.
+	// Buffers are kept until DestroyDeviceObjects; only downloaded framebuffers get a ring
+	// so this stays small.
+	struct DelayedReadback {
+		VkBuffer buffer[VulkanContext::MAX_INFLIGHT_FRAMES]{};
+		VkDeviceMemory memory[VulkanContext::MAX_INFLIGHT_FRAMES]{};
+		VkDeviceSize size[VulkanContext::MAX_INFLIGHT_FRAMES]{};
+		bool isCoherent[VulkanContext::MAX_INFLIGHT_FRAMES]{};
+		// Dimensions of the last copy into each slot, 0 if never written.
+		int width[VulkanContext::MAX_INFLIGHT_FRAMES]{};
+		int height[VulkanContext::MAX_INFLIGHT_FRAMES]{};
+	};
+	// Guards the map and the metadata - the render thread allocates buffers and records
+	// dimensions while the emu thread reads results out of older slots.
+	std::mutex delayedReadbackMutex_;
+	std::map<VKRFramebuffer *, DelayedReadback> delayedReadbacks_;
+
+	int curFrame_ = 0;
+
 	// TODO: Enable based on compat.ini.
 	uint32_t hacksEnabled_ = 0;
 };
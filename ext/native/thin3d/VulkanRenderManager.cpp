@@ -5,6 +5,7 @@
 #include "base/logging.h"
 
 #include "Common/Vulkan/VulkanContext.h"
+#include "profiler/profiler.h"
 #include "thin3d/VulkanRenderManager.h"
 #include "thread/threadutil.h"
 
@@ -111,6 +112,12 @@ VulkanRenderManager::VulkanRenderManager(VulkanContext *vulkan) : vulkan_(vulkan
 	res = vkCreateSemaphore(vulkan_->GetDevice(), &semaphoreCreateInfo, nullptr, &renderingCompleteSemaphore_);
 	assert(res == VK_SUCCESS);
 
+#ifdef USE_PROFILER
+	// GPU timestamps per queue step, to attribute GPU time in the profiler.
+	// timestampPeriod == 0 means the device can't time command execution.
+	gpuProfiling_ = vulkan_->GetPhysicalDeviceProperties().properties.limits.timestampPeriod > 0.0f;
+#endif
+
 	for (int i = 0; i < vulkan_->GetInflightFrames(); i++) {
 		VkCommandPoolCreateInfo cmd_pool_info = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
 		cmd_pool_info.queueFamilyIndex = vulkan_->GetGraphicsQueueFamilyIndex();
@@ -131,6 +138,15 @@ VulkanRenderManager::VulkanRenderManager(VulkanContext *vulkan) : vulkan_(vulkan
 		res = vkAllocateCommandBuffers(vulkan_->GetDevice(), &cmd_alloc, &frameData_[i].mainCmd);
 		assert(res == VK_SUCCESS);
 		frameData_[i].fence = vulkan_->CreateFence(true);  // So it can be instantly waited on
+
+		if (gpuProfiling_) {
+			VkQueryPoolCreateInfo query_ci{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+			query_ci.queryCount = MAX_TIMESTAMP_QUERIES;
+			query_ci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			res = vkCreateQueryPool(vulkan_->GetDevice(), &query_ci, nullptr, &frameData_[i].profile.queryPool);
+			assert(res == VK_SUCCESS);
+			frameData_[i].profile.enabled = true;
+		}
 	}
 
 	queueRunner_.CreateDeviceObjects();
@@ -289,12 +305,15 @@ VulkanRenderManager::~VulkanRenderManager() {
 		vkDestroyCommandPool(device, frameData_[i].cmdPoolInit, nullptr);
 		vkDestroyCommandPool(device, frameData_[i].cmdPoolMain, nullptr);
 		vkDestroyFence(device, frameData_[i].fence, nullptr);
+		if (frameData_[i].profile.queryPool)
+			vkDestroyQueryPool(device, frameData_[i].profile.queryPool, nullptr);
 	}
 	queueRunner_.DestroyDeviceObjects();
 }
 
 void VulkanRenderManager::ThreadFunc() {
 	setCurrentThreadName("RenderMan");
+	setCurrentThreadRole(ThreadRole::RENDER);
 	int threadFrame = threadInitFrame_;
 	bool nextFrame = false;
 	bool firstFrame = true;
@@ -360,6 +379,30 @@ void VulkanRenderManager::BeginFrame() {
 	vkWaitForFences(device, 1, &frameData.fence, true, UINT64_MAX);
 	vkResetFences(device, 1, &frameData.fence);
 
+#ifdef USE_PROFILER
+	if (!frameData.profile.stepTypes.empty()) {
+		// The fence above means the timestamps from this slot's last submit are
+		// done - credit each step's GPU time so the overlay can show the
+		// CPU/GPU split. Indexed by VKRStepType; RENDER_SKIP never gets one.
+		static const char * const stepCategories[] = {
+			"gpu_render", "gpu_render", "gpu_copy", "gpu_blit", "gpu_readback", "gpu_readback",
+		};
+		uint64_t queryResults[MAX_TIMESTAMP_QUERIES];
+		uint32_t numQueries = 1 + (uint32_t)frameData.profile.stepTypes.size();
+		VkResult res = vkGetQueryPoolResults(
+			device, frameData.profile.queryPool, 0, numQueries, sizeof(uint64_t) * numQueries,
+			&queryResults[0], sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+		if (res == VK_SUCCESS) {
+			double secondsPerTick = 1e-9 * vulkan_->GetPhysicalDeviceProperties().properties.limits.timestampPeriod;
+			for (size_t i = 0; i < frameData.profile.stepTypes.size(); i++) {
+				double seconds = (double)(queryResults[i + 1] - queryResults[i]) * secondsPerTick;
+				internal_profiler_add_time(internal_profiler_resolve(stepCategories[(int)frameData.profile.stepTypes[i]]), seconds);
+			}
+		}
+		frameData.profile.stepTypes.clear();
+	}
+#endif
+
 	// Must be after the fence - this performs deletes.
 	VLOG("PUSH: BeginFrame %d", curFrame);
 	if (!run_) {
@@ -446,6 +489,7 @@ bool VulkanRenderManager::CopyFramebufferToMemorySync(VKRFramebuffer *src, int a
 	step->readback.src = src;
 	step->readback.srcRect.offset = { x, y };
 	step->readback.srcRect.extent = { (uint32_t)w, (uint32_t)h };
+	step->readback.delayed = false;
 	steps_.push_back(step);
 
 	curRenderStep_ = nullptr;
@@ -492,6 +536,51 @@ bool VulkanRenderManager::CopyFramebufferToMemorySync(VKRFramebuffer *src, int a
 	return true;
 }
 
+bool VulkanRenderManager::CopyFramebufferToMemoryDelayed(VKRFramebuffer *src, int aspectBits, int x, int y, int w, int h, Draw::DataFormat destFormat, uint8_t *pixels, int pixelStride) {
+	// Only color readbacks from our own framebuffers go through the delayed path - the
+	// backbuffer readback (screenshots) is rare enough that stalling is fine, and depth/stencil
+	// downloads want exact data.
+	if (!src || aspectBits != VK_IMAGE_ASPECT_COLOR_BIT) {
+		return CopyFramebufferToMemorySync(src, aspectBits, x, y, w, h, destFormat, pixels, pixelStride);
+	}
+	Draw::DataFormat srcFormat;
+	switch (src->color.format) {
+	case VK_FORMAT_R8G8B8A8_UNORM: srcFormat = Draw::DataFormat::R8G8B8A8_UNORM; break;
+	default: _assert_(false); return false;
+	}
+
+	for (int i = (int)steps_.size() - 1; i >= 0; i--) {
+		if (steps_[i]->stepType == VKRStepType::RENDER && steps_[i]->render.framebuffer == src) {
+			steps_[i]->render.numReads++;
+			break;
+		}
+	}
+
+	// Queue a readback into this frame's ring slot for src, to be retrieved once the GPU
+	// is done with this frame - that is, GetInflightFrames() frames from now.
+	VKRStep *step = new VKRStep{ VKRStepType::READBACK };
+	step->readback.aspectMask = aspectBits;
+	step->readback.src = src;
+	step->readback.srcRect.offset = { x, y };
+	step->readback.srcRect.extent = { (uint32_t)w, (uint32_t)h };
+	step->readback.delayed = true;
+	steps_.push_back(step);
+
+	curRenderStep_ = nullptr;
+
+	// This frame's slot holds the data from the readback we queued GetInflightFrames() frames
+	// ago - its fence was waited for in BeginFrame, so reading it doesn't stall. The pixels are
+	// a few frames old, which is fine for downloads whose results the game polls continuously.
+	int slot = vulkan_->GetCurFrame();
+	if (!queueRunner_.CopyDelayedReadbackData(src, slot, w, h, srcFormat, destFormat, pixelStride, pixels)) {
+		// Nothing usable in the ring yet (first readback from this framebuffer, or the size
+		// changed). Sync like the old path this once - after a few frames the ring is warm.
+		FlushSync();
+		queueRunner_.CopyDelayedReadbackData(src, slot, w, h, srcFormat, destFormat, pixelStride, pixels);
+	}
+	return true;
+}
+
 void VulkanRenderManager::CopyImageToMemorySync(VkImage image, int mipLevel, int x, int y, int w, int h, Draw::DataFormat destFormat, uint8_t *pixels, int pixelStride) {
 	VKRStep *step = new VKRStep{ VKRStepType::READBACK_IMAGE };
 	step->readback_image.image = image;
@@ -992,7 +1081,17 @@ void VulkanRenderManager::Run(int frame) {
 	auto &stepsOnThread = frameData_[frame].steps;
 	VkCommandBuffer cmd = frameData.mainCmd;
 	// queueRunner_.LogSteps(stepsOnThread);
-	queueRunner_.RunSteps(cmd, stepsOnThread);
+	queueRunner_.SetCurrentFrame(frame);
+	// On a sync in the middle of a frame, this resets again - only the last
+	// segment's timings survive. Uploads in the init cmd aren't covered either,
+	// since it's recorded on the other thread before we could reset the pool.
+	QueueProfileContext *profile = frameData.profile.enabled ? &frameData.profile : nullptr;
+	if (profile) {
+		vkCmdResetQueryPool(cmd, profile->queryPool, 0, MAX_TIMESTAMP_QUERIES);
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, profile->queryPool, 0);
+		profile->stepTypes.clear();
+	}
+	queueRunner_.RunSteps(cmd, stepsOnThread, profile);
 	stepsOnThread.clear();
 
 	switch (frameData.type) {
@@ -103,6 +103,10 @@ public:
 	void BindFramebufferAsRenderTarget(VKRFramebuffer *fb, VKRRenderPassAction color, VKRRenderPassAction depth, VKRRenderPassAction stencil, uint32_t clearColor, float clearDepth, uint8_t clearStencil);
 	VkImageView BindFramebufferAsTexture(VKRFramebuffer *fb, int binding, int aspectBit, int attachment);
 	bool CopyFramebufferToMemorySync(VKRFramebuffer *src, int aspectBits, int x, int y, int w, int h, Draw::DataFormat destFormat, uint8_t *pixels, int pixelStride);
+	// Like the above but avoids the pipeline stall by returning pixels from a readback queued
+	// a few frames ago, through a per-framebuffer ring of buffers. Falls back to a synchronous
+	// readback when there's no usable data yet, or for non-color/backbuffer reads.
+	bool CopyFramebufferToMemoryDelayed(VKRFramebuffer *src, int aspectBits, int x, int y, int w, int h, Draw::DataFormat destFormat, uint8_t *pixels, int pixelStride);
 	void CopyImageToMemorySync(VkImage image, int mipLevel, int x, int y, int w, int h, Draw::DataFormat destFormat, uint8_t *pixels, int pixelStride);
 
 	void CopyFramebuffer(VKRFramebuffer *src, VkRect2D srcRect, VKRFramebuffer *dst, VkOffset2D dstPos, int aspectMask);
@@ -281,6 +285,10 @@ private:
 		bool hasInitCommands = false;
 		std::vector<VKRStep *> steps;
 
+		// GPU time attribution (USE_PROFILER). Results are pulled after the
+		// fence wait in BeginFrame, so reading them never stalls.
+		QueueProfileContext profile;
+
 		// Swapchain.
 		bool hasBegun = false;
 		uint32_t curSwapchainImage = -1;
@@ -302,6 +310,9 @@ private:
 	std::mutex mutex_;
 	int threadInitFrame_ = 0;
 	VulkanQueueRunner queueRunner_;
+	// Whether GPU timestamps feed the profiler. Off unless built with
+	// USE_PROFILER and the device can actually time command execution.
+	bool gpuProfiling_ = false;
 
 	// Swap chain management
 	struct SwapchainImageData {
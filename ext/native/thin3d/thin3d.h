@@ -588,6 +588,12 @@ public:
 	virtual bool CopyFramebufferToMemorySync(Framebuffer *src, int channelBits, int x, int y, int w, int h, Draw::DataFormat format, void *pixels, int pixelStride) {
 		return false;
 	}
+	// Like CopyFramebufferToMemorySync, but the backend may return pixels from a few frames back
+	// instead of stalling the pipeline. Only for use where slightly stale data is acceptable,
+	// like downloads the game polls every frame. Synchronous where not implemented.
+	virtual bool CopyFramebufferToMemoryAsync(Framebuffer *src, int channelBits, int x, int y, int w, int h, Draw::DataFormat format, void *pixels, int pixelStride) {
+		return CopyFramebufferToMemorySync(src, channelBits, x, y, w, h, format, pixels, pixelStride);
+	}
 	virtual DataFormat PreferredFramebufferReadbackFormat(Framebuffer *src) {
 		return DataFormat::R8G8B8A8_UNORM;
 	}
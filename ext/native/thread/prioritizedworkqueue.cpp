@@ -20,7 +20,7 @@ void PrioritizedWorkQueue::Add(PrioritizedWorkQueueItem *item) {
 void PrioritizedWorkQueue::Stop() {
 	std::lock_guard<std::mutex> guard(mutex_);
 	done_ = true;
-	notEmpty_.notify_one();
+	notEmpty_.notify_all();
 }
 
 void PrioritizedWorkQueue::Flush() {
@@ -61,19 +61,21 @@ void PrioritizedWorkQueue::NotifyDrain() {
 
 bool PrioritizedWorkQueue::AllItemsDone() {
 	std::lock_guard<std::mutex> guard(mutex_);
-	return queue_.empty() && !working_;
+	return queue_.empty() && numWorking_ == 0;
 }
 
-// The worker should simply call this in a loop. Will block when appropriate.
-PrioritizedWorkQueueItem *PrioritizedWorkQueue::Pop() {
+void PrioritizedWorkQueue::NotifyItemDone() {
 	{
 		std::lock_guard<std::mutex> guard(mutex_);
-		working_ = false;  // The thread only calls Pop if it's done.
+		numWorking_--;
 	}
 
 	// Important: make sure mutex_ is not locked while draining.
 	NotifyDrain();
+}
 
+// The workers should simply call this in a loop. Will block when appropriate.
+PrioritizedWorkQueueItem *PrioritizedWorkQueue::Pop() {
 	std::unique_lock<std::mutex> guard(mutex_);
 	if (done_) {
 		return 0;
@@ -99,7 +101,7 @@ PrioritizedWorkQueueItem *PrioritizedWorkQueue::Pop() {
 	if (best != queue_.end()) {
 		PrioritizedWorkQueueItem *poppedItem = *best;
 		queue_.erase(best);
-		working_ = true;  // This will be worked on.
+		numWorking_++;  // This will be worked on.
 		return poppedItem;
 	} else {
 		// Not really sure how this can happen, but let's be safe.
@@ -109,7 +111,7 @@ PrioritizedWorkQueueItem *PrioritizedWorkQueue::Pop() {
 
 // TODO: This feels ugly. Revisit later.
 
-static std::thread *workThread;
+static std::vector<std::thread> workThreads;
 
 static void threadfunc(PrioritizedWorkQueue *wq) {
 	setCurrentThreadName("PrioQueue");
@@ -121,19 +123,28 @@ static void threadfunc(PrioritizedWorkQueue *wq) {
 		} else {
 			item->run();
 			delete item;
+			wq->NotifyItemDone();
 		}
 	}
 }
 
 void ProcessWorkQueueOnThreadWhile(PrioritizedWorkQueue *wq) {
-	workThread = new std::thread([=](){threadfunc(wq);});
+	// Items are mostly I/O bound, so a few workers hide each other's latency
+	// without saturating the machine.
+	int numThreads = (int)std::thread::hardware_concurrency() / 2;
+	if (numThreads < 1)
+		numThreads = 1;
+	if (numThreads > 4)
+		numThreads = 4;
+	for (int i = 0; i < numThreads; i++) {
+		workThreads.push_back(std::thread([=](){threadfunc(wq);}));
+	}
 }
 
 void StopProcessingWorkQueue(PrioritizedWorkQueue *wq) {
 	wq->Stop();
-	if (workThread) {
-		workThread->join();
-		delete workThread;
+	for (auto &thread : workThreads) {
+		thread.join();
 	}
-	workThread = nullptr;
+	workThreads.clear();
 }
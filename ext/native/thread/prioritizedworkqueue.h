@@ -24,13 +24,15 @@ private:
 
 class PrioritizedWorkQueue {
 public:
-	PrioritizedWorkQueue() : done_(false), working_(false) {}
+	PrioritizedWorkQueue() : done_(false), numWorking_(0) {}
 	~PrioritizedWorkQueue();
 	// Takes ownership.
 	void Add(PrioritizedWorkQueueItem *item);
 
-	// The worker should simply call this in a loop. Will block when appropriate.
+	// The workers should simply call this in a loop. Will block when appropriate.
 	PrioritizedWorkQueueItem *Pop();
+	// Each worker calls this after finishing an item it popped.
+	void NotifyItemDone();
 
 	void Flush();
 	bool Done() { return done_; }
@@ -38,7 +40,7 @@ public:
 	bool WaitUntilDone(bool all = true);
 
 	bool IsWorking() {
-		return working_;
+		return numWorking_ != 0;
 	}
 
 private:
@@ -46,7 +48,8 @@ private:
 	bool AllItemsDone();
 
 	bool done_;
-	bool working_;
+	// How many workers are currently running a popped item.
+	int numWorking_;
 	std::mutex mutex_;
 	std::mutex drainMutex_;
 	std::condition_variable notEmpty_;
@@ -58,7 +61,7 @@ private:
 };
 
 
-// Starts up a thread that keeps trying to run this workqueue.
+// Starts up a few threads that keep trying to run this workqueue.
 // TODO: This feels ugly. Revisit later.
 void ProcessWorkQueueOnThreadWhile(PrioritizedWorkQueue *wq);
 void StopProcessingWorkQueue(PrioritizedWorkQueue *wq);
@@ -1,133 +1,139 @@
+#include <algorithm>
+
 #include "base/logging.h"
 #include "thread/threadpool.h"
 #include "thread/threadutil.h"
-#include "Common/MakeUnique.h"
 
-///////////////////////////// WorkerThread
+ThreadPool::ThreadPool(int numThreads) {
+	if (numThreads <= 0) {
+		numThreads_ = 1;
+		ILOG("ThreadPool: Bad number of threads %i", numThreads);
+	} else if (numThreads > 8) {
+		ILOG("ThreadPool: Capping number of threads to 8 (was %i)", numThreads);
+		numThreads_ = 8;
+	} else {
+		numThreads_ = numThreads;
+	}
+}
 
-WorkerThread::~WorkerThread() {
+ThreadPool::~ThreadPool() {
 	{
-		std::lock_guard<std::mutex> guard(mutex);
-		active = false;
-		signal.notify_one();
+		std::lock_guard<std::mutex> lock(wakeMutex_);
+		active_ = false;
+		wake_.notify_all();
 	}
-	if (thread.joinable()) {
-		thread.join();
+	for (auto &worker : workers_) {
+		worker.join();
 	}
 }
 
-void WorkerThread::StartUp() {
-	thread = std::thread(std::bind(&WorkerThread::WorkFunc, this));
-}
-
-void WorkerThread::Process(std::function<void()> work) {
-	std::lock_guard<std::mutex> guard(mutex);
-	work_ = std::move(work);
-	jobsTarget = jobsDone + 1;
-	signal.notify_one();
-}
-
-void WorkerThread::WaitForCompletion() {
-	std::unique_lock<std::mutex> guard(doneMutex);
-	while (jobsDone < jobsTarget) {
-		done.wait(guard);
+void ThreadPool::StartWorkers() {
+	if (workersStarted_)
+		return;
+	// One less worker thread than cores, since the thread calling ParallelLoop
+	// also does work.
+	workers_.reserve(numThreads_ - 1);
+	for (int i = 0; i < numThreads_ - 1; ++i) {
+		workers_.push_back(std::thread(std::bind(&ThreadPool::WorkerFunc, this)));
 	}
+	workersStarted_ = true;
 }
 
-void WorkerThread::WorkFunc() {
-	setCurrentThreadName("Worker");
-	std::unique_lock<std::mutex> guard(mutex);
-	while (active) {
-		// 'active == false' is one of the conditions for signaling,
-		// do not "optimize" it
-		while (active && jobsTarget <= jobsDone) {
-			signal.wait(guard);
+void ThreadPool::WorkerFunc() {
+	setCurrentThreadName("PoolWorker");
+	while (true) {
+		std::function<void()> task;
+		std::shared_ptr<LoopState> ls;
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex_);
+			while (active_ && tasks_.empty() && (!currentLoop_ || currentLoop_->exhausted)) {
+				wake_.wait(lock);
+			}
+			if (!active_ && tasks_.empty()) {
+				break;
+			}
+			if (!tasks_.empty()) {
+				task = std::move(tasks_.front());
+				tasks_.pop_front();
+			} else {
+				ls = currentLoop_;
+			}
 		}
-		if (active) {
-			work_();
-
-			std::lock_guard<std::mutex> doneGuard(doneMutex);
-			jobsDone++;
-			done.notify_one();
+		if (task) {
+			task();
+		} else if (ls) {
+			RunLoopChunks(*ls);
 		}
 	}
 }
 
-void LoopWorkerThread::Process(std::function<void(int, int)> work, int start, int end) {
-	std::lock_guard<std::mutex> guard(mutex);
-	work_ = std::move(work);
-	start_ = start;
-	end_ = end;
-	jobsTarget = jobsDone + 1;
-	signal.notify_one();
-}
-
-void LoopWorkerThread::WorkFunc() {
-	setCurrentThreadName("LoopWorker");
-	std::unique_lock<std::mutex> guard(mutex);
-	while (active) {
-		// 'active == false' is one of the conditions for signaling,
-		// do not "optimize" it
-		while (active && jobsTarget <= jobsDone) {
-			signal.wait(guard);
+void ThreadPool::RunLoopChunks(LoopState &ls) {
+	while (true) {
+		int start = ls.next.fetch_add(ls.chunkSize);
+		if (start >= ls.upper) {
+			ls.exhausted = true;
+			break;
 		}
-		if (active) {
-			work_(start_, end_);
-
-			std::lock_guard<std::mutex> doneGuard(doneMutex);
-			jobsDone++;
-			done.notify_one();
+		int end = std::min(start + ls.chunkSize, ls.upper);
+		(*ls.loop)(start, end);
+		if (ls.pending.fetch_sub(1) == 1) {
+			// That was the last chunk, wake the submitter.
+			std::lock_guard<std::mutex> lock(doneMutex_);
+			done_.notify_all();
 		}
 	}
 }
 
-///////////////////////////// ThreadPool
-
-ThreadPool::ThreadPool(int numThreads) {
-	if (numThreads <= 0) {
-		numThreads_ = 1;
-		ILOG("ThreadPool: Bad number of threads %i", numThreads);
-	} else if (numThreads > 8) {
-		ILOG("ThreadPool: Capping number of threads to 8 (was %i)", numThreads);
-		numThreads_ = 8;
-	} else {
-		numThreads_ = numThreads;
+void ThreadPool::ParallelLoop(const std::function<void(int, int)> &loop, int lower, int upper) {
+	int range = upper - lower;
+	// Don't parallelize tiny loops, the wakeup costs more than the work.
+	if (range < numThreads_ * 2) {
+		loop(lower, upper);
+		return;
 	}
-}
 
-void ThreadPool::StartWorkers() {
-	if (!workersStarted) {
-		workers.reserve(numThreads_ - 1);
-		for(int i = 0; i < numThreads_ - 1; ++i) { // create one less worker thread as the thread calling ParallelLoop will also do work
-			auto workerPtr = make_unique<LoopWorkerThread>();
-			workerPtr->StartUp();
-			workers.push_back(std::move(workerPtr));
-		}
-		workersStarted = true;
-	}
-}
+	std::lock_guard<std::mutex> guard(loopMutex_);
 
-void ThreadPool::ParallelLoop(const std::function<void(int,int)> &loop, int lower, int upper) {
-	int range = upper - lower;
-	if (range >= numThreads_ * 2) { // don't parallelize tiny loops (this could be better, maybe add optional parameter that estimates work per iteration)
-		std::lock_guard<std::mutex> guard(mutex);
+	auto ls = std::make_shared<LoopState>();
+	ls->loop = &loop;
+	ls->upper = upper;
+	// A few chunks per thread, so threads that finish early take over work
+	// from slow ones, without so many that the atomic traffic dominates.
+	ls->chunkSize = std::max(range / (numThreads_ * 4), 1);
+	int numChunks = (range + ls->chunkSize - 1) / ls->chunkSize;
+	ls->pending.store(numChunks);
+	ls->next.store(lower);
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex_);
 		StartWorkers();
+		currentLoop_ = ls;
+		wake_.notify_all();
+	}
 
-		// could do slightly better load balancing for the generic case, 
-		// but doesn't matter since all our loops are power of 2
-		int chunk = range / numThreads_;
-		int s = lower;
-		for (auto& worker : workers) {
-			worker->Process(loop, s, s+chunk);
-			s+=chunk;
-		}
-		// This is the final chunk.
-		loop(s, upper);
-		for (auto& worker : workers) {
-			worker->WaitForCompletion();
+	// This thread works too.
+	RunLoopChunks(*ls);
+
+	{
+		std::unique_lock<std::mutex> lock(doneMutex_);
+		while (ls->pending.load() != 0) {
+			done_.wait(lock);
 		}
-	} else {
-		loop(lower, upper);
 	}
+
+	std::lock_guard<std::mutex> lock(wakeMutex_);
+	currentLoop_.reset();
 }
 
+void ThreadPool::Enqueue(std::function<void()> task) {
+	std::unique_lock<std::mutex> lock(wakeMutex_);
+	StartWorkers();
+	if (workers_.empty()) {
+		// No one to hand it to.
+		lock.unlock();
+		task();
+		return;
+	}
+	tasks_.push_back(std::move(task));
+	wake_.notify_one();
+}
@@ -1,77 +1,70 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <vector>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
+#include <thread>
+#include <vector>
 
-// This is the simplest possible worker implementation I can think of
-// but entirely sufficient for the given purpose.
-// Only handles a single item of work at a time.
-class WorkerThread {
+// A persistent pool of worker threads.
+//
+// Parallel loops are split into a few chunks per thread, and every thread
+// (including the caller) grabs the next chunk with an atomic increment when
+// it finishes its previous one - so threads that finish early automatically
+// take over work from slow ones, and a loop costs one condvar broadcast
+// instead of a mutex round trip per worker.
+//
+// Standalone tasks can be queued with Enqueue, which returns immediately.
+class ThreadPool {
 public:
-	WorkerThread() = default;
-	virtual ~WorkerThread();
+	ThreadPool(int numThreads);
+	~ThreadPool();
 
-	void StartUp();
+	// Executes slices of [lower, upper) on the pool, blocking until all are done.
+	// Loops are sequentialized against each other, as each is expected to use
+	// the whole machine.
+	void ParallelLoop(const std::function<void(int, int)> &loop, int lower, int upper);
 
-	// submit a new work item
-	void Process(std::function<void()> work);
-	// wait for a submitted work item to be completed
-	void WaitForCompletion();
+	// Queues a task for any worker and returns immediately. Runs the task
+	// inline if the pool has no workers (single core.)
+	void Enqueue(std::function<void()> task);
 
-protected:
-	std::thread thread; // the worker thread
-	std::condition_variable signal; // used to signal new work
-	std::condition_variable done; // used to signal work completion
-	std::mutex mutex, doneMutex; // associated with each respective condition variable
-	bool active = true;
-	int jobsDone = 0;
-	int jobsTarget = 0;
 private:
-	virtual void WorkFunc();
-
-	std::function<void()> work_; // the work to be done by this thread
-
-	WorkerThread(const WorkerThread& other) = delete; // prevent copies
-	void operator =(const WorkerThread &other) = delete;
-};
-
-class LoopWorkerThread final : public WorkerThread {
-public:
-	LoopWorkerThread() = default;
-	void Process(std::function<void(int, int)> work, int start, int end);
+	struct LoopState {
+		const std::function<void(int, int)> *loop;
+		std::atomic<int> next;
+		int upper;
+		int chunkSize;
+		// Chunks not yet completed, for the submitter to wait on.
+		std::atomic<int> pending;
+		// Set once all chunks are handed out, so idle workers stop looking.
+		std::atomic<bool> exhausted{false};
+	};
 
-private:
-	virtual void WorkFunc() override;
+	// Must be called with wakeMutex_ held.
+	void StartWorkers();
+	void WorkerFunc();
+	void RunLoopChunks(LoopState &ls);
 
-	int start_;
-	int end_;
-	std::function<void(int, int)> work_; // the work to be done by this thread
-};
+	int numThreads_;
+	std::vector<std::thread> workers_;
+	bool workersStarted_ = false;
 
-// A thread pool manages a set of worker threads, and allows the execution of parallel loops on them
-// individual parallel loops are fully sequentialized to simplify synchronization, which should not 
-// be a problem as they should each use the entire system
-class ThreadPool {
-public:
-	ThreadPool(int numThreads);
-	// don't need a destructor, "workers" is cleared on delete, 
-	// leading to the stopping and joining of all worker threads (RAII and all that)
+	std::mutex loopMutex_;  // sequentializes ParallelLoop calls
 
-	void ParallelLoop(const std::function<void(int,int)> &loop, int lower, int upper);
+	// Guards the fields below, and pairs with wake_.
+	std::mutex wakeMutex_;
+	std::condition_variable wake_;
+	std::shared_ptr<LoopState> currentLoop_;
+	std::deque<std::function<void()>> tasks_;
+	bool active_ = true;
 
-private:
-	int numThreads_;
-	std::vector<std::unique_ptr<LoopWorkerThread>> workers;
-	std::mutex mutex; // used to sequentialize loop execution
+	std::mutex doneMutex_;
+	std::condition_variable done_;
 
-	bool workersStarted = false;
-	void StartWorkers();
-	
-	ThreadPool(const ThreadPool& other) = delete; // prevent copies
+	ThreadPool(const ThreadPool &other) = delete;
 	void operator =(const ThreadPool &other) = delete;
 };
-
@@ -16,6 +16,13 @@
 #include <pthread.h>
 #endif
 
+#if defined(__ANDROID__) || defined(__linux__)
+#include <sched.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
 #ifdef TLS_SUPPORTED
 static __THREAD const char *curThreadName;
 #endif
@@ -119,3 +126,101 @@ void AssertCurrentThreadName(const char *threadName) {
 	}
 #endif
 }
+
+#if defined(__ANDROID__) || defined(__linux__)
+
+// Core topology, detected once from the per-core max frequencies.
+// On uniform machines fast == slow == all cores.
+struct CoreMasks {
+	uint64_t fast = 0;
+	uint64_t slow = 0;
+
+	CoreMasks() {
+		int cpus = (int)sysconf(_SC_NPROCESSORS_CONF);
+		if (cpus > 64)
+			cpus = 64;
+		long freq[64]{};
+		long maxFreq = 0;
+		for (int i = 0; i < cpus; i++) {
+			char path[256];
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", i);
+			FILE *f = fopen(path, "r");
+			if (f) {
+				if (fscanf(f, "%ld", &freq[i]) != 1)
+					freq[i] = 0;
+				fclose(f);
+			}
+			if (freq[i] > maxFreq)
+				maxFreq = freq[i];
+		}
+		for (int i = 0; i < cpus; i++) {
+			// Cores we couldn't read count as fast, to not pin anything away
+			// from them by mistake.
+			if (freq[i] == maxFreq || freq[i] == 0)
+				fast |= 1ULL << i;
+			else
+				slow |= 1ULL << i;
+		}
+		if (!slow)
+			slow = fast;
+		if (fast != slow)
+			ILOG("Heterogeneous cores detected: fast mask %08x%08x, slow mask %08x%08x",
+				(uint32_t)(fast >> 32), (uint32_t)fast, (uint32_t)(slow >> 32), (uint32_t)slow);
+	}
+};
+
+static const CoreMasks &GetCoreMasks() {
+	static CoreMasks masks;
+	return masks;
+}
+
+static void ApplyAffinityMask(uint64_t mask) {
+	if (!mask)
+		return;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int i = 0; i < 64; i++) {
+		if (mask & (1ULL << i))
+			CPU_SET(i, &set);
+	}
+	// 0 = the calling thread.
+	sched_setaffinity(0, sizeof(set), &set);
+}
+
+#endif
+
+void setCurrentThreadRole(ThreadRole role) {
+#if defined(__ANDROID__) || defined(__linux__)
+	const CoreMasks &masks = GetCoreMasks();
+	switch (role) {
+	case ThreadRole::EMULATION:
+	case ThreadRole::RENDER:
+		if (masks.fast != masks.slow)
+			ApplyAffinityMask(masks.fast);
+		break;
+	case ThreadRole::IO:
+		if (masks.fast != masks.slow)
+			ApplyAffinityMask(masks.slow);
+		break;
+	case ThreadRole::AUDIO:
+#if defined(__ANDROID__)
+		// Run anywhere, but ahead of bulk work. Android allows raising
+		// a thread's own priority without privileges.
+		setpriority(PRIO_PROCESS, gettid(), -16);
+#endif
+		break;
+	}
+#elif defined(_WIN32)
+	switch (role) {
+	case ThreadRole::AUDIO:
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+		break;
+	case ThreadRole::IO:
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+		break;
+	default:
+		// Windows schedules the heavy threads fine by itself.
+		break;
+	}
+#endif
+}
@@ -3,4 +3,18 @@
 // Note that name must be a global string that lives until the end of the process,
 // for assertThreadName to work.
 void setCurrentThreadName(const char *threadName);
-void AssertCurrentThreadName(const char *threadName);
\ No newline at end of file
+void AssertCurrentThreadName(const char *threadName);
+
+// Rough role-based thread placement. On heterogeneous (big.LITTLE) CPUs the
+// scheduler migrates threads freely between fast and slow cores, costing
+// cache state - so pin latency-critical threads to the fast cores and let
+// background I/O keep to the slow ones. Does nothing on platforms without
+// an affinity API, and applies no pinning on uniform-core machines.
+enum class ThreadRole {
+	EMULATION,  // CPU/HLE emulation - fast cores.
+	RENDER,     // GPU command submission - fast cores.
+	AUDIO,      // Latency critical but light - priority bump, no pinning.
+	IO,         // Background reads and decompression - slow cores are fine.
+};
+
+void setCurrentThreadRole(ThreadRole role);
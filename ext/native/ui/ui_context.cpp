@@ -35,12 +35,16 @@ void UIContext::Init(Draw::DrawContext *thin3d, Draw::Pipeline *uipipe, Draw::Pi
 
 void UIContext::BeginFrame() {
 	if (!uitexture_) {
-		uitexture_ = CreateTextureFromFile(draw_, "ui_atlas.zim", ImageFileType::ZIM, false);
+		// Generate mips so the atlas stays sharp when UI elements are drawn
+		// scaled down - the sampler already uses trilinear filtering.
+		uitexture_ = CreateTextureFromFile(draw_, "ui_atlas.zim", ImageFileType::ZIM, true);
 		if (!uitexture_) {
 			PanicAlert("Failed to load ui_atlas.zim.\n\nPlace it in the directory \"assets\" under your PPSSPP directory.");
 			FLOG("Failed to load ui_atlas.zim");
 		}
 	}
+	uidrawbufferTop_->BeginFrame();
+	uidrawbuffer_->BeginFrame();
 	uidrawbufferTop_->SetCurZ(0.0f);
 	uidrawbuffer_->SetCurZ(0.0f);
 	ActivateTopScissor();
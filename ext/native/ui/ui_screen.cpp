@@ -860,6 +860,20 @@ void ChoiceWithValueDisplay::Draw(UIContext &dc) {
 	int paddingX = 12;
 	dc.SetFontStyle(dc.theme->uiFont);
 
+	// Only resolve the translation when the value changes - we draw every frame.
+	if (!valueResolved_ || (sValue_ && *sValue_ != lastSValue_) || (iValue_ && *iValue_ != lastIValue_)) {
+		UpdateValueText();
+	}
+
+	float ignore;
+	dc.MeasureText(dc.theme->uiFont, 1.0f, 1.0f, valueText_.c_str(), &textPadding_.right, &ignore, ALIGN_RIGHT | ALIGN_VCENTER);
+	textPadding_.right += paddingX;
+
+	Choice::Draw(dc);
+	dc.DrawText(valueText_.c_str(), bounds_.x2() - paddingX, bounds_.centerY(), style.fgColor, ALIGN_RIGHT | ALIGN_VCENTER);
+}
+
+void ChoiceWithValueDisplay::UpdateValueText() {
 	I18NCategory *category = GetI18NCategory(category_);
 	std::ostringstream valueText;
 	if (translateCallback_ && sValue_) {
@@ -872,13 +886,13 @@ void ChoiceWithValueDisplay::Draw(UIContext &dc) {
 	} else if (iValue_ != nullptr) {
 		valueText << *iValue_;
 	}
+	valueText_ = valueText.str();
 
-	float ignore;
-	dc.MeasureText(dc.theme->uiFont, 1.0f, 1.0f, valueText.str().c_str(), &textPadding_.right, &ignore, ALIGN_RIGHT | ALIGN_VCENTER);
-	textPadding_.right += paddingX;
-
-	Choice::Draw(dc);
-	dc.DrawText(valueText.str().c_str(), bounds_.x2() - paddingX, bounds_.centerY(), style.fgColor, ALIGN_RIGHT | ALIGN_VCENTER);
+	if (sValue_)
+		lastSValue_ = *sValue_;
+	if (iValue_)
+		lastIValue_ = *iValue_;
+	valueResolved_ = true;
 }
 
 }  // namespace UI
@@ -418,10 +418,18 @@ public:
 	virtual void Draw(UIContext &dc) override;
 
 private:
+	void UpdateValueText();
+
 	int *iValue_ = nullptr;
 	std::string *sValue_ = nullptr;
 	const char *category_ = nullptr;
 	std::string (*translateCallback_)(const char *value) = nullptr;
+
+	// Translated value, cached so drawing doesn't hit the i18n maps every frame.
+	std::string valueText_;
+	std::string lastSValue_;
+	int lastIValue_ = 0;
+	bool valueResolved_ = false;
 };
 
 }  // namespace UI
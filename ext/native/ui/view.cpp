@@ -23,6 +23,17 @@ static bool focusMovementEnabled;
 bool focusForced;
 static std::mutex eventMutex_;  // needs recursivity!
 
+// Starts at 1 so that roots with a zero-initialized stamp always lay out once.
+static uint32_t layoutGeneration = 1;
+
+void RequestLayout() {
+	layoutGeneration++;
+}
+
+uint32_t LayoutGeneration() {
+	return layoutGeneration;
+}
+
 const float ITEM_HEIGHT = 64.f;
 const float MIN_TEXT_SCALE = 0.8f;
 const float MAX_ITEM_SIZE = 65535.0f;
@@ -1091,6 +1102,7 @@ bool TextEdit::Key(const KeyInput &input) {
 	}
 
 	if (textChanged) {
+		RequestLayout();
 		UI::EventParams e{};
 		e.v = this;
 		OnTextChange.Trigger(e);
@@ -1104,6 +1116,7 @@ void TextEdit::InsertAtCaret(const char *text) {
 		text_.insert(text_.begin() + caret_, text[i]);
 		caret_++;
 	}
+	RequestLayout();
 }
 
 void ProgressBar::GetContentDimensions(const UIContext &dc, float &w, float &h) const {
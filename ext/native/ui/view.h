@@ -50,6 +50,15 @@ bool IsFocusMovementEnabled();
 View *GetFocusedView();
 void SetFocusedView(View *view, bool force = false);
 
+// Marks all view hierarchies dirty, so that the next LayoutViewHierarchy()
+// actually re-measures and re-lays-out instead of reusing the cached layout.
+// Call after any change that can affect view sizes or positions: text,
+// visibility, children, scroll position, layout params. The common mutators
+// below all do this themselves.
+void RequestLayout();
+// The current layout generation, bumped by RequestLayout().
+uint32_t LayoutGeneration();
+
 enum DrawableType {
 	DRAW_NOTHING,
 	DRAW_SOLID_COLOR,
@@ -393,7 +402,7 @@ public:
 	// Called when the layout is done.
 	void SetBounds(Bounds bounds) { bounds_ = bounds; }
 	virtual const LayoutParams *GetLayoutParams() const { return layoutParams_.get(); }
-	virtual void ReplaceLayoutParams(LayoutParams *newLayoutParams) { layoutParams_.reset(newLayoutParams); }
+	virtual void ReplaceLayoutParams(LayoutParams *newLayoutParams) { layoutParams_.reset(newLayoutParams); RequestLayout(); }
 	const Bounds &GetBounds() const { return bounds_; }
 
 	virtual bool SetFocus();
@@ -415,7 +424,12 @@ public:
 	void SetEnabledPtr(bool *enabled) { enabledPtr_ = enabled; enabledMeansDisabled_ = false; }
 	void SetDisabledPtr(bool *disabled) { enabledPtr_ = disabled; enabledMeansDisabled_ = true;  }
 
-	virtual void SetVisibility(Visibility visibility) { visibility_ = visibility; }
+	virtual void SetVisibility(Visibility visibility) {
+		if (visibility_ != visibility) {
+			visibility_ = visibility;
+			RequestLayout();
+		}
+	}
 	Visibility GetVisibility() const { return visibility_; }
 
 	const std::string &Tag() const { return tag_; }
@@ -690,6 +704,7 @@ public:
 
 	void SetText(const std::string &text) {
 		text_ = text;
+		RequestLayout();
 	}
 	const std::string &GetText() const {
 		return text_;
@@ -791,9 +806,9 @@ public:
 	void GetContentDimensionsBySpec(const UIContext &dc, MeasureSpec horiz, MeasureSpec vert, float &w, float &h) const override;
 	void Draw(UIContext &dc) override;
 
-	void SetText(const std::string &text) { text_ = text; }
+	void SetText(const std::string &text) { text_ = text; RequestLayout(); }
 	const std::string &GetText() const { return text_; }
-	void SetSmall(bool small) { small_ = small; }
+	void SetSmall(bool small) { small_ = small; RequestLayout(); }
 	void SetTextColor(uint32_t color) { textColor_ = color; hasTextColor_ = true; }
 	void SetShadow(bool shadow) { shadow_ = shadow; }
 	void SetFocusable(bool focusable) { focusable_ = focusable; }
@@ -815,7 +830,7 @@ private:
 class TextEdit : public View {
 public:
 	TextEdit(const std::string &text, const std::string &placeholderText, LayoutParams *layoutParams = 0);
-	void SetText(const std::string &text) { text_ = text; scrollPos_ = 0; caret_ = (int)text_.size(); }
+	void SetText(const std::string &text) { text_ = text; scrollPos_ = 0; caret_ = (int)text_.size(); RequestLayout(); }
 	void SetTextColor(uint32_t color) { textColor_ = color; hasTextColor_ = true; }
 	const std::string &GetText() const { return text_; }
 	void SetMaxLen(size_t maxLen) { maxLen_ = maxLen; }
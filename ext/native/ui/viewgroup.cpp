@@ -51,6 +51,7 @@ void ViewGroup::RemoveSubview(View *view) {
 		if (views_[i] == view) {
 			views_.erase(views_.begin() + i);
 			delete view;
+			RequestLayout();
 			return;
 		}
 	}
@@ -63,6 +64,7 @@ void ViewGroup::Clear() {
 		views_[i] = nullptr;
 	}
 	views_.clear();
+	RequestLayout();
 }
 
 void ViewGroup::PersistData(PersistStatus status, std::string anonId, PersistMap &storage) {
@@ -776,6 +778,8 @@ void ScrollView::Touch(const TouchInput &input) {
 			scrollPos_ = pos;
 			scrollTarget_ = pos;
 			scrollToTarget_ = false;
+			// Don't wait until the next Update() to apply the drag.
+			RequestLayout();
 		}
 	} else {
 		input2 = input;
@@ -983,6 +987,14 @@ void ScrollView::Update() {
 			pull_ = 0.0f;
 		}
 	}
+
+	// Layout is what actually applies scrollPos_ to the child, so whenever it
+	// moved this frame - drag, inertia, animation, restore - request one.
+	// This catches every write to scrollPos_, at worst one frame late.
+	if (scrollPos_ != lastScrollPosToLayout_) {
+		lastScrollPosToLayout_ = scrollPos_;
+		RequestLayout();
+	}
 }
 
 void AnchorLayout::Measure(const UIContext &dc, MeasureSpec horiz, MeasureSpec vert) {
@@ -1428,6 +1440,15 @@ void LayoutViewHierarchy(const UIContext &dc, ViewGroup *root) {
 	}
 	const Bounds &rootBounds = dc.GetBounds();
 
+	// If nothing has changed since this root was last laid out - no view was
+	// dirtied (RequestLayout) and the available space is the same - the cached
+	// bounds in the views are still valid, and we can skip the whole pass.
+	if (root->lastLayoutGeneration_ == LayoutGeneration() &&
+		root->lastLayoutBounds_.x == rootBounds.x && root->lastLayoutBounds_.y == rootBounds.y &&
+		root->lastLayoutBounds_.w == rootBounds.w && root->lastLayoutBounds_.h == rootBounds.h) {
+		return;
+	}
+
 	MeasureSpec horiz(EXACTLY, rootBounds.w);
 	MeasureSpec vert(EXACTLY, rootBounds.h);
 
@@ -1436,6 +1457,9 @@ void LayoutViewHierarchy(const UIContext &dc, ViewGroup *root) {
 	// Root has a specified size. Set it, then let root layout all its children.
 	root->SetBounds(rootBounds);
 	root->Layout();
+
+	root->lastLayoutGeneration_ = LayoutGeneration();
+	root->lastLayoutBounds_ = rootBounds;
 }
 
 // TODO: Figure out where this should really live.
@@ -52,6 +52,7 @@ public:
 	T *Add(T *view) {
 		std::lock_guard<std::mutex> guard(modifyLock_);
 		views_.push_back(view);
+		RequestLayout();
 		return view;
 	}
 
@@ -91,6 +92,14 @@ protected:
 	float dropShadowExpand_ = 0.0f;
 	bool hasDropShadow_ = false;
 	bool clip_ = false;
+
+private:
+	// Layout cache state, only used when this group is the root of a hierarchy.
+	// Lets LayoutViewHierarchy skip clean measure/layout passes entirely.
+	uint32_t lastLayoutGeneration_ = 0;
+	Bounds lastLayoutBounds_;
+
+	friend void LayoutViewHierarchy(const UIContext &dc, ViewGroup *root);
 };
 
 // A frame layout contains a single child view (normally).
@@ -265,6 +274,9 @@ private:
 	float inertia_ = 0.0f;
 	float pull_ = 0.0f;
 	float lastViewSize_ = 0.0f;
+	// The scroll position Update() last requested a layout for - Layout() is
+	// what actually applies scrollPos_ to the child.
+	float lastScrollPosToLayout_ = 0.0f;
 	bool scrollToTopOnSizeChange_ = false;
 };
 
@@ -20,6 +20,7 @@ public:
 	static const uint32_t INVALID = (uint32_t)-1;
 
 	UTF16_Type(const uint16_t *c) : c_(c), index_(0) {}
+	UTF16_Type(const uint16_t *c, int index) : c_(c), index_(index) {}
 
 	uint32_t next() {
 		const uint32_t u = UTF16_Swap<is_little>(c_[index_++]);
@@ -2,11 +2,14 @@
 // See headless.txt.
 // To build on non-windows systems, just run CMake in the SDL directory, it will build both a normal ppsspp and the headless version.
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <limits>
+#include <vector>
 
 #include "file/zip_read.h"
+#include "json/json_writer.h"
 #include "profiler/profiler.h"
 #include "Common/FileUtil.h"
 #include "Common/GraphicsContext.h"
@@ -14,11 +17,13 @@
 #include "Core/ConfigValues.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/Replay.h"
 #include "Core/System.h"
 #include "Core/HLE/sceUtility.h"
 #include "Core/Host.h"
 #include "Core/SaveState.h"
 #include "GPU/Common/FramebufferCommon.h"
+#include "GPU/Debugger/Playback.h"
 #include "Log.h"
 #include "LogManager.h"
 #include "base/NativeApp.h"
@@ -108,6 +113,12 @@ int printUsage(const char *progname, const char *reason)
 	fprintf(stderr, "  --ir                  use ir interpreter\n");
 	fprintf(stderr, "  -j                    use jit (default)\n");
 	fprintf(stderr, "  -c, --compare         compare with output in file.expected\n");
+	fprintf(stderr, "  --bench=FRAMES        run as a benchmark for FRAMES frames and print\n");
+	fprintf(stderr, "                        timing statistics as JSON (works well with GE\n");
+	fprintf(stderr, "                        dumps recorded by the GPU debugger)\n");
+	fprintf(stderr, "  --replay=FILE         replay recorded input from FILE after boot\n");
+	fprintf(stderr, "  --dump-frame=N        for GE dumps, seek to frame N and loop just that\n");
+	fprintf(stderr, "                        frame (earlier frames are fast-forwarded)\n");
 	fprintf(stderr, "\nSee headless.txt for details.\n");
 
 	return 1;
@@ -205,6 +216,132 @@ bool RunAutoTest(HeadlessHost *headlessHost, CoreParameter &coreParameter, bool
 	return passed;
 }
 
+static double Percentile(const std::vector<double> &sorted, int pct) {
+	if (sorted.empty())
+		return 0.0;
+	size_t i = sorted.size() * pct / 100;
+	if (i >= sorted.size())
+		i = sorted.size() - 1;
+	return sorted[i];
+}
+
+// Runs the workload (a GE dump, or any bootable plus an optional input
+// replay) for a fixed number of frames and prints timing statistics as JSON
+// on stdout, for performance regression tracking in CI. The workload is
+// deterministic, the host machine of course is not - compare percentiles,
+// not single runs.
+bool RunBenchmark(HeadlessHost *headlessHost, CoreParameter &coreParameter, const char *replayFilename, int numFrames, double timeout)
+{
+	std::string error_string;
+	if (!PSP_Init(coreParameter, &error_string)) {
+		fprintf(stderr, "Failed to start %s. Error: %s\n", coreParameter.fileToStart.c_str(), error_string.c_str());
+		return false;
+	}
+
+	host->BootDone();
+
+	if (replayFilename && !ReplayExecuteFile(replayFilename)) {
+		fprintf(stderr, "Failed to load replay file %s\n", replayFilename);
+		PSP_Shutdown();
+		return false;
+	}
+
+	time_update();
+	static double deadline;
+	deadline = time_now() + timeout;
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(numFrames);
+#ifdef USE_PROFILER
+	std::vector<double> categoryTotals;
+	std::vector<float> profileBuf;
+#endif
+
+	PSP_BeginHostFrame();
+	if (coreParameter.thin3d)
+		coreParameter.thin3d->BeginFrame();
+
+	coreState = CORE_RUNNING;
+	bool timedOut = false;
+	double frameStart = time_now_d();
+	while (coreState == CORE_RUNNING && (int)frameTimes.size() < numFrames)
+	{
+		int blockTicks = usToCycles(1000000 / 10);
+		PSP_RunLoopFor(blockTicks);
+
+		if (coreState == CORE_NEXTFRAME) {
+			coreState = CORE_RUNNING;
+			headlessHost->SwapBuffers();
+			time_update();
+			double now = time_now_d();
+			frameTimes.push_back(now - frameStart);
+			frameStart = now;
+
+#ifdef USE_PROFILER
+			// Sum up what each profiler category ate this frame, before the
+			// end-of-frame tick moves the history along.
+			int historyLength = Profiler_GetHistoryLength();
+			profileBuf.resize(historyLength);
+			categoryTotals.resize(Profiler_GetNumCategories(), 0.0);
+			for (int c = 0; c < (int)categoryTotals.size(); c++) {
+				for (int t = 0; t < Profiler_GetNumThreads(); t++) {
+					Profiler_GetHistory(c, t, &profileBuf[0], historyLength);
+					categoryTotals[c] += profileBuf[historyLength - 1];
+				}
+			}
+			PROFILE_END_FRAME();
+#endif
+		}
+		time_update();
+		if (time_now_d() > deadline) {
+			timedOut = true;
+			fprintf(stderr, "Benchmark timed out after %d frames.\n", (int)frameTimes.size());
+			Core_Stop();
+		}
+	}
+	PSP_EndHostFrame();
+
+	if (coreParameter.thin3d)
+		coreParameter.thin3d->EndFrame();
+
+	PSP_Shutdown();
+
+	headlessHost->FlushDebugOutput();
+
+	double totalTime = 0.0;
+	for (size_t i = 0; i < frameTimes.size(); ++i)
+		totalTime += frameTimes[i];
+	std::vector<double> sorted = frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+
+	json::JsonWriter json(json::JsonWriter::PRETTY);
+	json.begin();
+	json.writeString("file", coreParameter.fileToStart);
+	json.writeInt("frames", (int)frameTimes.size());
+	json.writeBool("timeout", timedOut);
+	json.writeFloat("seconds", totalTime);
+	json.writeFloat("fps", totalTime > 0.0 ? frameTimes.size() / totalTime : 0.0);
+	json.pushDict("frame_ms");
+	json.writeFloat("avg", frameTimes.empty() ? 0.0 : totalTime * 1000.0 / frameTimes.size());
+	json.writeFloat("p50", Percentile(sorted, 50) * 1000.0);
+	json.writeFloat("p95", Percentile(sorted, 95) * 1000.0);
+	json.writeFloat("p99", Percentile(sorted, 99) * 1000.0);
+	json.writeFloat("max", sorted.empty() ? 0.0 : sorted.back() * 1000.0);
+	json.pop();
+#ifdef USE_PROFILER
+	json.pushDict("category_ms");
+	for (int c = 0; c < (int)categoryTotals.size(); c++) {
+		if (categoryTotals[c] > 0.0)
+			json.writeFloat(Profiler_GetCategoryName(c), categoryTotals[c] * 1000.0);
+	}
+	json.pop();
+#endif
+	json.end();
+	printf("%s\n", json.str().c_str());
+
+	return !timedOut && (int)frameTimes.size() == numFrames;
+}
+
 int main(int argc, const char* argv[])
 {
 	PROFILE_INIT();
@@ -223,6 +360,8 @@ int main(int argc, const char* argv[])
 	bool autoCompare = false;
 	bool verbose = false;
 	const char *stateToLoad = 0;
+	const char *replayFilename = 0;
+	int benchFrames = 0;
 	GPUCore gpuCore = GPUCORE_NULL;
 	CPUCore cpuCore = CPUCore::JIT;
 	
@@ -291,6 +430,14 @@ int main(int argc, const char* argv[])
 			teamCityMode = true;
 		else if (!strncmp(argv[i], "--state=", strlen("--state=")) && strlen(argv[i]) > strlen("--state="))
 			stateToLoad = argv[i] + strlen("--state=");
+		else if (!strncmp(argv[i], "--bench=", strlen("--bench=")) && strlen(argv[i]) > strlen("--bench="))
+			benchFrames = atoi(argv[i] + strlen("--bench="));
+		else if (!strncmp(argv[i], "--replay=", strlen("--replay=")) && strlen(argv[i]) > strlen("--replay="))
+			replayFilename = argv[i] + strlen("--replay=");
+		else if (!strncmp(argv[i], "--dump-frame=", strlen("--dump-frame=")) && strlen(argv[i]) > strlen("--dump-frame=")) {
+			int frame = atoi(argv[i] + strlen("--dump-frame="));
+			GPURecord::SetFrameRange(frame, frame);
+		}
 		else if (!strcmp(argv[i], "--help") || !strcmp(argv[i], "-h"))
 			return printUsage(argv[0], NULL);
 		else
@@ -420,7 +567,9 @@ int main(int argc, const char* argv[])
 		coreParameter.fileToStart = testFilenames[i];
 		if (autoCompare)
 			printf("%s:\n", coreParameter.fileToStart.c_str());
-		bool passed = RunAutoTest(headlessHost, coreParameter, autoCompare, verbose, timeout);
+		bool passed = benchFrames > 0
+			? RunBenchmark(headlessHost, coreParameter, replayFilename, benchFrames, timeout)
+			: RunAutoTest(headlessHost, coreParameter, autoCompare, verbose, timeout);
 		if (autoCompare)
 		{
 			std::string testName = GetTestName(coreParameter.fileToStart);
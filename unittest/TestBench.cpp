@@ -0,0 +1,291 @@
+// Copyright (c) 2018- PPSSPP Project.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, version 2.0 or later versions.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License 2.0 for more details.
+
+// A copy of the GPL 2.0 should have been included with the program.
+// If not, see http://www.gnu.org/licenses/
+
+// Official git repository and contact information can be found at
+// https://github.com/hrydgard/ppsspp and http://www.ppsspp.org/.
+
+// Microbenchmarks for the hand-optimized kernels: texture hashing and
+// unswizzling, color conversion, index generation, vertex decoding and the
+// Sas mixer. Run with "unitTest bench [filter]". Output is CSV on stdout,
+// with the CPU's feature set in a comment line, so results from different
+// devices and builds diff directly. Timing is wall clock (best round wins) -
+// raw cycle counters aren't readable from user mode on most of the ARM
+// devices we care about.
+
+#include <cstdio>
+#include <cstring>
+
+#include "base/timeutil.h"
+#include "Common/ColorConv.h"
+#include "Common/CPUDetect.h"
+#include "Core/Config.h"
+#include "Core/ConfigValues.h"
+#include "Core/Core.h"
+#include "Core/MemMap.h"
+#include "Core/HLE/sceKernelMemory.h"
+#include "Core/HW/SasAudio.h"
+#include "Core/MIPS/MIPS.h"
+#include "GPU/Common/IndexGenerator.h"
+#include "GPU/Common/TextureDecoder.h"
+#include "GPU/Common/VertexDecoderCommon.h"
+#include "GPU/ge_constants.h"
+#include "GPU/GPUState.h"
+#include "unittest/UnitTest.h"
+
+static const char *benchFilter;
+
+// Repeats rounds of `iters` calls for at least minTime and returns seconds
+// per call of the fastest round, to shake off scheduler noise.
+template <typename F>
+static double TimePerCall(F f, int iters, double minTime = 0.25) {
+	double best = 1e9;
+	f();  // Warmup, page in the buffers.
+	double start = real_time_now();
+	do {
+		double roundStart = real_time_now();
+		for (int i = 0; i < iters; i++) {
+			f();
+		}
+		double round = (real_time_now() - roundStart) / iters;
+		if (round < best)
+			best = round;
+	} while (real_time_now() - start < minTime);
+	return best;
+}
+
+static bool WantBench(const char *kernel) {
+	return !benchFilter || strstr(kernel, benchFilter) != nullptr;
+}
+
+static void ReportRow(const char *kernel, const char *variant, double secsPerCall, double bytesPerCall) {
+	printf("%s,%s,%d,%0.1f,%0.1f\n", kernel, variant, (int)bytesPerCall,
+		secsPerCall * 1e9, bytesPerCall / secsPerCall / (1024.0 * 1024.0));
+}
+
+static void BenchTexHash() {
+	if (!WantBench("texhash"))
+		return;
+	SetupTextureDecoder();
+
+	static const u32 sizes[] = { 512, 8192, 131072 };
+	alignas(16) static u8 buf[131072];
+	for (size_t i = 0; i < sizeof(buf); i++)
+		buf[i] = (u8)(i * 31);
+
+	for (u32 size : sizes) {
+		double t = TimePerCall([&] {
+			DoQuickTexHash(buf, size);
+		}, 1024 * 1024 / size);
+		ReportRow("texhash", "quick", t, size);
+	}
+}
+
+static void BenchUnswizzle() {
+	if (!WantBench("unswizzle"))
+		return;
+	SetupTextureDecoder();
+
+	// A 512x272 16bpp buffer, like a framebuffer-sized texture.
+	static const int pitch = 512 * 2;
+	static const int height = 272;
+	alignas(16) static u8 src[pitch * height];
+	alignas(16) static u8 dst[pitch * height];
+	for (size_t i = 0; i < sizeof(src); i++)
+		src[i] = (u8)i;
+
+	double t = TimePerCall([&] {
+		DoUnswizzleTex16(src, (u32 *)dst, pitch / 16, height / 8, pitch);
+	}, 64);
+	ReportRow("unswizzle16", "default", t, pitch * height);
+}
+
+static void BenchColorConv() {
+	if (!WantBench("colorconv"))
+		return;
+	SetupColorConv();
+
+	static const u32 numPixels = 512 * 272;
+	alignas(16) static u16 buf16[numPixels];
+	alignas(16) static u32 buf32[numPixels];
+	alignas(16) static u16 out16[numPixels];
+	alignas(16) static u32 out32[numPixels];
+	for (u32 i = 0; i < numPixels; i++) {
+		buf16[i] = (u16)(i * 53);
+		buf32[i] = i * 2654435761u;
+	}
+
+	double t = TimePerCall([&] {
+		ConvertRGBA4444ToABGR4444(out16, buf16, numPixels);
+	}, 64);
+	ReportRow("colorconv_4444_abgr4444", "default", t, numPixels * 2);
+
+	t = TimePerCall([&] {
+		ConvertRGBA4444ToRGBA8888(out32, buf16, numPixels);
+	}, 64);
+	ReportRow("colorconv_4444_8888", "default", t, numPixels * 2);
+
+	t = TimePerCall([&] {
+		ConvertRGBA8888ToRGB565(out16, buf32, numPixels);
+	}, 64);
+	ReportRow("colorconv_8888_565", "default", t, numPixels * 4);
+
+	t = TimePerCall([&] {
+		ConvertRGBA565ToRGBA8888(out32, buf16, numPixels);
+	}, 64);
+	ReportRow("colorconv_565_8888", "default", t, numPixels * 2);
+}
+
+static void BenchIndexGenerator() {
+	if (!WantBench("indexgen"))
+		return;
+
+	static const int numInds = 2048;
+	static u16 indsOut[numInds * 4];
+	static u8 inds8[numInds];
+	static u16_le inds16[numInds];
+	for (int i = 0; i < numInds; i++) {
+		inds8[i] = (u8)i;
+		inds16[i] = (u16)i;
+	}
+
+	IndexGenerator gen;
+	gen.Setup(indsOut);
+
+	double t = TimePerCall([&] {
+		gen.Reset();
+		gen.AddPrim(GE_PRIM_TRIANGLES, numInds);
+	}, 256);
+	ReportRow("indexgen_tris", "direct", t, numInds * 2);
+
+	t = TimePerCall([&] {
+		gen.Reset();
+		gen.TranslatePrim(GE_PRIM_TRIANGLES, numInds, inds8, 0, true);
+	}, 256);
+	ReportRow("indexgen_tris", "u8", t, numInds * 2);
+
+	t = TimePerCall([&] {
+		gen.Reset();
+		gen.TranslatePrim(GE_PRIM_TRIANGLES, numInds, inds16, 0, true);
+	}, 256);
+	ReportRow("indexgen_tris", "u16", t, numInds * 2);
+
+	t = TimePerCall([&] {
+		gen.Reset();
+		gen.TranslatePrim(GE_PRIM_TRIANGLE_STRIP, numInds, inds16, 0, true);
+	}, 256);
+	ReportRow("indexgen_strip", "u16", t, numInds * 2);
+}
+
+static void BenchVertexDecoder() {
+	if (!WantBench("vertexdec"))
+		return;
+
+	struct Format {
+		const char *name;
+		u32 vtype;
+	};
+	static const Format formats[] = {
+		{ "through_u16", GE_VTYPE_THROUGH | GE_VTYPE_TC_16BIT | GE_VTYPE_COL_8888 | GE_VTYPE_POS_16BIT },
+		{ "float_all", GE_VTYPE_TC_FLOAT | GE_VTYPE_NRM_FLOAT | GE_VTYPE_POS_FLOAT },
+		{ "compact_s8", GE_VTYPE_TC_8BIT | GE_VTYPE_NRM_8BIT | GE_VTYPE_POS_8BIT },
+		{ "col565_s16", GE_VTYPE_COL_565 | GE_VTYPE_POS_16BIT },
+		{ "skin4_s16", GE_VTYPE_WEIGHT_16BIT | (3 << GE_VTYPE_WEIGHTCOUNT_SHIFT) | GE_VTYPE_NRM_16BIT | GE_VTYPE_POS_16BIT },
+	};
+
+	static const int numVerts = 1024;
+	alignas(16) static u8 src[numVerts * 64];
+	alignas(16) static u8 dst[numVerts * 64];
+	memset(src, 0x3f, sizeof(src));
+
+	g_Config.iCpuCore = (int)CPUCore::JIT;
+	gstate_c.uv.uScale = 1.0f;
+	gstate_c.uv.vScale = 1.0f;
+	VertexDecoderJitCache *cache = new VertexDecoderJitCache();
+	VertexDecoderOptions options{};
+
+	for (const Format &fmt : formats) {
+		// Once with the jit and once with the C++ fallback, to keep both honest.
+		for (int jit = 1; jit >= 0; jit--) {
+			g_Config.bVertexDecoderJit = jit != 0;
+			VertexDecoder dec;
+			dec.SetVertexType(fmt.vtype, options, jit ? cache : nullptr);
+			double t = TimePerCall([&] {
+				dec.DecodeVerts(dst, src, 0, numVerts - 1);
+			}, 64);
+			ReportRow(fmt.name, jit ? "jit" : "cpp", t, numVerts * dec.VertexSize());
+		}
+	}
+	g_Config.bVertexDecoderJit = true;
+	delete cache;
+}
+
+static void BenchSasMix() {
+	if (!WantBench("sasmix"))
+		return;
+
+	// Sas reads voice data from and mixes into emulated RAM.
+	coreState = CORE_POWERUP;
+	currentMIPS = &mipsr4k;
+	Memory::g_MemorySize = Memory::RAM_NORMAL_SIZE;
+	Memory::Init();
+
+	static const int grainSize = 512;
+	static const int pcmSamples = 4096;
+	const u32 pcmAddr = PSP_GetUserMemoryBase();
+	const u32 outAddr = pcmAddr + 0x10000;
+	s16 *pcm = (s16 *)Memory::GetPointer(pcmAddr);
+	for (int i = 0; i < pcmSamples; i++)
+		pcm[i] = (s16)(i * 331);
+
+	SasInstance *sas = new SasInstance();
+	sas->SetGrainSize(grainSize);
+	for (int v = 0; v < 16; v++) {
+		SasVoice &voice = sas->voices[v];
+		voice.type = VOICETYPE_PCM;
+		voice.pcmAddr = pcmAddr;
+		voice.pcmSize = pcmSamples * 2;
+		voice.loop = true;
+		// Off-unity pitches so the resampler actually interpolates.
+		voice.pitch = PSP_SAS_PITCH_BASE + (v - 8) * 64;
+		// Jump straight to full envelope height on the first step.
+		voice.envelope.attackRate = PSP_SAS_ENVELOPE_HEIGHT_MAX;
+		voice.KeyOn();
+	}
+
+	double t = TimePerCall([&] {
+		sas->Mix(outAddr);
+	}, 64);
+	ReportRow("sasmix_pcm16", "default", t, grainSize * 2 * sizeof(s16));
+
+	delete sas;
+	Memory::Shutdown();
+	coreState = CORE_POWERDOWN;
+	currentMIPS = nullptr;
+}
+
+bool RunKernelBenchmarks(const char *filter) {
+	benchFilter = filter;
+
+	printf("# ppsspp kernel benchmarks\n");
+	printf("# cpu: %s\n", cpu_info.Summarize().c_str());
+	printf("kernel,variant,bytes,ns_per_call,mb_per_s\n");
+
+	BenchTexHash();
+	BenchUnswizzle();
+	BenchColorConv();
+	BenchIndexGenerator();
+	BenchVertexDecoder();
+	BenchSasMix();
+	return true;
+}
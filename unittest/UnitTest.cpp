@@ -497,6 +497,9 @@ bool TestArmEmitter();
 bool TestArm64Emitter();
 bool TestX64Emitter();
 
+// In TestBench.cpp.
+bool RunKernelBenchmarks(const char *filter);
+
 TestItem availableTests[] = {
 #if defined(ARM64) || defined(_M_X64) || defined(_M_IX86)
 	TEST_ITEM(Arm64Emitter),
@@ -533,6 +536,10 @@ int main(int argc, const char *argv[]) {
 		if (!strcasecmp(argv[1], "all")) {
 			allTests = true;
 		}
+		if (!strcasecmp(argv[1], "bench")) {
+			// Not a test - runs the kernel microbenchmarks and prints CSV.
+			return RunKernelBenchmarks(argc >= 3 ? argv[2] : nullptr) ? 0 : 2;
+		}
 		for (auto f : availableTests) {
 			if (!strcasecmp(argv[1], f.name)) {
 				testFunc = f.func;
@@ -565,6 +572,7 @@ int main(int argc, const char *argv[]) {
 		for (auto f : availableTests) {
 			fprintf(stderr, "  * %s\n", f.name);
 		}
+		fprintf(stderr, "Or 'bench [filter]' for the kernel microbenchmarks.\n");
 		return 1;
 	} else {
 		if (!testFunc()) {